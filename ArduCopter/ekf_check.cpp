@@ -1,5 +1,7 @@
 #include "Copter.h"
 
+#include <AP_DAL/AP_DAL.h>
+
 /**
  *
  * Detects failures of the ekf or inertial nav system triggers an alert
@@ -168,6 +170,13 @@ void Copter::failsafe_ekf_event()
     // EKF failsafe event has occurred
     failsafe.ekf = true;
     LOGGER_WRITE_ERROR(LogErrorSubsystem::FAILSAFE_EKFINAV, LogErrorCode::FAILSAFE_OCCURRED);
+#if AP_LOGGER_REPLAY_RING_ENABLED
+    // write the recent EKF replay history so the failsafe can be replayed
+    AP::dal().replay_ring_trigger();
+#endif
+#if HAL_LOGGING_ENABLED
+    AP::logger().trigger_full_rate();
+#endif
 
     // if disarmed take no action
     if (!motors->armed()) {
@@ -295,6 +304,9 @@ void Copter::check_vibration()
             vibration_check.high_vibes = true;
             pos_control->set_vibe_comp(true);
             LOGGER_WRITE_ERROR(LogErrorSubsystem::FAILSAFE_VIBE, LogErrorCode::FAILSAFE_OCCURRED);
+#if HAL_LOGGING_ENABLED
+            logger.trigger_full_rate();
+#endif
             gcs().send_text(MAV_SEVERITY_CRITICAL, "Vibration compensation ON");
         }
     } else {
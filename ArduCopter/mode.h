@@ -2,6 +2,7 @@
 
 #include "Copter.h"
 #include <AP_Math/chirp.h>
+#include <AP_Math/freqresp_estimator.h>
 #include <AP_ExternalControl/AP_ExternalControl_config.h> // TODO why is this needed if Copter.h includes this
 
 #if AP_COPTER_ADVANCED_FAILSAFE_ENABLED
@@ -1719,6 +1720,8 @@ private:
 
     void log_data() const;
     bool is_poscontrol_axis_type() const;
+    bool get_freqresp_output(float &output) const;
+    void update_freqresp();
 
     enum class AxisType {
         NONE = 0,               // none
@@ -1750,6 +1753,16 @@ private:
     AP_Float time_fade_in;      // Time to reach maximum amplitude of chirp
     AP_Float time_record;       // Time taken to complete the chirp waveform
     AP_Float time_fade_out;     // Time to reach zero amplitude after chirp finishes
+    AP_Int8 options;            // bitmask of options
+
+    enum class Option {
+        LOG_FREQRESP_ONLY = (1U<<0),    // skip raw data logging, log the frequency response estimate
+    };
+    bool option_is_set(Option option) const {
+        return (options & uint8_t(option)) != 0;
+    }
+
+    FreqRespEstimator freqresp; // onboard frequency response estimate
 
     bool att_bf_feedforward;    // Setting of attitude_control->get_bf_feedforward
     float waveform_time;        // Time reference for waveform
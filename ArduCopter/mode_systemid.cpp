@@ -62,6 +62,13 @@ const AP_Param::GroupInfo ModeSystemId::var_info[] = {
     // @User: Standard
     AP_GROUPINFO("_T_FADE_OUT", 7, ModeSystemId, time_fade_out, 2),
 
+    // @Param: _OPTIONS
+    // @DisplayName: System identification options
+    // @Description: Options for system identification. The frequency response of the excited axis is always estimated onboard and reported to the GCS. Setting Log frequency response only stops the high rate raw SIDD logging and logs attitude at the slowest rate, leaving the SIDF estimate for analysis
+    // @Bitmask: 0:Log frequency response only
+    // @User: Advanced
+    AP_GROUPINFO("_OPTIONS", 8, ModeSystemId, options, 0),
+
     AP_GROUPEND
 };
 
@@ -71,6 +78,7 @@ ModeSystemId::ModeSystemId(void) : Mode()
 }
 
 #define SYSTEM_ID_DELAY     1.0f      // time in seconds waited after system id mode change for frequency sweep injection
+#define SYSTEM_ID_FREQRESP_POINTS_PER_DECADE 10 // number of frequency response estimates per decade of the sweep
 
 // systemId_init - initialise systemId controller
 bool ModeSystemId::init(bool ignore_checks)
@@ -140,6 +148,7 @@ bool ModeSystemId::init(bool ignore_checks)
     log_subsample = 0;
 
     chirp_input.init(time_record, frequency_start, frequency_stop, time_fade_in, time_fade_out, time_const_freq);
+    freqresp.init(frequency_start, frequency_stop, SYSTEM_ID_FREQRESP_POINTS_PER_DECADE);
 
     gcs().send_text(MAV_SEVERITY_INFO, "SystemID Starting: axis=%d", (unsigned)axis);
 
@@ -344,6 +353,9 @@ void ModeSystemId::run()
                     input_vel.rotate(attitude_control->get_att_target_euler_rad().z);
                     break;
             }
+            if (!chirp_input.completed()) {
+                update_freqresp();
+            }
             break;
     }
 
@@ -385,7 +397,9 @@ void ModeSystemId::run()
 
     if (log_subsample <= 0) {
         log_data();
-        if (copter.should_log(MASK_LOG_ATTITUDE_FAST) && copter.should_log(MASK_LOG_ATTITUDE_MED)) {
+        if (option_is_set(Option::LOG_FREQRESP_ONLY)) {
+            log_subsample = 8;
+        } else if (copter.should_log(MASK_LOG_ATTITUDE_FAST) && copter.should_log(MASK_LOG_ATTITUDE_MED)) {
             log_subsample = 1;
         } else if (copter.should_log(MASK_LOG_ATTITUDE_FAST)) {
             log_subsample = 2;
@@ -409,7 +423,7 @@ void ModeSystemId::log_data() const
     float delta_velocity_dt;
     copter.ins.get_delta_velocity(delta_velocity, delta_velocity_dt);
 
-    if (is_positive(delta_angle_dt) && is_positive(delta_velocity_dt)) {
+    if (is_positive(delta_angle_dt) && is_positive(delta_velocity_dt) && !option_is_set(Option::LOG_FREQRESP_ONLY)) {
         copter.Log_Write_SysID_Data(waveform_time, waveform_sample, waveform_freq_rads / (2 * M_PI), degrees(delta_angle.x / delta_angle_dt), degrees(delta_angle.y / delta_angle_dt), degrees(delta_angle.z / delta_angle_dt), delta_velocity.x / delta_velocity_dt, delta_velocity.y / delta_velocity_dt, delta_velocity.z / delta_velocity_dt);
     }
 
@@ -426,6 +440,91 @@ void ModeSystemId::log_data() const
     }
 }
 
+// get the measured response of the excited axis for the frequency response estimate, in the units of the
+// waveform: deg for angle inputs, deg/s for rate and mixer inputs, m/s/s for throttle and m/s for velocity
+bool ModeSystemId::get_freqresp_output(float &output) const
+{
+    const Vector3f &gyro = ahrs.get_gyro();
+    Vector2f vel_bf;
+    switch ((AxisType)axis.get()) {
+        case AxisType::INPUT_ROLL:
+        case AxisType::RECOVER_ROLL:
+            output = degrees(ahrs.get_roll());
+            return true;
+        case AxisType::INPUT_PITCH:
+        case AxisType::RECOVER_PITCH:
+            output = degrees(ahrs.get_pitch());
+            return true;
+        case AxisType::RATE_ROLL:
+        case AxisType::MIX_ROLL:
+            output = degrees(gyro.x);
+            return true;
+        case AxisType::RATE_PITCH:
+        case AxisType::MIX_PITCH:
+            output = degrees(gyro.y);
+            return true;
+        case AxisType::INPUT_YAW:
+        case AxisType::RECOVER_YAW:
+        case AxisType::RATE_YAW:
+        case AxisType::MIX_YAW:
+            output = degrees(gyro.z);
+            return true;
+        case AxisType::MIX_THROTTLE:
+            output = -copter.ins.get_accel().z;
+            return true;
+        case AxisType::DISTURB_VEL_LAT:
+        case AxisType::DISTURB_VEL_LONG:
+        case AxisType::INPUT_VEL_LAT:
+        case AxisType::INPUT_VEL_LONG:
+            vel_bf = inertial_nav.get_velocity_neu_cms().xy() * 0.01f;
+            vel_bf.rotate(-attitude_control->get_att_target_euler_rad().z);
+            if ((AxisType)axis.get() == AxisType::DISTURB_VEL_LAT || (AxisType)axis.get() == AxisType::INPUT_VEL_LAT) {
+                output = vel_bf.y;
+            } else {
+                output = vel_bf.x;
+            }
+            return true;
+        case AxisType::NONE:
+        case AxisType::DISTURB_POS_LAT:
+        case AxisType::DISTURB_POS_LONG:
+            break;
+    }
+    return false;
+}
+
+// @LoggerMessage: SIDF
+// @Description: System ID onboard frequency response estimate
+// @Field: TimeUS: Time since system startup
+// @Field: Ax: The axis which is being excited
+// @Field: F: Frequency of the estimate
+// @Field: Gain: Gain of the measured response over the waveform in dB
+// @Field: Ph: Phase of the measured response relative to the waveform, negative for a lag
+// @Field: Coh: Coherence of the estimate, low values show the response is not linearly related to the waveform
+
+// update the frequency response estimate and report any new result
+void ModeSystemId::update_freqresp()
+{
+    float output;
+    if (!get_freqresp_output(output)) {
+        return;
+    }
+    if (!freqresp.update(G_Dt, waveform_freq_rads, waveform_sample, output)) {
+        return;
+    }
+    const FreqRespEstimator::Result &result = freqresp.get_result();
+    gcs().send_text(MAV_SEVERITY_INFO, "SystemID: %.2fHz %.1fdB %.0fdeg coh %.2f",
+                    (double)result.freq_hz, (double)result.gain_db, (double)result.phase_deg, (double)result.coherence);
+#if HAL_LOGGING_ENABLED
+    AP::logger().Write("SIDF", "TimeUS,Ax,F,Gain,Ph,Coh", "s-z-d-", "F-----", "QBffff",
+                       AP_HAL::micros64(),
+                       uint8_t(axis.get()),
+                       result.freq_hz,
+                       result.gain_db,
+                       result.phase_deg,
+                       result.coherence);
+#endif
+}
+
 bool ModeSystemId::is_poscontrol_axis_type() const
 {
     bool ret = false;
@@ -62,9 +62,14 @@ overruns its allotted time
 const AP_Scheduler::Task Plane::scheduler_tasks[] = {
                            // Units:   Hz      us
     FAST_TASK(ahrs_update),
+    FAST_TASK(read_radio_fast),
     FAST_TASK(update_control_mode),
     FAST_TASK(stabilize),
     FAST_TASK(set_servos),
+#if HAL_MOUNT_ENABLED
+    // camera mount's fast update
+    FAST_TASK_CLASS(AP_Mount, &plane.camera_mount, update_fast),
+#endif
     SCHED_TASK(read_radio,             50,    100,   6),
     SCHED_TASK(check_short_failsafe,   50,    100,   9),
     SCHED_TASK(update_speed_height,    50,    200,  12),
@@ -147,6 +152,10 @@ const AP_Scheduler::Task Plane::scheduler_tasks[] = {
 #if AP_QUICKTUNE_ENABLED
     SCHED_TASK(update_quicktune, 40, 100, 163),
 #endif
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // don't delete this, there is an equivalent (virtual) in AP_Vehicle for the non-rate loop case
+    SCHED_TASK(update_dynamic_notch_at_specified_rate_main, LOOP_RATE, 200, 215),
+#endif
 };
 
 void Plane::get_scheduler_tasks(const AP_Scheduler::Task *&tasks,
@@ -385,7 +394,7 @@ void Plane::one_second_loop()
 
     const float loop_rate = AP::scheduler().get_filtered_loop_rate_hz();
 #if HAL_QUADPLANE_ENABLED
-    if (quadplane.available()) {
+    if (quadplane.available() && !quadplane.rate_thread_active()) {
         quadplane.attitude_control->set_notch_sample_rate(loop_rate);
     }
 #endif
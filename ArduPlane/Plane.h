@@ -772,6 +772,10 @@ private:
     // The location of the current/active waypoint.  Used for altitude ramp, track following and loiter calculations.
     Location next_WP_loc {};
 
+    // NE vectors between prev_WP_loc, next_WP_loc and current_loc, computed once per navigation
+    // update and shared with the navigation controller
+    AP_Navigation::WaypointGeometry nav_geometry;
+
     // Altitude control
     struct {
         // target altitude above sea level in cm. Used for barometric
@@ -892,6 +896,11 @@ private:
     void update_quicktune(void);
 #endif
 
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // rate_thread.cpp
+    void update_dynamic_notch_at_specified_rate_main();
+#endif
+
     // Attitude.cpp
     void adjust_nav_pitch_throttle(void);
     void update_load_factor(void);
@@ -1103,6 +1112,7 @@ private:
     // navigation.cpp
     void loiter_angle_reset(void);
     void loiter_angle_update(void);
+    void update_nav_geometry();
     void navigate();
     void check_home_alt_change(void);
     void calc_airspeed_errors();
@@ -1121,6 +1131,8 @@ private:
     void init_rc_out_aux();
     void rudder_arm_disarm_check();
     void read_radio();
+    void read_radio_fast();
+    void process_radio_input();
     int16_t rudder_input(void);
     void control_failsafe();
     void trim_radio();
@@ -49,9 +49,7 @@ void Plane::setup_alt_slope(void)
 {
     // establish the distance we are travelling to the next waypoint,
     // for calculating out rate of change of altitude
-    auto_state.wp_distance = current_loc.get_distance(next_WP_loc);
-    auto_state.wp_proportion = current_loc.line_path_proportion(prev_WP_loc, next_WP_loc);
-    TECS_controller.set_path_proportion(auto_state.wp_proportion);
+    update_nav_geometry();
     update_flight_stage();
 
     /*
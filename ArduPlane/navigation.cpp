@@ -82,6 +82,21 @@ void Plane::loiter_angle_update(void)
 
 //****************************************************************
 // Function that will calculate the desired direction to fly and distance
+/*
+  update the geometry between the waypoints and the plane, and the
+  waypoint distance and path proportion found from it. The geometry
+  is shared with the navigation controller, so the
+  update_waypoint(prev_WP_loc, next_WP_loc) call in this loop does
+  not recompute it
+ */
+void Plane::update_nav_geometry()
+{
+    nav_geometry.update(prev_WP_loc, next_WP_loc, current_loc);
+    auto_state.wp_distance = nav_geometry.current_to_next.length();
+    auto_state.wp_proportion = nav_geometry.path_proportion();
+    TECS_controller.set_path_proportion(auto_state.wp_proportion);
+}
+
 //****************************************************************
 void Plane::navigate()
 {
@@ -99,9 +114,7 @@ void Plane::navigate()
 
     // waypoint distance from plane
     // ----------------------------
-    auto_state.wp_distance = current_loc.get_distance(next_WP_loc);
-    auto_state.wp_proportion = current_loc.line_path_proportion(prev_WP_loc, next_WP_loc);
-    TECS_controller.set_path_proportion(auto_state.wp_proportion);
+    update_nav_geometry();
 
     // update total loiter angle
     loiter_angle_update();
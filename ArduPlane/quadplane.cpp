@@ -554,7 +554,24 @@ const AP_Param::GroupInfo QuadPlane::var_info2[] = {
     // @Increment: 1
     // @User: Standard
     AP_GROUPINFO("APPROACH_DIST", 39, QuadPlane, approach_distance, 0),
-    
+
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // @Param: FSTRATE_ENABLE
+    // @DisplayName: Enable the fast rate thread
+    // @Description: Enable the fast rate thread for VTOL flight. When enabled the multicopter rate controller and VTOL motor outputs are run in a separate thread on every gyro sample, divided by Q_FSTRATE_DIV, whenever the VTOL motors are under multicopter control. At other times they are run at the main loop rate.
+    // @Values: 0:Disabled,1:Enabled
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("FSTRATE_ENABLE", 40, QuadPlane, fast_rate_enable, 0),
+
+    // @Param: FSTRATE_DIV
+    // @DisplayName: Fast rate thread divisor
+    // @Description: Divisor of the gyro rate used for the fast rate thread. The rate controller runs at the gyro rate in Hz divided by this value, and never slower than the main loop rate.
+    // @Range: 1 10
+    // @User: Advanced
+    AP_GROUPINFO("FSTRATE_DIV", 41, QuadPlane, fast_rate_div, 1),
+#endif
+
     AP_GROUPEND
 };
 
@@ -832,6 +849,19 @@ bool QuadPlane::setup(void)
     char frame_and_type_string[30];
     motors->get_frame_and_type_string(frame_and_type_string, ARRAY_SIZE(frame_and_type_string));
     gcs().send_text(MAV_SEVERITY_INFO, "QuadPlane initialised, %s", frame_and_type_string);
+
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    if (!started_rate_thread && fast_rate_enable > 0) {
+        if (hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&QuadPlane::rate_controller_thread, void),
+                                         "rate",
+                                         1536, AP_HAL::Scheduler::PRIORITY_RCOUT, 1)) {
+            started_rate_thread = true;
+        } else {
+            AP_BoardConfig::allocation_error("rate thread");
+        }
+    }
+#endif
+
     initialised = true;
     return true;
 }
@@ -1439,8 +1469,12 @@ float QuadPlane::desired_auto_yaw_rate_cds(void) const
 /*
   update for transition from quadplane to fixed wing mode
  */
+AP_CYCLE_PROBE_DEFINE(qp_trans);
+
 void SLT_Transition::update()
 {
+    AP_CYCLE_PROBE(qp_trans);
+
     const uint32_t now = millis();
     
     if (!plane.arming.is_armed_and_safety_off()) {
@@ -1634,6 +1668,7 @@ void SLT_Transition::update()
     }
 
     case TRANSITION_DONE:
+        quadplane.release_rate_thread();
         quadplane.set_desired_spool_state(AP_Motors::DesiredSpoolState::SHUT_DOWN);
         motors->output();
         set_last_fw_pitch();
@@ -1687,6 +1722,7 @@ void QuadPlane::update(void)
 
 #if AP_ADVANCEDFAILSAFE_ENABLED
     if (plane.afs.should_crash_vehicle() && !plane.afs.terminating_vehicle_via_landing()) {
+        release_rate_thread();
         set_desired_spool_state(AP_Motors::DesiredSpoolState::SHUT_DOWN);
         motors->output();
         return;
@@ -1694,6 +1730,7 @@ void QuadPlane::update(void)
 #endif
     
     if (motor_test.running) {
+        release_rate_thread();
         motor_test_output();
         return;
     }
@@ -1726,6 +1763,7 @@ void QuadPlane::update(void)
             plane.control_mode == &plane.mode_training) {
             // in manual modes quad motors are always off
             if (!tailsitter.enabled()) {
+                release_rate_thread();
                 set_desired_spool_state(AP_Motors::DesiredSpoolState::SHUT_DOWN);
                 motors->output();
             }
@@ -1918,8 +1956,17 @@ void QuadPlane::update_throttle_hover()
 /*
   output motors and do any copter needed
  */
+AP_CYCLE_PROBE_DEFINE(qp_motors);
+
 void QuadPlane::motors_output(bool run_rate_controller)
 {
+    AP_CYCLE_PROBE(qp_motors);
+
+    if (!run_rate_controller) {
+        // fixed wing control of the motors
+        release_rate_thread();
+    }
+
     /* Delay for ARMING_DELAY_MS after arming before allowing props to spin:
        1) for safety (OPTION_DELAY_ARMING)
        2) to allow motors to return to vertical (OPTION_DISARMED_TILT)
@@ -1927,6 +1974,7 @@ void QuadPlane::motors_output(bool run_rate_controller)
     if (option_is_set(QuadPlane::OPTION::DISARMED_TILT) || option_is_set(QuadPlane::OPTION::DELAY_ARMING)) {
         if (plane.arming.get_delay_arming()) {
             // delay motor start after arming
+            release_rate_thread();
             set_desired_spool_state(AP_Motors::DesiredSpoolState::SHUT_DOWN);
             motors->output();
             return;
@@ -1940,12 +1988,14 @@ void QuadPlane::motors_output(bool run_rate_controller)
 #else
     if (!plane.arming.is_armed_and_safety_off() || SRV_Channels::get_emergency_stop()) {
 #endif
+        release_rate_thread();
         set_desired_spool_state(AP_Motors::DesiredSpoolState::SHUT_DOWN);
         motors->output();
         return;
     }
     if (esc_calibration && AP_Notify::flags.esc_calibration && plane.control_mode == &plane.mode_qstabilize) {
         // output is direct from run_esc_calibration()
+        release_rate_thread();
         return;
     }
 
@@ -1956,6 +2006,7 @@ void QuadPlane::motors_output(bool run_rate_controller)
           transition. That is taken care of by the fixed wing
           stabilisation code
          */
+        release_rate_thread();
         return;
     }
 
@@ -1970,10 +2021,20 @@ void QuadPlane::motors_output(bool run_rate_controller)
 
         // run low level rate controllers that only require IMU data and set loop time
         const float last_loop_time_s = AP::scheduler().get_last_loop_time_s();
-        motors->set_dt(last_loop_time_s);
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+        if (started_rate_thread && fast_rate_enable > 0) {
+            // the rate thread keeps the motors until the next main loop
+            rate_thread_request_us = AP_HAL::micros();
+        }
+#endif
+        if (!rate_thread_active()) {
+            motors->set_dt(last_loop_time_s);
+        }
         attitude_control->set_dt(last_loop_time_s);
         pos_control->set_dt(last_loop_time_s);
-        attitude_control->rate_controller_run();
+        if (!rate_thread_active()) {
+            attitude_control->rate_controller_run();
+        }
         // reset sysid and other temporary inputs
         attitude_control->rate_controller_target_reset();
         last_att_control_ms = now;
@@ -1982,7 +2043,9 @@ void QuadPlane::motors_output(bool run_rate_controller)
     // see if motors should be shut down
     update_throttle_suppression();
 
-    motors->output();
+    if (!rate_thread_active()) {
+        motors->output();
+    }
 
     // remember when motors were last active for throttle suppression
     if (motors->get_throttle() > 0.01f || tiltrotor.motors_active()) {
@@ -3901,6 +3964,7 @@ void QuadPlane::guided_update(void)
 void QuadPlane::afs_terminate(void)
 {
     if (available()) {
+        release_rate_thread();
         set_desired_spool_state(AP_Motors::DesiredSpoolState::SHUT_DOWN);
         motors->output();
     }
@@ -21,6 +21,7 @@
 #include <AP_Logger/LogStructure.h>
 #include <AP_Mission/AP_Mission.h>
 #include <AP_Proximity/AP_Proximity.h>
+#include <AP_InertialSensor/AP_InertialSensor_rate_config.h>
 #include "qautotune.h"
 #include "defines.h"
 #include "tailsitter.h"
@@ -286,6 +287,42 @@ private:
 
     bool should_relax(void);
     void motors_output(bool run_rate_controller = true);
+
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // fast rate thread for the VTOL rate controller and motor outputs
+    void rate_controller_thread();
+    void enable_fast_rate_loop(uint8_t rate_decimation);
+    void disable_fast_rate_loop();
+    void rate_controller_filter_update();
+    bool rate_thread_wanted() const;
+
+    AP_Int8 fast_rate_enable;
+    AP_Int8 fast_rate_div;
+
+    bool started_rate_thread;
+    // last time the main loop gave the motors to the rate thread,
+    // zero when it has taken them back
+    uint32_t rate_thread_request_us;
+    // set by the rate thread while it is running at the fast rate
+    bool using_rate_thread;
+    // held by the rate thread while it runs the rate controller and motors
+    HAL_Semaphore rate_thread_sem;
+
+    // take the motors back from the rate thread before outputting
+    // to them from the main loop
+    void release_rate_thread();
+#else
+    void release_rate_thread() {}
+#endif
+
+    // true when the rate controller and motors are run from the fast rate thread
+    bool rate_thread_active() const {
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+        return using_rate_thread && rate_thread_wanted();
+#else
+        return false;
+#endif
+    }
     void Log_Write_QControl_Tuning();
     void log_QPOS(void);
     float landing_descent_rate_cms(float height_above_ground);
@@ -177,6 +177,27 @@ void Plane::read_radio()
         return;
     }
 
+    process_radio_input();
+}
+
+/*
+  read the radio in the fast loop in modes where the pilot drives the
+  outputs directly, so that a new RC frame reaches the servos in the
+  same loop rather than waiting up to 20ms for the read_radio task
+ */
+void Plane::read_radio_fast()
+{
+    if (control_mode != &mode_manual && control_mode != &mode_acro) {
+        return;
+    }
+    if (rc().read_input()) {
+        process_radio_input();
+    }
+}
+
+// handle new RC input
+void Plane::process_radio_input()
+{
     if (!failsafe.rc_failsafe)
     {
         failsafe.AFS_last_valid_rc_ms = millis();
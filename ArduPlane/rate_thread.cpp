@@ -0,0 +1,183 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Plane.h"
+#include <AP_InertialSensor/AP_InertialSensor_rate_config.h>
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+
+/*
+  VTOL fast rate thread, following the design of the Copter rate
+  thread (see ArduCopter/rate_thread.cpp).
+
+  While the main loop runs the multicopter rate controller from
+  QuadPlane::motors_output() it hands the rate controller and the VTOL
+  motor outputs to this thread, which runs them on every filtered gyro
+  sample divided by Q_FSTRATE_DIV. The attitude targets, spool state
+  and throttle suppression stay in the main loop.
+
+  The motors are handed over for one main loop at a time. Any main
+  loop path that outputs to the motors itself, for example a fixed
+  wing controlled tailsitter or tiltrotor or a fixed wing mode, calls
+  release_rate_thread() first, and the thread stops on its own if the
+  main loop has not asked for it within the last two loops.
+
+  Unlike Copter the divisor is fixed and is not scaled down when the
+  thread falls behind, and the rate thread outputs are not separately
+  logged.
+ */
+
+#define DIV_ROUND_INT(x, d) ((x + d/2) / d)
+
+#if HAL_QUADPLANE_ENABLED
+
+AP_CYCLE_PROBE_DEFINE(qp_rate);
+
+/*
+  thread for rate control
+*/
+void QuadPlane::rate_controller_thread()
+{
+    auto &ins = plane.ins;
+    uint8_t filter_loop_count = 0;
+    uint8_t active_decimation = 0;
+
+    while (true) {
+        const uint8_t rate_decimation = constrain_int16(fast_rate_div.get(), 1,
+                                                        DIV_ROUND_INT(ins.get_raw_gyro_rate_hz(), AP::scheduler().get_loop_rate_hz()));
+
+        if (fast_rate_enable <= 0 || !rate_thread_wanted()) {
+            if (using_rate_thread) {
+                WITH_SEMAPHORE(rate_thread_sem);
+                disable_fast_rate_loop();
+            }
+            hal.scheduler->delay_microseconds(500);
+            continue;
+        }
+
+        if (!using_rate_thread || rate_decimation != active_decimation) {
+            WITH_SEMAPHORE(rate_thread_sem);
+            enable_fast_rate_loop(rate_decimation);
+            active_decimation = rate_decimation;
+        }
+
+        // wait for an IMU sample
+        Vector3f gyro;
+        if (!ins.get_next_gyro_sample(gyro)) {
+            continue;   // go around again
+        }
+
+        // we must use multiples of the actual sensor rate
+        const float sensor_dt = 1.0f * rate_decimation / ins.get_raw_gyro_rate_hz();
+
+        {
+            WITH_SEMAPHORE(rate_thread_sem);
+            if (!rate_thread_wanted()) {
+                // the main loop has taken the motors back
+                continue;
+            }
+
+            AP_CYCLE_PROBE(qp_rate);
+
+            attitude_control->rate_controller_run_dt(gyro + ahrs.get_gyro_drift(), sensor_dt);
+
+            // immediately output the new motor values
+            hal.rcout->cork();
+            motors->output();
+            hal.rcout->push();
+        }
+
+        // run the filters at half the gyro rate
+        if (++filter_loop_count >= MAX(uint8_t(DIV_ROUND_INT(ins.get_raw_gyro_rate_hz() / rate_decimation, ins.get_raw_gyro_rate_hz() / 2)), 1U)) {
+            filter_loop_count = 0;
+            rate_controller_filter_update();
+        }
+    }
+}
+
+/*
+  true if the main loop has given the motors to the rate thread
+*/
+bool QuadPlane::rate_thread_wanted() const
+{
+    const uint32_t request_us = rate_thread_request_us;
+    return request_us != 0 && AP_HAL::micros() - request_us < 2 * AP::scheduler().get_loop_period_us();
+}
+
+/*
+  take the motors back from the rate thread. Waits for a rate
+  controller run in progress to finish
+*/
+void QuadPlane::release_rate_thread()
+{
+    if (rate_thread_request_us == 0) {
+        return;
+    }
+    WITH_SEMAPHORE(rate_thread_sem);
+    rate_thread_request_us = 0;
+}
+
+// enable the fast rate thread using the provided decimation rate
+void QuadPlane::enable_fast_rate_loop(uint8_t rate_decimation)
+{
+    auto &ins = plane.ins;
+    const uint32_t attitude_rate = ins.get_raw_gyro_rate_hz() / rate_decimation;
+
+    ins.enable_fast_rate_buffer();
+    ins.set_rate_decimation(rate_decimation);
+    attitude_control->set_notch_sample_rate(attitude_rate);
+    hal.rcout->set_dshot_rate(SRV_Channels::get_dshot_rate(), attitude_rate);
+    motors->set_dt(1.0f / attitude_rate);
+    hal.rcout->force_trigger_groups(true);
+    using_rate_thread = true;
+}
+
+// disable the fast rate thread and return to main loop rate outputs
+void QuadPlane::disable_fast_rate_loop()
+{
+    using_rate_thread = false;
+    attitude_control->set_notch_sample_rate(AP::scheduler().get_filtered_loop_rate_hz());
+    hal.rcout->set_dshot_rate(SRV_Channels::get_dshot_rate(), AP::scheduler().get_loop_rate_hz());
+    hal.rcout->force_trigger_groups(false);
+    plane.ins.disable_fast_rate_buffer();
+}
+
+/*
+  update rate controller filters
+*/
+void QuadPlane::rate_controller_filter_update()
+{
+    // update the frontend center frequencies of notch filters
+    for (auto &notch : plane.ins.harmonic_notches) {
+        plane.update_dynamic_notch(notch);
+    }
+
+    // this copies backend data to the frontend and updates the notches
+    plane.ins.update_backend_filters();
+}
+
+#endif // HAL_QUADPLANE_ENABLED
+
+// run notch update at either loop rate or 200Hz
+void Plane::update_dynamic_notch_at_specified_rate_main()
+{
+#if HAL_QUADPLANE_ENABLED
+    if (quadplane.rate_thread_active()) {
+        return;
+    }
+#endif
+
+    update_dynamic_notch_at_specified_rate();
+}
+
+#endif // AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
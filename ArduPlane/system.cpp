@@ -117,6 +117,9 @@ void Plane::init_ardupilot()
     gcs().send_text(MAV_SEVERITY_INFO,"Ground start");
 #endif
 
+    // share the waypoint geometry computed for navigation with the navigation controller
+    nav_controller->set_waypoint_geometry(&nav_geometry);
+
     //INS ground start
     //------------------------
     //
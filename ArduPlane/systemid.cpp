@@ -70,6 +70,13 @@ const AP_Param::GroupInfo AP_SystemID::var_info[] = {
     // @Range: 0.05 1.0
     // @User: Standard
     AP_GROUPINFO("_XY_CTRL_MUL", 8, AP_SystemID, xy_control_mul, 0.1),
+
+    // @Param: _OPTIONS
+    // @DisplayName: System identification options
+    // @Description: Options for system identification. The frequency response of the excited axis is always estimated onboard and reported to the GCS. Setting Log frequency response only stops the high rate raw SIDD logging and logs attitude at the slowest rate, leaving the SIDF estimate for analysis
+    // @Bitmask: 0:Log frequency response only
+    // @User: Advanced
+    AP_GROUPINFO("_OPTIONS", 9, AP_SystemID, options, 0),
     
     AP_GROUPEND
 };
@@ -125,6 +132,8 @@ void AP_SystemID::start()
     time_const_freq = 2.0 / frequency_start; // Two full cycles at the starting frequency
 
     chirp_input.init(time_record, frequency_start, frequency_stop, time_fade_in, time_fade_out, time_const_freq);
+    freqresp.init(frequency_start, frequency_stop, 10);
+    start_yaw_deg = degrees(plane.ahrs.get_yaw());
 
     gcs().send_text(MAV_SEVERITY_INFO, "SystemID Starting: axis=%d", (unsigned)axis);
 
@@ -238,12 +247,16 @@ void AP_SystemID::update()
             break;
     }
 
+    update_freqresp(last_loop_time_s);
+
     // reduce control in XY axis when in position controlled modes
     plane.quadplane.pos_control->set_NE_control_scale_factor(xy_control_mul);
 
     if (log_subsample <= 0) {
         log_data();
-        if (plane.should_log(MASK_LOG_ATTITUDE_FAST) && plane.should_log(MASK_LOG_ATTITUDE_MED)) {
+        if (option_is_set(Option::LOG_FREQRESP_ONLY)) {
+            log_subsample = 8;
+        } else if (plane.should_log(MASK_LOG_ATTITUDE_FAST) && plane.should_log(MASK_LOG_ATTITUDE_MED)) {
             log_subsample = 1;
         } else if (plane.should_log(MASK_LOG_ATTITUDE_FAST)) {
             log_subsample = 2;
@@ -273,6 +286,11 @@ void AP_SystemID::update()
 void AP_SystemID::log_data() const
 {
 #if HAL_LOGGING_ENABLED
+    if (option_is_set(Option::LOG_FREQRESP_ONLY)) {
+        plane.quadplane.Log_Write_AttRate();
+        return;
+    }
+
     Vector3f delta_angle;
     float delta_angle_dt;
     plane.ins.get_delta_angle(delta_angle, delta_angle_dt);
@@ -301,5 +319,77 @@ void AP_SystemID::log_data() const
 #endif // HAL_LOGGING_ENABLED
 }
 
+// get the measured response of the excited axis for the frequency response estimate, in the units of the
+// waveform: deg for angle inputs, deg/s for rate and mixer inputs and m/s/s for throttle
+bool AP_SystemID::get_freqresp_output(float &output) const
+{
+    const Vector3f &gyro = plane.ahrs.get_gyro();
+    switch (start_axis) {
+        case AxisType::NONE:
+            break;
+        case AxisType::INPUT_ROLL:
+        case AxisType::RECOVER_ROLL:
+            output = degrees(plane.ahrs.get_roll());
+            return true;
+        case AxisType::INPUT_PITCH:
+        case AxisType::RECOVER_PITCH:
+            output = degrees(plane.ahrs.get_pitch());
+            return true;
+        case AxisType::INPUT_YAW:
+        case AxisType::RECOVER_YAW:
+            output = wrap_180(degrees(plane.ahrs.get_yaw()) - start_yaw_deg);
+            return true;
+        case AxisType::RATE_ROLL:
+        case AxisType::MIX_ROLL:
+            output = degrees(gyro.x);
+            return true;
+        case AxisType::RATE_PITCH:
+        case AxisType::MIX_PITCH:
+            output = degrees(gyro.y);
+            return true;
+        case AxisType::RATE_YAW:
+        case AxisType::MIX_YAW:
+            output = degrees(gyro.z);
+            return true;
+        case AxisType::MIX_THROTTLE:
+            output = -plane.ins.get_accel().z;
+            return true;
+    }
+    return false;
+}
+
+// @LoggerMessage: SIDF
+// @Description: System ID onboard frequency response estimate
+// @Field: TimeUS: Time since system startup
+// @Field: Ax: The axis which is being excited
+// @Field: F: Frequency of the estimate
+// @Field: Gain: Gain of the measured response over the waveform in dB
+// @Field: Ph: Phase of the measured response relative to the waveform, negative for a lag
+// @Field: Coh: Coherence of the estimate, low values show the response is not linearly related to the waveform
+
+// update the frequency response estimate and report any new result
+void AP_SystemID::update_freqresp(float dt)
+{
+    float output;
+    if (!get_freqresp_output(output)) {
+        return;
+    }
+    if (!freqresp.update(dt, waveform_freq_rads, waveform_sample, output)) {
+        return;
+    }
+    const FreqRespEstimator::Result &result = freqresp.get_result();
+    gcs().send_text(MAV_SEVERITY_INFO, "SystemID: %.2fHz %.1fdB %.0fdeg coh %.2f",
+                    (double)result.freq_hz, (double)result.gain_db, (double)result.phase_deg, (double)result.coherence);
+#if HAL_LOGGING_ENABLED
+    AP::logger().Write("SIDF", "TimeUS,Ax,F,Gain,Ph,Coh", "s-z-d-", "F-----", "QBffff",
+                       AP_HAL::micros64(),
+                       uint8_t(start_axis),
+                       result.freq_hz,
+                       result.gain_db,
+                       result.phase_deg,
+                       result.coherence);
+#endif // HAL_LOGGING_ENABLED
+}
+
 #endif // AP_PLANE_SYSTEMID_ENABLED
 
@@ -10,6 +10,7 @@
 #if AP_PLANE_SYSTEMID_ENABLED
 
 #include <AP_Math/chirp.h>
+#include <AP_Math/freqresp_estimator.h>
 #include <AP_Param/AP_Param.h>
 #include <AP_Math/vector3.h>
 #include <AP_Math/vector2.h>
@@ -60,6 +61,18 @@ private:
     void log_data() const;
     int8_t log_subsample;       // Subsample multiple for logging.
 
+    bool get_freqresp_output(float &output) const;
+    void update_freqresp(float dt);
+    FreqRespEstimator freqresp; // onboard frequency response estimate
+    float start_yaw_deg;        // heading at the start, yaw angle responses are relative to this
+
+    enum class Option {
+        LOG_FREQRESP_ONLY = (1U<<0),    // skip raw data logging, log the frequency response estimate
+    };
+    bool option_is_set(Option option) const {
+        return (options & uint8_t(option)) != 0;
+    }
+
 
     AP_Enum<AxisType> axis;               // Controls which axis are being excited. Set to non-zero to display other parameters
     AP_Float waveform_magnitude;// Magnitude of chirp waveform
@@ -69,6 +82,7 @@ private:
     AP_Float time_record;       // Time taken to complete the chirp waveform
     AP_Float time_fade_out;     // Time to reach zero amplitude after chirp finishes
     AP_Float xy_control_mul;    // multiplier for VTOL XY control
+    AP_Int8 options;            // bitmask of options
 
     struct {
         bool att_bf_feedforward;    // Setting of attitude_control->get_bf_feedforward
@@ -827,8 +827,12 @@ bool Tailsitter::relax_pitch()
 /*
   update for transition from quadplane to fixed wing mode
  */
+AP_CYCLE_PROBE_DEFINE(qp_ts_trans);
+
 void Tailsitter_Transition::update()
 {
+    AP_CYCLE_PROBE(qp_ts_trans);
+
     const uint32_t now = millis();
 
     float aspeed;
@@ -775,6 +775,23 @@ const AP_Param::GroupInfo ParametersG2::var_info[] = {
     // @User: Standard
     AP_GROUPINFO("ORIGIN_ALT", 21, ParametersG2, backup_origin_alt, 0),
 
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // @Param: FSTRATE_ENABLE
+    // @DisplayName: Enable the fast Rate thread
+    // @Description: Enable the fast rate thread. The rate controller and thruster outputs are run in a separate thread on every gyro sample, divided by FSTRATE_DIV, instead of at the main loop rate.
+    // @Values: 0:Disabled,1:Enabled
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("FSTRATE_ENABLE", 22, ParametersG2, fast_rate_enable, 0),
+
+    // @Param: FSTRATE_DIV
+    // @DisplayName: Fast rate thread divisor
+    // @Description: Fast rate thread divisor used to control the rate controller update rate. The actual rate is the gyro rate in Hz divided by this value, and never slower than the main loop rate.
+    // @Range: 1 10
+    // @User: Advanced
+    AP_GROUPINFO("FSTRATE_DIV", 23, ParametersG2, fast_rate_div, 1),
+#endif
+
     AP_GROUPEND
 };
 
@@ -404,6 +404,11 @@ public:
     AP_Float backup_origin_lat;
     AP_Float backup_origin_lon;
     AP_Float backup_origin_alt;
+
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    AP_Int8 fast_rate_enable;
+    AP_Int8 fast_rate_div;
+#endif
 };
 
 extern const AP_Param::Info        var_info[];
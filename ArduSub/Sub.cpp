@@ -87,7 +87,7 @@ const AP_Scheduler::Task Sub::scheduler_tasks[] = {
     // run low level rate controllers that only require IMU data
     FAST_TASK(run_rate_controller),
     // send outputs to the motors library immediately
-    FAST_TASK(motors_output),
+    FAST_TASK(motors_output_main),
      // run EKF state estimator (expensive)
     FAST_TASK(read_AHRS),
     // Inertial Nav
@@ -115,6 +115,7 @@ const AP_Scheduler::Task Sub::scheduler_tasks[] = {
 #endif
     SCHED_TASK(update_batt_compass,   10,    120,  12),
     SCHED_TASK(read_rangefinder,      20,    100,  15),
+    SCHED_TASK(read_barometer,        50,    100,  16),
     SCHED_TASK(update_altitude,       10,    100,  18),
 #if AP_SUB_RC_ENABLED
     SCHED_TASK_CLASS(RC_Channels, (RC_Channels*)&sub.g2.rc_channels, read_aux_all, 10,  50,  18),
@@ -144,6 +145,9 @@ const AP_Scheduler::Task Sub::scheduler_tasks[] = {
     SCHED_TASK_CLASS(AP_RPM,              &sub.rpm_sensor,   update,              10, 200,  66),
 #endif
     SCHED_TASK(terrain_update,        10,    100,  72),
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    SCHED_TASK(update_dynamic_notch_at_specified_rate_main, LOOP_RATE, 200, 73),
+#endif
 #if AP_STATS_ENABLED
     SCHED_TASK(stats_update,           1,    200,  76),
 #endif
@@ -179,10 +183,17 @@ constexpr int8_t Sub::_failsafe_priorities[5];
 void Sub::run_rate_controller()
 {
     const float last_loop_time_s = AP::scheduler().get_last_loop_time_s();
-    motors.set_dt(last_loop_time_s);
     attitude_control.set_dt(last_loop_time_s);
     pos_control.set_dt(last_loop_time_s);
 
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // the rate thread runs the rate controller and motors
+    if (using_rate_thread) {
+        return;
+    }
+#endif
+    motors.set_dt(last_loop_time_s);
+
     //don't run rate controller in manual or motordetection modes
     if (control_mode != Mode::Number::MANUAL && control_mode != Mode::Number::MOTOR_DETECT) {
         // run low level rate controllers that only require IMU data and set loop time
@@ -343,8 +354,26 @@ void Sub::one_hz_loop()
     // learning to run
     set_likely_flying(hal.util->get_soft_armed());
 
-    attitude_control.set_notch_sample_rate(AP::scheduler().get_filtered_loop_rate_hz());
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    if (!using_rate_thread)
+#endif
+    {
+        attitude_control.set_notch_sample_rate(AP::scheduler().get_filtered_loop_rate_hz());
+    }
     pos_control.get_accel_U_pid().set_notch_sample_rate(AP::scheduler().get_filtered_loop_rate_hz());
+
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // see if we should have a separate rate thread
+    if (!started_rate_thread && g2.fast_rate_enable > 0) {
+        if (hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&Sub::rate_controller_thread, void),
+                                         "rate",
+                                         1536, AP_HAL::Scheduler::PRIORITY_RCOUT, 1)) {
+            started_rate_thread = true;
+        } else {
+            AP_BoardConfig::allocation_error("rate thread");
+        }
+    }
+#endif
 }
 
 void Sub::read_AHRS()
@@ -356,12 +385,9 @@ void Sub::read_AHRS()
     ahrs_view.update();
 }
 
-// read baro and rangefinder altitude at 10hz
+// log altitude at 10hz, the depth sensor is read at 50hz by read_barometer
 void Sub::update_altitude()
 {
-    // read in baro altitude
-    read_barometer();
-
 #if HAL_LOGGING_ENABLED
     if (should_log(MASK_LOG_CTUN)) {
         Log_Write_Control_Tuning();
@@ -42,6 +42,7 @@
 #include <AP_Baro/AP_Baro.h>
 #include <AP_Compass/AP_Compass.h>         // ArduPilot Mega Magnetometer Library
 #include <AP_InertialSensor/AP_InertialSensor.h>  // ArduPilot Mega Inertial Sensor (accel & gyro) Library
+#include <AP_InertialSensor/AP_InertialSensor_rate_config.h>
 #include <AP_AHRS/AP_AHRS.h>
 #include <AP_Mission/AP_Mission.h>         // Mission command library
 #include <AC_AttitudeControl/AC_AttitudeControl_Sub.h> // Attitude control library
@@ -398,6 +399,16 @@ private:
     static const struct LogStructure log_structure[];
 
     void run_rate_controller();
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // rate_thread.cpp
+    void rate_controller_thread();
+    void enable_fast_rate_loop(uint8_t rate_decimation);
+    void disable_fast_rate_loop();
+    void rate_controller_filter_update();
+    void update_dynamic_notch_at_specified_rate_main();
+    bool started_rate_thread;
+    bool using_rate_thread;
+#endif
     void fifty_hz_loop();
     void update_batt_compass(void);
     void ten_hz_logging_loop();
@@ -483,7 +494,8 @@ private:
     void update_surface_and_bottom_detector();
     void set_surfaced(bool at_surface);
     void set_bottomed(bool at_bottom);
-    void motors_output();
+    void motors_output(bool full_push = true);
+    void motors_output_main();
     void init_rc_in();
     void init_rc_out();
 #if AP_SUB_RC_ENABLED
@@ -7,7 +7,8 @@ void Sub::enable_motor_output()
 }
 
 // motors_output - send output to motors library which will adjust and send to ESCs and servos
-void Sub::motors_output()
+// full_push is false from the rate thread between main loop runs, when only the motor outputs need pushing
+void Sub::motors_output(bool full_push)
 {
     // Motor detection mode controls the thrusters directly
     if (control_mode == Mode::Number::MOTOR_DETECT){
@@ -23,8 +24,23 @@ void Sub::motors_output()
         SRV_Channels::calc_pwm();
         SRV_Channels::output_ch_all();
         motors.output();
-        srv.push();
+        if (full_push) {
+            srv.push();
+        } else {
+            hal.rcout->push();
+        }
+    }
+}
+
+// motors_output from main thread at main loop rate
+void Sub::motors_output_main()
+{
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    if (using_rate_thread) {
+        return;
     }
+#endif
+    motors_output();
 }
 
 // Initialize new style motor test
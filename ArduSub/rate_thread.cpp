@@ -0,0 +1,129 @@
+#include "Sub.h"
+
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+
+/*
+  Sub fast rate thread, following the design of the Copter rate
+  thread (see ArduCopter/rate_thread.cpp).
+
+  When FSTRATE_ENABLE is set the rate controller and the thruster
+  outputs run in this thread on every filtered gyro sample divided by
+  FSTRATE_DIV, so the 6DOF thruster mix follows the gyro with the least
+  possible delay. The attitude and position controllers, pilot input
+  and depth hold stay in the main loop and only set the rate targets
+  and throttle used here.
+
+  The thread gives the thrusters back to the main loop during a motor
+  test and in MOTOR_DETECT mode, both of which drive the thrusters
+  directly.
+ */
+
+#define DIV_ROUND_INT(x, d) ((x + d/2) / d)
+
+/*
+  thread for rate control
+*/
+void Sub::rate_controller_thread()
+{
+    uint8_t filter_loop_count = 0;
+    uint8_t main_loop_count = 0;
+    uint8_t active_decimation = 0;
+
+    while (true) {
+        const uint8_t rate_decimation = constrain_int16(g2.fast_rate_div.get(), 1,
+                                                        DIV_ROUND_INT(ins.get_raw_gyro_rate_hz(), AP::scheduler().get_loop_rate_hz()));
+
+        if (g2.fast_rate_enable <= 0 || ap.motor_test || control_mode == Mode::Number::MOTOR_DETECT) {
+            if (using_rate_thread) {
+                disable_fast_rate_loop();
+            }
+            hal.scheduler->delay_microseconds(500);
+            continue;
+        }
+
+        if (!using_rate_thread || rate_decimation != active_decimation) {
+            enable_fast_rate_loop(rate_decimation);
+            active_decimation = rate_decimation;
+        }
+
+        // wait for an IMU sample
+        Vector3f gyro;
+        if (!ins.get_next_gyro_sample(gyro)) {
+            continue;   // go around again
+        }
+
+        // we must use multiples of the actual sensor rate
+        const float sensor_dt = 1.0f * rate_decimation / ins.get_raw_gyro_rate_hz();
+
+        // don't run rate controller in manual mode, the pilot input is mixed directly
+        if (control_mode != Mode::Number::MANUAL) {
+            attitude_control.rate_controller_run_dt(gyro + ahrs.get_gyro_drift(), sensor_dt);
+        }
+
+        // immediately output the new thruster values, the other
+        // servo outputs are only pushed at the main loop rate
+        const uint8_t main_loop_decimation = MAX(uint8_t(DIV_ROUND_INT(ins.get_raw_gyro_rate_hz() / rate_decimation, AP::scheduler().get_loop_rate_hz())), 1U);
+        if (++main_loop_count >= main_loop_decimation) {
+            main_loop_count = 0;
+            motors_output(true);
+        } else {
+            motors_output(false);
+        }
+
+        // run the filters at half the gyro rate
+        if (++filter_loop_count >= MAX(uint8_t(DIV_ROUND_INT(ins.get_raw_gyro_rate_hz() / rate_decimation, ins.get_raw_gyro_rate_hz() / 2)), 1U)) {
+            filter_loop_count = 0;
+            rate_controller_filter_update();
+        }
+    }
+}
+
+// enable the fast rate thread using the provided decimation rate
+void Sub::enable_fast_rate_loop(uint8_t rate_decimation)
+{
+    const uint32_t attitude_rate = ins.get_raw_gyro_rate_hz() / rate_decimation;
+
+    ins.enable_fast_rate_buffer();
+    ins.set_rate_decimation(rate_decimation);
+    attitude_control.set_notch_sample_rate(attitude_rate);
+    hal.rcout->set_dshot_rate(SRV_Channels::get_dshot_rate(), attitude_rate);
+    motors.set_dt(1.0f / attitude_rate);
+    hal.rcout->force_trigger_groups(true);
+    using_rate_thread = true;
+}
+
+// disable the fast rate thread and return to main loop rate outputs
+void Sub::disable_fast_rate_loop()
+{
+    using_rate_thread = false;
+    attitude_control.set_notch_sample_rate(AP::scheduler().get_filtered_loop_rate_hz());
+    hal.rcout->set_dshot_rate(SRV_Channels::get_dshot_rate(), AP::scheduler().get_loop_rate_hz());
+    hal.rcout->force_trigger_groups(false);
+    ins.disable_fast_rate_buffer();
+}
+
+/*
+  update rate controller filters
+*/
+void Sub::rate_controller_filter_update()
+{
+    // update the frontend center frequencies of notch filters
+    for (auto &notch : ins.harmonic_notches) {
+        update_dynamic_notch(notch);
+    }
+
+    // this copies backend data to the frontend and updates the notches
+    ins.update_backend_filters();
+}
+
+// run notch update at either loop rate or 200Hz
+void Sub::update_dynamic_notch_at_specified_rate_main()
+{
+    if (using_rate_thread) {
+        return;
+    }
+
+    update_dynamic_notch_at_specified_rate();
+}
+
+#endif // AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
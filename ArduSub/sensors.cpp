@@ -1,6 +1,7 @@
 #include "Sub.h"
 
-// return barometric altitude in centimeters
+// read the depth sensor and any other barometers, called at 50Hz so
+// the EKF gets each new depth sample with little delay
 void Sub::read_barometer()
 {
     barometer.update();
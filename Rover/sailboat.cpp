@@ -4,6 +4,10 @@
 #define SAILBOAT_TACKING_ACCURACY_DEG 10        // tack is considered complete when vehicle is within this many degrees of target tack angle
 #define SAILBOAT_NOGO_PAD 10                    // deg, the no go zone is padded by this much when deciding if we should use the Sailboat heading controller
 #define TACK_RETRY_TIME_MS 5000                 // Can only try another auto mode tack this many milliseconds after the last is cleared (either competed or timed-out)
+#define SAILBOAT_POLAR_CLOSE_HAULED 0.7f        // polar speed ratio when sailing at the no go angle
+#define SAILBOAT_POLAR_BEAM_DEG 100             // deg, true wind angle of best polar speed
+#define SAILBOAT_POLAR_RUN 0.75f                // polar speed ratio when running dead downwind
+#define SAILBOAT_VMG_TACK_RATIO 0.5f            // tack if the VMG on the current tack is less than this fraction of the other tack's
 /*
 To Do List
  - Improve tacking in light winds and bearing away in strong wings
@@ -320,6 +324,63 @@ float Sailboat::get_VMG() const
     return (speed * cosf(wrap_PI(radians(rover.g2.wp_nav.wp_bearing_cd() * 0.01f) - rover.ahrs.get_yaw())));
 }
 
+// rebuild the polar performance table if the no go angle has changed
+// the table holds the boat speed as a fraction of its best speed at true wind angles evenly spaced from the no go angle to dead downwind
+void Sailboat::update_polar()
+{
+    const float no_go_deg = constrain_float(sail_no_go, 0.0f, 90.0f);
+    if (is_equal(no_go_deg, polar.no_go_deg)) {
+        return;
+    }
+    polar.no_go_deg = no_go_deg;
+
+    const float step_deg = (180.0f - no_go_deg) / (SAILBOAT_POLAR_POINTS - 1);
+    for (uint8_t i = 0; i < SAILBOAT_POLAR_POINTS; i++) {
+        const float twa_deg = no_go_deg + i * step_deg;
+        float ratio;
+        if (twa_deg <= SAILBOAT_POLAR_BEAM_DEG) {
+            // speed builds as the boat bears away from close hauled
+            const float prop = (twa_deg - no_go_deg) / MAX(SAILBOAT_POLAR_BEAM_DEG - no_go_deg, 1.0f);
+            ratio = SAILBOAT_POLAR_CLOSE_HAULED + (1.0f - SAILBOAT_POLAR_CLOSE_HAULED) * sinf(M_PI_2 * prop);
+        } else {
+            // and drops off again towards a dead run
+            const float prop = (twa_deg - SAILBOAT_POLAR_BEAM_DEG) / (180.0f - SAILBOAT_POLAR_BEAM_DEG);
+            ratio = 1.0f - (1.0f - SAILBOAT_POLAR_RUN) * sq(prop);
+        }
+        const float twa_rad = radians(twa_deg);
+        polar.ratio[i] = ratio;
+        polar.cos_twa[i] = cosf(twa_rad);
+        polar.sin_twa[i] = sinf(twa_rad);
+    }
+}
+
+// find the heading on the given tack with the best velocity made good towards bearing_rad
+// all candidate headings are evaluated from one sin/cos of the wind angle to the bearing
+// returns the heading in radians and the VMG as a fraction of the best boat speed
+float Sailboat::calc_best_vmg_heading(float bearing_rad, float true_wind_rad, AP_WindVane::Sailboat_Tack tack, float &vmg) const
+{
+    // port tack headings are to the left of the wind looking upwind, starboard to the right
+    const float sign = (tack == AP_WindVane::Sailboat_Tack::TACK_PORT) ? 1.0f : -1.0f;
+
+    // cos(heading - bearing) = cos(wind - bearing + sign * twa)
+    const float wind_to_bearing_rad = true_wind_rad - bearing_rad;
+    const float cos_d = cosf(wind_to_bearing_rad);
+    const float sin_d = sign * sinf(wind_to_bearing_rad);
+
+    uint8_t best = 0;
+    vmg = -1.0f;
+    for (uint8_t i = 0; i < SAILBOAT_POLAR_POINTS; i++) {
+        const float candidate_vmg = polar.ratio[i] * (cos_d * polar.cos_twa[i] - sin_d * polar.sin_twa[i]);
+        if (candidate_vmg > vmg) {
+            vmg = candidate_vmg;
+            best = i;
+        }
+    }
+
+    const float step_deg = (180.0f - polar.no_go_deg) / (SAILBOAT_POLAR_POINTS - 1);
+    return wrap_2PI(true_wind_rad + sign * radians(polar.no_go_deg + best * step_deg));
+}
+
 // handle user initiated tack while in acro mode
 void Sailboat::handle_tack_request_acro()
 {
@@ -459,22 +520,26 @@ float Sailboat::calc_heading(float desired_heading_cd)
         }
     }
 
-    // calculate left and right no go headings looking upwind, Port tack heading is left no-go, STBD tack is right of no-go
-    const float left_no_go_heading_rad = wrap_2PI(true_wind_rad + radians(sail_no_go));
-    const float right_no_go_heading_rad = wrap_2PI(true_wind_rad - radians(sail_no_go));
+    // find the best VMG heading towards the destination on each tack
+    update_polar();
+    const AP_WindVane::Sailboat_Tack other_tack = (current_tack == AP_WindVane::Sailboat_Tack::TACK_PORT) ?
+                                                  AP_WindVane::Sailboat_Tack::TACK_STARBOARD : AP_WindVane::Sailboat_Tack::TACK_PORT;
+    float current_vmg, other_vmg;
+    const float current_tack_heading_rad = calc_best_vmg_heading(desired_heading_rad, true_wind_rad, current_tack, current_vmg);
+    const float other_tack_heading_rad = calc_best_vmg_heading(desired_heading_rad, true_wind_rad, other_tack, other_vmg);
+
+    // trigger tack if the other tack makes much better progress, while well inside the cross track corridor
+    if (!should_tack && !currently_tacking && is_positive(other_vmg) &&
+        (current_vmg < SAILBOAT_VMG_TACK_RATIO * other_vmg) &&
+        (is_zero(xtrack_max) || fabsf(cross_track_error) < 0.5f * xtrack_max)) {
+        should_tack = true;
+    }
 
     // if tack triggered, calculate target heading
     if (should_tack && (now - tack_clear_ms) > TACK_RETRY_TIME_MS) {
         gcs().send_text(MAV_SEVERITY_INFO, "Sailboat: Tacking");
-        // calculate target heading for the new tack
-        switch (current_tack) {
-            case AP_WindVane::Sailboat_Tack::TACK_PORT:
-                tack_heading_rad = right_no_go_heading_rad;
-                break;
-            case AP_WindVane::Sailboat_Tack::TACK_STARBOARD:
-                tack_heading_rad = left_no_go_heading_rad;
-                break;
-        }
+        // target the best heading on the new tack
+        tack_heading_rad = other_tack_heading_rad;
         currently_tacking = true;
         auto_tack_start_ms = now;
     }
@@ -498,12 +563,8 @@ float Sailboat::calc_heading(float desired_heading_cd)
         return degrees(tack_heading_rad) * 100.0f;
     }
 
-    // return the correct heading for our current tack
-    if (current_tack == AP_WindVane::Sailboat_Tack::TACK_PORT) {
-        return degrees(left_no_go_heading_rad) * 100.0f;
-    } else {
-        return degrees(right_no_go_heading_rad) * 100.0f;
-    }
+    // return the best heading for our current tack
+    return degrees(current_tack_heading_rad) * 100.0f;
 }
 
 // set state of motor
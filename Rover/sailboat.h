@@ -16,6 +16,9 @@
 /*
     Rover Sailboat functionality
 */
+
+#include <AP_WindVane/AP_WindVane.h>
+
 class Sailboat
 {
 public:
@@ -97,6 +100,12 @@ private:
     // true if motor should be on to assist with low wind
     bool motor_assist_low_wind() const;
 
+    // rebuild the polar performance table if the no go angle has changed
+    void update_polar();
+
+    // heading on the given tack with the best velocity made good towards bearing_rad
+    float calc_best_vmg_heading(float bearing_rad, float true_wind_rad, AP_WindVane::Sailboat_Tack tack, float &vmg) const;
+
     // parameters
     AP_Int8 enable;
     AP_Float sail_angle_min;
@@ -116,4 +125,13 @@ private:
     uint32_t tack_clear_ms;         // system time when tack was cleared
     bool tack_assist;               // true if we should use some throttle to assist tack
     UseMotor motor_state;           // current state of motor output
+
+    // polar performance table, from the no go angle to dead downwind
+    static const uint8_t SAILBOAT_POLAR_POINTS = 19;
+    struct {
+        float no_go_deg = -1;       // no go angle the table was built for
+        float ratio[SAILBOAT_POLAR_POINTS];    // boat speed as a fraction of its best speed
+        float cos_twa[SAILBOAT_POLAR_POINTS];  // cosine of each true wind angle
+        float sin_twa[SAILBOAT_POLAR_POINTS];  // sine of each true wind angle
+    } polar;
 };
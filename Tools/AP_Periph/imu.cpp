@@ -5,20 +5,24 @@
 
 extern const AP_HAL::HAL &hal;
 
+// lowest rate with a sample period that fits the uint16_t microsecond
+// delay used by AP_InertialSensor::wait_for_sample()
+#define IMU_WAIT_FOR_SAMPLE_MIN_RATE_HZ 16
+
 /*
   update CAN magnetometer
  */
 void AP_Periph_FW::can_imu_update(void)
 {
     while (true) {
-        // we need to delay by a ms value as hal->schedule->delay_microseconds_boost
-        // used in wait_for_sample() takes uint16_t
-        const uint32_t delay_ms = 1000U / g.imu_sample_rate;
-        hal.scheduler->delay(delay_ms);
-
-        if (delay_ms == 0) {
-            // sleep for a bit to avoid flooding the CPU
-            hal.scheduler->delay_microseconds(100);
+        if (g.imu_sample_rate >= IMU_WAIT_FOR_SAMPLE_MIN_RATE_HZ) {
+            // pace the thread on the sensor samples at the rate given
+            // to imu.init(), rather than polling with millisecond delays
+            imu.wait_for_sample();
+        } else {
+            // we need to delay by a ms value as hal->schedule->delay_microseconds_boost
+            // used in wait_for_sample() takes uint16_t
+            hal.scheduler->delay(1000U / g.imu_sample_rate);
         }
 
         imu.update();
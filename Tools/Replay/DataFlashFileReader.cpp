@@ -9,6 +9,9 @@
 #include <unistd.h>
 #include <time.h>
 #include <cinttypes>
+#if AP_REPLAY_MMAP_ENABLED
+#include <sys/mman.h>
+#endif
 
 #ifndef PRIu64
 #define PRIu64 "llu"
@@ -20,10 +23,59 @@ AP_LoggerFileReader::AP_LoggerFileReader()
 AP_LoggerFileReader::~AP_LoggerFileReader()
 {
     ::printf("Replay counts: %" PRIu64 " bytes  %u entries\n", bytes_read, message_count);
+#if AP_REPLAY_MMAP_ENABLED
+    if (map_base != nullptr) {
+        munmap(map_base, file_size);
+    }
+#endif
+}
+
+#if AP_REPLAY_MMAP_ENABLED
+/*
+  map the log file into memory. The mapping is private so message
+  handlers may still modify the message they are passed
+ */
+bool AP_LoggerFileReader::open_log_mmap(const char *logfile)
+{
+    const int map_fd = ::open(logfile, O_RDONLY|O_CLOEXEC);
+    if (map_fd == -1) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(map_fd, &st) != 0 || st.st_size <= 0) {
+        ::close(map_fd);
+        return false;
+    }
+    void *p = mmap(nullptr, st.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, map_fd, 0);
+    ::close(map_fd);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    madvise(p, st.st_size, MADV_SEQUENTIAL);
+    map_base = (uint8_t *)p;
+    file_size = st.st_size;
+    return true;
+}
+
+uint8_t *AP_LoggerFileReader::map_input(size_t count)
+{
+    if (bytes_read + count > file_size) {
+        bytes_read = file_size;
+        return nullptr;
+    }
+    uint8_t *ret = &map_base[bytes_read];
+    bytes_read += count;
+    return ret;
 }
+#endif // AP_REPLAY_MMAP_ENABLED
 
 bool AP_LoggerFileReader::open_log(const char *logfile)
 {
+#if AP_REPLAY_MMAP_ENABLED
+    if (open_log_mmap(logfile)) {
+        return true;
+    }
+#endif
     fd = AP::FS().open(logfile, O_RDONLY);
     if (fd == -1) {
         return false;
@@ -38,6 +90,16 @@ bool AP_LoggerFileReader::open_log(const char *logfile)
 
 ssize_t AP_LoggerFileReader::read_input(void *buffer, const size_t count)
 {
+#if AP_REPLAY_MMAP_ENABLED
+    if (map_base != nullptr) {
+        const uint8_t *src = map_input(count);
+        if (src == nullptr) {
+            return 0;
+        }
+        memcpy(buffer, src, count);
+        return count;
+    }
+#endif
     uint64_t ret = AP::FS().read(fd, buffer, count);
     bytes_read += ret;
     return ret;
@@ -88,6 +150,12 @@ bool AP_LoggerFileReader::update()
         return handle_log_format_msg(f);
     }
 
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+    if (hdr[2] == LOG_COMPRESSED_MSG) {
+        return handle_compressed_msg();
+    }
+#endif
+
     const struct log_Format &f = formats[hdr[2]];
     if (f.length == 0) {
         // can't just throw these away as the format specifies the
@@ -96,16 +164,93 @@ bool AP_LoggerFileReader::update()
         exit(1);
     }
 
+#if AP_REPLAY_MMAP_ENABLED
+    if (map_base != nullptr) {
+        // hand the message to the handler directly from the mapping,
+        // the header has already been consumed
+        if (map_input(f.length-3) == nullptr) {
+            return false;
+        }
+        uint8_t *msg = &map_base[bytes_read - f.length];
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+        decompressor.store(msg, f.length);
+#endif
+        message_count++;
+        return handle_msg(f, msg);
+    }
+#endif
+
     uint8_t msg[f.length];
 
     memcpy(msg, hdr, 3);
     if (read_input(&msg[3], f.length-3) != f.length-3) {
         return false;
     }
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+    decompressor.store(msg, f.length);
+#endif
+
+    message_count++;
+    return handle_msg(f, msg);
+}
+
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+bool AP_LoggerFileReader::handle_compressed_msg(void)
+{
+    uint8_t type;
+    if (read_input(&type, 1) != 1) {
+        return false;
+    }
+    if (type == AP_Logger_Compressor::STREAM_HEADER) {
+        uint8_t version;
+        if (read_input(&version, 1) != 1) {
+            return false;
+        }
+        if (!decompressor.start(version)) {
+            printf("unsupported compressed log version %u\n", (unsigned)version);
+            return false;
+        }
+        return true;
+    }
+
+    const struct log_Format &f = formats[type];
+    if (f.length == 0) {
+        ::printf("No format defined for compressed type (%d)\n", type);
+        exit(1);
+    }
+    packet_counts[type]++;
+
+    uint8_t msg[f.length];
+    msg[0] = HEAD_BYTE1;
+    msg[1] = HEAD_BYTE2;
+    msg[2] = type;
+    uint16_t ofs = LOG_PACKET_HEADER_LEN;
+    while (ofs < f.length) {
+        uint8_t token;
+        if (read_input(&token, 1) != 1) {
+            return false;
+        }
+        const uint8_t count = AP_Logger_Compressor::token_count(token);
+        if (ofs + count > f.length) {
+            printf("bad compressed message\n");
+            return false;
+        }
+        if (AP_Logger_Compressor::token_is_zero_run(token)) {
+            memset(&msg[ofs], 0, count);
+        } else if (read_input(&msg[ofs], count) != count) {
+            return false;
+        }
+        ofs += count;
+    }
+    if (!decompressor.apply_delta(msg, f.length)) {
+        printf("compressed message without a base message\n");
+        return false;
+    }
 
     message_count++;
     return handle_msg(f, msg);
 }
+#endif // AP_LOGGER_FILE_COMPRESSION_ENABLED
 
 float AP_LoggerFileReader::get_percent_read()
 {
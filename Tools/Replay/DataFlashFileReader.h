@@ -1,9 +1,16 @@
 #pragma once
 
 #include <AP_Logger/AP_Logger.h>
+#include <AP_Logger/AP_Logger_Compressor.h>
 
 #define LOGREADER_MAX_FORMATS 255 // must be >= highest MESSAGE
 
+// on posix systems map the whole log into memory rather than reading
+// it a message at a time
+#ifndef AP_REPLAY_MMAP_ENABLED
+#define AP_REPLAY_MMAP_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
 class AP_LoggerFileReader
 {
 public:
@@ -29,6 +36,19 @@ protected:
 private:
     ssize_t read_input(void *buf, size_t count);
 
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+    // expand a LOG_COMPRESSED_MSG whose header has been consumed
+    bool handle_compressed_msg(void);
+    AP_Logger_Decompressor decompressor;
+#endif
+
+#if AP_REPLAY_MMAP_ENABLED
+    bool open_log_mmap(const char *logfile);
+    // return a pointer to the next count bytes of the mapped log
+    uint8_t *map_input(size_t count);
+    uint8_t *map_base = nullptr;
+#endif
+
     uint64_t bytes_read = 0;
     uint64_t file_size = 0; // Total size of the log file
     uint32_t message_count = 0;
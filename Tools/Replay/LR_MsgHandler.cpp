@@ -171,6 +171,12 @@ void LR_MsgHandler_REY3::process_message(uint8_t *msgbytes)
     ekf3.writeEulerYawAngle(msg.yawangle, msg.yawangleerr, msg.timestamp_ms, msg.type);
 }
 
+void LR_MsgHandler_RWS3::process_message(uint8_t *msgbytes)
+{
+    MSG_CREATE(RWS3, msgbytes);
+    ekf3.setWarmStartAttitude(msg.roll, msg.pitch, msg.yaw);
+}
+
 void LR_MsgHandler_RISH::process_message(uint8_t *msgbytes)
 {
     MSG_CREATE(RISH, msgbytes);
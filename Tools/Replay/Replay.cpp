@@ -26,6 +26,7 @@
 #include <AP_Filesystem/AP_Filesystem.h>
 #include <AP_Filesystem/posix_compat.h>
 #include <AP_AdvancedFailsafe/AP_AdvancedFailsafe.h>
+#include <AP_Common/ExpandingString.h>
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
 #include <AP_HAL_Linux/Scheduler.h>
@@ -129,11 +130,13 @@ void Replay::usage(void)
     ::printf("\t--force-ekf2 force enable EKF2\n");
     ::printf("\t--force-ekf3 force enable EKF3\n");
     ::printf("\t--progress  show a progress bar during replay\n");
+    ::printf("\t--perf  print the CPU time of each EKF3 update step at the end\n");
 }
 
 enum param_key : uint8_t {
     FORCE_EKF2 = 1,
     FORCE_EKF3,
+    PERF,
 };
 
 void Replay::_parse_command_line(uint8_t argc, char * const argv[])
@@ -146,6 +149,7 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
         {"force-ekf2",      false,  0, param_key::FORCE_EKF2},
         {"force-ekf3",      false,  0, param_key::FORCE_EKF3},
         {"progress",        false,  0, 'P'},
+        {"perf",            false,  0, param_key::PERF},
         {"help",            false,  0, 'h'},
         {0, false, 0, 0}
     };
@@ -185,6 +189,10 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
             show_progress = true;
             break;
 
+        case param_key::PERF:
+            show_perf = true;
+            break;
+
         case 'h':
         default:
             usage();
@@ -300,6 +308,15 @@ void Replay::setup()
 void Replay::loop()
 {
     if (!reader.update()) {
+#if EK3_FEATURE_PERF_ACCOUNTING
+        if (show_perf) {
+            ExpandingString str;
+            _vehicle.ekf3.perf_report(str);
+            if (!str.has_failed_allocation()) {
+                ::printf("%s", str.get_string());
+            }
+        }
+#endif
 #if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
     // If we don't tear down the threads then they continue to access
     // global state during object destruction.
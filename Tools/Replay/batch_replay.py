@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+
+'''
+Run Replay over many logs in parallel and print a single summary of
+the EKF3 innovation statistics of the replayed lanes.
+
+Each log is replayed in its own temporary directory so that parallel
+Replay processes do not write to the same logs/ directory.
+
+  Tools/Replay/batch_replay.py --jobs 8 fleet_logs/*.BIN
+'''
+
+import glob
+import math
+import multiprocessing
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from pymavlink import mavutil
+
+INNOVATION_FIELDS = ['IVN', 'IVE', 'IVD', 'IPN', 'IPE', 'IPD', 'IMX', 'IMY', 'IMZ', 'IYAW']
+
+
+class InnovationStats(object):
+    '''running statistics for a single innovation field'''
+    def __init__(self):
+        self.count = 0
+        self.sum = 0.0
+        self.sum_sq = 0.0
+        self.max_abs = 0.0
+
+    def add(self, value):
+        self.count += 1
+        self.sum += value
+        self.sum_sq += value * value
+        self.max_abs = max(self.max_abs, abs(value))
+
+    def merge(self, other):
+        self.count += other.count
+        self.sum += other.sum
+        self.sum_sq += other.sum_sq
+        self.max_abs = max(self.max_abs, other.max_abs)
+
+    def mean(self):
+        if self.count == 0:
+            return 0.0
+        return self.sum / self.count
+
+    def rms(self):
+        if self.count == 0:
+            return 0.0
+        return math.sqrt(self.sum_sq / self.count)
+
+
+def collect_innovations(logfile):
+    '''return a dict of InnovationStats for the replayed (C>=100) lanes'''
+    stats = {}
+    for f in INNOVATION_FIELDS:
+        stats[f] = InnovationStats()
+    mlog = mavutil.mavlink_connection(logfile)
+    while True:
+        m = mlog.recv_match(type='XKF3')
+        if m is None:
+            break
+        if m.C < 100:
+            continue
+        for f in INNOVATION_FIELDS:
+            if hasattr(m, f):
+                stats[f].add(getattr(m, f))
+    return stats
+
+
+def replay_one(args):
+    '''replay a single log, returning (logfile, error, stats)'''
+    (replay, logfile, extra_args) = args
+    logfile = os.path.abspath(logfile)
+    workdir = tempfile.mkdtemp(prefix="replay-")
+    try:
+        with open(os.path.join(workdir, "replay.out"), "w") as out:
+            ret = subprocess.call([replay] + extra_args + [logfile],
+                                  cwd=workdir,
+                                  stdout=out,
+                                  stderr=subprocess.STDOUT)
+        if ret != 0:
+            return (logfile, "Replay exited with %d" % ret, None)
+        outputs = sorted(glob.glob(os.path.join(workdir, "logs", "*.BIN")))
+        if len(outputs) != 1:
+            return (logfile, "expected a single output log, got %u" % len(outputs), None)
+        return (logfile, None, collect_innovations(outputs[0]))
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+
+def run(replay, logs, jobs, extra_args, progress=print):
+    totals = {}
+    for f in INNOVATION_FIELDS:
+        totals[f] = InnovationStats()
+    failures = []
+    pool = multiprocessing.Pool(processes=jobs)
+    work = [(replay, log, extra_args) for log in logs]
+    done = 0
+    for (logfile, error, stats) in pool.imap_unordered(replay_one, work):
+        done += 1
+        if error is not None:
+            failures.append((logfile, error))
+            progress("[%u/%u] %s: FAILED (%s)" % (done, len(logs), logfile, error))
+            continue
+        progress("[%u/%u] %s: OK" % (done, len(logs), logfile))
+        for f in INNOVATION_FIELDS:
+            totals[f].merge(stats[f])
+    pool.close()
+    pool.join()
+
+    progress("")
+    progress("%-6s %10s %12s %12s %12s" % ("Field", "Count", "Mean", "RMS", "MaxAbs"))
+    for f in INNOVATION_FIELDS:
+        s = totals[f]
+        progress("%-6s %10u %12.5f %12.5f %12.5f" % (f, s.count, s.mean(), s.rms(), s.max_abs))
+    progress("Replayed %u/%u logs" % (len(logs) - len(failures), len(logs)))
+    for (logfile, error) in failures:
+        progress("  %s: %s" % (logfile, error))
+    return len(failures) == 0
+
+
+if __name__ == '__main__':
+    from argparse import ArgumentParser
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("--replay", default="build/sitl/tool/Replay", help="path to Replay binary")
+    parser.add_argument("--jobs", type=int, default=multiprocessing.cpu_count(), help="number of parallel Replay processes")
+    parser.add_argument("--parm", action='append', default=[], help="NAME=VALUE parameter passed to each Replay run")
+    parser.add_argument("logs", metavar="LOG", nargs="+")
+
+    args = parser.parse_args()
+
+    replay = os.path.abspath(args.replay)
+    if not os.path.exists(replay):
+        print("Replay binary %s not found, build with ./waf replay" % replay)
+        sys.exit(1)
+
+    extra_args = []
+    for p in args.parm:
+        extra_args.extend(["--parm", p])
+
+    if not run(replay, args.logs, args.jobs, extra_args):
+        print("FAILED")
+        sys.exit(1)
+    print("Passed")
+    sys.exit(0)
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+
+'''
+Measure the CPU cost of EKF3 by replaying a set of reference logs with
+Replay --perf, and print the time taken by each update step of each
+lane.
+
+Each log is replayed --repeat times, one at a time so runs do not
+compete for the CPU, and the fastest run is kept. A summary can be
+saved and later runs compared against it to quantify an optimisation
+or catch a regression:
+
+  Tools/Replay/bench_replay.py --save base.json ref_logs/*.BIN
+  Tools/Replay/bench_replay.py --compare base.json ref_logs/*.BIN
+'''
+
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+def replay_perf(replay, logfile, extra_args):
+    '''replay a single log, returning a dict of (lane, step) -> (calls, total_us, max_us)'''
+    workdir = tempfile.mkdtemp(prefix="replay-bench-")
+    try:
+        out = subprocess.check_output([replay, "--perf"] + extra_args + [os.path.abspath(logfile)],
+                                      cwd=workdir,
+                                      stderr=subprocess.STDOUT)
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+    ret = {}
+    for line in out.decode('utf-8', 'replace').splitlines():
+        w = line.split()
+        if len(w) != 8 or w[0] != 'EK3PERF' or w[1] == 'lane':
+            continue
+        ret[(int(w[1]), w[3])] = (int(w[4]), float(w[5]), float(w[7]))
+    return ret
+
+
+def run(replay, logs, repeat, extra_args):
+    '''return a dict of "lane step" -> [calls, total_us, max_us] summed over logs'''
+    totals = {}
+    for log in logs:
+        best = None
+        for i in range(repeat):
+            perf = replay_perf(replay, log, extra_args)
+            total = sum(v[1] for (k, v) in perf.items() if k[1] == 'UpdateFilter')
+            if best is None or total < best[0]:
+                best = (total, perf)
+        print("%s: %.1f ms" % (log, best[0] * 1.0e-3))
+        for ((lane, step), (calls, total_us, max_us)) in best[1].items():
+            key = "%u %s" % (lane, step)
+            t = totals.setdefault(key, [0, 0.0, 0.0])
+            t[0] += calls
+            t[1] += total_us
+            t[2] = max(t[2], max_us)
+    return totals
+
+
+def print_summary(totals, baseline=None):
+    print("")
+    print("%-4s %-18s %10s %12s %10s %10s %8s" % ("Lane", "Step", "Calls", "Total(ms)", "Mean(us)", "Max(us)", "Change"))
+    for key in sorted(totals.keys(), key=lambda k: (int(k.split()[0]), k.split()[1])):
+        (calls, total_us, max_us) = totals[key]
+        (lane, step) = key.split()
+        change = ""
+        if baseline is not None and key in baseline and baseline[key][1] > 0:
+            change = "%+.1f%%" % (100.0 * (total_us - baseline[key][1]) / baseline[key][1])
+        print("%-4s %-18s %10u %12.1f %10.2f %10.1f %8s" % (lane, step, calls, total_us * 1.0e-3,
+                                                           total_us / max(calls, 1), max_us, change))
+
+
+if __name__ == '__main__':
+    from argparse import ArgumentParser
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("--replay", default="build/sitl/tool/Replay", help="path to Replay binary")
+    parser.add_argument("--repeat", type=int, default=3, help="number of runs of each log, the fastest is kept")
+    parser.add_argument("--parm", action='append', default=[], help="NAME=VALUE parameter passed to each Replay run")
+    parser.add_argument("--save", default=None, help="save the summary to this JSON file")
+    parser.add_argument("--compare", default=None, help="compare against a summary saved with --save")
+    parser.add_argument("logs", metavar="LOG", nargs="+")
+
+    args = parser.parse_args()
+
+    replay = os.path.abspath(args.replay)
+    if not os.path.exists(replay):
+        print("Replay binary %s not found, build with ./waf replay" % replay)
+        sys.exit(1)
+
+    extra_args = []
+    for p in args.parm:
+        extra_args.extend(["--parm", p])
+
+    baseline = None
+    if args.compare is not None:
+        with open(args.compare) as f:
+            baseline = json.load(f)
+
+    totals = run(replay, args.logs, args.repeat, extra_args)
+    print_summary(totals, baseline)
+
+    if args.save is not None:
+        with open(args.save, "w") as f:
+            json.dump(totals, f, indent=1)
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+
+'''
+Expand a delta-compressed dataflash log (LOG_FILE_CMPRS=1) into a
+normal log. See libraries/AP_Logger/README.md for the stream format.
+
+  Tools/Replay/decompress_log.py 00000012.BIN 00000012-plain.BIN
+'''
+
+import struct
+import sys
+
+HEAD1 = 0xA3
+HEAD2 = 0x95
+FORMAT_MSG = 128
+COMPRESSED_MSG = 255
+STREAM_HEADER = 255
+STREAM_VERSION = 1
+
+
+def decompress(data):
+    lengths = {FORMAT_MSG: 89}
+    last = {}
+    out = bytearray()
+    ofs = 0
+    while ofs < len(data):
+        if data[ofs] != HEAD1 or data[ofs+1] != HEAD2:
+            raise ValueError("bad header at offset %u" % ofs)
+        mtype = data[ofs+2]
+        if mtype != COMPRESSED_MSG:
+            if mtype not in lengths:
+                raise ValueError("no format for type %u at offset %u" % (mtype, ofs))
+            length = lengths[mtype]
+            msg = data[ofs:ofs+length]
+            if mtype == FORMAT_MSG:
+                (ftype, flength) = struct.unpack("<BB", msg[3:5])
+                lengths[ftype] = flength
+            else:
+                last[mtype] = msg
+            out += msg
+            ofs += length
+            continue
+
+        mtype = data[ofs+3]
+        ofs += 4
+        if mtype == STREAM_HEADER:
+            if data[ofs] != STREAM_VERSION:
+                raise ValueError("unsupported stream version %u" % data[ofs])
+            ofs += 1
+            continue
+        if mtype not in last:
+            raise ValueError("compressed type %u without base at offset %u" % (mtype, ofs))
+        prev = last[mtype]
+        length = lengths[mtype]
+        msg = bytearray(prev[0:3])
+        while len(msg) < length:
+            token = data[ofs]
+            ofs += 1
+            count = (token & 0x7F) + 1
+            if token & 0x80:
+                delta = bytes(count)
+            else:
+                delta = data[ofs:ofs+count]
+                ofs += count
+            i = len(msg)
+            msg += bytes(a ^ b for (a, b) in zip(delta, prev[i:i+count]))
+        if len(msg) != length:
+            raise ValueError("bad compressed message at offset %u" % ofs)
+        msg = bytes(msg)
+        last[mtype] = msg
+        out += msg
+    return out
+
+
+if __name__ == '__main__':
+    from argparse import ArgumentParser
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("infile")
+    parser.add_argument("outfile")
+    args = parser.parse_args()
+
+    with open(args.infile, "rb") as f:
+        data = f.read()
+    out = decompress(data)
+    with open(args.outfile, "wb") as f:
+        f.write(out)
+    print("Expanded %u bytes to %u bytes" % (len(data), len(out)))
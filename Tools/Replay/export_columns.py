@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+
+'''
+Export a dataflash log into one file per message field so analysis
+only has to read the fields it needs, plus a per-type index of message
+offsets for random access into the original log.
+
+  Tools/Replay/export_columns.py 00000012.BIN 00000012-cols
+  Tools/Replay/export_columns.py --types IMU,XKF1 00000012.BIN 00000012-cols
+
+The output directory holds:
+
+  manifest.json      message types, fields, numpy dtypes and scales
+  TYPE.offsets       uint64 byte offset in the log of each TYPE message
+  TYPE.FIELD         the raw little-endian values of FIELD, one per message
+
+Column files are the field bytes exactly as logged, so they can be read
+with e.g. numpy.fromfile("IMU.GyrX", dtype="<f4"). Multiply by "scale"
+from the manifest to get the logged units (e.g. 1e-7 for lat/lon).
+Compressed logs (LOG_FILE_CMPRS=1) must be expanded with
+decompress_log.py first.
+'''
+
+import json
+import mmap
+import os
+import struct
+import sys
+
+HEAD1 = 0xA3
+HEAD2 = 0x95
+FORMAT_MSG = 128
+COMPRESSED_MSG = 255
+
+# flush a column to disk once this many bytes are buffered
+FLUSH_BYTES = 1 << 20
+
+# dataflash format character: (size, numpy dtype, scale[, array length])
+FORMAT_TYPES = {
+    'a': (64, '<i2', 1, 32),
+    'b': (1, 'i1', 1),
+    'B': (1, 'u1', 1),
+    'h': (2, '<i2', 1),
+    'H': (2, '<u2', 1),
+    'i': (4, '<i4', 1),
+    'I': (4, '<u4', 1),
+    'f': (4, '<f4', 1),
+    'd': (8, '<f8', 1),
+    'n': (4, 'S4', 1),
+    'N': (16, 'S16', 1),
+    'Z': (64, 'S64', 1),
+    'c': (2, '<i2', 0.01),
+    'C': (2, '<u2', 0.01),
+    'e': (4, '<i4', 0.01),
+    'E': (4, '<u4', 0.01),
+    'L': (4, '<i4', 1.0e-7),
+    'M': (1, 'u1', 1),
+    'q': (8, '<i8', 1),
+    'Q': (8, '<u8', 1),
+    'g': (2, '<f2', 1),
+}
+
+
+class Column(object):
+    '''one field of one message type'''
+    def __init__(self, path, name, fmt, offset):
+        self.path = path
+        self.name = name
+        self.fmt = fmt
+        self.offset = offset
+        self.size = FORMAT_TYPES[fmt][0]
+        self.buf = bytearray()
+        with open(self.path, "wb"):
+            pass
+
+    def add(self, data, ofs):
+        start = ofs + self.offset
+        self.buf += data[start:start+self.size]
+        if len(self.buf) >= FLUSH_BYTES:
+            self.flush()
+
+    def flush(self):
+        if len(self.buf) == 0:
+            return
+        with open(self.path, "ab") as f:
+            f.write(self.buf)
+        self.buf = bytearray()
+
+    def manifest(self):
+        info = FORMAT_TYPES[self.fmt]
+        ret = {"name": self.name, "format": self.fmt, "dtype": info[1], "scale": info[2]}
+        if len(info) > 3:
+            ret["shape"] = [info[3]]
+        return ret
+
+
+class MessageType(object):
+    '''index and columns for one message type'''
+    def __init__(self, outdir, name, length, fmt, labels, export):
+        self.name = name
+        self.length = length
+        self.fmt = fmt
+        self.labels = labels
+        self.count = 0
+        self.offsets = bytearray()
+        self.offsets_path = os.path.join(outdir, name + ".offsets")
+        with open(self.offsets_path, "wb"):
+            pass
+        self.columns = []
+        if not export:
+            return
+        ofs = 3
+        for (c, label) in zip(fmt, labels):
+            if c not in FORMAT_TYPES:
+                raise ValueError("unknown format character %s in %s" % (c, name))
+            self.columns.append(Column(os.path.join(outdir, name + "." + label), label, c, ofs))
+            ofs += FORMAT_TYPES[c][0]
+
+    def add(self, data, ofs):
+        self.count += 1
+        self.offsets += struct.pack("<Q", ofs)
+        if len(self.offsets) >= FLUSH_BYTES:
+            self.flush()
+        for col in self.columns:
+            col.add(data, ofs)
+
+    def flush(self):
+        if len(self.offsets) != 0:
+            with open(self.offsets_path, "ab") as f:
+                f.write(self.offsets)
+            self.offsets = bytearray()
+        for col in self.columns:
+            col.flush()
+
+    def manifest(self):
+        return {
+            "length": self.length,
+            "format": self.fmt,
+            "count": self.count,
+            "columns": [c.manifest() for c in self.columns],
+        }
+
+
+def export(data, outdir, types=None):
+    '''export the log in data to outdir, returning the message types found'''
+    lengths = {FORMAT_MSG: 89}
+    by_id = {}
+    ofs = 0
+    n = len(data)
+    while ofs + 3 <= n:
+        if data[ofs] != HEAD1 or data[ofs+1] != HEAD2:
+            # resync on the next header, as the readers do
+            ofs += 1
+            continue
+        mtype = data[ofs+2]
+        if mtype == COMPRESSED_MSG:
+            raise ValueError("compressed log, expand it with decompress_log.py first")
+        length = lengths.get(mtype)
+        if length is None or ofs + length > n:
+            ofs += 1
+            continue
+        if mtype == FORMAT_MSG:
+            (ftype, flength, name, fmt, labels) = struct.unpack("<BB4s16s64s", data[ofs+3:ofs+89])
+            name = name.rstrip(b'\0').decode('ascii', 'replace')
+            fmt = fmt.rstrip(b'\0').decode('ascii', 'replace')
+            labels = labels.rstrip(b'\0').decode('ascii', 'replace').split(',')
+            lengths[ftype] = flength
+            if ftype != FORMAT_MSG and ftype not in by_id:
+                by_id[ftype] = MessageType(outdir, name, flength, fmt, labels,
+                                           types is None or name in types)
+        elif mtype in by_id:
+            by_id[mtype].add(data, ofs)
+        ofs += length
+
+    for m in by_id.values():
+        m.flush()
+    return by_id
+
+
+if __name__ == '__main__':
+    from argparse import ArgumentParser
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("--types", default=None, help="comma separated list of message types to export, default all")
+    parser.add_argument("infile")
+    parser.add_argument("outdir")
+    args = parser.parse_args()
+
+    types = None
+    if args.types is not None:
+        types = set(args.types.split(','))
+
+    if not os.path.isdir(args.outdir):
+        os.makedirs(args.outdir)
+
+    with open(args.infile, "rb") as f:
+        data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        try:
+            by_id = export(data, args.outdir, types)
+        except ValueError as e:
+            print(e)
+            sys.exit(1)
+
+    manifest = {
+        "log": os.path.basename(args.infile),
+        "types": {m.name: m.manifest() for m in by_id.values()},
+    }
+    with open(os.path.join(args.outdir, "manifest.json"), "w") as f:
+        json.dump(manifest, f, indent=1)
+    print("Exported %u messages of %u types" % (sum(m.count for m in by_id.values()), len(by_id)))
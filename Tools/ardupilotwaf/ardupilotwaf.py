@@ -522,7 +522,7 @@ def write_version_header(ctx, tgt):
             print('#define {} {}'.format(k, v), file=f)
 
 @conf
-def ap_find_benchmarks(bld, use=[]):
+def ap_find_benchmarks(bld, use=[], DOUBLE_PRECISION_SOURCES=[]):
     if not bld.env.HAS_GBENCHMARK:
         return
 
@@ -537,7 +537,7 @@ def ap_find_benchmarks(bld, use=[]):
             bld.env.CXXFLAGS.remove(to_remove)
 
     for f in bld.path.ant_glob(incl='*.cpp'):
-        ap_program(
+        t = ap_program(
             bld,
             features=['gbenchmark'],
             includes=includes,
@@ -548,6 +548,9 @@ def ap_find_benchmarks(bld, use=[]):
             program_groups='benchmarks',
             use_legacy_defines=False,
         )
+        filename = os.path.basename(f.abspath())
+        if filename in DOUBLE_PRECISION_SOURCES:
+            t.env.CXXFLAGS = set_double_precision_flags(t.env.CXXFLAGS)
 
 def test_summary(bld):
     from io import BytesIO
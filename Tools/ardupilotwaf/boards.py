@@ -611,7 +611,7 @@ class Board:
 
         # Allow lua to load from ROMFS if any lua files are added
         for file in ctx.env.ROMFS_FILES:
-            if file[0].startswith("scripts") and file[0].endswith(".lua"):
+            if file[0].startswith("scripts") and file[0].endswith((".lua", ".luac")):
                 ctx.env.CXXFLAGS += ['-DHAL_HAVE_AP_ROMFS_EMBEDDED_LUA']
                 break
 
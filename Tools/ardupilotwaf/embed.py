@@ -9,6 +9,11 @@ May 2017
 
 import os, sys, zlib
 
+# files larger than this are compressed as independent blocks of this
+# size so they can be read without decompressing the whole file. Must
+# match AP_ROMFS::BLOCK_SIZE
+BLOCK_SIZE = 8192
+
 def write_encode(out, s):
     out.write(s.encode())
 
@@ -30,6 +35,7 @@ def embed_file(out, f, idx, embedded_name, uncompressed):
 
     crc = crc32(contents)
     write_encode(out, '__EXTFLASHFUNC__ static const uint8_t ap_romfs_%u[] = {' % idx)
+    block_offsets = None
 
     if uncompressed:
         # terminate if there's not already an existing null. we don't add it to
@@ -39,7 +45,20 @@ def embed_file(out, f, idx, embedded_name, uncompressed):
     else:
         # compress it (max level, max window size, raw stream, max mem usage)
         z = zlib.compressobj(level=9, method=zlib.DEFLATED, wbits=-15, memLevel=9)
-        b = z.compress(contents)
+        if len(contents) > BLOCK_SIZE:
+            # a full flush after each block resets the history and
+            # byte aligns the output, so each block can be inflated on
+            # its own from its offset. The result is still one valid
+            # stream for decompressing the whole file
+            block_offsets = []
+            b = b''
+            for ofs in range(0, len(contents), BLOCK_SIZE):
+                block_offsets.append(len(b))
+                b += z.compress(contents[ofs:ofs+BLOCK_SIZE])
+                if ofs + BLOCK_SIZE < len(contents):
+                    b += z.flush(zlib.Z_FULL_FLUSH)
+        else:
+            b = z.compress(contents)
         b += z.flush()
         # decompressed data will be null terminated at runtime, nothing to do here
         null_terminate = False
@@ -50,7 +69,11 @@ def embed_file(out, f, idx, embedded_name, uncompressed):
     if null_terminate:
         write_encode(out, ",0")
     write_encode(out, '};\n\n');
-    return crc, len(contents)
+    if block_offsets is not None:
+        write_encode(out, '__EXTFLASHFUNC__ static const uint32_t ap_romfs_%u_blocks[] = {' % idx)
+        write_encode(out, ",".join(str(o) for o in block_offsets))
+        write_encode(out, '};\n\n')
+    return crc, len(contents), block_offsets is not None
 
 def crc32(bytes, crc=0):
     '''crc32 equivalent to crc32_small() from AP_Math/crc.cpp'''
@@ -72,10 +95,11 @@ def create_embedded_h(filename, files, uncompressed=False):
     files = sorted(list(set(files)))
     crc = {}
     decompressed_size = {}
+    blocked = {}
     for i in range(len(files)):
         (name, filename) = files[i]
         try:
-            crc[filename], decompressed_size[filename] = embed_file(out, filename, i, name, uncompressed)
+            crc[filename], decompressed_size[filename], blocked[filename] = embed_file(out, filename, i, name, uncompressed)
         except Exception as e:
             print(e)
             return False
@@ -89,8 +113,12 @@ def create_embedded_h(filename, files, uncompressed=False):
         else:
             ustr = ''
         print("Embedding file %s:%s%s" % (name, filename, ustr))
-        write_encode(out, '{ "%s", sizeof(ap_romfs_%u), %d, 0x%08x, ap_romfs_%u },\n' % (
-            name, i, decompressed_size[filename], crc[filename], i))
+        if blocked[filename]:
+            blocks = 'ap_romfs_%u_blocks' % i
+        else:
+            blocks = 'nullptr'
+        write_encode(out, '{ "%s", sizeof(ap_romfs_%u), %d, 0x%08x, ap_romfs_%u, %s },\n' % (
+            name, i, decompressed_size[filename], crc[filename], i, blocks))
     write_encode(out, '};\n')
     out.close()
     return True
@@ -5486,6 +5486,19 @@ class AutoTestCopter(vehicle_test_suite.TestSuite):
         self._DO_WINCH(self.run_cmd_int)
         self._DO_WINCH(self.run_cmd)
 
+    def SITLSnapshot(self):
+        '''check restoring a SITL snapshot puts the vehicle back where it was'''
+        self.customise_SITL_commandline(["--snapshot"])
+        self.takeoff(20, mode='GUIDED')
+        snapshot_loc = self.mav.location()
+        self.snapshot_SITL()
+        # fan out from the one snapshot
+        for (x, y) in (50, 0), (0, 50):
+            self.fly_guided_move_local(x, y, 20)
+            self.restore_SITL_snapshot()
+            self.wait_location(snapshot_loc, accuracy=5, height_accuracy=None, timeout=10)
+        self.do_RTL()
+
     def GuidedSubModeChange(self):
         """"Ensure we can move around in guided after a takeoff command."""
 
@@ -11963,6 +11976,7 @@ class AutoTestCopter(vehicle_test_suite.TestSuite):
              self.NavDelayAbsTime,
              self.NavDelay,
              self.GuidedSubModeChange,
+             self.SITLSnapshot,
              self.MAV_CMD_CONDITION_YAW,
              self.LoiterToAlt,
              self.PayloadPlaceMission,
@@ -516,6 +516,8 @@ def run_step(step):
         "build_opts": copy.copy(build_opts),
         "generate_junit": opts.junit,
         "enable_fgview": opts.enable_fgview,
+        "instance": opts.instance,
+        "shard": opts.shard,
     }
     if opts.speedup is not None:
         fly_opts["speedup"] = opts.speedup
@@ -695,6 +697,57 @@ def write_fullresults():
     write_webresults(results)
 
 
+def parallel_child_args():
+    '''return the command line arguments for a parallel child process,
+    without the steps or the --parallel option'''
+    ret = []
+    skip_next = False
+    for arg in sys.argv[1:]:
+        if skip_next:
+            skip_next = False
+            continue
+        if arg == "--parallel":
+            skip_next = True
+            continue
+        if arg.startswith("--parallel="):
+            continue
+        if arg in command_line_steps:
+            continue
+        ret.append(arg)
+    return ret
+
+
+def run_step_parallel(step, count):
+    '''run a test step split across count autotest processes.  Child
+    process N uses SITL instance N so ports do not clash, and runs in a
+    separate directory so eeprom and logs do not clash.  Each child
+    keeps its SITL running between its tests'''
+    children = []
+    for i in range(count):
+        shard_dir = buildlogs_path("shard-%u" % i)
+        util.mkdir_p(shard_dir)
+        cmd = [sys.executable, os.path.realpath(__file__)]
+        cmd.extend(parallel_child_args())
+        cmd.extend(["--instance", str(i), "--shard", "%u/%u" % (i, count), step])
+        env = dict(os.environ)
+        env["BUILDLOGS"] = shard_dir
+        logfile = open(os.path.join(shard_dir, "%s.txt" % step), "w")
+        print(">>>> Starting shard %u/%u of %s in %s" % (i, count, step, shard_dir))
+        children.append((i, subprocess.Popen(cmd, cwd=shard_dir, env=env, stdout=logfile, stderr=subprocess.STDOUT),
+                         logfile, time.time()))
+
+    passed = True
+    for (i, child, logfile, start) in children:
+        returncode = child.wait()
+        logfile.close()
+        print(">>>> Shard %u/%u of %s %s in %.1fs (see %s)" %
+              (i, count, step, "PASSED" if returncode == 0 else "FAILED",
+               time.time() - start, logfile.name))
+        if returncode != 0:
+            passed = False
+    return passed
+
+
 def run_tests(steps):
     """Run a list of steps."""
 
@@ -722,7 +775,10 @@ def run_tests(steps):
         t1 = time.time()
         print(">>>> RUNNING STEP: %s at %s" % (step, time.asctime()))
         try:
-            success = run_step(step)
+            if opts.parallel > 1 and step in tester_class_map:
+                success = run_step_parallel(step, opts.parallel)
+            else:
+                success = run_step(step)
             testinstance = None
             if isinstance(success, tuple):
                 (success, testinstance) = success
@@ -1008,6 +1064,18 @@ if __name__ == "__main__":
     group_sim.add_option("", "--replay",
                          action='store_true',
                          help="enable replay logging for tests")
+    group_sim.add_option("--instance",
+                         default=0,
+                         type='int',
+                         help="SITL instance number; offsets all SITL ports by 10*instance")
+    group_sim.add_option("--shard",
+                         default=None,
+                         type='string',
+                         help="only run every N'th test of a suite, starting at test I, given as I/N")
+    group_sim.add_option("--parallel",
+                         default=1,
+                         type='int',
+                         help="split each vehicle test suite across this many autotest processes")
     parser.add_option_group(group_sim)
 
     group_completion = optparse.OptionGroup(parser, "Completion helpers")
@@ -1030,6 +1098,7 @@ if __name__ == "__main__":
     parser.add_option_group(group_completion)
 
     opts, args = parser.parse_args()
+    command_line_steps = list(args)
 
     # canonicalise on opts.debug:
     if opts.debug is None and opts.no_debug is None:
@@ -1041,6 +1110,12 @@ if __name__ == "__main__":
     elif opts.no_debug is not None:
         opts.debug = not opts.no_debug
 
+    if opts.shard is not None:
+        (shard_index, shard_count) = [int(x) for x in opts.shard.split("/")]
+        if shard_count < 1 or shard_index < 0 or shard_index >= shard_count:
+            raise ValueError("Bad shard %s" % opts.shard)
+        opts.shard = (shard_index, shard_count)
+
     if opts.timeout is None:
         opts.timeout = 5400
         # adjust if we're running in a regime which may slow us down e.g. Valgrind
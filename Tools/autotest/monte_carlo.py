@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+
+'''
+Run a mission many times in SITL with perturbed parameters
+
+The runs are described by a JSON scenario file, for example:
+
+{
+    "binary": "build/sitl/bin/arducopter",
+    "model": "quad",
+    "mission": "Tools/autotest/Generic_Missions/CMAC-copter-navtest.txt",
+    "runs": 100,
+    "seed": 1,
+    "speedup": 100,
+    "params": {
+        "SIM_WIND_SPD": {"uniform": [0, 10]},
+        "SIM_WIND_DIR": {"uniform": [0, 360]},
+        "SIM_ACC1_RND": {"normal": [0, 0.1]},
+        "PSC_POSXY_P": {"choice": [0.8, 1.0, 1.2]},
+        "SIM_GPS1_GLTCH_X": 0
+    }
+}
+
+Relative paths are relative to the top of the source tree.  Every run
+gets its own parameter values drawn from a random generator seeded
+with the scenario seed and the run number, so any single run can be
+repeated.  Runs are spread over a pool of worker processes, each using
+its own SITL instance number and directory, and the per-run metrics
+are written to a CSV file along with a summary.
+
+AP_FLAKE8_CLEAN
+'''
+
+import argparse
+import csv
+import json
+import multiprocessing
+import os
+import random
+import sys
+import time
+
+import vehicle_test_suite
+
+from pysim import util
+
+
+class MonteCarloRun(vehicle_test_suite.TestSuite):
+    def __init__(self, vehicle_binary, model, mission_filepath, instance, speedup=None, streamrate=4):
+        super(MonteCarloRun, self).__init__(vehicle_binary, instance=instance)
+        self.mission_filepath = mission_filepath
+        self.model = model
+        self.speedup = speedup
+        self.streamrate = streamrate
+
+        if self.speedup is None:
+            self.speedup = 100
+
+        self.metrics = {
+            "xtrack_error_max": 0.0,
+            "xtrack_error_sum": 0.0,
+            "xtrack_error_count": 0,
+            "ekf_velocity_variance_max": 0.0,
+            "ekf_pos_horiz_variance_max": 0.0,
+            "ekf_pos_vert_variance_max": 0.0,
+            "ekf_compass_variance_max": 0.0,
+        }
+
+    def vehicleinfo_key(self):
+        '''magically guess vehicleinfo_key from filepath'''
+        path = self.binary.lower()
+        if "plane" in path:
+            return "ArduPlane"
+        if "copter" in path:
+            return "ArduCopter"
+        if "rover" in path:
+            return "Rover"
+        raise ValueError("Can't determine vehicleinfo_key from binary path")
+
+    def record_metrics(self, mav, m):
+        '''message hook accumulating the metrics for this run'''
+        t = m.get_type()
+        if t == "NAV_CONTROLLER_OUTPUT":
+            xtrack_error = abs(m.xtrack_error)
+            self.metrics["xtrack_error_max"] = max(self.metrics["xtrack_error_max"], xtrack_error)
+            self.metrics["xtrack_error_sum"] += xtrack_error
+            self.metrics["xtrack_error_count"] += 1
+        elif t == "EKF_STATUS_REPORT":
+            for (field, key) in (("velocity_variance", "ekf_velocity_variance_max"),
+                                 ("pos_horiz_variance", "ekf_pos_horiz_variance_max"),
+                                 ("pos_vert_variance", "ekf_pos_vert_variance_max"),
+                                 ("compass_variance", "ekf_compass_variance_max")):
+                self.metrics[key] = max(self.metrics[key], getattr(m, field))
+
+    def run(self, params_filepath):
+        defaults = self.model_defaults_filepath(self.model)
+        defaults.append(params_filepath)
+        self.start_SITL(
+            binary=self.binary,
+            model=self.model,
+            sitl_home=self.sitl_home_string_from_mission_filepath(self.mission_filepath),
+            speedup=self.speedup,
+            defaults_filepath=defaults,
+        )
+        self.get_mavlink_connection_going()
+        self.install_message_hook(self.record_metrics)
+
+        # hack; Plane defaults are annoying... we should do better
+        # here somehow.
+        if self.vehicleinfo_key() == "ArduPlane":
+            self.set_parameter("RTL_AUTOLAND", 1)
+
+        self.load_mission_from_filepath(self.mission_filepath, strict=False)
+        self.change_mode('AUTO')
+        self.set_streamrate(self.streamrate)
+        self.wait_ready_to_arm()
+        self.arm_vehicle()
+        self.wait_disarmed(timeout=600)
+        self.stop_SITL()
+
+
+def perturbed_value(rng, spec):
+    '''draw a parameter value from a scenario parameter specification'''
+    if not isinstance(spec, dict):
+        return float(spec)
+    if "uniform" in spec:
+        (low, high) = spec["uniform"]
+        return rng.uniform(low, high)
+    if "normal" in spec:
+        (mean, sigma) = spec["normal"]
+        return rng.gauss(mean, sigma)
+    if "choice" in spec:
+        return rng.choice(spec["choice"])
+    raise ValueError("Bad parameter specification %s" % str(spec))
+
+
+def run_one(job):
+    '''run a single scenario run in a worker process; returns a results row'''
+    (scenario, run_number, outdir) = job
+
+    # a fixed instance per worker keeps ports apart; the pool identity counts from 1
+    identity = multiprocessing.current_process()._identity
+    instance = identity[0] if len(identity) else 0
+
+    rundir = os.path.join(outdir, "run-%04u" % run_number)
+    util.mkdir_p(rundir)
+    os.chdir(rundir)
+
+    rng = random.Random("%s-%u" % (scenario.get("seed", 0), run_number))
+    params = {}
+    for name in sorted(scenario.get("params", {}).keys()):
+        params[name] = perturbed_value(rng, scenario["params"][name])
+    params_filepath = os.path.join(rundir, "params.parm")
+    with open(params_filepath, "w") as f:
+        for (name, value) in params.items():
+            f.write("%s %f\n" % (name, value))
+
+    row = {"run": run_number}
+    row.update(params)
+    tstart = time.time()
+    tester = MonteCarloRun(
+        util.reltopdir(scenario["binary"]),
+        scenario["model"],
+        util.reltopdir(scenario["mission"]),
+        instance,
+        speedup=scenario.get("speedup"),
+        streamrate=scenario.get("streamrate", 4),
+    )
+    try:
+        tester.run(params_filepath)
+        row["passed"] = 1
+    except Exception as e:
+        print("Run %u failed: %s" % (run_number, str(e)))
+        row["passed"] = 0
+        util.pexpect_close_all()
+    row["wallclock_s"] = time.time() - tstart
+
+    metrics = tester.metrics
+    row["xtrack_error_max"] = metrics["xtrack_error_max"]
+    if metrics["xtrack_error_count"] > 0:
+        row["xtrack_error_mean"] = metrics["xtrack_error_sum"] / metrics["xtrack_error_count"]
+    else:
+        row["xtrack_error_mean"] = 0
+    for key in ("ekf_velocity_variance_max",
+                "ekf_pos_horiz_variance_max",
+                "ekf_pos_vert_variance_max",
+                "ekf_compass_variance_max"):
+        row[key] = metrics[key]
+    return row
+
+
+def summarise(rows):
+    '''print the spread of each metric over the runs'''
+    passed = [r for r in rows if r["passed"]]
+    print("%u/%u runs completed" % (len(passed), len(rows)))
+    if len(passed) == 0:
+        return
+    for key in ("xtrack_error_max",
+                "xtrack_error_mean",
+                "ekf_velocity_variance_max",
+                "ekf_pos_horiz_variance_max",
+                "ekf_pos_vert_variance_max",
+                "ekf_compass_variance_max",
+                "wallclock_s"):
+        values = sorted([r[key] for r in passed])
+        median = values[len(values) // 2]
+        p95 = values[min(len(values) - 1, int(0.95 * len(values)))]
+        print("  %-28s min %10.3f median %10.3f p95 %10.3f max %10.3f" %
+              (key, values[0], median, p95, values[-1]))
+
+
+if __name__ == "__main__":
+    ''' main program '''
+    os.environ['PYTHONUNBUFFERED'] = '1'
+
+    if sys.platform != "darwin":
+        os.putenv('TMPDIR', util.reltopdir('tmp'))
+
+    parser = argparse.ArgumentParser("monte_carlo.py")
+    parser.add_argument(
+        'scenario_filepath',
+        type=str,
+        help='JSON scenario file'
+    )
+    parser.add_argument(
+        '-j', '--jobs',
+        type=int,
+        help='number of runs to execute at once',
+        default=multiprocessing.cpu_count(),
+    )
+    parser.add_argument(
+        '--outdir',
+        type=str,
+        help='directory for the run directories and results',
+        default="monte_carlo",
+    )
+
+    args = parser.parse_args()
+
+    with open(args.scenario_filepath) as f:
+        scenario = json.load(f)
+
+    outdir = os.path.realpath(args.outdir)
+    util.mkdir_p(outdir)
+
+    jobs = [(scenario, i, outdir) for i in range(scenario.get("runs", 1))]
+    tstart = time.time()
+    # each worker is used for one run only so no state carries between runs
+    pool = multiprocessing.Pool(processes=args.jobs, maxtasksperchild=1)
+    rows = pool.map(run_one, jobs, chunksize=1)
+    pool.close()
+    pool.join()
+
+    results_filepath = os.path.join(outdir, "results.csv")
+    fieldnames = []
+    for row in rows:
+        for key in row.keys():
+            if key not in fieldnames:
+                fieldnames.append(key)
+    with open(results_filepath, "w") as f:
+        writer = csv.DictWriter(f, fieldnames=fieldnames)
+        writer.writeheader()
+        writer.writerows(rows)
+
+    elapsed = time.time() - tstart
+    print("%u runs in %.0fs (%.1f runs/hour), results in %s" %
+          (len(rows), elapsed, 3600 * len(rows) / elapsed, results_filepath))
+    summarise(rows)
@@ -712,6 +712,14 @@ def start_CAN_Periph(opts, frame_info):
     run_in_terminal_window(cmd_name, cmd)
 
 
+def remove_lockstep_group(name):
+    """Remove the shared memory a SITL lockstep group was created in"""
+    try:
+        os.unlink("/dev/shm/ardupilot-lockstep-" + name)
+    except OSError:
+        pass
+
+
 def start_vehicle(binary, opts, stuff, spawns=None):
     """Run the ArduPilot binary"""
 
@@ -833,6 +841,12 @@ def start_vehicle(binary, opts, stuff, spawns=None):
 
     cmd.append("--sim-address=%s" % cmd_opts.sim_address)
 
+    if opts.lockstep and len(instances) > 1:
+        # a new group for each run, removed when we exit
+        lockstep_name = "sim_vehicle-%u" % os.getpid()
+        cmd.extend(["--lockstep", "%s:%u" % (lockstep_name, len(instances))])
+        atexit.register(remove_lockstep_group, lockstep_name)
+
     old_dir = os.getcwd()
     for i, i_dir in zip(instances, instance_dir):
         c = ["-I" + str(i)]
@@ -1349,6 +1363,10 @@ group_sim.add_option("", "--auto-sysid",
                      default=False,
                      action='store_true',
                      help="Set MAV_SYSID based upon instance number")
+group_sim.add_option("", "--lockstep",
+                     default=False,
+                     action='store_true',
+                     help="keep the simulation clocks of all instances in step")
 group_sim.add_option("", "--sim-address",
                      type=str,
                      default="127.0.0.1",
@@ -1922,6 +1922,8 @@ class TestSuite(ABC):
                  dronecan_tests=False,
                  generate_junit=False,
                  enable_fgview=False,
+                 instance=0,
+                 shard=None,
                  build_opts={}):
 
         self.start_time = time.time()
@@ -1945,6 +1947,10 @@ class TestSuite(ABC):
             self.speedup = self.default_speedup()
         self.sup_binaries = sup_binaries
         self.reset_after_every_test = reset_after_every_test
+        # SITL instance number; all ArduPilot ports are offset by 10*instance
+        self.instance = instance
+        # (index, count) tuple; only run every count'th test starting at index
+        self.shard = shard
         self.force_32bit = force_32bit
         self.ubsan = ubsan
         self.ubsan_abort = ubsan_abort
@@ -2086,13 +2092,13 @@ class TestSuite(ABC):
 
     def adjust_ardupilot_port(self, port):
         '''adjust port in case we do not wish to use the default range (5760 and 5501 etc)'''
-        return port
+        return port + 10 * self.instance
 
     def spare_network_port(self, offset=0):
         '''returns a network port which should be able to be bound'''
         if offset > 2:
             raise ValueError("offset too large")
-        return 8000 + offset
+        return 8000 + 10 * self.instance + offset
 
     def autotest_connection_string_to_ardupilot(self):
         return "tcp:127.0.0.1:%u" % self.adjust_ardupilot_port(5760)
@@ -2100,7 +2106,7 @@ class TestSuite(ABC):
     def sitl_rcin_port(self, offset=0):
         if offset > 2:
             raise ValueError("offset too large")
-        return 5501 + offset
+        return self.adjust_ardupilot_port(5501 + offset)
 
     def mavproxy_options(self):
         """Returns options to be passed to MAVProxy."""
@@ -3406,6 +3412,24 @@ class TestSuite(ABC):
         # self.progress("Unpausing SITL")
         self.sitl.kill(signal.SIGCONT)
 
+    def snapshot_SITL(self, timeout=10):
+        '''take a snapshot of the running simulation.  SITL must have
+        been started with --snapshot'''
+        self.progress("Taking SITL snapshot")
+        self.sitl.kill(signal.SIGUSR1)
+        self.sitl.expect("SITL: snapshot taken", timeout=timeout)
+
+    def restore_SITL_snapshot(self, timeout=10):
+        '''return the simulation to the last snapshot_SITL() call.
+        Simulation time goes backwards, so stale messages are dropped'''
+        self.progress("Restoring SITL snapshot")
+        self.sitl.kill(signal.SIGUSR2)
+        self.sitl.expect("SITL: restored snapshot", timeout=timeout)
+        self.mav.messages.pop("SYSTEM_TIME", None)
+        self.last_sim_time_cached = 0
+        self.drain_mav()
+        self.wait_heartbeat()
+
     def stop_SITL(self):
         self.progress("Stopping SITL")
         self.expect_list_remove(self.sitl)
@@ -9283,6 +9307,9 @@ Also, ignores heartbeats not from our target system'''
             "enable_fgview": self.enable_fgview,
         }
         start_sitl_args.update(**sitl_args)
+        if self.instance != 0:
+            start_sitl_args["customisations"] = (["-I", str(self.instance)] +
+                                                 list(start_sitl_args.get("customisations", [])))
         if ("defaults_filepath" not in start_sitl_args or
                 start_sitl_args["defaults_filepath"] is None):
             start_sitl_args["defaults_filepath"] = self.defaults_filepath()
@@ -14823,6 +14850,12 @@ SERIAL5_BAUD 128
                 continue
             tests.append(test)
 
+        if self.shard is not None:
+            # deterministically split the tests between shards, in suite order
+            (shard_index, shard_count) = self.shard
+            tests = [t for (i, t) in enumerate(tests) if i % shard_count == shard_index]
+            self.progress("Shard %u/%u running %u tests" % (shard_index, shard_count, len(tests)))
+
         results = self.run_tests(tests)
 
         if len(skip_list):
@@ -3,10 +3,11 @@
 unpack a param.pck file from @PARAM/param.pck via mavlink FTP
 '''
 
-import struct, sys
+import struct, sys, zlib
 
 from argparse import ArgumentParser
 parser = ArgumentParser(description=__doc__)
+parser.add_argument("--block-crc", type=int, default=0, help="print checksums of blocks of this many parameters as given by @PARAM/param.crc")
 parser.add_argument("file", metavar="LOG")
 
 args = parser.parse_args()
@@ -41,6 +42,13 @@ if sys.version_info.major < 3:
     pad_byte = chr(0)
 
 count = 0
+block_crcs = []
+
+
+def crc_crc32(crc, buf):
+    '''equivalent to crc_crc32() in AP_Math/crc.cpp'''
+    return zlib.crc32(buf, crc ^ 0xFFFFFFFF) ^ 0xFFFFFFFF
+
 
 while True:
     # skip pad bytes
@@ -66,9 +74,18 @@ while True:
     last_name = name
     data = data[2+name_len+type_len:]
     v, = struct.unpack("<" + type_format, vdata)
+    if args.block_crc > 0:
+        if count % args.block_crc == 0:
+            block_crcs.append(0)
+        crc = crc_crc32(block_crcs[-1], name.encode('utf-8'))
+        crc = crc_crc32(crc, struct.pack("<B", ptype))
+        block_crcs[-1] = crc_crc32(crc, vdata)
     count += 1
     print("%-16s %f" % (name, float(v)))
 
+for i in range(len(block_crcs)):
+    print("block %u: 0x%08x" % (i, block_crcs[i]))
+
 if count != num_params or count > total_params:
     print("Error: Got %u params expected %u/%u" % (count, num_params, total_params))
     sys.exit(1)
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+
+'''
+Run the Google Benchmark programs built with
+  ./waf configure --board sitl --enable-benchmarks
+  ./waf benchmarks
+and optionally compare the results against a saved JSON baseline.
+
+  Tools/scripts/run_benchmarks.py --save baseline.json
+  Tools/scripts/run_benchmarks.py --baseline baseline.json --threshold 10
+
+Benchmarks are keyed by "<program>/<benchmark name>" and compared on
+CPU time. Baselines are only meaningful on the machine they were
+recorded on.
+'''
+
+import glob
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def run_program(path, benchmark_filter=None):
+    '''run one benchmark program, returning its parsed JSON output'''
+    (fd, outfile) = tempfile.mkstemp(suffix=".json")
+    os.close(fd)
+    try:
+        cmd = [path,
+               "--benchmark_out=%s" % outfile,
+               "--benchmark_out_format=json"]
+        if benchmark_filter is not None:
+            cmd.append("--benchmark_filter=%s" % benchmark_filter)
+        subprocess.check_call(cmd, stdout=subprocess.DEVNULL)
+        with open(outfile) as f:
+            return json.load(f)
+    finally:
+        os.unlink(outfile)
+
+
+def run_all(programs, benchmark_filter=None):
+    results = {}
+    context = None
+    for path in programs:
+        prog = os.path.basename(path)
+        print("Running %s" % prog)
+        out = run_program(path, benchmark_filter)
+        if context is None:
+            context = out.get("context", {})
+        for b in out.get("benchmarks", []):
+            if b.get("run_type", "iteration") != "iteration":
+                continue
+            results["%s/%s" % (prog, b["name"])] = {
+                "cpu_time": b["cpu_time"],
+                "real_time": b["real_time"],
+                "time_unit": b["time_unit"],
+            }
+    return {"context": context, "benchmarks": results}
+
+
+def compare(baseline, current, threshold):
+    '''print a comparison and return the list of regressions'''
+    regressions = []
+    print("%-70s %12s %12s %8s" % ("Benchmark", "Baseline", "Current", "Change"))
+    for name in sorted(current["benchmarks"].keys()):
+        cur = current["benchmarks"][name]
+        base = baseline["benchmarks"].get(name)
+        if base is None:
+            print("%-70s %12s %12.1f %8s" % (name, "-", cur["cpu_time"], "new"))
+            continue
+        if base["time_unit"] != cur["time_unit"] or base["cpu_time"] <= 0:
+            print("%-70s incomparable" % name)
+            continue
+        change = 100.0 * (cur["cpu_time"] - base["cpu_time"]) / base["cpu_time"]
+        flag = ""
+        if change > threshold:
+            flag = " REGRESSION"
+            regressions.append(name)
+        print("%-70s %12.1f %12.1f %+7.1f%%%s" % (name, base["cpu_time"], cur["cpu_time"], change, flag))
+    for name in sorted(baseline["benchmarks"].keys()):
+        if name not in current["benchmarks"]:
+            print("%-70s missing from current run" % name)
+    return regressions
+
+
+if __name__ == '__main__':
+    from argparse import ArgumentParser
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("--board", default="sitl", help="board the benchmarks were built for")
+    parser.add_argument("--filter", default=None, help="only run benchmarks matching this regex")
+    parser.add_argument("--save", default=None, help="write results as a JSON baseline")
+    parser.add_argument("--baseline", default=None, help="JSON baseline to compare against")
+    parser.add_argument("--threshold", type=float, default=10.0, help="percentage CPU time increase counted as a regression")
+    parser.add_argument("programs", nargs="*", help="benchmark programs to run, default all built programs")
+    args = parser.parse_args()
+
+    programs = args.programs
+    if len(programs) == 0:
+        programs = sorted(glob.glob(os.path.join("build", args.board, "benchmarks", "*")))
+    if len(programs) == 0:
+        print("No benchmarks found; build with ./waf configure --board %s --enable-benchmarks && ./waf benchmarks" % args.board)
+        sys.exit(1)
+
+    current = run_all(programs, args.filter)
+
+    if args.save is not None:
+        with open(args.save, "w") as f:
+            json.dump(current, f, indent=2, sort_keys=True)
+        print("Saved %u results to %s" % (len(current["benchmarks"]), args.save))
+
+    if args.baseline is not None:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare(baseline, current, args.threshold)
+        if len(regressions):
+            print("%u benchmarks regressed by more than %.1f%%" % (len(regressions), args.threshold))
+            sys.exit(1)
@@ -76,9 +76,9 @@ public:
     bool is_throttle_mix_min() const override { return (_throttle_rpy_mix < 1.25f * _thr_mix_min); }
 
     // run lowest level body-frame rate controller and send outputs to the motors
-    void rate_controller_run_dt(const Vector3f& gyro_rads, float dt) override;
+    void rate_controller_run_dt(const Vector3f& gyro_rads, float dt) override __FASTRAMFUNC__;
     void rate_controller_target_reset() override;
-    void rate_controller_run() override;
+    void rate_controller_run() override __FASTRAMFUNC__;
 
     // sanity check parameters.  should be called once before take-off
     void parameter_sanity_check() override;
@@ -415,17 +415,26 @@ void AC_AttitudeControl_Sub::update_throttle_rpy_mix()
     _throttle_rpy_mix = constrain_float(_throttle_rpy_mix, 0.1f, AC_ATTITUDE_CONTROL_MAX);
 }
 
-void AC_AttitudeControl_Sub::rate_controller_run()
+void AC_AttitudeControl_Sub::rate_controller_run_dt(const Vector3f& gyro_rads, float dt)
 {
+    // take a copy of the target so that it can't be changed from under us.
+    const Vector3f ang_vel_body = _ang_vel_body_rads;
+
     // move throttle vs attitude mixing towards desired (called from here because this is conveniently called on every iteration)
     update_throttle_rpy_mix();
 
-    _rate_gyro_rads = _ahrs.get_gyro_latest();
+    _rate_gyro_rads = gyro_rads;
     _rate_gyro_time_us = AP_HAL::micros64();
 
-    _motors.set_roll(get_rate_roll_pid().update_all(_ang_vel_body_rads.x, _rate_gyro_rads.x, _dt, _motors.limit.roll));
-    _motors.set_pitch(get_rate_pitch_pid().update_all(_ang_vel_body_rads.y, _rate_gyro_rads.y, _dt, _motors.limit.pitch));
-    _motors.set_yaw(get_rate_yaw_pid().update_all(_ang_vel_body_rads.z, _rate_gyro_rads.z, _dt, _motors.limit.yaw));
+    _motors.set_roll(get_rate_roll_pid().update_all(ang_vel_body.x, gyro_rads.x, dt, _motors.limit.roll));
+    _motors.set_pitch(get_rate_pitch_pid().update_all(ang_vel_body.y, gyro_rads.y, dt, _motors.limit.pitch));
+    _motors.set_yaw(get_rate_yaw_pid().update_all(ang_vel_body.z, gyro_rads.z, dt, _motors.limit.yaw));
+}
+
+// run the rate controller using the configured _dt and latest gyro_rads
+void AC_AttitudeControl_Sub::rate_controller_run()
+{
+    rate_controller_run_dt(_ahrs.get_gyro_latest(), _dt);
 }
 
 // sanity check parameters.  should be called once before takeoff
@@ -61,6 +61,8 @@ public:
 
     // run lowest level body-frame rate controller and send outputs to the motors
     void rate_controller_run() override;
+    // run the rate controller with the provided gyro sample and dt, used by the fast rate thread
+    void rate_controller_run_dt(const Vector3f& gyro_rads, float dt) override;
 
     // sanity check parameters.  should be called once before take-off
     void parameter_sanity_check() override;
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <AP_HAL/AP_HAL_Boards.h>
+
+#ifndef AC_POSCONTROL_MPC_ENABLED
+#define AC_POSCONTROL_MPC_ENABLED HAL_PROGRAM_SIZE_LIMIT_KB > 1024
+#endif
@@ -323,6 +323,12 @@ const AP_Param::GroupInfo AC_PosControl::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("_JERK_Z", 11, AC_PosControl, _shaping_jerk_u_msss, POSCONTROL_JERK_U),
 
+#if AC_POSCONTROL_MPC_ENABLED
+    // @Group: _MPC_
+    // @Path: AC_PosControl_MPC.cpp
+    AP_SUBGROUPINFO(_mpc_ne, "_MPC_", 12, AC_PosControl, AC_PosControl_MPC),
+#endif
+
     AP_GROUPEND
 };
 
@@ -538,6 +544,10 @@ void AC_PosControl::init_NE_controller()
     // _accel_desired_neu_cmss is zero and can be removed from the equation
     _pid_vel_ne.set_integrator(_accel_target_neu_cmss.xy() - _vel_target_neu_cms.xy() * _pid_vel_ne.ff());
 
+#if AC_POSCONTROL_MPC_ENABLED
+    _mpc_ne.reset();
+#endif
+
     // initialise ekf xy reset handler
     init_ekf_NE_reset();
 
@@ -689,6 +699,25 @@ void AC_PosControl::update_NE_controller()
 
     Vector2f accel_target_ne_cmss = _pid_vel_ne.update_all(_vel_target_neu_cms.xy(), comb_vel, _dt, _limit_vector.xy());
 
+    // maximum acceleration from the maximum lean angles
+    float angle_max = MIN(_attitude_control.get_althold_lean_angle_max_cd(), get_lean_angle_max_cd());
+    float accel_max = angle_to_accel(angle_max * 0.01) * 100;
+
+#if AC_POSCONTROL_MPC_ENABLED
+    if (_mpc_ne.enabled()) {
+        // the model predictive controller corrects both the position and velocity errors directly
+        // the velocity controller's I term is kept to correct for steady disturbances
+        // and its feed-forward term so VEL_FF behaves the same with either controller
+        // if the solve runs out of time the velocity controller's output is used unchanged
+        const Vector2f pos_error_ne_cm = (comb_pos.xy().topostype() - _pos_target_neu_cm.xy()).tofloat();
+        const Vector2f vel_error_ne_cms = comb_vel - (_vel_desired_neu_cms.xy() + _vel_offset_neu_cms.xy());
+        Vector2f accel_mpc_ne_cmss;
+        if (_mpc_ne.update(pos_error_ne_cm, vel_error_ne_cms, accel_max, accel_mpc_ne_cmss)) {
+            accel_target_ne_cmss = accel_mpc_ne_cmss + _pid_vel_ne.get_i() + _pid_vel_ne.get_ff();
+        }
+    }
+#endif
+
     // Acceleration Controller
     
     // acceleration to correct for velocity error and scale PID output to compensate for optical flow measurement induced EKF noise
@@ -702,8 +731,6 @@ void AC_PosControl::update_NE_controller()
     _accel_target_neu_cmss.xy() += _accel_desired_neu_cmss.xy() + _accel_offset_neu_cmss.xy();
 
     // limit acceleration using maximum lean angles
-    float angle_max = MIN(_attitude_control.get_althold_lean_angle_max_cd(), get_lean_angle_max_cd());
-    float accel_max = angle_to_accel(angle_max * 0.01) * 100;
     // Define the limit vector before we constrain _accel_target_neu_cmss 
     _limit_vector.xy() = _accel_target_neu_cmss.xy();
     if (!limit_accel_xy(_vel_desired_neu_cms.xy(), _accel_target_neu_cmss.xy(), accel_max)) {
@@ -13,6 +13,7 @@
 #include <AP_InertialNav/AP_InertialNav.h>  // Inertial Navigation library
 #include <AP_Scripting/AP_Scripting_config.h>
 #include "AC_AttitudeControl.h"     // Attitude control library
+#include "AC_PosControl_MPC.h"      // model predictive horizontal controller
 
 #include <AP_Logger/LogStructure.h>
 
@@ -531,6 +532,9 @@ protected:
     AC_PID_2D       _pid_vel_ne;            // XY axis velocity controller to convert velocity error to desired acceleration
     AC_PID_Basic    _pid_vel_u;             // Z axis velocity controller to convert climb rate error to desired acceleration
     AC_PID          _pid_accel_u;           // Z axis acceleration controller to convert desired acceleration to throttle output
+#if AC_POSCONTROL_MPC_ENABLED
+    AC_PosControl_MPC _mpc_ne;              // NE axis model predictive controller optionally used in place of the velocity controller's P and D terms
+#endif
 
     // internal variables
     float       _dt;                        // time difference (in seconds) since the last loop time
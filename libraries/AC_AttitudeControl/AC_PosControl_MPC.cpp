@@ -0,0 +1,154 @@
+#include "AC_PosControl_MPC.h"
+
+#if AC_POSCONTROL_MPC_ENABLED
+
+#include <AP_HAL/AP_HAL.h>
+
+const AP_Param::GroupInfo AC_PosControl_MPC::var_info[] = {
+    // @Param: ENABLE
+    // @DisplayName: Horizontal model predictive control enable
+    // @Description: Enables the model predictive controller which replaces the horizontal velocity controller's P and D terms. The velocity controller's I term is still used to correct for steady disturbances like wind. The existing controller is used for any loop in which the solver runs out of time
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO_FLAGS("ENABLE", 1, AC_PosControl_MPC, _enable, 0, AP_PARAM_FLAG_ENABLE),
+
+    // @Param: POS_W
+    // @DisplayName: Horizontal model predictive control position weight
+    // @Description: Weight of the squared position error relative to the squared correction acceleration. Higher values track the position target more tightly. The square root of this value is roughly the equivalent position to acceleration gain
+    // @Range: 0.1 50
+    // @Increment: 0.1
+    // @User: Advanced
+    AP_GROUPINFO("POS_W", 2, AC_PosControl_MPC, _pos_weight, AC_POSCONTROL_MPC_POS_W),
+
+    // @Param: VEL_W
+    // @DisplayName: Horizontal model predictive control velocity weight
+    // @Description: Weight of the squared velocity error relative to the squared correction acceleration. Higher values damp the response more
+    // @Range: 0 50
+    // @Increment: 0.1
+    // @User: Advanced
+    AP_GROUPINFO("VEL_W", 3, AC_PosControl_MPC, _vel_weight, AC_POSCONTROL_MPC_VEL_W),
+
+    // @Param: TIME
+    // @DisplayName: Horizontal model predictive control time budget
+    // @Description: Maximum time the solver may run each loop. If the solve does not finish in this time the existing controller is used for that loop
+    // @Units: us
+    // @Range: 50 1000
+    // @Increment: 10
+    // @User: Advanced
+    AP_GROUPINFO("TIME", 4, AC_PosControl_MPC, _time_budget_us, AC_POSCONTROL_MPC_TIME_US),
+
+    AP_GROUPEND
+};
+
+AC_PosControl_MPC::AC_PosControl_MPC()
+{
+    AP_Param::setup_object_defaults(this, var_info);
+}
+
+// calculate the condensed cost from the weights
+// the error after step k (1 to N) is the initial error propagated forward plus the effect of the accelerations before it
+//   pos_k = pos_0 + k * T * vel_0 + sum over j < k of (k - j - 0.5) * T^2 * accel_j
+//   vel_k = vel_0 + sum over j < k of T * accel_j
+void AC_PosControl_MPC::update_cost()
+{
+    const float T = AC_POSCONTROL_MPC_STEP_S;
+    const float q_pos = MAX(_pos_weight.get(), 0.0f);
+    const float q_vel = MAX(_vel_weight.get(), 0.0f);
+
+    for (uint8_t i = 0; i < AC_POSCONTROL_MPC_HORIZON; i++) {
+        _grad_pos[i] = 0.0f;
+        _grad_vel[i] = 0.0f;
+        for (uint8_t j = 0; j < AC_POSCONTROL_MPC_HORIZON; j++) {
+            // the correction acceleration weight is one
+            _hessian[i][j] = (i == j) ? 1.0f : 0.0f;
+        }
+    }
+
+    for (uint8_t k = 1; k <= AC_POSCONTROL_MPC_HORIZON; k++) {
+        for (uint8_t i = 0; i < k; i++) {
+            const float pos_i = (k - i - 0.5f) * sq(T);
+            _grad_pos[i] += q_pos * pos_i;
+            _grad_vel[i] += q_pos * pos_i * k * T + q_vel * T;
+            for (uint8_t j = 0; j < k; j++) {
+                const float pos_j = (k - j - 0.5f) * sq(T);
+                _hessian[i][j] += q_pos * pos_i * pos_j + q_vel * sq(T);
+            }
+        }
+    }
+
+    // the largest row sum bounds the largest eigenvalue
+    float eigen_max = 0.0f;
+    for (uint8_t i = 0; i < AC_POSCONTROL_MPC_HORIZON; i++) {
+        float row_sum = 0.0f;
+        for (uint8_t j = 0; j < AC_POSCONTROL_MPC_HORIZON; j++) {
+            row_sum += fabsf(_hessian[i][j]);
+        }
+        eigen_max = MAX(eigen_max, row_sum);
+    }
+    _step_size = 1.0f / eigen_max;
+
+    _cost_pos_weight = _pos_weight;
+    _cost_vel_weight = _vel_weight;
+    _cost_valid = true;
+    _solution_valid = false;
+}
+
+// calculate the correction acceleration (in cm/s/s) from the position error (in cm) and velocity error (in cm/s)
+// returns false if the solver did not finish within the time budget, in which case accel is not updated
+bool AC_PosControl_MPC::update(const Vector2f &pos_error, const Vector2f &vel_error, float accel_max, Vector2f &accel)
+{
+    const uint32_t start_us = AP_HAL::micros();
+
+    if (!_cost_valid || !is_equal(_cost_pos_weight, _pos_weight.get()) || !is_equal(_cost_vel_weight, _vel_weight.get())) {
+        update_cost();
+    }
+    if (!_solution_valid) {
+        for (uint8_t i = 0; i < AC_POSCONTROL_MPC_HORIZON; i++) {
+            _solution[i].zero();
+        }
+    }
+
+    // accelerated projected gradient descent, keeping each step's acceleration within accel_max
+    Vector2f extrapolated[AC_POSCONTROL_MPC_HORIZON];
+    memcpy(extrapolated, _solution, sizeof(extrapolated));
+    float momentum = 1.0f;
+    for (uint8_t iter = 0; iter < AC_POSCONTROL_MPC_ITER_MAX; iter++) {
+        if (AP_HAL::micros() - start_us > (uint32_t)_time_budget_us.get()) {
+            // the solution may be part way between two iterates so do not use it as a starting point
+            _solution_valid = false;
+            return false;
+        }
+
+        float change_max = 0.0f;
+        Vector2f previous[AC_POSCONTROL_MPC_HORIZON];
+        memcpy(previous, _solution, sizeof(previous));
+        for (uint8_t i = 0; i < AC_POSCONTROL_MPC_HORIZON; i++) {
+            Vector2f gradient = pos_error * _grad_pos[i] + vel_error * _grad_vel[i];
+            for (uint8_t j = 0; j < AC_POSCONTROL_MPC_HORIZON; j++) {
+                gradient += extrapolated[j] * _hessian[i][j];
+            }
+            _solution[i] = extrapolated[i] - gradient * _step_size;
+            if (is_positive(accel_max)) {
+                _solution[i].limit_length(accel_max);
+            }
+            change_max = MAX(change_max, (_solution[i] - previous[i]).length());
+        }
+
+        if (change_max < AC_POSCONTROL_MPC_TOLERANCE) {
+            break;
+        }
+
+        const float momentum_next = 0.5f * (1.0f + sqrtf(1.0f + 4.0f * sq(momentum)));
+        const float ratio = (momentum - 1.0f) / momentum_next;
+        for (uint8_t i = 0; i < AC_POSCONTROL_MPC_HORIZON; i++) {
+            extrapolated[i] = _solution[i] + (_solution[i] - previous[i]) * ratio;
+        }
+        momentum = momentum_next;
+    }
+
+    _solution_valid = true;
+    accel = _solution[0];
+    return true;
+}
+
+#endif  // AC_POSCONTROL_MPC_ENABLED
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "AC_AttitudeControl_config.h"
+
+#if AC_POSCONTROL_MPC_ENABLED
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Param/AP_Param.h>
+#include <AP_Math/AP_Math.h>
+
+#define AC_POSCONTROL_MPC_HORIZON       10      // number of steps in the prediction horizon
+#define AC_POSCONTROL_MPC_STEP_S        0.15f   // time between steps in the prediction horizon in seconds
+#define AC_POSCONTROL_MPC_ITER_MAX      25      // maximum number of solver iterations per update
+#define AC_POSCONTROL_MPC_TOLERANCE     0.5f    // solver has converged when no acceleration changes by more than this in cm/s/s
+#define AC_POSCONTROL_MPC_POS_W         4.0f    // default position error weight
+#define AC_POSCONTROL_MPC_VEL_W         1.0f    // default velocity error weight
+#define AC_POSCONTROL_MPC_TIME_US       150     // default solver time budget in microseconds
+
+/*
+  Linear model predictive controller for the horizontal position controller.
+
+  Each axis is modelled as a double integrator driven by the correction
+  acceleration.  The cost over the horizon is the weighted sum of the squared
+  position and velocity errors plus the squared correction accelerations.  It
+  is condensed into a quadratic in the accelerations whose Hessian is only
+  recalculated when the weights change.  Each update solves the acceleration
+  limited problem with accelerated projected gradient iterations starting from
+  the previous solution.
+ */
+class AC_PosControl_MPC {
+public:
+    AC_PosControl_MPC();
+
+    CLASS_NO_COPY(AC_PosControl_MPC);
+
+    // return true if the controller should be used in place of the velocity controller's P and D terms
+    bool enabled() const { return _enable > 0; }
+
+    // clear the previous solution, should be called when the position controller is initialised
+    void reset() { _solution_valid = false; }
+
+    // calculate the correction acceleration (in cm/s/s) from the position error (in cm) and velocity error (in cm/s)
+    // errors are the actual position and velocity less the targets
+    // accel_max (in cm/s/s) limits the magnitude of the correction acceleration at each step
+    // returns false if the solver did not finish within the time budget, in which case accel is not updated
+    bool update(const Vector2f &pos_error, const Vector2f &vel_error, float accel_max, Vector2f &accel);
+
+    static const struct AP_Param::GroupInfo var_info[];
+
+private:
+
+    // calculate the condensed cost from the weights
+    void update_cost();
+
+    // parameters
+    AP_Int8     _enable;
+    AP_Float    _pos_weight;
+    AP_Float    _vel_weight;
+    AP_Int16    _time_budget_us;
+
+    // cost is accel' * _hessian * accel + 2 * accel' * (_grad_pos * pos_error + _grad_vel * vel_error)
+    float       _hessian[AC_POSCONTROL_MPC_HORIZON][AC_POSCONTROL_MPC_HORIZON];
+    float       _grad_pos[AC_POSCONTROL_MPC_HORIZON];
+    float       _grad_vel[AC_POSCONTROL_MPC_HORIZON];
+    float       _step_size;             // inverse of a bound on the Hessian's largest eigenvalue
+    float       _cost_pos_weight;       // position weight used to calculate the cost
+    float       _cost_vel_weight;       // velocity weight used to calculate the cost
+    bool        _cost_valid;
+
+    // accelerations over the horizon from the last update, used to start the next solve
+    Vector2f    _solution[AC_POSCONTROL_MPC_HORIZON];
+    bool        _solution_valid;
+};
+
+#endif  // AC_POSCONTROL_MPC_ENABLED
@@ -1,5 +1,5 @@
 /*
-This library receives time history data (angular rate or angle) during a dwell test or frequency sweep test and determines the gain and phase of the response to the input. For dwell tests once the designated number of cycles are complete, the average of the gain and phase are determined over the last 5 cycles and the cycle_complete flag is set. For frequency sweep tests, phase and gain are determined for every cycle and cycle_complete flag is set to indicate when to pull the phase and gain data.  The flag is reset to enable the next cycle to be analyzed.  The init function must be used when initializing the dwell or frequency sweep test.
+This library receives time history data (angular rate or angle) during a dwell test or frequency sweep test and determines the gain and phase of the response to the input. For dwell tests once the designated number of cycles are complete, the average of the gain and phase are determined over the last 5 cycles and the cycle_complete flag is set. For frequency sweep tests, phase and gain are determined for every cycle and cycle_complete flag is set to indicate when to pull the phase and gain data.  The flag is reset to enable the next cycle to be analyzed.  The init function must be used when initializing the dwell or frequency sweep test. For multi-sine tests the response at every component of the input is determined from spectra averaged over a number of periods of the input, and the init_multisine function must be used.
 */
 
 #include <AP_HAL/AP_HAL.h>
@@ -29,6 +29,22 @@ void AC_AutoTune_FreqResp::init(InputType input_type, ResponseType response_type
     meas_peak_info_buffer.clear();
     tgt_peak_info_buffer.clear();
     cycle_complete = false;
+    ms_num_freqs = 0;
+}
+
+// Initialize the Frequency Response Object for a multi-sine test
+void AC_AutoTune_FreqResp::init_multisine(ResponseType response_type, const MultiSine &input, uint8_t periods)
+{
+    init(MULTISINE, response_type, periods);
+    ms_num_freqs = input.num_components();
+    ms_period = input.get_period();
+    ms_start_us = 0;
+    ms_last_us = 0;
+    ms_period_cnt = 0;
+    for (uint8_t i = 0; i < ms_num_freqs; i++) {
+        ms_bin[i] = {};
+        ms_bin[i].freq = input.get_frequency_rads(i);
+    }
 }
 
 // update_angle - this function receives time history data during a dwell and frequency sweep tests for angle_p tuning
@@ -39,6 +55,11 @@ void AC_AutoTune_FreqResp::init(InputType input_type, ResponseType response_type
 void AC_AutoTune_FreqResp::update(float command, float tgt_resp, float meas_resp, float tgt_freq)
 {
 
+    if (excitation == MULTISINE) {
+        update_multisine(tgt_resp, meas_resp);
+        return;
+    }
+
     uint32_t now = AP_HAL::millis();
     float dt = 0.0025;
     uint32_t half_cycle_time_ms = 0;
@@ -298,3 +319,97 @@ void AC_AutoTune_FreqResp::pull_from_tgt_buffer(uint16_t &count, float &amplitud
     time_ms = sample.time_ms;
 }
 
+
+// update_multisine - accumulates a DFT of the target and measured responses at each multi-sine component over one
+// period of the input.  At the end of each period the cross and power spectra are summed, with the first period
+// skipped as it contains the transient and the fade in.  Once the designated number of periods are complete the
+// gain, phase and coherence of each component are determined and the cycle_complete flag is set.  The gain and
+// phase of angle and rate responses are the same, so angle responses are not differentiated as for dwells.
+void AC_AutoTune_FreqResp::update_multisine(float tgt_resp, float meas_resp)
+{
+    if (cycle_complete || ms_num_freqs == 0) {
+        return;
+    }
+
+    const uint32_t now_us = AP_HAL::micros();
+    if (ms_start_us == 0) {
+        ms_start_us = now_us;
+        ms_last_us = now_us;
+    }
+    const float dt = (now_us - ms_last_us) * 1.0e-6f;
+    const float t = (now_us - ms_start_us) * 1.0e-6f;
+    ms_last_us = now_us;
+
+    // end of period, sum spectra and start the next period
+    if (t >= (ms_period_cnt + 1) * ms_period) {
+        for (uint8_t i = 0; i < ms_num_freqs; i++) {
+            multisine_bin &bin = ms_bin[i];
+            if (ms_period_cnt > 0) {
+                bin.cross.x += bin.tgt_dft.x * bin.meas_dft.x + bin.tgt_dft.y * bin.meas_dft.y;
+                bin.cross.y += bin.tgt_dft.x * bin.meas_dft.y - bin.tgt_dft.y * bin.meas_dft.x;
+                bin.tgt_power += bin.tgt_dft.length_squared();
+                bin.meas_power += bin.meas_dft.length_squared();
+            }
+            bin.tgt_dft.zero();
+            bin.meas_dft.zero();
+        }
+        ms_period_cnt++;
+        if (ms_period_cnt > dwell_cycles) {
+            calc_multisine_response();
+            cycle_complete = true;
+            return;
+        }
+    }
+
+    for (uint8_t i = 0; i < ms_num_freqs; i++) {
+        multisine_bin &bin = ms_bin[i];
+        const float angle = bin.freq * t;
+        const float c = cosf(angle) * dt;
+        const float s = -sinf(angle) * dt;
+        bin.tgt_dft.x += tgt_resp * c;
+        bin.tgt_dft.y += tgt_resp * s;
+        bin.meas_dft.x += meas_resp * c;
+        bin.meas_dft.y += meas_resp * s;
+    }
+}
+
+// calculates the gain, phase and coherence of each multi-sine component.  Phase lag is unwrapped across the
+// components so it increases continuously with frequency
+void AC_AutoTune_FreqResp::calc_multisine_response()
+{
+    for (uint8_t i = 0; i < ms_num_freqs; i++) {
+        multisine_bin &bin = ms_bin[i];
+        const float cross_mag = bin.cross.length();
+        if (!is_positive(bin.tgt_power) || !is_positive(bin.meas_power)) {
+            bin.gain = 0.0f;
+            bin.phase = 0.0f;
+            bin.coherence = 0.0f;
+            continue;
+        }
+        bin.gain = cross_mag / bin.tgt_power;
+        bin.coherence = sq(cross_mag) / (bin.tgt_power * bin.meas_power);
+        bin.phase = degrees(-atan2f(bin.cross.y, bin.cross.x));
+        if (i > 0) {
+            const float prev_phase = ms_bin[i-1].phase;
+            while (bin.phase < prev_phase - 180.0f) {
+                bin.phase += 360.0f;
+            }
+            while (bin.phase > prev_phase + 180.0f) {
+                bin.phase -= 360.0f;
+            }
+        }
+    }
+}
+
+// get the response at a multi-sine component.  returns false if the index is invalid or the test is not complete
+bool AC_AutoTune_FreqResp::get_component(uint8_t idx, float &freq, float &gain, float &phase, float &coherence) const
+{
+    if (!cycle_complete || idx >= ms_num_freqs) {
+        return false;
+    }
+    freq = ms_bin[idx].freq;
+    gain = ms_bin[idx].gain;
+    phase = ms_bin[idx].phase;
+    coherence = ms_bin[idx].coherence;
+    return true;
+}
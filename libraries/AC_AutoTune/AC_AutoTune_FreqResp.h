@@ -5,6 +5,7 @@
 */
 
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/multisine.h>
 
 class AC_AutoTune_FreqResp {
 public:
@@ -17,6 +18,7 @@ public:
     enum InputType {
         DWELL = 0,                 
         SWEEP = 1, 
+        MULTISINE = 2,
     };
 
     // Enumeration of type
@@ -29,6 +31,10 @@ public:
     // Must be called before running dwell or frequency sweep tests
     void init(InputType input_type, ResponseType response_type, uint8_t cycles);
 
+    // Initialize the Frequency Response Object for a multi-sine test.  The response at each
+    // component of the input is found from the cross spectrum averaged over the given number of periods
+    void init_multisine(ResponseType response_type, const MultiSine &input, uint8_t periods);
+
     // Determines the gain and phase based on angle response for a dwell or sweep
     void update(float command, float tgt_resp, float meas_resp, float tgt_freq);
 
@@ -44,6 +50,10 @@ public:
     float get_phase() { return curr_test_phase; }
     float get_accel_max() { return max_accel; }
 
+    // Multi-sine response data accessors, valid once the cycle is complete
+    uint8_t get_num_components() const { return ms_num_freqs; }
+    bool get_component(uint8_t idx, float &freq, float &gain, float &phase, float &coherence) const;
+
 private:
     // time of the start of a new target value search.  keeps noise from prematurely starting the search of a new target value.
     uint32_t new_tgt_time_ms;
@@ -197,4 +207,37 @@ private:
     // Pull data from target peak data buffer object
     void pull_from_tgt_buffer(uint16_t &count, float &amplitude, uint32_t &time_ms);
 
+    // Determines the response at each multi-sine component
+    void update_multisine(float tgt_resp, float meas_resp);
+
+    // Calculates gain, phase and coherence from the averaged spectra
+    void calc_multisine_response();
+
+    // multisine_bin holds the spectra at one multi-sine component.  Complex values are stored as x real, y imaginary
+    struct multisine_bin {
+        float freq;                 // component frequency in rad/s
+        Vector2f tgt_dft;           // DFT of target over the current period
+        Vector2f meas_dft;          // DFT of measured over the current period
+        Vector2f cross;             // cross spectrum of target and measured summed over the periods
+        float tgt_power;            // power spectrum of target summed over the periods
+        float meas_power;           // power spectrum of measured summed over the periods
+        float gain;
+        float phase;                // phase lag in deg
+        float coherence;
+    };
+    multisine_bin ms_bin[MULTISINE_MAX_COMPONENTS];
+
+    // number of multi-sine components
+    uint8_t ms_num_freqs;
+
+    // multi-sine period in seconds
+    float ms_period;
+
+    // start time of the multi-sine test and time of the last sample in microseconds
+    uint32_t ms_start_us;
+    uint32_t ms_last_us;
+
+    // number of multi-sine periods completed
+    uint8_t ms_period_cnt;
+
 };
@@ -68,6 +68,9 @@
 #define AUTOTUNE_ANGLE_MAX_RP_CD            3000    // maximum allowable angle in degrees during testing
 #define AUTOTUNE_ANGLE_NEG_RPY_CD           1000    // maximum allowable angle in degrees during testing
 
+#define AUTOTUNE_MULTISINE_PERIODS             8       // number of multi-sine periods averaged to find the frequency response
+#define AUTOTUNE_MULTISINE_COHERENCE_MIN       0.6f    // multi-sine components with lower coherence are not used
+
 const AP_Param::GroupInfo AC_AutoTune_Heli::var_info[] = {
 
     // @Param: AXES
@@ -126,6 +129,13 @@ const AP_Param::GroupInfo AC_AutoTune_Heli::var_info[] = {
     // @User: Standard
     AP_GROUPINFO("RAT_MAX", 8, AC_AutoTune_Heli, rate_max, 0.0f),
 
+    // @Param: SWP_TYP
+    // @DisplayName: AutoTune frequency sweep type
+    // @Description: Input used for the frequency sweeps. A chirp excites one frequency at a time over 23 seconds. A multi-sine excites harmonics of the minimum sweep frequency together, so the response at all of them is found in a few seconds.
+    // @Values: 0:Chirp,1:Multi-sine
+    // @User: Advanced
+    AP_GROUPINFO("SWP_TYP", 9, AC_AutoTune_Heli, sweep_type, 0),
+
     AP_GROUPEND
 };
 
@@ -252,7 +262,11 @@ void AC_AutoTune_Heli::test_init()
     }
 
     if (!is_equal(start_freq,stop_freq)) {
-        input_type = AC_AutoTune_FreqResp::InputType::SWEEP;
+        if (sweep_type == 1) {
+            input_type = AC_AutoTune_FreqResp::InputType::MULTISINE;
+        } else {
+            input_type = AC_AutoTune_FreqResp::InputType::SWEEP;
+        }
     } else {
         input_type = AC_AutoTune_FreqResp::InputType::DWELL;
     }
@@ -750,6 +764,15 @@ void AC_AutoTune_Heli::dwell_test_init(float start_frq, float stop_frq, float am
         curr_test.gain = 0.0f;
         curr_test.phase = 0.0f;
         chirp_input.init(0.001f * sweep_time_ms, start_frq / M_2PI, stop_frq / M_2PI, 0.0f, 0.0001f * sweep_time_ms, 0.0f);
+    } else if (test_input_type == AC_AutoTune_FreqResp::InputType::MULTISINE) {
+        // the first period fades in and is skipped as a transient, the last fades out
+        const float period = M_2PI / start_frq;
+        const float record = (AUTOTUNE_MULTISINE_PERIODS + 2) * period;
+        step_time_limit_ms = (uint32_t)(1000.0f * record) + 500;
+        reset_sweep_variables();
+        curr_test.gain = 0.0f;
+        curr_test.phase = 0.0f;
+        multisine_input.init(record, start_frq / M_2PI, stop_frq / M_2PI, period, period);
     } else {
         if (!is_zero(start_frq)) {
             // time limit set by adding the pre calc cycles with the dwell cycles.  500 ms added to account for settling with buffer.
@@ -758,8 +781,13 @@ void AC_AutoTune_Heli::dwell_test_init(float start_frq, float stop_frq, float am
         chirp_input.init(0.001f * step_time_limit_ms, start_frq / M_2PI, stop_frq / M_2PI, 0.0f, 0.0001f * step_time_limit_ms, 0.0f);
     }
 
-    freqresp_tgt.init(test_input_type, resp_type, num_dwell_cycles);
-    freqresp_mtr.init(test_input_type, resp_type, num_dwell_cycles);
+    if (test_input_type == AC_AutoTune_FreqResp::InputType::MULTISINE) {
+        freqresp_tgt.init_multisine(resp_type, multisine_input, AUTOTUNE_MULTISINE_PERIODS);
+        freqresp_mtr.init_multisine(resp_type, multisine_input, AUTOTUNE_MULTISINE_PERIODS);
+    } else {
+        freqresp_tgt.init(test_input_type, resp_type, num_dwell_cycles);
+        freqresp_mtr.init(test_input_type, resp_type, num_dwell_cycles);
+    }
     
     dwell_start_time_ms = 0.0f;
     settle_time = 200;
@@ -811,7 +839,12 @@ void AC_AutoTune_Heli::dwell_test_run(sweep_info &test_data)
     }
 
     if (settle_time == 0) {
-        dwell_freq = chirp_input.get_frequency_rads();
+        if (test_input_type == AC_AutoTune_FreqResp::InputType::MULTISINE) {
+            // limit the magnitude using the highest frequency component
+            dwell_freq = multisine_input.get_max_frequency_rads();
+        } else {
+            dwell_freq = chirp_input.get_frequency_rads();
+        }
         float tgt_att_limited = tgt_attitude;
         if (is_positive(dwell_freq)) {
             float tgt_att_temp = tgt_attitude;
@@ -826,8 +859,12 @@ void AC_AutoTune_Heli::dwell_test_run(sweep_info &test_data)
                 tgt_att_limited = tgt_att_temp;
             }
         }
-        target_angle_cd = -chirp_input.update((now - dwell_start_time_ms) * 0.001, degrees(tgt_att_limited) * 100.0f);
-        dwell_freq = chirp_input.get_frequency_rads();
+        if (test_input_type == AC_AutoTune_FreqResp::InputType::MULTISINE) {
+            target_angle_cd = -multisine_input.update((now - dwell_start_time_ms) * 0.001, degrees(tgt_att_limited) * 100.0f);
+        } else {
+            target_angle_cd = -chirp_input.update((now - dwell_start_time_ms) * 0.001, degrees(tgt_att_limited) * 100.0f);
+            dwell_freq = chirp_input.get_frequency_rads();
+        }
         const Vector2f att_fdbk {
             -5730.0f * vel_hold_gain * velocity_bf.y,
             5730.0f * vel_hold_gain * velocity_bf.x
@@ -911,6 +948,11 @@ void AC_AutoTune_Heli::dwell_test_run(sweep_info &test_data)
     command_out = command_filt.apply((command_reading - filt_command_reading.get()),
                 AP::scheduler().get_loop_period_s());
 
+    if (test_input_type == AC_AutoTune_FreqResp::InputType::MULTISINE) {
+        multisine_test_run(now);
+        return;
+    }
+
     float dwell_gain_mtr = 0.0f; 
     float dwell_phase_mtr = 0.0f;
     float dwell_gain_tgt = 0.0f;
@@ -1036,6 +1078,74 @@ void AC_AutoTune_Heli::dwell_test_run(sweep_info &test_data)
     }
 }
 
+// multisine_test_run - determines the response to the multi-sine input and, once complete, the sweep data
+// for the target and motor responses
+void AC_AutoTune_Heli::multisine_test_run(uint32_t now)
+{
+    if (settle_time == 0) {
+        freqresp_mtr.update(command_out, command_out, rotation_rate, 0.0f);
+        freqresp_tgt.update(command_out, filt_target_rate, rotation_rate, 0.0f);
+    }
+
+    if (freqresp_tgt.is_cycle_complete() && freqresp_mtr.is_cycle_complete()) {
+        multisine_sweep_data(freqresp_tgt, sweep_tgt);
+        multisine_sweep_data(freqresp_mtr, sweep_mtr);
+        for (uint8_t i = 0; i < freqresp_tgt.get_num_components(); i++) {
+            float coherence;
+            freqresp_tgt.get_component(i, curr_test_tgt.freq, curr_test_tgt.gain, curr_test_tgt.phase, coherence);
+            freqresp_mtr.get_component(i, curr_test_mtr.freq, curr_test_mtr.gain, curr_test_mtr.phase, coherence);
+#if HAL_LOGGING_ENABLED
+            // log sweep data
+            Log_AutoTuneSweep();
+#endif
+        }
+        curr_test = (test_freq_resp_input == TARGET) ? curr_test_tgt : curr_test_mtr;
+        sweep_complete = true;
+        step = UPDATE_GAINS;
+    } else if (now - step_start_time_ms >= step_time_limit_ms) {
+        GCS_SEND_TEXT(MAV_SEVERITY_INFO, "AutoTune: Step time limit exceeded");
+        sweep_complete = true;
+        step = UPDATE_GAINS;
+    }
+}
+
+// multisine_sweep_data - finds the max gain and the frequencies where the phase crosses 155 and 245 deg from
+// the multi-sine components, matching the phase windows used for the chirp.  Components with low coherence are
+// dominated by noise or nonlinearity and are not used
+void AC_AutoTune_Heli::multisine_sweep_data(const AC_AutoTune_FreqResp &freqresp, sweep_data &data)
+{
+    sweep_info prev {};
+    for (uint8_t i = 0; i < freqresp.get_num_components(); i++) {
+        sweep_info curr;
+        float coherence;
+        if (!freqresp.get_component(i, curr.freq, curr.gain, curr.phase, coherence) ||
+            coherence < AUTOTUNE_MULTISINE_COHERENCE_MIN) {
+            continue;
+        }
+        if (curr.gain > data.maxgain.gain) {
+            data.maxgain = curr;
+        }
+        if (is_positive(prev.freq)) {
+            if (is_zero(data.ph180.freq) && prev.phase < 155.0f && curr.phase >= 155.0f) {
+                interpolate_sweep_info(prev, curr, 155.0f, data.ph180);
+            }
+            if (is_zero(data.ph270.freq) && prev.phase < 245.0f && curr.phase >= 245.0f) {
+                interpolate_sweep_info(prev, curr, 245.0f, data.ph270);
+            }
+        }
+        prev = curr;
+    }
+}
+
+// interpolate_sweep_info - linearly interpolates between two sweep data points to the desired phase
+void AC_AutoTune_Heli::interpolate_sweep_info(const sweep_info &low, const sweep_info &high, float phase, sweep_info &result) const
+{
+    const float ratio = (phase - low.phase) / (high.phase - low.phase);
+    result.freq = low.freq + ratio * (high.freq - low.freq);
+    result.gain = low.gain + ratio * (high.gain - low.gain);
+    result.phase = phase;
+}
+
 // update gains for the rate p up tune type
 void AC_AutoTune_Heli::updating_rate_p_up_all(AxisType test_axis)
 {
@@ -1098,7 +1208,7 @@ void AC_AutoTune_Heli::updating_angle_p_up_all(AxisType test_axis)
 
     // sweep doesn't require gain update so return immediately after setting next test freq
     // determine next_test_freq for dwell testing
-    if (sweep_complete && input_type == AC_AutoTune_FreqResp::InputType::SWEEP){
+    if (sweep_complete && (input_type == AC_AutoTune_FreqResp::InputType::SWEEP || input_type == AC_AutoTune_FreqResp::InputType::MULTISINE)) {
         // if a max gain frequency was found then set the start of the dwells to that freq otherwise start at min frequency
         if (!is_zero(sweep_tgt.maxgain.freq)) {
             next_test_freq = constrain_float(sweep_tgt.maxgain.freq, min_sweep_freq, max_sweep_freq);
@@ -1131,7 +1241,7 @@ void AC_AutoTune_Heli::updating_max_gains_all(AxisType test_axis)
 {
     // sweep doesn't require gain update so return immediately after setting next test freq
     // determine next_test_freq for dwell testing
-    if (sweep_complete && input_type == AC_AutoTune_FreqResp::InputType::SWEEP) {
+    if (sweep_complete && (input_type == AC_AutoTune_FreqResp::InputType::SWEEP || input_type == AC_AutoTune_FreqResp::InputType::MULTISINE)) {
         // if a max gain frequency was found then set the start of the dwells to that freq otherwise start at min frequency
         if (!is_zero(sweep_mtr.ph180.freq)) {
             next_test_freq = constrain_float(sweep_mtr.ph180.freq, min_sweep_freq, max_sweep_freq);
@@ -24,6 +24,7 @@
 
 #include "AC_AutoTune.h"
 #include <AP_Math/chirp.h>
+#include <AP_Math/multisine.h>
 #include <GCS_MAVLink/GCS.h>
 
 #include <AP_Scheduler/AP_Scheduler.h>
@@ -181,6 +182,9 @@ private:
     // dwell test used to perform frequency dwells for rate gains
     void dwell_test_run(sweep_info &test_data);
 
+    // multi-sine test run, called from dwell_test_run for multi-sine input
+    void multisine_test_run(uint32_t now);
+
     // updating_rate_ff_up - adjust FF to ensure the target is reached
     // FF is adjusted until rate requested is achieved
     void updating_rate_ff_up(float &tune_ff, sweep_info &test_data, float &next_freq);
@@ -206,6 +210,9 @@ private:
     // reset the sweep variables
     void reset_sweep_variables();
 
+    // interpolate between two sweep data points to the desired phase
+    void interpolate_sweep_info(const sweep_info &low, const sweep_info &high, float phase, sweep_info &result) const;
+
     // exceeded_freq_range - ensures tuning remains inside frequency range
     bool exceeded_freq_range(float frequency);
 
@@ -286,6 +293,9 @@ private:
     sweep_data sweep_tgt;
     bool sweep_complete;
 
+    // find sweep data from the multi-sine test results
+    void multisine_sweep_data(const AC_AutoTune_FreqResp &freqresp, sweep_data &data);
+
     // fix the frequency sweep time to 23 seconds
     const float sweep_time_ms = 23000;
 
@@ -298,6 +308,7 @@ private:
     AP_Float vel_hold_gain;     // gain for velocity hold
     AP_Float accel_max;         // maximum autotune angular acceleration
     AP_Float rate_max;          // maximum autotune angular rate
+    AP_Int8  sweep_type;        // frequency sweep input, 0 chirp, 1 multi-sine
 
     // freqresp object for the frequency response tests
     AC_AutoTune_FreqResp freqresp_mtr; // frequency response of output to motor mixer input
@@ -308,6 +319,7 @@ private:
     bool cycle_complete_mtr;
 
     Chirp chirp_input;
+    MultiSine multisine_input;
 };
 
 #endif  // AC_AUTOTUNE_ENABLED
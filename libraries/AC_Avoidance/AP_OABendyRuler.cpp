@@ -151,6 +151,24 @@ bool AP_OABendyRuler::search_xy_path(const Location& current_loc, const Location
     float best_margin = -FLT_MAX;
     float best_margin_bearing = best_bearing;
 
+    // calculate margin from proximity sensor obstacles for all bearings in one pass through the object database
+    // bearings are probed in order directly towards the destination then alternating left and right
+    const uint8_t num_bearings = 1 + 2 * (170 / OA_BENDYRULER_BEARING_INC_XY);
+    float bearing_north[num_bearings];
+    float bearing_east[num_bearings];
+    float database_margins[num_bearings];
+    for (uint8_t k = 0; k < num_bearings; k++) {
+        const float bearing_delta = ((k + 1) / 2) * OA_BENDYRULER_BEARING_INC_XY * ((k % 2) == 1 ? -1.0f : 1.0f);
+        const float bearing_rad = radians(wrap_180(bearing_to_dest + bearing_delta));
+        bearing_north[k] = cosf(bearing_rad);
+        bearing_east[k] = sinf(bearing_rad);
+    }
+    if (!calc_margins_from_object_database(current_loc, bearing_north, bearing_east, num_bearings, lookahead_step1_dist, database_margins)) {
+        for (uint8_t k = 0; k < num_bearings; k++) {
+            database_margins[k] = FLT_MAX;
+        }
+    }
+
     for (uint8_t i = 0; i <= (170 / OA_BENDYRULER_BEARING_INC_XY); i++) {
         for (uint8_t bdir = 0; bdir <= 1; bdir++) {
             // skip duplicate check of bearing straight towards destination
@@ -160,6 +178,7 @@ bool AP_OABendyRuler::search_xy_path(const Location& current_loc, const Location
             // bearing that we are probing
             const float bearing_delta = i * OA_BENDYRULER_BEARING_INC_XY * (bdir == 0 ? -1.0f : 1.0f);
             const float bearing_test = wrap_180(bearing_to_dest + bearing_delta);
+            const uint8_t bearing_idx = (i == 0) ? 0 : (2 * i - 1 + bdir);
 
             // ToDo: add effective groundspeed calculations using airspeed
             // ToDo: add prediction of vehicle's position change as part of turn to desired heading
@@ -169,7 +188,7 @@ bool AP_OABendyRuler::search_xy_path(const Location& current_loc, const Location
             test_loc.offset_bearing(bearing_test, lookahead_step1_dist);
 
             // calculate margin from obstacles for this scenario
-            float margin = calc_avoidance_margin(current_loc, test_loc, proximity_only);
+            float margin = calc_avoidance_margin(current_loc, test_loc, proximity_only, database_margins[bearing_idx]);
             if (margin > best_margin) {
                 best_margin_bearing = bearing_test;
                 best_margin = margin;
@@ -419,14 +438,21 @@ bool AP_OABendyRuler::resist_bearing_change(const Location &destination, const L
 // calculate minimum distance between a segment and any obstacle
 float AP_OABendyRuler::calc_avoidance_margin(const Location &start, const Location &end, bool proximity_only) const
 {
-    float margin_min = FLT_MAX;
+    float database_margin;
+    if (!calc_margin_from_object_database(start, end, database_margin)) {
+        database_margin = FLT_MAX;
+    }
+    return calc_avoidance_margin(start, end, proximity_only, database_margin);
+}
+
+// calculate minimum distance between a segment and any obstacle
+// database_margin is the margin from proximity sensor obstacles which has already been calculated (FLT_MAX if there are none)
+float AP_OABendyRuler::calc_avoidance_margin(const Location &start, const Location &end, bool proximity_only, float database_margin) const
+{
+    float margin_min = database_margin;
 
     float latest_margin;
-    
-    if (calc_margin_from_object_database(start, end, latest_margin)) {
-        margin_min = MIN(margin_min, latest_margin);
-    }
-    
+
     if (proximity_only) {
         // only need margin from proximity data
         return margin_min;
@@ -716,4 +742,54 @@ bool AP_OABendyRuler::calc_margin_from_object_database(const Location &start, co
     return false;
 }
 
+// calculate minimum distance between proximity sensor obstacles and several paths of length_m meters from start
+// path directions are given as unit vectors in the north and east arrays, all paths are checked against each obstacle in one pass
+// on success returns true and updates margins
+bool AP_OABendyRuler::calc_margins_from_object_database(const Location &start, const float north[], const float east[], uint8_t num_paths, float length_m, float margins[]) const
+{
+    // exit immediately if db is empty
+    AP_OADatabase *oaDb = AP::oadatabase();
+    if (oaDb == nullptr || !oaDb->healthy() || !is_positive(length_m)) {
+        return false;
+    }
+
+    // convert start to offset (in meters) from EKF origin
+    Vector3f start_NEU;
+    if (!start.get_vector_from_origin_NEU_m(start_NEU)) {
+        return false;
+    }
+
+    for (uint8_t k = 0; k < num_paths; k++) {
+        margins[k] = FLT_MAX;
+    }
+
+    // largest of the paths' margins so far, obstacles further than this from every path cannot change any margin
+    float largest_margin = FLT_MAX;
+    for (uint16_t i=0; i<oaDb->database_count(); i++) {
+        const AP_OADatabase::OA_DbItem& item = oaDb->get_item(i);
+        const Vector3f ofs = item.pos - start_NEU;
+        const float ofs_length_sq = ofs.length_squared();
+
+        // no path can get closer to the obstacle than its distance from start less the path length
+        if ((largest_margin < FLT_MAX) && (safe_sqrt(ofs_length_sq) - length_m - item.radius >= largest_margin)) {
+            continue;
+        }
+
+        largest_margin = -FLT_MAX;
+        for (uint8_t k = 0; k < num_paths; k++) {
+            // distance along path to closest point to obstacle
+            const float along = constrain_float(ofs.x * north[k] + ofs.y * east[k], 0.0f, length_m);
+            // margin is distance between line segment and obstacle minus obstacle's radius
+            const float m = safe_sqrt(ofs_length_sq - along * (2.0f * (ofs.x * north[k] + ofs.y * east[k]) - along)) - item.radius;
+            if (m < margins[k]) {
+                margins[k] = m;
+            }
+            largest_margin = MAX(largest_margin, margins[k]);
+        }
+    }
+
+    // margins are only valid if there was at least one obstacle
+    return (largest_margin < FLT_MAX);
+}
+
 #endif  // AP_OAPATHPLANNER_BENDYRULER_ENABLED
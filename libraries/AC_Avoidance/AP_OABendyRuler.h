@@ -48,6 +48,10 @@ private:
     // calculate minimum distance between a path and any obstacle
     float calc_avoidance_margin(const Location &start, const Location &end, bool proximity_only) const;
 
+    // calculate minimum distance between a path and any obstacle
+    // database_margin is the margin from proximity sensor obstacles which has already been calculated (FLT_MAX if there are none)
+    float calc_avoidance_margin(const Location &start, const Location &end, bool proximity_only, float database_margin) const;
+
     // determine if BendyRuler should accept the new bearing or try and resist it. Returns true if bearing is not changed  
     bool resist_bearing_change(const Location &destination, const Location &current_loc, bool active, float bearing_test, float lookahead_step1_dist, float margin, Location &prev_dest, float &prev_bearing, float &final_bearing, float &final_margin, bool proximity_only) const;    
 
@@ -71,6 +75,11 @@ private:
     // on success returns true and updates margin
     bool calc_margin_from_object_database(const Location &start, const Location &end, float &margin) const;
 
+    // calculate minimum distance between proximity sensor obstacles and several paths of length_m meters from start
+    // path directions are given as unit vectors in the north and east arrays, all paths are checked against each obstacle in one pass
+    // on success returns true and updates margins
+    bool calc_margins_from_object_database(const Location &start, const float north[], const float east[], uint8_t num_paths, float length_m, float margins[]) const;
+
     // Logging function
 #if HAL_LOGGING_ENABLED
     void Write_OABendyRuler(const uint8_t type, const bool active, const float target_yaw, const float target_pitch, const bool resist_chg, const float margin, const Location &final_dest, const Location &oa_dest) const;
@@ -40,6 +40,11 @@ extern const AP_HAL::HAL& hal;
     #define AP_OADATABASE_DISTANCE_FROM_HOME 3
 #endif
 
+#define AP_OADATABASE_GRID_CELL_SIZE    2.0f    // width of spatial index grid cells (in meters)
+#define AP_OADATABASE_GRID_BUCKETS_MIN  16      // minimum number of buckets in spatial index
+#define AP_OADATABASE_GRID_BUCKETS_MAX  4096    // maximum number of buckets in spatial index
+#define AP_OADATABASE_GRID_NONE         UINT16_MAX // marks the end of a bucket's list of items
+
 const AP_Param::GroupInfo AP_OADatabase::var_info[] = {
 
     // @Param: SIZE
@@ -132,6 +137,12 @@ void AP_OADatabase::init()
         GCS_SEND_TEXT(MAV_SEVERITY_INFO, "DB init failed . Sizes queue:%u, db:%u", (unsigned int)_queue.size, (unsigned int)_database.size);
         delete _queue.items;
         delete[] _database.items;
+        delete[] _database.grid_head;
+        delete[] _database.grid_next;
+        _queue.items = nullptr;
+        _database.items = nullptr;
+        _database.grid_head = nullptr;
+        _database.grid_next = nullptr;
         return;
     }
 }
@@ -206,6 +217,24 @@ void AP_OADatabase::init_database()
     }
 
     _database.items = NEW_NOTHROW OA_DbItem[_database.size];
+
+    // spatial index with about two items per bucket when full
+    _database.grid_buckets = AP_OADATABASE_GRID_BUCKETS_MIN;
+    while ((_database.grid_buckets < AP_OADATABASE_GRID_BUCKETS_MAX) && (_database.grid_buckets * 2U < _database.size)) {
+        _database.grid_buckets *= 2;
+    }
+    _database.grid_head = NEW_NOTHROW uint16_t[_database.grid_buckets];
+    _database.grid_next = NEW_NOTHROW uint16_t[_database.size];
+    if ((_database.grid_head == nullptr) || (_database.grid_next == nullptr)) {
+        delete[] _database.grid_head;
+        delete[] _database.grid_next;
+        _database.grid_head = nullptr;
+        _database.grid_next = nullptr;
+        return;
+    }
+    for (uint16_t i=0; i<_database.grid_buckets; i++) {
+        _database.grid_head[i] = AP_OADATABASE_GRID_NONE;
+    }
 }
 
 // get bitmask of gcs channels item should be sent to based on its importance
@@ -265,17 +294,11 @@ bool AP_OADatabase::process_queue()
 
         item.send_to_gcs = get_send_to_gcs_flags(item.importance);
 
-        // compare item to all items in database. If found a similar item, update the existing, else add it as a new one
-        bool found = false;
-        for (uint16_t i=0; i<_database.count; i++) {
-            if (is_close_to_item_in_database(i, item)) {
-                database_item_refresh(i, item.timestamp_ms, item.radius);
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) {
+        // compare item to nearby items in database. If found a similar item, update the existing, else add it as a new one
+        uint16_t index;
+        if (find_close_item_in_database(item, index)) {
+            database_item_refresh(index, item.timestamp_ms, item.radius);
+        } else {
             database_item_add(item);
         }
     }
@@ -289,6 +312,8 @@ void AP_OADatabase::database_item_add(const OA_DbItem &item)
     }
     _database.items[_database.count] = item;
     _database.items[_database.count].send_to_gcs = get_send_to_gcs_flags(_database.items[_database.count].importance);
+    grid_add(_database.count);
+    _database.radius_max = MAX(_database.radius_max, item.radius);
     _database.count++;
 }
 
@@ -302,6 +327,7 @@ void AP_OADatabase::database_item_remove(const uint16_t index)
     // radius of 0 tells the GCS we don't care about it any more (aka it expired)
     _database.items[index].radius = 0;
     _database.items[index].send_to_gcs = get_send_to_gcs_flags(_database.items[index].importance);
+    grid_remove(index);
 
     _database.count--;
     if (_database.count == 0) {
@@ -310,8 +336,10 @@ void AP_OADatabase::database_item_remove(const uint16_t index)
 
     if (index != _database.count) {
         // copy last object in array over expired object
+        grid_remove(_database.count);
         _database.items[index] = _database.items[_database.count];
         _database.items[index].send_to_gcs = get_send_to_gcs_flags(_database.items[index].importance);
+        grid_add(index);
     }
 }
 
@@ -332,6 +360,7 @@ void AP_OADatabase::database_item_refresh(const uint16_t index, const uint32_t t
         _database.items[index].timestamp_ms = timestamp_ms;
         _database.items[index].radius = radius;
         _database.items[index].send_to_gcs = get_send_to_gcs_flags(_database.items[index].importance);
+        _database.radius_max = MAX(_database.radius_max, radius);
     }
 }
 
@@ -348,13 +377,133 @@ void AP_OADatabase::database_items_remove_all_expired()
     const uint32_t now_ms = AP_HAL::millis();
     const uint32_t expiry_ms = (uint32_t)_database_expiry_seconds * 1000;
     uint16_t index = 0;
+    float radius_max = 0;
     while (index < _database.count) {
         if (now_ms - _database.items[index].timestamp_ms > expiry_ms) {
             database_item_remove(index);
         } else {
+            // recalculate largest radius of remaining items so spatial index searches stay small
+            radius_max = MAX(radius_max, _database.items[index].radius);
             index++;
         }
     }
+    _database.radius_max = radius_max;
+}
+
+// get the spatial index grid cell holding a position
+void AP_OADatabase::grid_cell(const Vector3f &pos, int32_t &cell_x, int32_t &cell_y) const
+{
+    cell_x = (int32_t)floorf(pos.x * (1.0f / AP_OADATABASE_GRID_CELL_SIZE));
+    cell_y = (int32_t)floorf(pos.y * (1.0f / AP_OADATABASE_GRID_CELL_SIZE));
+}
+
+// get the bucket a spatial index grid cell is held in
+uint16_t AP_OADatabase::grid_bucket(int32_t cell_x, int32_t cell_y) const
+{
+    const uint32_t hash = ((uint32_t)cell_x * 73856093U) ^ ((uint32_t)cell_y * 19349663U);
+    return hash & (_database.grid_buckets - 1);
+}
+
+// add database item "index" to the spatial index
+void AP_OADatabase::grid_add(const uint16_t index)
+{
+    int32_t cell_x, cell_y;
+    grid_cell(_database.items[index].pos, cell_x, cell_y);
+    const uint16_t bucket = grid_bucket(cell_x, cell_y);
+    _database.grid_next[index] = _database.grid_head[bucket];
+    _database.grid_head[bucket] = index;
+}
+
+// remove database item "index" from the spatial index
+void AP_OADatabase::grid_remove(const uint16_t index)
+{
+    int32_t cell_x, cell_y;
+    grid_cell(_database.items[index].pos, cell_x, cell_y);
+    uint16_t *link = &_database.grid_head[grid_bucket(cell_x, cell_y)];
+    while (*link != AP_OADATABASE_GRID_NONE) {
+        if (*link == index) {
+            *link = _database.grid_next[index];
+            return;
+        }
+        link = &_database.grid_next[*link];
+    }
+}
+
+// find an item in the database close to "item", returns true and updates index if found
+bool AP_OADatabase::find_close_item_in_database(const OA_DbItem &item, uint16_t &index) const
+{
+    // items are close if within either item's radius so search the cells within the largest radius
+    const int32_t range = (int32_t)ceilf(MAX(item.radius, _database.radius_max) * (1.0f / AP_OADATABASE_GRID_CELL_SIZE));
+    if (sq(2 * range + 1) > _database.grid_buckets) {
+        // searching the cells would visit every bucket so check all items
+        for (uint16_t i=0; i<_database.count; i++) {
+            if (is_close_to_item_in_database(i, item)) {
+                index = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int32_t cell_x, cell_y;
+    grid_cell(item.pos, cell_x, cell_y);
+    for (int32_t x = cell_x - range; x <= cell_x + range; x++) {
+        for (int32_t y = cell_y - range; y <= cell_y + range; y++) {
+            for (uint16_t i = _database.grid_head[grid_bucket(x, y)]; i != AP_OADATABASE_GRID_NONE; i = _database.grid_next[i]) {
+                if (is_close_to_item_in_database(i, item)) {
+                    index = i;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// find items whose edge may be within dist meters horizontally of pos (an offset in meters from the EKF origin)
+// fills in up to max_indices indices (for use with get_item) and returns the number found
+uint16_t AP_OADatabase::find_items_within(const Vector3f &pos, float dist, uint16_t indices[], uint16_t max_indices) const
+{
+    if (!healthy()) {
+        return 0;
+    }
+
+    uint16_t num_found = 0;
+    const float search_dist = MAX(dist, 0.0f) + _database.radius_max;
+    const int32_t range = (int32_t)ceilf(search_dist * (1.0f / AP_OADATABASE_GRID_CELL_SIZE));
+    if (sq(2 * range + 1) > _database.grid_buckets) {
+        // searching the cells would visit every bucket so check all items
+        for (uint16_t i=0; (i<_database.count) && (num_found < max_indices); i++) {
+            const OA_DbItem &item = _database.items[i];
+            if ((item.pos.xy() - pos.xy()).length() - item.radius <= dist) {
+                indices[num_found++] = i;
+            }
+        }
+        return num_found;
+    }
+
+    int32_t cell_x, cell_y;
+    grid_cell(pos, cell_x, cell_y);
+    for (int32_t x = cell_x - range; x <= cell_x + range; x++) {
+        for (int32_t y = cell_y - range; y <= cell_y + range; y++) {
+            for (uint16_t i = _database.grid_head[grid_bucket(x, y)]; i != AP_OADATABASE_GRID_NONE; i = _database.grid_next[i]) {
+                const OA_DbItem &item = _database.items[i];
+                // buckets may hold other cells so only accept items in this cell to avoid duplicates
+                int32_t item_x, item_y;
+                grid_cell(item.pos, item_x, item_y);
+                if ((item_x != x) || (item_y != y)) {
+                    continue;
+                }
+                if ((item.pos.xy() - pos.xy()).length() - item.radius <= dist) {
+                    if (num_found >= max_indices) {
+                        return num_found;
+                    }
+                    indices[num_found++] = i;
+                }
+            }
+        }
+    }
+    return num_found;
 }
 
 // returns true if a similar object already exists in database. When true, the object timer is also reset
@@ -42,7 +42,7 @@ public:
     void queue_push(const Vector3f &pos, uint32_t timestamp_ms, float distance);
 
     // returns true if database is healthy
-    bool healthy() const { return (_queue.items != nullptr) && (_database.items != nullptr); }
+    bool healthy() const { return (_queue.items != nullptr) && (_database.items != nullptr) && (_database.grid_head != nullptr); }
 
     // fetch an item in database. Undefined result when i >= _database.count.
     const OA_DbItem& get_item(uint32_t i) const { return _database.items[i]; }
@@ -50,6 +50,10 @@ public:
     // get number of items in the database
     uint16_t database_count() const { return _database.count; }
 
+    // find items whose edge may be within dist meters horizontally of pos (an offset in meters from the EKF origin)
+    // fills in up to max_indices indices (for use with get_item) and returns the number found
+    uint16_t find_items_within(const Vector3f &pos, float dist, uint16_t indices[], uint16_t max_indices) const;
+
     // empty queue and try and put into database. Return true if there's more work to do
     bool process_queue();
 
@@ -77,6 +81,16 @@ private:
     // returns true if database item "index" is close to "item"
     bool is_close_to_item_in_database(const uint16_t index, const OA_DbItem &item) const;
 
+    // find an item in the database close to "item", returns true and updates index if found
+    bool find_close_item_in_database(const OA_DbItem &item, uint16_t &index) const;
+
+    // spatial index of database items by horizontal grid cell
+    // items in the same cell are linked through grid_next starting from the grid_head bucket the cell hashes to
+    void grid_cell(const Vector3f &pos, int32_t &cell_x, int32_t &cell_y) const;
+    uint16_t grid_bucket(int32_t cell_x, int32_t cell_y) const;
+    void grid_add(const uint16_t index);
+    void grid_remove(const uint16_t index);
+
     // enum for use with _OUTPUT parameter
     enum class OutputLevel {
         NONE = 0,
@@ -106,6 +120,10 @@ private:
         OA_DbItem       *items;                             // array of objects in the database
         uint16_t        count;                              // number of objects in the items array
         uint16_t        size;                               // cached value of _database_size_param that sticks after initialized
+        uint16_t        *grid_head;                         // index of first item in each bucket of the grid, UINT16_MAX if empty
+        uint16_t        *grid_next;                         // index of the next item in the same bucket for each item, UINT16_MAX if last
+        uint16_t        grid_buckets;                       // number of buckets in grid_head, always a power of two
+        float           radius_max;                         // largest radius of any item in the database (in meters)
     } _database;
 
     uint16_t _next_index_to_send[MAVLINK_COMM_NUM_BUFFERS]; // index of next object in _database to send to GCS
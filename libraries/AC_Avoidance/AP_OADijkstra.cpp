@@ -25,19 +25,29 @@
 #if AP_FENCE_ENABLED
 
 #include <AP_AHRS/AP_AHRS.h>
+#include <AP_Common/Bitmask.h>
 #include <AP_Logger/AP_Logger.h>
 #include <GCS_MAVLink/GCS.h>
 
 #define OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK  32      // expanding arrays for fence points and paths to destination will grow in increments of 20 elements
 #define OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX        255     // index use to indicate we do not have a tentative short path for a node
 #define OA_DIJKSTRA_ERROR_REPORTING_INTERVAL_MS         5000    // failure messages sent to GCS every 5 seconds
+#define OA_DIJKSTRA_FENCE_ITEMS_PER_CHUNK               8       // expanding arrays of exclusion polygons and circles grow in increments of 8 elements
+#define OA_DIJKSTRA_MAX_VISGRAPH_ITEMS                  255     // maximum number of exclusion polygons and circles for incremental visibility graph updates
+#define OA_DIJKSTRA_FENCE_ADJACENCY_PER_CHUNK           256     // expanding array of fence visgraph edges per point grows in increments of 256 elements
 
 /// Constructor
 AP_OADijkstra::AP_OADijkstra(AP_Int16 &options) :
         _inclusion_polygon_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _exclusion_polygon_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+        _exclusion_polygon_items(OA_DIJKSTRA_FENCE_ITEMS_PER_CHUNK),
         _exclusion_circle_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+        _exclusion_circle_items(OA_DIJKSTRA_FENCE_ITEMS_PER_CHUNK),
+        _visgraph_items(OA_DIJKSTRA_FENCE_ITEMS_PER_CHUNK),
         _short_path_data(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+        _fence_adjacency(OA_DIJKSTRA_FENCE_ADJACENCY_PER_CHUNK),
+        _fence_adjacency_start(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+        _open_set(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _path(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _options(options)
 {
@@ -128,7 +138,7 @@ AP_OADijkstra::AP_OADijkstra_State AP_OADijkstra::update(const Location &current
 
     // create visgraph for all fence (with margin) points
     if (!_polyfence_visgraph_ok) {
-        _polyfence_visgraph_ok = create_fence_visgraph(_error_id);
+        _polyfence_visgraph_ok = update_fence_visgraph(_error_id);
         if (!_polyfence_visgraph_ok) {
             _shortest_path_ok = false;
             dest_to_next_dest_clear = _dest_to_next_dest_clear = false;
@@ -339,6 +349,26 @@ bool AP_OADijkstra::create_inclusion_polygon_with_margin(float margin_cm, AP_OAD
     // return immediately if no polygons
     const uint8_t num_inclusion_polygons = fence->polyfence().get_inclusion_polygon_count();
 
+    // hash all inclusion fences so unchanged inclusion fences can be detected when the visibility graph is updated
+    // inclusion circles do not have points but are included because they limit the visible edges
+    _inclusion_hash = FNV_1_OFFSET_BASIS_64;
+    hash_fnv_1a(sizeof(margin_cm), (const uint8_t*)&margin_cm, &_inclusion_hash);
+    for (uint8_t i = 0; i < num_inclusion_polygons; i++) {
+        uint16_t num_points;
+        const Vector2f* boundary = fence->polyfence().get_inclusion_polygon(i, num_points);
+        if (boundary != nullptr) {
+            hash_fnv_1a(num_points * sizeof(Vector2f), (const uint8_t*)boundary, &_inclusion_hash);
+        }
+    }
+    for (uint8_t i = 0; i < fence->polyfence().get_inclusion_circle_count(); i++) {
+        Vector2f center_pos_cm;
+        float radius;
+        if (fence->polyfence().get_inclusion_circle(i, center_pos_cm, radius)) {
+            hash_fnv_1a(sizeof(center_pos_cm), (const uint8_t*)&center_pos_cm, &_inclusion_hash);
+            hash_fnv_1a(sizeof(radius), (const uint8_t*)&radius, &_inclusion_hash);
+        }
+    }
+
     // iterate through polygons and create inner points
     for (uint8_t i = 0; i < num_inclusion_polygons; i++) {
         uint16_t num_points;
@@ -436,15 +466,42 @@ bool AP_OADijkstra::create_exclusion_polygon_with_margin(float margin_cm, AP_OAD
 
     // clear all points
     _exclusion_polygon_numpoints = 0;
+    _exclusion_polygon_numitems = 0;
 
     // return immediately if no exclusion polygons
     const uint8_t num_exclusion_polygons = fence->polyfence().get_exclusion_polygon_count();
 
+    // expand item array if required
+    if (!_exclusion_polygon_items.expand_to_hold(num_exclusion_polygons)) {
+        err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+        return false;
+    }
+
     // iterate through exclusion polygons and create outer points
     for (uint8_t i = 0; i < num_exclusion_polygons; i++) {
         uint16_t num_points;
         const Vector2f* boundary = fence->polyfence().get_exclusion_polygon(i, num_points);
-   
+        if (boundary == nullptr) {
+            num_points = 0;
+        }
+
+        // record polygon so changes can be detected when the visibility graph is updated
+        FenceItem &item = _exclusion_polygon_items[_exclusion_polygon_numitems++];
+        item.hash = FNV_1_OFFSET_BASIS_64;
+        hash_fnv_1a(sizeof(margin_cm), (const uint8_t*)&margin_cm, &item.hash);
+        hash_fnv_1a(num_points * sizeof(Vector2f), (const uint8_t*)boundary, &item.hash);
+        item.min_pt = item.max_pt = (num_points > 0) ? boundary[0] : Vector2f();
+        for (uint16_t j = 1; j < num_points; j++) {
+            item.min_pt.x = MIN(item.min_pt.x, boundary[j].x);
+            item.min_pt.y = MIN(item.min_pt.y, boundary[j].y);
+            item.max_pt.x = MAX(item.max_pt.x, boundary[j].x);
+            item.max_pt.y = MAX(item.max_pt.y, boundary[j].y);
+        }
+        item.first_point = _exclusion_polygon_numpoints;
+        item.num_points = 0;
+        item.fence_index = i;
+        item.is_circle = false;
+
         // for each point in exclusion polygon
         // Note: boundary is "unclosed" meaning the last point is *not* the same as the first
         uint16_t new_points = 0;
@@ -501,6 +558,7 @@ bool AP_OADijkstra::create_exclusion_polygon_with_margin(float margin_cm, AP_OAD
 
         // update total number of points
         _exclusion_polygon_numpoints += new_points;
+        item.num_points = new_points;
     }
     return true;
 }
@@ -530,6 +588,7 @@ bool AP_OADijkstra::create_exclusion_circle_with_margin(float margin_cm, AP_OADi
 
     // clear all points
     _exclusion_circle_numpoints = 0;
+    _exclusion_circle_numitems = 0;
 
     // unit length offsets for polygon points around circles
     const Vector2f unit_offsets[] = {
@@ -544,7 +603,8 @@ bool AP_OADijkstra::create_exclusion_circle_with_margin(float margin_cm, AP_OADi
 
     // expand polygon point array if required
     const uint8_t num_exclusion_circles = fence->polyfence().get_exclusion_circle_count();
-    if (!_exclusion_circle_pts.expand_to_hold(num_exclusion_circles * num_points_per_circle)) {
+    if (!_exclusion_circle_pts.expand_to_hold(num_exclusion_circles * num_points_per_circle) ||
+        !_exclusion_circle_items.expand_to_hold(num_exclusion_circles)) {
         err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
         return false;
     }
@@ -557,6 +617,19 @@ bool AP_OADijkstra::create_exclusion_circle_with_margin(float margin_cm, AP_OADi
             // scaler to ensure lines between points do not intersect circle
             const float scaler = (1.0f / cosf(radians(180.0f / (float)num_points_per_circle))) * ((radius * 100.0f) + margin_cm);
 
+            // record circle so changes can be detected when the visibility graph is updated
+            FenceItem &item = _exclusion_circle_items[_exclusion_circle_numitems++];
+            item.hash = FNV_1_OFFSET_BASIS_64;
+            hash_fnv_1a(sizeof(margin_cm), (const uint8_t*)&margin_cm, &item.hash);
+            hash_fnv_1a(sizeof(circle_pos_cm), (const uint8_t*)&circle_pos_cm, &item.hash);
+            hash_fnv_1a(sizeof(radius), (const uint8_t*)&radius, &item.hash);
+            item.min_pt = circle_pos_cm - Vector2f{radius * 100.0f, radius * 100.0f};
+            item.max_pt = circle_pos_cm + Vector2f{radius * 100.0f, radius * 100.0f};
+            item.first_point = _exclusion_circle_numpoints;
+            item.num_points = num_points_per_circle;
+            item.fence_index = i;
+            item.is_circle = true;
+
             // add points to array
             for (uint8_t j = 0; j < num_points_per_circle; j++) {
                 _exclusion_circle_pts[_exclusion_circle_numpoints] = circle_pos_cm + (unit_offsets[j] * scaler);
@@ -623,6 +696,15 @@ bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &
     for (uint8_t i = 0; i < fence->polyfence().get_inclusion_polygon_count(); i++) {
         const Vector2f* boundary = fence->polyfence().get_inclusion_polygon(i, num_points);
         if (boundary != nullptr) {
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+            const AP_PolygonIndex *index = fence->polyfence().get_inclusion_polygon_index(i);
+            if (index != nullptr) {
+                if (index->intersects(boundary, seg_start, seg_end)) {
+                    return true;
+                }
+                continue;
+            }
+#endif
             Vector2f intersection;
             if (Polygon_intersects(boundary, num_points, seg_start, seg_end, intersection)) {
                 return true;
@@ -632,12 +714,8 @@ bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &
 
     // determine if segment crosses any of the exclusion polygons
     for (uint8_t i = 0; i < fence->polyfence().get_exclusion_polygon_count(); i++) {
-        const Vector2f* boundary = fence->polyfence().get_exclusion_polygon(i, num_points);
-        if (boundary != nullptr) {
-            Vector2f intersection;
-            if (Polygon_intersects(boundary, num_points, seg_start, seg_end, intersection)) {
-                return true;
-            }
+        if (intersects_exclusion_polygon(i, seg_start, seg_end)) {
+            return true;
         }
     }
 
@@ -659,16 +737,8 @@ bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &
 
     // determine if segment crosses any of the exclusion circles
     for (uint8_t i = 0; i < fence->polyfence().get_exclusion_circle_count(); i++) {
-        Vector2f center_pos_cm;
-        float radius;
-        if (fence->polyfence().get_exclusion_circle(i, center_pos_cm, radius)) {
-            // calculate distance between circle's center and segment
-            const float dist_cm = Vector2f::closest_distance_between_line_and_point(seg_start, seg_end, center_pos_cm);
-
-            // intersects if distance is less than radius
-            if (dist_cm <= (radius * 100.0f)) {
-                return true;
-            }
+        if (intersects_exclusion_circle(i, seg_start, seg_end)) {
+            return true;
         }
     }
 
@@ -676,6 +746,50 @@ bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &
     return false;
 }
 
+// returns true if line segment intersects the exclusion polygon with the given index
+bool AP_OADijkstra::intersects_exclusion_polygon(uint8_t index, const Vector2f &seg_start, const Vector2f &seg_end) const
+{
+    const AC_Fence *fence = AC_Fence::get_singleton();
+    if (fence == nullptr) {
+        return false;
+    }
+
+    uint16_t num_points = 0;
+    const Vector2f* boundary = fence->polyfence().get_exclusion_polygon(index, num_points);
+    if (boundary == nullptr) {
+        return false;
+    }
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+    const AP_PolygonIndex *polygon_index = fence->polyfence().get_exclusion_polygon_index(index);
+    if (polygon_index != nullptr) {
+        return polygon_index->intersects(boundary, seg_start, seg_end);
+    }
+#endif
+    Vector2f intersection;
+    return Polygon_intersects(boundary, num_points, seg_start, seg_end, intersection);
+}
+
+// returns true if line segment intersects the exclusion circle with the given index
+bool AP_OADijkstra::intersects_exclusion_circle(uint8_t index, const Vector2f &seg_start, const Vector2f &seg_end) const
+{
+    const AC_Fence *fence = AC_Fence::get_singleton();
+    if (fence == nullptr) {
+        return false;
+    }
+
+    Vector2f center_pos_cm;
+    float radius;
+    if (!fence->polyfence().get_exclusion_circle(index, center_pos_cm, radius)) {
+        return false;
+    }
+
+    // calculate distance between circle's center and segment
+    const float dist_cm = Vector2f::closest_distance_between_line_and_point(seg_start, seg_end, center_pos_cm);
+
+    // intersects if distance is less than radius
+    return (dist_cm <= (radius * 100.0f));
+}
+
 // create visibility graph for all fence (with margin) points
 // returns true on success.  returns false on failure and err_id is updated
 // requires these functions to have been run create_inclusion_polygon_with_margin, create_exclusion_polygon_with_margin, create_exclusion_circle_with_margin
@@ -722,6 +836,194 @@ bool AP_OADijkstra::create_fence_visgraph(AP_OADijkstra_Error &err_id)
     return true;
 }
 
+// get a single exclusion polygon or circle with first_point converted to an index into the total list of points
+// polygons are returned first followed by circles
+AP_OADijkstra::FenceItem AP_OADijkstra::get_fence_item(uint16_t index) const
+{
+    FenceItem item;
+    if (index < _exclusion_polygon_numitems) {
+        item = _exclusion_polygon_items[index];
+        item.first_point += _inclusion_polygon_numpoints;
+    } else {
+        item = _exclusion_circle_items[index - _exclusion_polygon_numitems];
+        item.first_point += _inclusion_polygon_numpoints + _exclusion_polygon_numpoints;
+    }
+    return item;
+}
+
+// returns true if the bounding box of a line segment overlaps the bounding box of a fence item
+// segments that do not overlap cannot intersect the item
+static bool segment_near_item(const Vector2f &seg_start, const Vector2f &seg_end, const Vector2f &min_pt, const Vector2f &max_pt)
+{
+    return (MAX(seg_start.x, seg_end.x) >= min_pt.x) && (MIN(seg_start.x, seg_end.x) <= max_pt.x) &&
+           (MAX(seg_start.y, seg_end.y) >= min_pt.y) && (MIN(seg_start.y, seg_end.y) <= max_pt.y);
+}
+
+// update visibility graph after the fence has changed
+// if only exclusion polygons and circles have changed, only the edges they may affect are recalculated
+// otherwise the visibility graph is created from scratch
+// returns true on success.  returns false on failure and err_id is updated
+bool AP_OADijkstra::update_fence_visgraph(AP_OADijkstra_Error &err_id)
+{
+    bool ret;
+    if (_visgraph_items_ok && (_visgraph_inclusion_hash == _inclusion_hash)) {
+        ret = update_fence_visgraph_for_changes(err_id);
+    } else {
+        ret = create_fence_visgraph(err_id);
+    }
+
+    // destination's visibility graph and the fence adjacency must be recalculated against the new fence
+    _destination_visgraph_ok = false;
+    _fence_adjacency_ok = false;
+
+    // record the fence used so that the next update can be incremental
+    // a failed update may leave the graph incomplete so the next update must start from scratch
+    _visgraph_items_ok = false;
+    if (!ret) {
+        return false;
+    }
+    const uint16_t num_items = total_numitems();
+    if ((num_items <= OA_DIJKSTRA_MAX_VISGRAPH_ITEMS) && _visgraph_items.expand_to_hold(num_items)) {
+        for (uint16_t i = 0; i < num_items; i++) {
+            _visgraph_items[i] = get_fence_item(i);
+        }
+        _visgraph_numitems = num_items;
+        _visgraph_inclusion_hash = _inclusion_hash;
+        _visgraph_items_ok = true;
+    }
+    return true;
+}
+
+// update visibility graph for exclusion polygons and circles added or removed since it was created
+// requires the inclusion fences to be unchanged so that the inclusion polygon points (which are first in the list of points) are the same
+// an edge between points of unchanged items remains visible unless it intersects an added item
+// and an edge that was not visible can only become visible if it passes near a removed item, so only those edges are fully recalculated
+// returns true on success.  returns false on failure and err_id is updated
+bool AP_OADijkstra::update_fence_visgraph_for_changes(AP_OADijkstra_Error &err_id)
+{
+    // fail if more fence points than algorithm can handle
+    if ((total_numpoints() >= OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) || (total_numitems() > OA_DIJKSTRA_MAX_VISGRAPH_ITEMS)) {
+        return create_fence_visgraph(err_id);
+    }
+
+    // map points of the old graph to points of the new graph, removed points map to OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX
+    // inclusion polygon points are unchanged
+    uint8_t old_to_new[OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX];
+    memset(old_to_new, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, sizeof(old_to_new));
+    Bitmask<OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX> point_unchanged;
+    for (uint8_t i = 0; i < _inclusion_polygon_numpoints; i++) {
+        old_to_new[i] = i;
+        point_unchanged.set(i);
+    }
+
+    // match each new item with an identical old item
+    Bitmask<OA_DIJKSTRA_MAX_VISGRAPH_ITEMS> old_item_matched;
+    Bitmask<OA_DIJKSTRA_MAX_VISGRAPH_ITEMS> new_item_matched;
+    uint16_t num_changes = 0;
+    for (uint16_t n = 0; n < total_numitems(); n++) {
+        const FenceItem new_item = get_fence_item(n);
+        for (uint8_t o = 0; o < _visgraph_numitems; o++) {
+            const FenceItem &old_item = _visgraph_items[o];
+            if (old_item_matched.get(o) || (old_item.hash != new_item.hash) ||
+                (old_item.is_circle != new_item.is_circle) || (old_item.num_points != new_item.num_points)) {
+                continue;
+            }
+            old_item_matched.set(o);
+            new_item_matched.set(n);
+            for (uint8_t k = 0; k < new_item.num_points; k++) {
+                old_to_new[old_item.first_point + k] = new_item.first_point + k;
+                point_unchanged.set(new_item.first_point + k);
+            }
+            break;
+        }
+        if (!new_item_matched.get(n)) {
+            num_changes++;
+        }
+    }
+    num_changes += _visgraph_numitems - old_item_matched.count();
+
+    // returns true if a segment may have been blocked by a removed item
+    auto near_removed_item = [&](const Vector2f &seg_start, const Vector2f &seg_end) {
+        for (uint8_t o = 0; o < _visgraph_numitems; o++) {
+            if (!old_item_matched.get(o) && segment_near_item(seg_start, seg_end, _visgraph_items[o].min_pt, _visgraph_items[o].max_pt)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // returns true if a segment intersects an added item
+    auto intersects_added_item = [&](const Vector2f &seg_start, const Vector2f &seg_end) {
+        for (uint16_t n = 0; n < total_numitems(); n++) {
+            if (new_item_matched.get(n)) {
+                continue;
+            }
+            const FenceItem item = get_fence_item(n);
+            if (!segment_near_item(seg_start, seg_end, item.min_pt, item.max_pt)) {
+                continue;
+            }
+            if (item.is_circle ? intersects_exclusion_circle(item.fence_index, seg_start, seg_end) :
+                                 intersects_exclusion_polygon(item.fence_index, seg_start, seg_end)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // keep edges between unchanged points, except those blocked by added items or near removed items (which are recalculated below)
+    uint16_t num_kept = 0;
+    for (uint16_t i = 0; i < _fence_visgraph.num_items(); i++) {
+        const AP_OAVisGraph::VisGraphItem edge = _fence_visgraph[i];
+        const uint8_t id1 = old_to_new[edge.id1.id_num];
+        const uint8_t id2 = old_to_new[edge.id2.id_num];
+        Vector2f start_seg, end_seg;
+        if ((id1 == OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) || (id2 == OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) ||
+            !get_point(id1, start_seg) || !get_point(id2, end_seg)) {
+            continue;
+        }
+        if (near_removed_item(start_seg, end_seg) || intersects_added_item(start_seg, end_seg)) {
+            continue;
+        }
+        _fence_visgraph.replace_item(num_kept++, {AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, id1},
+                                     {AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, id2},
+                                     edge.distance_cm);
+    }
+    _fence_visgraph.truncate(num_kept);
+
+    // nothing more to do if no items were added or removed
+    if (num_changes == 0) {
+        return true;
+    }
+
+    // calculate edges to points of added items and edges near removed items
+    for (uint8_t i = 0; i < total_numpoints() - 1; i++) {
+        Vector2f start_seg;
+        if (get_point(i, start_seg)) {
+            for (uint8_t j = i + 1; j < total_numpoints(); j++) {
+                Vector2f end_seg;
+                if (get_point(j, end_seg)) {
+                    // edges between unchanged points away from removed items are already correct
+                    if (point_unchanged.get(i) && point_unchanged.get(j) && !near_removed_item(start_seg, end_seg)) {
+                        continue;
+                    }
+                    // if line segment does not intersect with any inclusion or exclusion zones add to visgraph
+                    if (!intersects_fence(start_seg, end_seg)) {
+                        if (!_fence_visgraph.add_item({AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, i},
+                                                      {AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, j},
+                                                      (start_seg - end_seg).length())) {
+                            // failure to add a point can only be caused by out-of-memory
+                            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 // updates visibility graph for a given position which is an offset (in cm) from the ekf origin
 // to add an additional position (i.e. the destination) set add_extra_position = true and provide the position in the extra_position argument
 // requires create_inclusion_polygon_with_margin to have been run
@@ -756,48 +1058,119 @@ bool AP_OADijkstra::update_visgraph(AP_OAVisGraph& visgraph, const AP_OAVisGraph
     return true;
 }
 
+// create the list of fence visgraph items touching each fence point
+// returns true on success, false if out of memory
+bool AP_OADijkstra::create_fence_adjacency()
+{
+    const uint16_t num_points = total_numpoints();
+    const uint16_t num_items = _fence_visgraph.num_items();
+    // each item touches two points, the graph holds at most one item per pair of points so this cannot overflow
+    if (!_fence_adjacency_start.expand_to_hold(num_points + 1) ||
+        !_fence_adjacency.expand_to_hold(2 * num_items)) {
+        return false;
+    }
+
+    // count the items touching each point, then turn the counts into offsets
+    for (uint16_t i = 0; i <= num_points; i++) {
+        _fence_adjacency_start[i] = 0;
+    }
+    for (uint16_t i = 0; i < num_items; i++) {
+        _fence_adjacency_start[_fence_visgraph[i].id1.id_num + 1]++;
+        _fence_adjacency_start[_fence_visgraph[i].id2.id_num + 1]++;
+    }
+    for (uint16_t i = 0; i < num_points; i++) {
+        _fence_adjacency_start[i+1] += _fence_adjacency_start[i];
+    }
+
+    // fill in the items, which moves each offset to the start of the next point, then move them back
+    for (uint16_t i = 0; i < num_items; i++) {
+        _fence_adjacency[_fence_adjacency_start[_fence_visgraph[i].id1.id_num]++] = i;
+        _fence_adjacency[_fence_adjacency_start[_fence_visgraph[i].id2.id_num]++] = i;
+    }
+    for (uint16_t i = num_points; i > 0; i--) {
+        _fence_adjacency_start[i] = _fence_adjacency_start[i-1];
+    }
+    _fence_adjacency_start[0] = 0;
+
+    return true;
+}
+
+// add node to the open set, returns false if out of memory
+bool AP_OADijkstra::open_set_push(node_index node_idx)
+{
+    if (!_open_set.expand_to_hold(_open_set_numitems + 1)) {
+        return false;
+    }
+    const ShortPathNode &node = _short_path_data[node_idx];
+    const OpenSetItem new_item {node.distance_cm + node.heuristic_cm, node_idx};
+
+    // move parents down until the new item's position is found
+    uint16_t i = _open_set_numitems++;
+    while (i > 0) {
+        const uint16_t parent = (i - 1) / 2;
+        if (_open_set[parent].cost_cm <= new_item.cost_cm) {
+            break;
+        }
+        _open_set[i] = _open_set[parent];
+        i = parent;
+    }
+    _open_set[i] = new_item;
+    return true;
+}
+
+// update a node's distance if going via from_idx is shorter and add it to the open set
+// returns false if out of memory
+bool AP_OADijkstra::update_node_distance(node_index node_idx, node_index from_idx, float distance_cm)
+{
+    ShortPathNode &node = _short_path_data[node_idx];
+    if (node.visited || (distance_cm >= node.distance_cm)) {
+        return true;
+    }
+    // update item's distance and set "distance_from_idx" to current node's index
+    node.distance_cm = distance_cm;
+    node.distance_from_idx = from_idx;
+    return open_set_push(node_idx);
+}
+
 // update total distance for all nodes visible from current node
 // curr_node_idx is an index into the _short_path_data array
-void AP_OADijkstra::update_visible_node_distances(node_index curr_node_idx)
+// returns false if out of memory
+bool AP_OADijkstra::update_visible_node_distances(node_index curr_node_idx)
 {
     // sanity check
     if (curr_node_idx >= _short_path_data_numpoints) {
-        return;
+        return true;
     }
 
     // get current node for convenience
     const ShortPathNode &curr_node = _short_path_data[curr_node_idx];
 
-    // for each visibility graph
-    const AP_OAVisGraph* visgraphs[] = {&_fence_visgraph, &_destination_visgraph};
-    for (uint8_t v=0; v<ARRAY_SIZE(visgraphs); v++) {
-
-        // skip if empty
-        const AP_OAVisGraph &curr_visgraph = *visgraphs[v];
-        if (curr_visgraph.num_items() == 0) {
-            continue;
+    // update destination if visible from current node
+    if (curr_node.destination_cm < FLT_MAX) {
+        node_index dest_node_idx;
+        if (find_node_from_id({AP_OAVisGraph::OATYPE_DESTINATION, 0}, dest_node_idx) &&
+            !update_node_distance(dest_node_idx, curr_node_idx, curr_node.distance_cm + curr_node.destination_cm)) {
+            return false;
         }
+    }
 
-        // search visibility graph for items visible from current_node
-        for (uint16_t i = 0; i < curr_visgraph.num_items(); i++) {
-            const AP_OAVisGraph::VisGraphItem &item = curr_visgraph[i];
-            // match if current node's id matches either of the id's in the graph (i.e. either end of the vector)
-            if ((curr_node.id == item.id1) || (curr_node.id == item.id2)) {
-                AP_OAVisGraph::OAItemID matching_id = (curr_node.id == item.id1) ? item.id2 : item.id1;
-                // find item's id in node array
-                node_index item_node_idx;
-                if (find_node_from_id(matching_id, item_node_idx)) {
-                    // if current node's distance + distance to item is less than item's current distance, update item's distance
-                    const float dist_to_item_via_current_node = _short_path_data[curr_node_idx].distance_cm + item.distance_cm;
-                    if (dist_to_item_via_current_node < _short_path_data[item_node_idx].distance_cm) {
-                        // update item's distance and set "distance_from_idx" to current node's index
-                        _short_path_data[item_node_idx].distance_cm = dist_to_item_via_current_node;
-                        _short_path_data[item_node_idx].distance_from_idx = curr_node_idx;
-                    }
-                }
-            }
+    // only fence points are held in the fence visgraph
+    if (curr_node.id.id_type != AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT) {
+        return true;
+    }
+
+    // search fence visibility graph for items visible from current_node
+    for (uint16_t i = _fence_adjacency_start[curr_node.id.id_num]; i < _fence_adjacency_start[curr_node.id.id_num + 1]; i++) {
+        const AP_OAVisGraph::VisGraphItem &item = _fence_visgraph[_fence_adjacency[i]];
+        const AP_OAVisGraph::OAItemID &matching_id = (curr_node.id == item.id1) ? item.id2 : item.id1;
+        // find item's id in node array
+        node_index item_node_idx;
+        if (find_node_from_id(matching_id, item_node_idx) &&
+            !update_node_distance(item_node_idx, curr_node_idx, curr_node.distance_cm + item.distance_cm)) {
+            return false;
         }
     }
+    return true;
 }
 
 // find a node's index into _short_path_data array from it's id (i.e. id type and id number)
@@ -832,43 +1205,41 @@ bool AP_OADijkstra::find_node_from_id(const AP_OAVisGraph::OAItemID &id, node_in
     return false;
 }
 
-// find index of node with lowest tentative distance (ignore visited nodes)
+// remove the unvisited node with lowest distance plus heuristic from the open set
+// heuristic is simple Euclidean distance from the node to the destination
+// This should be admissible, therefore optimal path is guaranteed
 // returns true if successful and node_idx argument is updated
-bool AP_OADijkstra::find_closest_node_idx(node_index &node_idx) const
+bool AP_OADijkstra::find_closest_node_idx(node_index &node_idx)
 {
-    node_index lowest_idx = 0;
-    float lowest_dist = FLT_MAX;
-
-    // scan through all nodes looking for closest
-    for (node_index i=0; i<_short_path_data_numpoints; i++) {
-        const ShortPathNode &node = _short_path_data[i];
-        if (node.visited || is_equal(_short_path_data[i].distance_cm, FLT_MAX)) {
-            // if node is already visited OR cannot be reached yet, we can't use it
-            continue;
-        }
-        // figure out the pos of this node
-        Vector2f node_pos;
-        float dist_with_heuristics = FLT_MAX;
-        if (convert_node_to_point(node.id, node_pos)) {
-            // heuristics is is simple Euclidean distance from the node to the destination
-            // This should be admissible, therefore optimal path is guaranteed
-            const float heuristics = (node_pos-_path_destination).length();
-            dist_with_heuristics = node.distance_cm + heuristics;
-        } else {
-            // shouldn't happen
-            return false;
+    while (_open_set_numitems > 0) {
+        const node_index lowest_idx = _open_set[0].node_idx;
+
+        // move the last item down from the top until its position is found
+        const OpenSetItem last_item = _open_set[--_open_set_numitems];
+        uint16_t i = 0;
+        while (true) {
+            uint16_t child = 2 * i + 1;
+            if (child >= _open_set_numitems) {
+                break;
+            }
+            if ((child + 1 < _open_set_numitems) && (_open_set[child + 1].cost_cm < _open_set[child].cost_cm)) {
+                child++;
+            }
+            if (last_item.cost_cm <= _open_set[child].cost_cm) {
+                break;
+            }
+            _open_set[i] = _open_set[child];
+            i = child;
         }
-        if (dist_with_heuristics < lowest_dist) {
-            // for NOW, this is the closest node
-            lowest_idx = i;
-            lowest_dist = dist_with_heuristics;
+        if (_open_set_numitems > 0) {
+            _open_set[i] = last_item;
         }
-    }
 
-    if (lowest_dist < FLT_MAX) {
-        // found the closest node
-        node_idx = lowest_idx;
-        return true;
+        // skip nodes visited since they were added, these were added again with a shorter distance
+        if (!_short_path_data[lowest_idx].visited) {
+            node_idx = lowest_idx;
+            return true;
+        }
     }
     return false;
 }
@@ -880,6 +1251,7 @@ bool AP_OADijkstra::find_closest_node_idx(node_index &node_idx) const
 bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &destination, AP_OADijkstra_Error &err_id)
 {
     // convert origin and destination to offsets from EKF origin
+    const Vector2f path_destination_prev = _path_destination;
     if (!origin.get_vector_xy_from_origin_NE_cm(_path_source) ||
         !destination.get_vector_xy_from_origin_NE_cm(_path_destination)) {
         err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_NO_POSITION_ESTIMATE;
@@ -891,9 +1263,22 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
         err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
         return false;
     }
-    if (!update_visgraph(_destination_visgraph, {AP_OAVisGraph::OATYPE_DESTINATION, 0}, _path_destination)) {
-        err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
-        return false;
+    // destination's visgraph only changes with the destination or fence
+    if (!_destination_visgraph_ok || (_path_destination != path_destination_prev)) {
+        _destination_visgraph_ok = update_visgraph(_destination_visgraph, {AP_OAVisGraph::OATYPE_DESTINATION, 0}, _path_destination);
+        if (!_destination_visgraph_ok) {
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+            return false;
+        }
+    }
+
+    // create list of fence visgraph items for each fence point if necessary
+    if (!_fence_adjacency_ok) {
+        _fence_adjacency_ok = create_fence_adjacency();
+        if (!_fence_adjacency_ok) {
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+            return false;
+        }
     }
 
     // expand _short_path_data if necessary
@@ -902,32 +1287,49 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
         return false;
     }
 
-    // add origin and destination (node_type, id, visited, distance_from_idx, distance_cm) to short_path_data array
-    _short_path_data[0] = {{AP_OAVisGraph::OATYPE_SOURCE, 0}, false, 0, 0};
-    _short_path_data[1] = {{AP_OAVisGraph::OATYPE_DESTINATION, 0}, false, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, FLT_MAX};
+    // add origin and destination (node_type, id, visited, distance_from_idx, distance_cm, heuristic_cm, destination_cm) to short_path_data array
+    _short_path_data[0] = {{AP_OAVisGraph::OATYPE_SOURCE, 0}, false, 0, 0, (_path_destination - _path_source).length(), FLT_MAX};
+    _short_path_data[1] = {{AP_OAVisGraph::OATYPE_DESTINATION, 0}, false, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, FLT_MAX, 0, FLT_MAX};
     _short_path_data_numpoints = 2;
 
-    // add all inclusion and exclusion fence points to short_path_data array (node_type, id, visited, distance_from_idx, distance_cm)
+    // add all inclusion and exclusion fence points to short_path_data array
     for (uint8_t i=0; i<total_numpoints(); i++) {
-        _short_path_data[_short_path_data_numpoints++] = {{AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, i}, false, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, FLT_MAX};
+        Vector2f point;
+        if (!get_point(i, point)) {
+            // shouldn't happen
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_COULD_NOT_FIND_PATH;
+            return false;
+        }
+        _short_path_data[_short_path_data_numpoints++] = {{AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, i}, false, OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX, FLT_MAX, (_path_destination - point).length(), FLT_MAX};
+    }
+
+    // record distance to destination for fence points visible from destination
+    for (uint16_t i = 0; i < _destination_visgraph.num_items(); i++) {
+        node_index node_idx;
+        if (find_node_from_id(_destination_visgraph[i].id2, node_idx)) {
+            _short_path_data[node_idx].destination_cm = _destination_visgraph[i].distance_cm;
+        }
     }
 
     // start algorithm from source point
     node_index current_node_idx = 0;
+    _open_set_numitems = 0;
+
+    // mark source node as visited
+    _short_path_data[current_node_idx].visited = true;
 
     // update nodes visible from source point
     for (uint16_t i = 0; i < _source_visgraph.num_items(); i++) {
         node_index node_idx;
-        if (find_node_from_id(_source_visgraph[i].id2, node_idx)) {
-            _short_path_data[node_idx].distance_cm = _source_visgraph[i].distance_cm;
-            _short_path_data[node_idx].distance_from_idx = current_node_idx;
-        } else {
+        if (!find_node_from_id(_source_visgraph[i].id2, node_idx)) {
             err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_COULD_NOT_FIND_PATH;
             return false;
         }
+        if (!update_node_distance(node_idx, current_node_idx, _source_visgraph[i].distance_cm)) {
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+            return false;
+        }
     }
-    // mark source node as visited
-    _short_path_data[current_node_idx].visited = true;
 
     // move current_node_idx to node with lowest distance
     while (find_closest_node_idx(current_node_idx)) {
@@ -937,11 +1339,14 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
             // We have discovered destination.. Don't bother with the rest of the graph
             break;
         }
-        // update distances to all neighbours of current node
-        update_visible_node_distances(current_node_idx);
-
         // mark current node as visited
         _short_path_data[current_node_idx].visited = true;
+
+        // update distances to all neighbours of current node
+        if (!update_visible_node_distances(current_node_idx)) {
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+            return false;
+        }
     }
 
     // extract path starting from destination
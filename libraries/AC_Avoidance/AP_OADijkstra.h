@@ -119,10 +119,41 @@ private:
     // returns true if line segment intersects polygon or circular fence
     bool intersects_fence(const Vector2f &seg_start, const Vector2f &seg_end) const;
 
+    // returns true if line segment intersects a single exclusion polygon or circle
+    bool intersects_exclusion_polygon(uint8_t index, const Vector2f &seg_start, const Vector2f &seg_end) const;
+    bool intersects_exclusion_circle(uint8_t index, const Vector2f &seg_start, const Vector2f &seg_end) const;
+
     // create visibility graph for all fence (with margin) points
     // returns true on success.  returns false on failure and err_id is updated
     bool create_fence_visgraph(AP_OADijkstra_Error &err_id);
 
+    // update visibility graph after the fence has changed, only recalculating the edges affected by changed exclusion zones if possible
+    // returns true on success.  returns false on failure and err_id is updated
+    bool update_fence_visgraph(AP_OADijkstra_Error &err_id);
+
+    // update visibility graph for exclusion zones added or removed since it was created
+    // returns true on success.  returns false on failure and err_id is updated
+    bool update_fence_visgraph_for_changes(AP_OADijkstra_Error &err_id);
+
+    // exclusion polygon or circle and the points created around it
+    // used to find which parts of the fence have changed when updating the visibility graph
+    struct FenceItem {
+        uint64_t hash;          // hash of the item's shape and the margin used to create its points
+        Vector2f min_pt;        // lower corner of the item's bounding box (offset in cm from EKF origin)
+        Vector2f max_pt;        // upper corner of the item's bounding box (offset in cm from EKF origin)
+        uint8_t first_point;    // index of the item's first point (within its fence type's points)
+        uint8_t num_points;     // number of points created around the item
+        uint8_t fence_index;    // index of the polygon or circle within the fence
+        bool is_circle;         // true if item is an exclusion circle
+    };
+
+    // return number of exclusion polygons and circles
+    uint16_t total_numitems() const { return _exclusion_polygon_numitems + _exclusion_circle_numitems; }
+
+    // get a single exclusion polygon or circle with first_point converted to an index into the total list of points
+    // polygons are returned first followed by circles
+    FenceItem get_fence_item(uint16_t index) const;
+
     // calculate shortest path from origin to destination
     // returns true on success.  returns false on failure and err_id is updated
     // requires create_polygon_fence_with_margin and create_polygon_fence_visgraph to have been run
@@ -146,21 +177,33 @@ private:
     AP_ExpandingArray<Vector2f> _inclusion_polygon_pts; // array of nodes corresponding to inclusion polygon points plus a margin
     uint8_t _inclusion_polygon_numpoints;   // number of points held in above array
     uint32_t _inclusion_polygon_update_ms;  // system time of boundary update from AC_Fence (used to detect changes to polygon fence)
+    uint64_t _inclusion_hash;               // hash of inclusion polygons, inclusion circles and margin used to create above points
 
     // exclusion polygon related variables
     AP_ExpandingArray<Vector2f> _exclusion_polygon_pts; // array of nodes corresponding to exclusion polygon points plus a margin
     uint8_t _exclusion_polygon_numpoints;   // number of points held in above array
     uint32_t _exclusion_polygon_update_ms;  // system time exclusion polygon was updated (used to detect changes)
+    AP_ExpandingArray<FenceItem> _exclusion_polygon_items;  // exclusion polygons the above points were created around
+    uint8_t _exclusion_polygon_numitems;    // number of items held in above array
 
     // exclusion circle related variables
     AP_ExpandingArray<Vector2f> _exclusion_circle_pts; // array of nodes surrounding exclusion circles plus a margin
     uint8_t _exclusion_circle_numpoints;    // number of points held in above array
     uint32_t _exclusion_circle_update_ms;   // system time exclusion circles were updated (used to detect changes)
+    AP_ExpandingArray<FenceItem> _exclusion_circle_items;   // exclusion circles the above points were created around
+    uint8_t _exclusion_circle_numitems;     // number of items held in above array
 
     // visibility graphs
     AP_OAVisGraph _fence_visgraph;          // holds distances between all inclusion/exclusion fence points (with margin)
     AP_OAVisGraph _source_visgraph;         // holds distances from source point to all other nodes
     AP_OAVisGraph _destination_visgraph;    // holds distances from the destination to all other nodes
+    bool _destination_visgraph_ok;          // true if _destination_visgraph is valid for _path_destination and the current fence
+
+    // fence the _fence_visgraph was created from, used to update it incrementally
+    AP_ExpandingArray<FenceItem> _visgraph_items;   // exclusion polygons and circles with first_point as an index into the total list of points
+    uint8_t _visgraph_numitems;             // number of items held in above array
+    uint64_t _visgraph_inclusion_hash;      // _inclusion_hash when visgraph was created
+    bool _visgraph_items_ok;                // true if above variables describe the fence used to create _fence_visgraph
 
     // updates visibility graph for a given position which is an offset (in cm) from the ekf origin
     // to add an additional position (i.e. the destination) set add_extra_position = true and provide the position in the extra_position argument
@@ -174,21 +217,49 @@ private:
         bool visited;                   // true if all this node's neighbour's distances have been updated
         node_index distance_from_idx;   // index into _short_path_data from where distance was updated (or 255 if not set)
         float distance_cm;              // distance from source (number is tentative until this node is the current node and/or visited = true)
+        float heuristic_cm;             // straight line distance to destination, used to decide which node to visit next
+        float destination_cm;           // distance to destination if visible from this node, FLT_MAX if not
     };
     AP_ExpandingArray<ShortPathNode> _short_path_data;
     node_index _short_path_data_numpoints;  // number of elements in _short_path_data array
 
+    // fence visgraph items touching each fence point, so visiting a node only checks its own edges
+    // items for point i are _fence_adjacency[_fence_adjacency_start[i]] up to _fence_adjacency[_fence_adjacency_start[i+1]]
+    AP_ExpandingArray<uint16_t> _fence_adjacency;       // indices into _fence_visgraph
+    AP_ExpandingArray<uint16_t> _fence_adjacency_start; // index of each point's first item in above array
+    bool _fence_adjacency_ok;                           // true if above arrays are valid for _fence_visgraph
+
+    // create the above arrays from _fence_visgraph, returns true on success
+    bool create_fence_adjacency();
+
+    // nodes whose distance has been updated but that have not been visited yet, as a binary heap ordered by distance plus heuristic
+    // nodes are added again when their distance improves, the stale entry is skipped when it is removed
+    struct OpenSetItem {
+        float cost_cm;                  // node's distance from source plus heuristic when it was added
+        node_index node_idx;            // index into _short_path_data
+    };
+    AP_ExpandingArray<OpenSetItem> _open_set;
+    uint16_t _open_set_numitems;        // number of elements in _open_set array
+
+    // add node to the open set, returns false if out of memory
+    bool open_set_push(node_index node_idx);
+
+    // update a node's distance if going via from_idx is shorter and add it to the open set
+    // returns false if out of memory
+    bool update_node_distance(node_index node_idx, node_index from_idx, float distance_cm);
+
     // update total distance for all nodes visible from current node
     // curr_node_idx is an index into the _short_path_data array
-    void update_visible_node_distances(node_index curr_node_idx);
+    // returns false if out of memory
+    bool update_visible_node_distances(node_index curr_node_idx);
 
     // find a node's index into _short_path_data array from it's id (i.e. id type and id number)
     // returns true if successful and node_idx is updated
     bool find_node_from_id(const AP_OAVisGraph::OAItemID &id, node_index &node_idx) const;
 
-    // find index of node with lowest tentative distance (ignore visited nodes)
+    // remove the unvisited node with lowest distance plus heuristic from the open set
     // returns true if successful and node_idx argument is updated
-    bool find_closest_node_idx(node_index &node_idx) const;
+    bool find_closest_node_idx(node_index &node_idx);
 
     // final path variables and functions
     AP_ExpandingArray<AP_OAVisGraph::OAItemID> _path;   // ids of points on return path in reverse order (i.e. destination is first element)
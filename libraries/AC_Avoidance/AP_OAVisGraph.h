@@ -49,6 +49,12 @@ public:
     // add item to visiblity graph, returns true on success, false if graph is full
     bool add_item(const OAItemID &id1, const OAItemID &id2, float distance_cm);
 
+    // replace an existing item, used with truncate() to filter the graph in place
+    void replace_item(uint16_t i, const OAItemID &id1, const OAItemID &id2, float distance_cm) { _items[i] = {id1, id2, distance_cm}; }
+
+    // remove all items from index num_items onwards
+    void truncate(uint16_t num_items) { if (num_items < _num_items) { _num_items = num_items; } }
+
     // allow accessing graph as an array, 0 indexed
     // Note: no protection against out-of-bounds accesses so use with num_items()
     const VisGraphItem& operator[](uint16_t i) const { return _items[i]; }
@@ -19,3 +19,9 @@
 #ifndef AC_POLYFENCE_FENCE_POINT_PROTOCOL_SUPPORT
 #define AC_POLYFENCE_FENCE_POINT_PROTOCOL_SUPPORT 0
 #endif
+
+// index polygon fence edges so breach and path checks only look at
+// the edges near the vehicle
+#ifndef AC_POLYFENCE_EDGE_INDEX_ENABLED
+#define AC_POLYFENCE_EDGE_INDEX_ENABLED (AP_FENCE_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_300)
+#endif
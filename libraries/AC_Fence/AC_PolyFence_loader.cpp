@@ -233,7 +233,7 @@ bool AC_PolyFence_loader::breached(const Location& loc, float& distance_outside_
 
     Vector2f scaled_pos;
     Vector2l pos { loc.lat, loc.lng };
-    if (!scale_latlon_from_origin(loaded_origin, pos, scaled_pos)) {
+    if (!scale_latlon_from_origin(pos, scaled_pos)) {
         return false;
     }
 
@@ -245,9 +245,22 @@ bool AC_PolyFence_loader::breached(const Location& loc, float& distance_outside_
     for (uint8_t i=0; i<_num_loaded_inclusion_boundaries; i++) {
         const InclusionBoundary &boundary = _loaded_inclusion_boundary[i];
         float distance;
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+        bool valid_distance;
+        bool outside;
+        if (boundary.index.valid()) {
+            valid_distance = boundary.index.closest_distance(boundary.points, scaled_pos, distance);
+            outside = boundary.index.outside(scaled_pos, pos, boundary.points_lla);
+        } else {
+            valid_distance = Polygon_closest_distance_point(boundary.points, boundary.count, scaled_pos, distance);
+            outside = Polygon_outside(pos, boundary.points_lla, boundary.count);
+        }
+#else
         bool valid_distance = Polygon_closest_distance_point(boundary.points, boundary.count, scaled_pos, distance);
+        const bool outside = Polygon_outside(pos, boundary.points_lla, boundary.count);
+#endif
         distance *= 0.01f; // convert back to meters
-        if (Polygon_outside(pos, boundary.points_lla, boundary.count)) {
+        if (outside) {
             num_inclusion_outside++;
             if (valid_distance) {
                 if (is_positive(distance_outside_fence)) {
@@ -265,9 +278,22 @@ bool AC_PolyFence_loader::breached(const Location& loc, float& distance_outside_
     for (uint8_t i=0; i<_num_loaded_exclusion_boundaries; i++) {
         const ExclusionBoundary &boundary = _loaded_exclusion_boundary[i];
         float distance;
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+        bool valid_distance;
+        bool outside;
+        if (boundary.index.valid()) {
+            valid_distance = boundary.index.closest_distance(boundary.points, scaled_pos, distance);
+            outside = boundary.index.outside(scaled_pos, pos, boundary.points_lla);
+        } else {
+            valid_distance = Polygon_closest_distance_point(boundary.points, boundary.count, scaled_pos, distance);
+            outside = Polygon_outside(pos, boundary.points_lla, boundary.count);
+        }
+#else
         bool valid_distance = Polygon_closest_distance_point(boundary.points, boundary.count, scaled_pos, distance);
+        const bool outside = Polygon_outside(pos, boundary.points_lla, boundary.count);
+#endif
         distance *= 0.01f; // convert back to meters
-        if (!Polygon_outside(pos, boundary.points_lla, boundary.count)) {
+        if (!outside) {
             if (valid_distance) {
                 distance_outside_fence = distance;
             } else {
@@ -353,16 +379,16 @@ bool AC_PolyFence_loader::format()
     return write_eos_to_storage(offset);
 }
 
-bool AC_PolyFence_loader::scale_latlon_from_origin(const Location &origin, const Vector2l &point, Vector2f &pos_cm) const
+bool AC_PolyFence_loader::scale_latlon_from_origin(const Vector2l &point, Vector2f &pos_cm) const
 {
     Location tmp_loc;
     tmp_loc.lat = point.x;
     tmp_loc.lng = point.y;
-    pos_cm = origin.get_distance_NE(tmp_loc) * 100.0f;
+    pos_cm = loaded_frame.get_distance_NE(tmp_loc) * 100.0f;
     return true;
 }
 
-bool AC_PolyFence_loader::read_polygon_from_storage(const Location &origin, uint16_t &read_offset, const uint8_t vertex_count, Vector2f *&next_storage_point, Vector2l *&next_storage_point_lla)
+bool AC_PolyFence_loader::read_polygon_from_storage(uint16_t &read_offset, const uint8_t vertex_count, Vector2f *&next_storage_point, Vector2l *&next_storage_point_lla)
 {
     for (uint8_t i=0; i<vertex_count; i++) {
         // read from storage to lat/lon
@@ -370,7 +396,7 @@ bool AC_PolyFence_loader::read_polygon_from_storage(const Location &origin, uint
             return false;
         }
         // convert lat/lon to position in cm from origin
-        if (!scale_latlon_from_origin(origin, *next_storage_point_lla, *next_storage_point)) {
+        if (!scale_latlon_from_origin(*next_storage_point_lla, *next_storage_point)) {
             return false;
         }
         
@@ -649,6 +675,7 @@ bool AC_PolyFence_loader::load_from_storage()
 //        Debug("fence load requires origin");
         return false;
     }
+    loaded_frame.set_origin(loaded_origin);
 
     // find indexes of each fence:
     if (!get_loaded_fence_semaphore().take_nonblocking()) {
@@ -761,11 +788,17 @@ bool AC_PolyFence_loader::load_from_storage()
                 break;
             }
             storage_offset += 1; // skip vertex count
-            if (!read_polygon_from_storage(loaded_origin, storage_offset, index.count, next_storage_point, next_storage_point_lla)) {
+            if (!read_polygon_from_storage(storage_offset, index.count, next_storage_point, next_storage_point_lla)) {
                 GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "AC_Fence: polygon read failed");
                 storage_valid = false;
                 break;
             }
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+            // the lat/lon points are checked against an index of the
+            // offsets, so allow 1m for the difference between them.
+            // If the index can't be built the polygon is checked in full
+            boundary.index.build(boundary.points, boundary.count, 100);
+#endif
             _num_loaded_inclusion_boundaries++;
             break;
         }
@@ -780,11 +813,17 @@ bool AC_PolyFence_loader::load_from_storage()
                 break;
             }
             storage_offset += 1; // skip vertex count
-            if (!read_polygon_from_storage(loaded_origin, storage_offset, index.count, next_storage_point, next_storage_point_lla)) {
+            if (!read_polygon_from_storage(storage_offset, index.count, next_storage_point, next_storage_point_lla)) {
                 GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "AC_Fence: polygon read failed");
                 storage_valid = false;
                 break;
             }
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+            // the lat/lon points are checked against an index of the
+            // offsets, so allow 1m for the difference between them.
+            // If the index can't be built the polygon is checked in full
+            boundary.index.build(boundary.points, boundary.count, 100);
+#endif
             _num_loaded_exclusion_boundaries++;
             break;
         }
@@ -796,7 +835,7 @@ bool AC_PolyFence_loader::load_from_storage()
                 storage_valid = false;
                 break;
             }
-            if (!scale_latlon_from_origin(loaded_origin, circle.point, circle.pos_cm)) {
+            if (!scale_latlon_from_origin(circle.point, circle.pos_cm)) {
                 GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "AC_Fence: latlon read failed");
                 storage_valid = false;
                 break;
@@ -823,7 +862,7 @@ bool AC_PolyFence_loader::load_from_storage()
                 storage_valid = false;
                 break;
             }
-            if (!scale_latlon_from_origin(loaded_origin, circle.point, circle.pos_cm)){
+            if (!scale_latlon_from_origin(circle.point, circle.pos_cm)){
                 GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "AC_Fence: latlon read failed");
                 storage_valid = false;
                 break;
@@ -861,7 +900,7 @@ bool AC_PolyFence_loader::load_from_storage()
                 GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "PolyFence: latlon read failed");
                 break;
             }
-            if (!scale_latlon_from_origin(loaded_origin, *next_storage_point_lla, *next_storage_point)) {
+            if (!scale_latlon_from_origin(*next_storage_point_lla, *next_storage_point)) {
                 storage_valid = false;
                 GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "PolyFence: latlon read failed");
                 break;
@@ -912,6 +951,28 @@ Vector2f* AC_PolyFence_loader::get_inclusion_polygon(uint16_t index, uint16_t &n
     return boundary.points;
 }
 
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+/// returns the edge index of the exclusion polygon, or nullptr if it has not been indexed
+const AP_PolygonIndex *AC_PolyFence_loader::get_exclusion_polygon_index(uint16_t index) const
+{
+    if (index >= _num_loaded_exclusion_boundaries) {
+        return nullptr;
+    }
+    const AP_PolygonIndex &polygon_index = _loaded_exclusion_boundary[index].index;
+    return polygon_index.valid() ? &polygon_index : nullptr;
+}
+
+/// returns the edge index of the inclusion polygon, or nullptr if it has not been indexed
+const AP_PolygonIndex *AC_PolyFence_loader::get_inclusion_polygon_index(uint16_t index) const
+{
+    if (index >= _num_loaded_inclusion_boundaries) {
+        return nullptr;
+    }
+    const AP_PolygonIndex &polygon_index = _loaded_inclusion_boundary[index].index;
+    return polygon_index.valid() ? &polygon_index : nullptr;
+}
+#endif
+
 /// returns the specified exclusion circle
 /// circle center offsets in cm from EKF origin in NE frame, radius is in meters
 bool AC_PolyFence_loader::get_exclusion_circle(uint8_t index, Vector2f &center_pos_cm, float &radius) const
@@ -1662,6 +1723,10 @@ bool AC_PolyFence_loader::get_item(const uint16_t seq, AC_PolyFenceItem &item) {
 
 Vector2f* AC_PolyFence_loader::get_exclusion_polygon(uint16_t index, uint16_t &num_points) const { return nullptr; }
 Vector2f* AC_PolyFence_loader::get_inclusion_polygon(uint16_t index, uint16_t &num_points) const { return nullptr; }
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+const AP_PolygonIndex *AC_PolyFence_loader::get_exclusion_polygon_index(uint16_t index) const { return nullptr; }
+const AP_PolygonIndex *AC_PolyFence_loader::get_inclusion_polygon_index(uint16_t index) const { return nullptr; }
+#endif
 
 bool AC_PolyFence_loader::get_exclusion_circle(uint8_t index, Vector2f &center_pos_cm, float &radius) const { return false; }
 bool AC_PolyFence_loader::get_inclusion_circle(uint8_t index, Vector2f &center_pos_cm, float &radius) const { return false; }
@@ -2,6 +2,7 @@
 
 #include "AC_Fence_config.h"
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/polygon_index.h>
 
 // CIRCLE_INCLUSION_INT stores the radius an a 32-bit integer in
 // metres.  This was a bug, and CIRCLE_INCLUSION was created to store
@@ -79,6 +80,12 @@ public:
     /// points are offsets in cm from EKF origin in NE frame
     Vector2f* get_exclusion_polygon(uint16_t index, uint16_t &num_points) const;
 
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+    /// returns the edge index of the exclusion polygon, or nullptr if it
+    /// has not been indexed
+    const AP_PolygonIndex *get_exclusion_polygon_index(uint16_t index) const;
+#endif
+
     /// return system time of last update to the exclusion polygon points
     uint32_t get_exclusion_polygon_update_ms() const {
         return _load_time_ms;
@@ -96,6 +103,12 @@ public:
     /// points are offsets in cm from EKF origin in NE frame
     Vector2f* get_inclusion_polygon(uint16_t index, uint16_t &num_points) const;
 
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+    /// returns the edge index of the inclusion polygon, or nullptr if it
+    /// has not been indexed
+    const AP_PolygonIndex *get_inclusion_polygon_index(uint16_t index) const;
+#endif
+
     /// return system time of last update to the inclusion polygon points
     uint32_t get_inclusion_polygon_update_ms() const {
         return _load_time_ms;
@@ -302,6 +315,9 @@ private:
         Vector2f *points; // pointer into the _loaded_offsets_from_origin array
         Vector2l *points_lla; // pointer into the _loaded_points_lla array
         uint8_t count; // count of points in the boundary
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+        AP_PolygonIndex index; // edge index of points
+#endif
     };
     InclusionBoundary *_loaded_inclusion_boundary;
 
@@ -312,6 +328,9 @@ private:
         Vector2f *points; // pointer into the _loaded_offsets_from_origin array
         Vector2l *points_lla; // pointer into the _loaded_points_lla_lla array
         uint8_t count; // count of points in the boundary
+#if AC_POLYFENCE_EDGE_INDEX_ENABLED
+        AP_PolygonIndex index; // edge index of points
+#endif
     };
     ExclusionBoundary *_loaded_exclusion_boundary;
 
@@ -324,6 +343,7 @@ private:
     Vector2f *_loaded_offsets_from_origin;
     Vector2l *_loaded_points_lla;
     Location loaded_origin; // origin at the time the boundary was loaded
+    LocalFrame loaded_frame; // loaded_origin with its longitude scale cached
 
     class ExclusionCircle {
     public:
@@ -355,18 +375,16 @@ private:
     uint32_t _load_time_ms;
 
     // scale_latlon_from_origin - given a latitude/longitude
-    // transforms the point to an offset-from-origin and deposits
-    // the result into pos_cm.
-    bool scale_latlon_from_origin(const Location &origin,
-                                  const Vector2l &point,
+    // transforms the point to an offset-from-loaded_origin and
+    // deposits the result into pos_cm.
+    bool scale_latlon_from_origin(const Vector2l &point,
                                   Vector2f &pos_cm) const WARN_IF_UNUSED;
    
     // read_polygon_from_storage - reads vertex_count
     // latitude/longitude points from offset in permanent storage,
-    // transforms them into an offset-from-origin and deposits the
-    // results into next_storage_point.
-    bool read_polygon_from_storage(const Location &origin,
-                                   uint16_t &read_offset,
+    // transforms them into an offset-from-loaded_origin and deposits
+    // the results into next_storage_point.
+    bool read_polygon_from_storage(uint16_t &read_offset,
                                    const uint8_t vertex_count,
                                    Vector2f *&next_storage_point,
                                    Vector2l *&next_storage_point_lla) WARN_IF_UNUSED;
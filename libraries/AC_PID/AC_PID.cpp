@@ -225,6 +225,8 @@ float AC_PID::update_all(float target, float measurement, float dt, bool limit,
 
     } else {
 
+        update_filt_alphas(dt);
+
         // Apply target filters
         const float target_last = _target;
 #if AP_FILTER_ENABLED
@@ -233,7 +235,7 @@ float AC_PID::update_all(float target, float measurement, float dt, bool limit,
             target = _target_notch->apply(target);
         }
 #endif
-        _target += get_filt_T_alpha(dt) * (target - _target);
+        _target += _filt_alpha.T * (target - _target);
 
         // Calculate error and apply error filter
         const float error_last = _error;
@@ -243,12 +245,12 @@ float AC_PID::update_all(float target, float measurement, float dt, bool limit,
             error = _error_notch->apply(error);
         }
 #endif
-        _error += get_filt_E_alpha(dt) * (error - _error);
+        _error += _filt_alpha.E * (error - _error);
 
         // calculate and filter derivative
         if (is_positive(dt)) {
             float derivative = (_error - error_last) / dt;
-            _derivative += get_filt_D_alpha(dt) * (derivative - _derivative);
+            _derivative += _filt_alpha.D * (derivative - _derivative);
             _target_derivative = (_target - target_last) / dt;
         }
     }
@@ -408,6 +410,24 @@ float AC_PID::get_filt_D_alpha(float dt) const
     return calc_lowpass_alpha_dt(dt, _filt_D_hz);
 }
 
+// update_filt_alphas - recalculate the filter alphas if dt or a filter frequency has changed
+void AC_PID::update_filt_alphas(float dt)
+{
+    if (is_equal(dt, _filt_alpha.dt) &&
+        is_equal(_filt_T_hz.get(), _filt_alpha.T_hz) &&
+        is_equal(_filt_E_hz.get(), _filt_alpha.E_hz) &&
+        is_equal(_filt_D_hz.get(), _filt_alpha.D_hz)) {
+        return;
+    }
+    _filt_alpha.dt = dt;
+    _filt_alpha.T_hz = _filt_T_hz;
+    _filt_alpha.E_hz = _filt_E_hz;
+    _filt_alpha.D_hz = _filt_D_hz;
+    _filt_alpha.T = get_filt_T_alpha(dt);
+    _filt_alpha.E = get_filt_E_alpha(dt);
+    _filt_alpha.D = get_filt_D_alpha(dt);
+}
+
 void AC_PID::set_integrator(float integrator)
 {
     _flags._I_set = true;
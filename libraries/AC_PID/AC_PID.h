@@ -153,6 +153,9 @@ protected:
     //  if the limit flag is set the integral is only allowed to shrink
     void update_i(float dt, bool limit);
 
+    // update the cached target, error and derivative filter alphas
+    void update_filt_alphas(float dt);
+
     // parameters
     AP_Float _kp;
     AP_Float _ki;
@@ -198,6 +201,19 @@ protected:
 
     AP_PIDInfo _pid_info;
 
+    // filter alphas and the dt and filter frequencies they were
+    // calculated for. The rate loops run with a constant dt so these
+    // are only recalculated when dt or a filter frequency changes
+    struct {
+        float dt = -1.0f;
+        float T_hz;
+        float E_hz;
+        float D_hz;
+        float T = 1.0f;
+        float E = 1.0f;
+        float D = 1.0f;
+    } _filt_alpha;
+
 private:
     const float default_kp;
     const float default_ki;
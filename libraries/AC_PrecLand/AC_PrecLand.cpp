@@ -511,8 +511,8 @@ void AC_PrecLand::run_estimator(float rangefinder_alt_m, bool rangefinder_alt_va
                 _target_vel_rel_est_NE.y = -_inertial_data_delayed->inertialNavVelocity.y;
             }
 
-            // Update if a new Line-Of-Sight measurement is available
-            if (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
+            // Update with each new Line-Of-Sight measurement since the last update
+            while (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
                 if (!_estimator_initialized) {
                     GCS_SEND_TEXT(MAV_SEVERITY_INFO, "PrecLand: Target Found");
                     _estimator_initialized = true;
@@ -542,8 +542,8 @@ void AC_PrecLand::run_estimator(float rangefinder_alt_m, bool rangefinder_alt_va
                 _ekf_y.predict(dt, -vehicleDelVel.y, _accel_noise*dt);
             }
 
-            // Update if a new Line-Of-Sight measurement is available
-            if (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
+            // Update with each new Line-Of-Sight measurement since the last update
+            while (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
                 float xy_pos_var = sq(_target_pos_rel_meas_NED.z*(0.01f + 0.01f*AP::ahrs().get_gyro().length()) + 0.02f);
                 if (!_estimator_initialized) {
                     // Inform the user landing target has been found
@@ -612,11 +612,18 @@ void AC_PrecLand::check_ekf_init_timeout()
     }
 }
 
-bool AC_PrecLand::retrieve_los_meas(Vector3f& target_vec_unit_body)
+bool AC_PrecLand::retrieve_los_meas(Vector3f& target_vec_unit_body, float &distance_m, uint32_t &time_ms)
 {
-    const uint32_t los_meas_time_ms = _backend->los_meas_time_ms();
-    if (los_meas_time_ms != _last_backend_los_meas_ms && _backend->get_los_body(target_vec_unit_body)) {
-        _last_backend_los_meas_ms = los_meas_time_ms;
+    AC_PrecLand_Backend::los_meas meas;
+    while (_backend->pop_los_meas(meas)) {
+        // ignore measurements older than the backend's timeout
+        if (AP_HAL::millis() - meas.time_ms > 1000) {
+            continue;
+        }
+        _last_backend_los_meas_ms = meas.time_ms;
+        target_vec_unit_body = meas.dir_body;
+        distance_m = meas.distance_m;
+        time_ms = meas.time_ms;
         if (!is_zero(_yaw_align)) {
             // Apply sensor yaw alignment rotation
             target_vec_unit_body.rotate_xy(radians(_yaw_align*0.01f));
@@ -644,13 +651,17 @@ bool AC_PrecLand::retrieve_los_meas(Vector3f& target_vec_unit_body)
 bool AC_PrecLand::construct_pos_meas_using_rangefinder(float rangefinder_alt_m, bool rangefinder_alt_valid)
 {
     Vector3f target_vec_unit_body;
-    if (retrieve_los_meas(target_vec_unit_body)) {
-        _inertial_data_delayed = (*_inertial_history)[0];
+    float distance_m;
+    uint32_t meas_time_ms;
+    while (retrieve_los_meas(target_vec_unit_body, distance_m, meas_time_ms)) {
+        // use the attitude at the time the measurement was taken
+        const uint8_t meas_index = get_inertial_index(meas_time_ms);
+        _inertial_data_delayed = (*_inertial_history)[meas_index];
 
         const bool target_vec_valid = target_vec_unit_body.projected(_approach_vector_body).dot(_approach_vector_body) > 0.0f;
         const Vector3f target_vec_unit_ned = _inertial_data_delayed->Tbn * target_vec_unit_body;
         const Vector3f approach_vector_NED = _inertial_data_delayed->Tbn * _approach_vector_body;
-        const bool alt_valid = (rangefinder_alt_valid && rangefinder_alt_m > 0.0f) || (_backend->distance_to_target() > 0.0f);
+        const bool alt_valid = (rangefinder_alt_valid && rangefinder_alt_m > 0.0f) || (distance_m > 0.0f);
         if (target_vec_valid && alt_valid) {
             // distance to target and distance to target along approach vector
             float dist_to_target, dist_to_target_along_av;
@@ -661,9 +672,9 @@ bool AC_PrecLand::construct_pos_meas_using_rangefinder(float rangefinder_alt_m,
                 // take its height into account while calculating distance
                 cam_pos_ned = _inertial_data_delayed->Tbn * _cam_offset;
             }
-            if (_backend->distance_to_target() > 0.0f) {
+            if (distance_m > 0.0f) {
                 // sensor has provided distance to landing target
-                dist_to_target = _backend->distance_to_target();
+                dist_to_target = distance_m;
             } else {
                 // sensor only knows the horizontal location of the landing target
                 // rely on rangefinder for the vertical target
@@ -678,6 +689,15 @@ bool AC_PrecLand::construct_pos_meas_using_rangefinder(float rangefinder_alt_m,
             // Compute target position relative to IMU
             _target_pos_rel_meas_NED = (target_vec_unit_ned * dist_to_target) + cam_pos_ned_rel_imu;
 
+            // move the measurement back to the estimator's delayed time
+            // horizon by adding the vehicle's movement since then
+            for (uint8_t i=1; i<=meas_index; i++) {
+                const struct inertial_data_frame_s *inertial_data = (*_inertial_history)[i];
+                _target_pos_rel_meas_NED.x += inertial_data->inertialNavVelocity.x * inertial_data->dt;
+                _target_pos_rel_meas_NED.y += inertial_data->inertialNavVelocity.y * inertial_data->dt;
+            }
+            _inertial_data_delayed = (*_inertial_history)[0];
+
             // store the current relative down position so that if we need to retry landing, we know at this height landing target can be found
             const AP_AHRS &_ahrs = AP::ahrs();
             Vector3f pos_NED;
@@ -688,9 +708,29 @@ bool AC_PrecLand::construct_pos_meas_using_rangefinder(float rangefinder_alt_m,
             return true;
         }
     }
+    _inertial_data_delayed = (*_inertial_history)[0];
     return false;
 }
 
+// get the index in the inertial history of the frame closest to when a
+// measurement was taken, allowing for the sensor lag, the oldest frame if
+// the measurement is from before the start of the history
+uint8_t AC_PrecLand::get_inertial_index(uint32_t meas_time_ms) const
+{
+    const uint64_t now_us = AP_HAL::micros64();
+    const uint64_t meas_age_us = uint64_t(AP_HAL::millis() - meas_time_ms) * 1000U + uint64_t(_lag * 1.0e6f);
+    if (meas_age_us >= now_us) {
+        return 0;
+    }
+    const uint64_t capture_time_us = now_us - meas_age_us;
+    for (uint8_t i=_inertial_history->available(); i>1; i--) {
+        if ((*_inertial_history)[i-1]->time_usec <= capture_time_us) {
+            return i-1;
+        }
+    }
+    return 0;
+}
+
 void AC_PrecLand::run_output_prediction()
 {
     _target_pos_rel_out_NE = _target_pos_rel_est_NE;
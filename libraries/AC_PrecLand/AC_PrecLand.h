@@ -178,10 +178,14 @@ private:
     void run_estimator(float rangefinder_alt_m, bool rangefinder_alt_valid);
 
     // If a new measurement was retrieved, sets _target_pos_rel_meas_NED and returns true
+    // call until it returns false to use all measurements queued since the last update
     bool construct_pos_meas_using_rangefinder(float rangefinder_alt_m, bool rangefinder_alt_valid);
 
-    // get vehicle body frame 3D vector from vehicle to target.  returns true on success, false on failure
-    bool retrieve_los_meas(Vector3f& target_vec_unit_body);
+    // get the oldest unused vehicle body frame 3D vector from vehicle to target with its distance and time.  returns true on success, false on failure
+    bool retrieve_los_meas(Vector3f& target_vec_unit_body, float &distance_m, uint32_t &time_ms);
+
+    // get the index in the inertial history of the frame closest to when a measurement was taken
+    uint8_t get_inertial_index(uint32_t meas_time_ms) const;
 
     // calculate target's position and velocity relative to the vehicle (used as input to position controller)
     // results are stored in_target_pos_rel_out_NE, _target_vel_rel_out_NE
@@ -7,6 +7,7 @@
 #include "AC_PrecLand.h"
 #include <AP_Math/AP_Math.h>
 #include <AC_PID/AC_PID.h>
+#include <AP_HAL/utility/RingBuffer.h>
 
 
 class AC_PrecLand_Backend
@@ -26,6 +27,16 @@ public:
     // retrieve updates from sensor
     virtual void update() = 0;
 
+    // a line-of-sight measurement queued for the estimator
+    struct los_meas {
+        Vector3f dir_body;      // unit vector in body frame pointing towards target
+        float distance_m;       // distance from the sensor to landing target in meters (0 means distance is not known)
+        uint32_t time_ms;       // system time in milliseconds when los was measured
+    };
+
+    // get the oldest measurement not yet used by the estimator.  returns false if there are none
+    bool pop_los_meas(los_meas &meas) { return _los_meas_queue.pop(meas); }
+
     // provides a unit vector towards the target in body frame
     //  returns same as have_los_meas()
     bool get_los_body(Vector3f& dir_body) {
@@ -52,6 +63,13 @@ public:
     int8_t get_bus(void) const { return _frontend._bus.get(); }
     
 protected:
+    // queue the latest los measurement for the estimator, called by
+    // backends each time they set a new measurement so that none are
+    // lost when the sensor runs faster than the estimator
+    void queue_los_meas() {
+        _los_meas_queue.push_force(los_meas{_los_meas_body, _distance_to_target, _los_meas_time_ms});
+    }
+
     const AC_PrecLand&  _frontend;          // reference to precision landing front end
     AC_PrecLand::precland_state &_state;    // reference to this instances state
 
@@ -59,6 +77,7 @@ protected:
     uint32_t            _los_meas_time_ms;      // system time in milliseconds when los was measured
     bool                _have_los_meas;         // true if there is a valid measurement from the sensor
     float               _distance_to_target;    // distance from the sensor to landing target in meters
+    ObjectBuffer<los_meas> _los_meas_queue{AC_PRECLAND_LOS_QUEUE_SIZE}; // measurements not yet used by the estimator
 };
 
 #endif // AC_PRECLAND_ENABLED
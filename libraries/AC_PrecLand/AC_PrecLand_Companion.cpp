@@ -48,6 +48,7 @@ void AC_PrecLand_Companion::handle_msg(const mavlink_landing_target_t &packet, u
 
     _los_meas_time_ms = timestamp_ms;
     _have_los_meas = true;
+    queue_los_meas();
 }
 
 #endif // AC_PRECLAND_COMPANION_ENABLED
@@ -32,6 +32,7 @@ void AC_PrecLand_SITL::update()
 
         _have_los_meas = true;
         _los_meas_time_ms = _sitl->precland_sim.last_update_ms();
+        queue_los_meas();
     } else {
         _have_los_meas = false;
     }
@@ -31,6 +31,7 @@ void AC_PrecLand_SITL_Gazebo::update()
         irlock.get_unit_vector_body(_los_meas_body);
         _have_los_meas = true;
         _los_meas_time_ms = irlock.last_update_ms();
+        queue_los_meas();
     }
     _have_los_meas = _have_los_meas && AP_HAL::millis()-_los_meas_time_ms <= 1000;
 }
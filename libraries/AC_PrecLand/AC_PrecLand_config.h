@@ -10,6 +10,11 @@
 #define AC_PRECLAND_BACKEND_DEFAULT_ENABLED AC_PRECLAND_ENABLED
 #endif
 
+// number of line-of-sight measurements queued for the estimator between updates
+#ifndef AC_PRECLAND_LOS_QUEUE_SIZE
+#define AC_PRECLAND_LOS_QUEUE_SIZE 8
+#endif
+
 #ifndef AC_PRECLAND_COMPANION_ENABLED
 #define AC_PRECLAND_COMPANION_ENABLED AC_PRECLAND_BACKEND_DEFAULT_ENABLED
 #endif
@@ -300,12 +300,6 @@ void AP_AHRS::update_trim_rotation_matrices()
     _rotation_vehicle_body_to_autopilot_body = _rotation_autopilot_body_to_vehicle_body.transposed();
 }
 
-// return a Quaternion representing our current attitude in NED frame
-void AP_AHRS::get_quat_body_to_ned(Quaternion &quat) const
-{
-    quat.from_rotation_matrix(get_rotation_body_to_ned());
-}
-
 // convert a vector from body to earth frame
 Vector3f AP_AHRS::body_to_earth(const Vector3f &v) const
 {
@@ -377,8 +371,12 @@ void AP_AHRS::update_state(void)
 }
 
 // update run at loop rate
+AP_CYCLE_PROBE_DEFINE(ahrs_update);
+
 void AP_AHRS::update(bool skip_ins_update)
 {
+    AP_CYCLE_PROBE(ahrs_update);
+
     // periodically checks to see if we should update the AHRS
     // orientation (e.g. based on the AHRS_ORIENTATION parameter)
     // allow for runtime change of orientation
@@ -498,6 +496,19 @@ void AP_AHRS::update(bool skip_ins_update)
     // update published state
     update_state();
 
+#if AP_AHRS_HISTORY_ENABLED
+    update_history();
+#endif
+
+    // back up the active attitude for a warm restart after a
+    // watchdog reset. DCM backs up its own attitude when it is active
+    if (active_EKF_type() != EKFType::DCM) {
+        AP_HAL::Util::PersistentData &pd = hal.util->persistent_data;
+        pd.roll_rad = roll;
+        pd.pitch_rad = pitch;
+        pd.yaw_rad = yaw;
+    }
+
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
     /*
       add timing jitter to simulate slow EKF response
@@ -509,6 +520,97 @@ void AP_AHRS::update(bool skip_ins_update)
 #endif
 }
 
+#if AP_AHRS_HISTORY_ENABLED
+/*
+  add the current attitude and location to the history. Entries are
+  spaced by at least AP_AHRS_HISTORY_PERIOD_US so the history covers a
+  fixed time whatever the loop rate
+ */
+void AP_AHRS::update_history()
+{
+    if (!state.quat_ok || !state.location_ok) {
+        _history_count = 0;
+        return;
+    }
+#if AP_INERTIALSENSOR_ENABLED
+    const uint32_t time_us = AP::ins().get_last_update_usec();
+#else
+    const uint32_t time_us = AP_HAL::micros();
+#endif
+    if (_history_count > 0 &&
+        time_us - _history[_history_head].time_us < AP_AHRS_HISTORY_PERIOD_US) {
+        return;
+    }
+    _history_head = (_history_head + 1) % AP_AHRS_HISTORY_SIZE;
+    history_entry &e = _history[_history_head];
+    e.time_us = time_us;
+    e.quat = state.quat;
+    e.loc = state.location;
+    if (_history_count < AP_AHRS_HISTORY_SIZE) {
+        _history_count++;
+    }
+}
+
+/*
+  get the attitude and location at time_us, interpolating between the
+  two history entries either side of it. The entries are close to
+  evenly spaced, so the starting index is estimated from the age and
+  only needs a step or two to correct
+ */
+bool AP_AHRS::get_state_at(uint32_t time_us, Quaternion &quat, Location &loc) const
+{
+    if (_history_count == 0) {
+        return false;
+    }
+    const history_entry &newest = _history[_history_head];
+    const int32_t age_us = int32_t(newest.time_us - time_us);
+    if (age_us <= 0) {
+        // newer than the history, use the latest state
+        quat = newest.quat;
+        loc = newest.loc;
+        return true;
+    }
+
+    // number of entries back from the newest to the entry at or
+    // before time_us
+    uint8_t back = MIN(uint32_t(age_us) / AP_AHRS_HISTORY_PERIOD_US, _history_count - 1U);
+    while (back > 0 &&
+           int32_t(newest.time_us - _history[(_history_head + AP_AHRS_HISTORY_SIZE - back) % AP_AHRS_HISTORY_SIZE].time_us) > age_us) {
+        back--;
+    }
+    while (back < _history_count - 1U &&
+           int32_t(newest.time_us - _history[(_history_head + AP_AHRS_HISTORY_SIZE - back) % AP_AHRS_HISTORY_SIZE].time_us) < age_us) {
+        back++;
+    }
+    const history_entry &e0 = _history[(_history_head + AP_AHRS_HISTORY_SIZE - back) % AP_AHRS_HISTORY_SIZE];
+    if (int32_t(time_us - e0.time_us) < 0) {
+        // older than the history
+        return false;
+    }
+    if (back == 0) {
+        quat = e0.quat;
+        loc = e0.loc;
+        return true;
+    }
+    const history_entry &e1 = _history[(_history_head + AP_AHRS_HISTORY_SIZE - back + 1) % AP_AHRS_HISTORY_SIZE];
+    const uint32_t span_us = e1.time_us - e0.time_us;
+    const float frac = span_us == 0 ? 0 : float(time_us - e0.time_us) / span_us;
+
+    // rotate from e0 part of the way to e1
+    Vector3f delta;
+    (e0.quat.inverse() * e1.quat).to_axis_angle(delta);
+    Quaternion q_frac;
+    q_frac.from_axis_angle(delta * frac);
+    quat = e0.quat * q_frac;
+
+    loc = e0.loc;
+    const Vector3f ofs_ned = e0.loc.get_distance_NED(e1.loc) * frac;
+    loc.offset(ofs_ned.x, ofs_ned.y);
+    loc.alt = e0.loc.alt + int32_t((e1.loc.alt - e0.loc.alt) * frac);
+    return true;
+}
+#endif // AP_AHRS_HISTORY_ENABLED
+
 /*
  * copy results from a backend over AP_AHRS canonical results.
  * This updates member variables like roll and pitch, as well as
@@ -672,7 +774,14 @@ void AP_AHRS::update_EKF3(void)
             }
         }
 #endif
-        if (AP_HAL::millis() - start_time_ms > startup_delay_ms) {
+        if (hal.util->was_watchdog_reset() && AP_HAL::millis() < 10000 && !_ekf3_warm_start_set) {
+            // resume from the attitude before the reset rather than
+            // waiting for DCM and the EKF to align again
+            const AP_HAL::Util::PersistentData &pd = hal.util->persistent_data;
+            EKF3.setWarmStartAttitude(pd.roll_rad, pd.pitch_rad, pd.yaw_rad);
+            _ekf3_warm_start_set = true;
+        }
+        if (AP_HAL::millis() - start_time_ms > startup_delay_ms || _ekf3_warm_start_set) {
             _ekf3_started = EKF3.InitialiseFilter();
         }
     }
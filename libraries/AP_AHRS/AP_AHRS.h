@@ -207,6 +207,13 @@ public:
     // return the quaternion defining the rotation from NED to XYZ (body) axes
     bool get_quaternion(Quaternion &quat) const WARN_IF_UNUSED;
 
+#if AP_AHRS_HISTORY_ENABLED
+    // get the attitude quaternion and location at a recent time in
+    // microseconds, interpolated from a history of the AHRS state.
+    // Returns false if time_us is not covered by the history
+    bool get_state_at(uint32_t time_us, Quaternion &quat, Location &loc) const WARN_IF_UNUSED;
+#endif
+
     // return secondary attitude solution if available, as eulers in radians
     bool get_secondary_attitude(Vector3f &eulers) const {
         eulers = state.secondary_attitude;
@@ -588,7 +595,9 @@ public:
     const Matrix3f &get_rotation_body_to_ned(void) const { return state.dcm_matrix; }
 
     // return a Quaternion representing our current attitude in NED frame
-    void get_quat_body_to_ned(Quaternion &quat) const;
+    void get_quat_body_to_ned(Quaternion &quat) const {
+        quat = _quat_body_to_ned;
+    }
 
 #if AP_AHRS_DCM_ENABLED
     // get rotation matrix specifically from DCM backend (used for
@@ -743,7 +752,8 @@ private:
                    float &cr, float &cp, float &cy,
                    float &sr, float &sp, float &sy) const;
 
-    // update_trig - recalculates _cos_roll, _cos_pitch, etc based on latest attitude
+    // update_trig - recalculates _cos_roll, _cos_pitch, etc and the
+    //      attitude quaternion based on latest attitude
     //      should be called after _dcm_matrix is updated
     void update_trig(void);
 
@@ -758,12 +768,17 @@ private:
     float _sin_pitch;
     float _sin_yaw;
 
+    // attitude as a quaternion, kept with the trig variables as it
+    // is asked for several times a loop
+    Quaternion _quat_body_to_ned;
+
 #if HAL_NAVEKF2_AVAILABLE
     void update_EKF2(void);
     bool _ekf2_started;
 #endif
 #if HAL_NAVEKF3_AVAILABLE
     bool _ekf3_started;
+    bool _ekf3_warm_start_set;
     void update_EKF3(void);
 #endif
 
@@ -779,6 +794,26 @@ private:
      */
     void load_watchdog_home();
     bool _checked_watchdog_home;
+
+#if AP_AHRS_HISTORY_ENABLED
+    /*
+      history of the attitude and location at the time of the IMU
+      data they were computed from, so sensors with a known delay can
+      look up the vehicle state when they measured instead of keeping
+      their own buffers
+     */
+    #define AP_AHRS_HISTORY_SIZE 32
+    #define AP_AHRS_HISTORY_PERIOD_US 10000
+    struct history_entry {
+        uint32_t time_us;
+        Quaternion quat;
+        Location loc;
+    } _history[AP_AHRS_HISTORY_SIZE];
+    // index of the newest entry and number of valid entries
+    uint8_t _history_head;
+    uint8_t _history_count;
+    void update_history();
+#endif
     Location _home;
     bool _home_is_set :1;
     bool _home_locked :1;
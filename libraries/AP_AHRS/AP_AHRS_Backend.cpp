@@ -145,6 +145,7 @@ void AP_AHRS::update_trig(void)
     calc_trig(get_rotation_body_to_ned(),
               _cos_roll, _cos_pitch, _cos_yaw,
               _sin_roll, _sin_pitch, _sin_yaw);
+    _quat_body_to_ned.from_rotation_matrix(get_rotation_body_to_ned());
 }
 
 /*
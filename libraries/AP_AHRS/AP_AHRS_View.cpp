@@ -63,11 +63,29 @@ void AP_AHRS_View::update()
     rot_body_to_ned = ahrs.get_rotation_body_to_ned();
     gyro = ahrs.get_gyro();
 
-    if (!is_zero(y_angle + _pitch_trim_deg)) {
-        rot_body_to_ned = rot_body_to_ned * rot_view_T;
-        gyro = rot_view * gyro;
+    if (is_zero(y_angle + _pitch_trim_deg)) {
+        // the view is the same as the AHRS, which has already done
+        // the angle and trig calculations for this attitude
+        ahrs.get_quat_body_to_ned(quat_body_to_ned);
+        roll = ahrs.get_roll();
+        pitch = ahrs.get_pitch();
+        yaw = ahrs.get_yaw();
+        roll_sensor = ahrs.roll_sensor;
+        pitch_sensor = ahrs.pitch_sensor;
+        yaw_sensor = ahrs.yaw_sensor;
+        trig.cos_roll = ahrs.cos_roll();
+        trig.cos_pitch = ahrs.cos_pitch();
+        trig.cos_yaw = ahrs.cos_yaw();
+        trig.sin_roll = ahrs.sin_roll();
+        trig.sin_pitch = ahrs.sin_pitch();
+        trig.sin_yaw = ahrs.sin_yaw();
+        return;
     }
 
+    rot_body_to_ned = rot_body_to_ned * rot_view_T;
+    gyro = rot_view * gyro;
+    quat_body_to_ned.from_rotation_matrix(rot_body_to_ned);
+
     rot_body_to_ned.to_euler(&roll, &pitch, &yaw);
 
     roll_sensor  = degrees(roll) * 100;
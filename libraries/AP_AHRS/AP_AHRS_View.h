@@ -53,7 +53,7 @@ public:
 
     // return a Quaternion representing our current attitude in this view
     void get_quat_body_to_ned(Quaternion &quat) const {
-        quat.from_rotation_matrix(rot_body_to_ned);
+        quat = quat_body_to_ned;
     }
 
     // apply pitch trim
@@ -204,6 +204,7 @@ private:
     // transpose of rot_view
     Matrix3f rot_view_T;
     Matrix3f rot_body_to_ned;
+    Quaternion quat_body_to_ned;
     Vector3f gyro;
 
     struct {
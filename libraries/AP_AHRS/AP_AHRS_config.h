@@ -44,3 +44,8 @@
 #ifndef AP_AHRS_EXTERNAL_WIND_ESTIMATE_ENABLED
 #define AP_AHRS_EXTERNAL_WIND_ESTIMATE_ENABLED (HAL_PROGRAM_SIZE_LIMIT_KB>1024 && AP_AHRS_DCM_ENABLED)
 #endif
+
+// history of the attitude and position for delay compensation
+#ifndef AP_AHRS_HISTORY_ENABLED
+#define AP_AHRS_HISTORY_ENABLED AP_AHRS_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#endif
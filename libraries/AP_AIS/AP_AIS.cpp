@@ -108,139 +108,148 @@ void AP_AIS::update()
         return;
     }
 
-    // read any available lines
+    // read any available lines, a block at a time
+    uint8_t buf[64];
     uint32_t nbytes = MIN(_uart->available(),1024U);
-    while (nbytes-- > 0) {
-        const int16_t byte = _uart->read();
-        if (byte == -1) {
+    while (nbytes > 0) {
+        const ssize_t n = _uart->read(buf, MIN(nbytes, sizeof(buf)));
+        if (n <= 0) {
             break;
         }
-        const char c = byte;
-        if (decode(c)) {
-            const bool log_all = (_log_options & AIS_OPTIONS_LOG_ALL_RAW) != 0;
-            const bool log_unsupported = ((_log_options & AIS_OPTIONS_LOG_UNSUPPORTED_RAW) != 0) && !log_all; // only log unsupported if not logging all
-
-            if (_incoming.total  > AIVDM_BUFFER_SIZE)  {
-                // no point in trying to decode it wont fit
-#if HAL_LOGGING_ENABLED
-                if (log_all || log_unsupported) {
-                    log_raw(&_incoming);
-                }
-#endif
-                break;
+        nbytes -= n;
+        for (ssize_t i = 0; i < n; i++) {
+            if (decode(buf[i])) {
+                handle_sentence();
             }
+        }
+    }
+
+    // remove expired items from the list
+    const uint32_t now =  AP_HAL::millis();
+    const uint32_t timeout = _time_out * 1000;
+    if (now < timeout) {
+        return;
+    }
+    const uint32_t deadline = now - timeout;
+    for (uint16_t i = 0; i < _list.max_items(); i++) {
+        if (_list[i].last_update_ms < deadline && _list[i].last_update_ms != 0) {
+            clear_list_item(i);
+        }
+    }
+}
+
+// handle a complete AIVDM sentence held in _incoming
+void AP_AIS::handle_sentence()
+{
+    const bool log_all = (_log_options & AIS_OPTIONS_LOG_ALL_RAW) != 0;
+    const bool log_unsupported = ((_log_options & AIS_OPTIONS_LOG_UNSUPPORTED_RAW) != 0) && !log_all; // only log unsupported if not logging all
+
+    if (_incoming.total  > AIVDM_BUFFER_SIZE)  {
+        // no point in trying to decode it wont fit
 #if HAL_LOGGING_ENABLED
-            if (log_all) {
-                log_raw(&_incoming);
-            }
+        if (log_all || log_unsupported) {
+            log_raw(&_incoming);
+        }
 #endif
-
-            if (_incoming.num == 1 && _incoming.total == 1) {
-                // single part message
-                if (!payload_decode(_incoming.payload) && log_unsupported) {
+        return;
+    }
 #if HAL_LOGGING_ENABLED
-                    // could not decode so log
-                    log_raw(&_incoming);
+    if (log_all) {
+        log_raw(&_incoming);
+    }
 #endif
-                }
-            } else if (_incoming.num == _incoming.total) {
-                // last part of a multi part message
-                uint8_t index = 0;
-
-                // We have the last part, need to find preceding fragments
-                const uint8_t parts = _incoming.num - 1;
-
-                uint8_t msg_parts[parts];
-                for  (uint8_t i = 0; i < AIVDM_BUFFER_SIZE; i++) {
-                    // look for the rest of the message from the start of the buffer
-                    // we assume the message has be received in the correct order
-                    if (_AIVDM_buffer[i].num == (index + 1) && _AIVDM_buffer[i].total == _incoming.total && _AIVDM_buffer[i].ID == _incoming.ID) {
-                        msg_parts[index] = i;
-                        index++;
-                        if (index >= parts) {
-                            break;
-                        }
-                    }
-                }
 
-                // did we find the right number?
-                if (parts != index) {
-                    // could not find all of the message, save messages
+    if (_incoming.num == 1 && _incoming.total == 1) {
+        // single part message
+        if (!payload_decode(_incoming.payload) && log_unsupported) {
 #if HAL_LOGGING_ENABLED
-                    if (log_unsupported) {
-                        for (uint8_t i = 0; i < index; i++) {
-                            log_raw(&_AIVDM_buffer[msg_parts[i]]);
-                        }
-                        log_raw(&_incoming);
-                    }
+            // could not decode so log
+            log_raw(&_incoming);
 #endif
-                    // remove
-                    for (uint8_t i = 0; i < index; i++) {
-                        buffer_shift(msg_parts[i]);
-                    }
+        }
+    } else if (_incoming.num == _incoming.total) {
+        // last part of a multi part message
+        uint8_t index = 0;
+
+        // We have the last part, need to find preceding fragments
+        const uint8_t parts = _incoming.num - 1;
+
+        uint8_t msg_parts[parts];
+        for  (uint8_t i = 0; i < AIVDM_BUFFER_SIZE; i++) {
+            // look for the rest of the message from the start of the buffer
+            // we assume the message has be received in the correct order
+            if (_AIVDM_buffer[i].num == (index + 1) && _AIVDM_buffer[i].total == _incoming.total && _AIVDM_buffer[i].ID == _incoming.ID) {
+                msg_parts[index] = i;
+                index++;
+                if (index >= parts) {
                     break;
                 }
+            }
+        }
 
-                // combine packets
-                ExpandingString s;
-                s.append(_AIVDM_buffer[msg_parts[0]].payload, strlen(_AIVDM_buffer[msg_parts[0]].payload));
-                for (uint8_t i = 1; i < index; i++) {
-                    s.append(_AIVDM_buffer[msg_parts[i]].payload, strlen(_AIVDM_buffer[msg_parts[i]].payload));
-                }
-                s.append(_incoming.payload, strlen(_incoming.payload));
+        // did we find the right number?
+        if (parts != index) {
+            // could not find all of the message, save messages
 #if HAL_LOGGING_ENABLED
-                const bool decoded = payload_decode(s.get_string());
-#endif
+            if (log_unsupported) {
                 for (uint8_t i = 0; i < index; i++) {
+                    log_raw(&_AIVDM_buffer[msg_parts[i]]);
+                }
+                log_raw(&_incoming);
+            }
+#endif
+            // remove
+            for (uint8_t i = 0; i < index; i++) {
+                buffer_shift(msg_parts[i]);
+            }
+            return;
+        }
+
+        // combine packets
+        ExpandingString s;
+        s.append(_AIVDM_buffer[msg_parts[0]].payload, strlen(_AIVDM_buffer[msg_parts[0]].payload));
+        for (uint8_t i = 1; i < index; i++) {
+            s.append(_AIVDM_buffer[msg_parts[i]].payload, strlen(_AIVDM_buffer[msg_parts[i]].payload));
+        }
+        s.append(_incoming.payload, strlen(_incoming.payload));
 #if HAL_LOGGING_ENABLED
-                    // unsupported type, log and discard
-                    if (!decoded && log_unsupported) {
-                        log_raw(&_AIVDM_buffer[msg_parts[i]]);
-                    }
+        const bool decoded = payload_decode(s.get_string());
 #endif
-                    buffer_shift(msg_parts[i]);
-                }
+        for (uint8_t i = 0; i < index; i++) {
 #if HAL_LOGGING_ENABLED
-                if (!decoded && log_unsupported) {
-                    log_raw(&_incoming);
-                }
+            // unsupported type, log and discard
+            if (!decoded && log_unsupported) {
+                log_raw(&_AIVDM_buffer[msg_parts[i]]);
+            }
 #endif
-            } else {
-                // multi part message, store in buffer
-                bool fits_in = false;
-                for  (uint8_t i = 0; i < AIVDM_BUFFER_SIZE; i++) {
-                    // find the first free spot
-                    if (_AIVDM_buffer[i].num == 0 && _AIVDM_buffer[i].total == 0 && _AIVDM_buffer[i].ID == 0) {
-                        _AIVDM_buffer[i] = _incoming;
-                        fits_in = true;
-                        break;
-                    }
-                }
-                if (!fits_in) {
-                    // remove the oldest message
+            buffer_shift(msg_parts[i]);
+        }
 #if HAL_LOGGING_ENABLED
-                    if (log_unsupported) {
-                        // log the unused message before removing it
-                        log_raw(&_AIVDM_buffer[0]);
-                    }
+        if (!decoded && log_unsupported) {
+            log_raw(&_incoming);
+        }
 #endif
-                    buffer_shift(0);
-                    _AIVDM_buffer[AIVDM_BUFFER_SIZE - 1] = _incoming;
-                }
+    } else {
+        // multi part message, store in buffer
+        bool fits_in = false;
+        for  (uint8_t i = 0; i < AIVDM_BUFFER_SIZE; i++) {
+            // find the first free spot
+            if (_AIVDM_buffer[i].num == 0 && _AIVDM_buffer[i].total == 0 && _AIVDM_buffer[i].ID == 0) {
+                _AIVDM_buffer[i] = _incoming;
+                fits_in = true;
+                break;
             }
         }
-    }
-
-    // remove expired items from the list
-    const uint32_t now =  AP_HAL::millis();
-    const uint32_t timeout = _time_out * 1000;
-    if (now < timeout) {
-        return;
-    }
-    const uint32_t deadline = now - timeout;
-    for (uint16_t i = 0; i < _list.max_items(); i++) {
-        if (_list[i].last_update_ms < deadline && _list[i].last_update_ms != 0) {
-            clear_list_item(i);
+        if (!fits_in) {
+            // remove the oldest message
+#if HAL_LOGGING_ENABLED
+            if (log_unsupported) {
+                // log the unused message before removing it
+                log_raw(&_AIVDM_buffer[0]);
+            }
+#endif
+            buffer_shift(0);
+            _AIVDM_buffer[AIVDM_BUFFER_SIZE - 1] = _incoming;
         }
     }
 }
@@ -255,7 +264,8 @@ void AP_AIS::send(mavlink_channel_t chan)
     const uint16_t list_size = _list.max_items();
     const uint32_t now =  AP_HAL::millis();
     uint16_t search_length = 0;
-    while (search_length < list_size) {
+    uint8_t sent = 0;
+    while (search_length < list_size && sent < AIS_VESSEL_SEND_MAX) {
         _send_index++;
         search_length++;
         if (_send_index == list_size) {
@@ -267,7 +277,11 @@ void AP_AIS::send(mavlink_channel_t chan)
                 _list[_send_index].last_send_ms = now;
                 _list[_send_index].info.tslc = (now - _list[_send_index].last_update_ms) * 0.001;
                 mavlink_msg_ais_vessel_send_struct(chan,&_list[_send_index].info);
-                return;
+                sent++;
+                if (!HAVE_PAYLOAD_SPACE(chan, AIS_VESSEL)) {
+                    // keep going from the next vessel when there is room
+                    return;
+                }
         }
     }
 }
@@ -293,26 +307,19 @@ void AP_AIS::buffer_shift(uint8_t i)
 // find vessel index in existing list, if not then return NEW_NOTHROW index if possible
 bool AP_AIS::get_vessel_index(uint32_t mmsi, uint16_t &index, uint32_t lat, uint32_t lon)
 {
-    const uint16_t list_size = _list.max_items();
+    if (find_vessel(mmsi, index)) {
+        return true;
+    }
 
-    uint16_t empty = 0;
-    bool found_empty = false;
+    // a new vessel, use the first empty slot
+    const uint16_t list_size = _list.max_items();
     for (uint16_t i = 0; i < list_size; i++) {
-        if (_list[i].info.MMSI == mmsi) {
+        if (_list[i].last_update_ms == 0) {
             index = i;
+            clear_list_item(index);
+            hash_insert(index, mmsi);
             return true;
         }
-        if (_list[i].last_update_ms == 0 && !found_empty) {
-            found_empty = true;
-            empty = i;
-        }
-    }
-
-    // got through the list without a match
-    if (found_empty) {
-        index = empty;
-        _list[index].info.MMSI = mmsi;
-        return true;
     }
 
     // no space in the list
@@ -320,7 +327,7 @@ bool AP_AIS::get_vessel_index(uint32_t mmsi, uint16_t &index, uint32_t lat, uint
         // if we can try and expand
         if (_list.expand(1)) {
             index = list_size;
-            _list[index].info.MMSI = mmsi;
+            hash_insert(index, mmsi);
             return true;
         }
     }
@@ -356,16 +363,51 @@ bool AP_AIS::get_vessel_index(uint32_t mmsi, uint16_t &index, uint32_t lat, uint
 
     if (dist < max_dist) {
         clear_list_item(index);
-        _list[index].info.MMSI = mmsi;
+        hash_insert(index, mmsi);
         return true;
     }
 
     return false;
 }
 
+// find a vessel already in the list by MMSI
+bool AP_AIS::find_vessel(uint32_t mmsi, uint16_t &index) const
+{
+    for (uint16_t i = _hash_head[hash_bucket(mmsi)]; i != 0; i = _list[i-1].hash_next) {
+        if (_list[i-1].info.MMSI == mmsi) {
+            index = i - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+// set the MMSI of an empty list item and add it to the hash index
+void AP_AIS::hash_insert(uint16_t index, uint32_t mmsi)
+{
+    const uint8_t bucket = hash_bucket(mmsi);
+    _list[index].info.MMSI = mmsi;
+    _list[index].hash_next = _hash_head[bucket];
+    _hash_head[bucket] = index + 1;
+}
+
+// remove a list item from the hash index
+void AP_AIS::hash_remove(uint16_t index)
+{
+    uint16_t *link = &_hash_head[hash_bucket(_list[index].info.MMSI)];
+    while (*link != 0) {
+        if (*link == index + 1) {
+            *link = _list[index].hash_next;
+            return;
+        }
+        link = &_list[*link - 1].hash_next;
+    }
+}
+
 void AP_AIS::clear_list_item(uint16_t index)
 {
     if (index < _list.max_items()) {
+        hash_remove(index);
         memset(&_list[index],0,sizeof(ais_vehicle_t));
     }
 }
@@ -27,6 +27,8 @@
 
 #define AIVDM_BUFFER_SIZE 10
 #define AIVDM_PAYLOAD_SIZE 65
+#define AIS_VESSEL_HASH_SIZE 32     // number of MMSI hash buckets, must be a power of two
+#define AIS_VESSEL_SEND_MAX 5       // maximum number of vessels sent per call to send
 
 class AP_AIS
 {
@@ -85,11 +87,15 @@ private:
         mavlink_ais_vessel_t info;
         uint32_t last_update_ms; // last time this was refreshed, allows timeouts
         uint32_t last_send_ms; // last time this message was sent via mavlink, stops us spamming the link
+        uint16_t hash_next; // index + 1 of the next vessel in the same hash bucket, 0 for none
     };
 
     // list of the vessels that are being tracked
     AP_ExpandingArray<ais_vehicle_t> _list {8};
 
+    // index + 1 of the first vessel in each MMSI hash bucket, 0 for an empty bucket
+    uint16_t _hash_head[AIS_VESSEL_HASH_SIZE];
+
     AP_HAL::UARTDriver *_uart;
 
     uint16_t _send_index; // index of the last vessel send over mavlink
@@ -101,6 +107,15 @@ private:
     bool get_vessel_index(uint32_t mmsi, uint16_t &index, uint32_t lat = 0, uint32_t lon = 0) WARN_IF_UNUSED;
     void clear_list_item(uint16_t index);
 
+    // MMSI hash index of the vessel list
+    static uint8_t hash_bucket(uint32_t mmsi) { return (mmsi ^ (mmsi >> 16)) & (AIS_VESSEL_HASH_SIZE - 1); }
+    bool find_vessel(uint32_t mmsi, uint16_t &index) const WARN_IF_UNUSED;
+    void hash_insert(uint16_t index, uint32_t mmsi);
+    void hash_remove(uint16_t index);
+
+    // handle a complete AIVDM sentence held in _incoming
+    void handle_sentence();
+
     // decode the payload
     bool payload_decode(const char *payload) WARN_IF_UNUSED;
 
@@ -133,6 +133,7 @@ void AccelCalibrator::new_sample(const Vector3f& delta_velocity, float dt) {
             return;
         }
 
+        _sample_index.add(_samples_collected, sample);
         _samples_collected++;
 
         if (_samples_collected >= _conf_num_samples) {
@@ -243,15 +244,13 @@ bool AccelCalibrator::accept_sample(const Vector3f& sample)
         return false;
     }
 
-    for(uint8_t i=0; i < _samples_collected; i++) {
-        Vector3f other_sample;
-        get_sample(i, other_sample);
+    return _sample_index.is_clear(sample, _min_sample_dist,
+                                  FUNCTOR_BIND_MEMBER(&AccelCalibrator::get_sample_at, Vector3f, uint16_t));
+}
 
-        if ((other_sample - sample).length() < _min_sample_dist){
-            return false;
-        }
-    }
-    return true;
+Vector3f AccelCalibrator::get_sample_at(uint16_t idx)
+{
+    return _sample_buffer[idx].delta_velocity / _sample_buffer[idx].delta_time;
 }
 
 // sets status of calibrator and takes appropriate actions
@@ -266,6 +265,7 @@ void AccelCalibrator::set_status(enum accel_cal_status_t status) {
                 free(_sample_buffer);
                 _sample_buffer = nullptr;
             }
+            _sample_index.deinit();
 
             break;
 
@@ -279,7 +279,14 @@ void AccelCalibrator::set_status(enum accel_cal_status_t status) {
                         set_status(ACCEL_CAL_FAILED);
                         break;
                     }
+                    if (!_sample_index.init(_conf_num_samples)) {
+                        free(_sample_buffer);
+                        _sample_buffer = nullptr;
+                        set_status(ACCEL_CAL_FAILED);
+                        break;
+                    }
                 }
+                _sample_index.clear(Vector3f());
             }
             if (_samples_collected >= _conf_num_samples) {
                 break;
@@ -355,7 +362,7 @@ void AccelCalibrator::run_fit(uint8_t max_iterations, float& fitness)
             }
         }
 
-        if (!mat_inverse(JTJ, JTJ, get_num_params())) {
+        if (!mat_inverse_spd(JTJ, JTJ, get_num_params())) {
             return;
         }
 
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/AP_GeodesicSampleIndex.h>
 #include <AP_Math/vectorN.h>
 
 #define ACCEL_CAL_MAX_NUM_PARAMS 9
@@ -113,6 +114,7 @@ private:
     // state
     accel_cal_status_t _status;
     struct AccelSample* _sample_buffer;
+    AP_GeodesicSampleIndex _sample_index;   // index of the sample buffer by direction, for accept_sample()
     uint8_t _samples_collected;
     union param_u _param;
     float _fitness;
@@ -123,6 +125,9 @@ private:
     // check sanity of including the sample and add it to buffer if test is passed
     bool accept_sample(const Vector3f& sample);
 
+    // return the sample at idx in the sample buffer, for _sample_index
+    Vector3f get_sample_at(uint16_t idx);
+
     // reset to calibrator state before the start of calibration
     void reset_state();
 
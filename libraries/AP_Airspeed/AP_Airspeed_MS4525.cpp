@@ -103,9 +103,15 @@ found_sensor:
 // start a measurement
 void AP_Airspeed_MS4525::_measure()
 {
+    static const uint8_t cmd = 0;
     _measurement_started_ms = 0;
-    uint8_t cmd = 0;
-    if (_dev->transfer(&cmd, 1, nullptr, 0)) {
+    _dev->transfer_async(&cmd, 1, nullptr, 0,
+                         FUNCTOR_BIND_MEMBER(&AP_Airspeed_MS4525::_measure_done, void, bool));
+}
+
+void AP_Airspeed_MS4525::_measure_done(bool ok)
+{
+    if (ok) {
         _measurement_started_ms = AP_HAL::millis();
     }
 }
@@ -141,18 +147,31 @@ float AP_Airspeed_MS4525::_get_temperature(int16_t dT_raw) const
 // read the values from the sensor
 void AP_Airspeed_MS4525::_collect()
 {
-    uint8_t data[4];
-    uint8_t data2[4];
-
     _measurement_started_ms = 0;
 
-    if (!_dev->transfer(nullptr, 0, data, sizeof(data))) {
+    _first_read_ok = false;
+    if (!_dev->transfer_async(nullptr, 0, _data, sizeof(_data),
+                              FUNCTOR_BIND_MEMBER(&AP_Airspeed_MS4525::_first_read_done, void, bool))) {
         return;
     }
     // reread the data, so we can attempt to detect bad inputs
-    if (!_dev->transfer(nullptr, 0, data2, sizeof(data2))) {
+    _dev->transfer_async(nullptr, 0, _data2, sizeof(_data2),
+                         FUNCTOR_BIND_MEMBER(&AP_Airspeed_MS4525::_collect_done, void, bool));
+}
+
+void AP_Airspeed_MS4525::_first_read_done(bool ok)
+{
+    _first_read_ok = ok;
+}
+
+// process the two reads of the sensor
+void AP_Airspeed_MS4525::_collect_done(bool ok)
+{
+    if (!ok || !_first_read_ok) {
         return;
     }
+    const uint8_t *data = _data;
+    const uint8_t *data2 = _data2;
 
     uint8_t status = (data[0] & 0xC0) >> 6;
     // only check the status on the first read, the second read is expected to be stale
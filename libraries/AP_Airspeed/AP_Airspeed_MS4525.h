@@ -48,7 +48,10 @@ public:
 
 private:
     void _measure();
+    void _measure_done(bool ok);
     void _collect();
+    void _first_read_done(bool ok);
+    void _collect_done(bool ok);
     void _timer();
     void _voltage_correction(float &diff_press_pa, float &temperature);
     float _get_pressure(int16_t dp_raw) const;
@@ -62,6 +65,10 @@ private:
     float _pressure;
     uint32_t _last_sample_time_ms;
     uint32_t _measurement_started_ms;
+    // buffers of the queued reads of the sensor
+    uint8_t _data[4];
+    uint8_t _data2[4];
+    bool _first_read_ok;
     AP_HAL::I2CDevice *_dev;
 
     bool probe(uint8_t bus, uint8_t address);
@@ -343,6 +343,30 @@ void AP_Avoidance::update_threat_level(const Location &my_loc,
     obstacle.threat_level = MAV_COLLISION_THREAT_LEVEL_NONE;
 
     const uint32_t obstacle_age = AP_HAL::millis() - obstacle.timestamp_ms;
+
+    // coarse check before the closest approach calculations.  An
+    // obstacle that can't get within the warning distances even if it
+    // closed at the full current relative speed for the whole time
+    // horizon is no threat.  With busy traffic most obstacles are
+    // rejected here
+    {
+        const uint8_t time_horizon = MAX(_warn_time_horizon, _fail_time_horizon) + obstacle_age/1000;
+        const Vector3f delta_vel = obstacle_vel - my_vel;
+        const float dist_xy = obstacle_loc.get_distance_NE(my_loc).length();
+        const float min_dist_xy = dist_xy - delta_vel.xy().length() * time_horizon;
+        const float min_dist_z = fabsf(obstacle_loc.alt - my_loc.alt) * 0.01f - fabsf(delta_vel.z) * (_warn_time_horizon + obstacle_age/1000);
+        if (min_dist_xy > MAX(_warn_distance_xy.get(), float(_fail_distance_xy.get())) ||
+            min_dist_z > _warn_distance_z) {
+            // report the lower bounds on the closest approach
+            obstacle.closest_approach_xy = MAX(min_dist_xy, 0.0f);
+            obstacle.closest_approach_z = MAX(min_dist_z, 0.0f);
+            obstacle.distance_to_closest_approach = dist_xy - obstacle.closest_approach_xy;
+            const float closing_speed = delta_vel.xy().length();
+            obstacle.time_to_closest_approach = is_zero(closing_speed) ? 0.0f : obstacle.distance_to_closest_approach / closing_speed;
+            return;
+        }
+    }
+
     float closest_xy = closest_approach_xy(my_loc, my_vel, obstacle_loc, obstacle_vel, _fail_time_horizon + obstacle_age/1000);
     if (closest_xy < _fail_distance_xy) {
         obstacle.threat_level = MAV_COLLISION_THREAT_LEVEL_HIGH;
@@ -818,6 +818,9 @@ void AP_BattMonitor::read()
             }
             drivers[i]->read();
             drivers[i]->update_resistance_estimate();
+#if AP_BATTERY_MODEL_ENABLED
+            drivers[i]->update_battery_model();
+#endif
 
 #if AP_BATTERY_ESC_TELEM_OUTBOUND_ENABLED
             drivers[i]->update_esc_telem_outbound();
@@ -132,6 +132,58 @@ void AP_BattMonitor_Backend::update_resistance_estimate()
     _state.voltage_resting_estimate = _state.voltage + _state.current_amps * _state.resistance;
 }
 
+#if AP_BATTERY_MODEL_ENABLED
+// open circuit voltage of a LiPo cell at 0%, 10%, ... 100% state of charge
+static const float lipo_cell_ocv[] = { 3.30, 3.68, 3.74, 3.77, 3.79, 3.82, 3.87, 3.92, 3.98, 4.06, 4.20 };
+
+// state of charge (0 to 1) of a LiPo cell from its open circuit voltage
+static float lipo_cell_soc(float cell_voltage)
+{
+    const uint8_t n = ARRAY_SIZE(lipo_cell_ocv);
+    if (cell_voltage <= lipo_cell_ocv[0]) {
+        return 0;
+    }
+    for (uint8_t i = 1; i < n; i++) {
+        if (cell_voltage < lipo_cell_ocv[i]) {
+            const float frac = (cell_voltage - lipo_cell_ocv[i-1]) / (lipo_cell_ocv[i] - lipo_cell_ocv[i-1]);
+            return (i - 1 + frac) / (n - 1);
+        }
+    }
+    return 1;
+}
+
+/*
+  update the time remaining from an equivalent circuit model of the
+  battery. The pack is modelled as an open circuit voltage source that
+  depends on the state of charge in series with the estimated internal
+  resistance, so the resting voltage estimate is the open circuit
+  voltage. The remaining capacity is the lower of the one given by the
+  open circuit voltage and the one left after the consumed mAh, which
+  catches a pack that was not fully charged as well as one that has
+  lost capacity with age
+*/
+void AP_BattMonitor_Backend::update_battery_model()
+{
+    const uint8_t cells = _params._model_cells;
+    if (cells == 0 || has_time_remaining() || !has_current()) {
+        return;
+    }
+
+    const float pack_capacity_mah = _params._pack_capacity;
+    if (!_state.healthy || !is_positive(pack_capacity_mah) || !is_positive(_current_filt_amps)) {
+        _state.has_time_remaining = false;
+        return;
+    }
+
+    const float soc = lipo_cell_soc(_state.voltage_resting_estimate / cells);
+    const float remaining_mah = MIN(soc * pack_capacity_mah, MAX(pack_capacity_mah - _state.consumed_mah, 0));
+
+    // mAh at the filtered current draw, 3.6 seconds per mAh per amp
+    _state.time_remaining = remaining_mah * 3.6f / _current_filt_amps;
+    _state.has_time_remaining = true;
+}
+#endif // AP_BATTERY_MODEL_ENABLED
+
 // return true if state of health can be provided and fills in soh_pct argument
 bool AP_BattMonitor_Backend::get_state_of_health_pct(uint8_t &soh_pct) const
 {
@@ -73,6 +73,11 @@ public:
     // update battery resistance estimate and voltage_resting_estimate
     virtual void update_resistance_estimate();
 
+#if AP_BATTERY_MODEL_ENABLED
+    // update the time remaining from the battery model
+    void update_battery_model();
+#endif
+
     // updates failsafe timers, and returns what failsafes are active
     virtual AP_BattMonitor::Failsafe update_failsafes(void);
 
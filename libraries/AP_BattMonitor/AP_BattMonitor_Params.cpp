@@ -171,6 +171,16 @@ const AP_Param::GroupInfo AP_BattMonitor_Params::var_info[] = {
     AP_GROUPINFO("ESC_INDEX", 22, AP_BattMonitor_Params, _esc_telem_outbound_index, 0),
 #endif
 
+#if AP_BATTERY_MODEL_ENABLED
+    // @Param: MDL_CELLS
+    // @DisplayName: Battery model cell count
+    // @Description: Number of series LiPo cells in the battery. When set, the battery state of charge is estimated from the resistance compensated voltage using a LiPo open circuit voltage curve and combined with the consumed capacity to give the time remaining reported to the GCS. Requires current monitoring and BATTx_CAPACITY. Use 0 to disable.
+    // @Range: 0 24
+    // @Increment: 1
+    // @User: Advanced
+    AP_GROUPINFO("MDL_CELLS", 23, AP_BattMonitor_Params, _model_cells, 0),
+#endif
+
     AP_GROUPEND
 
 };
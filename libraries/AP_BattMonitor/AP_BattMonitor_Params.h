@@ -85,4 +85,7 @@ public:
 #if AP_BATTERY_ESC_TELEM_OUTBOUND_ENABLED
     AP_Int8  _esc_telem_outbound_index; /// bitmask of ESCs to forward voltage, current, consumption and temperature to.
 #endif
+#if AP_BATTERY_MODEL_ENABLED
+    AP_Int8  _model_cells;              /// number of series cells used by the battery model, 0 disables the model
+#endif
 };
@@ -125,6 +125,11 @@
 #define AP_BATTERY_SCRIPTING_ENABLED (AP_SCRIPTING_ENABLED && AP_BATTERY_BACKEND_DEFAULT_ENABLED)
 #endif
 
+// equivalent circuit battery model for time remaining
+#ifndef AP_BATTERY_MODEL_ENABLED
+#define AP_BATTERY_MODEL_ENABLED (AP_BATTERY_ENABLED && !defined(HAL_BUILD_AP_PERIPH) && (HAL_PROGRAM_SIZE_LIMIT_KB > 1024))
+#endif
+
 #ifndef AP_BATTERY_OPTIONS_PARAM_ENABLED
 #define AP_BATTERY_OPTIONS_PARAM_ENABLED (!defined(HAL_BUILD_AP_PERIPH) || AP_BATTERY_SUM_ENABLED)
 #endif
@@ -35,3 +35,9 @@
 #ifndef AP_SDCARD_STORAGE_ENABLED
 #define AP_SDCARD_STORAGE_ENABLED (HAL_MEM_CLASS >= HAL_MEM_CLASS_1000) && (AP_FILESYSTEM_POSIX_ENABLED || AP_FILESYSTEM_FATFS_ENABLED) && HAL_PROGRAM_SIZE_LIMIT_KB > 1024
 #endif
+
+// mission storage files larger than 64k are not held in memory, but
+// accessed through a cache of this many 1k pages
+#ifndef AP_SDCARD_STORAGE_CACHE_PAGES
+#define AP_SDCARD_STORAGE_CACHE_PAGES 16
+#endif
@@ -46,8 +46,8 @@ const AP_Param::GroupInfo AP_CANManager::CANIface_Params::var_info[] = {
 
     // @Param: OPTIONS
     // @DisplayName: CAN per-interface options
-    // @Description: CAN per-interface options
-    // @Bitmask: 0:LogAllFrames
+    // @Description: CAN per-interface options. LogFramesBatched packs the frames logged by LogAllFrames into CANB messages of up to 12 frames each, which costs much less log bandwidth on busy buses
+    // @Bitmask: 0:LogAllFrames,1:LogFramesBatched
     // @User: Advanced
     AP_GROUPINFO("OPTIONS", 4, AP_CANManager::CANIface_Params, _options, 0),
 
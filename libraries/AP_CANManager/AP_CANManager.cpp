@@ -428,13 +428,13 @@ void AP_CANManager::log_retrieve(ExpandingString &str) const
 /*
   handler for CAN frames for frame logging
  */
-void AP_CANManager::can_logging_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags)
+void AP_CANManager::can_logging_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags, uint64_t timestamp_us)
 {
 #if HAL_CANFD_SUPPORTED
     if (frame.canfd) {
         struct log_CAFD pkt {
             LOG_PACKET_HEADER_INIT(LOG_CAFD_MSG),
-            time_us : AP_HAL::micros64(),
+            time_us : timestamp_us,
             bus     : bus,
             id      : frame.id,
             dlc     : frame.dlc
@@ -446,7 +446,7 @@ void AP_CANManager::can_logging_callback(uint8_t bus, const AP_HAL::CANFrame &fr
 #endif
     struct log_CANF pkt {
         LOG_PACKET_HEADER_INIT(LOG_CANF_MSG),
-        time_us : AP_HAL::micros64(),
+        time_us : timestamp_us,
         bus     : bus,
         id      : frame.id,
         dlc     : frame.dlc
@@ -455,24 +455,125 @@ void AP_CANManager::can_logging_callback(uint8_t bus, const AP_HAL::CANFrame &fr
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
 }
 
+// a part-filled batch is written out after this long
+#define CAN_LOG_BATCH_FLUSH_US 100000
+
+struct AP_CANManager::LogBatch {
+    HAL_Semaphore sem;
+    struct log_CANB pkt;
+};
+
+/*
+  write out a batch of frames. Called with the batch semaphore held
+ */
+void AP_CANManager::log_batch_flush(LogBatch &batch)
+{
+    if (batch.pkt.count == 0) {
+        return;
+    }
+    AP::logger().WriteBlock(&batch.pkt, sizeof(batch.pkt));
+    batch.pkt.count = 0;
+}
+
+/*
+  handler for CAN frames for batched frame logging. Frames are
+  collected into a CANB message per bus, which is written when it is
+  full, when the next frame is too far from the first to be stamped
+  relative to it, or by check_logging_enable() when it gets old
+ */
+void AP_CANManager::can_logging_callback_batched(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags, uint64_t timestamp_us)
+{
+    if (_log_batch == nullptr || bus >= HAL_NUM_CAN_IFACES) {
+        can_logging_callback(bus, frame, flags, timestamp_us);
+        return;
+    }
+    LogBatch &batch = _log_batch[bus];
+    WITH_SEMAPHORE(batch.sem);
+    log_CANB &pkt = batch.pkt;
+
+#if HAL_CANFD_SUPPORTED
+    if (frame.canfd) {
+        // keep the log in order
+        log_batch_flush(batch);
+        can_logging_callback(bus, frame, flags, timestamp_us);
+        return;
+    }
+#endif
+
+    if (pkt.count > 0 &&
+        (timestamp_us < pkt.time_us || timestamp_us - pkt.time_us > UINT16_MAX)) {
+        log_batch_flush(batch);
+    }
+    if (pkt.count == 0) {
+        pkt.time_us = timestamp_us;
+        pkt.bus = bus;
+    }
+    log_CANB_frame &f = pkt.frames[pkt.count++];
+    f.dt_us = timestamp_us - pkt.time_us;
+    f.id = frame.id;
+    f.dlc = frame.dlc;
+    f.flags = (flags & AP_HAL::CANIface::IsForwardedFrame) ? 1 : 0;
+    memcpy(f.data, frame.data, sizeof(f.data));
+    if (pkt.count == LOG_CANB_MAX_FRAMES) {
+        log_batch_flush(batch);
+    }
+}
+
 /*
   see if we need to enable/disable the CAN logging callback
  */
 void AP_CANManager::check_logging_enable(void)
 {
+    const uint64_t now_us = AP_HAL::micros64();
     for (uint8_t i = 0; i < HAL_NUM_CAN_IFACES; i++) {
-        const bool enabled = _interfaces[i].option_is_set(CANIface_Params::Options::LOG_ALL_FRAMES);
-        uint8_t &logging_id = _interfaces[i].logging_id;
+        auto &iface = _interfaces[i];
+        const bool enabled = iface.option_is_set(CANIface_Params::Options::LOG_ALL_FRAMES);
+        bool batched = iface.option_is_set(CANIface_Params::Options::LOG_FRAMES_BATCHED);
+        uint8_t &logging_id = iface.logging_id;
         auto *can = hal.can[i];
         if (can == nullptr) {
             continue;
         }
-        if (enabled && logging_id == 0) {
-            can->register_frame_callback(
-                FUNCTOR_BIND_MEMBER(&AP_CANManager::can_logging_callback, void, uint8_t, const AP_HAL::CANFrame &, AP_HAL::CANIface::CanIOFlags),
-                logging_id);
-        } else if (!enabled && logging_id != 0) {
+        if (enabled && batched && _log_batch == nullptr) {
+            _log_batch = NEW_NOTHROW LogBatch[HAL_NUM_CAN_IFACES];
+            if (_log_batch == nullptr) {
+                batched = false;
+            } else {
+                for (uint8_t b = 0; b < HAL_NUM_CAN_IFACES; b++) {
+                    _log_batch[b].pkt = log_CANB {
+                        LOG_PACKET_HEADER_INIT(LOG_CANB_MSG),
+                    };
+                }
+            }
+        }
+        if (logging_id != 0 && (!enabled || batched != iface.logging_batched)) {
             can->unregister_frame_callback(logging_id);
+            logging_id = 0;
+        }
+        if (enabled && logging_id == 0) {
+            if (batched) {
+                can->register_frame_callback(
+                    FUNCTOR_BIND_MEMBER(&AP_CANManager::can_logging_callback_batched, void, uint8_t, const AP_HAL::CANFrame &, AP_HAL::CANIface::CanIOFlags, uint64_t),
+                    logging_id);
+            } else {
+                can->register_frame_callback(
+                    FUNCTOR_BIND_MEMBER(&AP_CANManager::can_logging_callback, void, uint8_t, const AP_HAL::CANFrame &, AP_HAL::CANIface::CanIOFlags, uint64_t),
+                    logging_id);
+            }
+            iface.logging_batched = batched;
+        }
+    }
+
+    if (_log_batch == nullptr) {
+        return;
+    }
+    // write out batches which have been waiting too long, including
+    // what is left of one whose bus has stopped logging
+    for (uint8_t b = 0; b < HAL_NUM_CAN_IFACES; b++) {
+        LogBatch &batch = _log_batch[b];
+        WITH_SEMAPHORE(batch.sem);
+        if (batch.pkt.count > 0 && now_us - batch.pkt.time_us > CAN_LOG_BATCH_FLUSH_US) {
+            log_batch_flush(batch);
         }
     }
 }
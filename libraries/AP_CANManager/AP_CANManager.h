@@ -138,6 +138,7 @@ private:
 
         enum class Options : uint32_t {
             LOG_ALL_FRAMES = (1U<<0),
+            LOG_FRAMES_BATCHED = (1U<<1),
         };
 
         bool option_is_set(Options option) const {
@@ -152,6 +153,7 @@ private:
 
 #if AP_CAN_LOGGING_ENABLED && HAL_LOGGING_ENABLED
         uint8_t logging_id;
+        bool logging_batched;
 #endif
     };
 
@@ -201,8 +203,14 @@ private:
     /*
       handler for CAN frames for logging
     */
-    void can_logging_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags);
+    void can_logging_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags, uint64_t timestamp_us);
+    void can_logging_callback_batched(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags, uint64_t timestamp_us);
     void check_logging_enable(void);
+
+    // frames waiting to be written as a CANB message, one per bus
+    struct LogBatch;
+    LogBatch *_log_batch;
+    void log_batch_flush(LogBatch &batch);
 #endif
 };
 
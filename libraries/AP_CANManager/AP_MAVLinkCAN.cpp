@@ -54,7 +54,7 @@ bool AP_MAVLinkCAN::handle_can_forward(mavlink_channel_t chan, const mavlink_com
 
     if (can_forward.callback_id == 0 &&
         !hal.can[bus]->register_frame_callback(
-            FUNCTOR_BIND_MEMBER(&AP_MAVLinkCAN::can_frame_callback, void, uint8_t, const AP_HAL::CANFrame &, AP_HAL::CANIface::CanIOFlags), can_forward.callback_id)) {
+            FUNCTOR_BIND_MEMBER(&AP_MAVLinkCAN::can_frame_callback, void, uint8_t, const AP_HAL::CANFrame &, AP_HAL::CANIface::CanIOFlags, uint64_t), can_forward.callback_id)) {
         // failed to register the callback
         return false;
     }
@@ -250,7 +250,7 @@ void AP_MAVLinkCAN::handle_can_filter_modify(const mavlink_message_t &msg)
   handler for CAN frames from the registered callback, sending frames
   out as CAN_FRAME or CANFD_FRAME messages
  */
-void AP_MAVLinkCAN::can_frame_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags)
+void AP_MAVLinkCAN::can_frame_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags, uint64_t timestamp_us)
 {
     WITH_SEMAPHORE(can_forward.sem);
     if (bus != can_forward.callback_bus) {
@@ -44,7 +44,7 @@ public:
 
 private:
     // Callback for receiving CAN frames from CAN bus and sending to GCS
-    void can_frame_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags);
+    void can_frame_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags, uint64_t timestamp_us);
     
     /*
      * Structure to maintain forwarding state
@@ -8,7 +8,8 @@
 
 #define LOG_IDS_FROM_CANMANAGER \
     LOG_CANF_MSG,               \
-    LOG_CAFD_MSG
+    LOG_CAFD_MSG,               \
+    LOG_CANB_MSG
 
 // @LoggerMessage: CANF
 // @Description: CAN Frame
@@ -56,6 +57,34 @@ struct PACKED log_CAFD {
     uint64_t data[8];
 };
 
+// frames packed into one CANB message
+#define LOG_CANB_MAX_FRAMES 12
+
+// one frame in a CANB message, 16 bytes
+struct PACKED log_CANB_frame {
+    uint16_t dt_us;     // timestamp relative to the message TimeUS
+    uint32_t id;        // frame identifier including the EFF/RTR/ERR flags
+    uint8_t dlc;
+    uint8_t flags;      // bit 0 set for received frames, clear for sent frames
+    uint8_t data[8];
+};
+
+// @LoggerMessage: CANB
+// @Description: Batch of CAN frames
+// @Field: TimeUS: Time of the first frame in the batch
+// @Field: Bus: bus number
+// @Field: N: number of frames in the batch
+// @Field: D0: frames 0 to 3, packed as 16 byte records of dt_us (uint16), id (uint32), dlc, flags and 8 data bytes
+// @Field: D1: frames 4 to 7
+// @Field: D2: frames 8 to 11
+struct PACKED log_CANB {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t bus;
+    uint8_t count;
+    log_CANB_frame frames[LOG_CANB_MAX_FRAMES];
+};
+
 #if AP_CAN_LOGGING_ENABLED
 #define LOG_STRUCTURE_FROM_CANMANAGER \
     { LOG_CANF_MSG, sizeof(log_CANF), \
@@ -73,6 +102,14 @@ struct PACKED log_CAFD {
             "s"       "#"    "-"    "-"    "-"    "-"    "-"    "-"    "-"    "-"    "-"    "-", \
             "F"       "-"    "-"    "-"    "-"    "-"    "-"    "-"    "-"    "-"    "-"    "-", \
             false \
+            }, \
+    { LOG_CANB_MSG, sizeof(log_CANB), \
+            "CANB", \
+            "Q"       "B"    "B"   "a"    "a"    "a", \
+            "TimeUS," "Bus," "N,"  "D0,"  "D1,"  "D2", \
+            "s"       "#"    "-"   "-"    "-"    "-", \
+            "F"       "-"    "-"   "-"    "-"    "-", \
+            false \
             },
 #else
 #define LOG_STRUCTURE_FROM_CANMANAGER
@@ -11,6 +11,8 @@
 
 extern const AP_HAL::HAL& hal;
 
+#define AP_CAMERA_CAPTURE_MAX_AGE_S 0.5 // capture state is not wound back further than this
+
 // Constructor
 AP_Camera_Backend::AP_Camera_Backend(AP_Camera &frontend, AP_Camera_Params &params, uint8_t instance) :
     _frontend(frontend),
@@ -417,8 +419,9 @@ void AP_Camera_Backend::check_feedback()
 #endif
         feedback_trigger_logged_count = feedback_trigger_count;
 
-        // we should consider doing this inside the ISR and pin_timer
-        prep_mavlink_msg_camera_feedback(feedback_trigger_timestamp_us);
+        // the feedback is handled some time after the capture, the
+        // geotag is wound back to the time of the pin change
+        prep_mavlink_msg_camera_feedback(feedback_trigger_timestamp_us, feedback_trigger_timestamp_us);
 
 #if HAL_LOGGING_ENABLED
         // log camera message
@@ -429,21 +432,65 @@ void AP_Camera_Backend::check_feedback()
     }
 }
 
-void AP_Camera_Backend::prep_mavlink_msg_camera_feedback(uint64_t timestamp_us)
+void AP_Camera_Backend::prep_mavlink_msg_camera_feedback(uint64_t timestamp_us, uint32_t capture_us)
 {
-    const AP_AHRS &ahrs = AP::ahrs();
-    if (!ahrs.get_location(camera_feedback.location)) {
-        // completely ignore this failure!  AHRS will provide its best guess.
-    }
+    get_capture_state(capture_us, camera_feedback.location, camera_feedback.roll_sensor, camera_feedback.pitch_sensor, camera_feedback.yaw_sensor);
     camera_feedback.timestamp_us = timestamp_us;
-    camera_feedback.roll_sensor = ahrs.roll_sensor;
-    camera_feedback.pitch_sensor = ahrs.pitch_sensor;
-    camera_feedback.yaw_sensor = ahrs.yaw_sensor;
     camera_feedback.feedback_trigger_logged_count = feedback_trigger_logged_count;
 
     GCS_SEND_MESSAGE(MSG_CAMERA_FEEDBACK);
 }
 
+// get the vehicle location and attitude at a recent capture time. This
+// comes from the AHRS state history where available, otherwise the
+// current AHRS state is wound back by the NED velocity and the body rates
+// over the time since the capture, which for a feedback pin handled in
+// the main loop is up to a loop period plus any scheduler delay
+void AP_Camera_Backend::get_capture_state(uint32_t capture_us, Location &loc, int32_t &roll_cd, int32_t &pitch_cd, int32_t &yaw_cd) const
+{
+    const AP_AHRS &ahrs = AP::ahrs();
+#if AP_AHRS_HISTORY_ENABLED
+    Quaternion quat;
+    if (capture_us != 0 && ahrs.get_state_at(capture_us, quat, loc)) {
+        float roll, pitch, yaw;
+        quat.to_euler(roll, pitch, yaw);
+        roll_cd = degrees(roll) * 100;
+        pitch_cd = degrees(pitch) * 100;
+        yaw_cd = wrap_360_cd(degrees(yaw) * 100);
+        return;
+    }
+#endif
+    if (!ahrs.get_location(loc)) {
+        // completely ignore this failure!  AHRS will provide its best guess.
+    }
+    float roll = ahrs.get_roll();
+    float pitch = ahrs.get_pitch();
+    float yaw = ahrs.get_yaw();
+
+    const float dt = capture_us == 0 ? 0 : MIN((AP_HAL::micros() - capture_us) * 1.0e-6f, AP_CAMERA_CAPTURE_MAX_AGE_S);
+    if (is_positive(dt)) {
+        Vector3f vel_ned;
+        if (loc.initialised() && ahrs.get_velocity_NED(vel_ned)) {
+            loc.offset((vel_ned * -dt).topostype());
+        }
+
+        // body rates to euler angle rates
+        const Vector3f &gyro = ahrs.get_gyro();
+        const float cos_pitch = MAX(cosf(pitch), 0.1f);
+        const float qr = gyro.y * sinf(roll) + gyro.z * cosf(roll);
+        const float roll_rate = gyro.x + qr * sinf(pitch) / cos_pitch;
+        const float pitch_rate = gyro.y * cosf(roll) - gyro.z * sinf(roll);
+        const float yaw_rate = qr / cos_pitch;
+        roll -= roll_rate * dt;
+        pitch -= pitch_rate * dt;
+        yaw -= yaw_rate * dt;
+    }
+
+    roll_cd = degrees(roll) * 100;
+    pitch_cd = degrees(pitch) * 100;
+    yaw_cd = wrap_360_cd(degrees(yaw) * 100);
+}
+
 #if HAL_LOGGING_ENABLED
 // log picture
 void AP_Camera_Backend::log_picture()
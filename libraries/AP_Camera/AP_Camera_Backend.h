@@ -163,7 +163,13 @@ protected:
     void check_feedback();
 
     // store vehicle location and attitude for use in camera_feedback message to GCS
-    void prep_mavlink_msg_camera_feedback(uint64_t timestamp_us);
+    // capture_us is the system time of the capture in microseconds, 0 for now
+    void prep_mavlink_msg_camera_feedback(uint64_t timestamp_us, uint32_t capture_us = 0);
+
+    // get the vehicle location and attitude in centi-degrees at the
+    // system time capture_us, which should be no older than a few
+    // main loops. 0 gets the current state
+    void get_capture_state(uint32_t capture_us, Location &loc, int32_t &roll_cd, int32_t &pitch_cd, int32_t &yaw_cd) const;
     struct {
         uint64_t timestamp_us;      // system time of most recent image
         Location location;          // location where most recent image was taken
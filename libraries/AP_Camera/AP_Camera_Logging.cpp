@@ -22,12 +22,10 @@ void AP_Camera_Backend::Write_CameraInfo(enum LogMessages msg, uint64_t timestam
         return;
     }
 
-    const AP_AHRS &ahrs = AP::ahrs();
-
+    // a non-zero timestamp is the capture time reported by the feedback pin
     Location current_loc;
-    if (!ahrs.get_location(current_loc)) {
-        // completely ignore this failure!  AHRS will provide its best guess.
-    }
+    int32_t roll_cd, pitch_cd, yaw_cd;
+    get_capture_state(uint32_t(timestamp_us), current_loc, roll_cd, pitch_cd, yaw_cd);
 
     int32_t altitude_cm = 0;
     int32_t altitude_rel_cm = 0;
@@ -62,9 +60,9 @@ void AP_Camera_Backend::Write_CameraInfo(enum LogMessages msg, uint64_t timestam
         altitude    : altitude_cm,
         altitude_rel: altitude_rel_cm,
         altitude_gps: altitude_gps_cm,
-        roll        : (int16_t)ahrs.roll_sensor,
-        pitch       : (int16_t)ahrs.pitch_sensor,
-        yaw         : (uint16_t)ahrs.yaw_sensor
+        roll        : (int16_t)roll_cd,
+        pitch       : (int16_t)pitch_cd,
+        yaw         : (uint16_t)yaw_cd
     };
     AP::logger().WriteCriticalBlock(&pkt, sizeof(pkt));
 
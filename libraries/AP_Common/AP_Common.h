@@ -192,3 +192,17 @@ template <typename T> void BIT_CLEAR (T& value, uint8_t bitnumber) noexcept {
 #define NEW_NOTHROW new(std::nothrow)
 #endif
 
+/*
+  NEW_NOTHROW_FAST is NEW_NOTHROW from fast memory (DTCM on H7, CCM
+  on F4) where the board has it, otherwise from the normal heap. Use
+  it for objects used on every sample of the fast loop. The objects
+  are freed with delete as usual
+ */
+struct AP_FastMem_t {};
+extern const AP_FastMem_t AP_FastMem;
+void *operator new(size_t size, const AP_FastMem_t &fastmem) noexcept;
+void *operator new[](size_t size, const AP_FastMem_t &fastmem) noexcept;
+#ifndef NEW_NOTHROW_FAST
+#define NEW_NOTHROW_FAST new(AP_FastMem)
+#endif
+
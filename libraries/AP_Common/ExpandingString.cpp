@@ -114,6 +114,17 @@ bool ExpandingString::append(const char *s, uint32_t len)
     return true;
 }
 
+/*
+  make sure the string can hold at least len bytes without expanding
+ */
+bool ExpandingString::reserve(uint32_t len)
+{
+    if (buflen >= len) {
+        return true;
+    }
+    return expand(len - used);
+}
+
 ExpandingString::~ExpandingString()
 {
     if (!external_buffer) {
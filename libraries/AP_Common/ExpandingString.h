@@ -48,6 +48,9 @@ public:
     // zero out the string
     void reset() { used = 0; }
 
+    // make sure the string can hold at least len bytes without expanding
+    bool reserve(uint32_t len) WARN_IF_UNUSED;
+
     // destructor
     ~ExpandingString();
 
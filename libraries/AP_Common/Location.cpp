@@ -617,4 +617,46 @@ void Location::linearly_interpolate_alt(const Location &point1, const Location &
     set_alt_cm(point1.alt + (point2.alt - point1.alt) * constrain_float(line_path_proportion(point1, point2), 0.0f, 1.0f), point2.get_alt_frame());
 }
 
+void LocalFrame::set_origin(const Location &origin)
+{
+    _origin = origin;
+    const ftype lat_rad = origin.lat * (1.0e-7 * DEG_TO_RAD);
+    _cos_lat = cosF(lat_rad);
+    _sin_lat = sinF(lat_rad);
+}
+
+/*
+  the longitude scale at the midpoint latitude, as used by Location,
+  from a second order expansion of cos() about the origin
+ */
+ftype LocalFrame::longitude_scale_mid(int32_t lat) const
+{
+    const ftype d = (0.5 * 1.0e-7 * DEG_TO_RAD) * (lat - _origin.lat);
+    const ftype scale = _cos_lat * (1 - 0.5 * d * d) - _sin_lat * d;
+    return MAX(scale, 0.01);
+}
+
+Vector2f LocalFrame::get_distance_NE(const Location &loc) const
+{
+    return Vector2f((loc.lat - _origin.lat) * LATLON_TO_M,
+                    Location::diff_longitude(loc.lng, _origin.lng) * LATLON_TO_M * longitude_scale_mid(loc.lat));
+}
+
+void LocalFrame::get_distance_NE(const Location *locs, Vector2f *ne, uint16_t count) const
+{
+    for (uint16_t i=0; i<count; i++) {
+        ne[i] = get_distance_NE(locs[i]);
+    }
+}
+
+Location LocalFrame::offset(const Vector2f &ne) const
+{
+    Location ret = _origin;
+    const int32_t dlat = ne.x * LATLON_TO_M_INV;
+    const int64_t dlng = (ne.y * LATLON_TO_M_INV) / longitude_scale_mid(_origin.lat + dlat);
+    ret.lat = Location::limit_lattitude(_origin.lat + dlat);
+    ret.lng = Location::wrap_longitude(dlng + _origin.lng);
+    return ret;
+}
+
 #endif // HAL_BOOTLOADER_BUILD
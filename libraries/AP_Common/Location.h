@@ -200,3 +200,36 @@ private:
     // inverse of LOCATION_SCALING_FACTOR
     static constexpr float LOCATION_SCALING_FACTOR_INV = LATLON_TO_M_INV;
 };
+
+/*
+  a local North/East frame about a fixed origin. The sine and cosine
+  of the origin latitude are computed once, so
+  converting many locations to and from the frame needs no trig. The
+  results match Location::get_distance_NE() and Location::offset() to
+  well under a centimetre within tens of kilometres of the origin
+ */
+class LocalFrame
+{
+public:
+    LocalFrame() {}
+    LocalFrame(const Location &origin) { set_origin(origin); }
+
+    void set_origin(const Location &origin);
+    const Location &get_origin() const { return _origin; }
+
+    // return the distance in meters North/East from the origin to loc
+    Vector2f get_distance_NE(const Location &loc) const;
+    // convert count locations to North/East distances in meters
+    void get_distance_NE(const Location *locs, Vector2f *ne, uint16_t count) const;
+
+    // return the origin moved by ne meters North/East
+    Location offset(const Vector2f &ne) const;
+
+private:
+    // longitude scale at the midpoint of the origin and a latitude
+    ftype longitude_scale_mid(int32_t lat) const;
+
+    Location _origin;
+    ftype _cos_lat = 1;
+    ftype _sin_lat = 0;
+};
@@ -7,6 +7,8 @@
 #include <new>
 #include <AP_InternalError/AP_InternalError.h>
 
+extern const AP_HAL::HAL& hal;
+
 /*
   globally override new and delete to ensure that we always start with
   zero memory. This ensures consistent behaviour.
@@ -53,6 +55,25 @@ void * operator new[](size_t size, std::nothrow_t const &nothrow)
     return(calloc(size, 1));
 }
 
+/*
+  variant for NEW_NOTHROW_FAST. This needs the HAL, so can't be used
+  for objects constructed before main()
+ */
+const AP_FastMem_t AP_FastMem;
+
+void * operator new(size_t size, const AP_FastMem_t &fastmem) noexcept
+{
+    if (size < 1) {
+        size = 1;
+    }
+    return hal.util->malloc_type(size, AP_HAL::Util::MEM_FAST);
+}
+
+void * operator new[](size_t size, const AP_FastMem_t &fastmem) noexcept
+{
+    return operator new(size, fastmem);
+}
+
 /*
   These variants are for new without std::nothrow. We don't want to ever
   use this from ArduPilot code
@@ -21,4 +21,22 @@ TEST(ExpandingString, Tests)
     test_string->printf("%s", long_string);
 }
 
+TEST(ExpandingString, Reserve)
+{
+    ExpandingString test_string;
+    EXPECT_TRUE(test_string.reserve(1024));
+    const char *buf = test_string.get_string();
+    for (uint8_t i = 0; i < 100; i++) {
+        test_string.printf("line %u\n", unsigned(i));
+    }
+    EXPECT_LT(test_string.get_length(), 1024u);
+    // no expansion was needed so the buffer has not moved
+    EXPECT_EQ(buf, test_string.get_string());
+    test_string.reset();
+    test_string.printf("Test\n");
+    EXPECT_EQ(buf, test_string.get_string());
+    EXPECT_EQ(5u, test_string.get_length());
+    EXPECT_FALSE(test_string.has_failed_allocation());
+}
+
 AP_GTEST_MAIN()
@@ -465,5 +465,42 @@ TEST(Location, London_distance)
     TEST_POLYGON_DISTANCE_POINTS(London_boundary, London_test_points);
 }
 
+TEST(Location, LocalFrame)
+{
+    const Location origins[] {
+        Location(-353632640, 1491652352, 58400, Location::AltFrame::ABSOLUTE),
+        Location(515085000, -1257000, 0, Location::AltFrame::ABSOLUTE),
+        Location(780000000, 1799990000, 0, Location::AltFrame::ABSOLUTE),
+    };
+    for (const auto &origin : origins) {
+        const LocalFrame frame { origin };
+        for (int16_t n = -20000; n <= 20000; n += 5000) {
+            for (int16_t e = -20000; e <= 20000; e += 5000) {
+                // frame offset agrees with Location::offset to
+                // within rounding of the 1e-7 degree lat/lng
+                Location loc = origin;
+                loc.offset(n, e);
+                const Location frame_loc = frame.offset(Vector2f(n, e));
+                EXPECT_LE(loc.get_distance(frame_loc), 0.02);
+
+                // and the distance back to the origin with get_distance_NE
+                const Vector2f ne = origin.get_distance_NE(loc);
+                const Vector2f frame_ne = frame.get_distance_NE(loc);
+                EXPECT_LE((ne - frame_ne).length(), 0.01);
+            }
+        }
+    }
+
+    const LocalFrame frame { origins[0] };
+    Location locs[3] { origins[0], origins[0], origins[0] };
+    locs[1].offset(100, 0);
+    locs[2].offset(0, -100);
+    Vector2f ne[3];
+    frame.get_distance_NE(locs, ne, 3);
+    EXPECT_VECTOR2F_NEAR(Vector2f(0, 0), ne[0], 0.01);
+    EXPECT_VECTOR2F_NEAR(Vector2f(100, 0), ne[1], 0.01);
+    EXPECT_VECTOR2F_NEAR(Vector2f(0, -100), ne[2], 0.01);
+}
+
 
 AP_GTEST_MAIN()
@@ -616,6 +616,7 @@ const AP_Param::GroupInfo Compass::var_info[] = {
     // @Description: This sets options to change the behaviour of the compass
     // @Bitmask: 0:CalRequireGPS
     // @Bitmask: 1: Allow missing DroneCAN compasses to be automaticaly replaced (calibration still required)
+    // @Bitmask: 2: Only probe the I2C addresses of the compasses in COMPASS_PRIOn_ID, for a faster boot. Clear this after changing I2C compasses
     // @User: Advanced
     AP_GROUPINFO("OPTIONS", 43, Compass, _options, 0),
 #endif
@@ -1087,6 +1088,33 @@ bool Compass::_have_i2c_driver(uint8_t bus, uint8_t address) const
     return false;
 }
 
+/*
+  with the PROBE_SAVED_I2C_ONLY option only the i2c addresses of the
+  compasses saved in the priority list are probed, so boot doesn't
+  wait on the probes of every possible external compass. If no i2c
+  compass has been saved everything is probed
+ */
+bool Compass::_i2c_probe_allowed(uint8_t bus, uint8_t address) const
+{
+    if (!option_set(Option::PROBE_SAVED_I2C_ONLY)) {
+        return true;
+    }
+    const uint32_t bus_id = AP_HAL::Device::make_bus_id(AP_HAL::Device::BUS_TYPE_I2C, bus, address, 0);
+    bool have_saved_i2c = false;
+    for (Priority i(0); i<COMPASS_MAX_INSTANCES; i++) {
+        const uint32_t saved_id = uint32_t(_priority_did_stored_list[i].get());
+        if (saved_id == 0 ||
+            AP_HAL::Device::devid_get_bus_type(saved_id) != AP_HAL::Device::BUS_TYPE_I2C) {
+            continue;
+        }
+        if (AP_HAL::Device::change_bus_id(saved_id, 0) == bus_id) {
+            return true;
+        }
+        have_saved_i2c = true;
+    }
+    return !have_saved_i2c;
+}
+
 #if COMPASS_MAX_UNREG_DEV > 0
 #define CHECK_UNREG_LIMIT_RETURN  if (_unreg_compass_count == COMPASS_MAX_UNREG_DEV) return
 #else
@@ -1102,7 +1130,7 @@ bool Compass::_have_i2c_driver(uint8_t bus, uint8_t address) const
         CHECK_UNREG_LIMIT_RETURN; \
     } while (0)
 
-#define GET_I2C_DEVICE(bus, address) _have_i2c_driver(bus, address)?nullptr:hal.i2c_mgr->get_device(bus, address)
+#define GET_I2C_DEVICE(bus, address) (_have_i2c_driver(bus, address) || !_i2c_probe_allowed(bus, address))?nullptr:hal.i2c_mgr->get_device(bus, address)
 
 /*
   look for compasses on external i2c buses
@@ -406,6 +406,8 @@ private:
 
     // see if we already have probed a i2c driver by bus number and address
     bool _have_i2c_driver(uint8_t bus_num, uint8_t address) const;
+    // see if an i2c address should be probed given the PROBE_SAVED_I2C_ONLY option
+    bool _i2c_probe_allowed(uint8_t bus_num, uint8_t address) const;
 
 #if AP_COMPASS_CALIBRATION_FIXED_YAW_ENABLED
     /*
@@ -622,6 +624,7 @@ private:
     enum class Option : uint16_t {
         CAL_REQUIRE_GPS = (1U<<0),
         ALLOW_DRONECAN_AUTO_REPLACEMENT = (1U<<1),
+        PROBE_SAVED_I2C_ONLY = (1U<<2),
     };
     bool option_set(Option opt) const { return (_options.get() & uint16_t(opt)) != 0; }
     AP_Int16 _options;
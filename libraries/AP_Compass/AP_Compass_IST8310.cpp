@@ -198,7 +198,17 @@ fail:
 
 void AP_Compass_IST8310::start_conversion()
 {
-    if (!_dev->write_register(CNTL1_REG, CNTL1_VAL_SINGLE_MEASUREMENT_MODE)) {
+    _conversion_cmd[0] = CNTL1_REG;
+    _conversion_cmd[1] = CNTL1_VAL_SINGLE_MEASUREMENT_MODE;
+    if (!_dev->transfer_async(_conversion_cmd, sizeof(_conversion_cmd), nullptr, 0,
+                              FUNCTOR_BIND_MEMBER(&AP_Compass_IST8310::start_conversion_done, void, bool))) {
+        _ignore_next_sample = true;
+    }
+}
+
+void AP_Compass_IST8310::start_conversion_done(bool ok)
+{
+    if (!ok) {
         _ignore_next_sample = true;
     }
 }
@@ -211,14 +221,16 @@ void AP_Compass_IST8310::timer()
         return;
     }
 
-    struct PACKED {
-        le16_t rx;
-        le16_t ry;
-        le16_t rz;
-    } buffer;
+    // the sample is handled by read_done() once the read has been
+    // done, leaving the bus thread free to service other devices
+    _read_reg = OUTPUT_X_L_REG;
+    _dev->transfer_async(&_read_reg, 1, (uint8_t *)&_buffer, sizeof(_buffer),
+                         FUNCTOR_BIND_MEMBER(&AP_Compass_IST8310::read_done, void, bool));
+}
 
-    bool ret = _dev->read_registers(OUTPUT_X_L_REG, (uint8_t *) &buffer, sizeof(buffer));
-    if (!ret) {
+void AP_Compass_IST8310::read_done(bool ok)
+{
+    if (!ok) {
         return;
     }
 
@@ -227,9 +239,9 @@ void AP_Compass_IST8310::timer()
     /* same period, but start counting from now */
     _dev->adjust_periodic_callback(_periodic_handle, SAMPLING_PERIOD_USEC);
 
-    auto x = static_cast<int16_t>(le16toh(buffer.rx));
-    auto y = static_cast<int16_t>(le16toh(buffer.ry));
-    auto z = static_cast<int16_t>(le16toh(buffer.rz));
+    auto x = static_cast<int16_t>(le16toh(_buffer.rx));
+    auto y = static_cast<int16_t>(le16toh(_buffer.ry));
+    auto z = static_cast<int16_t>(le16toh(_buffer.rz));
 
     /*
      * Check if value makes sense according to the FSR and Resolution of
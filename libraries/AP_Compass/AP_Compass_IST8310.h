@@ -23,6 +23,7 @@
 #include <AP_Common/AP_Common.h>
 #include <AP_HAL/AP_HAL.h>
 #include <AP_HAL/I2CDevice.h>
+#include <AP_HAL/utility/sparse-endian.h>
 #include <AP_Math/AP_Math.h>
 
 #include "AP_Compass_Backend.h"
@@ -52,8 +53,10 @@ private:
                        enum Rotation rotation);
 
     void timer();
+    void read_done(bool ok);
     bool init();
     void start_conversion();
+    void start_conversion_done(bool ok);
 
     AP_HAL::OwnPtr<AP_HAL::Device> _dev;
     AP_HAL::Device::PeriodicHandle _periodic_handle;
@@ -61,6 +64,15 @@ private:
     enum Rotation _rotation;
     uint8_t _instance;
     bool _ignore_next_sample;
+
+    // buffers of the queued transfers
+    uint8_t _conversion_cmd[2];
+    uint8_t _read_reg;
+    struct PACKED {
+        le16_t rx;
+        le16_t ry;
+        le16_t rz;
+    } _buffer;
     bool _force_external;
 };
 
@@ -55,6 +55,10 @@
  *
  * The fitting algorithm used is Levenberg-Marquardt. See also:
  * http://en.wikipedia.org/wiki/Levenberg%E2%80%93Marquardt_algorithm
+ *
+ * The sphere fit starts from a linear least squares fit that is updated
+ * as each sample is collected, and each stage of the fit ends once its
+ * steps stop improving the fitness.
  */
 
 #include "AP_Compass_config.h"
@@ -200,6 +204,8 @@ void CompassCalibrator::update()
         return;
     }
 
+    // each fit stage ends early once its steps stop improving the fit
+    const float prev_fitness = _fitness;
     if (_status == Status::RUNNING_STEP_ONE) {
         if (_fit_step >= 10) {
             if (is_equal(_fitness, _initial_fitness) || isnan(_fitness)) {  // if true, means that fitness is diverging instead of converging
@@ -213,6 +219,9 @@ void CompassCalibrator::update()
             }
             run_sphere_fit();
             _fit_step++;
+            if (fit_converged(prev_fitness)) {
+                _fit_step = 10;
+            }
         }
     } else if (_status == Status::RUNNING_STEP_TWO) {
         if (_fit_step >= 35) {
@@ -224,13 +233,36 @@ void CompassCalibrator::update()
         } else if (_fit_step < 15) {
             run_sphere_fit();
             _fit_step++;
+            if (fit_converged(prev_fitness)) {
+                _fit_step = 15;
+            }
+            if (_fit_step == 15) {
+                // the ellipsoid stage counts its own converged steps,
+                // whether or not the sphere stage converged
+                _converged_steps = 0;
+            }
         } else {
             run_ellipsoid_fit();
             _fit_step++;
+            if (fit_converged(prev_fitness)) {
+                _fit_step = 35;
+            }
         }
     }
 }
 
+bool CompassCalibrator::fit_converged(float prev_fitness)
+{
+    if (isnan(_fitness) || prev_fitness - _fitness > COMPASS_CAL_CONVERGED_FRACTION * prev_fitness) {
+        _converged_steps = 0;
+        return false;
+    }
+    // a step the fit rejected only raises lambda, so it takes a few
+    // in a row to be sure the fit can't be improved
+    _converged_steps++;
+    return _converged_steps >= COMPASS_CAL_CONVERGED_STEPS;
+}
+
 void CompassCalibrator::pull_sample()
 {
     CompassSample mag_sample;
@@ -247,7 +279,9 @@ void CompassCalibrator::pull_sample()
     }
     if (_running() && _samples_collected < COMPASS_CAL_NUM_SAMPLES && accept_sample(mag_sample.get())) {
         update_completion_mask(mag_sample.get());
+        add_sphere_lsq_sample(mag_sample.get());
         _sample_buffer[_samples_collected] = mag_sample;
+        _sample_index.add(_samples_collected, mag_sample.get());
         _samples_collected++;
     }
 }
@@ -365,6 +399,7 @@ void CompassCalibrator::initialize_fit()
     _sphere_lambda = 1.0f;
     _ellipsoid_lambda = 1.0f;
     _fit_step = 0;
+    _converged_steps = 0;
 }
 
 void CompassCalibrator::reset_state()
@@ -378,6 +413,9 @@ void CompassCalibrator::reset_state()
     _params.scale_factor = 0;
 
     memset(_completion_mask, 0, sizeof(_completion_mask));
+    _sample_index.clear(Vector3f());
+    memset(_lsq_JTJ, 0, sizeof(_lsq_JTJ));
+    memset(_lsq_JTy, 0, sizeof(_lsq_JTy));
     initialize_fit();
 }
 
@@ -395,6 +433,7 @@ bool CompassCalibrator::set_status(CompassCalibrator::Status status)
                 free(_sample_buffer);
                 _sample_buffer = nullptr;
             }
+            _sample_index.deinit();
             return true;
 
         case Status::WAITING_TO_START:
@@ -415,6 +454,10 @@ bool CompassCalibrator::set_status(CompassCalibrator::Status status)
 
             if (_sample_buffer == nullptr) {
                 _sample_buffer = (CompassSample*)calloc(COMPASS_CAL_NUM_SAMPLES, sizeof(CompassSample));
+                if (_sample_buffer != nullptr && !_sample_index.init(COMPASS_CAL_NUM_SAMPLES)) {
+                    free(_sample_buffer);
+                    _sample_buffer = nullptr;
+                }
             }
             if (_sample_buffer != nullptr) {
                 initialize_fit();
@@ -511,10 +554,22 @@ void CompassCalibrator::thin_samples()
         _sample_buffer[j] = temp;
     }
 
+    // index the samples by their direction from the fitted center
+    _sample_index.clear(-_params.offset);
+    for (uint16_t i=0; i < _samples_collected; i++) {
+        _sample_index.add(i, _sample_buffer[i].get());
+    }
+
     // remove any samples that are close together
     for (uint16_t i=0; i < _samples_collected; i++) {
         if (!accept_sample(_sample_buffer[i], i)) {
-            _sample_buffer[i] = _sample_buffer[_samples_collected-1];
+            const uint16_t last = _samples_collected-1;
+            _sample_index.remove(i);
+            if (last != i) {
+                _sample_index.remove(last);
+                _sample_buffer[i] = _sample_buffer[last];
+                _sample_index.add(i, _sample_buffer[i].get());
+            }
             _samples_collected--;
             _samples_thinned++;
         }
@@ -551,15 +606,9 @@ bool CompassCalibrator::accept_sample(const Vector3f& sample, uint16_t skip_inde
 
     float min_distance = _params.radius * 2*sinf(theta/2);
 
-    for (uint16_t i = 0; i<_samples_collected; i++) {
-        if (i != skip_index) {
-            float distance = (sample - _sample_buffer[i].get()).length();
-            if (distance < min_distance) {
-                return false;
-            }
-        }
-    }
-    return true;
+    return _sample_index.is_clear(sample, min_distance,
+                                  FUNCTOR_BIND_MEMBER(&CompassCalibrator::get_sample, Vector3f, uint16_t),
+                                  skip_index);
 }
 
 bool CompassCalibrator::accept_sample(const CompassSample& sample, uint16_t skip_index)
@@ -593,9 +642,45 @@ float CompassCalibrator::calc_mean_squared_residuals(const param_t& params) cons
     return sum;
 }
 
-// calculate initial offsets by simply taking the average values of the samples
+/*
+  accumulate the normal equations of the linear sphere fit
+  |s|^2 = 2*c.s + d, with unknowns c and d. This is linear in the
+  unknowns, so it needs only the sums below rather than passes over
+  the sample buffer
+ */
+void CompassCalibrator::add_sphere_lsq_sample(const Vector3f &sample)
+{
+    const Vector3d s = sample.todouble();
+    const double row[COMPASS_CAL_NUM_SPHERE_PARAMS] { 2*s.x, 2*s.y, 2*s.z, 1 };
+    const double y = s.length_squared();
+    for (uint8_t i = 0; i < COMPASS_CAL_NUM_SPHERE_PARAMS; i++) {
+        for (uint8_t j = 0; j < COMPASS_CAL_NUM_SPHERE_PARAMS; j++) {
+            _lsq_JTJ[i*COMPASS_CAL_NUM_SPHERE_PARAMS+j] += row[i] * row[j];
+        }
+        _lsq_JTy[i] += row[i] * y;
+    }
+}
+
+// calculate initial offsets and radius from the linear sphere fit
 void CompassCalibrator::calc_initial_offset()
 {
+    double inv[COMPASS_CAL_NUM_SPHERE_PARAMS*COMPASS_CAL_NUM_SPHERE_PARAMS];
+    if (mat_inverse_spd(_lsq_JTJ, inv, COMPASS_CAL_NUM_SPHERE_PARAMS)) {
+        double sol[COMPASS_CAL_NUM_SPHERE_PARAMS] {};
+        for (uint8_t i = 0; i < COMPASS_CAL_NUM_SPHERE_PARAMS; i++) {
+            for (uint8_t j = 0; j < COMPASS_CAL_NUM_SPHERE_PARAMS; j++) {
+                sol[i] += inv[i*COMPASS_CAL_NUM_SPHERE_PARAMS+j] * _lsq_JTy[j];
+            }
+        }
+        const Vector3f center { float(sol[0]), float(sol[1]), float(sol[2]) };
+        const float radius_sq = float(sol[3] + Vector3d{sol[0], sol[1], sol[2]}.length_squared());
+        if (!center.is_nan() && is_positive(radius_sq)) {
+            _params.offset = -center;
+            _params.radius = sqrtf(radius_sq);
+            return;
+        }
+    }
+
     // Set initial offset to the average value of the samples
     _params.offset.zero();
     for (uint16_t k = 0; k < _samples_collected; k++) {
@@ -673,11 +758,11 @@ void CompassCalibrator::run_sphere_fit()
         JTJ2[i*COMPASS_CAL_NUM_SPHERE_PARAMS+i] += _sphere_lambda/lma_damping;
     }
 
-    if (!mat_inverse(JTJ, JTJ, 4)) {
+    if (!mat_inverse_spd(JTJ, JTJ, 4)) {
         return;
     }
 
-    if (!mat_inverse(JTJ2, JTJ2, 4)) {
+    if (!mat_inverse_spd(JTJ2, JTJ2, 4)) {
         return;
     }
 
@@ -789,11 +874,11 @@ void CompassCalibrator::run_ellipsoid_fit()
         JTJ2[i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+i] += _ellipsoid_lambda/lma_damping;
     }
 
-    if (!mat_inverse(JTJ, JTJ, 9)) {
+    if (!mat_inverse_spd(JTJ, JTJ, 9)) {
         return;
     }
 
-    if (!mat_inverse(JTJ2, JTJ2, 9)) {
+    if (!mat_inverse_spd(JTJ2, JTJ2, 9)) {
         return;
     }
 
@@ -5,10 +5,13 @@
 #if COMPASS_CAL_ENABLED
 
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/AP_GeodesicSampleIndex.h>
 
 #define COMPASS_CAL_NUM_SPHERE_PARAMS       4
 #define COMPASS_CAL_NUM_ELLIPSOID_PARAMS    9
 #define COMPASS_CAL_NUM_SAMPLES             300     // number of samples required before fitting begins
+#define COMPASS_CAL_CONVERGED_FRACTION      1.0e-3f // a fit step improving fitness by less than this fraction has converged
+#define COMPASS_CAL_CONVERGED_STEPS         3       // number of converged steps in a row to end a fit stage early
 
 class CompassCalibrator {
 public:
@@ -156,6 +159,9 @@ private:
     bool accept_sample(const Vector3f &sample, uint16_t skip_index = UINT16_MAX);
     bool accept_sample(const CompassSample &sample, uint16_t skip_index = UINT16_MAX);
 
+    // return the sample at idx in the sample buffer, for _sample_index
+    Vector3f get_sample(uint16_t idx) { return _sample_buffer[idx].get(); }
+
     // returns true if fit is acceptable
     bool fit_acceptable() const;
 
@@ -178,9 +184,17 @@ private:
     // returns 1.0e30f if the sample buffer is empty
     float calc_mean_squared_residuals(const param_t& params) const;
 
-    // calculate initial offsets by simply taking the average values of the samples
+    // add a sample to the running linear least squares sphere fit
+    void add_sphere_lsq_sample(const Vector3f &sample);
+
+    // calculate initial offsets and radius from the running sphere fit,
+    // or failing that by simply taking the average values of the samples
     void calc_initial_offset();
 
+    // note the fitness before a fit step, returning true once the
+    // steps have stopped improving the fit
+    bool fit_converged(float prev_fitness);
+
     // run sphere fit to calculate diagonals and offdiagonals
     void calc_sphere_jacob(const Vector3f& sample, const param_t& params, float* ret) const;
     void run_sphere_fit();
@@ -224,6 +238,7 @@ private:
     uint8_t _attempt;                       // number of attempts have been made to calibrate
     completion_mask_t _completion_mask;     // bitmask of directions in which we have samples
     CompassSample *_sample_buffer;          // buffer of sensor values
+    AP_GeodesicSampleIndex _sample_index;   // index of the sample buffer by direction, for accept_sample()
     uint16_t _samples_collected;            // number of samples in buffer
     uint16_t _samples_thinned;              // number of samples removed by the thin_samples() call (called before step 2 begins)
 
@@ -234,6 +249,16 @@ private:
     float _initial_fitness;                 // fitness before latest "fit" was attempted (used to determine if fit was an improvement)
     float _sphere_lambda;                   // sphere fit's lambda
     float _ellipsoid_lambda;                // ellipsoid fit's lambda
+    uint8_t _converged_steps;               // number of fit steps in a row that have not improved the fit
+
+    // linear least squares fit of |s|^2 = 2c.s + d over the collected
+    // samples s, updated as each sample is accepted. Solving for the
+    // center c gives a starting point for the sphere fit close to its
+    // final solution, so the stage usually converges in a few steps.
+    // The sums of |s|^2 terms reach 1e12 for real field strengths, so
+    // they are kept in double
+    double _lsq_JTJ[COMPASS_CAL_NUM_SPHERE_PARAMS*COMPASS_CAL_NUM_SPHERE_PARAMS];
+    double _lsq_JTy[COMPASS_CAL_NUM_SPHERE_PARAMS];
 
     // variables for orientation checking
     enum Rotation _orientation;             // latest detected orientation
@@ -15,6 +15,15 @@
 #include <AP_NavEKF3/AP_NavEKF3.h>
 #endif
 
+#if AP_LOGGER_REPLAY_RING_ENABLED
+// bytes of replay history written to the log per frame while draining
+// the ring. This needs to be well above the size of one frame so the
+// ring empties
+#ifndef AP_DAL_REPLAY_RING_DRAIN_BYTES
+#define AP_DAL_REPLAY_RING_DRAIN_BYTES 1024U
+#endif
+#endif
+
 extern const AP_HAL::HAL& hal;
 
 AP_DAL *AP_DAL::_singleton = nullptr;
@@ -50,6 +59,10 @@ void AP_DAL::start_frame(AP_DAL::FrameType frametype)
 
     end_frame();
 
+#if AP_LOGGER_REPLAY_RING_ENABLED
+    replay_ring_update();
+#endif
+
     _RFRF.frame_types = uint8_t(frametype);
 
 #if AP_VEHICLE_ENABLED
@@ -169,6 +182,19 @@ void AP_DAL::init_sensors(void)
     if (alloc_failed) {
         AP_BoardConfig::allocation_error("DAL backends");
     }
+
+#if AP_LOGGER_REPLAY_RING_ENABLED
+    // the ring is only useful when we are not already logging replay
+    // data. It is optional so failing to allocate it is not an error
+    const uint16_t ring_kb = AP::logger().replay_ring_kb();
+    if (ring_kb > 0 && !AP::logger().log_replay()) {
+        _replay_ring = NEW_NOTHROW ByteBuffer(ring_kb * 1024U);
+        if (_replay_ring != nullptr && _replay_ring->get_size() == 0) {
+            delete _replay_ring;
+            _replay_ring = nullptr;
+        }
+    }
+#endif
 }
 
 /*
@@ -264,6 +290,18 @@ void AP_DAL::log_writeEulerYawAngle(float yawAngle, float yawAngleErr, uint32_t
 #endif
 }
 
+void AP_DAL::log_WarmStartAttitude3(float roll, float pitch, float yaw)
+{
+#if !APM_BUILD_TYPE(APM_BUILD_AP_DAL_Standalone) && !APM_BUILD_TYPE(APM_BUILD_Replay)
+    struct log_RWS3 pkt{
+        roll           : roll,
+        pitch          : pitch,
+        yaw            : yaw,
+    };
+    WRITE_REPLAY_BLOCK(RWS3, pkt);
+#endif
+}
+
 int AP_DAL::snprintf(char* str, size_t size, const char *format, ...) const
 {
     va_list ap;
@@ -297,6 +335,16 @@ uint8_t AP_DAL::logging_core(uint8_t c) const
 // only write if the content has changed
 void AP_DAL::WriteLogMessage(enum LogMessages msg_type, void *msg, const void *old_msg, uint8_t msg_size)
 {
+#if AP_LOGGER_REPLAY_RING_ENABLED
+    if (_singleton != nullptr && _singleton->replay_ring_write(msg_type, msg, msg_size)) {
+        // held in the replay ring
+        return;
+    }
+    // once the history is out the log carries replay data regardless of LOG_REPLAY
+    const bool force = _singleton != nullptr && _singleton->_replay_ring != nullptr;
+#else
+    const bool force = false;
+#endif
     if (!logging_started) {
         // we're not logging
         return;
@@ -307,7 +355,7 @@ void AP_DAL::WriteLogMessage(enum LogMessages msg_type, void *msg, const void *o
         // no change, skip this block write
         return;
     }
-    if (!AP::logger().WriteReplayBlock(msg_type, msg, msg_size)) {
+    if (!AP::logger().WriteReplayBlock(msg_type, msg, msg_size, force)) {
         // mark for forced write next time
         _end = 1;
     } else {
@@ -316,6 +364,109 @@ void AP_DAL::WriteLogMessage(enum LogMessages msg_type, void *msg, const void *o
 }
 #endif
 
+#if AP_LOGGER_REPLAY_RING_ENABLED
+/*
+  hold a replay message in the ring. Returns false if the message
+  should go to the logger instead. Every message is held in full, not
+  just changes, as the frames before the ring are gone by the time it
+  is written
+ */
+bool AP_DAL::replay_ring_write(enum LogMessages msg_type, const void *msg, uint8_t msg_size)
+{
+    if (_replay_ring == nullptr) {
+        return false;
+    }
+    WITH_SEMAPHORE(_replay_ring_sem);
+    if (_replay_ring_state == ReplayRingState::LIVE) {
+        return false;
+    }
+    const uint8_t header[2] { uint8_t(msg_type), msg_size };
+    const uint32_t len = sizeof(header) + msg_size;
+    while (_replay_ring->space() < len && !_replay_ring->is_empty()) {
+        replay_ring_drop_frame();
+    }
+    if ((_replay_ring->is_empty() && msg_type != LOG_RFRH_MSG) ||
+        _replay_ring->space() < len) {
+        // only start the ring on a frame boundary
+        return true;
+    }
+    _replay_ring->write(header, sizeof(header));
+    _replay_ring->write((const uint8_t *)msg, msg_size);
+    return true;
+}
+
+/*
+  discard the oldest frame in the ring, leaving it starting on the
+  next RFRH
+ */
+void AP_DAL::replay_ring_drop_frame()
+{
+    uint8_t header[2];
+    bool first = true;
+    while (_replay_ring->peekbytes(header, sizeof(header)) == sizeof(header)) {
+        if (!first && header[0] == LOG_RFRH_MSG) {
+            return;
+        }
+        first = false;
+        _replay_ring->advance(sizeof(header) + header[1]);
+    }
+    _replay_ring->clear();
+}
+
+/*
+  called at the start of each frame to move the history into the log
+  once triggered
+ */
+void AP_DAL::replay_ring_update()
+{
+    if (_replay_ring == nullptr) {
+        return;
+    }
+    WITH_SEMAPHORE(_replay_ring_sem);
+    if (!logging_started) {
+        if (_replay_ring_state != ReplayRingState::RECORDING) {
+            // log closed, start collecting history for the next one
+            _replay_ring->clear();
+            _replay_ring_state = ReplayRingState::RECORDING;
+        }
+        return;
+    }
+    if (_replay_ring_state != ReplayRingState::DRAINING) {
+        return;
+    }
+    uint32_t budget = AP_DAL_REPLAY_RING_DRAIN_BYTES;
+    uint8_t record[2+UINT8_MAX];
+    while (budget > 0 && _replay_ring->peekbytes(record, 2) == 2) {
+        const uint32_t len = 2U + record[1];
+        if (_replay_ring->peekbytes(record, len) != len ||
+            !AP::logger().WriteReplayBlock(record[0], &record[2], record[1], true)) {
+            // logger is full, carry on next frame
+            break;
+        }
+        _replay_ring->advance(len);
+        budget -= MIN(budget, len);
+    }
+    if (_replay_ring->is_empty()) {
+        // we are between frames, so the frame starting now is the
+        // first live one. Write it in full as the IFCHANGED state
+        // held by the messages doesn't match what the log has seen
+        _replay_ring_state = ReplayRingState::LIVE;
+        force_write = true;
+    }
+}
+
+void AP_DAL::replay_ring_trigger()
+{
+    if (_replay_ring == nullptr || !logging_started) {
+        return;
+    }
+    WITH_SEMAPHORE(_replay_ring_sem);
+    if (_replay_ring_state == ReplayRingState::RECORDING) {
+        _replay_ring_state = ReplayRingState::DRAINING;
+    }
+}
+#endif
+
 /*
   check if we are low on CPU for this core. This needs to capture the
   timing of running the cores
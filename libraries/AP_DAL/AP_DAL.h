@@ -11,6 +11,12 @@
 
 #include "LogStructure.h"
 
+#include <AP_Logger/AP_Logger_config.h>
+#if AP_LOGGER_REPLAY_RING_ENABLED
+#include <AP_HAL/Semaphores.h>
+#include <AP_HAL/utility/RingBuffer.h>
+#endif
+
 #include <stdio.h>
 #include <stdint.h>
 #include <cstddef>
@@ -86,6 +92,7 @@ public:
 
     void log_writeDefaultAirSpeed3(const float aspeed, const float uncertainty);
     void log_writeEulerYawAngle(float yawAngle, float yawAngleErr, uint32_t timeStamp_ms, uint8_t type);
+    void log_WarmStartAttitude3(float roll, float pitch, float yaw);
 
     enum class RFRNFlags {
         ARMED = (1U<<0),
@@ -345,6 +352,12 @@ public:
     static void WriteLogMessage(enum LogMessages msg_type, void *msg, const void *old_msg, uint8_t msg_size);
 #endif
 
+#if AP_LOGGER_REPLAY_RING_ENABLED
+    // write the replay history held in the ring into the log, then
+    // keep logging replay data for the rest of the log
+    void replay_ring_trigger();
+#endif
+
 private:
 
     static AP_DAL *_singleton;
@@ -393,6 +406,23 @@ private:
 
     void init_sensors(void);
     bool init_done;
+
+#if AP_LOGGER_REPLAY_RING_ENABLED
+    // recent replay messages held while LOG_REPLAY is off. Each
+    // message is a type byte, a length byte and the message body, and
+    // the ring always starts with an RFRH so it holds whole frames
+    ByteBuffer *_replay_ring;
+    HAL_Semaphore _replay_ring_sem;
+    enum class ReplayRingState : uint8_t {
+        RECORDING,  // holding history, nothing goes to the log
+        DRAINING,   // writing history to the log, new frames still go via the ring
+        LIVE,       // history written, replay data goes straight to the log
+    } _replay_ring_state;
+
+    bool replay_ring_write(enum LogMessages msg_type, const void *msg, uint8_t msg_size);
+    void replay_ring_drop_frame();
+    void replay_ring_update();
+#endif
 };
 
 #if HAL_LOGGING_ENABLED
@@ -16,6 +16,7 @@
     LOG_RSO3_MSG, \
     LOG_RWA3_MSG, \
     LOG_REY3_MSG, \
+    LOG_RWS3_MSG, \
     LOG_RFRN_MSG, \
     LOG_RISH_MSG, \
     LOG_RISI_MSG, \
@@ -163,6 +164,15 @@ struct log_REY3 {
     uint8_t _end;
 };
 
+// @LoggerMessage: RWS3
+// @Description: Replay warm start attitude event (EKF3)
+struct log_RWS3 {
+    float roll;
+    float pitch;
+    float yaw;
+    uint8_t _end;
+};
+
 // @LoggerMessage: RBRH
 // @Description: Replay Data Barometer Header
 struct log_RBRH {
@@ -420,6 +430,8 @@ struct log_RBOH {
       "RWA3", "ff", "Airspeed,Uncertainty", "nn", "00" }, \
     { LOG_REY3_MSG, RLOG_SIZE(REY3),                                   \
       "REY3", "ffIB", "yawangle,yawangleerr,timestamp_ms,type", "???-", "???-" }, \
+    { LOG_RWS3_MSG, RLOG_SIZE(RWS3),                                   \
+      "RWS3", "fff", "Roll,Pitch,Yaw", "rrr", "000" }, \
     { LOG_RISH_MSG, RLOG_SIZE(RISH),                                   \
       "RISH", "HBBfBB", "LR,PG,PA,LD,AC,GC", "------", "------" }, \
     { LOG_RISI_MSG, RLOG_SIZE(RISI),                                   \
@@ -169,6 +169,15 @@ const AP_Param::GroupInfo AP_DDS_Client::var_info[] {
     // @User: Standard
     AP_GROUPINFO("_MAX_RETRY", 6, AP_DDS_Client, ping_max_retry, 10),
 
+    // @Param: _BATCH_MS
+    // @DisplayName: DDS publication batch window
+    // @Description: Topics other than IMU, time, clock and NavSatFix are checked for publication once per this many milliseconds, so the samples falling due in the window are sent together in one datagram or serial frame. Average topic rates are kept. Set to 0 to check every topic on every update
+    // @Units: ms
+    // @Range: 0 50
+    // @Increment: 1
+    // @User: Advanced
+    AP_GROUPINFO("_BATCH_MS", 7, AP_DDS_Client, batch_ms, 10),
+
     AP_GROUPEND
 };
 
@@ -1724,11 +1733,35 @@ void AP_DDS_Client::write_status_topic()
 }
 #endif // AP_DDS_STATUS_PUB_ENABLED
 
+/*
+  return true if a topic with the given period is due for publication,
+  advancing its schedule by one period so the average rate is kept when
+  it is only checked once per batch window
+ */
+bool AP_DDS_Client::topic_due(uint64_t &last_ms, uint16_t period_ms, uint64_t now_ms)
+{
+    const uint64_t elapsed_ms = now_ms - last_ms;
+    if (elapsed_ms < period_ms) {
+        return false;
+    }
+    // don't try to catch up after a long gap, e.g. on reconnection
+    last_ms = elapsed_ms < 2U * period_ms ? last_ms + period_ms : now_ms;
+    return true;
+}
+
 void AP_DDS_Client::update()
 {
     WITH_SEMAPHORE(csem);
     const auto cur_time_ms = AP_HAL::millis64();
 
+    // the lower rate topics are only considered once per batch window
+    // so that all of them falling due in the window share one flush of
+    // the output stream. IMU, time, clock and NavSatFix are not delayed
+    const bool check_low_rate = cur_time_ms - last_low_rate_check_ms >= uint32_t(MAX(batch_ms.get(), 0));
+    if (check_low_rate) {
+        last_low_rate_check_ms = cur_time_ms;
+    }
+
 #if AP_DDS_TIME_PUB_ENABLED
     if (cur_time_ms - last_time_time_ms > DELAY_TIME_TOPIC_MS) {
         update_topic(time_topic);
@@ -1744,41 +1777,36 @@ void AP_DDS_Client::update()
     }
 #endif // AP_DDS_NAVSATFIX_PUB_ENABLED
 #if AP_DDS_BATTERY_STATE_PUB_ENABLED
-    if (cur_time_ms - last_battery_state_time_ms > DELAY_BATTERY_STATE_TOPIC_MS) {
+    if (check_low_rate && topic_due(last_battery_state_time_ms, DELAY_BATTERY_STATE_TOPIC_MS, cur_time_ms)) {
         for (uint8_t battery_instance = 0; battery_instance < AP_BATT_MONITOR_MAX_INSTANCES; battery_instance++) {
             update_topic(battery_state_topic, battery_instance);
             if (battery_state_topic.present) {
                 write_battery_state_topic();
             }
         }
-        last_battery_state_time_ms = cur_time_ms;
     }
 #endif // AP_DDS_BATTERY_STATE_PUB_ENABLED
 #if AP_DDS_LOCAL_POSE_PUB_ENABLED
-    if (cur_time_ms - last_local_pose_time_ms > DELAY_LOCAL_POSE_TOPIC_MS) {
+    if (check_low_rate && topic_due(last_local_pose_time_ms, DELAY_LOCAL_POSE_TOPIC_MS, cur_time_ms)) {
         update_topic(local_pose_topic);
-        last_local_pose_time_ms = cur_time_ms;
         write_local_pose_topic();
     }
 #endif // AP_DDS_LOCAL_POSE_PUB_ENABLED
 #if AP_DDS_LOCAL_VEL_PUB_ENABLED
-    if (cur_time_ms - last_local_velocity_time_ms > DELAY_LOCAL_VELOCITY_TOPIC_MS) {
+    if (check_low_rate && topic_due(last_local_velocity_time_ms, DELAY_LOCAL_VELOCITY_TOPIC_MS, cur_time_ms)) {
         update_topic(tx_local_velocity_topic);
-        last_local_velocity_time_ms = cur_time_ms;
         write_tx_local_velocity_topic();
     }
 #endif // AP_DDS_LOCAL_VEL_PUB_ENABLED
 #if AP_DDS_AIRSPEED_PUB_ENABLED
-    if (cur_time_ms - last_airspeed_time_ms > DELAY_AIRSPEED_TOPIC_MS) {
-        last_airspeed_time_ms = cur_time_ms;
+    if (check_low_rate && topic_due(last_airspeed_time_ms, DELAY_AIRSPEED_TOPIC_MS, cur_time_ms)) {
         if (update_topic(tx_local_airspeed_topic)) {
             write_tx_local_airspeed_topic();
         }
     }
 #endif // AP_DDS_AIRSPEED_PUB_ENABLED
 #if AP_DDS_RC_PUB_ENABLED
-    if (cur_time_ms - last_rc_time_ms > DELAY_RC_TOPIC_MS) {
-        last_rc_time_ms = cur_time_ms;
+    if (check_low_rate && topic_due(last_rc_time_ms, DELAY_RC_TOPIC_MS, cur_time_ms)) {
         if (update_topic(tx_local_rc_topic)) {
             write_tx_local_rc_topic();
         }
@@ -1792,9 +1820,8 @@ void AP_DDS_Client::update()
     }
 #endif // AP_DDS_IMU_PUB_ENABLED
 #if AP_DDS_GEOPOSE_PUB_ENABLED
-    if (cur_time_ms - last_geo_pose_time_ms > DELAY_GEO_POSE_TOPIC_MS) {
+    if (check_low_rate && topic_due(last_geo_pose_time_ms, DELAY_GEO_POSE_TOPIC_MS, cur_time_ms)) {
         update_topic(geo_pose_topic);
-        last_geo_pose_time_ms = cur_time_ms;
         write_geo_pose_topic();
     }
 #endif // AP_DDS_GEOPOSE_PUB_ENABLED
@@ -1806,26 +1833,23 @@ void AP_DDS_Client::update()
     }
 #endif // AP_DDS_CLOCK_PUB_ENABLED
 #if AP_DDS_GPS_GLOBAL_ORIGIN_PUB_ENABLED
-    if (cur_time_ms - last_gps_global_origin_time_ms > DELAY_GPS_GLOBAL_ORIGIN_TOPIC_MS) {
+    if (check_low_rate && topic_due(last_gps_global_origin_time_ms, DELAY_GPS_GLOBAL_ORIGIN_TOPIC_MS, cur_time_ms)) {
         update_topic(gps_global_origin_topic);
-        last_gps_global_origin_time_ms = cur_time_ms;
         write_gps_global_origin_topic();
     }
 #endif // AP_DDS_GPS_GLOBAL_ORIGIN_PUB_ENABLED
 #if AP_DDS_GOAL_PUB_ENABLED
-    if (cur_time_ms - last_goal_time_ms > DELAY_GOAL_TOPIC_MS) {
+    if (check_low_rate && topic_due(last_goal_time_ms, DELAY_GOAL_TOPIC_MS, cur_time_ms)) {
         if (update_topic_goal(goal_topic)) {
             write_goal_topic();
         }
-        last_goal_time_ms = cur_time_ms;
     }
 #endif // AP_DDS_GOAL_PUB_ENABLED
 #if AP_DDS_STATUS_PUB_ENABLED
-    if (cur_time_ms - last_status_check_time_ms > DELAY_STATUS_TOPIC_MS) {
+    if (check_low_rate && topic_due(last_status_check_time_ms, DELAY_STATUS_TOPIC_MS, cur_time_ms)) {
         if (update_topic(status_topic)) {
             write_status_topic();
         }
-        last_status_check_time_ms = cur_time_ms;
     }
 #endif // AP_DDS_STATUS_PUB_ENABLED
 
@@ -346,6 +346,13 @@ public:
     //! @brief Maximum number of attempts to ping the XRCE agent before exiting
     AP_Int8 ping_max_retry;
 
+    //! @brief Window in milliseconds over which lower rate topics are batched
+    AP_Int16 batch_ms;
+    uint64_t last_low_rate_check_ms;
+
+    //! @brief Return true if a topic is due, advancing its schedule by one period
+    static bool topic_due(uint64_t &last_ms, uint16_t period_ms, uint64_t now_ms);
+
     //! @brief Enum used to mark a topic as a data reader or writer
     enum class Topic_rw : uint8_t {
         DataReader = 0,
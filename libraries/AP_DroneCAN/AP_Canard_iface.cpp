@@ -5,6 +5,7 @@
 #include <canard/handler_list.h>
 #include <canard/transfer_object.h>
 #include <AP_Math/AP_Math.h>
+#include <AP_Common/ExpandingString.h>
 #include <dronecan_msgs.h>
 extern const AP_HAL::HAL& hal;
 #define LOG_TAG "DroneCANIface"
@@ -14,6 +15,11 @@ extern const AP_HAL::HAL& hal;
 #define DEBUG_PKTS 0
 
 #define CANARD_MSG_TYPE_FROM_ID(x)                         ((uint16_t)(((x) >> 8U)  & 0xFFFFU))
+#define CANARD_PRIORITY_FROM_ID(x)                         ((uint8_t)(((x) >> 24U) & 0x1FU))
+#define CANARD_SERVICE_NOT_MSG_FROM_ID(x)                  ((bool)(((x) >> 7U)  & 0x1U))
+#define CANARD_DEST_ID_FROM_ID(x)                          ((uint8_t)(((x) >> 8U)  & 0x7FU))
+
+#define ACCEPT_CACHE_RESET_MS 1000
 
 DEFINE_HANDLER_LIST_HEADS();
 DEFINE_HANDLER_LIST_SEMAPHORES();
@@ -103,11 +109,7 @@ bool CanardInterface::broadcast(const Canard::Transfer &bcast_transfer) {
         test_iface_sem.give();
     }
 #endif
-    if (ret <= 0) {
-        protocol_stats.tx_errors++;
-    } else {
-        protocol_stats.tx_frames += ret;
-    }
+    update_tx_protocol_stats(ret);
     return ret > 0;
 }
 
@@ -135,11 +137,7 @@ bool CanardInterface::request(uint8_t destination_node_id, const Canard::Transfe
     };
     // do canard request
     int16_t ret = canardRequestOrRespondObj(&canard, destination_node_id, &tx_transfer);
-    if (ret <= 0) {
-        protocol_stats.tx_errors++;
-    } else {
-        protocol_stats.tx_frames += ret;
-    }
+    update_tx_protocol_stats(ret);
     return ret > 0;
 }
 
@@ -167,11 +165,7 @@ bool CanardInterface::respond(uint8_t destination_node_id, const Canard::Transfe
     };
     // do canard respond
     int16_t ret = canardRequestOrRespondObj(&canard, destination_node_id, &tx_transfer);
-    if (ret <= 0) {
-        protocol_stats.tx_errors++;
-    } else {
-        protocol_stats.tx_frames += ret;
-    }
+    update_tx_protocol_stats(ret);
     return ret > 0;
 }
 
@@ -186,7 +180,38 @@ bool CanardInterface::shouldAcceptTransfer(const CanardInstance* ins,
                                            CanardTransferType transfer_type,
                                            uint8_t source_node_id) {
     CanardInterface* iface = (CanardInterface*) ins->user_reference;
-    return iface->accept_message(data_type_id, transfer_type, *out_data_type_signature);
+    return iface->accept_message_cached(data_type_id, transfer_type, *out_data_type_signature);
+}
+
+/*
+  look up whether we have a handler for a data type in a small hashed
+  cache before falling back to accept_message(), which walks the list
+  of all handlers
+ */
+bool CanardInterface::accept_message_cached(uint16_t data_type_id, CanardTransferType transfer_type, uint64_t &signature)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - accept_cache_reset_ms > ACCEPT_CACHE_RESET_MS) {
+        accept_cache_reset_ms = now_ms;
+        memset(accept_cache, 0, sizeof(accept_cache));
+    }
+
+    const uint8_t hash = (data_type_id ^ (data_type_id >> 5) ^ (uint8_t(transfer_type) << 3)) % ARRAY_SIZE(accept_cache);
+    AcceptCacheEntry &entry = accept_cache[hash];
+    if (entry.valid &&
+        entry.data_type_id == data_type_id &&
+        entry.transfer_type == uint8_t(transfer_type)) {
+        signature = entry.signature;
+        return entry.accept;
+    }
+
+    // replace whatever was in this slot
+    entry.accept = accept_message(data_type_id, transfer_type, signature);
+    entry.signature = signature;
+    entry.data_type_id = data_type_id;
+    entry.transfer_type = uint8_t(transfer_type);
+    entry.valid = true;
+    return entry.accept;
 }
 
 #if AP_TEST_DRONECAN_DRIVERS
@@ -232,6 +257,14 @@ void CanardInterface::processTx(bool raw_commands_only = false) {
         // scan through list of pending transfers
         while (true) {
             auto txf = &txq->frame;
+            if (raw_commands_only &&
+                CANARD_PRIORITY_FROM_ID(txf->id) > CANARD_TRANSFER_PRIORITY_HIGH) {
+                // the queue is in priority order, so there are no
+                // raw commands beyond here. Stopping now keeps the
+                // time to send ESC commands independent of how much
+                // other traffic is queued
+                break;
+            }
             if (raw_commands_only &&
                 CANARD_MSG_TYPE_FROM_ID(txf->id) != UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID &&
                 CANARD_MSG_TYPE_FROM_ID(txf->id) != COM_HOBBYWING_ESC_RAWCOMMAND_ID) {
@@ -283,6 +316,45 @@ void CanardInterface::processTx(bool raw_commands_only = false) {
 
 }
 
+void CanardInterface::update_tx_protocol_stats(int16_t res)
+{
+    if (res > 0) {
+        protocol_stats.tx_frames += res;
+        return;
+    }
+    protocol_stats.tx_errors++;
+    if (res == -CANARD_ERROR_OUT_OF_MEMORY) {
+        // called with _sem_tx held, so tx_transfer is the one that failed
+        tx_oom[MIN(tx_transfer.priority / 8U, ARRAY_SIZE(tx_oom)-1)]++;
+    }
+}
+
+/*
+  return the peak pool usage in bytes since boot
+ */
+uint32_t CanardInterface::pool_peak_bytes()
+{
+    const CanardPoolAllocatorStatistics stats = canardGetPoolAllocatorStatistics(&canard);
+    return stats.peak_usage_blocks * CANARD_MEM_BLOCK_SIZE;
+}
+
+/*
+  report memory pool usage and allocation failures
+ */
+void CanardInterface::pool_stats(ExpandingString &str)
+{
+    const CanardPoolAllocatorStatistics stats = canardGetPoolAllocatorStatistics(&canard);
+    str.printf("pool: blocks=%u block_size=%u used=%u peak=%u (%u%%)\n",
+               unsigned(stats.capacity_blocks),
+               unsigned(CANARD_MEM_BLOCK_SIZE),
+               unsigned(stats.current_usage_blocks),
+               unsigned(stats.peak_usage_blocks),
+               stats.capacity_blocks > 0 ? unsigned(100U * stats.peak_usage_blocks / stats.capacity_blocks) : 0U);
+    str.printf("rx_oom=%u tx_oom: highest=%u high=%u medium=%u low=%u\n",
+               unsigned(protocol_stats.rx_error_oom),
+               unsigned(tx_oom[0]), unsigned(tx_oom[1]), unsigned(tx_oom[2]), unsigned(tx_oom[3]));
+}
+
 void CanardInterface::update_rx_protocol_stats(int16_t res)
 {
     switch (-res) {
@@ -356,10 +428,24 @@ void CanardInterface::processRx() {
                 continue;
             }
 
+            // drop services between other nodes without taking the
+            // receive semaphore. libcanard would discard them anyway
+            const uint32_t can_id = rxmsg.id & AP_HAL::CANFrame::MaskExtID;
+            if (CANARD_SERVICE_NOT_MSG_FROM_ID(can_id) &&
+                CANARD_DEST_ID_FROM_ID(can_id) != canard.node_id) {
+                protocol_stats.rx_ignored_wrong_address++;
+                continue;
+            }
+
             rx_frame.data_len = AP_HAL::CANFrame::dlcToDataLength(rxmsg.dlc);
             memcpy(rx_frame.data, rxmsg.data, rx_frame.data_len);
 #if HAL_CANFD_SUPPORTED
             rx_frame.canfd = rxmsg.canfd;
+            if (rxmsg.canfd) {
+                // the source node is in the low 7 bits of the id
+                const uint8_t source_node_id = rxmsg.id & 0x7F;
+                canfd_nodes[source_node_id / 32] |= 1U << (source_node_id % 32);
+            }
 #endif
             rx_frame.id = rxmsg.id;
 #if CANARD_MULTI_IFACE
@@ -6,6 +6,7 @@
 
 class AP_DroneCAN;
 class CANSensor;
+class ExpandingString;
 
 class CanardInterface : public Canard::Interface {
     friend class AP_DroneCAN;
@@ -62,9 +63,24 @@ public:
 #endif
 
     void update_rx_protocol_stats(int16_t res);
+    void update_tx_protocol_stats(int16_t res);
+
+    // report memory pool usage and allocation failures
+    void pool_stats(ExpandingString &str);
+
+    // return the peak pool usage in bytes since boot
+    uint32_t pool_peak_bytes();
+
+    // cached accept_message(), avoiding a walk of the handler list for every transfer
+    bool accept_message_cached(uint16_t data_type_id, CanardTransferType transfer_type, uint64_t &signature);
 
     uint8_t get_node_id() const override { return canard.node_id; }
 
+    // return true if we have received CAN-FD frames from a node
+    bool node_sent_canfd(uint8_t node_id) const {
+        return node_id < 128 && (canfd_nodes[node_id / 32] & (1U << (node_id % 32))) != 0;
+    }
+
     // get reference to the semaphore that is held during message receive
     HAL_Semaphore &get_sem_rx(void) { return _sem_rx; }
 
@@ -83,7 +99,25 @@ private:
     CanardTxTransfer tx_transfer;
     dronecan_protocol_Stats protocol_stats;
 
+    // transfers that could not be queued for lack of pool memory, in
+    // priority bands of 8 starting at CANARD_TRANSFER_PRIORITY_HIGHEST
+    uint32_t tx_oom[4];
+
     // auxillary 11 bit CANSensor
     CANSensor *aux_11bit_driver;
+
+    // mask of nodes we have received CAN-FD frames from
+    uint32_t canfd_nodes[4];
+
+    // results of accept_message() by data type. The cache is cleared
+    // periodically so that handlers registered later are picked up
+    struct AcceptCacheEntry {
+        uint64_t signature;
+        uint16_t data_type_id;
+        uint8_t transfer_type;
+        bool valid;
+        bool accept;
+    } accept_cache[32];
+    uint32_t accept_cache_reset_ms;
 };
 #endif // HAL_ENABLE_DRONECAN_DRIVERS
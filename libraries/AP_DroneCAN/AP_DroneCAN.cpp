@@ -24,6 +24,7 @@
 
 #include <AP_BoardConfig/AP_BoardConfig.h>
 #include <AP_CANManager/AP_CANManager.h>
+#include <AP_Common/ExpandingString.h>
 
 #include <AP_Arming/AP_Arming.h>
 #include <AP_GPS/AP_GPS_DroneCAN.h>
@@ -75,6 +76,11 @@ extern const AP_HAL::HAL& hal;
 #endif
 #endif
 
+// automatic pool sizing allows this much per node seen, on top of a base
+#define DRONECAN_POOL_AUTO_BASE     4096
+#define DRONECAN_POOL_AUTO_PER_NODE 512
+#define DRONECAN_POOL_AUTO_MAX      16384
+
 #if HAL_CANFD_SUPPORTED
 #define DRONECAN_STACK_SIZE     8192
 #else
@@ -129,7 +135,7 @@ const AP_Param::GroupInfo AP_DroneCAN::var_info[] = {
     // @Param: OPTION
     // @DisplayName: DroneCAN options
     // @Description: Option flags
-    // @Bitmask: 0:ClearDNADatabase,1:IgnoreDNANodeConflicts,2:EnableCanfd,3:IgnoreDNANodeUnhealthy,4:SendServoAsPWM,5:SendGNSS,6:UseHimarkServo,7:HobbyWingESC,8:EnableStats,9:EnableFlexDebug
+    // @Bitmask: 0:ClearDNADatabase,1:IgnoreDNANodeConflicts,2:EnableCanfd,3:IgnoreDNANodeUnhealthy,4:SendServoAsPWM,5:SendGNSS,6:UseHimarkServo,7:HobbyWingESC,8:EnableStats,9:EnableFlexDebug,10:AutoPoolSize
     // @User: Advanced
     AP_GROUPINFO("OPTION", 5, AP_DroneCAN, _options, 0),
     
@@ -150,7 +156,7 @@ const AP_Param::GroupInfo AP_DroneCAN::var_info[] = {
 
     // @Param: POOL
     // @DisplayName: CAN pool size
-    // @Description: Amount of memory in bytes to allocate for the DroneCAN memory pool. More memory is needed for higher CAN bus loads
+    // @Description: Amount of memory in bytes to allocate for the DroneCAN memory pool. More memory is needed for higher CAN bus loads. Usage is reported in @SYS/can_stats.txt and the AutoPoolSize option can raise this automatically
     // @Range: 1024 16384
     // @User: Advanced
     AP_GROUPINFO("POOL", 8, AP_DroneCAN, _pool_size, DRONECAN_NODE_POOL_SIZE),
@@ -549,6 +555,7 @@ void AP_DroneCAN::loop(void)
         }
 #endif
         logging();
+        check_pool_size();
 #if AP_DRONECAN_HOBBYWING_ESC_SUPPORT
         hobbywing_ESC_update();
 #endif
@@ -827,8 +834,20 @@ void AP_DroneCAN::SRV_send_himark(void)
 }
 #endif // AP_DRONECAN_HIMARK_SERVO_SUPPORT
 
+/*
+  record the time taken to get ESC commands to the CAN driver
+ */
+void AP_DroneCAN::update_esc_latency(uint32_t start_us)
+{
+    const uint32_t latency_us = AP_HAL::micros() - start_us;
+    _esc_latency.sum_us += latency_us;
+    _esc_latency.max_us = MAX(_esc_latency.max_us, latency_us);
+    _esc_latency.count++;
+}
+
 void AP_DroneCAN::SRV_send_esc(void)
 {
+    const uint32_t start_us = AP_HAL::micros();
     uavcan_equipment_esc_RawCommand esc_msg;
 
     uint8_t active_esc_num = 0, max_esc_num = 0;
@@ -869,6 +888,7 @@ void AP_DroneCAN::SRV_send_esc(void)
         }
         // immediately push data to CAN bus
         canard_iface.processTx(true);
+        update_esc_latency(start_us);
     }
 
     for (uint8_t i = 0; i < DRONECAN_SRV_NUMBER; i++) {
@@ -882,6 +902,7 @@ void AP_DroneCAN::SRV_send_esc(void)
  */
 void AP_DroneCAN::SRV_send_esc_hobbywing(void)
 {
+    const uint32_t start_us = AP_HAL::micros();
     com_hobbywing_esc_RawCommand esc_msg;
 
     uint8_t active_esc_num = 0, max_esc_num = 0;
@@ -922,6 +943,7 @@ void AP_DroneCAN::SRV_send_esc_hobbywing(void)
         }
         // immediately push data to CAN bus
         canard_iface.processTx(true);
+        update_esc_latency(start_us);
     }
 }
 #endif // AP_DRONECAN_HOBBYWING_ESC_SUPPORT
@@ -1931,6 +1953,55 @@ bool AP_DroneCAN::prearm_check(char* fail_msg, uint8_t fail_msg_len) const
 /*
   periodic logging
  */
+/*
+  return the pool size we would like given the number of nodes seen
+  and the peak usage so far
+ */
+uint32_t AP_DroneCAN::recommended_pool_size()
+{
+    const uint32_t for_nodes = DRONECAN_POOL_AUTO_BASE + _dna_server.num_nodes_seen() * DRONECAN_POOL_AUTO_PER_NODE;
+    const uint32_t peak = canard_iface.pool_peak_bytes();
+    // keep a quarter of the pool spare above the peak
+    const uint32_t for_peak = peak + peak / 3;
+    const uint32_t size = ((MAX(for_nodes, for_peak) + 1023U) / 1024U) * 1024U;
+    return MIN(size, uint32_t(DRONECAN_POOL_AUTO_MAX));
+}
+
+/*
+  with the AutoPoolSize option raise the pool size parameter when the
+  bus needs more than we have. The pool can't be resized while running
+  so the new size applies at the next boot
+ */
+void AP_DroneCAN::check_pool_size(void)
+{
+    if (!option_is_set(Options::AUTO_POOL_SIZE)) {
+        return;
+    }
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - last_pool_check_ms < 5000) {
+        return;
+    }
+    last_pool_check_ms = now_ms;
+    const uint32_t size = recommended_pool_size();
+    if (size > uint32_t(_pool_size.get())) {
+        _pool_size.set_and_save(size);
+        GCS_SEND_TEXT(MAV_SEVERITY_INFO, "DroneCAN%u: pool size set to %u, reboot required", unsigned(_driver_index+1), unsigned(size));
+    }
+}
+
+/*
+  report pool usage for @SYS/can_stats.txt
+ */
+void AP_DroneCAN::pool_stats(ExpandingString &str)
+{
+    str.printf("DroneCAN%u: pool=%u recommended=%u nodes=%u\n",
+               unsigned(_driver_index+1),
+               unsigned(_pool_size.get()),
+               unsigned(recommended_pool_size()),
+               unsigned(_dna_server.num_nodes_seen()));
+    canard_iface.pool_stats(str);
+}
+
 void AP_DroneCAN::logging(void)
 {
 #if HAL_LOGGING_ENABLED
@@ -1954,6 +2025,17 @@ void AP_DroneCAN::logging(void)
     }
     const auto &s = *stats;
 
+    uint32_t esc_latency_mean_us = 0;
+    uint32_t esc_latency_max_us = 0;
+    {
+        WITH_SEMAPHORE(SRV_sem);
+        if (_esc_latency.count > 0) {
+            esc_latency_mean_us = _esc_latency.sum_us / _esc_latency.count;
+            esc_latency_max_us = _esc_latency.max_us;
+        }
+        _esc_latency = {};
+    }
+
 // @LoggerMessage: CANS
 // @Description: CAN Bus Statistics
 // @Field: TimeUS: Time since system startup
@@ -1971,11 +2053,13 @@ void AP_DroneCAN::logging(void)
 // @Field: Etx: ESC successful send count
 // @Field: Stx: Servo successful send count
 // @Field: Ftx: ESC/Servo failed-to-send count
+// @Field: ELat: mean time from starting to send ESC commands to them reaching the CAN driver
+// @Field: EMax: maximum time from starting to send ESC commands to them reaching the CAN driver
     AP::logger().WriteStreaming("CANS",
-                                "TimeUS,I,T,Trq,Trej,Tov,Tto,Tab,R,Rov,Rer,Bo,Etx,Stx,Ftx",
-                                "s#-------------",
-                                "F--------------",
-                                "QBIIIIIIIIIIIII",
+                                "TimeUS,I,T,Trq,Trej,Tov,Tto,Tab,R,Rov,Rer,Bo,Etx,Stx,Ftx,ELat,EMax",
+                                "s#-------------ss",
+                                "F--------------FF",
+                                "QBIIIIIIIIIIIIIII",
                                 AP_HAL::micros64(),
                                 _driver_index,
                                 s.tx_success,
@@ -1990,7 +2074,9 @@ void AP_DroneCAN::logging(void)
                                 s.num_busoff_err,
                                 _esc_send_count,
                                 _srv_send_count,
-                                _fail_send_count);
+                                _fail_send_count,
+                                esc_latency_mean_us,
+                                esc_latency_max_us);
 #endif // HAL_LOGGING_ENABLED
 }
 
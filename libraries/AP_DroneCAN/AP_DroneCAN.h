@@ -70,6 +70,11 @@
 #define AP_DRONECAN_VOLZ_FEEDBACK_ENABLED 0
 #endif
 
+// messages sent at once on bulk data streams to CAN-FD nodes
+#ifndef AP_DRONECAN_CANFD_BULK_MESSAGES
+#define AP_DRONECAN_CANFD_BULK_MESSAGES 8
+#endif
+
 #if AP_DRONECAN_SERIAL_ENABLED
 #include "AP_DroneCAN_serial.h"
 #endif
@@ -101,6 +106,9 @@ public:
     
     uint8_t get_driver_index() const { return _driver_index; }
 
+    // report pool usage for @SYS/can_stats.txt
+    void pool_stats(ExpandingString &str);
+
     // define string with length structure
     struct string { uint8_t len; uint8_t data[128]; };
 
@@ -151,6 +159,7 @@ public:
         USE_HOBBYWING_ESC         = (1U<<7),
         ENABLE_STATS              = (1U<<8),
         ENABLE_FLEX_DEBUG         = (1U<<9),
+        AUTO_POOL_SIZE            = (1U<<10),
     };
 
     // check if a option is set
@@ -164,6 +173,20 @@ public:
 
     CanardInterface& get_canard_iface() { return canard_iface; }
 
+    // return the number of messages a bulk data stream (RTCM, serial
+    // tunnels) may send to a node in one go. A CAN-FD frame carries
+    // eight times the data of a classic frame, so when we send CAN-FD
+    // and the node has shown it can too, more can be sent in the same
+    // bus time
+    uint8_t bulk_messages_per_send(uint8_t node_id) const {
+#if HAL_CANFD_SUPPORTED
+        if (option_is_set(Options::CANFD_ENABLED) && canard_iface.node_sent_canfd(node_id)) {
+            return AP_DRONECAN_CANFD_BULK_MESSAGES;
+        }
+#endif
+        return 1;
+    }
+
     Canard::Publisher<uavcan_equipment_indication_LightsCommand> rgb_led{canard_iface};
     Canard::Publisher<uavcan_equipment_indication_BeepCommand> buzzer{canard_iface};
     Canard::Publisher<uavcan_equipment_gnss_RTCMStream> rtcm_stream{canard_iface};
@@ -215,6 +238,13 @@ private:
 
     // periodic logging
     void logging();
+
+    // pool size wanted for the nodes seen and the peak usage so far
+    uint32_t recommended_pool_size();
+
+    // raise the pool size parameter if the AutoPoolSize option is set
+    void check_pool_size();
+    uint32_t last_pool_check_ms;
     
     // get parameter on a node
     ParamGetSetIntCb *param_int_cb;         // latest get param request callback function (for integers)
@@ -263,6 +293,14 @@ private:
     uint32_t _srv_send_count;
     uint32_t _fail_send_count;
 
+    // time from starting to send ESC commands to them being handed to the CAN driver
+    struct {
+        uint32_t sum_us;
+        uint32_t max_us;
+        uint32_t count;
+    } _esc_latency;
+    void update_esc_latency(uint32_t start_us);
+
     uint32_t _SRV_armed_mask; // mask of servo outputs that are active
     uint32_t _ESC_armed_mask; // mask of ESC outputs that are active
     uint32_t _SRV_last_send_us;
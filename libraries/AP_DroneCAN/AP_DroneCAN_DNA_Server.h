@@ -160,6 +160,9 @@ public:
 
     //Run through the list of seen node ids for verification
     void verify_nodes();
+
+    // number of nodes we have received NodeStatus from
+    uint8_t num_nodes_seen() const { return node_seen.count(); }
 };
 
 #endif
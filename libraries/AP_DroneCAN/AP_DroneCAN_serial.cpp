@@ -74,47 +74,65 @@ void AP_DroneCAN_Serial::update(void)
         if (p.writebuffer == nullptr || p.node <= 0 || p.idx < 0) {
             continue;
         }
-        uavcan_tunnel_Targetted pkt {};
-        uint32_t n = 0;
-        {
-            WITH_SEMAPHORE(p.sem);
-            uint32_t avail;
-            const bool send_keepalive = now_ms - p.last_send_ms > 500;
-            const auto *ptr = p.writebuffer->readptr(avail);
-            if (!send_keepalive && (ptr == nullptr || avail <= 0)) {
-                continue;
-            }
-            n = MIN(avail, sizeof(pkt.buffer.data));
-            pkt.target_node = p.node;
-            switch (p.state.protocol) {
-                case AP_SerialManager::SerialProtocol_MAVLink:
-                    pkt.protocol.protocol = UAVCAN_TUNNEL_PROTOCOL_MAVLINK;
-                    break;
-                case AP_SerialManager::SerialProtocol_MAVLink2:
-                    pkt.protocol.protocol = UAVCAN_TUNNEL_PROTOCOL_MAVLINK2;
-                    break;
-                case AP_SerialManager::SerialProtocol_GPS:
-                case AP_SerialManager::SerialProtocol_GPS2: // is not in SERIAL1_PROTOCOL option list, but could be entered by user
-                    pkt.protocol.protocol = UAVCAN_TUNNEL_PROTOCOL_GPS_GENERIC;
-                    break;
-                default:
-                    pkt.protocol.protocol = UAVCAN_TUNNEL_PROTOCOL_UNDEFINED;
-            }
-            pkt.buffer.len = n;
-            pkt.baudrate = p.baudrate;
-            pkt.serial_id = p.idx;
-            pkt.options = UAVCAN_TUNNEL_TARGETTED_OPTION_LOCK_PORT;
-            if (ptr != nullptr) {
-                memcpy(pkt.buffer.data, ptr, n);
+        // more can be sent at once to nodes using CAN-FD
+        const uint8_t max_packets = dronecan->bulk_messages_per_send(p.node);
+        for (uint8_t i=0; i<max_packets; i++) {
+            if (!send_packet(p, now_ms)) {
+                break;
             }
         }
-        if (targetted->broadcast(pkt)) {
-            WITH_SEMAPHORE(p.sem);
-            p.writebuffer->advance(n);
-            p.tx_stats_bytes += n;
-            p.last_send_ms = now_ms;
+    }
+}
+
+/*
+  send one tunnel packet from a port's write buffer, returns false if
+  there was nothing to send or the packet could not be queued
+*/
+bool AP_DroneCAN_Serial::send_packet(Port &p, uint32_t now_ms)
+{
+    uavcan_tunnel_Targetted pkt {};
+    uint32_t n = 0;
+    {
+        WITH_SEMAPHORE(p.sem);
+        uint32_t avail;
+        const bool send_keepalive = now_ms - p.last_send_ms > 500;
+        const auto *ptr = p.writebuffer->readptr(avail);
+        if (!send_keepalive && (ptr == nullptr || avail <= 0)) {
+            return false;
         }
+        n = MIN(avail, sizeof(pkt.buffer.data));
+        pkt.target_node = p.node;
+        switch (p.state.protocol) {
+            case AP_SerialManager::SerialProtocol_MAVLink:
+                pkt.protocol.protocol = UAVCAN_TUNNEL_PROTOCOL_MAVLINK;
+                break;
+            case AP_SerialManager::SerialProtocol_MAVLink2:
+                pkt.protocol.protocol = UAVCAN_TUNNEL_PROTOCOL_MAVLINK2;
+                break;
+            case AP_SerialManager::SerialProtocol_GPS:
+            case AP_SerialManager::SerialProtocol_GPS2: // is not in SERIAL1_PROTOCOL option list, but could be entered by user
+                pkt.protocol.protocol = UAVCAN_TUNNEL_PROTOCOL_GPS_GENERIC;
+                break;
+            default:
+                pkt.protocol.protocol = UAVCAN_TUNNEL_PROTOCOL_UNDEFINED;
+        }
+        pkt.buffer.len = n;
+        pkt.baudrate = p.baudrate;
+        pkt.serial_id = p.idx;
+        pkt.options = UAVCAN_TUNNEL_TARGETTED_OPTION_LOCK_PORT;
+        if (ptr != nullptr) {
+            memcpy(pkt.buffer.data, ptr, n);
+        }
+    }
+    if (!targetted->broadcast(pkt)) {
+        return false;
     }
+    WITH_SEMAPHORE(p.sem);
+    p.writebuffer->advance(n);
+    p.tx_stats_bytes += n;
+    p.last_send_ms = now_ms;
+    // a keepalive carries no data, and one is enough
+    return n > 0;
 }
 
 /*
@@ -81,6 +81,7 @@ private:
     AP_DroneCAN *dronecan;
 
     Canard::Publisher<uavcan_tunnel_Targetted> *targetted;
+    bool send_packet(Port &p, uint32_t now_ms);
     static void handle_tunnel_targetted(AP_DroneCAN *dronecan,
                                         const CanardRxTransfer& transfer,
                                         const uavcan_tunnel_Targetted &msg);
@@ -63,13 +63,12 @@ float AP_ESC_Telem::get_average_motor_rpm(uint32_t servo_channel_mask) const
     uint8_t valid_escs = 0;
 
     // average the rpm of each motor
-    for (uint8_t i = 0; i < ESC_TELEM_MAX_ESCS; i++) {
-        if (BIT_IS_SET(servo_channel_mask,i)) {
-            float rpm;
-            if (get_rpm(i, rpm)) {
-                rpm_avg += rpm;
-                valid_escs++;
-            }
+    for (uint32_t mask = servo_channel_mask & _rpm_seen_mask; mask != 0; mask &= mask - 1) {
+        const uint8_t i = __builtin_ctz(mask);
+        float rpm;
+        if (get_rpm(i, rpm)) {
+            rpm_avg += rpm;
+            valid_escs++;
         }
     }
 
@@ -85,8 +84,13 @@ uint8_t AP_ESC_Telem::get_motor_frequencies_hz(uint8_t nfreqs, float* freqs) con
 {
     uint8_t valid_escs = 0;
 
-    // average the rpm of each motor as reported by BLHeli and convert to Hz
-    for (uint8_t i = 0; i < ESC_TELEM_MAX_ESCS && valid_escs < nfreqs; i++) {
+    // average the rpm of each motor as reported by BLHeli and convert to Hz,
+    // visiting only the ESCs that have ever reported rpm, lowest index first
+    for (uint32_t mask = _rpm_seen_mask; mask != 0; mask &= mask - 1) {
+        const uint8_t i = __builtin_ctz(mask);
+        if (valid_escs >= nfreqs) {
+            break;
+        }
         float rpm;
         if (get_rpm(i, rpm)) {
             freqs[valid_escs++] = rpm * (1.0f / 60.0f);
@@ -104,11 +108,8 @@ uint8_t AP_ESC_Telem::get_motor_frequencies_hz(uint8_t nfreqs, float* freqs) con
 // ESC_TELEM_DATA_TIMEOUT_MS/ESC_RPM_DATA_TIMEOUT_US
 uint32_t AP_ESC_Telem::get_active_esc_mask() const {
     uint32_t ret = 0;
-    for (uint8_t i = 0; i < ESC_TELEM_MAX_ESCS; i++) {
-        if (_telem_data[i].last_update_ms == 0 && !was_rpm_data_ever_reported(_rpm_data[i])) {
-            // have never seen telem from this ESC
-            continue;
-        }
+    for (uint32_t mask = seen_esc_mask(); mask != 0; mask &= mask - 1) {
+        const uint8_t i = __builtin_ctz(mask);
         if (_telem_data[i].stale() && !_rpm_data[i].data_valid) {
             continue;
         }
@@ -122,11 +123,8 @@ uint8_t AP_ESC_Telem::get_max_rpm_esc() const
 {
     uint32_t ret = 0;
     float max_rpm = 0;
-    for (uint8_t i = 0; i < ESC_TELEM_MAX_ESCS; i++) {
-        if (_telem_data[i].last_update_ms == 0 && !was_rpm_data_ever_reported(_rpm_data[i])) {
-            // have never seen telem from this ESC
-            continue;
-        }
+    for (uint32_t mask = seen_esc_mask(); mask != 0; mask &= mask - 1) {
+        const uint8_t i = __builtin_ctz(mask);
         if (_telem_data[i].stale() && !_rpm_data[i].data_valid) {
             continue;
         }
@@ -169,15 +167,11 @@ bool AP_ESC_Telem::are_motors_running(uint32_t servo_channel_mask, float min_rpm
 // is telemetry active for the provided channel mask
 bool AP_ESC_Telem::is_telemetry_active(uint32_t servo_channel_mask) const
 {
-    for (uint8_t i = 0; i < ESC_TELEM_MAX_ESCS; i++) {
-        if (BIT_IS_SET(servo_channel_mask, i)) {
-            // no data received
-            if (get_last_telem_data_ms(i) == 0 && !was_rpm_data_ever_reported(_rpm_data[i])) {
-                return false;
-            }
-        }
-    }
-    return true;
+#if ESC_TELEM_MAX_ESCS < 32
+    servo_channel_mask &= (1U << ESC_TELEM_MAX_ESCS) - 1;
+#endif
+    // false if no data has ever been received from one of the ESCs
+    return (servo_channel_mask & ~seen_esc_mask()) == 0;
 }
 
 // get an individual ESC's slewed rpm if available, returns true on success
@@ -261,7 +255,8 @@ bool AP_ESC_Telem::get_highest_temperature(int16_t& temp) const
 {
     uint8_t valid_escs = 0;
 
-    for (uint8_t i = 0; i < ESC_TELEM_MAX_ESCS; i++) {
+    for (uint32_t mask = _telem_seen_mask; mask != 0; mask &= mask - 1) {
+        const uint8_t i = __builtin_ctz(mask);
         int16_t temp_temp;
         if (get_temperature(i, temp_temp)) {
             temp = MAX(temp, temp_temp);
@@ -520,6 +515,7 @@ void AP_ESC_Telem::update_telem_data(const uint8_t esc_index, const AP_ESC_Telem
     }
 
     _have_data = true;
+    _telem_seen_mask |= 1U << esc_index;
     volatile AP_ESC_Telem_Backend::TelemetryData &telemdata = _telem_data[esc_index];
 
 #if AP_TEMPERATURE_SENSOR_ENABLED
@@ -592,6 +588,7 @@ void AP_ESC_Telem::update_rpm(const uint8_t esc_index, const float new_rpm, cons
     }
 
     _have_data = true;
+    _rpm_seen_mask |= 1U << esc_index;
 
     const uint32_t now = MAX(1U ,AP_HAL::micros()); // don't allow a value of 0 in, as we use this as a flag in places
     volatile AP_ESC_Telem_Backend::RpmData& rpmdata = _rpm_data[esc_index];
@@ -672,7 +669,8 @@ void AP_ESC_Telem::update()
     AP_Logger *logger = AP_Logger::get_singleton();
     const uint64_t now_us64 = AP_HAL::micros64();
 
-    for (uint8_t i = 0; i < ESC_TELEM_MAX_ESCS; i++) {
+    for (uint32_t mask = seen_esc_mask(); mask != 0; mask &= mask - 1) {
+        const uint8_t i = __builtin_ctz(mask);
         const volatile AP_ESC_Telem_Backend::RpmData &rpmdata = _rpm_data[i];
         volatile AP_ESC_Telem_Backend::TelemetryData &telemdata = _telem_data[i];
         // Push received telemetry data into the logging system
@@ -796,7 +794,8 @@ void AP_ESC_Telem::update()
     }
 #endif  // HAL_LOGGING_ENABLED
 
-    for (uint8_t i = 0; i < ESC_TELEM_MAX_ESCS; i++) {
+    for (uint32_t mask = seen_esc_mask(); mask != 0; mask &= mask - 1) {
+        const uint8_t i = __builtin_ctz(mask);
         // copy the last_updated_us timestamp to avoid any race issues
         const uint32_t last_updated_us = _rpm_data[i].last_update_us;
         const uint32_t now_us = AP_HAL::micros();
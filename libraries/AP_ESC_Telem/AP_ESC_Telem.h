@@ -148,6 +148,14 @@ private:
     // telemetry data
     volatile AP_ESC_Telem_Backend::TelemetryData _telem_data[ESC_TELEM_MAX_ESCS];
 
+    // masks of the ESCs that have ever reported telemetry and rpm data,
+    // consumers only visit these ESCs rather than every slot. A bit lost
+    // to a concurrent update from another backend is set again on that
+    // backend's next update
+    uint32_t _telem_seen_mask;
+    uint32_t _rpm_seen_mask;
+    uint32_t seen_esc_mask() const { return _telem_seen_mask | _rpm_seen_mask; }
+
     uint32_t _last_telem_log_ms[ESC_TELEM_MAX_ESCS];
     uint32_t _last_rpm_log_us[ESC_TELEM_MAX_ESCS];
     uint8_t next_idx;
@@ -113,13 +113,20 @@ void AP_ExternalAHRS_MicroStrain7::build_packet()
 
     WITH_SEMAPHORE(sem);
     uint32_t nbytes = MIN(uart->available(), 2048u);
-    while (nbytes--> 0) {
-        uint8_t b;
-        if (!uart->read(b)) {
+    while (nbytes > 0) {
+        // read in chunks rather than a byte at a time to save the
+        // UART driver overhead per byte at high packet rates
+        uint8_t buf[64];
+        const ssize_t nread = uart->read(buf, MIN(nbytes, sizeof(buf)));
+        if (nread <= 0) {
             break;
         }
-        DescriptorSet descriptor;
-        if (handle_byte(b, descriptor)) {
+        nbytes -= nread;
+        for (ssize_t i = 0; i < nread; i++) {
+            DescriptorSet descriptor;
+            if (!handle_byte(buf[i], descriptor)) {
+                continue;
+            }
             switch (descriptor) {
             case DescriptorSet::IMUData:
                 post_imu();
@@ -202,7 +202,9 @@ AP_ExternalAHRS_VectorNav::AP_ExternalAHRS_VectorNav(AP_ExternalAHRS *_frontend,
 }
 
 /*
-  check the UART for more data
+  check the UART for more data, then decode every complete packet in
+  the buffer in place before moving any partial packet down to the
+  start of the buffer
   returns true if the function should be called again straight away
  */
 #define SYNC_BYTE 0xFA
@@ -211,7 +213,6 @@ bool AP_ExternalAHRS_VectorNav::check_uart()
     if (!setup_complete) {
         return false;
     }
-    WITH_SEMAPHORE(state.sem);
     // ensure we own the uart
     uart->begin(0);
     uint32_t n = uart->available();
@@ -226,74 +227,70 @@ bool AP_ExternalAHRS_VectorNav::check_uart()
         pktoffset += nread;
     }
 
-    bool match_header1 = false;
-    bool match_header2 = false;
-    bool match_header3 = false;
-    bool match_header4 = false;
-
-    if (pktbuf[0] != SYNC_BYTE) {
-        goto reset;
-    }
-
-
-    match_header1 = (0 == memcmp(&pktbuf[1], VN_IMU_packet::header,  MIN(sizeof(VN_IMU_packet::header), unsigned(pktoffset - 1))));
-    if (type == TYPE::VN_AHRS) {
-        match_header2 = (0 == memcmp(&pktbuf[1], VN_AHRS_ekf_packet::header, MIN(sizeof(VN_AHRS_ekf_packet::header), unsigned(pktoffset - 1))));
-    } else {
-        match_header3 = (0 == memcmp(&pktbuf[1], VN_INS_ekf_packet::header,  MIN(sizeof(VN_INS_ekf_packet::header), unsigned(pktoffset - 1))));
-        match_header4 = (0 == memcmp(&pktbuf[1], VN_INS_gnss_packet::header, MIN(sizeof(VN_INS_gnss_packet::header), unsigned(pktoffset - 1))));
-    }
-    if (!match_header1 && !match_header2 && !match_header3 && !match_header4) {
-        goto reset;
-    }
-
-    if (match_header1 && pktoffset >= VN_IMU_LENGTH) {
-        uint16_t crc = crc16_ccitt(&pktbuf[1], VN_IMU_LENGTH - 1, 0);
-        if (crc == 0) {
-            process_imu_packet(&pktbuf[sizeof(VN_IMU_packet::header) + 1]);
-            memmove(&pktbuf[0], &pktbuf[VN_IMU_LENGTH], pktoffset - VN_IMU_LENGTH);
-            pktoffset -= VN_IMU_LENGTH;
-        } else {
-            goto reset;
-        }
-    } else if (match_header2 && pktoffset >= VN_AHRS_EKF_LENGTH) {
-        uint16_t crc = crc16_ccitt(&pktbuf[1], VN_AHRS_EKF_LENGTH - 1, 0);
-        if (crc == 0) {
-            process_ahrs_ekf_packet(&pktbuf[sizeof(VN_AHRS_ekf_packet::header) + 1]);
-            memmove(&pktbuf[0], &pktbuf[VN_AHRS_EKF_LENGTH], pktoffset - VN_AHRS_EKF_LENGTH);
-            pktoffset -= VN_AHRS_EKF_LENGTH;
-        } else {
-            goto reset;
-        }
-    } else if (match_header3 && pktoffset >= VN_INS_EKF_LENGTH) {
-        uint16_t crc = crc16_ccitt(&pktbuf[1], VN_INS_EKF_LENGTH - 1, 0);
-        if (crc == 0) {
-            process_ins_ekf_packet(&pktbuf[sizeof(VN_INS_ekf_packet::header) + 1]);
-            memmove(&pktbuf[0], &pktbuf[VN_INS_EKF_LENGTH], pktoffset - VN_INS_EKF_LENGTH);
-            pktoffset -= VN_INS_EKF_LENGTH;
-        } else {
-            goto reset;
+    uint16_t start = 0;
+    while (start < pktoffset) {
+        const uint8_t *p = &pktbuf[start];
+        const uint16_t len = pktoffset - start;
+        // which packet type is complete in the buffer, 0 for none
+        uint8_t match = 0;
+        uint16_t pkt_len = 0;
+
+        if (p[0] == SYNC_BYTE) {
+            const bool match_header1 = (0 == memcmp(&p[1], VN_IMU_packet::header, MIN(sizeof(VN_IMU_packet::header), unsigned(len - 1))));
+            bool match_header2 = false;
+            bool match_header3 = false;
+            bool match_header4 = false;
+            if (type == TYPE::VN_AHRS) {
+                match_header2 = (0 == memcmp(&p[1], VN_AHRS_ekf_packet::header, MIN(sizeof(VN_AHRS_ekf_packet::header), unsigned(len - 1))));
+            } else {
+                match_header3 = (0 == memcmp(&p[1], VN_INS_ekf_packet::header,  MIN(sizeof(VN_INS_ekf_packet::header), unsigned(len - 1))));
+                match_header4 = (0 == memcmp(&p[1], VN_INS_gnss_packet::header, MIN(sizeof(VN_INS_gnss_packet::header), unsigned(len - 1))));
+            }
+            if (match_header1 && len >= VN_IMU_LENGTH) {
+                match = 1;
+                pkt_len = VN_IMU_LENGTH;
+            } else if (match_header2 && len >= VN_AHRS_EKF_LENGTH) {
+                match = 2;
+                pkt_len = VN_AHRS_EKF_LENGTH;
+            } else if (match_header3 && len >= VN_INS_EKF_LENGTH) {
+                match = 3;
+                pkt_len = VN_INS_EKF_LENGTH;
+            } else if (match_header4 && len >= VN_INS_GNSS_LENGTH) {
+                match = 4;
+                pkt_len = VN_INS_GNSS_LENGTH;
+            } else if (match_header1 || match_header2 || match_header3 || match_header4) {
+                // wait for the rest of the packet
+                break;
+            }
         }
-    } else if (match_header4 && pktoffset >= VN_INS_GNSS_LENGTH) {
-        uint16_t crc = crc16_ccitt(&pktbuf[1], VN_INS_GNSS_LENGTH - 1, 0);
-        if (crc == 0) {
-            process_ins_gnss_packet(&pktbuf[sizeof(VN_INS_gnss_packet::header) + 1]);
-            memmove(&pktbuf[0], &pktbuf[VN_INS_GNSS_LENGTH], pktoffset - VN_INS_GNSS_LENGTH);
-            pktoffset -= VN_INS_GNSS_LENGTH;
-        } else {
-            goto reset;
+
+        if (match != 0 && crc16_ccitt(&p[1], pkt_len - 1, 0) == 0) {
+            switch (match) {
+            case 1:
+                process_imu_packet(&p[sizeof(VN_IMU_packet::header) + 1]);
+                break;
+            case 2:
+                process_ahrs_ekf_packet(&p[sizeof(VN_AHRS_ekf_packet::header) + 1]);
+                break;
+            case 3:
+                process_ins_ekf_packet(&p[sizeof(VN_INS_ekf_packet::header) + 1]);
+                break;
+            case 4:
+                process_ins_gnss_packet(&p[sizeof(VN_INS_gnss_packet::header) + 1]);
+                break;
+            }
+            start += pkt_len;
+            continue;
         }
+
+        // not a packet, or a bad CRC: resync on the next sync byte
+        const uint8_t *sync = (const uint8_t *)memchr(&p[1], SYNC_BYTE, len-1);
+        start = sync != nullptr ? sync - pktbuf : pktoffset;
     }
-    return true;
 
-reset:
-    uint8_t *p = (uint8_t *)memchr(&pktbuf[1], SYNC_BYTE, pktoffset-1);
-    if (p) {
-        uint8_t newlen = pktoffset - (p - pktbuf);
-        memmove(&pktbuf[0], p, newlen);
-        pktoffset = newlen;
-    } else {
-        pktoffset = 0;
+    if (start > 0) {
+        memmove(&pktbuf[0], &pktbuf[start], pktoffset - start);
+        pktoffset -= start;
     }
     return true;
 }
@@ -606,8 +603,11 @@ void AP_ExternalAHRS_VectorNav::process_ahrs_ekf_packet(const uint8_t *b) {
 
     last_pkt2_ms = AP_HAL::millis();
 
-    state.quat = Quaternion{pkt.quaternion[3], pkt.quaternion[0], pkt.quaternion[1], pkt.quaternion[2]};
-    state.have_quaternion = true;
+    {
+        WITH_SEMAPHORE(state.sem);
+        state.quat = Quaternion{pkt.quaternion[3], pkt.quaternion[0], pkt.quaternion[1], pkt.quaternion[2]};
+        state.have_quaternion = true;
+    }
 
 #if HAL_LOGGING_ENABLED
     VNAT data_to_log;
@@ -625,17 +625,21 @@ void AP_ExternalAHRS_VectorNav::process_ins_ekf_packet(const uint8_t *b) {
     const struct VN_INS_ekf_packet &pkt = *(struct VN_INS_ekf_packet *)b;
 
     last_pkt2_ms          = AP_HAL::millis();
-    *latest_ins_ekf_packet = pkt;
 
-    state.quat = Quaternion{pkt.quaternion[3], pkt.quaternion[0], pkt.quaternion[1], pkt.quaternion[2]};
-    state.have_quaternion = true;
+    {
+        // publish the whole solution at once
+        WITH_SEMAPHORE(state.sem);
+        *latest_ins_ekf_packet = pkt;
+        state.quat = Quaternion{pkt.quaternion[3], pkt.quaternion[0], pkt.quaternion[1], pkt.quaternion[2]};
+        state.have_quaternion = true;
 
-    state.velocity      = Vector3f{pkt.velNed[0], pkt.velNed[1], pkt.velNed[2]};
-    state.have_velocity = true;
+        state.velocity      = Vector3f{pkt.velNed[0], pkt.velNed[1], pkt.velNed[2]};
+        state.have_velocity = true;
 
-    state.location = Location{int32_t(pkt.posLla[0] * 1.0e7), int32_t(pkt.posLla[1] * 1.0e7), int32_t(pkt.posLla[2] * 1.0e2), Location::AltFrame::ABSOLUTE};
-    state.last_location_update_us = AP_HAL::micros();
-    state.have_location           = true;
+        state.location = Location{int32_t(pkt.posLla[0] * 1.0e7), int32_t(pkt.posLla[1] * 1.0e7), int32_t(pkt.posLla[2] * 1.0e2), Location::AltFrame::ABSOLUTE};
+        state.last_location_update_us = AP_HAL::micros();
+        state.have_location           = true;
+    }
 
 #if HAL_LOGGING_ENABLED
     VNAT data_to_log;
@@ -678,8 +682,11 @@ void AP_ExternalAHRS_VectorNav::process_ins_gnss_packet(const uint8_t *b) {
 
 
     last_pkt3_ms          = AP_HAL::millis();
-    *latest_ins_gnss_packet = pkt;
-    
+    {
+        WITH_SEMAPHORE(state.sem);
+        *latest_ins_gnss_packet = pkt;
+    }
+
     // get ToW in milliseconds
     gps.gps_week           = pkt.timeGps / (AP_MSEC_PER_WEEK * 1000000ULL);
     gps.ms_tow             = (pkt.timeGps / 1000000ULL) % (60 * 60 * 24 * 7 * 1000ULL);
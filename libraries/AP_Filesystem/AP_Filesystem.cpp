@@ -294,6 +294,31 @@ uint32_t AP_Filesystem::bytes_until_fsync(int fd)
     return backend.fs.bytes_until_fsync(fd);
 }
 
+void AP_Filesystem::set_high_priority(int fd)
+{
+    const Backend &backend = backend_by_fd(fd);
+    backend.fs.set_high_priority(fd);
+}
+
+bool AP_Filesystem::preallocate(int fd, uint32_t size)
+{
+    const Backend &backend = backend_by_fd(fd);
+    return backend.fs.preallocate(fd, size);
+}
+
+const void *AP_Filesystem::mmap(int fd, uint32_t length)
+{
+    const Backend &backend = backend_by_fd(fd);
+    return backend.fs.mmap(fd, length);
+}
+
+void AP_Filesystem::munmap(int fd, const void *addr, uint32_t length)
+{
+    // fd may have been closed, it is only used to find the backend
+    const Backend &backend = backend_by_fd(fd);
+    backend.fs.munmap(addr, length);
+}
+
 // return free disk space in bytes
 int64_t AP_Filesystem::disk_free(const char *path)
 {
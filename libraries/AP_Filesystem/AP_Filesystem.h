@@ -114,6 +114,25 @@ public:
     // streaming performance/robustness. if zero, any number can be written.
     uint32_t bytes_until_fsync(int fd);
 
+    // mark an open file as high priority. On backends where several
+    // users share one storage device, operations on it are serviced
+    // ahead of other files and long transfers of other files are
+    // broken up so they can't delay it
+    void set_high_priority(int fd);
+
+    // find space for an empty file to grow to size bytes in one
+    // contiguous area, returning false if the backend doesn't
+    // support it or there is no such area. The file size is not
+    // changed
+    bool preallocate(int fd, uint32_t size);
+
+    // map the first length bytes of an open file into memory for
+    // reading. Returns nullptr if the backend does not support it. The
+    // mapping stays valid after the file is closed, until munmap() is
+    // called with the same fd, length and the returned address
+    const void *mmap(int fd, uint32_t length);
+    void munmap(int fd, const void *addr, uint32_t length);
+
     // return free disk space in bytes, -1 on error
     int64_t disk_free(const char *path);
 
@@ -42,10 +42,13 @@ static HAL_Semaphore sem;
 typedef struct {
     FIL fobj; // should be first member; it's the most used
     char *name;
+    bool high_priority;
+    uint16_t id; // distinguishes files which have had the same fd
 } FAT_FILE;
 
 #define MAX_FILES 16
 static FAT_FILE *file_table[MAX_FILES];
+static uint16_t next_file_id;
 
 /*
   allocate a file descriptor
@@ -69,6 +72,7 @@ static int new_file_descriptor(const char *pathname, FIL * &fh)
                 return -1;
             }
 
+            stream->id = ++next_file_id;
             file_table[i]  = stream;
             fh = &stream->fobj;
             return i;
@@ -116,6 +120,95 @@ static FIL *fileno_to_fatfs(int fileno)
     return &stream->fobj;
 }
 
+/*
+  lookup a file handle again after the filesystem lock has been given
+  up, returning nullptr if fileno was closed meanwhile, including when
+  another file has since been opened with the same fileno
+ */
+static FIL *fileno_to_fatfs(int fileno, uint16_t id)
+{
+    FAT_FILE *stream = fileno_to_stream(fileno);
+    if (stream == nullptr) {
+        return nullptr; // errno already set
+    }
+    if (stream->id != id) {
+        errno = EBADF;
+        return nullptr;
+    }
+    return &stream->fobj;
+}
+
+/*
+  operations on files marked high priority (the log being written)
+  are given the filesystem ahead of everyone else. An operation on any
+  other file or path first waits a short time for pending high
+  priority operations to get the semaphore, and long reads and writes
+  of other files give it up between chunks, so a terrain or FTP
+  transfer can't hold off log writes for long. The wait is bounded so
+  a low priority thread that already holds the (recursive) semaphore
+  can't deadlock, and is skipped in the main thread so the main loop
+  is never delayed by it.
+  Only the logger thread does high priority operations, so the
+  pending count has a single writer
+ */
+#define LOW_PRIORITY_MAX_WAIT_US 20000
+static volatile uint8_t high_priority_pending;
+
+static bool fd_high_priority(int fileno)
+{
+    if (fileno < 0 || fileno >= MAX_FILES) {
+        return false;
+    }
+    const FAT_FILE *stream = file_table[fileno];
+    return stream != nullptr && stream->high_priority;
+}
+
+class FSLock {
+public:
+    FSLock(bool _high_priority) :
+        high_priority(_high_priority) {
+        take();
+    }
+    ~FSLock() {
+        sem.give();
+    }
+
+    // let pending high priority operations run between chunks of a
+    // low priority transfer. Returns true if the lock was given up, in
+    // which case any file handle must be looked up again
+    bool yield() {
+        if (!high_priority && high_priority_pending != 0) {
+            sem.give();
+            take();
+            return true;
+        }
+        return false;
+    }
+
+private:
+    void take();
+
+    const bool high_priority;
+};
+
+void FSLock::take()
+{
+    if (high_priority) {
+        high_priority_pending++;
+        sem.take_blocking();
+        high_priority_pending--;
+        return;
+    }
+    if (!hal.scheduler->in_main_thread()) {
+        const uint32_t start_us = AP_HAL::micros();
+        while (high_priority_pending != 0 &&
+               AP_HAL::micros() - start_us < LOW_PRIORITY_MAX_WAIT_US) {
+            hal.scheduler->delay_microseconds(200);
+        }
+    }
+    sem.take_blocking();
+}
+
 static int fatfs_to_errno(FRESULT Result)
 {
     switch (Result) {
@@ -235,7 +328,7 @@ int AP_Filesystem_FATFS::open(const char *pathname, int flags, bool allow_absolu
     int res;
 
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     CHECK_REMOUNT();
 
@@ -298,7 +391,7 @@ int AP_Filesystem_FATFS::close(int fileno)
     int res;
 
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(fd_high_priority(fileno));
 
     errno = 0;
 
@@ -322,7 +415,7 @@ int32_t AP_Filesystem_FATFS::read(int fd, void *buf, uint32_t count)
     FIL *fh;
 
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(fd_high_priority(fd));
 
     CHECK_REMOUNT();
 
@@ -337,13 +430,22 @@ int32_t AP_Filesystem_FATFS::read(int fd, void *buf, uint32_t count)
         return -1; // errno already set
     }
 
+    const bool high_priority = fd_high_priority(fd);
+    const uint16_t file_id = fileno_to_stream(fd)->id;
     UINT total = 0;
     do {
         UINT size = 0;
         UINT n = bytes;
-        if (!mem_is_dma_safe(buf, count, true)) {
+        if (!high_priority || !mem_is_dma_safe(buf, count, true)) {
             n = MIN(bytes, MAX_IO_SIZE);
         }
+        if (total != 0 && lock.yield()) {
+            fh = fileno_to_fatfs(fd, file_id);
+            if (fh == nullptr) {
+                // closed by another thread while we yielded
+                return (ssize_t)total;
+            }
+        }
         res = f_read(fh, (void *)buf, n, &size);
         if (res != FR_OK) {
             errno = fatfs_to_errno((FRESULT)res);
@@ -374,7 +476,7 @@ int32_t AP_Filesystem_FATFS::write(int fd, const void *buf, uint32_t count)
     errno = 0;
 
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(fd_high_priority(fd));
 
     CHECK_REMOUNT();
 
@@ -383,12 +485,21 @@ int32_t AP_Filesystem_FATFS::write(int fd, const void *buf, uint32_t count)
         return -1; // errno already set
     }
 
+    const bool high_priority = fd_high_priority(fd);
+    const uint16_t file_id = fileno_to_stream(fd)->id;
     UINT total = 0;
     do {
         UINT n = bytes;
-        if (!mem_is_dma_safe(buf, count, true)) {
+        if (!high_priority || !mem_is_dma_safe(buf, count, true)) {
             n = MIN(bytes, MAX_IO_SIZE);
         }
+        if (total != 0 && lock.yield()) {
+            fh = fileno_to_fatfs(fd, file_id);
+            if (fh == nullptr) {
+                // closed by another thread while we yielded
+                return (ssize_t)total;
+            }
+        }
         UINT size = 0;
         res = f_write(fh, buf, n, &size);
         if (res == FR_DISK_ERR && RETRY_ALLOWED()) {
@@ -422,7 +533,7 @@ int AP_Filesystem_FATFS::fsync(int fileno)
     int res;
 
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(fd_high_priority(fileno));
 
     errno = 0;
 
@@ -445,7 +556,7 @@ off_t AP_Filesystem_FATFS::lseek(int fileno, off_t position, int whence)
     errno = 0;
 
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(fd_high_priority(fileno));
 
     fh = fileno_to_fatfs(fileno);
     if (fh == nullptr) { // unknown fileno?
@@ -491,7 +602,7 @@ int AP_Filesystem_FATFS::stat(const char *name, struct stat *buf)
     uint16_t mode;
 
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     CHECK_REMOUNT();
 
@@ -555,7 +666,7 @@ int AP_Filesystem_FATFS::stat(const char *name, struct stat *buf)
 int AP_Filesystem_FATFS::unlink(const char *pathname)
 {
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     errno = 0;
     int res = f_unlink(pathname);
@@ -569,7 +680,7 @@ int AP_Filesystem_FATFS::unlink(const char *pathname)
 int AP_Filesystem_FATFS::mkdir(const char *pathname)
 {
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     errno = 0;
 
@@ -585,7 +696,7 @@ int AP_Filesystem_FATFS::mkdir(const char *pathname)
 int AP_Filesystem_FATFS::rename(const char *oldpath, const char *newpath)
 {
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     errno = 0;
 
@@ -609,7 +720,7 @@ struct DIR_Wrapper {
 void *AP_Filesystem_FATFS::opendir(const char *pathdir)
 {
     FS_CHECK_ALLOWED(nullptr);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     CHECK_REMOUNT_NULL();
 
@@ -637,7 +748,7 @@ void *AP_Filesystem_FATFS::opendir(const char *pathdir)
 struct dirent *AP_Filesystem_FATFS::readdir(void *dirp_void)
 {
     FS_CHECK_ALLOWED(nullptr);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
     DIR *dirp = (DIR *)dirp_void;
 
     struct DIR_Wrapper *d = (struct DIR_Wrapper *)dirp;
@@ -670,7 +781,7 @@ int AP_Filesystem_FATFS::closedir(void *dirp_void)
 {
     DIR *dirp = (DIR *)dirp_void;
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     struct DIR_Wrapper *d = (struct DIR_Wrapper *)dirp;
     if (!d) {
@@ -690,10 +801,48 @@ int AP_Filesystem_FATFS::closedir(void *dirp_void)
 // return number of bytes that should be written before fsync for optimal
 // streaming performance/robustness. if zero, any number can be written.
 // assume similar to old logging code that max-IO-size boundaries are good.
+/*
+  mark an open file as high priority, giving its operations the
+  filesystem ahead of operations on other files
+ */
+void AP_Filesystem_FATFS::set_high_priority(int fd)
+{
+    FS_CHECK_ALLOWED();
+    FSLock lock(false);
+
+    FAT_FILE *stream = fileno_to_stream(fd);
+    if (stream != nullptr) {
+        stream->high_priority = true;
+    }
+}
+
+/*
+  find a contiguous free area of size bytes for an empty file, so
+  appends up to that size don't need to search the FAT for free
+  clusters and the card sees one long sequential write
+ */
+bool AP_Filesystem_FATFS::preallocate(int fd, uint32_t size)
+{
+#if FF_USE_EXPAND
+    FS_CHECK_ALLOWED(false);
+    FSLock lock(fd_high_priority(fd));
+
+    FIL *fh = fileno_to_fatfs(fd);
+    if (fh == nullptr) {
+        return false;
+    }
+    // option 0 only reserves the area as the start of the next
+    // allocation, so the file size stays zero
+    return f_expand(fh, size, 0) == FR_OK;
+#else
+    return false;
+#endif
+}
+
 uint32_t AP_Filesystem_FATFS::bytes_until_fsync(int fd)
 {
     FS_CHECK_ALLOWED(0);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(fd_high_priority(fd));
 
     FIL *fh = fileno_to_fatfs(fd);
     if (fh == nullptr) { // unknown fd?
@@ -710,7 +859,7 @@ uint32_t AP_Filesystem_FATFS::bytes_until_fsync(int fd)
 int64_t AP_Filesystem_FATFS::disk_free(const char *path)
 {
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     FATFS *fs;
     DWORD fre_clust, fre_sect;
@@ -732,7 +881,7 @@ int64_t AP_Filesystem_FATFS::disk_free(const char *path)
 int64_t AP_Filesystem_FATFS::disk_space(const char *path)
 {
     FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     CHECK_REMOUNT();
 
@@ -782,7 +931,7 @@ bool AP_Filesystem_FATFS::set_mtime(const char *filename, const uint32_t mtime_s
     fno.ftime = ftime;
 
     FS_CHECK_ALLOWED(false);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
 
     return f_utime(filename, (FILINFO *)&fno) == FR_OK;
 }
@@ -793,7 +942,7 @@ bool AP_Filesystem_FATFS::set_mtime(const char *filename, const uint32_t mtime_s
 bool AP_Filesystem_FATFS::retry_mount(void)
 {
     FS_CHECK_ALLOWED(false);
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
     return sdcard_retry();
 }
 
@@ -802,7 +951,7 @@ bool AP_Filesystem_FATFS::retry_mount(void)
 */
 void AP_Filesystem_FATFS::unmount(void)
 {
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
     return sdcard_stop();
 }
 
@@ -812,7 +961,7 @@ void AP_Filesystem_FATFS::unmount(void)
 bool AP_Filesystem_FATFS::format(void)
 {
 #if FF_USE_MKFS
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
     hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&AP_Filesystem_FATFS::format_handler, void));
     // the format is handled asynchronously, we inform user of success
     // via a text message.  format_status can be polled for progress
@@ -832,7 +981,7 @@ void AP_Filesystem_FATFS::format_handler(void)
     if (format_status != FormatStatus::PENDING) {
         return;
     }
-    WITH_SEMAPHORE(sem);
+    FSLock lock(false);
     format_status = FormatStatus::IN_PROGRESS;
     GCS_SEND_TEXT(MAV_SEVERITY_NOTICE, "Formatting SDCard");
     uint8_t *buf = (uint8_t *)hal.util->malloc_type(FF_MAX_SS, AP_HAL::Util::MEM_DMA_SAFE);
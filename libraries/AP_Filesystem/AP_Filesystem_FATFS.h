@@ -38,6 +38,10 @@ public:
 
     uint32_t bytes_until_fsync(int fd) override;
 
+    void set_high_priority(int fd) override;
+
+    bool preallocate(int fd, uint32_t size) override;
+
     // return free disk space in bytes, -1 on error
     int64_t disk_free(const char *path) override;
 
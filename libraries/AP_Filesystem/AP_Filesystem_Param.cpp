@@ -24,9 +24,11 @@
 #include "AP_Filesystem_Param.h"
 #include <AP_Param/AP_Param.h>
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
 #include <ctype.h>
 
 #define PACKED_NAME "param.pck"
+#define CRC_NAME "param.crc"
 
 extern const AP_HAL::HAL& hal;
 
@@ -53,7 +55,16 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
         return -1;
     }
     struct rfile &r = file[idx];
-    if (read_only) {
+    const bool crc_file = is_crc_file(fname);
+    if (crc_file && !read_only) {
+        errno = EROFS;
+        return -1;
+    }
+    r.cursors = nullptr;
+    r.block_crcs = nullptr;
+    r.block_size = default_crc_block_size;
+    r.num_blocks = 0;
+    if (read_only && !crc_file) {
         r.cursors = NEW_NOTHROW cursor[num_cursors];
         if (r.cursors == nullptr) {
             errno = ENOMEM;
@@ -116,12 +127,29 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
             continue;
         }
 #endif
+        if (crc_file && strncmp(c, "blocksize=", 10) == 0) {
+            uint32_t v = strtoul(c+10, nullptr, 10);
+            if (v == 0 || v >= UINT16_MAX) {
+                goto failed;
+            }
+            r.block_size = v;
+            c += 10;
+            c = strchr(c, '&');
+            continue;
+        }
+    }
+
+    if (crc_file && !calculate_block_crcs(r)) {
+        r.open = false;
+        errno = ENOMEM;
+        return -1;
     }
 
     return idx;
 
 failed:
     delete [] r.cursors;
+    r.cursors = nullptr;
     r.open = false;
     errno = EINVAL;
     return -1;
@@ -144,9 +172,79 @@ int AP_Filesystem_Param::close(int fd)
     r.cursors = nullptr;
     delete r.writebuf;
     r.writebuf = nullptr;
+    delete [] r.block_crcs;
+    r.block_crcs = nullptr;
     return ret;
 }
 
+/*
+  param.crc format:
+    file header:
+      uint16_t magic = 0x671d
+      uint16_t block_size
+      uint16_t total_params
+
+    followed by one uint32_t per block of block_size parameters, in
+    the same order as param.pck.  Each is the crc_crc32() with a seed
+    of zero over the full name, the type byte and the value bytes of
+    each parameter in the block.  A GCS with a cached parameter set
+    compares these against its own and fetches changed blocks with
+    param.pck?start=N&count=block_size
+ */
+bool AP_Filesystem_Param::calculate_block_crcs(struct rfile &r)
+{
+    const uint16_t total_params = AP_Param::count_parameters();
+    r.num_blocks = (total_params + r.block_size - 1) / r.block_size;
+    r.block_crcs = NEW_NOTHROW uint32_t[MAX(r.num_blocks, 1U)];
+    if (r.block_crcs == nullptr) {
+        return false;
+    }
+    // memory from NEW_NOTHROW is zeroed, which is our crc seed
+
+    AP_Param::ParamToken token;
+    enum ap_var_type ptype;
+    uint32_t idx = 0;
+    for (AP_Param *ap = AP_Param::first(&token, &ptype);
+         ap != nullptr && idx < uint32_t(r.num_blocks) * r.block_size;
+         ap = AP_Param::next_scalar(&token, &ptype), idx++) {
+        char name[AP_MAX_NAME_SIZE+1];
+        ap->copy_name_token(token, name, AP_MAX_NAME_SIZE, true);
+        name[AP_MAX_NAME_SIZE] = 0;
+        const uint8_t type = uint8_t(ptype);
+        uint32_t &crc = r.block_crcs[idx / r.block_size];
+        crc = crc_crc32(crc, (const uint8_t *)name, strlen(name));
+        crc = crc_crc32(crc, &type, 1);
+        crc = crc_crc32(crc, (const uint8_t *)ap, AP_Param::type_size(ptype));
+    }
+    r.file_size = sizeof(struct header) + r.num_blocks * sizeof(uint32_t);
+    return true;
+}
+
+int32_t AP_Filesystem_Param::read_crc_file(struct rfile &r, uint8_t *buf, uint32_t count)
+{
+    if (r.file_ofs >= r.file_size) {
+        return 0;
+    }
+    count = MIN(count, r.file_size - r.file_ofs);
+
+    struct header hdr;
+    hdr.magic = pmagic_crc;
+    hdr.num_params = r.block_size;
+    hdr.total_params = AP_Param::count_parameters();
+
+    for (uint32_t i=0; i<count; i++) {
+        const uint32_t ofs = r.file_ofs + i;
+        if (ofs < sizeof(hdr)) {
+            buf[i] = ((const uint8_t *)&hdr)[ofs];
+        } else {
+            const uint32_t crc_ofs = ofs - sizeof(hdr);
+            buf[i] = r.block_crcs[crc_ofs / sizeof(uint32_t)] >> (8 * (crc_ofs % sizeof(uint32_t)));
+        }
+    }
+    r.file_ofs += count;
+    return count;
+}
+
 /*
   packed format:
     file header:
@@ -333,6 +431,9 @@ int32_t AP_Filesystem_Param::read(int fd, void *buf, uint32_t count)
         errno = EINVAL;
         return -1;
     }
+    if (r.block_crcs != nullptr) {
+        return read_crc_file(r, (uint8_t *)buf, count);
+    }
     size_t header_total = 0;
 
     /*
@@ -478,6 +579,12 @@ int AP_Filesystem_Param::stat(const char *name, struct stat *stbuf)
         return -1;
     }
     memset(stbuf, 0, sizeof(*stbuf));
+    if (is_crc_file(name)) {
+        // exact for the default block size
+        stbuf->st_size = sizeof(struct header) +
+            sizeof(uint32_t) * ((AP_Param::count_parameters() + default_crc_block_size - 1) / default_crc_block_size);
+        return 0;
+    }
     // give size estimation to avoid needing to scan entire file
     stbuf->st_size = AP_Param::count_parameters() * 12;
     return 0;
@@ -493,7 +600,14 @@ bool AP_Filesystem_Param::check_file_name(const char *name)
         (name[packed_len] == 0 || name[packed_len] == '?')) {
         return true;
     }
-    return false;
+    return is_crc_file(name);
+}
+
+bool AP_Filesystem_Param::is_crc_file(const char *name) const
+{
+    const uint8_t crc_len = strlen(CRC_NAME);
+    return strncmp(name, CRC_NAME, crc_len) == 0 &&
+        (name[crc_len] == 0 || name[crc_len] == '?');
 }
 
 /*
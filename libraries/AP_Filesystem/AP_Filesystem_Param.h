@@ -49,6 +49,11 @@ private:
     // Support both protocol versions
     static constexpr uint16_t pmagic = 0x671b;
     static constexpr uint16_t pmagic_with_default = 0x671c;
+    // magic of the param.crc block checksum file
+    static constexpr uint16_t pmagic_crc = 0x671d;
+
+    // default number of parameters per block in param.crc
+    static constexpr uint16_t default_crc_block_size = 32;
 
     // header at front of the file
     struct header {
@@ -76,11 +81,20 @@ private:
         uint32_t file_size;
         struct cursor *cursors;
         ExpandingString *writebuf; // for upload
+        // for param.crc
+        uint16_t block_size;
+        uint16_t num_blocks;
+        uint32_t *block_crcs;
     } file[max_open_file];
 
     bool token_seek(const struct rfile &r, const uint32_t data_ofs, struct cursor &c);
     uint8_t pack_param(const struct rfile &r, struct cursor &c, uint8_t *buf);
     bool check_file_name(const char *fname);
+    bool is_crc_file(const char *fname) const;
+
+    // param.crc support
+    bool calculate_block_crcs(struct rfile &r);
+    int32_t read_crc_file(struct rfile &r, uint8_t *buf, uint32_t count);
 
     // finish uploading parameters
     bool finish_upload(const rfile &r);
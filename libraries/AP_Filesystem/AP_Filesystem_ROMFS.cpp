@@ -36,7 +36,7 @@ int AP_Filesystem_ROMFS::open(const char *fname, int flags, bool allow_absolute_
     WITH_SEMAPHORE(record_sem); // search for free file record
     uint8_t idx;
     for (idx=0; idx<max_open_file; idx++) {
-        if (file[idx].data == nullptr) {
+        if (file[idx].stream == nullptr) {
             break;
         }
     }
@@ -44,8 +44,9 @@ int AP_Filesystem_ROMFS::open(const char *fname, int flags, bool allow_absolute_
         errno = ENFILE;
         return -1;
     }
-    file[idx].data = AP_ROMFS::find_decompress(fname, file[idx].size);
-    if (file[idx].data == nullptr) {
+    // large files are decompressed a block at a time as they are read
+    file[idx].stream = AP_ROMFS::open_stream(fname);
+    if (file[idx].stream == nullptr) {
         errno = ENOENT;
         return -1;
     }
@@ -55,30 +56,30 @@ int AP_Filesystem_ROMFS::open(const char *fname, int flags, bool allow_absolute_
 
 int AP_Filesystem_ROMFS::close(int fd)
 {
-    if (fd < 0 || fd >= max_open_file || file[fd].data == nullptr) {
+    if (fd < 0 || fd >= max_open_file || file[fd].stream == nullptr) {
         errno = EBADF;
         return -1;
     }
 
     WITH_SEMAPHORE(record_sem); // release file record
-    AP_ROMFS::free(file[fd].data);
-    file[fd].data = nullptr;
+    delete file[fd].stream;
+    file[fd].stream = nullptr;
     return 0;
 }
 
 int32_t AP_Filesystem_ROMFS::read(int fd, void *buf, uint32_t count)
 {
-    if (fd < 0 || fd >= max_open_file || file[fd].data == nullptr) {
+    if (fd < 0 || fd >= max_open_file || file[fd].stream == nullptr) {
         errno = EBADF;
         return -1;
     }
-    count = MIN(file[fd].size - file[fd].ofs, count);
-    if (count == 0) {
-        return 0;
+    const int32_t ret = file[fd].stream->read(file[fd].ofs, buf, count);
+    if (ret < 0) {
+        errno = EIO;
+        return -1;
     }
-    memcpy(buf, &file[fd].data[file[fd].ofs], count);
-    file[fd].ofs += count;
-    return count;
+    file[fd].ofs += ret;
+    return ret;
 }
 
 int32_t AP_Filesystem_ROMFS::write(int fd, const void *buf, uint32_t count)
@@ -94,23 +95,24 @@ int AP_Filesystem_ROMFS::fsync(int fd)
 
 int32_t AP_Filesystem_ROMFS::lseek(int fd, int32_t offset, int seek_from)
 {
-    if (fd < 0 || fd >= max_open_file || file[fd].data == nullptr) {
+    if (fd < 0 || fd >= max_open_file || file[fd].stream == nullptr) {
         errno = EBADF;
         return -1;
     }
+    const uint32_t size = file[fd].stream->size();
     switch (seek_from) {
     case SEEK_SET:
         if (offset < 0) {
             errno = EINVAL;
             return -1;
         }
-        file[fd].ofs = MIN(file[fd].size, (uint32_t)offset);
+        file[fd].ofs = MIN(size, (uint32_t)offset);
         break;
     case SEEK_CUR:
-        file[fd].ofs = MIN(file[fd].size, offset+file[fd].ofs);
+        file[fd].ofs = MIN(size, offset+file[fd].ofs);
         break;
     case SEEK_END:
-        file[fd].ofs = file[fd].size;
+        file[fd].ofs = size;
         break;
     }
     return file[fd].ofs;
@@ -24,11 +24,26 @@
 
 #include <AP_Math/AP_Math.h>
 #include <AP_CANManager/AP_CANManager.h>
+#include <AP_DroneCAN/AP_DroneCAN.h>
 #include <AP_Scheduler/AP_Scheduler.h>
 #include <AP_Common/ExpandingString.h>
+#include <GCS_MAVLink/GCS_config.h>
+#if AP_MAVLINK_STATS_ENABLED
+#include <GCS_MAVLink/GCS.h>
+#endif
+#include <AP_Terrain/AP_Terrain.h>
+#include <AP_Scripting/AP_Scripting_config.h>
+#if AP_SCRIPTING_PROFILER_ENABLED
+#include <AP_Scripting/AP_Scripting.h>
+#endif
 
 extern const AP_HAL::HAL& hal;
 
+#ifndef AP_FILESYSTEM_SYS_SCRATCH_SIZE
+// initial size of the buffer used to generate each open file, enough for most files
+#define AP_FILESYSTEM_SYS_SCRATCH_SIZE 2048
+#endif
+
 struct SysFileList {
     const char* name;
 };
@@ -36,10 +51,28 @@ struct SysFileList {
 static const SysFileList sysfs_file_list[] = {
     {"threads.txt"},
     {"tasks.txt"},
+#if AP_SCHEDULER_ENABLED && AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+    {"latency.txt"},
+#endif
     {"dma.txt"},
     {"memory.txt"},
     {"uarts.txt"},
     {"timers.txt"},
+#if HAL_BUS_STATS_ENABLED
+    {"buses.txt"},
+#endif
+#if AP_HAL_CYCLE_PROBES_ENABLED
+    {"probes.txt"},
+#endif
+#if AP_MAVLINK_STATS_ENABLED
+    {"mavlink_stats.txt"},
+#endif
+#if AP_TERRAIN_TILE_UPLOAD_ENABLED
+    {"terrain.txt"},
+#endif
+#if AP_SCRIPTING_PROFILER_ENABLED
+    {"scripts.txt"},
+#endif
 #if HAL_MAX_CAN_PROTOCOL_DRIVERS
     {"can_log.txt"},
 #endif
@@ -47,6 +80,9 @@ static const SysFileList sysfs_file_list[] = {
     {"can0_stats.txt"},
     {"can1_stats.txt"},
 #endif
+#if HAL_ENABLE_DRONECAN_DRIVERS
+    {"can_stats.txt"},
+#endif
 #if !defined(HAL_BOOTLOADER_BUILD) && (defined(STM32F7) || defined(STM32H7))
     {"persistent.parm"},
 #endif
@@ -82,22 +118,27 @@ int AP_Filesystem_Sys::open(const char *fname, int flags, bool allow_absolute_pa
         errno = ENFILE;
         return -1;
     }
-    struct rfile &r = file[idx];
-    r.str = NEW_NOTHROW ExpandingString;
-    if (r.str == nullptr) {
-        errno = ENOMEM;
-        return -1;
-    }
-
     // This ensure that whenever new sys file is added its also added to list above
     int8_t pos = file_in_sysfs(fname);
     if (pos < 0) {
-        delete r.str;
-        r.str = nullptr;
         errno = ENOENT;
         return -1;
     }
 
+    struct rfile &r = file[idx];
+    if (r.str == nullptr) {
+        r.str = NEW_NOTHROW ExpandingString;
+        if (r.str == nullptr || !r.str->reserve(AP_FILESYSTEM_SYS_SCRATCH_SIZE)) {
+            delete r.str;
+            r.str = nullptr;
+            errno = ENOMEM;
+            return -1;
+        }
+    }
+    r.str->reset();
+    r.data = nullptr;
+    r.data_len = 0;
+
     if (strcmp(fname, "threads.txt") == 0) {
         hal.util->thread_info(*r.str);
     }
@@ -105,6 +146,11 @@ int AP_Filesystem_Sys::open(const char *fname, int flags, bool allow_absolute_pa
     if (strcmp(fname, "tasks.txt") == 0) {
         AP::scheduler().task_info(*r.str);
     }
+#if AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+    if (strcmp(fname, "latency.txt") == 0) {
+        AP::scheduler().task_latency(*r.str);
+    }
+#endif
 #endif
     if (strcmp(fname, "dma.txt") == 0) {
         hal.util->dma_info(*r.str);
@@ -120,6 +166,37 @@ int AP_Filesystem_Sys::open(const char *fname, int flags, bool allow_absolute_pa
     if (strcmp(fname, "timers.txt") == 0) {
         hal.util->timer_info(*r.str);
     }
+#if HAL_BUS_STATS_ENABLED
+    if (strcmp(fname, "buses.txt") == 0) {
+        hal.util->bus_info(*r.str);
+    }
+#endif
+#if AP_HAL_CYCLE_PROBES_ENABLED
+    if (strcmp(fname, "probes.txt") == 0) {
+        AP_HAL::CycleProbe::info(*r.str);
+    }
+#endif
+#if AP_MAVLINK_STATS_ENABLED
+    if (strcmp(fname, "mavlink_stats.txt") == 0) {
+        gcs().mavlink_stats(*r.str);
+    }
+#endif
+#if AP_TERRAIN_TILE_UPLOAD_ENABLED
+    if (strcmp(fname, "terrain.txt") == 0) {
+        AP_Terrain *terrain = AP::terrain();
+        if (terrain != nullptr) {
+            terrain->tile_upload_info(*r.str);
+        }
+    }
+#endif
+#if AP_SCRIPTING_PROFILER_ENABLED
+    if (strcmp(fname, "scripts.txt") == 0) {
+        AP_Scripting *scripting = AP::scripting();
+        if (scripting != nullptr) {
+            scripting->profile_info(*r.str);
+        }
+    }
+#endif
 #if HAL_CANMANAGER_ENABLED
     if (strcmp(fname, "can_log.txt") == 0) {
         AP::can().log_retrieve(*r.str);
@@ -137,13 +214,24 @@ int AP_Filesystem_Sys::open(const char *fname, int flags, bool allow_absolute_pa
             hal.can[can_stats_num]->get_stats(*r.str);
         }
     }
+#endif
+#if HAL_ENABLE_DRONECAN_DRIVERS
+    if (strcmp(fname, "can_stats.txt") == 0) {
+        for (uint8_t i = 0; i < HAL_MAX_CAN_PROTOCOL_DRIVERS; i++) {
+            AP_DroneCAN *dronecan = AP_DroneCAN::get_dronecan(i);
+            if (dronecan != nullptr) {
+                dronecan->pool_stats(*r.str);
+            }
+        }
+    }
 #endif
     if (strcmp(fname, "persistent.parm") == 0) {
         hal.util->load_persistent_params(*r.str);
     }
 #if AP_CRASHDUMP_ENABLED
     if (strcmp(fname, "crash_dump.bin") == 0) {
-        r.str->set_buffer((char*)hal.util->last_crash_dump_ptr(), hal.util->last_crash_dump_size(), hal.util->last_crash_dump_size());
+        r.data = (const char *)hal.util->last_crash_dump_ptr();
+        r.data_len = hal.util->last_crash_dump_size();
     }
 #endif
     if (strcmp(fname, "storage.bin") == 0) {
@@ -152,21 +240,32 @@ int AP_Filesystem_Sys::open(const char *fname, int flags, bool allow_absolute_pa
         void *ptr = nullptr;
         size_t size = 0;
         if (hal.storage->get_storage_ptr(ptr, size)) {
-            r.str->set_buffer((char*)ptr, size, size);
+            r.data = (const char *)ptr;
+            r.data_len = size;
         }
     }
 #if AP_FILESYSTEM_SYS_FLASH_ENABLED
     if (strcmp(fname, "flash.bin") == 0) {
         void *ptr = (void*)0x08000000;
         const size_t size = HAL_PROGRAM_SIZE_LIMIT_KB*1024;
-        r.str->set_buffer((char*)ptr, size, size);
+        r.data = (const char *)ptr;
+        r.data_len = size;
     }
 #endif
     
-    if (r.str->get_length() == 0) {
-        errno = r.str->has_failed_allocation()?ENOMEM:ENOENT;
+    if (r.data == nullptr) {
+        r.data = r.str->get_string();
+        r.data_len = r.str->get_length();
+    }
+    if (r.str->has_failed_allocation()) {
+        // free the buffer to give the memory back
         delete r.str;
         r.str = nullptr;
+        errno = ENOMEM;
+        return -1;
+    }
+    if (r.data_len == 0) {
+        errno = ENOENT;
         return -1;
     }
     r.file_ofs = 0;
@@ -182,8 +281,7 @@ int AP_Filesystem_Sys::close(int fd)
     }
     struct rfile &r = file[fd];
     r.open = false;
-    delete r.str;
-    r.str = nullptr;
+    // the generated contents buffer is kept for the next open
     return 0;
 }
 
@@ -194,8 +292,8 @@ int32_t AP_Filesystem_Sys::read(int fd, void *buf, uint32_t count)
         return -1;
     }
     struct rfile &r = file[fd];
-    count = MIN(count, r.str->get_length() - r.file_ofs);
-    memcpy(buf, &r.str->get_string()[r.file_ofs], count);
+    count = MIN(count, r.data_len - r.file_ofs);
+    memcpy(buf, &r.data[r.file_ofs], count);
 
     r.file_ofs += count;
     return count;
@@ -210,10 +308,10 @@ int32_t AP_Filesystem_Sys::lseek(int fd, int32_t offset, int seek_from)
     struct rfile &r = file[fd];
     switch (seek_from) {
     case SEEK_SET:
-        r.file_ofs = MIN(offset, int32_t(r.str->get_length()));
+        r.file_ofs = MIN(offset, int32_t(r.data_len));
         break;
     case SEEK_CUR:
-        r.file_ofs = MIN(r.str->get_length(), offset+r.file_ofs);
+        r.file_ofs = MIN(r.data_len, offset+r.file_ofs);
         break;
     case SEEK_END:
         errno = EINVAL;
@@ -49,6 +49,10 @@ private:
     struct rfile {
         bool open;
         uint32_t file_ofs;
+        const char *data;           // file contents, either in str or memory read directly
+        uint32_t data_len;
+        // generated file contents, kept between opens so that frequent
+        // polling of the same files reuses the buffer
         ExpandingString *str;
     } file[max_open_file];
 };
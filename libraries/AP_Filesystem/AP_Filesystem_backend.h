@@ -63,6 +63,17 @@ public:
     // streaming performance/robustness. if zero, any number can be written.
     virtual uint32_t bytes_until_fsync(int fd) { return 0; }
 
+    // mark an open file as high priority for access to the storage
+    virtual void set_high_priority(int fd) {}
+
+    // prepare contiguous space for an empty file to grow into
+    virtual bool preallocate(int fd, uint32_t size) { return false; }
+
+    // map the first length bytes of an open file into memory for
+    // reading, returning nullptr if not supported
+    virtual const void *mmap(int fd, uint32_t length) { return nullptr; }
+    virtual void munmap(const void *addr, uint32_t length) {}
+
     // return free disk space in bytes, -1 on error
     virtual int64_t disk_free(const char *path) { return 0; }
 
@@ -34,6 +34,10 @@
 #include <utime.h>
 #endif
 
+#if AP_FILESYSTEM_POSIX_HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 extern const AP_HAL::HAL& hal;
 
 /*
@@ -195,6 +199,26 @@ int AP_Filesystem_Posix::rename(const char *oldpath, const char *newpath)
     return ret;
 }
 
+#if AP_FILESYSTEM_POSIX_HAVE_MMAP
+const void *AP_Filesystem_Posix::mmap(int fd, uint32_t length)
+{
+    FS_CHECK_ALLOWED(nullptr);
+    if (length == 0) {
+        return nullptr;
+    }
+    void *ret = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    if (ret == MAP_FAILED) {
+        return nullptr;
+    }
+    return ret;
+}
+
+void AP_Filesystem_Posix::munmap(const void *addr, uint32_t length)
+{
+    ::munmap(const_cast<void*>(addr), length);
+}
+#endif
+
 // return free disk space in bytes
 int64_t AP_Filesystem_Posix::disk_free(const char *path)
 {
@@ -37,6 +37,10 @@
 #define AP_FILESYSTEM_POSIX_HAVE_FSYNC 1
 #endif
 
+#ifndef AP_FILESYSTEM_POSIX_HAVE_MMAP
+#define AP_FILESYSTEM_POSIX_HAVE_MMAP 1
+#endif
+
 #ifndef AP_FILESYSTEM_POSIX_HAVE_STATFS
 #define AP_FILESYSTEM_POSIX_HAVE_STATFS 1
 #endif
@@ -63,6 +67,12 @@ public:
     int closedir(void *dirp) override;
     int rename(const char *oldpath, const char *newpath) override;
 
+#if AP_FILESYSTEM_POSIX_HAVE_MMAP
+    // map a file into memory for reading
+    const void *mmap(int fd, uint32_t length) override;
+    void munmap(const void *addr, uint32_t length) override;
+#endif
+
     // return free disk space in bytes, -1 on error
     int64_t disk_free(const char *path) override;
 
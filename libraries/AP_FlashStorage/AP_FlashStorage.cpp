@@ -173,6 +173,29 @@ bool AP_FlashStorage::protected_switch_full_sector(void)
     return switch_sectors();
 }
 
+/*
+  switch the full sector ahead of time, so the erase happens while
+  the caller is idle rather than in the middle of a burst of writes,
+  or when erasing is no longer allowed
+ */
+bool AP_FlashStorage::idle_compact(void)
+{
+    if (write_error || reserved_space == 0) {
+        // the other sector is still available, switching to it won't
+        // need an erase
+        return false;
+    }
+    if (flash_sector_size - write_offset >= flash_sector_size/4) {
+        // plenty of space left
+        return false;
+    }
+    if (!flash_erase_ok()) {
+        return false;
+    }
+    debug("idle compaction at write_offset=%u\n", (unsigned)write_offset);
+    return switch_full_sector();
+}
+
 // write some data to virtual EEPROM
 bool AP_FlashStorage::write(uint16_t offset, uint16_t length)
 {
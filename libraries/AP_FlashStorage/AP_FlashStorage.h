@@ -130,6 +130,12 @@ public:
     // write some data to storage from mem_buffer
     bool write(uint16_t offset, uint16_t length) WARN_IF_UNUSED;
 
+    // if the current sector is nearly full and switching away from
+    // it will need an erase, do that switch now. This should be
+    // called when the caller is idle and an erase stall is
+    // acceptable. Returns true if the sector was switched
+    bool idle_compact(void);
+
     // fixed storage size
     static const uint16_t storage_size = HAL_STORAGE_SIZE;
     
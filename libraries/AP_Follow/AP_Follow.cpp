@@ -32,6 +32,10 @@ extern const AP_HAL::HAL& hal;
 #define AP_FOLLOW_TIMEOUT_MS    3000    // position estimate timeout after 1 second
 #define AP_FOLLOW_SYSID_TIMEOUT_MS 10000 // forget sysid we are following if we have not heard from them in 10 seconds
 
+#define AP_FOLLOW_ACCEL_MAX_MSS         10.0f   // limit on the acceleration fitted to a target's velocity history
+#define AP_FOLLOW_ACCEL_PREDICT_MAX_S   1.0f    // acceleration is only projected this far past the latest sample, after which velocity is held
+#define AP_FOLLOW_VEL_DERIVE_DT_MIN_MS  50      // minimum time between samples used to derive a velocity from positions
+
 #define AP_FOLLOW_OFFSET_TYPE_NED       0   // offsets are in north-east-down frame
 #define AP_FOLLOW_OFFSET_TYPE_RELATIVE  1   // offsets are relative to lead vehicle's heading
 
@@ -193,22 +197,32 @@ bool AP_Follow::get_target_position_and_velocity_NED_m(Vector3p &pos_ned_m, Vect
         return false;
     }
 
+    const Target *target = get_followed_target();
+    if (target == nullptr) {
+        return false;
+    }
+
     // check for timeout
-    if ((_last_location_update_ms == 0) || (AP_HAL::millis() - _last_location_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
+    const TargetSample &sample = target->latest();
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - sample.time_ms > AP_FOLLOW_TIMEOUT_MS) {
         return false;
     }
 
-    // calculate time since last actual position update
-    const float dt = (AP_HAL::millis() - _last_location_update_ms) * 0.001f;
+    // calculate time since the sample was taken, the jitter
+    // corrected timestamp includes the transport latency
+    const float dt = (now_ms - sample.time_ms) * 0.001f;
 
     // get velocity estimate
-    if (!get_velocity_NED_ms(vel_ned_ms, dt)) {
+    if (!get_velocity_NED_ms(*target, vel_ned_ms, dt)) {
         return false;
     }
 
-    // project the vehicle position
-    const Vector3p vel_ned_p { vel_ned_ms.x, vel_ned_ms.y, vel_ned_ms.z };
-    pos_ned_m = _target_position_ned_m + vel_ned_p * dt;
+    // project the vehicle position, acceleration is only applied for
+    // the first AP_FOLLOW_ACCEL_PREDICT_MAX_S seconds
+    const float accel_dt = MIN(dt, AP_FOLLOW_ACCEL_PREDICT_MAX_S);
+    const Vector3f ofs_ned_m = sample.vel_ned_ms * dt + target->accel_ned_mss * (accel_dt * (dt - 0.5f * accel_dt));
+    pos_ned_m = sample.pos_ned_m + ofs_ned_m.topostype();
 
     return true;
 }
@@ -276,16 +290,147 @@ bool AP_Follow::get_target_heading_deg(float &heading_deg) const
         return false;
     }
 
+    const Target *target = get_followed_target();
+    if (target == nullptr) {
+        return false;
+    }
+
     // check for timeout
-    if ((_last_heading_update_ms == 0) || (AP_HAL::millis() - _last_heading_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
+    if ((target->last_heading_update_ms == 0) || (AP_HAL::millis() - target->last_heading_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
         return false;
     }
 
     // return latest heading_deg estimate
-    heading_deg = _target_heading_deg;
+    heading_deg = target->heading_deg;
     return true;
 }
 
+// get the tracked vehicle we are following, nullptr if we have not heard from it
+const AP_Follow::Target *AP_Follow::get_followed_target() const
+{
+    if (_sysid == 0) {
+        return nullptr;
+    }
+    for (const auto &target : _targets) {
+        if (target.count > 0 && target.sysid == _sysid) {
+            return &target;
+        }
+    }
+    return nullptr;
+}
+
+// get the slot for a vehicle, taking over an unused or the stalest
+// slot if the vehicle is not already tracked
+AP_Follow::Target &AP_Follow::get_target_slot(uint8_t sysid)
+{
+    Target *stalest = nullptr;
+    const uint32_t now_ms = AP_HAL::millis();
+    for (auto &target : _targets) {
+        if (target.sysid == sysid) {
+            return target;
+        }
+        // never take over the vehicle we are following
+        if (_sysid != 0 && target.sysid == _sysid) {
+            continue;
+        }
+        if (target.count == 0) {
+            stalest = &target;
+            break;
+        }
+        if (stalest == nullptr || now_ms - target.latest().time_ms > now_ms - stalest->latest().time_ms) {
+            stalest = &target;
+        }
+    }
+
+    // with one slot the vehicle we are following may be the only choice
+    if (stalest == nullptr) {
+        stalest = &_targets[0];
+    }
+    stalest->sysid = sysid;
+    stalest->head = 0;
+    stalest->count = 0;
+    stalest->accel_ned_mss.zero();
+    stalest->last_heading_update_ms = 0;
+    stalest->jitter.reset();
+    return *stalest;
+}
+
+// add a sample to a vehicle's history and refit its acceleration.
+// If have_vel is false the velocity is derived from the previous sample
+void AP_Follow::add_target_sample(Target &target, uint32_t time_ms, const Vector3p &pos_ned_m, const Vector3f &vel_ned_ms, bool have_vel)
+{
+    Vector3f vel = vel_ned_ms;
+    if (!have_vel) {
+        vel.zero();
+        if (target.count > 0) {
+            const TargetSample &prev = target.latest();
+            const uint32_t dt_ms = time_ms - prev.time_ms;
+            if (dt_ms >= AP_FOLLOW_VEL_DERIVE_DT_MIN_MS && dt_ms <= AP_FOLLOW_TIMEOUT_MS) {
+                vel = (pos_ned_m - prev.pos_ned_m).tofloat() / (dt_ms * 0.001f);
+            } else {
+                vel = prev.vel_ned_ms;
+            }
+        }
+    }
+
+    if (target.count > 0) {
+        target.head = (target.head + 1) % AP_FOLLOW_TARGET_HISTORY;
+    }
+    target.samples[target.head] = TargetSample { time_ms, pos_ned_m, vel };
+    target.count = MIN(target.count + 1, AP_FOLLOW_TARGET_HISTORY);
+
+    // least squares fit of velocity against time over the recent
+    // history, which is less noisy than differencing the two latest
+    // velocities and gives less overshoot when the target turns or stops
+    target.accel_ned_mss.zero();
+    float t[AP_FOLLOW_TARGET_HISTORY];
+    uint8_t n = 0;
+    float t_mean = 0;
+    Vector3f vel_mean;
+    for (uint8_t i=0; i<target.count; i++) {
+        const TargetSample &s = target.samples[(target.head + AP_FOLLOW_TARGET_HISTORY - i) % AP_FOLLOW_TARGET_HISTORY];
+        const uint32_t age_ms = time_ms - s.time_ms;
+        if (age_ms > AP_FOLLOW_TIMEOUT_MS) {
+            break;
+        }
+        t[n] = -(age_ms * 0.001f);
+        t_mean += t[n];
+        vel_mean += s.vel_ned_ms;
+        n++;
+    }
+    if (n < 3) {
+        return;
+    }
+    t_mean /= n;
+    vel_mean /= n;
+    float t_var = 0;
+    Vector3f tv_cov;
+    for (uint8_t i=0; i<n; i++) {
+        const TargetSample &s = target.samples[(target.head + AP_FOLLOW_TARGET_HISTORY - i) % AP_FOLLOW_TARGET_HISTORY];
+        const float dt = t[i] - t_mean;
+        t_var += sq(dt);
+        tv_cov += (s.vel_ned_ms - vel_mean) * dt;
+    }
+    if (!is_positive(t_var)) {
+        return;
+    }
+    target.accel_ned_mss = tv_cov / t_var;
+    const float accel_mss = target.accel_ned_mss.length();
+    if (accel_mss > AP_FOLLOW_ACCEL_MAX_MSS) {
+        target.accel_ned_mss *= AP_FOLLOW_ACCEL_MAX_MSS / accel_mss;
+    }
+}
+
+// get system time of last position update of the vehicle we are following
+uint32_t AP_Follow::get_last_update_ms() const
+{
+    const Target *target = get_followed_target();
+    if (target == nullptr) {
+        return 0;
+    }
+    return target->latest().time_ms;
+}
+
 // returns true if we should extract information from msg
 bool AP_Follow::should_handle_message(const mavlink_message_t &msg) const
 {
@@ -299,11 +444,8 @@ bool AP_Follow::should_handle_message(const mavlink_message_t &msg) const
         return false;
     }
 
-    // skip message if not from our target
-    if (_sysid != 0 && msg.sysid != _sysid) {
-        return false;
-    }
-
+    // messages from other vehicles are used too so that their history
+    // is ready if the vehicle to follow is changed
     return true;
 }
 
@@ -313,8 +455,9 @@ void AP_Follow::handle_msg(const mavlink_message_t &msg)
     // this method should be called from an "update()" method:
     if (_automatic_sysid) {
         // maybe timeout who we were following...
-        if ((_last_location_update_ms == 0) ||
-            (AP_HAL::millis() - _last_location_update_ms > AP_FOLLOW_SYSID_TIMEOUT_MS)) {
+        const uint32_t last_update_ms = get_last_update_ms();
+        if ((last_update_ms == 0) ||
+            (AP_HAL::millis() - last_update_ms > AP_FOLLOW_SYSID_TIMEOUT_MS)) {
             _sysid.set(0);
         }
     }
@@ -337,7 +480,8 @@ void AP_Follow::handle_msg(const mavlink_message_t &msg)
     }
     }
 
-    if (updated) {
+    // only log the vehicle we are following
+    if (updated && msg.sysid == _sysid) {
 #if HAL_LOGGING_ENABLED
         Log_Write_FOLL();
 #endif
@@ -367,21 +511,26 @@ bool AP_Follow::handle_global_position_int_message(const mavlink_message_t &msg)
             // absolute altitude
             _target_location.set_alt_cm(packet.alt / 10, Location::AltFrame::ABSOLUTE);
         }
-        if (!_target_location.get_vector_from_origin_NEU(_target_position_ned_m)) {
+        Vector3p pos_ned_m;
+        if (!_target_location.get_vector_from_origin_NEU(pos_ned_m)) {
             return false;
         }
-        _target_position_ned_m.z = -_target_position_ned_m.z; // NEU->NED
-        _target_position_ned_m *= 0.01;  // cm -> m
+        pos_ned_m.z = -pos_ned_m.z; // NEU->NED
+        pos_ned_m *= 0.01;  // cm -> m
 
-        _target_velocity_ned_ms.x = packet.vx * 0.01f; // velocity north
-        _target_velocity_ned_ms.y = packet.vy * 0.01f; // velocity east
-        _target_velocity_ned_ms.z = packet.vz * 0.01f; // velocity down
+        const Vector3f vel_ned_ms {
+            packet.vx * 0.01f,  // velocity north
+            packet.vy * 0.01f,  // velocity east
+            packet.vz * 0.01f   // velocity down
+        };
 
         // get a local timestamp with correction for transport jitter
-        _last_location_update_ms = _jitter.correct_offboard_timestamp_msec(packet.time_boot_ms, AP_HAL::millis());
+        Target &target = get_target_slot(msg.sysid);
+        const uint32_t time_ms = target.jitter.correct_offboard_timestamp_msec(packet.time_boot_ms, AP_HAL::millis());
+        add_target_sample(target, time_ms, pos_ned_m, vel_ned_ms, true);
         if (packet.hdg <= 36000) {                  // heading_deg (UINT16_MAX if unknown)
-            _target_heading_deg = packet.hdg * 0.01f;   // convert centi-degrees to degrees
-            _last_heading_update_ms = _last_location_update_ms;
+            target.heading_deg = packet.hdg * 0.01f;   // convert centi-degrees to degrees
+            target.last_heading_update_ms = time_ms;
         }
         // initialise _sysid if zero to sender's id
         if (_sysid == 0) {
@@ -413,29 +562,32 @@ bool AP_Follow::handle_follow_target_message(const mavlink_message_t &msg)
             Location::AltFrame::ABSOLUTE
         };
 
-        if (!new_loc.get_vector_from_origin_NEU(_target_position_ned_m)) {
+        Vector3p pos_ned_m;
+        if (!new_loc.get_vector_from_origin_NEU(pos_ned_m)) {
             return false;
         }
-        _target_position_ned_m.z = -_target_position_ned_m.z; // NEU->NED
-        _target_position_ned_m *= 0.01;  // cm -> m
-
-        if (packet.est_capabilities & (1<<1)) {
-            _target_velocity_ned_ms.x = packet.vel[0]; // velocity north
-            _target_velocity_ned_ms.y = packet.vel[1]; // velocity east
-            _target_velocity_ned_ms.z = packet.vel[2]; // velocity down
-        } else {
-            _target_velocity_ned_ms.zero();
-        }
+        pos_ned_m.z = -pos_ned_m.z; // NEU->NED
+        pos_ned_m *= 0.01;  // cm -> m
+
+        // without a reported velocity it is derived from the position history
+        const bool have_vel = (packet.est_capabilities & (1<<1)) != 0;
+        const Vector3f vel_ned_ms {
+            packet.vel[0],  // velocity north
+            packet.vel[1],  // velocity east
+            packet.vel[2]   // velocity down
+        };
 
         // get a local timestamp with correction for transport jitter
-        _last_location_update_ms = _jitter.correct_offboard_timestamp_msec(packet.timestamp, AP_HAL::millis());
+        Target &target = get_target_slot(msg.sysid);
+        const uint32_t time_ms = target.jitter.correct_offboard_timestamp_msec(packet.timestamp, AP_HAL::millis());
+        add_target_sample(target, time_ms, pos_ned_m, vel_ned_ms, have_vel);
 
         if (packet.est_capabilities & (1<<3)) {
             Quaternion q{packet.attitude_q[0], packet.attitude_q[1], packet.attitude_q[2], packet.attitude_q[3]};
             float r, p, y;
             q.to_euler(r,p,y);
-            _target_heading_deg = degrees(y);
-            _last_heading_update_ms = _last_location_update_ms;
+            target.heading_deg = degrees(y);
+            target.last_heading_update_ms = time_ms;
         }
 
         // initialise _sysid if zero to sender's id
@@ -456,8 +608,14 @@ void AP_Follow::Log_Write_FOLL()
         Vector3f vel_estimate_ned_ms;
         UNUSED_RESULT(get_target_location_and_velocity(loc_estimate, vel_estimate_ned_ms));
 
+        const Target *target = get_followed_target();
+        if (target == nullptr) {
+            return;
+        }
+        const TargetSample &sample = target->latest();
+
         Location _target_location;
-        UNUSED_RESULT(AP::ahrs().get_location_from_origin_offset_NED(_target_location, _target_position_ned_m * 0.01));
+        UNUSED_RESULT(AP::ahrs().get_location_from_origin_offset_NED(_target_location, sample.pos_ned_m));
         if (_alt_type == AP_FOLLOW_ALTITUDE_TYPE_RELATIVE) {
             _target_location.change_alt_frame(Location::AltFrame::ABOVE_HOME);
         }
@@ -484,9 +642,9 @@ void AP_Follow::Log_Write_FOLL()
                                                _target_location.lat,
                                                _target_location.lng,
                                                _target_location.alt,
-                                               (double)_target_velocity_ned_ms.x,
-                                               (double)_target_velocity_ned_ms.y,
-                                               (double)_target_velocity_ned_ms.z,
+                                               (double)sample.vel_ned_ms.x,
+                                               (double)sample.vel_ned_ms.y,
+                                               (double)sample.vel_ned_ms.z,
                                                loc_estimate.lat,
                                                loc_estimate.lng,
                                                loc_estimate.alt
@@ -495,9 +653,9 @@ void AP_Follow::Log_Write_FOLL()
 #endif  // HAL_LOGGING_ENABLED
 
 // get velocity estimate in m/s in NED frame using dt since last update
-bool AP_Follow::get_velocity_NED_ms(Vector3f &vel_ned_ms, float dt) const
+bool AP_Follow::get_velocity_NED_ms(const Target &target, Vector3f &vel_ned_ms, float dt) const
 {
-    vel_ned_ms = _target_velocity_ned_ms + (_target_accel_ned_mss * dt);
+    vel_ned_ms = target.latest().vel_ned_ms + (target.accel_ned_mss * MIN(dt, AP_FOLLOW_ACCEL_PREDICT_MAX_S));
     return true;
 }
 
@@ -607,7 +765,8 @@ bool AP_Follow::have_target(void) const
     }
 
     // check for timeout
-    if ((_last_location_update_ms == 0) || (AP_HAL::millis() - _last_location_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
+    const uint32_t last_update_ms = get_last_update_ms();
+    if ((last_update_ms == 0) || (AP_HAL::millis() - last_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
         return false;
     }
     return true;
@@ -117,7 +117,7 @@ public:
     float get_bearing_to_target_deg() const { return _bearing_to_target_deg; }
 
     // get system time of last position update
-    uint32_t get_last_update_ms() const { return _last_location_update_ms; }
+    uint32_t get_last_update_ms() const;
 
     // returns true if a follow option enabled
     bool option_is_enabled(Option option) const { return (_options.get() & (uint16_t)option) != 0; }
@@ -128,11 +128,41 @@ public:
 private:
     static AP_Follow *_singleton;
 
+    // a time-stamped position and velocity report from a tracked vehicle
+    struct TargetSample {
+        uint32_t time_ms;           // local system time of the sample, corrected for transport jitter
+        Vector3p pos_ned_m;         // position from origin in NED frame in meters
+        Vector3f vel_ned_ms;        // velocity in NED frame in m/s
+    };
+
+    // state of one tracked vehicle
+    struct Target {
+        uint8_t sysid;              // mavlink system id, 0 if this slot is unused
+        TargetSample samples[AP_FOLLOW_TARGET_HISTORY]; // ring of latest samples
+        uint8_t head;               // index of the latest sample
+        uint8_t count;              // number of valid samples
+        Vector3f accel_ned_mss;     // acceleration fitted to the sample history in m/s/s
+        uint32_t last_heading_update_ms;    // system time of last heading update
+        float heading_deg;          // heading in degrees
+        JitterCorrection jitter{3000};      // jitter correction with max transport lag of 3s
+
+        const TargetSample &latest() const { return samples[head]; }
+    };
+
+    // get the tracked vehicle we are following, nullptr if we have not heard from it
+    const Target *get_followed_target() const;
+
+    // get the slot for a vehicle, taking over an unused or the stalest slot if it is not already tracked
+    Target &get_target_slot(uint8_t sysid);
+
+    // add a sample to a vehicle's history.  If have_vel is false the velocity is derived from the previous sample
+    void add_target_sample(Target &target, uint32_t time_ms, const Vector3p &pos_ned_m, const Vector3f &vel_ned_ms, bool have_vel);
+
     // returns true if we should extract information from msg
     bool should_handle_message(const mavlink_message_t &msg) const;
 
     // get velocity estimate in m/s in NED frame using dt since last update
-    bool get_velocity_NED_ms(Vector3f &vel_ned, float dt) const;
+    bool get_velocity_NED_ms(const Target &target, Vector3f &vel_ned, float dt) const;
 
     // initialise offsets to provided distance vector to other vehicle (in meters in NED frame) if required
     void init_offsets_if_required(const Vector3f &dist_vec_ned);
@@ -165,19 +195,11 @@ private:
     AP_Int16    _options;           // options for mount behaviour follow mode
 
     // local variables
-    uint32_t _last_location_update_ms;  // system time of last position update
-    Vector3p _target_position_ned_m;  // last known position of target
-    Vector3f _target_velocity_ned_ms;  // last known velocity of target in NED frame in m/s
-    Vector3f _target_accel_ned_mss;     // last known acceleration of target in NED frame in m/s/s
-    uint32_t _last_heading_update_ms;   // system time of last heading update
-    float _target_heading_deg;          // heading in degrees
+    Target _targets[AP_FOLLOW_MAX_TARGETS]; // vehicles we have heard from
     bool _automatic_sysid;          // did we lock onto a sysid automatically?
     float _dist_to_target_m;          // latest distance to target in meters (for reporting purposes)
     float _bearing_to_target_deg;       // latest bearing to target in degrees (for reporting purposes)
     bool _offsets_were_zero;        // true if offsets were originally zero and then initialised to the offset from lead vehicle
-
-    // setup jitter correction with max transport lag of 3s
-    JitterCorrection _jitter{3000};
 };
 
 namespace AP {
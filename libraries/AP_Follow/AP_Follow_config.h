@@ -5,3 +5,13 @@
 #ifndef AP_FOLLOW_ENABLED
 #define AP_FOLLOW_ENABLED 1
 #endif
+
+// number of vehicles tracked at once, any of which may be followed
+#ifndef AP_FOLLOW_MAX_TARGETS
+#define AP_FOLLOW_MAX_TARGETS 3
+#endif
+
+// number of past position samples kept for each tracked vehicle
+#ifndef AP_FOLLOW_TARGET_HISTORY
+#define AP_FOLLOW_TARGET_HISTORY 5
+#endif
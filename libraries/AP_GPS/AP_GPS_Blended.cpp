@@ -11,6 +11,10 @@
 
 #define BLEND_COUNTER_FAILURE_INCREMENT 10
 
+// largest time in seconds a receiver's fix is moved to line it up with
+// the blended solution
+#define BLEND_MAX_ALIGN_SEC 0.5f
+
 /*
  calculate the weightings used to blend GPSs location and velocity data
 */
@@ -56,139 +60,107 @@ bool AP_GPS_Blended::_calc_weights(void)
         return false;
     }
 
-    // calculate the sum squared speed accuracy across all GPS sensors
-    float speed_accuracy_sum_sq = 0.0f;
-    if (gps._blend_mask & BLEND_MASK_USE_SPD_ACC) {
-        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-            if (gps.state[i].status >= AP_GPS::GPS_OK_FIX_3D) {
-                if (gps.state[i].have_speed_accuracy && gps.state[i].speed_accuracy > 0.0f) {
-                    speed_accuracy_sum_sq += sq(gps.state[i].speed_accuracy);
-                } else {
-                    // not all receivers support this metric so set it to zero and don't use it
-                    speed_accuracy_sum_sq = 0.0f;
-                    break;
-                }
-            }
-        }
-    }
-
-    // calculate the sum squared horizontal position accuracy across all GPS sensors
-    float horizontal_accuracy_sum_sq = 0.0f;
-    if (gps._blend_mask & BLEND_MASK_USE_HPOS_ACC) {
-        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-            if (gps.state[i].status >= AP_GPS::GPS_OK_FIX_2D) {
-                if (gps.state[i].have_horizontal_accuracy && gps.state[i].horizontal_accuracy > 0.0f) {
-                    horizontal_accuracy_sum_sq += sq(gps.state[i].horizontal_accuracy);
-                } else {
-                    // not all receivers support this metric so set it to zero and don't use it
-                    horizontal_accuracy_sum_sq = 0.0f;
-                    break;
-                }
-            }
-        }
-    }
-
-    // calculate the sum squared vertical position accuracy across all GPS sensors
-    float vertical_accuracy_sum_sq = 0.0f;
-    if (gps._blend_mask & BLEND_MASK_USE_VPOS_ACC) {
-        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-            if (gps.state[i].status >= AP_GPS::GPS_OK_FIX_3D) {
-                if (gps.state[i].have_vertical_accuracy && gps.state[i].vertical_accuracy > 0.0f) {
-                    vertical_accuracy_sum_sq += sq(gps.state[i].vertical_accuracy);
-                } else {
-                    // not all receivers support this metric so set it to zero and don't use it
-                    vertical_accuracy_sum_sq = 0.0f;
-                    break;
-                }
-            }
-        }
-    }
-    // Check if we can do blending using reported accuracy
-    bool can_do_blending = (horizontal_accuracy_sum_sq > 0.0f || vertical_accuracy_sum_sq > 0.0f || speed_accuracy_sum_sq > 0.0f);
-
-    // if we can't do blending using reported accuracy, return false and hard switch logic will be used instead
-    if (!can_do_blending) {
-        return false;
-    }
-
-    float sum_of_all_weights = 0.0f;
-
-    // calculate a weighting using the reported horizontal position
+    // calculate the inverse variance of each accuracy metric for each
+    // receiver in one pass. A metric is only used if every receiver
+    // with a good enough fix for it reports it
+    bool use_hpos = (gps._blend_mask & BLEND_MASK_USE_HPOS_ACC) != 0;
+    bool use_vpos = (gps._blend_mask & BLEND_MASK_USE_VPOS_ACC) != 0;
+    bool use_spd = (gps._blend_mask & BLEND_MASK_USE_SPD_ACC) != 0;
     float hpos_blend_weights[GPS_MAX_RECEIVERS] = {};
-    if (horizontal_accuracy_sum_sq > 0.0f) {
-        // calculate the weights using the inverse of the variances
-        float sum_of_hpos_weights = 0.0f;
-        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-            if (gps.state[i].status >= AP_GPS::GPS_OK_FIX_2D && gps.state[i].horizontal_accuracy >= 0.001f) {
-                hpos_blend_weights[i] = horizontal_accuracy_sum_sq / sq(gps.state[i].horizontal_accuracy);
+    float vpos_blend_weights[GPS_MAX_RECEIVERS] = {};
+    float spd_blend_weights[GPS_MAX_RECEIVERS] = {};
+    float sum_of_hpos_weights = 0.0f;
+    float sum_of_vpos_weights = 0.0f;
+    float sum_of_spd_weights = 0.0f;
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        const AP_GPS::GPS_State &s = gps.state[i];
+        if (s.status >= AP_GPS::GPS_OK_FIX_2D && use_hpos) {
+            if (!s.have_horizontal_accuracy || s.horizontal_accuracy <= 0.0f) {
+                // not all receivers support this metric so don't use it
+                use_hpos = false;
+            } else if (s.horizontal_accuracy >= 0.001f) {
+                hpos_blend_weights[i] = 1.0f / sq(s.horizontal_accuracy);
                 sum_of_hpos_weights += hpos_blend_weights[i];
             }
         }
-        // normalise the weights
-        if (sum_of_hpos_weights > 0.0f) {
-            for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-                hpos_blend_weights[i] = hpos_blend_weights[i] / sum_of_hpos_weights;
-            }
-            sum_of_all_weights += 1.0f;
+        if (s.status < AP_GPS::GPS_OK_FIX_3D) {
+            continue;
         }
-    }
-
-    // calculate a weighting using the reported vertical position accuracy
-    float vpos_blend_weights[GPS_MAX_RECEIVERS] = {};
-    if (vertical_accuracy_sum_sq > 0.0f) {
-        // calculate the weights using the inverse of the variances
-        float sum_of_vpos_weights = 0.0f;
-        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-            if (gps.state[i].status >= AP_GPS::GPS_OK_FIX_3D && gps.state[i].vertical_accuracy >= 0.001f) {
-                vpos_blend_weights[i] = vertical_accuracy_sum_sq / sq(gps.state[i].vertical_accuracy);
+        if (use_vpos) {
+            if (!s.have_vertical_accuracy || s.vertical_accuracy <= 0.0f) {
+                use_vpos = false;
+            } else if (s.vertical_accuracy >= 0.001f) {
+                vpos_blend_weights[i] = 1.0f / sq(s.vertical_accuracy);
                 sum_of_vpos_weights += vpos_blend_weights[i];
             }
         }
-        // normalise the weights
-        if (sum_of_vpos_weights > 0.0f) {
-            for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-                vpos_blend_weights[i] = vpos_blend_weights[i] / sum_of_vpos_weights;
-            }
-            sum_of_all_weights += 1.0f;
-        };
-    }
-
-    // calculate a weighting using the reported speed accuracy
-    float spd_blend_weights[GPS_MAX_RECEIVERS] = {};
-    if (speed_accuracy_sum_sq > 0.0f) {
-        // calculate the weights using the inverse of the variances
-        float sum_of_spd_weights = 0.0f;
-        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-            if (gps.state[i].status >= AP_GPS::GPS_OK_FIX_3D && gps.state[i].speed_accuracy >= 0.001f) {
-                spd_blend_weights[i] = speed_accuracy_sum_sq / sq(gps.state[i].speed_accuracy);
+        if (use_spd) {
+            if (!s.have_speed_accuracy || s.speed_accuracy <= 0.0f) {
+                use_spd = false;
+            } else if (s.speed_accuracy >= 0.001f) {
+                spd_blend_weights[i] = 1.0f / sq(s.speed_accuracy);
                 sum_of_spd_weights += spd_blend_weights[i];
             }
         }
-        // normalise the weights
-        if (sum_of_spd_weights > 0.0f) {
-            for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-                spd_blend_weights[i] = spd_blend_weights[i] / sum_of_spd_weights;
-            }
-            sum_of_all_weights += 1.0f;
-        }
     }
 
-    if (!is_positive(sum_of_all_weights)) {
+    // each usable metric contributes its normalised weights equally
+    // to the overall weight. If no metric can be used, return false
+    // and hard switch logic will be used instead
+    const float hpos_scale = (use_hpos && is_positive(sum_of_hpos_weights)) ? 1.0f / sum_of_hpos_weights : 0.0f;
+    const float vpos_scale = (use_vpos && is_positive(sum_of_vpos_weights)) ? 1.0f / sum_of_vpos_weights : 0.0f;
+    const float spd_scale = (use_spd && is_positive(sum_of_spd_weights)) ? 1.0f / sum_of_spd_weights : 0.0f;
+    const uint8_t num_metrics = uint8_t(is_positive(hpos_scale)) + uint8_t(is_positive(vpos_scale)) + uint8_t(is_positive(spd_scale));
+    if (num_metrics == 0) {
         return false;
     }
 
     // calculate an overall weight
+    const float metric_scale = 1.0f / num_metrics;
     for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-        _blend_weights[i] = (hpos_blend_weights[i] + vpos_blend_weights[i] + spd_blend_weights[i]) / sum_of_all_weights;
+        _blend_weights[i] = (hpos_blend_weights[i] * hpos_scale +
+                             vpos_blend_weights[i] * vpos_scale +
+                             spd_blend_weights[i] * spd_scale) * metric_scale;
     }
 
     return true;
 }
 
+/*
+  record the receiver data the weights and state depend on, returning
+  true if any of it has changed since the last call
+ */
+bool AP_GPS_Blended::inputs_changed()
+{
+    const uint8_t blend_mask = uint8_t(gps._blend_mask.get());
+    bool changed = _last_inputs.blend_mask != blend_mask;
+    _last_inputs.blend_mask = blend_mask;
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        const uint32_t message_ms = gps.timing[i].last_message_time_ms;
+        const uint32_t fix_ms = gps.state[i].last_gps_time_ms;
+        const AP_GPS::GPS_Status status = gps.state[i].status;
+        changed |= message_ms != _last_inputs.message_ms[i] ||
+                   fix_ms != _last_inputs.fix_ms[i] ||
+                   status != _last_inputs.status[i];
+        _last_inputs.message_ms[i] = message_ms;
+        _last_inputs.fix_ms[i] = fix_ms;
+        _last_inputs.status[i] = status;
+    }
+    return changed;
+}
+
 bool AP_GPS_Blended::calc_weights()
 {
+    // the weights only depend on the receiver data, so they are kept
+    // until a receiver has something new. AP_GPS::update() runs a lot
+    // faster than the receivers do
+    if (inputs_changed()) {
+        _weights_ok = _calc_weights();
+        _state_stale = true;
+    }
+
     // adjust blend health counter
-    if (!_calc_weights()) {
+    if (!_weights_ok) {
         _blend_health_counter = MIN(_blend_health_counter+BLEND_COUNTER_FAILURE_INCREMENT, 100);
     } else if (_blend_health_counter > 0) {
         _blend_health_counter--;
@@ -202,6 +174,12 @@ bool AP_GPS_Blended::calc_weights()
 */
 void AP_GPS_Blended::calc_state(void)
 {
+    if (!_state_stale) {
+        // nothing has changed since the last blend
+        return;
+    }
+    _state_stale = false;
+
     // initialise the blended states so we can accumulate the results using the weightings for each GPS receiver
     state.instance = GPS_BLENDED_INSTANCE;
     state.status = AP_GPS::NO_FIX;
@@ -242,6 +220,7 @@ void AP_GPS_Blended::calc_state(void)
     }
 
     // combine the states into a blended solution
+    float lag_sec[GPS_MAX_RECEIVERS] {};
     for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
         // use the highest status
         if (gps.state[i].status > state.status) {
@@ -296,6 +275,12 @@ void AP_GPS_Blended::calc_state(void)
         if (gps.timing[i].last_message_time_ms > timing.last_message_time_ms) {
             timing.last_message_time_ms = gps.timing[i].last_message_time_ms;
         }
+
+        // blend the lag
+        if (_blend_weights[i] > 0.0f) {
+            gps.get_lag(i, lag_sec[i]);
+            _blended_lag_sec += lag_sec[i] * _blend_weights[i];
+        }
     }
 
     /*
@@ -314,15 +299,29 @@ void AP_GPS_Blended::calc_state(void)
         }
     }
 
-    // Calculate the weighted sum of horizontal and vertical position offsets relative to the reference position
+    // Calculate the weighted sum of horizontal and vertical position offsets relative to the reference position.
+    // Each fix is first moved along its velocity to the time the blended solution is for
+    // (state.last_gps_time_ms less the blended lag) so that receivers running at different
+    // rates or with different lags don't make the blended position jump between updates
     Vector2f blended_NE_offset_m;
     float blended_alt_offset_cm = 0.0f;
-    blended_NE_offset_m.zero();
     for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-        if (_blend_weights[i] > 0.0f && i != best_index) {
-            blended_NE_offset_m += state.location.get_distance_NE(gps.state[i].location) * _blend_weights[i];
-            blended_alt_offset_cm += (float)(gps.state[i].location.alt - state.location.alt) * _blend_weights[i];
+        if (!is_positive(_blend_weights[i])) {
+            continue;
+        }
+        const float dt = constrain_float(int32_t(state.last_gps_time_ms - gps.state[i].last_gps_time_ms) * 0.001f - (_blended_lag_sec - lag_sec[i]),
+                                         -BLEND_MAX_ALIGN_SEC, BLEND_MAX_ALIGN_SEC);
+        Vector2f NE_offset_m = gps.state[i].velocity.xy() * dt;
+        float alt_offset_cm = 0.0f;
+        if (gps.state[i].have_vertical_velocity) {
+            alt_offset_cm = -gps.state[i].velocity.z * dt * 100.0f;
+        }
+        if (i != best_index) {
+            NE_offset_m += state.location.get_distance_NE(gps.state[i].location);
+            alt_offset_cm += (float)(gps.state[i].location.alt - state.location.alt);
         }
+        blended_NE_offset_m += NE_offset_m * _blend_weights[i];
+        blended_alt_offset_cm += alt_offset_cm * _blend_weights[i];
     }
 
     // Add the sum of weighted offsets to the reference location to obtain the blended location
@@ -365,16 +364,13 @@ void AP_GPS_Blended::calc_state(void)
         state.time_week_ms = (uint32_t)temp_time_0;
     }
 
-    // calculate a blended value for the timing data and lag
+    // calculate a blended value for the timing data
     double temp_time_1 = 0.0;
     double temp_time_2 = 0.0;
     for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
         if (_blend_weights[i] > 0.0f) {
             temp_time_1 += (double)gps.timing[i].last_fix_time_ms * (double) _blend_weights[i];
             temp_time_2 += (double)gps.timing[i].last_message_time_ms * (double)_blend_weights[i];
-            float gps_lag_sec = 0;
-            gps.get_lag(i, gps_lag_sec);
-            _blended_lag_sec += gps_lag_sec * _blend_weights[i];
         }
     }
     timing.last_fix_time_ms = (uint32_t)temp_time_1;
@@ -68,6 +68,17 @@ private:
 
     AP_GPS::GPS_timing &timing;
     bool _calc_weights(void);
+
+    // receiver data the weights were last calculated from
+    struct {
+        uint32_t message_ms[GPS_MAX_RECEIVERS];
+        uint32_t fix_ms[GPS_MAX_RECEIVERS];
+        AP_GPS::GPS_Status status[GPS_MAX_RECEIVERS];
+        uint8_t blend_mask;
+    } _last_inputs;
+    bool inputs_changed();
+    bool _weights_ok;       // result of the last weight calculation
+    bool _state_stale;      // weights have been recalculated since the state was
 };
 
 #endif  // AP_GPS_BLENDED_ENABLED
@@ -791,17 +791,23 @@ void AP_GPS_DroneCAN::send_rtcm(void)
         // don't send more than 50 per second
         return;
     }
-    uint32_t outlen = 0;
-    const uint8_t *ptr = _rtcm_stream.buf->readptr(outlen);
-    if (ptr == nullptr || outlen == 0) {
-        return;
-    }
-    uavcan_equipment_gnss_RTCMStream msg {};
-    outlen = MIN(outlen, sizeof(msg.data.data));
-    msg.protocol_id = UAVCAN_EQUIPMENT_GNSS_RTCMSTREAM_PROTOCOL_ID_RTCM3;
-    memcpy(msg.data.data, ptr, outlen);
-    msg.data.len = outlen;
-    if (_detected_modules[_detected_module].ap_dronecan->rtcm_stream.broadcast(msg)) {
+    AP_DroneCAN *ap_dronecan = _detected_modules[_detected_module].ap_dronecan;
+    // a CAN-FD receiver can take several messages in the bus time of one classic message
+    const uint8_t max_messages = ap_dronecan->bulk_messages_per_send(_detected_modules[_detected_module].node_id);
+    for (uint8_t i=0; i<max_messages; i++) {
+        uint32_t outlen = 0;
+        const uint8_t *ptr = _rtcm_stream.buf->readptr(outlen);
+        if (ptr == nullptr || outlen == 0) {
+            return;
+        }
+        uavcan_equipment_gnss_RTCMStream msg {};
+        outlen = MIN(outlen, sizeof(msg.data.data));
+        msg.protocol_id = UAVCAN_EQUIPMENT_GNSS_RTCMSTREAM_PROTOCOL_ID_RTCM3;
+        memcpy(msg.data.data, ptr, outlen);
+        msg.data.len = outlen;
+        if (!ap_dronecan->rtcm_stream.broadcast(msg)) {
+            return;
+        }
         _rtcm_stream.buf->advance(outlen);
         _rtcm_stream.last_send_ms = now;
     }
@@ -829,7 +835,17 @@ void AP_GPS_DroneCAN::inject_data(const uint8_t *data, uint16_t len)
             }
         }
         _detected_modules[_detected_module].last_inject_ms = now_ms;
-        _rtcm_stream.buf->write(data, len);
+        {
+            WITH_SEMAPHORE(sem);
+            // when the bus can't keep up drop the oldest data rather
+            // than the newest, as old corrections are of little use
+            // to the receiver. It will resync on the next RTCM frame
+            const uint32_t space = _rtcm_stream.buf->space();
+            if (len > space) {
+                _rtcm_stream.buf->advance(MIN(uint32_t(len - space), _rtcm_stream.buf->available()));
+            }
+            _rtcm_stream.buf->write(data, len);
+        }
         send_rtcm();
     }
 }
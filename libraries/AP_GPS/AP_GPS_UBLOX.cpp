@@ -645,6 +645,10 @@ AP_GPS_UBLOX::_request_port(void)
 // re-processing it from the top, this is unavoidable. The parser
 // attempts to avoid this when possible.
 //
+#ifndef UBLOX_READ_BLOCK_SIZE
+#define UBLOX_READ_BLOCK_SIZE 128
+#endif
+
 bool
 AP_GPS_UBLOX::read(void)
 {
@@ -684,17 +688,37 @@ AP_GPS_UBLOX::read(void)
         }
     }
 
-    const uint16_t numc = MIN(port->available(), 8192U);
-    for (uint16_t i = 0; i < numc; i++) {        // Process bytes received
-
-        // read the next byte
-        uint8_t data;
-        if (!port->read(data)) {
-            break;
-        }
+    // the bytes are read from the UART a block at a time. With a
+    // moving baseline RTCMv3 parser we stop at the end of each RTCMv3
+    // packet, so must only take a byte at a time from the UART to
+    // avoid losing the rest of a block
+    uint16_t block_size = UBLOX_READ_BLOCK_SIZE;
+#if GPS_MOVING_BASELINE
+    if (rtcm3_parser) {
+        block_size = 1;
+    }
+#endif
+    uint8_t block[UBLOX_READ_BLOCK_SIZE];
+    uint16_t block_len = 0;
+    uint16_t block_ofs = 0;
+
+    uint16_t numc = MIN(port->available(), 8192U);
+    while (block_ofs < block_len || numc > 0) {        // Process bytes received
+        if (block_ofs == block_len) {
+            const ssize_t nread = port->read(block, MIN(numc, block_size));
+            if (nread <= 0) {
+                break;
+            }
+            numc -= nread;
+            block_len = nread;
+            block_ofs = 0;
 #if AP_GPS_DEBUG_LOGGING_ENABLED
-        log_data(&data, 1);
+            log_data(block, block_len);
 #endif
+        }
+
+        // read the next byte
+        const uint8_t data = block[block_ofs++];
 
 #if GPS_MOVING_BASELINE
         if (rtcm3_parser) {
@@ -731,8 +755,13 @@ AP_GPS_UBLOX::read(void)
             Debug("reset %u", __LINE__);
             FALLTHROUGH;
         case 0:
-            if(PREAMBLE1 == data)
+            if(PREAMBLE1 == data) {
                 _step++;
+            } else {
+                // skip straight to the next possible preamble in the block
+                const uint8_t *preamble = (const uint8_t *)memchr(&block[block_ofs], PREAMBLE1, block_len - block_ofs);
+                block_ofs = preamble != nullptr ? preamble - block : block_len;
+            }
             break;
 
         // Message header processing
@@ -780,14 +809,20 @@ AP_GPS_UBLOX::read(void)
 
         // Receive message data
         //
-        case 6:
-            _ck_b += (_ck_a += data);                   // checksum byte
-            if (_payload_counter < sizeof(_buffer)) {
-                _buffer[_payload_counter] = data;
-            }
-            if (++_payload_counter == _payload_length)
+        case 6: {
+            // take as much of the payload as this block holds in one
+            // go, checksumming it as a span. The length was checked
+            // against the size of _buffer in the header
+            const uint16_t ofs = block_ofs - 1;
+            const uint16_t n = MIN(uint16_t(_payload_length - _payload_counter), uint16_t(block_len - ofs));
+            memcpy(&_buffer[_payload_counter], &block[ofs], n);
+            _update_checksum(&block[ofs], n, _ck_a, _ck_b);
+            block_ofs = ofs + n;
+            _payload_counter += n;
+            if (_payload_counter == _payload_length)
                 _step++;
             break;
+        }
 
         // Checksum and message processing
         //
@@ -169,8 +169,8 @@ const AP_Param::GroupInfo AP_GyroFFT::var_info[] = {
 
     // @Param: OPTIONS
     // @DisplayName: FFT options
-    // @Description: FFT configuration options. Values: 1:Apply the FFT *after* the filter bank,2:Check noise at the motor frequencies using ESC data as a reference
-    // @Bitmask: 0:Enable post-filter FFT,1:Check motor noise
+    // @Description: FFT configuration options. Values: 1:Apply the FFT *after* the filter bank,2:Check noise at the motor frequencies using ESC data as a reference,4:Follow the center frequency on every axis each cycle rather than only on the axis being analysed
+    // @Bitmask: 0:Enable post-filter FFT,1:Check motor noise,2:Track peaks on all axes
     // @User: Advanced
     // @RebootRequired: True
     AP_GROUPINFO("OPTIONS", 15, AP_GyroFFT, _options, 0),
@@ -265,6 +265,14 @@ __INITFUNC__ void AP_GyroFFT::init(uint16_t loop_rate_hz)
         return;
     }
 
+    if (tracking_peaks()) {
+        _tracking_window = NEW_NOTHROW float[_window_size + _samples_per_frame];
+        if (_tracking_window == nullptr) {
+            GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "Failed to allocate window for AP_GyroFFT");
+            return;
+        }
+    }
+
     // make the gyro window match the window size plus a buffer to cope with the backend
     // getting too far ahead.
     if (!_ins->set_gyro_window_size(_window_size + _samples_per_frame)) {
@@ -470,6 +478,7 @@ uint16_t AP_GyroFFT::run_cycle()
     // something has been detected, update the peak frequency and associated metrics
     update_ref_energy(bin_max);
     calculate_noise(false, config);
+    track_noise_peaks(config);
 
     // record how we are doing
     _thread_state._last_output_us[_update_axis] = AP_HAL::micros();
@@ -1152,6 +1161,44 @@ void AP_GyroFFT::calculate_noise(bool calibrating, const EngineConfig& config)
 }
 
 
+// follow the center peak on the axes that are not being analysed this cycle. Each axis
+// only gets a full FFT every third cycle, in between the three bins around the last peak
+// are recalculated from the latest samples, which is much cheaper than a full FFT and
+// means the notch frequency of every axis is updated each cycle
+void AP_GyroFFT::track_noise_peaks(const EngineConfig& config)
+{
+    if (_tracking_window == nullptr) {
+        return;
+    }
+
+    for (uint8_t axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        const uint16_t bin = _thread_state._center_freq_bin[axis];
+        if (axis == _update_axis || _thread_state._health[axis] == 0
+            || bin <= config._fft_start_bin || bin >= config._fft_end_bin) {
+            continue;
+        }
+
+        FloatBuffer& gyro_buffer = (_sample_mode == 0 ?_ins->get_raw_gyro_window(axis) : _downsampled_gyro_data[axis]);
+        const uint16_t samples = gyro_buffer.peek(_tracking_window, _window_size + _samples_per_frame);
+        if (samples < _state->_window_size) {
+            continue;
+        }
+
+        // use the most recent window of samples
+        float freq_hz;
+        if (!hal.dsp->goertzel_peak(_state, &_tracking_window[samples - _state->_window_size], bin, freq_hz)) {
+            // the peak has moved, leave it to the next full analysis
+            continue;
+        }
+        freq_hz = constrain_float(freq_hz, config._fft_min_hz, config._fft_max_hz);
+
+        // move the tracked bin with the peak
+        _thread_state._center_freq_bin[axis] = constrain_int16(lrintf(freq_hz / _state->_bin_resolution),
+                                                               config._fft_start_bin, config._fft_end_bin);
+        update_tl_noise_center_freq_hz(FrequencyPeak::CENTER, axis, freq_hz);
+    }
+}
+
 // calculate noise peaks based on the frequencies closest to the recent historical average, switching peaks around as necessary
 uint8_t AP_GyroFFT::calculate_tracking_peaks(float& weighted_center_freq_hz, bool calibrating, const EngineConfig& config)
 {
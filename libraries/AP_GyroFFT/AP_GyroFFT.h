@@ -40,7 +40,8 @@ public:
 
     enum class Options : uint32_t {
         FFTPostFilter = 1 << 0,
-        ESCNoiseCheck = 1 << 1
+        ESCNoiseCheck = 1 << 1,
+        TrackPeaks = 1 << 2
     };
 
     AP_GyroFFT();
@@ -111,6 +112,8 @@ public:
     bool using_post_filter_samples() const { return (_options & uint32_t(Options::FFTPostFilter)) != 0; }
     // post filter mask of IMUs
     bool check_esc_noise() const { return (_options & uint32_t(Options::ESCNoiseCheck)) != 0; }
+    // follow the center peak on the axes not being analysed
+    bool tracking_peaks() const { return (_options & uint32_t(Options::TrackPeaks)) != 0; }
     // look for a frequency in the detected noise
     float has_noise_at_frequency_hz(float freq) const;
     static float calculate_notch_frequency(float* freqs, uint16_t numpeaks, float harmonic_fit, uint8_t& harmonics);
@@ -212,6 +215,8 @@ private:
     float calculate_weighted_freq_hz(const Vector3f& energy, const Vector3f& freq) const;
     // update the estimation of the background noise energy
     void update_ref_energy(uint16_t max_bin);
+    // follow the center peak of the axes not being analysed this cycle
+    void track_noise_peaks(const EngineConfig& config);
     // test frequency detection for all of the allowable bins
     float self_test_bin_frequencies();
     // detect the provided frequency
@@ -287,6 +292,8 @@ private:
     uint8_t _update_axis;
     // noise base of the gyros
     Vector3f* _ref_energy;
+    // copy of the gyro window used when following peaks
+    float* _tracking_window;
     // the number of cycles required to have a proper noise reference
     uint16_t _noise_cycles;
     // number of cycles over which to generate noise ensemble averages
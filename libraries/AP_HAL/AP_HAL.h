@@ -20,6 +20,7 @@
 #include "OpticalFlow.h"
 #include "Flash.h"
 #include "DSP.h"
+#include "CycleProbe.h"
 
 #include "CANIface.h"
 
@@ -217,6 +217,16 @@
 #define AP_HAL_UARTDRIVER_ENABLED 1
 #endif
 
+// per-device SPI and I2C bus usage and callback timing statistics
+#ifndef HAL_BUS_STATS_ENABLED
+#define HAL_BUS_STATS_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS && HAL_MEM_CLASS >= HAL_MEM_CLASS_500)
+#endif
+
+// transfers queued by bus thread callbacks with Device::transfer_async()
+#ifndef HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+#define HAL_DEVICE_TRANSFER_QUEUE_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS)
+#endif
+
 #ifndef HAL_OS_FATFS_IO
 #define HAL_OS_FATFS_IO 0
 #endif
@@ -68,7 +68,7 @@ int16_t AP_HAL::CANIface::receive(CANFrame& out_frame, uint64_t& out_ts_monotoni
     for (auto &cb : callbacks.cb) {
         if (cb != nullptr) {
             // forward the frame to the registered callbacks and mark it as forwarded
-            cb(get_iface_num(), out_frame, out_flags | IsForwardedFrame);
+            cb(get_iface_num(), out_frame, out_flags | IsForwardedFrame, out_ts_monotonic);
         }
     }
     return 1;
@@ -83,18 +83,19 @@ int16_t AP_HAL::CANIface::send(const CANFrame& frame, uint64_t tx_deadline, CanI
     WITH_SEMAPHORE(callbacks.sem);
 #endif
     bool added_to_rx_queue = false;
+    const uint64_t now_us = AP_HAL::micros64();
     for (auto &cb : callbacks.cb) {
         if (cb == nullptr) {
             continue;
         }
         if ((flags & IsForwardedFrame) == 0) {
             // call the frame callback from send only if the frame originated from this node
-            cb(get_iface_num(), frame, flags);
+            cb(get_iface_num(), frame, flags, now_us);
         } else if (!added_to_rx_queue) {
             // the frame was forwarded from another interface, so add it to the receive queue
             CanRxItem rx_item;
             rx_item.frame = frame;
-            rx_item.timestamp_us = AP_HAL::micros64();
+            rx_item.timestamp_us = now_us;
             rx_item.flags = AP_HAL::CANIface::IsForwardedFrame;
             add_to_rx_queue(rx_item);
             added_to_rx_queue = true;
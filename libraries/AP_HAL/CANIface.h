@@ -259,7 +259,9 @@ public:
     // return true if init was called and successful
     virtual bool is_initialized() const = 0;
 
-    FUNCTOR_TYPEDEF(FrameCb, void, uint8_t, const AP_HAL::CANFrame &, CanIOFlags);
+    // frame callbacks get the bus, frame, flags and the receive
+    // timestamp in microseconds (the time of sending for sent frames)
+    FUNCTOR_TYPEDEF(FrameCb, void, uint8_t, const AP_HAL::CANFrame &, CanIOFlags, uint64_t);
 
     // register a frame callback function
     virtual bool register_frame_callback(FrameCb cb, uint8_t &cb_id);
@@ -0,0 +1,105 @@
+#include "AP_HAL.h"
+#include "CycleProbe.h"
+
+#if AP_HAL_CYCLE_PROBES_ENABLED
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+#include "ch.h"
+#include "hal.h"
+#else
+#include <time.h>
+#endif
+#include <AP_Common/ExpandingString.h>
+#if HAL_LOGGING_ENABLED
+#include <AP_Logger/AP_Logger.h>
+#include "LogStructure.h"
+#endif
+
+using namespace AP_HAL;
+
+// counter ticks per microsecond
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+#if defined(STM32_SYS_CK)
+#define CYCLES_PER_US (STM32_SYS_CK / 1000000U)
+#else
+#define CYCLES_PER_US (STM32_HCLK / 1000000U)
+#endif
+#else
+#define CYCLES_PER_US 1000U
+#endif
+
+CycleProbe *CycleProbe::head;
+
+CycleProbe::CycleProbe(const char *_name) :
+    name(_name)
+{
+    next = head;
+    head = this;
+}
+
+uint32_t CycleProbe::now()
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+    return chSysGetRealtimeCounterX();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint32_t(uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+void CycleProbe::add(uint32_t cycles)
+{
+    count++;
+    total_cycles += cycles;
+    max_cycles = MAX(max_cycles, cycles);
+    window_count++;
+    window_cycles += cycles;
+    window_max_cycles = MAX(window_max_cycles, cycles);
+}
+
+/*
+  report each probe to @SYS/probes.txt
+ */
+void CycleProbe::info(ExpandingString &str)
+{
+    str.printf("%-16s %10s %9s %9s %9s %9s\n", "Name", "Count", "Avg(us)", "Max(us)", "1sAvg", "1sMax");
+    for (const CycleProbe *p = head; p != nullptr; p = p->next) {
+        const float avg_us = p->count ? float(p->total_cycles) / (p->count * CYCLES_PER_US) : 0;
+        const float window_avg_us = p->window_count ? float(p->window_cycles) / (p->window_count * CYCLES_PER_US) : 0;
+        str.printf("%-16s %10u %9.2f %9.2f %9.2f %9.2f\n",
+                   p->name, unsigned(p->count),
+                   avg_us, float(p->max_cycles) / CYCLES_PER_US,
+                   window_avg_us, float(p->window_max_cycles) / CYCLES_PER_US);
+    }
+}
+
+#if HAL_LOGGING_ENABLED
+void CycleProbe::log()
+{
+    const uint64_t now_us = AP_HAL::micros64();
+    for (CycleProbe *p = head; p != nullptr; p = p->next) {
+        const uint32_t window_count = p->window_count;
+        const uint64_t window_cycles = p->window_cycles;
+        const uint32_t window_max_cycles = p->window_max_cycles;
+        p->window_count = 0;
+        p->window_cycles = 0;
+        p->window_max_cycles = 0;
+        if (window_count == 0) {
+            continue;
+        }
+        struct log_PRBE pkt {
+            LOG_PACKET_HEADER_INIT(LOG_PRBE_MSG),
+            time_us : now_us,
+            name    : {},
+            count   : window_count,
+            avg_us  : float(window_cycles) / (window_count * CYCLES_PER_US),
+            max_us  : float(window_max_cycles) / CYCLES_PER_US,
+        };
+        strncpy_noterm(pkt.name, p->name, sizeof(pkt.name));
+        AP::logger().WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+#endif // HAL_LOGGING_ENABLED
+
+#endif // AP_HAL_CYCLE_PROBES_ENABLED
@@ -0,0 +1,102 @@
+#pragma once
+
+/*
+  timing of named code regions from the CPU cycle counter, for finding
+  hot spots in flight. On ChibiOS this is the DWT cycle counter, on
+  other boards it is CLOCK_MONOTONIC in nanoseconds.
+
+  A probe is defined once at file scope and then timed over a scope:
+
+    AP_CYCLE_PROBE_DEFINE(rate_ctrl);
+
+    void AC_AttitudeControl_Multi::rate_controller_run()
+    {
+        AP_CYCLE_PROBE(rate_ctrl);
+        ...
+    }
+
+  The totals are available in @SYS/probes.txt and are logged as PRBE
+  messages once a second. Both macros compile to nothing unless
+  AP_HAL_CYCLE_PROBES_ENABLED is set.
+ */
+
+#include "AP_HAL_Boards.h"
+
+#ifndef AP_HAL_CYCLE_PROBES_ENABLED
+#define AP_HAL_CYCLE_PROBES_ENABLED 0
+#endif
+
+#if AP_HAL_CYCLE_PROBES_ENABLED
+
+#include <stdint.h>
+#include <AP_Common/AP_Common.h>
+#include <AP_Logger/AP_Logger_config.h>
+
+class ExpandingString;
+
+namespace AP_HAL {
+
+class CycleProbe {
+public:
+    // probes are only created at file scope, so registration happens
+    // before any threads are started
+    CycleProbe(const char *name);
+
+    CLASS_NO_COPY(CycleProbe);
+
+    // raw counter value, wraps
+    static uint32_t now();
+
+    // add the time of one pass through the probed region
+    void add(uint32_t cycles);
+
+    // times the enclosing scope
+    class Scope {
+    public:
+        Scope(CycleProbe &_probe) :
+            probe(_probe),
+            start(now())
+        {}
+        ~Scope() {
+            probe.add(now() - start);
+        }
+    private:
+        CycleProbe &probe;
+        const uint32_t start;
+    };
+
+    // totals since boot and over the last second
+    static void info(ExpandingString &str);
+
+#if HAL_LOGGING_ENABLED
+    // log the last second of each probe and start a new one
+    static void log();
+#endif
+
+private:
+    static CycleProbe *head;
+    CycleProbe *next;
+    const char *name;
+
+    // counts are updated without a lock. A probe hit by more than
+    // one thread may occasionally lose a sample
+    uint32_t count;
+    uint64_t total_cycles;
+    uint32_t max_cycles;
+
+    uint32_t window_count;
+    uint64_t window_cycles;
+    uint32_t window_max_cycles;
+};
+
+} // namespace AP_HAL
+
+#define AP_CYCLE_PROBE_DEFINE(name) static AP_HAL::CycleProbe _cycle_probe_ ## name(#name)
+#define AP_CYCLE_PROBE(name) AP_HAL::CycleProbe::Scope _cycle_probe_scope_ ## name(_cycle_probe_ ## name)
+
+#else
+
+#define AP_CYCLE_PROBE_DEFINE(name)
+#define AP_CYCLE_PROBE(name)
+
+#endif // AP_HAL_CYCLE_PROBES_ENABLED
@@ -280,10 +280,12 @@ float DSP::calculate_jains_estimator(const FFTWindowState* fft, const float* rea
         return 0.0f;
     }
 
-    float y1 = real_fft[k_max-1];
-    float y2 = real_fft[k_max];
-    float y3 = real_fft[k_max+1];
+    return jains_estimator(real_fft[k_max-1], real_fft[k_max], real_fft[k_max+1]);
+}
 
+// Jain's estimator for the magnitudes of a peak bin y2 and its neighbours y1 and y3
+float DSP::jains_estimator(float y1, float y2, float y3) const
+{
     if (is_zero(y2) || is_zero(y1)) {
         return 0.0f;
     }
@@ -300,6 +302,39 @@ float DSP::calculate_jains_estimator(const FFTWindowState* fft, const float* rea
     return constrain_float(d, -0.5f, 0.5f);
 }
 
+// see https://en.wikipedia.org/wiki/Goertzel_algorithm
+float DSP::goertzel_magnitude(const FFTWindowState* fft, const float* samples, uint16_t k) const
+{
+    const float coeff = 2.0f * cosf(M_2PI * k / fft->_window_size);
+    float s1 = 0.0f;
+    float s2 = 0.0f;
+    for (uint16_t i = 0; i < fft->_window_size; i++) {
+        const float s0 = samples[i] * fft->_hanning_window[i] + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    return sqrtf(MAX(s1 * s1 + s2 * s2 - coeff * s1 * s2, 0.0f));
+}
+
+// follow a known peak using the magnitudes of the bins either side of it
+bool DSP::goertzel_peak(const FFTWindowState* fft, const float* samples, uint16_t k, float& freq_hz) const
+{
+    if (k <= 1 || k >= fft->_bin_count) {
+        return false;
+    }
+
+    const float y1 = goertzel_magnitude(fft, samples, k - 1);
+    const float y2 = goertzel_magnitude(fft, samples, k);
+    const float y3 = goertzel_magnitude(fft, samples, k + 1);
+
+    if (y2 < y1 || y2 < y3) {
+        return false;
+    }
+
+    freq_hz = (k + jains_estimator(y1, y2, y3)) * fft->_bin_resolution;
+    return true;
+}
+
 // initialize averaging FFT windows as they are calculated
 bool DSP::fft_init_average(FFTWindowState* fft)
 {
@@ -100,6 +100,10 @@ public:
     bool fft_start_average(FFTWindowState* fft);
     // finish the averaging process
     uint16_t fft_stop_average(FFTWindowState* fft, uint16_t start_bin, uint16_t end_bin, float* peaks);
+    // estimate the frequency of a peak at bin k of a window of samples using the Goertzel algorithm on
+    // bins k-1, k and k+1, much cheaper than a full FFT when only a known peak needs to be followed.
+    // returns false if bin k is not the largest of the three
+    bool goertzel_peak(const FFTWindowState* fft, const float* samples, uint16_t k, float& freq_hz) const;
 
 protected:
     // step 3: find the magnitudes of the complex data
@@ -133,6 +137,9 @@ protected:
     float tau(const float x) const;
     // Jain's estimator
     float calculate_jains_estimator(const FFTWindowState* fft, const float* real_fft, uint16_t k_max);
+    float jains_estimator(float y1, float y2, float y3) const;
+    // magnitude of bin k of the windowed samples
+    float goertzel_magnitude(const FFTWindowState* fft, const float* samples, uint16_t k) const;
     // init averaging FFT data
     bool fft_init_average(FFTWindowState* fft);
 
@@ -68,6 +68,9 @@ public:
 
     FUNCTOR_TYPEDEF(BankSelectCb, bool, uint8_t);
 
+    // completion callback of a queued transfer, passed true on success
+    FUNCTOR_TYPEDEF(TransferCb, void, bool);
+
     Device(enum BusType type)
     {
         _bus_id.devid_s.bus_type = type;
@@ -138,6 +141,23 @@ public:
         return transfer(send_recv, len, send_recv, len);
     }
 
+    /*
+     * Queue a transfer, calling cb with the result once it has
+     * completed. The send and recv buffers must remain valid until cb
+     * is called. Transfers are run in the order they are queued.
+     * Buses without a queue run the transfer and call cb before
+     * returning, which requires the bus semaphore to be held as for
+     * #transfer().
+     *
+     * Return: true if cb will be called, false if the transfer could
+     * not be queued.
+     */
+    virtual bool transfer_async(const uint8_t *send, uint32_t send_len,
+                                uint8_t *recv, uint32_t recv_len, TransferCb cb) {
+        cb(transfer(send, send_len, recv, recv_len));
+        return true;
+    }
+
     /*
      * Sets the required flags before transaction starts
      * this is to be used by Wide SPI communication interfaces like
@@ -2,9 +2,11 @@
 
 #include <AP_Logger/LogStructure.h>
 #include "UARTDriver.h"
+#include "CycleProbe.h"
 
 #define LOG_IDS_FROM_HAL \
-    LOG_UART_MSG
+    LOG_UART_MSG, \
+    LOG_PRBE_MSG
 
 // @LoggerMessage: UART
 // @Description: UART stats
@@ -22,10 +24,38 @@ struct PACKED log_UART {
     float rx_drop_rate;
 };
 
+// @LoggerMessage: PRBE
+// @Description: Code region timing from a cycle counter probe, over the last second
+// @Field: TimeUS: Time since system startup
+// @Field: Name: probe name
+// @Field: Cnt: number of passes through the region
+// @Field: Avg: average time in the region
+// @Field: Max: maximum time in the region
+struct PACKED log_PRBE {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    char name[16];
+    uint32_t count;
+    float avg_us;
+    float max_us;
+};
+
 #if HAL_UART_STATS_ENABLED
-#define LOG_STRUCTURE_FROM_HAL                          \
+#define LOG_STRUCTURE_FROM_HAL_UART                     \
     { LOG_UART_MSG, sizeof(log_UART),                   \
       "UART","QBfff","TimeUS,I,Tx,Rx,RxDp", "s#BBB", "F----" },
 #else
-#define LOG_STRUCTURE_FROM_HAL
+#define LOG_STRUCTURE_FROM_HAL_UART
 #endif
+
+#if AP_HAL_CYCLE_PROBES_ENABLED
+#define LOG_STRUCTURE_FROM_HAL_PRBE                     \
+    { LOG_PRBE_MSG, sizeof(log_PRBE),                   \
+      "PRBE","QNIff","TimeUS,Name,Cnt,Avg,Max", "s--ss", "F--FF" },
+#else
+#define LOG_STRUCTURE_FROM_HAL_PRBE
+#endif
+
+#define LOG_STRUCTURE_FROM_HAL                          \
+    LOG_STRUCTURE_FROM_HAL_UART                         \
+    LOG_STRUCTURE_FROM_HAL_PRBE
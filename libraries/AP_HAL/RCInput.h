@@ -21,6 +21,12 @@ public:
      */
     virtual bool new_input(void) = 0;
 
+    /**
+     * Return the system time in microseconds when the last new input was
+     * decoded, or 0 if not known. Used to measure RC to output latency
+     */
+    virtual uint32_t last_input_us(void) const { return 0; }
+
     /**
      * Return the number of valid channels in the last read
      */
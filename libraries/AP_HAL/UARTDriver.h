@@ -129,6 +129,15 @@ public:
      */
     virtual bool wait_timeout(uint16_t n, uint32_t timeout_ms) { return false; }
 
+    /*
+      wait for the delimiter byte to arrive or for at least n bytes
+      of incoming data, with timeout in milliseconds. This lets a
+      driver thread sleep until a whole frame is ready rather than
+      polling available(). Return true if the delimiter or n bytes
+      are available, false on timeout
+     */
+    virtual bool wait_frame_timeout(uint8_t delimiter, uint16_t n, uint32_t timeout_ms) { return wait_timeout(n, timeout_ms); }
+
     /*
      * Optional method to control the update of the motors. Derived classes
      * can implement it if their HAL layer requires.
@@ -196,6 +196,16 @@ public:
     // request information on timer frequencies
     virtual void timer_info(ExpandingString &str) {}
 
+#if HAL_BUS_STATS_ENABLED
+    // request information on SPI and I2C bus usage
+    virtual void bus_info(ExpandingString &str) {}
+
+#if HAL_LOGGING_ENABLED
+    // log bus usage of each device
+    virtual void bus_log() {}
+#endif
+#endif // HAL_BUS_STATS_ENABLED
+
     // generate Random values
     virtual bool get_random_vals(uint8_t* data, size_t size) { return false; }
 
@@ -54,6 +54,7 @@
 
 #define AP_FILESYSTEM_POSIX_HAVE_UTIME 0
 #define AP_FILESYSTEM_POSIX_HAVE_FSYNC 0
+#define AP_FILESYSTEM_POSIX_HAVE_MMAP 0
 #define AP_FILESYSTEM_POSIX_HAVE_STATFS 0
 #define AP_FILESYSTEM_HAVE_DIRENT_DTYPE 0
 
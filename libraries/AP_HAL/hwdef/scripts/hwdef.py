@@ -19,6 +19,19 @@ class IncludeNotFoundException(Exception):
 
 
 class HWDef:
+    # barometer drivers probed on SPI/I2C buses, which may be compiled
+    # out by HAL_PRUNE_UNLISTED_SENSOR_DRIVERS
+    baro_bus_drivers = [
+        'BMP085', 'BMP280', 'BMP388', 'BMP581', 'DPS280', 'FBM320',
+        'ICM20789', 'ICP101XX', 'ICP201XX', 'KELLERLD', 'LPS2XH',
+        'MS5607', 'MS5611', 'MS5637', 'MS5837', 'SPL06',
+    ]
+
+    # barometer drivers built under another driver's enable define
+    baro_driver_enable = {
+        'DPS310': 'DPS280',
+    }
+
     def __init__(self, quiet=False, outdir=None, hwdef=[]):
         self.outdir = outdir
         self.hwdef = hwdef
@@ -108,6 +121,18 @@ class HWDef:
     def write_define(self, f, name, value):
         f.write(f"#define {name} {value}\n")
 
+    def have_define(self, name):
+        '''return True if name is defined by a define line, with or without a value'''
+        for line in self.alllines:
+            a = line.split()
+            if len(a) > 1 and a[0] == 'define' and a[1] == name:
+                return True
+        return False
+
+    def prune_unlisted_drivers(self):
+        '''return True if drivers not named by IMU/COMPASS/BARO lines should be compiled out'''
+        return self.intdefines.get('HAL_PRUNE_UNLISTED_SENSOR_DRIVERS', 0) == 1
+
     def write_hwdef_header(self, outfilename):
         '''write hwdef header file'''
         self.progress("Writing hwdef setup in %s" % outfilename)
@@ -346,13 +371,21 @@ class HWDef:
                 '#define HAL_MAG_PROBE%u %s ADD_BACKEND(DRIVER_%s, AP_Compass_%s::%s(%s))\n'
                 % (n, wrapper, driver, driver, probe, ','.join(dev[1:])))
             f.write(f"#undef AP_COMPASS_{driver}_ENABLED\n#define AP_COMPASS_{driver}_ENABLED 1\n")
+            if probe.startswith('probe_ICM20948'):
+                f.write("#undef AP_COMPASS_ICM20948_ENABLED\n#define AP_COMPASS_ICM20948_ENABLED 1\n")
         if len(devlist) > 0:
             f.write('#define HAL_MAG_PROBE_LIST %s\n\n' % ';'.join(devlist))
+            # the listed drivers are enabled above; the rest of the
+            # I2C/SPI drivers can only be reached by probing external
+            # buses
+            if self.prune_unlisted_drivers() and not self.have_define('HAL_PROBE_EXTERNAL_I2C_COMPASSES'):
+                self.write_defaulting_define(f, 'AP_COMPASS_I2C_BACKEND_DEFAULT_ENABLED', 0)
 
     def write_BARO_config(self, f):
         '''write barometer config defines'''
         devlist = []
         seen = set()
+        listed = set()
         for dev in self.baro_list:
             if self.seen_str(dev) in seen:
                 self.error("Duplicate BARO: %s" % self.seen_str(dev))
@@ -376,8 +409,16 @@ class HWDef:
                 '#define HAL_BARO_PROBE%u %s ADD_BACKEND(AP_Baro_%s::%s(%s))\n'
                 % (n, wrapper, driver, probe, ','.join(args)))
             f.write(f"#undef AP_BARO_{driver}_ENABLED\n#define AP_BARO_{driver}_ENABLED 1\n")
+            listed.add(self.baro_driver_enable.get(driver, driver))
         if len(devlist) > 0:
             f.write('#define HAL_BARO_PROBE_LIST %s\n\n' % ';'.join(devlist))
+            # bus drivers not listed can only be reached by the
+            # BARO_PROBE_EXT probe of external buses
+            if (self.prune_unlisted_drivers() and
+                    self.intdefines.get('AP_BARO_PROBE_EXTERNAL_I2C_BUSES', 1) == 0):
+                for driver in self.baro_bus_drivers:
+                    if driver not in listed:
+                        self.write_defaulting_define(f, f'AP_BARO_{driver}_ENABLED', 0)
 
     def write_env_py(self, filename):
         '''write out env.py for environment variables to control the build process'''
@@ -0,0 +1,91 @@
+#include <AP_gtest.h>
+#include <AP_Common/AP_Common.h>
+#include <AP_HAL/HAL.h>
+#include <AP_HAL/utility/RingBuffer.h>
+
+#include <thread>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+TEST(ObjectBuffer_SPSC, basic)
+{
+    ObjectBuffer_SPSC<uint32_t> buf{4};
+    EXPECT_EQ(buf.get_size(), 4U);
+    EXPECT_TRUE(buf.is_empty());
+    EXPECT_EQ(buf.space(), 4U);
+
+    for (uint32_t i=0; i<4; i++) {
+        EXPECT_TRUE(buf.push(i));
+    }
+    EXPECT_FALSE(buf.push(99));
+    EXPECT_EQ(buf.available(), 4U);
+    EXPECT_EQ(buf.space(), 0U);
+
+    uint32_t v;
+    EXPECT_TRUE(buf.peek(v));
+    EXPECT_EQ(v, 0U);
+    for (uint32_t i=0; i<4; i++) {
+        EXPECT_TRUE(buf.pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(buf.pop(v));
+
+    // wrap around
+    for (uint32_t i=0; i<10; i++) {
+        EXPECT_TRUE(buf.push(i));
+        EXPECT_TRUE(buf.push(i+100));
+        EXPECT_TRUE(buf.pop(v));
+        EXPECT_EQ(v, i);
+        EXPECT_TRUE(buf.pop());
+    }
+    EXPECT_TRUE(buf.push(1));
+    buf.clear();
+    EXPECT_TRUE(buf.is_empty());
+}
+
+TEST(ObjectBuffer_SPSC, zero_size)
+{
+    ObjectBuffer_SPSC<uint32_t> buf;
+    uint32_t v;
+    EXPECT_EQ(buf.get_size(), 0U);
+    EXPECT_EQ(buf.space(), 0U);
+    EXPECT_FALSE(buf.push(1));
+    EXPECT_FALSE(buf.pop(v));
+}
+
+TEST(ObjectBuffer_SPSC, threads)
+{
+    struct Sample {
+        uint32_t seq;
+        uint32_t check;
+    };
+    static const uint32_t count = 100000;
+    ObjectBuffer_SPSC<Sample> buf{16};
+
+    std::thread producer([&buf]() {
+        for (uint32_t i=0; i<count; ) {
+            if (buf.push(Sample{i, ~i})) {
+                i++;
+            }
+        }
+    });
+
+    // keep consuming on errors so the producer can finish
+    uint32_t expected = 0;
+    uint32_t errors = 0;
+    while (expected < count) {
+        Sample s;
+        if (!buf.pop(s)) {
+            continue;
+        }
+        if (s.seq != expected || s.check != ~expected) {
+            errors++;
+        }
+        expected++;
+    }
+    producer.join();
+    EXPECT_EQ(errors, 0U);
+    EXPECT_TRUE(buf.is_empty());
+}
+
+AP_GTEST_MAIN()
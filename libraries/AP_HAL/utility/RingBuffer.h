@@ -461,6 +461,139 @@ private:
     HAL_Semaphore sem;
 };
 
+/*
+  lock-free ring buffer class for objects of fixed size with exactly
+  one producer thread and one consumer thread. push() must only be
+  called from the producer and pop(), peek() and clear() only from the
+  consumer. The head and tail indices are each written by one side
+  only, with release/acquire ordering so the consumer never sees an
+  index before the object it covers. No semaphore is taken so a high
+  priority consumer can't be blocked by a preempted producer.
+ */
+template <class T>
+class ObjectBuffer_SPSC {
+public:
+    static_assert(ATOMIC_INT_LOCK_FREE == 2, "ObjectBuffer_SPSC needs lock-free atomics");
+
+    ObjectBuffer_SPSC(uint32_t _size = 0) {
+        set_size(_size);
+    }
+    ~ObjectBuffer_SPSC(void) {
+        delete[] buffer;
+    }
+
+    // return size of ringbuffer
+    uint32_t get_size(void) const {
+        return size>0?size-1:0;
+    }
+
+    // set size of ringbuffer, caller responsible for ensuring
+    // neither producer nor consumer is running
+    bool set_size(uint32_t _size) {
+        delete[] buffer;
+        buffer = nullptr;
+        size = 0;
+        head.store(0);
+        tail.store(0);
+        if (_size == 0) {
+            return true;
+        }
+        // one slot is kept empty to tell full from empty
+        buffer = NEW_NOTHROW T[_size+1];
+        if (buffer == nullptr) {
+            return false;
+        }
+        size = _size+1;
+        return true;
+    }
+
+    // return number of objects available to be read
+    uint32_t available(void) const {
+        const uint32_t _head = head.load(std::memory_order_acquire);
+        const uint32_t _tail = tail.load(std::memory_order_acquire);
+        if (_tail >= _head) {
+            return _tail - _head;
+        }
+        return size - _head + _tail;
+    }
+
+    // return number of objects that could be pushed
+    uint32_t space(void) const {
+        if (size == 0) {
+            return 0;
+        }
+        return size - 1 - available();
+    }
+
+    // true if available() == 0
+    bool is_empty(void) const WARN_IF_UNUSED {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    // push one object onto the back of the queue, producer only
+    bool push(const T &object) {
+        if (size == 0) {
+            return false;
+        }
+        const uint32_t _tail = tail.load(std::memory_order_relaxed);
+        const uint32_t next = increment(_tail);
+        if (next == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        buffer[_tail] = object;
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // pop earliest object off the front of the queue, consumer only
+    bool pop(T &object) WARN_IF_UNUSED {
+        const uint32_t _head = head.load(std::memory_order_relaxed);
+        if (_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        object = buffer[_head];
+        head.store(increment(_head), std::memory_order_release);
+        return true;
+    }
+
+    // throw away an object from the front of the queue, consumer only
+    bool pop(void) {
+        const uint32_t _head = head.load(std::memory_order_relaxed);
+        if (_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        head.store(increment(_head), std::memory_order_release);
+        return true;
+    }
+
+    // copy the front object without removing it, consumer only
+    bool peek(T &object) WARN_IF_UNUSED {
+        const uint32_t _head = head.load(std::memory_order_relaxed);
+        if (_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        object = buffer[_head];
+        return true;
+    }
+
+    // discard the buffer contents, consumer only
+    void clear(void) {
+        head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    uint32_t increment(uint32_t idx) const {
+        idx++;
+        return idx == size ? 0 : idx;
+    }
+
+    T *buffer = nullptr;
+    uint32_t size = 0;
+
+    std::atomic<uint32_t> head{0}; // next object to pop, written by consumer
+    std::atomic<uint32_t> tail{0}; // next slot to push, written by producer
+};
+
 /*
   ring buffer class for objects of fixed size with pointer
   access. Note that this is not thread safe, buf offers efficient
@@ -36,6 +36,7 @@
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
@@ -352,6 +353,93 @@ ssize_t SOCKET_CLASS_NAME::recv(void *buf, size_t size, uint32_t timeout_ms)
     ssize_t ret;
     uint32_t in_addr[4] = {};
     ret = CALL_PREFIX(recvfrom)(fin, buf, size, MSG_DONTWAIT, (sockaddr *)&in_addr[0], &len);
+    return recv_complete(ret, in_addr);
+}
+
+/*
+  scatter/gather send; the pieces go out as a single datagram on UDP
+ */
+ssize_t SOCKET_CLASS_NAME::sendv(const ByteBuffer::IoVec vec[], uint8_t nvec) const
+{
+    if (fd == -1 || nvec > SOCKET_MAX_IOVEC) {
+        return -1;
+    }
+    struct iovec iov[SOCKET_MAX_IOVEC];
+    for (uint8_t i=0; i<nvec; i++) {
+        iov[i].iov_base = vec[i].data;
+        iov[i].iov_len = vec[i].len;
+    }
+    struct msghdr msg {};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = nvec;
+    return CALL_PREFIX(sendmsg)(fd, &msg, MSG_NOSIGNAL);
+}
+
+/*
+  scatter/gather send with address as a uint32_t
+ */
+ssize_t SOCKET_CLASS_NAME::sendtov(const ByteBuffer::IoVec vec[], uint8_t nvec, uint32_t address, uint16_t port)
+{
+    if (fd == -1 || nvec > SOCKET_MAX_IOVEC) {
+        return -1;
+    }
+    struct sockaddr_in sockaddr = {};
+
+#ifdef HAVE_SOCK_SIN_LEN
+    sockaddr.sin_len = sizeof(sockaddr);
+#endif
+    sockaddr.sin_port = htons(port);
+    sockaddr.sin_family = AF_INET;
+    sockaddr.sin_addr.s_addr = htonl(address);
+
+    struct iovec iov[SOCKET_MAX_IOVEC];
+    for (uint8_t i=0; i<nvec; i++) {
+        iov[i].iov_base = vec[i].data;
+        iov[i].iov_len = vec[i].len;
+    }
+    struct msghdr msg {};
+    msg.msg_name = (struct sockaddr *)&sockaddr;
+    msg.msg_namelen = sizeof(sockaddr);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = nvec;
+    return CALL_PREFIX(sendmsg)(fd, &msg, 0);
+}
+
+/*
+  scatter/gather receive, filling the pieces in order. Saves the copy
+  through a bounce buffer when receiving a datagram into a ring
+  buffer that wraps
+ */
+ssize_t SOCKET_CLASS_NAME::recvv(const ByteBuffer::IoVec vec[], uint8_t nvec, uint32_t timeout_ms)
+{
+    if (nvec > SOCKET_MAX_IOVEC) {
+        return -1;
+    }
+    if (!pollin(timeout_ms)) {
+        errno = EWOULDBLOCK;
+        return -1;
+    }
+    struct iovec iov[SOCKET_MAX_IOVEC];
+    for (uint8_t i=0; i<nvec; i++) {
+        iov[i].iov_base = vec[i].data;
+        iov[i].iov_len = vec[i].len;
+    }
+    uint32_t in_addr[4] = {};
+    struct msghdr msg {};
+    msg.msg_name = (struct sockaddr *)&in_addr[0];
+    msg.msg_namelen = sizeof(struct sockaddr_in);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = nvec;
+    const ssize_t ret = CALL_PREFIX(recvmsg)(get_read_fd(), &msg, MSG_DONTWAIT);
+    return recv_complete(ret, in_addr);
+}
+
+/*
+  record the sender of a received packet and filter out our own
+  multicast packets
+ */
+ssize_t SOCKET_CLASS_NAME::recv_complete(ssize_t ret, const uint32_t in_addr[4])
+{
     if (ret > 0) {
         // only update last_in_addr if we received data
         memcpy(last_in_addr, in_addr, sizeof(last_in_addr));
@@ -25,8 +25,13 @@
 #error "Don't include Socket.hpp directly"
 #endif
 
+#include <AP_HAL/utility/RingBuffer.h>
+
 #define IP4_STR_LEN 16
 
+// most buffer pieces passed to one scatter/gather call
+#define SOCKET_MAX_IOVEC 2
+
 class SOCKET_CLASS_NAME {
 public:
     SOCKET_CLASS_NAME(bool _datagram);
@@ -46,6 +51,13 @@ public:
     ssize_t sendto(const void *buf, size_t size, uint32_t address, uint16_t port);
     ssize_t recv(void *pkt, size_t size, uint32_t timeout_ms);
 
+    // scatter/gather variants, sending from or receiving into up to
+    // SOCKET_MAX_IOVEC pieces of caller memory, such as both parts of
+    // a wrapped ByteBuffer, in one call so a datagram is not split
+    ssize_t sendv(const ByteBuffer::IoVec vec[], uint8_t nvec) const;
+    ssize_t sendtov(const ByteBuffer::IoVec vec[], uint8_t nvec, uint32_t address, uint16_t port);
+    ssize_t recvv(const ByteBuffer::IoVec vec[], uint8_t nvec, uint32_t timeout_ms);
+
     // return the IP address and port of the last received packet
     void last_recv_address(const char *&ip_addr, uint16_t &port) const;
 
@@ -105,6 +117,9 @@ private:
     bool connected;
 
     void make_sockaddr(const char *address, uint16_t port, struct sockaddr_in &sockaddr);
+
+    // common handling of the result of a receive
+    ssize_t recv_complete(ssize_t ret, const uint32_t in_addr[4]);
 };
 
 #endif // AP_NETWORKING_SOCKETS_ENABLED
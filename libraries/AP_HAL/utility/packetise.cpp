@@ -8,11 +8,12 @@
 #include <GCS_MAVLink/GCS_MAVLink.h>
 
 /*
-  return the number of bytes to send for a packetised connection
+  return the number of bytes to send for a packetised connection,
+  looking at the data starting ofs bytes into the buffer
  */
-uint16_t mavlink_packetise(ByteBuffer &writebuf, uint16_t n)
+static uint16_t mavlink_packetise_at(ByteBuffer &writebuf, uint32_t ofs, uint16_t n)
 {
-    int16_t b = writebuf.peek(0);
+    int16_t b = writebuf.peek(ofs);
     if (b != MAVLINK_STX_MAVLINK1 && b != MAVLINK_STX) {
         /*
           we have a non-mavlink packet at the start of the
@@ -22,7 +23,7 @@ uint16_t mavlink_packetise(ByteBuffer &writebuf, uint16_t n)
         uint16_t limit = n>256?256:n;
         uint16_t i;
         for (i=0; i<limit; i++) {
-            b = writebuf.peek(i);
+            b = writebuf.peek(ofs+i);
             if (b == MAVLINK_STX_MAVLINK1 || b == MAVLINK_STX) {
                 n = i;
                 break;
@@ -46,10 +47,10 @@ uint16_t mavlink_packetise(ByteBuffer &writebuf, uint16_t n)
     }
 
     // the length of the packet is the 2nd byte
-    int16_t len = writebuf.peek(1);
+    int16_t len = writebuf.peek(ofs+1);
     if (b == MAVLINK_STX) {
         // This is Mavlink2. Check for signed packet with extra 13 bytes
-        int16_t incompat_flags = writebuf.peek(2);
+        int16_t incompat_flags = writebuf.peek(ofs+2);
         if (incompat_flags & MAVLINK_IFLAG_SIGNED) {
             min_length += MAVLINK_SIGNATURE_BLOCK_LEN;
         }
@@ -67,4 +68,34 @@ uint16_t mavlink_packetise(ByteBuffer &writebuf, uint16_t n)
     return n;
 }
 
+/*
+  return the number of bytes to send for a packetised connection
+ */
+uint16_t mavlink_packetise(ByteBuffer &writebuf, uint16_t n)
+{
+    return mavlink_packetise_at(writebuf, 0, n);
+}
+
+/*
+  return the number of bytes to send for a packetised connection,
+  packing as many whole MAVLink packets as fit in n bytes
+ */
+uint16_t mavlink_packetise_multiple(ByteBuffer &writebuf, uint16_t n)
+{
+    uint16_t ret = mavlink_packetise_at(writebuf, 0, n);
+    while (ret > 0 && ret < n) {
+        const int16_t b = writebuf.peek(ret);
+        if (b != MAVLINK_STX_MAVLINK1 && b != MAVLINK_STX) {
+            // leave non-MAVLink data for the next send
+            break;
+        }
+        const uint16_t len = mavlink_packetise_at(writebuf, ret, n-ret);
+        if (len == 0) {
+            break;
+        }
+        ret += len;
+    }
+    return ret;
+}
+
 #endif // AP_MAVLINK_PACKETISE_ENABLED
@@ -11,3 +11,9 @@
 */
 uint16_t mavlink_packetise(ByteBuffer &writebuf, uint16_t n);
 
+
+/*
+  return the number of bytes to send for a packetised connection,
+  packing as many whole MAVLink packets as fit in n bytes
+*/
+uint16_t mavlink_packetise_multiple(ByteBuffer &writebuf, uint16_t n);
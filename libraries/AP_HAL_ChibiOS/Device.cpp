@@ -25,6 +25,12 @@
 #include "Semaphores.h"
 #include "Util.h"
 #include "hwdef/common/stm32_util.h"
+#if HAL_BUS_STATS_ENABLED
+#include <AP_Common/ExpandingString.h>
+#if HAL_LOGGING_ENABLED
+#include <AP_Logger/AP_Logger.h>
+#endif
+#endif
 
 #ifndef HAL_DEVICE_THREAD_STACK
 #define HAL_DEVICE_THREAD_STACK 1024
@@ -34,11 +40,19 @@ using namespace ChibiOS;
 
 extern const AP_HAL::HAL& hal;
 
+#if HAL_BUS_STATS_ENABLED
+DeviceBus *DeviceBus::stats_buses;
+#endif
+
 DeviceBus::DeviceBus(uint8_t _thread_priority) :
         thread_priority(_thread_priority)
 {
     bouncebuffer_init(&bounce_buffer_tx, 10, false);
     bouncebuffer_init(&bounce_buffer_rx, 10, false);
+#if HAL_BUS_STATS_ENABLED
+    stats_next = stats_buses;
+    stats_buses = this;
+#endif
 }
 
 DeviceBus::DeviceBus(uint8_t _thread_priority, bool axi_sram) :
@@ -46,6 +60,10 @@ DeviceBus::DeviceBus(uint8_t _thread_priority, bool axi_sram) :
 {
     bouncebuffer_init(&bounce_buffer_tx, 10, axi_sram);
     bouncebuffer_init(&bounce_buffer_rx, 10, axi_sram);
+#if HAL_BUS_STATS_ENABLED
+    stats_next = stats_buses;
+    stats_buses = this;
+#endif
 }
 
 /*
@@ -59,17 +77,34 @@ void DeviceBus::bus_thread(void *arg)
         uint64_t now = AP_HAL::micros64();
         DeviceBus::callback_info *callback;
 
-        // find a callback to run
+        // run all the callbacks that are due with the semaphore taken
+        // once, so the transfers of devices sharing the bus run back
+        // to back rather than giving up the bus between devices
+        bool have_semaphore = false;
         for (callback = binfo->callbacks; callback; callback = callback->next) {
             if (now >= callback->next_usec) {
+#if HAL_BUS_STATS_ENABLED
+                binfo->record_lateness(callback->stats_idx, now - callback->next_usec, callback->period_usec);
+#endif
                 while (now >= callback->next_usec) {
                     callback->next_usec += callback->period_usec;
                 }
-                // call it with semaphore held
-                WITH_SEMAPHORE(binfo->semaphore);
+                if (!have_semaphore) {
+                    binfo->semaphore.take_blocking();
+                    have_semaphore = true;
+                }
                 callback->cb();
             }
         }
+        if (have_semaphore) {
+            binfo->semaphore.give();
+        }
+
+#if HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+        // queued transfers take the semaphore one at a time, so other
+        // threads can use the bus between them
+        binfo->run_queued_transfers();
+#endif
 
         // work out when next loop is needed
         uint64_t next_needed = 0;
@@ -95,6 +130,13 @@ void DeviceBus::bus_thread(void *arg)
         if (delay < 100) {
             delay = 100;
         }
+#if HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+        // run transfers queued by completion callbacks without waiting
+        // for the next callback
+        if (binfo->transfer_count > 0) {
+            delay = 100;
+        }
+#endif
         hal.scheduler->delay_microseconds(delay);
     }
     return;
@@ -143,6 +185,13 @@ AP_HAL::Device::PeriodicHandle DeviceBus::register_periodic_callback(uint32_t pe
     callback->cb = cb;
     callback->period_usec = period_usec;
     callback->next_usec = AP_HAL::micros64() + period_usec;
+#if HAL_BUS_STATS_ENABLED
+    {
+        WITH_SEMAPHORE(semaphore);
+        callback->stats_idx = HAL_BUS_STATS_MAX_DEVICES;
+        stats_slot(*_hal_device, callback->stats_idx);
+    }
+#endif
 
     // add to linked list of callbacks on thread
     callback->next = callbacks;
@@ -170,6 +219,51 @@ bool DeviceBus::adjust_timer(AP_HAL::Device::PeriodicHandle h, uint32_t period_u
     return true;
 }
 
+#if HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+bool DeviceBus::queue_transfer(AP_HAL::Device &dev, const uint8_t *send, uint32_t send_len,
+                               uint8_t *recv, uint32_t recv_len, AP_HAL::Device::TransferCb cb)
+{
+    if (transfer_queue == nullptr) {
+        transfer_queue = NEW_NOTHROW transfer_request[HAL_DEVICE_TRANSFER_QUEUE_LEN];
+        if (transfer_queue == nullptr) {
+            return false;
+        }
+    }
+    if (transfer_count >= HAL_DEVICE_TRANSFER_QUEUE_LEN) {
+        return false;
+    }
+    transfer_request &r = transfer_queue[(transfer_head + transfer_count) % HAL_DEVICE_TRANSFER_QUEUE_LEN];
+    r.dev = &dev;
+    r.send = send;
+    r.send_len = send_len;
+    r.recv = recv;
+    r.recv_len = recv_len;
+    r.cb = cb;
+    transfer_count++;
+    return true;
+}
+
+/*
+  run the transfers that were queued before this call. Transfers
+  queued by the completion callbacks are left for the next pass of
+  the bus thread so a device can't keep the bus to itself
+ */
+void DeviceBus::run_queued_transfers(void)
+{
+    uint8_t n = transfer_count;
+    while (n--) {
+        // take the request off the queue before running it, leaving
+        // room for the callback to queue another
+        const transfer_request r = transfer_queue[transfer_head];
+        transfer_head = (transfer_head + 1) % HAL_DEVICE_TRANSFER_QUEUE_LEN;
+        transfer_count--;
+
+        WITH_SEMAPHORE(semaphore);
+        r.cb(r.dev->transfer(r.send, r.send_len, r.recv, r.recv_len));
+    }
+}
+#endif // HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+
 /*
   setup to use DMA-safe bouncebuffers for device transfers
  */
@@ -205,4 +299,143 @@ void DeviceBus::bouncebuffer_finish(const uint8_t *buf_tx, uint8_t *buf_rx, uint
     }
 }
 
+#if HAL_BUS_STATS_ENABLED
+/*
+  find the statistics slot for a device, allocating one if needed. The
+  slot is keyed on the bus connection, so a device that is probed,
+  freed and opened again keeps its slot. Called with the bus
+  semaphore held
+ */
+uint8_t DeviceBus::stats_slot(const AP_HAL::Device &dev, uint8_t &stats_idx)
+{
+    if (stats_idx < num_dev_stats) {
+        return stats_idx;
+    }
+    const uint32_t key = dev.get_bus_id_devtype(0);
+    for (uint8_t i=0; i<num_dev_stats; i++) {
+        if (AP_HAL::Device::change_bus_id(dev_stats[i].bus_id, 0) == key) {
+            stats_idx = i;
+            return i;
+        }
+    }
+    if (num_dev_stats >= HAL_BUS_STATS_MAX_DEVICES) {
+        return HAL_BUS_STATS_MAX_DEVICES;
+    }
+    if (num_dev_stats == 0) {
+        stats_bus_type = dev.bus_type();
+        stats_bus_num = dev.bus_num();
+    }
+    dev_stats[num_dev_stats].bus_id = dev.get_bus_id();
+    stats_idx = num_dev_stats++;
+    return stats_idx;
+}
+
+/*
+  record a transfer, called by the bus drivers with the bus semaphore held
+ */
+void DeviceBus::record_transfer(const AP_HAL::Device &dev, uint8_t &stats_idx, uint32_t len, uint32_t busy_us)
+{
+    const uint8_t i = stats_slot(dev, stats_idx);
+    if (i >= HAL_BUS_STATS_MAX_DEVICES) {
+        return;
+    }
+    device_stats &ds = dev_stats[i];
+    ds.bus_id = dev.get_bus_id();
+    ds.total.transfers++;
+    ds.total.bytes += len;
+    ds.total.busy_us += busy_us;
+}
+
+/*
+  record how late a periodic callback ran, called from the bus thread
+ */
+void DeviceBus::record_lateness(uint8_t stats_idx, uint32_t late_us, uint32_t period_us)
+{
+    if (stats_idx >= num_dev_stats) {
+        return;
+    }
+    device_stats &ds = dev_stats[stats_idx];
+    for (uint8_t r=0; r<STATS_NUM_READERS; r++) {
+        ds.late_max_us[r] = MAX(ds.late_max_us[r], late_us);
+    }
+    ds.callback_period_us = period_us;
+}
+
+/*
+  get the change in a device's statistics since a reader last looked
+ */
+void DeviceBus::stats_delta(StatsReader reader, uint8_t i, stats_totals &delta, uint32_t &late_max_us)
+{
+    device_stats &ds = dev_stats[i];
+    // take a copy as the bus thread may be updating the totals
+    const stats_totals total = ds.total;
+    delta.transfers = total.transfers - ds.last[reader].transfers;
+    delta.bytes = total.bytes - ds.last[reader].bytes;
+    delta.busy_us = total.busy_us - ds.last[reader].busy_us;
+    ds.last[reader] = total;
+    late_max_us = ds.late_max_us[reader];
+    ds.late_max_us[reader] = 0;
+}
+
+/*
+  display the usage of each device since the last read of
+  @SYS/buses.txt, as rates and the percentage of time it held the bus
+ */
+void DeviceBus::bus_info(ExpandingString &str)
+{
+    const uint32_t now_us = AP_HAL::micros();
+    for (DeviceBus *b = stats_buses; b; b = b->stats_next) {
+        if (b->num_dev_stats == 0) {
+            continue;
+        }
+        const uint32_t dt_us = MAX(now_us - b->stats_last_us[STATS_SYSFS], 1U);
+        b->stats_last_us[STATS_SYSFS] = now_us;
+        const char *type = b->stats_bus_type == AP_HAL::Device::BUS_TYPE_SPI ? "SPI" : "I2C";
+        str.printf("%s%u\n", type, unsigned(b->stats_bus_num));
+        for (uint8_t i=0; i<b->num_dev_stats; i++) {
+            stats_totals delta;
+            uint32_t late_max_us;
+            b->stats_delta(STATS_SYSFS, i, delta, late_max_us);
+            str.printf("  0x%06x TR:%u/s BY:%u/s BUSY:%.1f%% CB:%uus LATE:%uus\n",
+                       unsigned(b->dev_stats[i].bus_id),
+                       unsigned(uint64_t(delta.transfers) * 1000000U / dt_us),
+                       unsigned(uint64_t(delta.bytes) * 1000000U / dt_us),
+                       delta.busy_us * 100.0f / dt_us,
+                       unsigned(b->dev_stats[i].callback_period_us),
+                       unsigned(late_max_us));
+        }
+    }
+}
+
+#if HAL_LOGGING_ENABLED
+// log the usage of each device since the last call
+void DeviceBus::bus_log(void)
+{
+    const uint32_t now_us = AP_HAL::micros();
+    for (DeviceBus *b = stats_buses; b; b = b->stats_next) {
+        if (b->num_dev_stats == 0) {
+            continue;
+        }
+        const uint32_t dt_us = MAX(now_us - b->stats_last_us[STATS_LOG], 1U);
+        b->stats_last_us[STATS_LOG] = now_us;
+        for (uint8_t i=0; i<b->num_dev_stats; i++) {
+            stats_totals delta;
+            uint32_t late_max_us;
+            b->stats_delta(STATS_LOG, i, delta, late_max_us);
+            const struct log_BUS pkt {
+                LOG_PACKET_HEADER_INIT(LOG_BUS_MSG),
+                time_us     : AP_HAL::micros64(),
+                bus_id      : b->dev_stats[i].bus_id,
+                transfers   : delta.transfers * 1.0e6f / dt_us,
+                bytes       : delta.bytes * 1.0e6f / dt_us,
+                busy        : delta.busy_us * 100.0f / dt_us,
+                late_max_us : late_max_us,
+            };
+            AP::logger().WriteBlock(&pkt, sizeof(pkt));
+        }
+    }
+}
+#endif // HAL_LOGGING_ENABLED
+#endif // HAL_BUS_STATS_ENABLED
+
 #endif // HAL_USE_I2C || HAL_USE_SPI
@@ -29,6 +29,17 @@
 #include "shared_dma.h"
 #include "hwdef/common/bouncebuffer.h"
 
+#if HAL_BUS_STATS_ENABLED
+#ifndef HAL_BUS_STATS_MAX_DEVICES
+#define HAL_BUS_STATS_MAX_DEVICES 8
+#endif
+class ExpandingString;
+#endif
+
+#if HAL_DEVICE_TRANSFER_QUEUE_ENABLED && !defined(HAL_DEVICE_TRANSFER_QUEUE_LEN)
+#define HAL_DEVICE_TRANSFER_QUEUE_LEN 8
+#endif
+
 namespace ChibiOS {
 
 class DeviceBus {
@@ -53,12 +64,45 @@ public:
                             uint8_t *&buf_rx, uint16_t rx_len) WARN_IF_UNUSED;
     void bouncebuffer_finish(const uint8_t *buf_tx, uint8_t *buf_rx, uint16_t rx_len);
 
+#if HAL_BUS_STATS_ENABLED
+    /*
+      record a transfer of len bytes by dev that held the bus for
+      busy_us. stats_idx is owned by the device and caches its slot
+     */
+    void record_transfer(const AP_HAL::Device &dev, uint8_t &stats_idx, uint32_t len, uint32_t busy_us);
+
+    // usage of all buses for @SYS/buses.txt
+    static void bus_info(ExpandingString &str);
+#if HAL_LOGGING_ENABLED
+    // log the usage of each device on all buses
+    static void bus_log(void);
+#endif
+#endif // HAL_BUS_STATS_ENABLED
+
+#if HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+    // true when called from a callback of this bus
+    bool in_bus_thread(void) const {
+        return thread_ctx != nullptr && chThdGetSelfX() == thread_ctx;
+    }
+
+    /*
+      queue a transfer from a callback of this bus, to be run once the
+      callbacks that are due have finished. Returns false if the
+      queue is full
+     */
+    bool queue_transfer(AP_HAL::Device &dev, const uint8_t *send, uint32_t send_len,
+                        uint8_t *recv, uint32_t recv_len, AP_HAL::Device::TransferCb cb);
+#endif
+
 private:
     struct callback_info {
         struct callback_info *next;
         AP_HAL::Device::PeriodicCb cb;
         uint32_t period_usec;
         uint64_t next_usec;
+#if HAL_BUS_STATS_ENABLED
+        uint8_t stats_idx;
+#endif
     } *callbacks;
     uint8_t thread_priority;
     thread_t* thread_ctx;
@@ -68,6 +112,64 @@ private:
     // support for bounce buffers for DMA-safe transfers
     struct bouncebuffer_t *bounce_buffer_tx;
     struct bouncebuffer_t *bounce_buffer_rx;
+
+#if HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+    // ring of queued transfers, only used by the bus thread and
+    // allocated on first use
+    struct transfer_request {
+        AP_HAL::Device *dev;
+        const uint8_t *send;
+        uint32_t send_len;
+        uint8_t *recv;
+        uint32_t recv_len;
+        AP_HAL::Device::TransferCb cb;
+    } *transfer_queue;
+    uint8_t transfer_head;
+    uint8_t transfer_count;
+
+    void run_queued_transfers(void);
+#endif
+
+#if HAL_BUS_STATS_ENABLED
+    // readers of the statistics, each with their own view of what
+    // has changed since they last looked
+    enum StatsReader : uint8_t {
+        STATS_SYSFS = 0,
+        STATS_LOG = 1,
+        STATS_NUM_READERS
+    };
+
+    struct stats_totals {
+        uint32_t transfers;
+        uint32_t bytes;
+        uint32_t busy_us;
+    };
+
+    struct device_stats {
+        // bus ID of the device, with the device type from the last transfer
+        uint32_t bus_id;
+        stats_totals total;
+        // totals when each reader last looked
+        stats_totals last[STATS_NUM_READERS];
+        // worst lateness of the device's callbacks since each reader last looked
+        uint32_t late_max_us[STATS_NUM_READERS];
+        uint32_t callback_period_us;
+    } dev_stats[HAL_BUS_STATS_MAX_DEVICES];
+    uint8_t num_dev_stats;
+    uint32_t stats_last_us[STATS_NUM_READERS];
+    enum AP_HAL::Device::BusType stats_bus_type;
+    uint8_t stats_bus_num;
+
+    // all buses with statistics
+    DeviceBus *stats_next;
+    static DeviceBus *stats_buses;
+
+    // find or allocate the statistics slot for a device
+    uint8_t stats_slot(const AP_HAL::Device &dev, uint8_t &stats_idx);
+    void record_lateness(uint8_t stats_idx, uint32_t late_us, uint32_t period_us);
+    // work out the change since a reader last looked
+    void stats_delta(StatsReader reader, uint8_t i, stats_totals &delta, uint32_t &late_max_us);
+#endif // HAL_BUS_STATS_ENABLED
 };
 
 }
@@ -359,9 +359,28 @@ bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
     return true;
 }
 
+#if HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+/*
+  transfers from callbacks of this bus are queued to run after the
+  other callbacks that are due, so a slow device doesn't delay the
+  devices after it. Anywhere else the transfer is run straight away
+ */
+bool I2CDevice::transfer_async(const uint8_t *send, uint32_t send_len,
+                               uint8_t *recv, uint32_t recv_len, TransferCb cb)
+{
+    if (!bus.in_bus_thread()) {
+        return AP_HAL::I2CDevice::transfer_async(send, send_len, recv, recv_len, cb);
+    }
+    return bus.queue_transfer(*this, send, send_len, recv, recv_len, cb);
+}
+#endif
+
 bool I2CDevice::_transfer(const uint8_t *send, uint32_t send_len,
                          uint8_t *recv, uint32_t recv_len)
 {
+#if HAL_BUS_STATS_ENABLED
+    const uint32_t start_us = AP_HAL::micros();
+#endif
     i2cAcquireBus(I2CD[bus.busnum].i2c);
 
     if (!bus.bouncebuffer_setup(send, send_len, recv, recv_len)) {
@@ -412,6 +431,9 @@ bool I2CDevice::_transfer(const uint8_t *send, uint32_t send_len,
         if (ret == MSG_OK) {
             bus.bouncebuffer_finish(send, recv, recv_len);
             i2cReleaseBus(I2CD[bus.busnum].i2c);
+#if HAL_BUS_STATS_ENABLED
+            bus.record_transfer(*this, stats_idx, send_len + recv_len, AP_HAL::micros() - start_us);
+#endif
             return true;
         }
 #if HAL_I2C_CLEAR_ON_TIMEOUT
@@ -422,6 +444,10 @@ bool I2CDevice::_transfer(const uint8_t *send, uint32_t send_len,
     }
     bus.bouncebuffer_finish(send, recv, recv_len);
     i2cReleaseBus(I2CD[bus.busnum].i2c);
+#if HAL_BUS_STATS_ENABLED
+    // failed transfers still hold the bus, often for the full timeout
+    bus.record_transfer(*this, stats_idx, send_len + recv_len, AP_HAL::micros() - start_us);
+#endif
     return false;
 }
 
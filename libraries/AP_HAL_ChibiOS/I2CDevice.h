@@ -81,6 +81,12 @@ public:
     bool read_registers_multiple(uint8_t first_reg, uint8_t *recv,
                                  uint32_t recv_len, uint8_t times) override;
 
+#if HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+    /* See AP_HAL::Device::transfer_async() */
+    bool transfer_async(const uint8_t *send, uint32_t send_len,
+                        uint8_t *recv, uint32_t recv_len, TransferCb cb) override;
+#endif
+
     /* See AP_HAL::Device::register_periodic_callback() */
     AP_HAL::Device::PeriodicHandle register_periodic_callback(
         uint32_t period_usec, AP_HAL::Device::PeriodicCb) override;
@@ -109,6 +115,9 @@ private:
     bool _split_transfers;
     bool _use_smbus;
     uint32_t _timeout_ms;
+#if HAL_BUS_STATS_ENABLED
+    uint8_t stats_idx = HAL_BUS_STATS_MAX_DEVICES;
+#endif
 };
 
 class I2CDeviceManager : public AP_HAL::I2CDeviceManager {
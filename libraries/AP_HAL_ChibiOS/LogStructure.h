@@ -4,7 +4,8 @@
 
 #define LOG_IDS_FROM_HAL_CHIBIOS \
     LOG_MON_MSG,                 \
-    LOG_WDOG_MSG
+    LOG_WDOG_MSG,                \
+    LOG_BUS_MSG
 
 // @LoggerMessage: MON
 // @Description: Main loop performance monitoring message.
@@ -70,8 +71,28 @@ struct PACKED log_WDOG {
     char thread_name4[4];
 };
 
+// @LoggerMessage: BUS
+// @Description: SPI and I2C bus usage of each device
+// @Field: TimeUS: Time since system startup
+// @Field: Id: bus ID of the device
+// @Field: Tr: transfers per second
+// @Field: By: bytes transferred per second
+// @Field: Bsy: percentage of time the device held the bus for transfers
+// @Field: LtMx: maximum lateness of the device's periodic callback
+struct PACKED log_BUS {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t bus_id;
+    float transfers;
+    float bytes;
+    float busy;
+    uint32_t late_max_us;
+};
+
 #define LOG_STRUCTURE_FROM_HAL_CHIBIOS                                  \
     { LOG_MON_MSG, sizeof(log_MON),                                     \
       "MON","QIbIHHHHHII","TimeUS,Dly,Tsk,IErr,IErrCnt,IErrLn,MM,MC,SmLn,SPICnt,I2CCnt", "s----------", "F----------", false }, \
     { LOG_WDOG_MSG, sizeof(log_WDOG),                                   \
-     "WDOG","QbIHHHHHHHIBIIn","TimeUS,Tsk,IE,IEC,IEL,MvMsg,MvCmd,SmLn,FL,FT,FA,FP,ICSR,LR,TN", "s--------------", "F--------------", false },
+     "WDOG","QbIHHHHHHHIBIIn","TimeUS,Tsk,IE,IEC,IEL,MvMsg,MvCmd,SmLn,FL,FT,FA,FP,ICSR,LR,TN", "s--------------", "F--------------", false }, \
+    { LOG_BUS_MSG, sizeof(log_BUS),                                     \
+      "BUS","QIfffI","TimeUS,Id,Tr,By,Bsy,LtMx", "s-zB%s", "F----F" },
@@ -37,6 +37,7 @@ class ChibiOS::RCInput : public AP_HAL::RCInput {
 public:
     void init() override;
     bool new_input() override;
+    uint32_t last_input_us() const override { return _rcin_timestamp_last_signal; }
     uint8_t num_channels() override;
     uint16_t read(uint8_t ch) override;
     uint8_t read(uint16_t* periods, uint8_t len) override;
@@ -69,6 +69,7 @@ extern AP_IOMCU iomcu;
 #endif
 
 #define TELEM_IC_SAMPLE 16
+#define SERIAL_LED_REFRESH_MS 1000  // unchanged serial LED strings are resent at this interval
 
 struct RCOutput::pwm_group RCOutput::pwm_group_list[] = { HAL_PWM_GROUPS };
 #if HAL_SERIAL_ESC_COMM_ENABLED
@@ -263,6 +264,10 @@ void RCOutput::rcout_thread()
 
             // now unlock everything
             dshot_collect_dma_locks(cycle_start_us, timeout_period_us);
+#ifdef HAL_WITH_BIDIR_DSHOT
+            // all captures for this cycle are in, decode them together
+            bdshot_decode_telemetry_all_groups();
+#endif
 
             if (_dshot_rate > 0) {
                 _dshot_cycle = (_dshot_cycle + 1) % _dshot_rate;
@@ -1661,11 +1666,6 @@ void RCOutput::dshot_send(pwm_group &group, rcout_timer_t cycle_start_us, rcout_
     for (uint8_t i=0; i<4; i++) {
         uint8_t chan = group.chan[i];
         if (group.is_chan_enabled(i)) {
-#ifdef HAL_WITH_BIDIR_DSHOT
-            if (group.bdshot.enabled) {
-                bdshot_decode_telemetry_from_erpm(group.bdshot.erpm[i], chan);
-            }
-#endif
             const uint32_t servo_chan_mask = 1U<<(chan+chan_offset);
 
             if (safety_on && !(safety_mask & servo_chan_mask)) {
@@ -1755,6 +1755,8 @@ bool RCOutput::serial_led_send(pwm_group &group)
 
         group.serial_led_pending = false;
         group.prepared_send = false;
+        group.serial_led_changed = false;
+        group.serial_led_last_send_ms = AP_HAL::millis();
 
         // fill the DMA buffer while we have the lock
         fill_DMA_buffer_serial_led(group);
@@ -2612,6 +2614,7 @@ bool RCOutput::set_serial_led_rgb_data(const uint16_t chan, int8_t led, uint8_t
 
         // at this point the group led data is all setup but the dma buffer still needs to be resized
         set_output_mode(1U<<chan, grp->led_mode);
+        grp->serial_led_changed = true;
 
         if (grp->current_mode != grp->led_mode) {
             // Failed to set output mode
@@ -2653,11 +2656,16 @@ void RCOutput::serial_led_set_single_rgb_data(pwm_group& group, uint8_t idx, uin
     switch (group.current_mode) {
         case MODE_PROFILED:
         case MODE_NEOPIXEL:
-        case MODE_NEOPIXELRGB:
-            group.serial_led_data[idx][led].red = red;
-            group.serial_led_data[idx][led].green = green;
-            group.serial_led_data[idx][led].blue = blue;
+        case MODE_NEOPIXELRGB: {
+            SerialLed &data = group.serial_led_data[idx][led];
+            if (data.red != red || data.green != green || data.blue != blue) {
+                data.red = red;
+                data.green = green;
+                data.blue = blue;
+                group.serial_led_changed = true;
+            }
             break;
+        }
         default:
             break;
     }
@@ -2689,6 +2697,14 @@ bool RCOutput::serial_led_send(const uint16_t chan)
     }
 
     if (grp->prepared_send) {
+        // only send strings that have changed, with a slow refresh in
+        // case an LED missed a frame. The LED thread sends all the
+        // pending groups together
+        if (!grp->serial_led_changed &&
+            AP_HAL::millis() - grp->serial_led_last_send_ms < SERIAL_LED_REFRESH_MS) {
+            grp->prepared_send = false;
+            return true;
+        }
         grp->serial_led_pending = true;
         serial_led_pending = true;
         chEvtSignal(led_thread_ctx, EVT_LED_SEND);
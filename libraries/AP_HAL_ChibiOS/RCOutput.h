@@ -379,6 +379,9 @@ private:
         enum output_mode led_mode;
         volatile bool serial_led_pending;
         volatile bool prepared_send;
+        // true if the LED data differs from what was last sent
+        bool serial_led_changed;
+        uint32_t serial_led_last_send_ms;
         HAL_Semaphore serial_led_mutex;
         // structure to hold serial LED data until it can be transferred
         // to the DMA buffer
@@ -739,6 +742,8 @@ private:
     static void bdshot_finish_dshot_gcr_transaction(virtual_timer_t* vt, void *p);
     bool bdshot_setup_group_ic_DMA(pwm_group &group);
     void bdshot_prepare_for_next_pulse(pwm_group& group);
+    void bdshot_decode_group_telemetry(pwm_group& group);
+    void bdshot_decode_telemetry_all_groups(void);
     static void bdshot_receive_pulses_DMAR(pwm_group* group);
     static void bdshot_receive_pulses_DMAR_f1(pwm_group* group);
     static void bdshot_reset_pwm(pwm_group& group, uint8_t telem_channel);
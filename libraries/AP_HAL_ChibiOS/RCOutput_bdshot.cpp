@@ -267,13 +267,39 @@ void RCOutput::bdshot_prepare_for_next_pulse(pwm_group& group)
         }
     }
 
-    // if the last transaction returned telemetry, decode it
+    // normally already done by bdshot_decode_telemetry_all_groups()
+    bdshot_decode_group_telemetry(group);
+
+    if (group.bdshot.enabled) {
+        if (group.pwm_started) {
+            bdshot_reset_pwm(group, group.bdshot.prev_telem_chan);
+        }
+        else {
+            pwmStart(group.pwm_drv, &group.pwm_cfg);
+            group.pwm_started = true;
+        }
+
+        // we can be more precise for capture timer
+        group.bdshot.telempsc = (uint16_t)(lrintf(((float)group.pwm_drv->clock / bdshot_get_output_rate_hz(group.current_mode) + 0.01f)/TELEM_IC_SAMPLE) - 1);
+    }
+}
+
+/*
+  if the last transaction on a group returned telemetry, decode it and
+  pass it on to the ESC telemetry
+ */
+void RCOutput::bdshot_decode_group_telemetry(pwm_group& group)
+{
     if (group.dshot_state == DshotState::RECV_COMPLETE) {
-        uint8_t chan = group.chan[group.bdshot.prev_telem_chan];
+        const uint8_t telem_chan = group.bdshot.prev_telem_chan;
+        uint8_t chan = group.chan[telem_chan];
         uint32_t now = AP_HAL::millis();
-        if (bdshot_decode_dshot_telemetry(group, group.bdshot.prev_telem_chan)) {
+        if (bdshot_decode_dshot_telemetry(group, telem_chan)) {
             _bdshot.erpm_clean_frames[chan]++;
             _active_escs_mask |= (1<<chan); // we know the ESC is functional at this point
+            if (group.is_chan_enabled(telem_chan)) {
+                bdshot_decode_telemetry_from_erpm(group.bdshot.erpm[telem_chan], chan);
+            }
         } else {
             _bdshot.erpm_errors[chan]++;
         }
@@ -283,21 +309,24 @@ void RCOutput::bdshot_prepare_for_next_pulse(pwm_group& group)
             _bdshot.erpm_errors[chan] = 0;
             _bdshot.erpm_last_stats_ms[chan] = now;
         }
+        group.dshot_state = DshotState::IDLE;
     } else if (group.dshot_state == DshotState::RECV_FAILED) {
         _bdshot.erpm_errors[group.bdshot.curr_telem_chan]++;
+        group.dshot_state = DshotState::IDLE;
     }
+}
 
-    if (group.bdshot.enabled) {
-        if (group.pwm_started) {
-            bdshot_reset_pwm(group, group.bdshot.prev_telem_chan);
-        }
-        else {
-            pwmStart(group.pwm_drv, &group.pwm_cfg);
-            group.pwm_started = true;
+/*
+  decode the telemetry from all groups in one pass once the cycle's
+  pulses have gone out and the captures are complete, keeping the
+  decoding out of the time between one group's pulse and the next
+ */
+void RCOutput::bdshot_decode_telemetry_all_groups(void)
+{
+    for (auto &group : pwm_group_list) {
+        if (group.bdshot.enabled) {
+            bdshot_decode_group_telemetry(group);
         }
-
-        // we can be more precise for capture timer
-        group.bdshot.telempsc = (uint16_t)(lrintf(((float)group.pwm_drv->clock / bdshot_get_output_rate_hz(group.current_mode) + 0.01f)/TELEM_IC_SAMPLE) - 1);
     }
 }
 
@@ -128,6 +128,9 @@ void RCOutput::rcout_thread() {
         dshot_send_groups(cycle_start_us, timeout_period_us);
 #if AP_HAL_SHARED_DMA_ENABLED
         dshot_collect_dma_locks(cycle_start_us, timeout_period_us);
+#endif
+#ifdef HAL_WITH_BIDIR_DSHOT
+        bdshot_decode_telemetry_all_groups();
 #endif
         if (_dshot_rate > 0) {
             _dshot_cycle = (_dshot_cycle + 1) % _dshot_rate;
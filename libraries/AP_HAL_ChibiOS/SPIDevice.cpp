@@ -97,7 +97,8 @@ SPIBus::SPIBus(uint8_t _bus) :
  */
 void SPIBus::dma_allocate(Shared_DMA *ctx)
 {
-    // nothing to do as we call spiStart() on each transaction
+    // nothing to do as acquire_bus() calls spiStart() whenever the
+    // peripheral has been stopped
 }
 
 /*
@@ -173,6 +174,9 @@ void SPIDevice::set_slowdown(uint8_t slowdown)
 bool SPIDevice::do_transfer(const uint8_t *send, uint8_t *recv, uint32_t len)
 {
     bool old_cs_forced = cs_forced;
+#if HAL_BUS_STATS_ENABLED
+    const uint32_t start_us = AP_HAL::micros();
+#endif
 
     if (!set_chip_select(true)) {
         return false;
@@ -218,6 +222,9 @@ bool SPIDevice::do_transfer(const uint8_t *send, uint8_t *recv, uint32_t len)
     bus.bouncebuffer_finish(send, recv, len);
 #endif
     set_chip_select(old_cs_forced);
+#if HAL_BUS_STATS_ENABLED
+    bus.record_transfer(*this, stats_idx, len, AP_HAL::micros() - start_us);
+#endif
     return ret;
 }
 
@@ -387,10 +394,39 @@ void SPIBus::start_peripheral(void)
 #if HAL_SPI_SCK_SAVE_RESTORE
     // restore sck pin mode from stop_peripheral()
     palSetLineMode(spi_devices[bus].sck_line, sck_mode);
+#endif
+#if defined(STM32H7)
+    started_cfg1 = spicfg.cfg1;
+    started_cfg2 = spicfg.cfg2;
+#else
+    started_cr1 = spicfg.cr1;
 #endif
     spi_started = true;
 }
 
+/*
+  restart the peripheral only if the clock or mode has changed since
+  it was started. When consecutive transactions are for devices with
+  the same settings, or for the same device, the peripheral and its
+  DMA streams are left running, avoiding a spiStop() and spiStart()
+  per transfer. If another peripheral takes one of our DMA streams
+  then dma_deallocate() stops the peripheral, and it is started again
+  here on the next transaction
+ */
+void SPIBus::restart_peripheral(void)
+{
+#if defined(STM32H7)
+    const bool same_config = spicfg.cfg1 == started_cfg1 && spicfg.cfg2 == started_cfg2;
+#else
+    const bool same_config = spicfg.cr1 == started_cr1;
+#endif
+    if (spi_started && same_config) {
+        return;
+    }
+    stop_peripheral();
+    start_peripheral();
+}
+
 /*
  used to acquire bus and (optionally) assert cs
 */
@@ -433,8 +469,7 @@ bool SPIDevice::acquire_bus(bool set, bool skip_cs)
         bus.spicfg.cr2 = 0;
 #endif
         bus.spi_mode = device_desc.mode;
-        bus.stop_peripheral();
-        bus.start_peripheral();
+        bus.restart_peripheral();
         if(!skip_cs) {
             spiSelectI(spi_devices[device_desc.bus].driver);                /* Slave Select assertion.          */
         }
@@ -53,10 +53,20 @@ public:
     // start and stop the hardware peripheral
     void start_peripheral(void);
     void stop_peripheral(void);
+    // restart the peripheral if spicfg has changed since it was started
+    void restart_peripheral(void);
 
 private:
     bool spi_started;
 
+    // clock and mode settings the peripheral was last started with
+#if defined(STM32H7)
+    uint32_t started_cfg1;
+    uint32_t started_cfg2;
+#else
+    uint16_t started_cr1;
+#endif
+
     // mode line for SCK pin
 #if HAL_SPI_SCK_SAVE_RESTORE
     iomode_t sck_mode;
@@ -169,6 +179,9 @@ private:
     uint32_t derive_freq_flag(uint32_t _frequency);
     // low level transfer function
     bool do_transfer(const uint8_t *send, uint8_t *recv, uint32_t len) WARN_IF_UNUSED;
+#if HAL_BUS_STATS_ENABLED
+    uint8_t stats_idx = HAL_BUS_STATS_MAX_DEVICES;
+#endif
 };
 
 class SPIDeviceManager : public AP_HAL::SPIDeviceManager {
@@ -241,6 +241,7 @@ void Storage::write_block(uint16_t loc, const void *src, size_t n)
         WITH_SEMAPHORE(sem);
         memcpy(&_buffer[loc], src, n);
         _mark_dirty(loc, n);
+        _last_write_ms = AP_HAL::millis();
     }
 }
 
@@ -249,13 +250,38 @@ void Storage::_timer_tick(void)
     if (_initialisedType == StorageBackend::None) {
         return;
     }
+    const uint32_t now_ms = AP_HAL::millis();
     if (_dirty_mask.empty()) {
-        _last_empty_ms = AP_HAL::millis();
+        _last_empty_ms = now_ms;
+#ifdef STORAGE_FLASH_PAGE
+        if (_initialisedType == StorageBackend::Flash &&
+            now_ms - _last_write_ms > CH_STORAGE_FLASH_IDLE_COMPACT_MS &&
+            now_ms - _last_compact_check_ms > 1000) {
+            // do any erase needed to switch sectors while nothing
+            // is being written, so it doesn't stall a later write
+            _last_compact_check_ms = now_ms;
+            EXPECT_DELAY_MS(1000);
+            _flash.idle_compact();
+        }
+#endif
+        return;
+    }
+
+    // number of adjacent lines to write
+    uint8_t nlines = 1;
+
+#ifdef STORAGE_FLASH_PAGE
+    if (_initialisedType == StorageBackend::Flash &&
+        now_ms - _last_write_ms < CH_STORAGE_FLASH_COALESCE_MS &&
+        now_ms - _last_empty_ms < CH_STORAGE_FLASH_MAX_DELAY_MS) {
+        // more writes may be coming, wait so they go out together
         return;
     }
+#endif
 
-    // write out the first dirty line. We don't write more
-    // than one to keep the latency of this call to a minimum
+    // write out the first dirty line, or on flash the first run
+    // of dirty lines. We don't write more than that to keep the
+    // latency of this call to a minimum
     uint16_t i;
     for (i=0; i<CH_STORAGE_NUM_LINES; i++) {
         if (_dirty_mask.get(i)) {
@@ -267,10 +293,21 @@ void Storage::_timer_tick(void)
         return;
     }
 
+#ifdef STORAGE_FLASH_PAGE
+    if (_initialisedType == StorageBackend::Flash) {
+        // a run of dirty lines can go out in a single flash write
+        while (nlines < CH_STORAGE_FLASH_MAX_LINES &&
+               i + nlines < CH_STORAGE_NUM_LINES &&
+               _dirty_mask.get(i + nlines)) {
+            nlines++;
+        }
+    }
+#endif
+
     {
-        // take a copy of the line we are writing with a semaphore held
+        // take a copy of the lines we are writing with a semaphore held
         WITH_SEMAPHORE(sem);
-        memcpy(tmpline, &_buffer[CH_STORAGE_LINE_SIZE*i], CH_STORAGE_LINE_SIZE);
+        memcpy(tmpline, &_buffer[CH_STORAGE_LINE_SIZE*i], CH_STORAGE_LINE_SIZE*nlines);
     }
 
     bool write_ok = false;
@@ -302,7 +339,7 @@ void Storage::_timer_tick(void)
 #ifdef STORAGE_FLASH_PAGE
     if (_initialisedType == StorageBackend::Flash) {
         // save to storage backend
-        if (_flash_write(i)) {
+        if (_flash_write(i, nlines)) {
             write_ok = true;
         }
     }
@@ -316,8 +353,10 @@ void Storage::_timer_tick(void)
         // were writing it, in which case we should not mark it
         // clean. If it matches then we know we can mark the line as
         // clean
-        if (memcmp(tmpline, &_buffer[CH_STORAGE_LINE_SIZE*i], CH_STORAGE_LINE_SIZE) == 0) {
-            _dirty_mask.clear(i);
+        for (uint8_t j=0; j<nlines; j++) {
+            if (memcmp(&tmpline[CH_STORAGE_LINE_SIZE*j], &_buffer[CH_STORAGE_LINE_SIZE*(i+j)], CH_STORAGE_LINE_SIZE) == 0) {
+                _dirty_mask.clear(i+j);
+            }
         }
     }
 }
@@ -345,13 +384,13 @@ void Storage::_flash_load(void)
 }
 
 /*
-  write one storage line. This also updates _dirty_mask.
+  write nlines adjacent storage lines
 */
-bool Storage::_flash_write(uint16_t line)
+bool Storage::_flash_write(uint16_t line, uint8_t nlines)
 {
 #ifdef STORAGE_FLASH_PAGE
     EXPECT_DELAY_MS(1);
-    return _flash.write(line*CH_STORAGE_LINE_SIZE, CH_STORAGE_LINE_SIZE);
+    return _flash.write(line*CH_STORAGE_LINE_SIZE, nlines*CH_STORAGE_LINE_SIZE);
 #else
     return false;
 #endif
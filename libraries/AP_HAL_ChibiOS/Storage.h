@@ -44,6 +44,30 @@
 #define CH_STORAGE_LINE_SIZE (1<<CH_STORAGE_LINE_SHIFT)
 #define CH_STORAGE_NUM_LINES (CH_STORAGE_SIZE/CH_STORAGE_LINE_SIZE)
 
+#ifdef STORAGE_FLASH_PAGE
+/*
+  flash writes are held back until there have been no new writes for
+  CH_STORAGE_FLASH_COALESCE_MS, or lines have been dirty for
+  CH_STORAGE_FLASH_MAX_DELAY_MS, so repeated writes to the same line
+  become a single flash write. Runs of up to CH_STORAGE_FLASH_MAX_LINES
+  adjacent dirty lines are written together
+ */
+#ifndef CH_STORAGE_FLASH_COALESCE_MS
+#define CH_STORAGE_FLASH_COALESCE_MS 100
+#endif
+#ifndef CH_STORAGE_FLASH_MAX_DELAY_MS
+#define CH_STORAGE_FLASH_MAX_DELAY_MS 500
+#endif
+#define CH_STORAGE_FLASH_MAX_LINES (64/CH_STORAGE_LINE_SIZE)
+// how long storage must be idle before a sector switch is done early
+#ifndef CH_STORAGE_FLASH_IDLE_COMPACT_MS
+#define CH_STORAGE_FLASH_IDLE_COMPACT_MS 5000
+#endif
+#define CH_STORAGE_TMP_SIZE (CH_STORAGE_FLASH_MAX_LINES*CH_STORAGE_LINE_SIZE)
+#else
+#define CH_STORAGE_TMP_SIZE CH_STORAGE_LINE_SIZE
+#endif
+
 static_assert(CH_STORAGE_SIZE % CH_STORAGE_LINE_SIZE == 0,
               "Storage is not multiple of line size");
 
@@ -80,7 +104,7 @@ private:
     uint8_t _buffer[CH_STORAGE_SIZE] __attribute__((aligned(4)));
     Bitmask<CH_STORAGE_NUM_LINES> _dirty_mask;
     HAL_Semaphore sem;
-    uint8_t tmpline[CH_STORAGE_LINE_SIZE];
+    uint8_t tmpline[CH_STORAGE_TMP_SIZE];
 
     bool _flash_write_data(uint8_t sector, uint32_t offset, const uint8_t *data, uint16_t length);
     bool _flash_read_data(uint8_t sector, uint32_t offset, uint8_t *data, uint16_t length);
@@ -90,6 +114,11 @@ private:
     bool _flash_failed;
     uint32_t _last_re_init_ms;
     uint32_t _last_empty_ms;
+    // last time write_block() dirtied a line
+    uint32_t _last_write_ms;
+#ifdef STORAGE_FLASH_PAGE
+    uint32_t _last_compact_check_ms;
+#endif
 
 #ifdef STORAGE_FLASH_PAGE
     AP_FlashStorage _flash{_buffer,
@@ -105,7 +134,7 @@ private:
 #endif
 
     void _flash_load(void);
-    bool _flash_write(uint16_t line);
+    bool _flash_write(uint16_t line, uint8_t nlines);
 
 #if HAL_WITH_RAMTRON
     AP_RAMTRON fram;
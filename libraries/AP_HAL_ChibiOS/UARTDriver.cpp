@@ -316,12 +316,21 @@ void UARTDriver::_begin(uint32_t b, uint16_t rxS, uint16_t txS)
 
 #ifndef HAL_UART_NODMA
     if (!half_duplex && !(_last_options & OPTION_NODMA_RX)) {
+#if HAL_UART_RX_DMA_CIRCULAR
+        if (rx_bounce_buf[0] == nullptr && sdef.dma_rx) {
+            rx_bounce_buf[0] = (uint8_t *)hal.util->malloc_type(RX_BOUNCE_BUFSIZE*2, AP_HAL::Util::MEM_DMA_SAFE);
+            if (rx_bounce_buf[0] != nullptr) {
+                rx_bounce_buf[1] = &rx_bounce_buf[0][RX_BOUNCE_BUFSIZE];
+            }
+        }
+#else
         if (rx_bounce_buf[0] == nullptr && sdef.dma_rx) {
             rx_bounce_buf[0] = (uint8_t *)hal.util->malloc_type(RX_BOUNCE_BUFSIZE, AP_HAL::Util::MEM_DMA_SAFE);
         }
         if (rx_bounce_buf[1] == nullptr && sdef.dma_rx) {
             rx_bounce_buf[1] = (uint8_t *)hal.util->malloc_type(RX_BOUNCE_BUFSIZE, AP_HAL::Util::MEM_DMA_SAFE);
         }
+#endif
     }
     if (tx_bounce_buf == nullptr && sdef.dma_tx && !(_last_options & OPTION_NODMA_TX)) {
         tx_bounce_buf = (uint8_t *)hal.util->malloc_type(TX_BOUNCE_BUFSIZE, AP_HAL::Util::MEM_DMA_SAFE);
@@ -538,22 +547,93 @@ void UARTDriver::dma_tx_allocate(Shared_DMA *ctx)
 }
 
 #ifndef HAL_UART_NODMA
+/*
+  DMA priority level for this port. Streams on the same DMA controller
+  are arbitrated by this level, so give the high baudrate links, which
+  have the least time to spare before an overrun, the highest priority
+ */
+uint32_t UARTDriver::dma_priority_level(void) const
+{
+    if (_baudrate >= 921600) {
+        return 3;
+    }
+    if (_baudrate >= 460800) {
+        return 2;
+    }
+    if (_baudrate > 115200) {
+        return 1;
+    }
+    return 0;
+}
+
 void UARTDriver::dma_rx_enable(void)
 {
     uint32_t dmamode = STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
     dmamode |= STM32_DMA_CR_CHSEL(sdef.dma_rx_channel_id);
-    dmamode |= STM32_DMA_CR_PL(0);
+    dmamode |= STM32_DMA_CR_PL(dma_priority_level());
 #if defined(STM32H7)
     dmamode |= DMA_SxCR_TRBUFF;   // TRBUFF See 2.3.1 in the H743 errata
 #endif
+#if HAL_UART_RX_DMA_CIRCULAR
+    rx_circ_pos = 0;
+    stm32_cacheBufferInvalidate(rx_bounce_buf[0], RX_BOUNCE_BUFSIZE*2);
+    dmaStreamSetMemory0(rxdma, rx_bounce_buf[0]);
+    dmaStreamSetTransactionSize(rxdma, RX_BOUNCE_BUFSIZE*2);
+    dmaStreamSetMode(rxdma, dmamode | STM32_DMA_CR_DIR_P2M |
+                     STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC |
+                     STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE);
+#else
     rx_bounce_idx ^= 1;
     stm32_cacheBufferInvalidate(rx_bounce_buf[rx_bounce_idx], RX_BOUNCE_BUFSIZE);
     dmaStreamSetMemory0(rxdma, rx_bounce_buf[rx_bounce_idx]);
     dmaStreamSetTransactionSize(rxdma, RX_BOUNCE_BUFSIZE);
     dmaStreamSetMode(rxdma, dmamode | STM32_DMA_CR_DIR_P2M |
                      STM32_DMA_CR_MINC | STM32_DMA_CR_TCIE);
+#endif
     dmaStreamEnable(rxdma);
 }
+
+#if HAL_UART_RX_DMA_CIRCULAR
+/*
+  copy out everything the DMA engine has written to the RX ring since
+  the last call. Must be called with the system locked or from the
+  DMA or UART interrupts, which run at the same priority
+ */
+__RAMFUNC__ void UARTDriver::dma_rx_copy_circular(void)
+{
+    const uint16_t ring_size = RX_BOUNCE_BUFSIZE*2;
+    uint16_t head = ring_size - dmaStreamGetTransactionSize(rxdma);
+    if (head >= ring_size) {
+        head = 0;
+    }
+    uint16_t pos = rx_circ_pos;
+    if (head == pos) {
+        return;
+    }
+    uint32_t len = 0;
+    uint32_t written = 0;
+    while (pos != head) {
+        // copy up to the head or the end of the ring, whichever is first
+        const uint16_t n = (head > pos ? head : ring_size) - pos;
+        stm32_cacheBufferInvalidate(&rx_bounce_buf[0][pos], n);
+        written += _readbuf.write(&rx_bounce_buf[0][pos], n);
+        check_rx_delimiter(&rx_bounce_buf[0][pos], n);
+        len += n;
+        pos = (pos + n) % ring_size;
+    }
+    rx_circ_pos = pos;
+    _rx_stats_bytes += len;
+    _rx_stats_dropped_bytes += len - written;
+    receive_timestamp_update();
+
+    if (rx_wait_done()) {
+        chEvtSignalI(_wait.thread_ctx, EVT_DATA);
+    }
+    if (_rts_is_active) {
+        update_rts_line();
+    }
+}
+#endif // HAL_UART_RX_DMA_CIRCULAR
 #endif
 
 void UARTDriver::dma_tx_deallocate(Shared_DMA *ctx)
@@ -572,7 +652,21 @@ void UARTDriver::rx_irq_cb(void* self)
     if (!uart_drv->rx_dma_enabled) {
         return;
     }
-#if defined(STM32F7) || defined(STM32H7)
+#if HAL_UART_RX_DMA_CIRCULAR
+    // line went idle, hand over the partial half of the ring without
+    // stopping the stream
+#if !(defined(STM32F7) || defined(STM32H7) || defined(STM32F3) || defined(STM32G4) || defined(STM32L4) || defined(STM32L4PLUS))
+    volatile uint16_t sr = ((SerialDriver*)(uart_drv->sdef.serial))->usart->SR;
+    if (!(sr & USART_SR_IDLE)) {
+        return;
+    }
+    volatile uint16_t dr = ((SerialDriver*)(uart_drv->sdef.serial))->usart->DR;
+    (void)dr;
+#endif
+    chSysLockFromISR();
+    uart_drv->dma_rx_copy_circular();
+    chSysUnlockFromISR();
+#elif defined(STM32F7) || defined(STM32H7)
     //disable dma, triggering DMA transfer complete interrupt
     uart_drv->rxdma->stream->CR &= ~STM32_DMA_CR_EN;
 #elif defined(STM32F3) || defined(STM32G4) || defined(STM32L4) || defined(STM32L4PLUS)
@@ -587,7 +681,7 @@ void UARTDriver::rx_irq_cb(void* self)
         //disable dma, triggering DMA transfer complete interrupt
         uart_drv->rxdma->stream->CR &= ~STM32_DMA_CR_EN;
     }
-#endif // STM32F7
+#endif // HAL_UART_RX_DMA_CIRCULAR
 #endif // HAL_USE_SERIAL
 }
 #endif
@@ -602,6 +696,17 @@ __RAMFUNC__ void UARTDriver::rxbuff_full_irq(void* self, uint32_t flags)
     if (!uart_drv->rx_dma_enabled) {
         return;
     }
+#if HAL_UART_RX_DMA_CIRCULAR
+    chSysLockFromISR();
+    uart_drv->dma_rx_copy_circular();
+    if (flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) {
+        // a transfer error stops the stream, start again from the
+        // beginning of the ring
+        dmaStreamDisable(uart_drv->rxdma);
+        uart_drv->dma_rx_enable();
+    }
+    chSysUnlockFromISR();
+#else
     uint16_t len = RX_BOUNCE_BUFSIZE - dmaStreamGetTransactionSize(uart_drv->rxdma);
     const uint8_t bounce_idx = uart_drv->rx_bounce_idx;
 
@@ -617,12 +722,13 @@ __RAMFUNC__ void UARTDriver::rxbuff_full_irq(void* self, uint32_t flags)
           we have data to copy out
          */
         const uint32_t written = uart_drv->_readbuf.write(uart_drv->rx_bounce_buf[bounce_idx], len);
+        uart_drv->check_rx_delimiter(uart_drv->rx_bounce_buf[bounce_idx], len);
         uart_drv->_rx_stats_bytes += len;
         uart_drv->_rx_stats_dropped_bytes += len - written;
         uart_drv->receive_timestamp_update();
     }
 
-    if (uart_drv->_wait.thread_ctx && uart_drv->_readbuf.available() >= uart_drv->_wait.n) {
+    if (uart_drv->rx_wait_done()) {
         chSysLockFromISR();
         chEvtSignalI(uart_drv->_wait.thread_ctx, EVT_DATA);
         chSysUnlockFromISR();
@@ -630,6 +736,7 @@ __RAMFUNC__ void UARTDriver::rxbuff_full_irq(void* self, uint32_t flags)
     if (uart_drv->_rts_is_active) {
         uart_drv->update_rts_line();
     }
+#endif // HAL_UART_RX_DMA_CIRCULAR
 #endif // HAL_USE_SERIAL
 }
 #endif // HAL_UART_NODMA
@@ -788,8 +895,31 @@ size_t UARTDriver::_write(const uint8_t *buffer, size_t size)
  */
 bool UARTDriver::wait_timeout(uint16_t n, uint32_t timeout_ms)
 {
+    return wait_rx(n, -1, timeout_ms);
+}
+
+/*
+  wait for the delimiter byte or n bytes to arrive, or a timeout
+ */
+bool UARTDriver::wait_frame_timeout(uint8_t delimiter, uint16_t n, uint32_t timeout_ms)
+{
+    return wait_rx(n, delimiter, timeout_ms);
+}
+
+bool UARTDriver::wait_rx(uint16_t n, int16_t delimiter, uint32_t timeout_ms)
+{
+    _wait.delimiter_seen = false;
+    _wait.delimiter = delimiter;
+    if (delimiter >= 0) {
+        // the delimiter may already be waiting for us
+        ByteBuffer::IoVec vec[2];
+        const auto n_vec = _readbuf.peekiovec(vec, _readbuf.available());
+        for (uint8_t i = 0; i < n_vec; i++) {
+            check_rx_delimiter(vec[i].data, vec[i].len);
+        }
+    }
     uint32_t t0 = AP_HAL::millis();
-    while (available() < n) {
+    while (available() < n && !_wait.delimiter_seen) {
         chEvtGetAndClearEvents(EVT_DATA);
         _wait.n = n;
         _wait.thread_ctx = chThdGetSelfX();
@@ -799,7 +929,9 @@ bool UARTDriver::wait_timeout(uint16_t n, uint32_t timeout_ms)
         }
         chEvtWaitAnyTimeout(EVT_DATA, chTimeMS2I(timeout_ms - (now - t0)));
     }
-    return available() >= n;
+    const bool ret = available() >= n || _wait.delimiter_seen;
+    _wait.delimiter = -1;
+    return ret;
 }
 
 #ifndef HAL_UART_NODMA
@@ -900,7 +1032,7 @@ void UARTDriver::write_pending_bytes_DMA(uint32_t n)
         dmaStreamSetTransactionSize(txdma, tx_len);
         uint32_t dmamode = STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
         dmamode |= STM32_DMA_CR_CHSEL(sdef.dma_tx_channel_id);
-        dmamode |= STM32_DMA_CR_PL(0);
+        dmamode |= STM32_DMA_CR_PL(dma_priority_level());
 #if defined(STM32H7)
         dmamode |= DMA_SxCR_TRBUFF;   // TRBUFF See 2.3.1 in the H743 errata
 #endif
@@ -1128,6 +1260,24 @@ void UARTDriver::_rx_timer_tick(void)
 #endif
 
 #ifndef HAL_UART_NODMA
+#if HAL_UART_RX_DMA_CIRCULAR
+    if (rx_dma_enabled && rxdma) {
+        chSysLock();
+        // the interrupts normally keep up, this catches anything
+        // left behind and restarts a stream stopped by an error
+#if defined(STM32F3) || defined(STM32G4) || defined(STM32L4) || defined(STM32L4PLUS)
+        const bool enabled = (rxdma->channel->CCR & STM32_DMA_CR_EN);
+#else
+        const bool enabled = (rxdma->stream->CR & STM32_DMA_CR_EN);
+#endif
+        dma_rx_copy_circular();
+        if (!enabled) {
+            dmaStreamDisable(rxdma);
+            dma_rx_enable();
+        }
+        chSysUnlock();
+    }
+#else
     if (rx_dma_enabled && rxdma) {
         chSysLock();
         //Check if DMA is enabled
@@ -1142,6 +1292,7 @@ void UARTDriver::_rx_timer_tick(void)
             uint8_t len = RX_BOUNCE_BUFSIZE - dmaStreamGetTransactionSize(rxdma);
             if (len != 0) {
                 const uint32_t written = _readbuf.write(rx_bounce_buf[rx_bounce_idx], len);
+                check_rx_delimiter(rx_bounce_buf[rx_bounce_idx], len);
                 _rx_stats_bytes += len;
                 _rx_stats_dropped_bytes += len - written;
 
@@ -1157,6 +1308,7 @@ void UARTDriver::_rx_timer_tick(void)
         }
         chSysUnlock();
     }
+#endif // HAL_UART_RX_DMA_CIRCULAR
 #endif
 
     // don't try IO on a disconnected USB port
@@ -1178,7 +1330,7 @@ void UARTDriver::_rx_timer_tick(void)
     {
         read_bytes_NODMA();
     }
-    if (_wait.thread_ctx && _readbuf.available() >= _wait.n) {
+    if (rx_wait_done()) {
         chEvtSignal(_wait.thread_ctx, EVT_DATA);
     }
 }
@@ -1213,6 +1365,9 @@ void UARTDriver::read_bytes_NODMA()
 #endif
         if (!hd_tx_active) {
             _readbuf.commit((unsigned)ret);
+            if (ret > 0) {
+                check_rx_delimiter(vec[i].data, ret);
+            }
             _rx_stats_bytes += ret;
             receive_timestamp_update();
         }
@@ -1268,7 +1423,7 @@ void UARTDriver::_tx_timer_tick(void)
     if (half_duplex) {
         WITH_SEMAPHORE(rx_sem);
         read_bytes_NODMA();
-        if (_wait.thread_ctx && _readbuf.available() >= _wait.n) {
+        if (rx_wait_done()) {
             chEvtSignal(_wait.thread_ctx, EVT_DATA);
         }
     }
@@ -25,6 +25,16 @@
 #define RX_BOUNCE_BUFSIZE 64U
 #define TX_BOUNCE_BUFSIZE 64U
 
+/*
+  with circular RX DMA the two bounce buffers are one contiguous ring
+  which the DMA engine never stops writing to. Data is copied out on
+  the half and full transfer interrupts and on line idle, so nothing
+  is lost while the stream is restarted at high baudrates
+ */
+#ifndef HAL_UART_RX_DMA_CIRCULAR
+#define HAL_UART_RX_DMA_CIRCULAR 1
+#endif
+
 // enough for serial0 to serial9, plus IOMCU
 #define UART_MAX_DRIVERS 11
 
@@ -87,6 +97,7 @@ public:
     };
 
     bool wait_timeout(uint16_t n, uint32_t timeout_ms) override;
+    bool wait_frame_timeout(uint8_t delimiter, uint16_t n, uint32_t timeout_ms) override;
 
     void set_flow_control(enum flow_control flow_control) override;
     enum flow_control get_flow_control(void) override { return _flow_control; }
@@ -175,13 +186,36 @@ private:
         thread_t *thread_ctx;
         // number of bytes needed
         uint16_t n;
+        // byte that also wakes the thread, or -1 for none
+        int16_t delimiter = -1;
+        volatile bool delimiter_seen;
     } _wait;
 
+    // common wait for n bytes or the delimiter
+    bool wait_rx(uint16_t n, int16_t delimiter, uint32_t timeout_ms);
+
+    // note the delimiter if it is in newly received data
+    void check_rx_delimiter(const uint8_t *data, uint32_t len) {
+        if (_wait.delimiter >= 0 && !_wait.delimiter_seen &&
+            memchr(data, _wait.delimiter, len) != nullptr) {
+            _wait.delimiter_seen = true;
+        }
+    }
+
+    // true if a thread is waiting and what it waits for has arrived
+    bool rx_wait_done(void) {
+        return _wait.thread_ctx && (_wait.delimiter_seen || _readbuf.available() >= _wait.n);
+    }
+
     // we use in-task ring buffers to reduce the system call cost
     // of ::read() and ::write() in the main loop
 #ifndef HAL_UART_NODMA
     volatile uint8_t rx_bounce_idx;
     uint8_t *rx_bounce_buf[2];
+#if HAL_UART_RX_DMA_CIRCULAR
+    // offset in the RX ring that we have copied out up to
+    volatile uint16_t rx_circ_pos;
+#endif
     uint8_t *tx_bounce_buf;
     uint16_t contention_counter;
 #endif
@@ -252,6 +286,11 @@ private:
     void dma_tx_allocate(Shared_DMA *ctx);
     void dma_tx_deallocate(Shared_DMA *ctx);
     void dma_rx_enable(void);
+#if HAL_UART_RX_DMA_CIRCULAR
+    void dma_rx_copy_circular(void);
+#endif
+    // DMA arbiter priority, favouring high baudrate links
+    uint32_t dma_priority_level(void) const;
 #endif
     void update_rts_line(void);
 
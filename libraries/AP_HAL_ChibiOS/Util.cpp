@@ -30,6 +30,7 @@
 #include <AP_InternalError/AP_InternalError.h>
 #include "sdcard.h"
 #include "shared_dma.h"
+#include "Device.h"
 #if defined(HAL_PWM_ALARM) || HAL_DSHOT_ALARM_ENABLED || HAL_CANMANAGER_ENABLED || HAL_USE_PWM == TRUE
 #include <AP_Notify/AP_Notify.h>
 #endif
@@ -699,6 +700,27 @@ void Util::timer_info(ExpandingString &str)
 }
 #endif
 
+#if HAL_BUS_STATS_ENABLED
+// request information on SPI and I2C bus usage
+void Util::bus_info(ExpandingString &str)
+{
+    str.printf("BUSV1\n");
+#if HAL_USE_I2C == TRUE || HAL_USE_SPI == TRUE || HAL_USE_WSPI == TRUE
+    DeviceBus::bus_info(str);
+#endif
+}
+
+#if HAL_LOGGING_ENABLED
+// log bus usage of each device
+void Util::bus_log()
+{
+#if HAL_USE_I2C == TRUE || HAL_USE_SPI == TRUE || HAL_USE_WSPI == TRUE
+    DeviceBus::bus_log();
+#endif
+}
+#endif
+#endif // HAL_BUS_STATS_ENABLED
+
 /**
  * This method will generate random values with set size. It will fall back to AP_Math's get_random16()
  * if True RNG fails or enough entropy is not present.
@@ -751,14 +773,21 @@ bool Util::get_true_random_vals(uint8_t* data, size_t size, uint32_t timeout_us)
 }
 
 /*
-  log info on stack usage. Called at 1Hz by logging thread, logs next
-  thread on each call
+  log info on stack usage and cpu load. Called at 10Hz by logging
+  thread, logs next thread on each call. The ISR entry ends a round,
+  after which the shared DMA contention is logged and the thread
+  statistics are restarted so the load of each thread is over the
+  time since then
 */
 void Util::log_stack_info(void)
 {
 #if HAL_LOGGING_ENABLED
     static thread_t *last_tp;
     static uint8_t thread_id;
+#if HAL_ENABLE_THREAD_STATISTICS
+    static rtcnt_t round_start;
+    const rtcnt_t round_cycles = chSysGetRealtimeCounterX() - round_start;
+#endif
     thread_t *tp = last_tp;
     if (tp == nullptr) {
         tp = chRegFirstThread();
@@ -778,6 +807,9 @@ void Util::log_stack_info(void)
         pkt.stack_total = isr_stack_size;
         pkt.stack_free = stack_free(&__main_stack_base__);
         strncpy_noterm(pkt.name, "ISR", sizeof(pkt.name));
+#if HAL_ENABLE_THREAD_STATISTICS
+        pkt.load = thread_load(currcore->kernel_stats.m_crit_isr.cumulative, round_cycles);
+#endif
     } else {
         if (tp->wabase == (void*)&__main_thread_stack_base__) {
             // main thread has its stack separated from the thread context
@@ -791,12 +823,53 @@ void Util::log_stack_info(void)
         pkt.priority = tp->realprio,
         pkt.stack_free = stack_free(tp->wabase);
         strncpy_noterm(pkt.name, tp->name, sizeof(pkt.name));
+#if HAL_ENABLE_THREAD_STATISTICS
+        pkt.load = thread_load(tp->stats.cumulative, round_cycles);
+#endif
     }
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
     last_tp = tp;
+
+    if (tp != nullptr) {
+        return;
+    }
+
+#if AP_HAL_SHARED_DMA_ENABLED
+    struct log_DMA dma {
+        LOG_PACKET_HEADER_INIT(LOG_DMA_MSG),
+        time_us         : pkt.time_us,
+    };
+    if (ChibiOS::Shared_DMA::get_contention_totals(dma.transactions, dma.uncontended_locks, dma.contended_locks)) {
+        AP::logger().WriteBlock(&dma, sizeof(dma));
+    }
+#endif
+
+#if HAL_ENABLE_THREAD_STATISTICS
+    // restart the statistics for the next round
+    for (thread_t *t = chRegFirstThread(); t; t = chRegNextThread(t)) {
+        if (t != chThdGetSelfX()) {
+            chTMObjectInit(&t->stats);
+        } else {
+            t->stats.cumulative = 0U;
+        }
+    }
+    currcore->kernel_stats.m_crit_isr.cumulative = 0U;
+    round_start = chSysGetRealtimeCounterX();
+#endif
 #endif
 }
 
+#if HAL_ENABLE_THREAD_STATISTICS
+// load in 0.1% units of cumulative cycles over elapsed cycles
+uint16_t Util::thread_load(uint64_t cumulative, rtcnt_t elapsed)
+{
+    if (elapsed == 0) {
+        return 0;
+    }
+    return MIN(uint64_t(1000), cumulative * 1000U / elapsed);
+}
+#endif
+
 #if AP_CRASHDUMP_ENABLED
 size_t Util::last_crash_dump_size() const
 {
@@ -106,6 +106,16 @@ public:
 #if HAL_USE_PWM == TRUE
     void timer_info(ExpandingString &str) override;
 #endif
+
+#if HAL_BUS_STATS_ENABLED
+    // request information on SPI and I2C bus usage
+    void bus_info(ExpandingString &str) override;
+
+#if HAL_LOGGING_ENABLED
+    // log bus usage of each device
+    void bus_log() override;
+#endif
+#endif // HAL_BUS_STATS_ENABLED
     // returns random values
     bool get_random_vals(uint8_t* data, size_t size) override;
 
@@ -148,8 +158,11 @@ private:
     bool get_persistent_params(ExpandingString &str) const;
 #endif
 
-    // log info on stack usage
+    // log info on stack usage, thread load and DMA contention
     void log_stack_info(void) override;
+#if HAL_ENABLE_THREAD_STATISTICS
+    static uint16_t thread_load(uint64_t cumulative, rtcnt_t elapsed);
+#endif
 
 #if AP_CRASHDUMP_ENABLED
     // get last crash dump
@@ -139,10 +139,13 @@ static void *malloc_flags(size_t size, uint32_t flags)
         size = (size + (DMA_ALIGNMENT-1)) & ~(DMA_ALIGNMENT-1);
     }
 
-    // if no flags are set or this is a DMA request and default heap
-    // is DMA safe then start with default heap
+    // if no flags are set or this is a DMA or fast memory request and
+    // the default heap has that property then start with default
+    // heap. On H7 the default heap is usually DTCM
     if (flags == 0 || (flags == MEM_REGION_FLAG_DMA_OK &&
-                       (memory_regions[0].flags & MEM_REGION_FLAG_DMA_OK))) {
+                       (memory_regions[0].flags & MEM_REGION_FLAG_DMA_OK)) ||
+        (flags == MEM_REGION_FLAG_FAST &&
+         (memory_regions[0].flags & MEM_REGION_FLAG_FAST))) {
         p = chHeapAllocAligned(NULL, size, alignment);
         if (p) {
             goto found;
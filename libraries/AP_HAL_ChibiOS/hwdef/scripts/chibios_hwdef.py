@@ -2524,6 +2524,7 @@ Please run: Tools/scripts/build_bootloaders.py %s
                 dma_exclude=self.get_dma_exclude(self.periph_list),
                 dma_priority=self.get_config('DMA_PRIORITY', default='TIM* SPI*', spaces=True),
                 dma_noshare=self.dma_noshare,
+                dma_rate=self.get_config('DMA_RATE', default='', aslist=True),
                 quiet=self.quiet,
             )
 
@@ -36,6 +36,14 @@
 #define AP_WATCHDOG_SAVE_FAULT_ENABLED 0
 #endif
 
+#ifndef HAL_BUS_STATS_ENABLED
+#define HAL_BUS_STATS_ENABLED 0
+#endif
+
+#ifndef HAL_DEVICE_TRANSFER_QUEUE_ENABLED
+#define HAL_DEVICE_TRANSFER_QUEUE_ENABLED 0
+#endif
+
 // less LWIP functionality in the bootloader
 #define LWIP_DHCP 0
 #define LWIP_UDP 1
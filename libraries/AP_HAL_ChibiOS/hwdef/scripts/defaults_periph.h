@@ -80,6 +80,10 @@
 #define HAL_UART_STATS_ENABLED (HAL_GCS_ENABLED || HAL_LOGGING_ENABLED)
 #endif
 
+#ifndef HAL_BUS_STATS_ENABLED
+#define HAL_BUS_STATS_ENABLED 0
+#endif
+
 #ifndef HAL_SUPPORT_RCOUT_SERIAL
 #define HAL_SUPPORT_RCOUT_SERIAL 0
 #endif
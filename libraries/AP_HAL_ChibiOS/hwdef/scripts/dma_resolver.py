@@ -118,6 +118,19 @@ def get_list_index(peripheral, priority_list):
     # default to max priority
     return len(priority_list)
 
+def get_rate(peripheral, rate_list):
+    '''return the declared transfer rate for a peripheral from a list of
+    PATTERN:RATE items, or zero if it has none'''
+    for item in rate_list:
+        (pattern, rate) = item.split(':')
+        if fnmatch.fnmatch(peripheral, pattern):
+            return int(rate)
+    return 0
+
+def get_sharing_rate(periph_list, rate_list):
+    '''get the total declared rate of a list of peripherals we could share with'''
+    return sum([get_rate(p, rate_list) for p in periph_list])
+
 def get_sharing_priority(periph_list, priority_list):
     '''get priority of a list of peripherals we could share with'''
     highest = len(priority_list)
@@ -293,7 +306,7 @@ def forbidden_list(p, peripheral_list):
 
 
 def write_dma_header(f, peripheral_list, mcu_type, dma_exclude=[],
-                     dma_priority='', dma_noshare=[], quiet=False):
+                     dma_priority='', dma_noshare=[], dma_rate=[], quiet=False):
     '''write out a DMA resolver header file'''
     global dma_map, have_DMAMUX, has_bdshot
     timer_ch_periph = []
@@ -307,8 +320,9 @@ def write_dma_header(f, peripheral_list, mcu_type, dma_exclude=[],
     # form a list of DMA priorities
     priority_list = dma_priority.split()
 
-    # sort by priority
-    peripheral_list = sorted(peripheral_list, key=lambda x: get_list_index(x, priority_list))
+    # sort by priority, and within a priority by declared rate so the
+    # busiest peripherals get the unshared streams
+    peripheral_list = sorted(peripheral_list, key=lambda x: (get_list_index(x, priority_list), -get_rate(x, dma_rate)))
 
     # form a list of peripherals that can't share
     noshare_list = dma_noshare[:]
@@ -415,8 +429,10 @@ def write_dma_header(f, peripheral_list, mcu_type, dma_exclude=[],
             if share_ok:
                 share_possibility.append(stream)
         if share_possibility:
-            # sort the possible sharings so minimise impact on high priority streams
-            share_possibility = sorted(share_possibility, key=lambda x: get_sharing_priority(stream_assign[x], priority_list))
+            # sort the possible sharings so minimise impact on high
+            # priority streams, then on streams with the most traffic
+            share_possibility = sorted(share_possibility, key=lambda x: (get_sharing_priority(stream_assign[x], priority_list),
+                                                                         -get_sharing_rate(stream_assign[x], dma_rate)))
             # and take the one with the least impact (lowest value for highest priority stream share)
             stream = share_possibility[-1]
             if debug:
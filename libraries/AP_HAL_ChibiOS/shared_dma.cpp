@@ -281,5 +281,24 @@ void Shared_DMA::dma_info(ExpandingString &str)
     }
 }
 
+bool Shared_DMA::get_contention_totals(uint32_t &transactions, uint32_t &uncontended_locks, uint32_t &contended_locks)
+{
+    if (_contention_stats == nullptr) {
+        _contention_stats = NEW_NOTHROW dma_stats[SHARED_DMA_MAX_STREAM_ID+1];
+        return false;
+    }
+    transactions = 0;
+    uncontended_locks = 0;
+    contended_locks = 0;
+    for (uint8_t i = 0; i < SHARED_DMA_MAX_STREAM_ID; i++) {
+        transactions += _contention_stats[i].transactions;
+        uncontended_locks += _contention_stats[i].uncontended_locks;
+        contended_locks += _contention_stats[i].contended_locks;
+        _contention_stats[i].contended_locks = 0;
+        _contention_stats[i].uncontended_locks = 0;
+    }
+    return true;
+}
+
 #endif // CH_CFG_USE_SEMAPHORES
 
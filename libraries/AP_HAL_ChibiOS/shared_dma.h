@@ -67,6 +67,11 @@ public:
     // display dma contention statistics as text buffer for @SYS/dma.txt
     static void dma_info(ExpandingString &str);
 
+    // get the total transactions and the contended and uncontended
+    // locks over all streams since the last call or dma_info(). The
+    // first call starts counting and returns false
+    static bool get_contention_totals(uint32_t &transactions, uint32_t &uncontended_locks, uint32_t &contended_locks);
+
     // return true if a stream ID is shared between two peripherals
     static bool is_shared(uint8_t stream_id);
     bool is_shared();
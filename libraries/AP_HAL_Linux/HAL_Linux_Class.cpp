@@ -5,6 +5,7 @@
 #include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <AP_HAL/AP_HAL.h>
@@ -319,6 +320,42 @@ void _usage(void)
     printf("\tcpu affinity:\n");
     printf("\t                   --cpu-affinity 1 (single cpu) or 1,3 (multiple cpus) or 1-3 (range of cpus)\n");
     printf("\t                   -c 1 (single cpu) or 1,3 (multiple cpus) or 1-3 (range of cpus)\n");
+    printf("\tper-thread cpu affinity and SCHED_FIFO priority, may be repeated:\n");
+    printf("\t                   --thread-affinity main=3 (main loop on cpu 3)\n");
+    printf("\t                   --thread-affinity ap-timer=2:15 (timer thread on cpu 2 at priority 15)\n");
+    printf("\t                   --thread-affinity ap-*=0-1 (threads with names starting ap- on cpus 0 and 1)\n");
+}
+
+/*
+  parse a --thread-affinity argument of the form name=cpus[:prio]
+ */
+static bool parse_thread_affinity(const char *arg)
+{
+    char buf[64];
+    if (strlen(arg) >= sizeof(buf)) {
+        return false;
+    }
+    strcpy(buf, arg);
+    char *cpus = strchr(buf, '=');
+    if (cpus == nullptr || cpus == buf) {
+        return false;
+    }
+    *cpus++ = '\0';
+    unsigned long prio = 0;
+    char *prio_str = strchr(cpus, ':');
+    if (prio_str != nullptr) {
+        *prio_str++ = '\0';
+        char *endptr;
+        prio = strtoul(prio_str, &endptr, 10);
+        if (endptr == prio_str || *endptr != '\0' || prio < 1 || prio > 99) {
+            return false;
+        }
+    }
+    cpu_set_t cpu_set;
+    if (!utilInstance.parse_cpu_set(cpus, &cpu_set)) {
+        return false;
+    }
+    return schedulerInstance.add_thread_affinity(buf, cpu_set, prio);
 }
 
 void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
@@ -338,6 +375,7 @@ void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
         CMDLINE_SERIAL7,
         CMDLINE_SERIAL8,
         CMDLINE_SERIAL9,
+        CMDLINE_THREAD_AFFINITY,
     };
 
     int opt;
@@ -368,6 +406,7 @@ void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
         {"module-directory",    true,  0, 'M'},
         {"defaults",            true,  0, 'd'},
         {"cpu-affinity",        true,  0, 'c'},
+        {"thread-affinity",     true,  0, CMDLINE_THREAD_AFFINITY},
         {"help",                false,  0, 'h'},
         {0, false, 0, 0}
     };
@@ -437,6 +476,12 @@ void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
             }
             Linux::Scheduler::from(scheduler)->set_cpu_affinity(cpu_affinity);
             break;
+        case CMDLINE_THREAD_AFFINITY:
+            if (!parse_thread_affinity(gopt.optarg)) {
+                fprintf(stderr, "Could not parse thread affinity: %s\n", gopt.optarg);
+                exit(1);
+            }
+            break;
         case 'h':
             _usage();
             exit(0);
@@ -170,7 +170,7 @@ void OpticalFlow_Onboard::init()
         AP_HAL::panic("OpticalFlow_Onboard: failed to create thread");
     }
 
-    _gyro_ring_buffer = NEW_NOTHROW ObjectBuffer<GyroSample>(OPTICAL_FLOW_GYRO_BUFFER_LEN);
+    _gyro_ring_buffer = NEW_NOTHROW ObjectBuffer_SPSC<GyroSample>(OPTICAL_FLOW_GYRO_BUFFER_LEN);
     if (_gyro_ring_buffer != nullptr && _gyro_ring_buffer->get_size() == 0) {
         // allocation failed
         delete _gyro_ring_buffer;
@@ -5,6 +5,7 @@
 #include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <sys/time.h>
 #include <unistd.h>
@@ -62,6 +63,7 @@ extern const AP_HAL::HAL& hal;
 Scheduler::Scheduler()
 {
     CPU_ZERO(&_cpu_affinity);
+    CPU_ZERO(&_default_affinity);
 }
 
 
@@ -99,6 +101,68 @@ void Scheduler::init_cpu_affinity()
     }
 }
 
+bool Scheduler::add_thread_affinity(const char *name, const cpu_set_t &cpus, uint8_t prio)
+{
+    if (_num_thread_affinity >= ARRAY_SIZE(_thread_affinity) ||
+        strlen(name) >= sizeof(_thread_affinity[0].name)) {
+        return false;
+    }
+    ThreadAffinity &a = _thread_affinity[_num_thread_affinity++];
+    strncpy(a.name, name, sizeof(a.name));
+    a.cpus = cpus;
+    a.prio = prio;
+    return true;
+}
+
+const Scheduler::ThreadAffinity *Scheduler::find_thread_affinity(const char *name) const
+{
+    if (name == nullptr) {
+        return nullptr;
+    }
+    for (uint8_t i = 0; i < _num_thread_affinity; i++) {
+        const ThreadAffinity &a = _thread_affinity[i];
+        const size_t len = strlen(a.name);
+        if (len > 0 && a.name[len-1] == '*') {
+            if (strncmp(a.name, name, len-1) == 0) {
+                return &a;
+            }
+        } else if (strcmp(a.name, name) == 0) {
+            return &a;
+        }
+    }
+    return nullptr;
+}
+
+bool Scheduler::start_thread(Thread &thread, const char *name, int policy, int prio)
+{
+    const ThreadAffinity *a = find_thread_affinity(name);
+    if (a == nullptr) {
+        return thread.start(name, policy, prio, &_default_affinity);
+    }
+    if (a->prio != 0) {
+        prio = a->prio;
+    }
+    return thread.start(name, policy, prio, &a->cpus);
+}
+
+void Scheduler::init_main_thread_affinity()
+{
+    const ThreadAffinity *a = find_thread_affinity("main");
+    if (a == nullptr) {
+        return;
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(a->cpus), &a->cpus) != 0) {
+        AP_HAL::panic("Failed to set affinity for main thread: %m");
+    }
+    if (a->prio != 0 && geteuid() == 0) {
+        struct sched_param param = { .sched_priority = a->prio };
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == -1) {
+            AP_HAL::panic("Scheduler: failed to set main thread priority: %s",
+                          strerror(errno));
+        }
+    }
+}
+
 void Scheduler::init()
 {
     int ret;
@@ -119,6 +183,9 @@ void Scheduler::init()
 
     init_realtime();
     init_cpu_affinity();
+    if (sched_getaffinity(0, sizeof(_default_affinity), &_default_affinity) != 0) {
+        CPU_ZERO(&_default_affinity);
+    }
 
     /* set barrier to N + 1 threads: worker threads + main */
     unsigned n_threads = ARRAY_SIZE(sched_table) + 1;
@@ -133,9 +200,11 @@ void Scheduler::init()
 
         t->thread->set_rate(t->rate);
         t->thread->set_stack_size(1024 * 1024);
-        t->thread->start(t->name, t->policy, t->prio);
+        start_thread(*t->thread, t->name, t->policy, t->prio);
     }
 
+    init_main_thread_affinity();
+
 #if defined(DEBUG_STACK) && DEBUG_STACK
     register_timer_process(FUNCTOR_BIND_MEMBER(&Scheduler::_debug_stack, void));
 #endif
@@ -278,9 +347,35 @@ void Scheduler::_run_io(void)
  */
 void Scheduler::_run_uarts()
 {
+    /*
+      find out which devices have data waiting with a single poll()
+      instead of a read() per device that mostly fails with EAGAIN.
+      Devices without a file descriptor are read on every tick
+     */
+    struct pollfd fds[AP_HAL::HAL::num_serial];
+    int8_t fd_idx[AP_HAL::HAL::num_serial];
+    nfds_t nfds = 0;
+
+    for (uint8_t i=0; i<hal.num_serial; i++) {
+        fd_idx[i] = -1;
+        const int fd = UARTDriver::from(hal.serial(i))->get_read_fd();
+        if (fd < 0) {
+            continue;
+        }
+        fds[nfds].fd = fd;
+        fds[nfds].events = POLLIN;
+        fds[nfds].revents = 0;
+        fd_idx[i] = nfds++;
+    }
+
+    const bool polled = nfds > 0 && ::poll(fds, nfds, 0) >= 0;
+
     // process any pending serial bytes
     for (uint8_t i=0;i<hal.num_serial; i++) {
-        hal.serial(i)->_timer_tick();
+        UARTDriver *uart = UARTDriver::from(hal.serial(i));
+        // errors and hang ups are left to the device's read() to handle
+        uart->set_read_ready(!polled || fd_idx[i] < 0 || fds[fd_idx[i]].revents != 0);
+        uart->_timer_tick();
     }
 }
 
@@ -424,7 +519,7 @@ bool Scheduler::thread_create(AP_HAL::MemberProc proc, const char *name, uint32_
      */
     thread->set_auto_free(true);
 
-    if (!thread->start(name, SCHED_FIFO, thread_priority)) {
+    if (!start_thread(*thread, name, SCHED_FIFO, thread_priority)) {
         delete thread;
         return false;
     }
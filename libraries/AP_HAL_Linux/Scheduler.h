@@ -10,6 +10,7 @@
 #define LINUX_SCHEDULER_MAX_TIMER_PROCS 10
 #define LINUX_SCHEDULER_MAX_TIMESLICED_PROCS 10
 #define LINUX_SCHEDULER_MAX_IO_PROCS 10
+#define LINUX_SCHEDULER_MAX_THREAD_AFFINITY 16
 
 #define AP_LINUX_SENSORS_STACK_SIZE  256 * 1024
 #define AP_LINUX_SENSORS_SCHED_POLICY  SCHED_FIFO
@@ -60,6 +61,16 @@ public:
      */
     void set_cpu_affinity(const cpu_set_t &cpu_affinity) { _cpu_affinity = cpu_affinity; }
 
+    /*
+      set the cpus and optionally the SCHED_FIFO priority of the
+      threads called name, applied when they start. A name ending in
+      '*' matches any thread starting with the rest of it and "main"
+      is the main loop thread. A prio of zero keeps the default
+      priority. Must be called before init(); returns false if the
+      table is full or the name is too long
+     */
+    bool add_thread_affinity(const char *name, const cpu_set_t &cpus, uint8_t prio);
+
 private:
     class SchedulerThread : public PeriodicThread {
     public:
@@ -78,6 +89,21 @@ private:
 
     void     init_cpu_affinity();
 
+    struct ThreadAffinity {
+        char name[16];
+        cpu_set_t cpus;
+        uint8_t prio;
+    };
+
+    // return the first affinity entry matching name, or nullptr
+    const ThreadAffinity *find_thread_affinity(const char *name) const;
+
+    // start a thread with the affinity and priority configured for its name
+    bool start_thread(Thread &thread, const char *name, int policy, int prio);
+
+    // apply any affinity and priority configured for the main thread
+    void init_main_thread_affinity();
+
     void _wait_all_threads();
 
     void     _debug_stack();
@@ -117,6 +143,14 @@ private:
 
     Semaphore _io_semaphore;
     cpu_set_t _cpu_affinity;
+
+    // affinity of the process after init_cpu_affinity(), given to
+    // threads without an entry so they don't inherit a pinned
+    // creator's affinity
+    cpu_set_t _default_affinity;
+
+    ThreadAffinity _thread_affinity[LINUX_SCHEDULER_MAX_THREAD_AFFINITY];
+    uint8_t _num_thread_affinity;
 };
 
 }
@@ -19,6 +19,11 @@ public:
     virtual ssize_t write(const uint8_t *buf, uint16_t n) override;
     virtual ssize_t read(uint8_t *buf, uint16_t n) override;
 
+    // the listener is readable when a connection is waiting to be accepted
+    virtual int get_read_fd() const override {
+        return sock != nullptr ? sock->get_read_fd() : listener.get_read_fd();
+    }
+
 private:
     SocketAPM_native listener{false};
     SocketAPM_native *sock = nullptr;
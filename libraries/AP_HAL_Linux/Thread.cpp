@@ -158,7 +158,7 @@ size_t Thread::get_stack_usage()
     return result;
 }
 
-bool Thread::start(const char *name, int policy, int prio)
+bool Thread::start(const char *name, int policy, int prio, const cpu_set_t *affinity)
 {
     if (_started) {
         return false;
@@ -184,6 +184,14 @@ bool Thread::start(const char *name, int policy, int prio)
         }
     }
 
+    if (affinity != nullptr && CPU_COUNT(affinity) > 0) {
+        r = pthread_attr_setaffinity_np(&attr, sizeof(*affinity), affinity);
+        if (r != 0) {
+            AP_HAL::panic("Failed to set affinity for thread '%s': %s",
+                          name, strerror(r));
+        }
+    }
+
     if (_stack_size) {
         if (pthread_attr_setstacksize(&attr, _stack_size) != 0) {
             return false;
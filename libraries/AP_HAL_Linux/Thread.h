@@ -35,7 +35,11 @@ public:
 
     virtual ~Thread() { }
 
-    bool start(const char *name, int policy, int prio);
+    /*
+     * Start the thread. If affinity is non-null the thread only runs on
+     * those cpus, otherwise it inherits the affinity of the caller.
+     */
+    bool start(const char *name, int policy, int prio, const cpu_set_t *affinity = nullptr);
 
     bool is_current_thread();
 
@@ -390,6 +390,11 @@ void UARTDriver::_timer_tick(void)
         num_send--;
     }
 
+    if (!_read_ready) {
+        _in_timer = false;
+        return;
+    }
+
     // try to fill the read buffer
     int ret;
     ByteBuffer::IoVec vec[2];
@@ -415,6 +420,14 @@ void UARTDriver::_timer_tick(void)
     _in_timer = false;
 }
 
+int UARTDriver::get_read_fd() const
+{
+    if (!_initialised || !_device) {
+        return -1;
+    }
+    return _device->get_read_fd();
+}
+
 void UARTDriver::configure_parity(uint8_t v) {
     UARTDriver::parity = v;
     _device->set_parity(v);
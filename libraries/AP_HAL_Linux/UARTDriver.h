@@ -27,6 +27,18 @@ public:
     bool _write_pending_bytes(void);
     virtual void _timer_tick(void) override;
 
+    /*
+      file descriptor the uart thread can poll for incoming data, or -1
+      if the device has to be read on every tick
+     */
+    int get_read_fd() const;
+
+    /*
+      set by the uart thread before _timer_tick() from the result of
+      polling get_read_fd(), so idle devices are not read
+     */
+    void set_read_ready(bool ready) { _read_ready = ready; }
+
     virtual enum flow_control get_flow_control(void) override
     {
         return _device->get_flow_control();
@@ -68,6 +80,7 @@ private:
     char *_flag;
     bool _connected; // true if a client has connected
     bool _packetise; // true if writes should try to be on mavlink boundaries
+    bool _read_ready = true; // false if polling showed no data to read
 
     void _allocate_buffers(uint16_t rxS, uint16_t txS);
     void _deallocate_buffers();
@@ -1,3 +1,4 @@
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <stdarg.h>
@@ -8,6 +9,7 @@
 #include <unistd.h>
 
 #include <AP_HAL/AP_HAL.h>
+#include <AP_Common/ExpandingString.h>
 
 #include "Heat_Pwm.h"
 #include "Util.h"
@@ -206,6 +208,102 @@ int Util::read_file(const char *path, const char *fmt, ...)
     return ret;
 }
 
+/*
+  report the threads of this process with the cpus they may run on,
+  their real-time priority, the cpu load since the last call and
+  their involuntary context switches, which show how often a thread
+  was preempted and so how isolated its cpu is
+ */
+void Util::thread_info(ExpandingString &str)
+{
+    WITH_SEMAPHORE(_thread_info_sem);
+
+    const uint64_t now_us = AP_HAL::micros64();
+    const float dt = (now_us - _thread_sample_us) * 1.0e-6f;
+    const bool have_samples = _thread_sample_us != 0;
+    const long ticks_per_sec = sysconf(_SC_CLK_TCK);
+
+    DIR *d = opendir("/proc/self/task");
+    if (d == nullptr) {
+        return;
+    }
+
+    struct thread_sample samples[ARRAY_SIZE(_thread_samples)];
+    uint8_t num_samples = 0;
+
+    str.printf("ThreadsV2\n");
+    struct dirent *de;
+    while ((de = readdir(d)) != nullptr) {
+        if (de->d_name[0] == '.') {
+            continue;
+        }
+        const pid_t tid = atoi(de->d_name);
+        char path[64];
+        char line[256];
+
+        // the name is in brackets and may contain spaces, so the
+        // fields are found from the last bracket
+        snprintf(path, sizeof(path), "/proc/self/task/%d/stat", int(tid));
+        FILE *f = fopen(path, "re");
+        if (f == nullptr) {
+            continue;
+        }
+        const bool got_stat = fgets(line, sizeof(line), f) != nullptr;
+        fclose(f);
+        char *name = strchr(line, '(');
+        char *name_end = strrchr(line, ')');
+        if (!got_stat || name == nullptr || name_end == nullptr || name_end < name) {
+            continue;
+        }
+        *name_end = '\0';
+        name++;
+        unsigned long utime, stime;
+        long priority;
+        if (sscanf(name_end + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu %*d %*d %ld",
+                   &utime, &stime, &priority) != 3) {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "/proc/self/task/%d/status", int(tid));
+        char cpus[32] = "?";
+        unsigned long long nvcsw = 0;
+        f = fopen(path, "re");
+        if (f != nullptr) {
+            while (fgets(line, sizeof(line), f) != nullptr) {
+                sscanf(line, "Cpus_allowed_list: %31s", cpus);
+                sscanf(line, "nonvoluntary_ctxt_switches: %llu", &nvcsw);
+            }
+            fclose(f);
+        }
+
+        const uint64_t ticks = utime + stime;
+        float load = 0;
+        uint64_t nvcsw_delta = 0;
+        for (uint8_t i = 0; have_samples && i < _num_thread_samples; i++) {
+            if (_thread_samples[i].tid == tid) {
+                if (dt > 0 && ticks_per_sec > 0) {
+                    load = 100.0f * (ticks - _thread_samples[i].ticks) / (ticks_per_sec * dt);
+                }
+                nvcsw_delta = nvcsw - _thread_samples[i].nvcsw;
+                break;
+            }
+        }
+        if (num_samples < ARRAY_SIZE(samples)) {
+            samples[num_samples++] = { tid, ticks, nvcsw };
+        }
+
+        // SCHED_FIFO threads report a priority of -1 - rt_priority
+        str.printf("%-15.15s TID=%6d PRI=%3ld CPUS=%-8s LOAD=%5.1f%% NVCSW=%llu (+%llu)\n",
+                   name, int(tid), priority < 0 ? -1 - priority : 0, cpus, load,
+                   nvcsw, (unsigned long long)nvcsw_delta);
+    }
+    closedir(d);
+
+    memcpy(_thread_samples, samples, num_samples * sizeof(samples[0]));
+    _num_thread_samples = num_samples;
+    _thread_sample_us = now_us;
+}
+
 const char *Linux::Util::_hw_names[UTIL_NUM_HARDWARES] = {
     [UTIL_HARDWARE_RPI1]   = "BCM2708",
     [UTIL_HARDWARE_RPI2]   = "BCM2709",
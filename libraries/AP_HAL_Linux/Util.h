@@ -95,6 +95,9 @@ public:
     // fills data with random values of requested size
     bool get_random_vals(uint8_t* data, size_t size) override;
 
+    // per-thread cpus, priority, load and context switches from /proc
+    void thread_info(ExpandingString &str) override;
+
 private:
 #if CONFIG_HAL_BOARD_SUBTYPE == HAL_BOARD_SUBTYPE_LINUX_DISCO
     static ToneAlarm_Disco _toneAlarm;
@@ -109,6 +112,17 @@ private:
     const char *custom_storage_directory = nullptr;
     const char *custom_defaults = HAL_PARAM_DEFAULTS_PATH;
     static const char *_hw_names[UTIL_NUM_HARDWARES];
+
+    // cpu time and involuntary context switches of each thread at
+    // the last thread_info() call, for the load and switches since then
+    struct thread_sample {
+        pid_t tid;
+        uint64_t ticks;
+        uint64_t nvcsw;
+    } _thread_samples[32];
+    uint8_t _num_thread_samples;
+    uint64_t _thread_sample_us;
+    HAL_Semaphore _thread_info_sem;
 };
 
 }
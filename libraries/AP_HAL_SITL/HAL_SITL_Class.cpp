@@ -288,6 +288,9 @@ void HAL_SITL::run(int argc, char * const argv[], Callbacks* callbacks) const
         }
         callbacks->loop();
         HALSITL::Scheduler::_run_io_procs();
+#if !defined(HAL_BUILD_AP_PERIPH)
+        _sitl_state->snapshot_update();
+#endif
 
         uint32_t now = AP_HAL::millis();
         if (now - last_watchdog_save >= 100 && using_watchdog) {
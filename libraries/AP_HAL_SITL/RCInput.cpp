@@ -17,7 +17,11 @@ void RCInput::init()
 
 bool RCInput::new_input()
 {
-    return AP::RC().new_input();
+    if (!AP::RC().new_input()) {
+        return false;
+    }
+    _last_input_us = AP_HAL::micros();
+    return true;
 }
 
 uint16_t RCInput::read(uint8_t ch)
@@ -12,9 +12,13 @@ public:
     explicit RCInput() {}
     void init() override;
     bool new_input() override;
+    uint32_t last_input_us() const override { return _last_input_us; }
     uint8_t num_channels() override;
     uint16_t read(uint8_t ch) override;
     uint8_t read(uint16_t* periods, uint8_t len) override;
+
+private:
+    uint32_t _last_input_us;
 };
 
 #endif
@@ -29,6 +29,14 @@ extern const AP_HAL::HAL& hal;
 
 using namespace HALSITL;
 
+// monotonic wall clock time in microseconds
+static uint64_t wall_time_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000ULL);
+}
+
 void SITL_State::_set_param_default(const char *parm)
 {
     char *pdup = strdup(parm);
@@ -115,10 +123,21 @@ void SITL_State::_sitl_setup()
  */
 void SITL_State::_fdm_input_step(void)
 {
+    if (_lockstep.group != nullptr) {
+        _lockstep_wait();
+    }
+
+    const uint64_t physics_start_us = _max_speed ? wall_time_us() : 0;
+
     _fdm_input_local();
 
-    /* make sure we die if our parent dies */
-    if (kill(_parent_pid, 0) != 0) {
+    if (_max_speed) {
+        _profile_update(physics_start_us);
+    }
+
+    /* make sure we die if our parent dies, checked every 100 steps
+       to save a system call per step at high speedups */
+    if ((_update_count % 100) == 0 && kill(_parent_pid, 0) != 0) {
         exit(1);
     }
 
@@ -144,6 +163,37 @@ void SITL_State::_fdm_input_step(void)
     _scheduler->sitl_end_atomic();
 }
 
+/*
+  record time spent in the physics model and periodically report the
+  achieved speedup and the split of wall clock time between the
+  physics model and the rest of the firmware
+ */
+void SITL_State::_profile_update(uint64_t physics_start_us)
+{
+    const uint64_t now_us = wall_time_us();
+    if (_profile.start_us == 0) {
+        _profile.start_us = now_us;
+        _profile.start_sim_us = AP_HAL::micros64();
+        return;
+    }
+    _profile.physics_us += now_us - physics_start_us;
+
+    const uint64_t elapsed_us = now_us - _profile.start_us;
+    if (elapsed_us < 10000000ULL) {
+        return;
+    }
+    const uint64_t sim_elapsed_us = AP_HAL::micros64() - _profile.start_sim_us;
+    const double physics_pct = 100.0 * _profile.physics_us / elapsed_us;
+    ::printf("SITL: speedup %.1f physics %.1f%% firmware %.1f%%\n",
+             double(sim_elapsed_us) / elapsed_us,
+             physics_pct,
+             100.0 - physics_pct);
+
+    _profile.start_us = now_us;
+    _profile.start_sim_us = AP_HAL::micros64();
+    _profile.physics_us = 0;
+}
+
 
 void SITL_State::wait_clock(uint64_t wait_time_usec)
 {
@@ -173,6 +223,7 @@ void SITL_State::wait_clock(uint64_t wait_time_usec)
                 }
             }
 #endif
+            _scheduler->park_point();
             usleep(1000);
         }
     }
@@ -180,7 +231,7 @@ void SITL_State::wait_clock(uint64_t wait_time_usec)
     // MAVProxy/pymavlink take too long to process packets and it ends
     // up seeing traffic well into our past and hits time-out
     // conditions.
-    if (speedup > 1 && hal.scheduler->in_main_thread()) {
+    if ((speedup > 1 || _max_speed) && hal.scheduler->in_main_thread()) {
         while (true) {
             HALSITL::UARTDriver *uart = (HALSITL::UARTDriver*)hal.serial(0);
             const int queue_length = uart->get_system_outqueue_length();
@@ -504,12 +555,24 @@ void SITL_State::set_height_agl(void)
         location.lat = _sitl->state.latitude*1.0e7;
         location.lng = _sitl->state.longitude*1.0e7;
 
+        // only go back to the terrain grid once we have moved
+        static Location last_location;
+        static float last_terrain_height_amsl;
+        static bool last_valid;
         AP_Terrain *_terrain = AP_Terrain::get_singleton();
+        if (last_valid && last_location.get_distance(location) < SIM_TERRAIN_CACHE_DIST_M) {
+            _sitl->state.height_agl = _sitl->state.altitude - last_terrain_height_amsl;
+            return;
+        }
         if (_terrain != nullptr &&
             _terrain->height_amsl(location, terrain_height_amsl, false)) {
+            last_location = location;
+            last_terrain_height_amsl = terrain_height_amsl;
+            last_valid = true;
             _sitl->state.height_agl = _sitl->state.altitude - terrain_height_amsl;
             return;
         }
+        last_valid = false;
     }
 #endif
 
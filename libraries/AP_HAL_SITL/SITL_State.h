@@ -55,6 +55,10 @@ public:
     
     uint8_t get_instance() const { return _instance; }
 
+    // take or restore a snapshot if one was requested, called from the
+    // top of the main loop
+    void snapshot_update(void);
+
 private:
     void _parse_command_line(int argc, char * const argv[]);
     void _set_param_default(const char *parm);
@@ -72,6 +76,7 @@ private:
     void _output_to_flightgear(void);
     void _simulator_servos(struct sitl_input &input);
     void _fdm_input_step(void);
+    void _profile_update(uint64_t physics_start_us);
 
     void wait_clock(uint64_t wait_time_usec);
 
@@ -89,6 +94,32 @@ private:
 
     bool _use_rtscts;
     bool _use_fg_view;
+    bool _max_speed;            // run as fast as possible rather than at SIM_SPEEDUP
+
+    // snapshot and restore, see SITL_snapshot.cpp
+    bool _snapshot_taken;       // this process is a running copy of a snapshot
+    static volatile bool _snapshot_requested;
+    static volatile bool _restore_requested;
+    static void _sig_snapshot(int signum);
+    void _snapshot_setup(void);
+    pid_t _snapshot_fork(void);
+    void _snapshot_hold(pid_t child);
+
+    // lockstep group, see SITL_lockstep.cpp
+    struct lockstep_group;
+    struct {
+        lockstep_group *group;
+        uint64_t next_us;       // simulation time of the next barrier
+    } _lockstep;
+    bool _lockstep_init(const char *group);
+    void _lockstep_wait(void);
+
+    // wall clock time spent in the physics model, reported with --max-speed
+    struct {
+        uint64_t start_us;      // wall clock time at start of report period
+        uint64_t start_sim_us;  // simulation time at start of report period
+        uint64_t physics_us;    // wall clock time spent in the physics model in report period
+    } _profile;
     
     const char *_fg_address;
 
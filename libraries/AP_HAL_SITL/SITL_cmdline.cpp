@@ -83,6 +83,9 @@ void SITL_State::_usage(void)
            "\t--wipe|-w                wipe eeprom\n"
            "\t--unhide-groups|-u       parameter enumeration ignores AP_PARAM_FLAG_ENABLE\n"
            "\t--speedup|-s SPEEDUP     set simulation speedup\n"
+           "\t--max-speed              run the simulation as fast as possible and report where the time goes\n"
+           "\t--lockstep NAME:COUNT    run in step with the other processes of lockstep group NAME\n"
+           "\t--snapshot               SIGUSR1 takes a snapshot of the simulation, SIGUSR2 restores it\n"
            "\t--rate|-r RATE           set SITL framerate\n"
            "\t--console|-C             use console instead of TCP ports\n"
            "\t--instance|-I N          set instance of SITL (adds 10*instance to all port numbers)\n"
@@ -279,6 +282,9 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         CMDLINE_START_TIME,
         CMDLINE_SYSID,
         CMDLINE_SLAVE,
+        CMDLINE_MAX_SPEED,
+        CMDLINE_SNAPSHOT,
+        CMDLINE_LOCKSTEP,
 #if STORAGE_USE_FLASH
         CMDLINE_SET_STORAGE_FLASH_ENABLED,
 #endif
@@ -339,6 +345,9 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         {"start-time",      true,   0, CMDLINE_START_TIME},
         {"sysid",           true,   0, CMDLINE_SYSID},
         {"slave",           true,   0, CMDLINE_SLAVE},
+        {"max-speed",       false,  0, CMDLINE_MAX_SPEED},
+        {"snapshot",        false,  0, CMDLINE_SNAPSHOT},
+        {"lockstep",        true,   0, CMDLINE_LOCKSTEP},
 #if STORAGE_USE_FLASH
         {"set-storage-flash-enabled", true,   0, CMDLINE_SET_STORAGE_FLASH_ENABLED},
 #endif
@@ -548,6 +557,18 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
 #endif
             break;
         }
+        case CMDLINE_MAX_SPEED:
+            _max_speed = true;
+            printf("Running at maximum speed\n");
+            break;
+        case CMDLINE_SNAPSHOT:
+            _snapshot_setup();
+            break;
+        case CMDLINE_LOCKSTEP:
+            if (!_lockstep_init(gopt.optarg)) {
+                exit(1);
+            }
+            break;
         default:
             _usage();
             exit(1);
@@ -585,6 +606,7 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
             }
             sitl_model->set_interface_ports(simulator_address, simulator_port_in, simulator_port_out);
             sitl_model->set_speedup(speedup);
+            sitl_model->set_max_speed(_max_speed);
             sitl_model->set_instance(_instance);
             sitl_model->set_autotest_dir(autotest_dir);
             sitl_model->set_config(config);
@@ -0,0 +1,202 @@
+/*
+  run a group of SITL processes in lockstep
+
+  With --lockstep NAME:COUNT, COUNT processes started with the same
+  NAME share a barrier in POSIX shared memory. Each process waits at
+  the barrier every SITL_LOCKSTEP_PERIOD_US of simulation time until
+  all members of the group have reached it, so a swarm run with
+  --max-speed keeps every vehicle on the same simulation clock, no
+  matter how the host schedules the processes.
+
+  The first process to start creates the group. The shared memory
+  object stays until it is removed, so each run of a group should use
+  a new NAME.
+ */
+
+#include <AP_HAL/AP_HAL.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL && !defined(HAL_BUILD_AP_PERIPH)
+
+#include "AP_HAL_SITL.h"
+#include "AP_HAL_SITL_Namespace.h"
+#include "HAL_SITL_Class.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace HALSITL;
+
+#define SITL_LOCKSTEP_MAGIC 0x4C4B5354U  // "LKST"
+
+// simulation time between barriers. Members of a group are never
+// more than this apart
+#define SITL_LOCKSTEP_PERIOD_US 5000U
+
+#if defined(__CYGWIN__) || defined(__CYGWIN64__)
+
+bool SITL_State::_lockstep_init(const char *group)
+{
+    ::printf("--lockstep is not supported on cygwin\n");
+    return false;
+}
+
+void SITL_State::_lockstep_wait(void)
+{
+}
+
+#else
+
+// layout of the shared memory object
+struct SITL_State::lockstep_group {
+    uint32_t magic;         // set once the rest has been initialised
+    uint32_t count;         // number of processes in the group
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t waiting;       // processes waiting at the barrier
+    uint32_t generation;    // incremented each time the barrier opens
+};
+
+/*
+  join or create the group given as NAME:COUNT
+ */
+bool SITL_State::_lockstep_init(const char *group)
+{
+    const char *colon = strrchr(group, ':');
+    if (colon == nullptr || colon == group) {
+        ::printf("--lockstep expects NAME:COUNT\n");
+        return false;
+    }
+    const int count = atoi(colon+1);
+    if (count < 1) {
+        ::printf("--lockstep COUNT must be at least 1\n");
+        return false;
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "/ardupilot-lockstep-%.*s", int(colon - group), group);
+
+    bool creator = true;
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd == -1 && errno == EEXIST) {
+        creator = false;
+        fd = shm_open(name, O_RDWR, 0600);
+    }
+    if (fd == -1) {
+        ::printf("lockstep: shm_open(%s): %s\n", name, strerror(errno));
+        return false;
+    }
+    if (creator) {
+        if (ftruncate(fd, sizeof(lockstep_group)) != 0) {
+            ::printf("lockstep: ftruncate(%s): %s\n", name, strerror(errno));
+            close(fd);
+            shm_unlink(name);
+            return false;
+        }
+    } else {
+        // wait for the creator to size the object
+        struct stat st {};
+        for (uint16_t i=0; fstat(fd, &st) == 0 && size_t(st.st_size) < sizeof(lockstep_group); i++) {
+            if (i == 10000) {
+                ::printf("lockstep: %s was never initialised\n", name);
+                close(fd);
+                return false;
+            }
+            usleep(1000);
+        }
+    }
+    void *ptr = mmap(nullptr, sizeof(lockstep_group), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        ::printf("lockstep: mmap(%s): %s\n", name, strerror(errno));
+        return false;
+    }
+    lockstep_group *g = (lockstep_group *)ptr;
+
+    if (creator) {
+        pthread_mutexattr_t mattr;
+        pthread_mutexattr_init(&mattr);
+        pthread_mutexattr_setpshared(&mattr, PTHREAD_PROCESS_SHARED);
+        pthread_mutex_init(&g->mutex, &mattr);
+        pthread_mutexattr_destroy(&mattr);
+
+        pthread_condattr_t cattr;
+        pthread_condattr_init(&cattr);
+        pthread_condattr_setpshared(&cattr, PTHREAD_PROCESS_SHARED);
+        pthread_cond_init(&g->cond, &cattr);
+        pthread_condattr_destroy(&cattr);
+
+        g->count = count;
+        g->waiting = 0;
+        g->generation = 0;
+        __atomic_store_n(&g->magic, SITL_LOCKSTEP_MAGIC, __ATOMIC_RELEASE);
+    } else {
+        for (uint16_t i=0; __atomic_load_n(&g->magic, __ATOMIC_ACQUIRE) != SITL_LOCKSTEP_MAGIC; i++) {
+            if (i == 10000) {
+                ::printf("lockstep: %s was never initialised\n", name);
+                munmap(ptr, sizeof(lockstep_group));
+                return false;
+            }
+            usleep(1000);
+        }
+        if (g->count != uint32_t(count)) {
+            ::printf("lockstep: %s has %u members, not %d\n", name, unsigned(g->count), count);
+            munmap(ptr, sizeof(lockstep_group));
+            return false;
+        }
+    }
+
+    _lockstep.group = g;
+    ::printf("Lockstep group %s of %d\n", name + 1, count);
+    return true;
+}
+
+/*
+  wait at the barrier each time simulation time crosses a period
+  boundary. Called from the main thread before each physics step
+ */
+void SITL_State::_lockstep_wait(void)
+{
+    const uint64_t now_us = AP_HAL::micros64();
+    if (now_us < _lockstep.next_us) {
+        return;
+    }
+    _lockstep.next_us = now_us - (now_us % SITL_LOCKSTEP_PERIOD_US) + SITL_LOCKSTEP_PERIOD_US;
+
+    lockstep_group *g = _lockstep.group;
+    pthread_mutex_lock(&g->mutex);
+    const uint32_t generation = g->generation;
+    if (++g->waiting >= g->count) {
+        g->waiting = 0;
+        g->generation++;
+        pthread_cond_broadcast(&g->cond);
+        pthread_mutex_unlock(&g->mutex);
+        return;
+    }
+    while (g->generation == generation) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec += 1;
+        if (pthread_cond_timedwait(&g->cond, &g->mutex, &ts) != ETIMEDOUT) {
+            continue;
+        }
+        // a member that has gone away stops the whole group, so
+        // make sure we don't outlive our parent while waiting
+        if (kill(_parent_pid, 0) != 0) {
+            pthread_mutex_unlock(&g->mutex);
+            exit(1);
+        }
+        ::printf("lockstep: waiting for %u of %u\n",
+                 unsigned(g->count - g->waiting), unsigned(g->count));
+    }
+    pthread_mutex_unlock(&g->mutex);
+}
+
+#endif  // __CYGWIN__
+
+#endif  // CONFIG_HAL_BOARD == HAL_BOARD_SITL && !defined(HAL_BUILD_AP_PERIPH)
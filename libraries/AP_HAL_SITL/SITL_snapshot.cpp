@@ -0,0 +1,179 @@
+/*
+  snapshot and restore of a running simulation
+
+  With --snapshot, SIGUSR1 takes a snapshot and SIGUSR2 restores
+  it. The snapshot is a fork() of the whole process, taken at the top
+  of the main loop with every HAL thread parked while it holds no
+  semaphores. The original process keeps the snapshot: it stops
+  running the vehicle and forks a new running copy on each restore,
+  killing the previous copy. Everything held in memory comes back
+  exactly as it was, including the physics model, the EKF and
+  controller state, storage, and the simulation clock. Open sockets
+  are shared with the running copy, so the GCS link survives a
+  restore.
+
+  Threads are started again from their entry points in each copy, so
+  lua scripts restart. Each copy rewrites the storage file and starts
+  a new log if one was open. Simulators running outside this process
+  (JSON, Gazebo, RealFlight and the like) are not part of the
+  snapshot.
+ */
+
+#include <AP_HAL/AP_HAL.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL && !defined(HAL_BUILD_AP_PERIPH)
+
+#include "AP_HAL_SITL.h"
+#include "AP_HAL_SITL_Namespace.h"
+#include "HAL_SITL_Class.h"
+#include "Scheduler.h"
+#include "Storage.h"
+#include <AP_Logger/AP_Logger.h>
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern const AP_HAL::HAL& hal;
+
+using namespace HALSITL;
+
+// wall clock time we allow for all threads to park
+#define SNAPSHOT_PARK_TIMEOUT_MS 1000
+
+volatile bool SITL_State::_snapshot_requested;
+volatile bool SITL_State::_restore_requested;
+
+void SITL_State::_sig_snapshot(int signum)
+{
+    if (signum == SIGUSR1) {
+        _snapshot_requested = true;
+    } else {
+        _restore_requested = true;
+    }
+}
+
+void SITL_State::_snapshot_setup(void)
+{
+    Scheduler::enable_snapshots();
+
+    struct sigaction sa = {};
+    sigemptyset(&sa.sa_mask);
+    sa.sa_handler = _sig_snapshot;
+    sigaction(SIGUSR1, &sa, nullptr);
+    sigaction(SIGUSR2, &sa, nullptr);
+}
+
+void SITL_State::snapshot_update(void)
+{
+    if (_restore_requested) {
+        _restore_requested = false;
+        if (_snapshot_taken) {
+            ::printf("SITL: send SIGUSR2 to pid %d to restore the snapshot\n", (int)_parent_pid);
+        } else {
+            ::printf("SITL: no snapshot to restore\n");
+        }
+    }
+    if (!_snapshot_requested) {
+        return;
+    }
+    _snapshot_requested = false;
+    if (_snapshot_taken) {
+        ::printf("SITL: pid %d already holds a snapshot\n", (int)_parent_pid);
+        return;
+    }
+
+    if (!_scheduler->park_threads(SNAPSHOT_PARK_TIMEOUT_MS)) {
+        ::printf("SITL: snapshot failed, threads did not stop\n");
+        return;
+    }
+    const pid_t child = _snapshot_fork();
+    if (child == 0) {
+        // we are the running copy
+        return;
+    }
+    if (child < 0) {
+        ::printf("SITL: snapshot failed, fork: %s\n", strerror(errno));
+        _scheduler->unpark_threads();
+        return;
+    }
+    _snapshot_hold(child);
+}
+
+/*
+  fork a running copy of the snapshot. Returns 0 in the copy, the
+  pid of the copy in the holder, or -1 on failure
+ */
+pid_t SITL_State::_snapshot_fork(void)
+{
+    const pid_t holder = getpid();
+    const pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+
+    _parent_pid = holder;
+    _snapshot_taken = true;
+    _scheduler->restart_threads_after_fork();
+
+    // a previous copy may have written to the storage file since the
+    // snapshot was taken
+    static_cast<Storage*>(hal.storage)->mark_all_dirty();
+
+#if HAL_LOGGING_ENABLED
+    // the log file is shared with the holder, give this copy its own
+    AP_Logger &logger = AP::logger();
+    if (logger.logging_started()) {
+        logger.StopLogging();
+        logger.PrepForArming();
+    }
+#endif
+    return 0;
+}
+
+/*
+  keep the snapshot, forking a new running copy each time a restore
+  is requested. Only returns in a restored copy
+ */
+void SITL_State::_snapshot_hold(pid_t child)
+{
+    // the watchdog would otherwise re-exec the holder
+    alarm(0);
+    ::printf("SITL: snapshot taken, running copy is pid %d\n", (int)child);
+
+    while (true) {
+        if (Scheduler::_should_exit || kill(_parent_pid, 0) != 0) {
+            if (child > 0) {
+                kill(child, SIGKILL);
+                waitpid(child, nullptr, 0);
+            }
+            exit(0);
+        }
+        if (child > 0 && waitpid(child, nullptr, WNOHANG) == child) {
+            child = -1;
+        }
+        _snapshot_requested = false;
+        if (_restore_requested) {
+            _restore_requested = false;
+            if (child > 0) {
+                kill(child, SIGKILL);
+                waitpid(child, nullptr, 0);
+            }
+            child = _snapshot_fork();
+            if (child == 0) {
+                return;
+            }
+            if (child < 0) {
+                ::printf("SITL: restore failed, fork: %s\n", strerror(errno));
+            } else {
+                ::printf("SITL: restored snapshot, running copy is pid %d\n", (int)child);
+            }
+        }
+        usleep(10000);
+    }
+}
+
+#endif  // CONFIG_HAL_BOARD == HAL_BOARD_SITL && !defined(HAL_BUILD_AP_PERIPH)
@@ -43,6 +43,10 @@ bool Scheduler::_should_exit = false;
 
 bool Scheduler::_in_semaphore_take_wait = false;
 
+bool Scheduler::_snapshots_enabled;
+volatile bool Scheduler::_park_request;
+volatile uint8_t Scheduler::_parked_count;
+
 Scheduler::thread_attr *Scheduler::threads;
 HAL_Semaphore Scheduler::_thread_sem;
 
@@ -420,6 +424,76 @@ void Scheduler::check_thread_stacks(void)
     }
 }
 
+/*
+  called by threads while they are idle. When a snapshot has been
+  requested, wait here until it has been taken. A thread holding any
+  semaphore is not parked, as the copy of the process could never
+  take that semaphore again
+ */
+void Scheduler::park_point(void)
+{
+    if (!_park_request ||
+        pthread_self() == _main_ctx ||
+        Semaphore::held_by_current_thread() != 0) {
+        return;
+    }
+    __atomic_add_fetch(&_parked_count, 1, __ATOMIC_SEQ_CST);
+    while (_park_request) {
+        usleep(1000);
+    }
+    __atomic_sub_fetch(&_parked_count, 1, __ATOMIC_SEQ_CST);
+}
+
+/*
+  park all threads, waiting at most timeout_ms of wall clock time.
+  Called from the main thread
+ */
+bool Scheduler::park_threads(uint32_t timeout_ms)
+{
+    _park_request = true;
+    for (uint32_t i=0; i<timeout_ms; i++) {
+        uint8_t count = 0;
+        {
+            WITH_SEMAPHORE(_thread_sem);
+            for (struct thread_attr *p=threads; p; p=p->next) {
+                count++;
+            }
+        }
+        if (_parked_count >= count) {
+            return true;
+        }
+        usleep(1000);
+    }
+    unpark_threads();
+    return false;
+}
+
+void Scheduler::unpark_threads(void)
+{
+    _park_request = false;
+}
+
+/*
+  the new copy of a forked process only has the main thread. Start
+  every thread again from its entry point, with the same attributes
+  and stack as the original
+ */
+void Scheduler::restart_threads_after_fork(void)
+{
+    _park_request = false;
+    _parked_count = 0;
+    WITH_SEMAPHORE(_thread_sem);
+    for (struct thread_attr *a=threads; a; a=a->next) {
+        pthread_t thread {};
+        if (pthread_create(&thread, &a->attr, thread_create_trampoline, a) != 0) {
+            AP_HAL::panic("Failed to restart thread %s", a->name);
+        }
+#if !defined(__APPLE__) && !defined(__OpenBSD__)
+        pthread_setname_np(thread, a->name);
+#endif
+    }
+}
+
 // get the name of the current thread, or nullptr if not known
 const char *Scheduler::get_current_thread_name(void) const
 {
@@ -70,6 +70,20 @@ public:
     // get the name of the current thread, or nullptr if not known
     const char *get_current_thread_name(void) const;
 
+    /*
+      snapshot support, see SITL_snapshot.cpp. park_threads() asks
+      every thread created with thread_create() to stop in
+      park_point() while it holds no semaphores, so the process can
+      be forked. restart_threads_after_fork() re-creates the threads
+      in the new copy, starting again from their entry points
+     */
+    static void enable_snapshots(void) { _snapshots_enabled = true; }
+    static bool snapshots_enabled(void) { return _snapshots_enabled; }
+    void park_point(void);
+    bool park_threads(uint32_t timeout_ms);
+    void unpark_threads(void);
+    void restart_threads_after_fork(void);
+
 private:
     SITL_State *_sitlState;
     uint8_t _nested_atomic_ctr;
@@ -89,6 +103,10 @@ private:
     // waiting for a take-timeout to occur.
     static bool _in_semaphore_take_wait;
 
+    static bool _snapshots_enabled;
+    static volatile bool _park_request;
+    static volatile uint8_t _parked_count;
+
     void stop_clock(uint64_t time_usec) override;
 
     static void *thread_create_trampoline(void *ctx);
@@ -9,6 +9,8 @@ extern const AP_HAL::HAL& hal;
 
 using namespace HALSITL;
 
+thread_local uint16_t Semaphore::_held_count;
+
 // construct a semaphore
 Semaphore::Semaphore()
 {
@@ -22,6 +24,7 @@ Semaphore::Semaphore()
 bool Semaphore::give()
 {
     take_count--;
+    _held_count--;
     if (pthread_mutex_unlock(&_lock) != 0) {
         AP_HAL::panic("Bad semaphore usage");
     }
@@ -45,6 +48,7 @@ bool Semaphore::take(uint32_t timeout_ms)
         if (pthread_mutex_lock(&_lock) == 0) {
             owner = pthread_self();
             take_count++;
+            _held_count++;
             return true;
         }
         return false;
@@ -71,6 +75,7 @@ bool Semaphore::take_nonblocking()
     if (pthread_mutex_trylock(&_lock) == 0) {
         owner = pthread_self();
         take_count++;
+        _held_count++;
         return true;
     }
     return false;
@@ -120,7 +125,7 @@ bool BinarySemaphore::wait(uint32_t timeout_us)
             ts.tv_sec++;
             ts.tv_nsec -= 1000000000L;
         }
-        if (pthread_cond_timedwait(&cond, &mtx._lock, &ts) != 0) {
+        if (!cond_wait(&ts)) {
             return false;
         }
     }
@@ -132,7 +137,7 @@ bool BinarySemaphore::wait_blocking(void)
 {
     WITH_SEMAPHORE(mtx);
     if (!pending) {
-        if (pthread_cond_wait(&cond, &mtx._lock) != 0) {
+        if (!cond_wait(nullptr)) {
             return false;
         }
     }
@@ -140,6 +145,53 @@ bool BinarySemaphore::wait_blocking(void)
     return true;
 }
 
+/*
+  wait on the condition variable until abstime, or forever if abstime
+  is nullptr. With snapshots enabled the wait is done in slices, and
+  between slices the thread can be parked with mtx released, so no
+  thread is inside a condition variable when the process is forked
+ */
+bool BinarySemaphore::cond_wait(const struct timespec *abstime)
+{
+    if (!Scheduler::snapshots_enabled()) {
+        if (abstime == nullptr) {
+            return pthread_cond_wait(&cond, &mtx._lock) == 0;
+        }
+        return pthread_cond_timedwait(&cond, &mtx._lock, abstime) == 0;
+    }
+    const long slice_ns = 50000000L;
+    while (true) {
+        struct timespec ts;
+        if (clock_gettime(CLOCK_REALTIME, &ts) != 0) {
+            return false;
+        }
+        if (abstime != nullptr &&
+            (ts.tv_sec > abstime->tv_sec ||
+             (ts.tv_sec == abstime->tv_sec && ts.tv_nsec >= abstime->tv_nsec))) {
+            return false;
+        }
+        ts.tv_nsec += slice_ns;
+        if (ts.tv_nsec >= 1000000000L) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000L;
+        }
+        if (abstime != nullptr &&
+            (ts.tv_sec > abstime->tv_sec ||
+             (ts.tv_sec == abstime->tv_sec && ts.tv_nsec > abstime->tv_nsec))) {
+            ts = *abstime;
+        }
+        if (pthread_cond_timedwait(&cond, &mtx._lock, &ts) == 0 || pending) {
+            return true;
+        }
+        mtx.give();
+        Scheduler::from(hal.scheduler)->park_point();
+        mtx.take_blocking();
+        if (pending) {
+            return true;
+        }
+    }
+}
+
 void BinarySemaphore::signal(void)
 {
     WITH_SEMAPHORE(mtx);
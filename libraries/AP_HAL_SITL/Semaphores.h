@@ -17,6 +17,10 @@ public:
 
     void check_owner() const;  // asserts that current thread owns semaphore
 
+    // number of semaphores held by the calling thread. Threads are
+    // only parked for a snapshot while they hold none
+    static uint16_t held_by_current_thread(void) { return _held_count; }
+
 protected:
     pthread_mutex_t _lock;
     pthread_t owner;
@@ -24,6 +28,8 @@ protected:
     // keep track the recursion level to ensure we only disown the
     // semaphore once we're done with it
     uint8_t take_count;
+
+    static thread_local uint16_t _held_count;
 };
 
 
@@ -38,6 +44,8 @@ public:
     void signal(void) override;
 
 private:
+    bool cond_wait(const struct timespec *abstime);
+
     HALSITL::Semaphore mtx;
     pthread_cond_t cond;
     bool pending;
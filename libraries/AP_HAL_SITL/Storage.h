@@ -33,6 +33,10 @@ public:
     void _timer_tick(void) override;
     bool healthy(void) override;
 
+    // write all of storage out again, used when a restored snapshot
+    // replaces whatever a previous copy of the process wrote
+    void mark_all_dirty(void) { _dirty_mask.setall(); }
+
 private:
     enum class StorageBackend: uint8_t {
         None,
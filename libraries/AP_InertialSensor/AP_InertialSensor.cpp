@@ -684,6 +684,16 @@ const AP_Param::GroupInfo AP_InertialSensor::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("_RAW_LOG_OPT", 56, AP_InertialSensor, raw_logging_options, 0),
 
+#if AP_INERTIALSENSOR_GYRO_DECIMATION_ENABLED
+    // @Param: _GYRO_DECIM
+    // @DisplayName: Gyro decimation factor
+    // @Description: Gyro samples are passed through an anti-aliasing FIR filter and decimated by this factor before the notch and low pass filters, which then run at the lower rate. This allows IMUs to be sampled at a high rate for better rejection of aliased noise without the cost of running the filters at that rate. The decimated rate must still be at least double the maximum filter frequency and above the loop rate. A value of 1 disables decimation.
+    // @Range: 1 8
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("_GYRO_DECIM", 57, AP_InertialSensor, _gyro_decimation, 1),
+#endif
+
     /*
       NOTE: parameter indexes have gaps above. When adding new
       parameters check for conflicts carefully
@@ -748,6 +758,17 @@ bool AP_InertialSensor::register_gyro(uint8_t &instance, uint16_t raw_sample_rat
     _gyro_over_sampling[_gyro_count] = 1;
     _gyro_raw_sampling_multiplier[_gyro_count] = INT16_MAX/radians(2000);
 
+#if AP_INERTIALSENSOR_GYRO_DECIMATION_ENABLED
+    if (_gyro_decimation > 1 && _gyro_decimator[_gyro_count] == nullptr) {
+        _gyro_decimator[_gyro_count] = NEW_NOTHROW FIRDecimatorVector3f();
+        if (_gyro_decimator[_gyro_count] != nullptr &&
+            !_gyro_decimator[_gyro_count]->init(_gyro_decimation)) {
+            delete _gyro_decimator[_gyro_count];
+            _gyro_decimator[_gyro_count] = nullptr;
+        }
+    }
+#endif
+
     bool saved = _gyro_id(_gyro_count).load();
 
     if (saved && (uint32_t)_gyro_id(_gyro_count) != id) {
@@ -1028,7 +1049,8 @@ AP_InertialSensor::init(uint16_t loop_rate)
 #if APM_BUILD_COPTER_OR_HELI || APM_BUILD_TYPE(APM_BUILD_ArduPlane)
         if (notch.params.hasOption(HarmonicNotchFilterParams::Options::DynamicHarmonic)) {
 #if HAL_GYROFFT_ENABLED
-            if (notch.params.tracking_mode() == HarmonicNotchDynamicMode::UpdateGyroFFT) {
+            if (notch.params.tracking_mode() == HarmonicNotchDynamicMode::UpdateGyroFFT &&
+                !notch.params.hasOption(HarmonicNotchFilterParams::Options::PerMotorFFT)) {
                 notch.num_dynamic_notches = AP_HAL::DSP::MAX_TRACKED_PEAKS; // only 3 peaks supported currently
             } else
 #endif
@@ -1512,7 +1534,7 @@ bool AP_InertialSensor::pre_arm_check_gyro_backend_rate_hz(char* fail_msg, uint1
         if (!_use(i) || _backends[i] == nullptr) {
             continue;
         }
-        const auto rate_hz = _backends[i]->get_gyro_backend_rate_hz();
+        const auto rate_hz = _backends[i]->get_gyro_backend_rate_hz() / gyro_decimation(i);
         if (rate_hz < threshold && (AP_HAL::Device::devid_get_devtype(_gyro_id(i)) != AP_InertialSensor_Backend::DEVTYPE_SERIAL)) {
             hal.util->snprintf(fail_msg, fail_msg_len, "Gyro %d rate %dHz < loop ratex1.8 %dHz",
                                i, int(rate_hz), int(threshold));
@@ -1921,8 +1943,12 @@ void AP_InertialSensor::set_primary(uint8_t instance)
 /*
   update gyro and accel values from backends
  */
+AP_CYCLE_PROBE_DEFINE(ins_update);
+
 void AP_InertialSensor::update(void)
 {
+    AP_CYCLE_PROBE(ins_update);
+
     // during initialisation update() may be called without
     // wait_for_sample(), and a wait is implied
     wait_for_sample();
@@ -2095,6 +2121,12 @@ check_sample:
         // IMUs to come in
         const uint8_t wait_per_loop = 100;
         const uint8_t wait_counter_limit = uint32_t(_loop_delta_t * 1.0e6) / (3*wait_per_loop);
+#if AP_INERTIALSENSOR_SAMPLE_WAKEUP_ENABLED
+        // the backends wake us early, so the limit is on elapsed time
+        // rather than on the number of waits
+        const uint32_t wait_start_us = AP_HAL::micros();
+        _waiting_for_sample = true;
+#endif
 
         while (true) {
             for (uint8_t i=0; i<_backend_count; i++) {
@@ -2147,9 +2179,17 @@ check_sample:
                 }
             }
 
+#if AP_INERTIALSENSOR_SAMPLE_WAKEUP_ENABLED
+            UNUSED_RESULT(_sample_sem.wait(wait_per_loop));
+            wait_counter = (AP_HAL::micros() - wait_start_us) / wait_per_loop;
+#else
             hal.scheduler->delay_microseconds_boost(wait_per_loop);
             wait_counter++;
+#endif
         }
+#if AP_INERTIALSENSOR_SAMPLE_WAKEUP_ENABLED
+        _waiting_for_sample = false;
+#endif
 
     now = AP_HAL::micros();
     _delta_time = (now - _last_sample_usec) * 1.0e-6f;
@@ -17,6 +17,7 @@
 #include <AP_ExternalAHRS/AP_ExternalAHRS.h>
 #include <Filter/LowPassFilter.h>
 #include <Filter/HarmonicNotchFilter.h>
+#include <Filter/FIRDecimator.h>
 #include <AP_SerialManager/AP_SerialManager_config.h>
 #include "AP_InertialSensor_Params.h"
 #include "AP_InertialSensor_tempcal.h"
@@ -168,9 +169,19 @@ public:
     bool has_fft_notch() const;
 #endif
 #endif
-    uint16_t get_raw_gyro_rate_hz(uint8_t instance) const { return _gyro_raw_sample_rates[_first_usable_gyro]; }
+    // rate of the gyro samples reaching the filters, after any decimation
+    uint16_t get_raw_gyro_rate_hz(uint8_t instance) const { return _gyro_raw_sample_rates[_first_usable_gyro] / gyro_decimation(_first_usable_gyro); }
     uint16_t get_raw_gyro_rate_hz() const { return get_raw_gyro_rate_hz(_first_usable_gyro); }
     bool set_gyro_window_size(uint16_t size);
+
+    // return the factor gyro samples are decimated by before filtering
+    uint8_t gyro_decimation(uint8_t instance) const {
+#if AP_INERTIALSENSOR_GYRO_DECIMATION_ENABLED
+        return _gyro_decimator[instance] != nullptr ? _gyro_decimator[instance]->get_factor() : 1;
+#else
+        return 1;
+#endif
+    }
     // get accel offsets in m/s/s
     const Vector3f &get_accel_offsets(uint8_t i) const { return _accel_offset(i); }
     const Vector3f &get_accel_offsets(void) const { return get_accel_offsets(_first_usable_accel); }
@@ -201,7 +212,7 @@ public:
     float get_gyro_drift_rate(void) const { return ToRad(0.5f/60); }
 
     // update gyro and accel values from accumulated samples
-    void update(void) __RAMFUNC__;
+    void update(void) __FASTRAMFUNC__;
 
     // wait for a sample to be available
     void wait_for_sample(void) __RAMFUNC__;
@@ -386,6 +397,7 @@ public:
             BATCH_OPT_SENSOR_RATE = (1<<0),
             BATCH_OPT_POST_FILTER = (1<<1),
             BATCH_OPT_PRE_POST_FILTER = (1<<2),
+            BATCH_OPT_STREAM = (1<<3),
         };
 
         void rotate_to_next_sensor();
@@ -421,6 +433,42 @@ public:
         // all samples are multiplied by this
         uint16_t multiplier; // initialised as part of init()
 
+#if AP_INERTIALSENSOR_BATCHSAMPLER_STREAM_ENABLED
+        /*
+          a frame of samples from one sensor streamed to the
+          SerialProtocol_IMUStream port. Samples are scaled as for
+          the ISBD log message
+         */
+        static constexpr uint16_t STREAM_MAGIC = 0x29c5;
+        static constexpr uint8_t STREAM_FRAME_SAMPLES = 32;
+        struct PACKED stream_frame {
+            uint16_t magic;
+            uint8_t instance;
+            uint8_t flags;          // bit 0 set for gyro, bit 1 set for post-filter
+            uint16_t seqnum;        // per sensor, to detect lost frames
+            uint16_t multiplier;
+            uint32_t first_sample_us;
+            uint32_t last_sample_us;
+            int16_t data[STREAM_FRAME_SAMPLES][3];
+            uint16_t crc;           // crc_xmodem of the rest of the frame
+        };
+
+        // the frame being filled for each sensor, written only by
+        // the backend of that sensor
+        struct stream_sensor {
+            stream_frame frame;
+            uint8_t count;
+            uint16_t seqnum;
+        } *stream_sensors;
+        ObjectBuffer_TS<stream_frame> *stream_queue;
+        AP_HAL::UARTDriver *stream_uart;
+
+        void stream_init();
+        void stream_sample(uint8_t _instance, IMU_SENSOR_TYPE _type, uint64_t sample_us, const Vector3f &_sample) __RAMFUNC__;
+        // send queued frames from the IO thread
+        void stream_update();
+#endif
+
         const AP_InertialSensor &_imu;
     };
     BatchSampler batchsampler{*this};
@@ -456,6 +504,9 @@ public:
         float calculated_notch_freq_hz[INS_MAX_NOTCHES];
         uint8_t num_calculated_notch_frequencies;
 
+        // ratio of FFT measured to thrust predicted frequency for each motor, used by per-motor FFT tracking
+        float motor_freq_scale[INS_MAX_NOTCHES];
+
         // runtime update of notch parameters
         void update_params(uint8_t instance, bool converging, float gyro_rate);
 
@@ -530,6 +581,11 @@ private:
     // Low Pass filters for gyro and accel
     LowPassFilter2pVector3f _accel_filter[INS_MAX_INSTANCES];
     LowPassFilter2pVector3f _gyro_filter[INS_MAX_INSTANCES];
+#if AP_INERTIALSENSOR_GYRO_DECIMATION_ENABLED
+    // anti-aliasing decimators ahead of the gyro filters, allocated
+    // when _gyro_decimation is above 1
+    FIRDecimatorVector3f *_gyro_decimator[INS_MAX_INSTANCES];
+#endif
     Vector3f _accel_filtered[INS_MAX_INSTANCES];
     Vector3f _gyro_filtered[INS_MAX_INSTANCES];
 #if HAL_GYROFFT_ENABLED
@@ -546,6 +602,19 @@ private:
     bool _new_accel_data[INS_MAX_INSTANCES];
     bool _new_gyro_data[INS_MAX_INSTANCES];
 
+#if AP_INERTIALSENSOR_SAMPLE_WAKEUP_ENABLED
+    // signalled by the backends on a new sample while wait_for_sample() waits
+    HAL_BinarySemaphore _sample_sem;
+    volatile bool _waiting_for_sample;
+    void notify_sample_waiter() {
+        if (_waiting_for_sample) {
+            _sample_sem.signal();
+        }
+    }
+#else
+    void notify_sample_waiter() {}
+#endif
+
     // Most recent gyro reading
     Vector3f _gyro[INS_MAX_INSTANCES];
     Vector3f _delta_angle[INS_MAX_INSTANCES];
@@ -646,6 +715,11 @@ private:
     // control enable of fast sampling
     AP_Int8     _fast_sampling_rate;
 
+#if AP_INERTIALSENSOR_GYRO_DECIMATION_ENABLED
+    // factor to decimate gyro samples by before filtering
+    AP_Int8     _gyro_decimation;
+#endif
+
     // control enable of detected sensors
     AP_Int8     _enable_mask;
     
@@ -412,6 +412,26 @@ void AP_InertialSensor_BMI270::read_fifo(void)
     // this means that we rarely run read_fifo() without updating the sensor data
     _dev->adjust_periodic_callback(periodic_handle, BACKEND_PERIOD_US);
 
+    // samples are collected and passed to the backend as blocks
+    Vector3f accel[BMI270_MAX_FIFO_SAMPLES];
+    Vector3f gyro[BMI270_MAX_FIFO_SAMPLES];
+    uint8_t n_accel = 0;
+    uint8_t n_gyro = 0;
+    auto push_accel = [&](const uint8_t *d) {
+        if (n_accel == ARRAY_SIZE(accel)) {
+            _notify_new_accel_raw_samples(accel_instance, accel, n_accel);
+            n_accel = 0;
+        }
+        accel[n_accel++] = parse_accel_frame(d);
+    };
+    auto push_gyro = [&](const uint8_t *d) {
+        if (n_gyro == ARRAY_SIZE(gyro)) {
+            _notify_new_gyro_raw_samples(gyro_instance, gyro, n_gyro);
+            n_gyro = 0;
+        }
+        gyro[n_gyro++] = parse_gyro_frame(d);
+    };
+
     const uint8_t *p = &data[0];
     while (fifo_length >= 12) {
         /*
@@ -421,16 +441,16 @@ void AP_InertialSensor_BMI270::read_fifo(void)
         switch (p[0] & 0xFC) {
         case 0x84: // accel
             frame_len = 7;
-            parse_accel_frame(p+1);
+            push_accel(p+1);
             break;
         case 0x88: // gyro
             frame_len = 7;
-            parse_gyro_frame(p+1);
+            push_gyro(p+1);
             break;
         case 0x8C: // accel + gyro
             frame_len = 13;
-            parse_gyro_frame(p+1);
-            parse_accel_frame(p+7);
+            push_gyro(p+1);
+            push_accel(p+7);
             break;
         case 0x40:
             // skip frame
@@ -450,6 +470,8 @@ void AP_InertialSensor_BMI270::read_fifo(void)
             break;
         case 0x80:
             // invalid frame
+            _notify_new_accel_raw_samples(accel_instance, accel, n_accel);
+            _notify_new_gyro_raw_samples(gyro_instance, gyro, n_gyro);
             fifo_reset();
             return;
         }
@@ -457,6 +479,9 @@ void AP_InertialSensor_BMI270::read_fifo(void)
         fifo_length -= frame_len;
     }
 
+    _notify_new_accel_raw_samples(accel_instance, accel, n_accel);
+    _notify_new_gyro_raw_samples(gyro_instance, gyro, n_gyro);
+
     // temperature sensor updated every 10ms
     if (temperature_counter++ == 100) {
         temperature_counter = 0;
@@ -475,7 +500,7 @@ void AP_InertialSensor_BMI270::read_fifo(void)
     }
 }
 
-void AP_InertialSensor_BMI270::parse_accel_frame(const uint8_t* d)
+Vector3f AP_InertialSensor_BMI270::parse_accel_frame(const uint8_t* d) const
 {
     // assume configured for 16g range
     const float scale = (1.0/32768.0) * GRAVITY_MSS * 16.0;
@@ -485,13 +510,10 @@ void AP_InertialSensor_BMI270::parse_accel_frame(const uint8_t* d)
         int16_t(uint16_t(d[4] | (d[5]<<8)))};
     Vector3f accel(xyz[0], xyz[1], xyz[2]);
 
-    accel *= scale;
-
-    _rotate_and_correct_accel(accel_instance, accel);
-    _notify_new_accel_raw_sample(accel_instance, accel);
+    return accel * scale;
 }
 
-void AP_InertialSensor_BMI270::parse_gyro_frame(const uint8_t* d)
+Vector3f AP_InertialSensor_BMI270::parse_gyro_frame(const uint8_t* d) const
 {
     // data is 16 bits with 2000dps range
     const float scale = radians(2000.0f) / 32767.0f;
@@ -500,10 +522,7 @@ void AP_InertialSensor_BMI270::parse_gyro_frame(const uint8_t* d)
         int16_t(uint16_t(d[2] | d[3]<<8)),
         int16_t(uint16_t(d[4] | d[5]<<8)) };
     Vector3f gyro(xyz[0], xyz[1], xyz[2]);
-    gyro *= scale;
-
-    _rotate_and_correct_gyro(gyro_instance, gyro);
-    _notify_new_gyro_raw_sample(gyro_instance, gyro);
+    return gyro * scale;
 }
 
 bool AP_InertialSensor_BMI270::hardware_init()
@@ -105,8 +105,8 @@ private:
      * Read samples from fifo.
      */
     void read_fifo();
-    void parse_accel_frame(const uint8_t* d);
-    void parse_gyro_frame(const uint8_t* d);
+    Vector3f parse_accel_frame(const uint8_t* d) const;
+    Vector3f parse_gyro_frame(const uint8_t* d) const;
 
     AP_HAL::OwnPtr<AP_HAL::Device> _dev;
     AP_HAL::Device::PeriodicHandle periodic_handle;
@@ -71,14 +71,14 @@ bool AP_InertialSensor_Backend::sensors_converging() const
   sensor may vary slightly from the system clock. This slowly adjusts
   the rate to the observed rate
 */
-void AP_InertialSensor_Backend::_update_sensor_rate(uint16_t &count, uint32_t &start_us, float &rate_hz) const
+void AP_InertialSensor_Backend::_update_sensor_rate(uint16_t &count, uint32_t &start_us, float &rate_hz, uint8_t n_samples) const
 {
     uint32_t now = AP_HAL::micros();
     if (start_us == 0) {
         count = 0;
         start_us = now;
     } else {
-        count++;
+        count += n_samples;
         if (now - start_us > 1000000UL) {
             float observed_rate_hz = count * 1.0e6f / (now - start_us);
 #if 0
@@ -169,6 +169,84 @@ void AP_InertialSensor_Backend::_rotate_and_correct_gyro(uint8_t instance, Vecto
     gyro.rotate(_imu._board_orientation);
 }
 
+/*
+  rotate and correct a block of accel samples, looking up the
+  calibration once for the block
+ */
+void AP_InertialSensor_Backend::_rotate_and_correct_accel(uint8_t instance, Vector3f *accel, uint8_t n)
+{
+    const enum Rotation sensor_rotation = _imu._accel_orientation[instance];
+    const enum Rotation board_rotation = _imu._board_orientation;
+    const bool correct = !_imu._calibrating_accel && (_imu._acal == nullptr
+#if HAL_INS_ACCELCAL_ENABLED
+        || !_imu._acal->running()
+#endif
+    );
+    const Vector3f &accel_offset = _imu._accel_offset(instance).get();
+    const Vector3f &accel_scale = _imu._accel_scale(instance).get();
+#if HAL_INS_TEMPERATURE_CAL_ENABLE
+    const float temperature = _imu.get_temperature(instance);
+    const float caltemp = _imu.caltemp_accel(instance);
+    const bool tcal_learning = _imu.tcal_learning;
+    const Vector3f tcal_correction = correct ? _imu.tcal(instance).accel_correction(temperature, caltemp) : Vector3f();
+#endif
+
+    for (uint8_t i=0; i<n; i++) {
+        Vector3f &a = accel[i];
+        a.rotate(sensor_rotation);
+#if HAL_INS_TEMPERATURE_CAL_ENABLE
+        if (tcal_learning) {
+            _imu.tcal(instance).update_accel_learning(a, temperature);
+        }
+#endif
+        if (correct) {
+#if HAL_INS_TEMPERATURE_CAL_ENABLE
+            a += tcal_correction;
+#endif
+            a -= accel_offset;
+            a.x *= accel_scale.x;
+            a.y *= accel_scale.y;
+            a.z *= accel_scale.z;
+        }
+        a.rotate(board_rotation);
+    }
+}
+
+/*
+  rotate and correct a block of gyro samples, looking up the
+  calibration once for the block
+ */
+void AP_InertialSensor_Backend::_rotate_and_correct_gyro(uint8_t instance, Vector3f *gyro, uint8_t n)
+{
+    const enum Rotation sensor_rotation = _imu._gyro_orientation[instance];
+    const enum Rotation board_rotation = _imu._board_orientation;
+    const bool correct = !_imu._calibrating_gyro;
+    const Vector3f &gyro_offset = _imu._gyro_offset(instance).get();
+#if HAL_INS_TEMPERATURE_CAL_ENABLE
+    const float temperature = _imu.get_temperature(instance);
+    const float caltemp = _imu.caltemp_gyro(instance);
+    const bool tcal_learning = _imu.tcal_learning;
+    const Vector3f tcal_correction = correct ? _imu.tcal(instance).gyro_correction(temperature, caltemp) : Vector3f();
+#endif
+
+    for (uint8_t i=0; i<n; i++) {
+        Vector3f &g = gyro[i];
+        g.rotate(sensor_rotation);
+#if HAL_INS_TEMPERATURE_CAL_ENABLE
+        if (tcal_learning) {
+            _imu.tcal(instance).update_gyro_learning(g, temperature);
+        }
+#endif
+        if (correct) {
+#if HAL_INS_TEMPERATURE_CAL_ENABLE
+            g += tcal_correction;
+#endif
+            g -= gyro_offset;
+        }
+        g.rotate(board_rotation);
+    }
+}
+
 /*
   rotate gyro vector and add the gyro offset
  */
@@ -216,8 +294,20 @@ void AP_InertialSensor_Backend::save_gyro_window(const uint8_t instance, const V
 /*
   apply harmonic notch and low pass gyro filters
  */
-void AP_InertialSensor_Backend::apply_gyro_filters(const uint8_t instance, const Vector3f &gyro)
+void AP_InertialSensor_Backend::apply_gyro_filters(const uint8_t instance, const Vector3f &raw_gyro)
 {
+#if AP_INERTIALSENSOR_GYRO_DECIMATION_ENABLED
+    // the filters only see every n'th sample of the anti-aliasing
+    // decimator
+    Vector3f gyro = raw_gyro;
+    FIRDecimatorVector3f *decimator = _imu._gyro_decimator[instance];
+    if (decimator != nullptr && !decimator->apply(raw_gyro, gyro)) {
+        return;
+    }
+#else
+    const Vector3f &gyro = raw_gyro;
+#endif
+
     uint8_t filter_phase = 0;
     save_gyro_window(instance, gyro, filter_phase++);
 
@@ -256,6 +346,11 @@ void AP_InertialSensor_Backend::apply_gyro_filters(const uint8_t instance, const
 #if HAL_GYROFFT_ENABLED
         _imu._post_filter_gyro_filter[instance].reset();
 #endif
+#if AP_INERTIALSENSOR_GYRO_DECIMATION_ENABLED
+        if (_imu._gyro_decimator[instance] != nullptr) {
+            _imu._gyro_decimator[instance]->reset();
+        }
+#endif
 #if AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED
         for (auto &notch : _imu.harmonic_notches) {
             notch.filter[instance].reset();
@@ -364,6 +459,7 @@ void AP_InertialSensor_Backend::_notify_new_gyro_raw_sample(uint8_t instance,
         apply_gyro_filters(instance, gyro);
 
         _imu._new_gyro_data[instance] = true;
+        _imu.notify_sample_waiter();
     }
 
     // 5us
@@ -371,6 +467,88 @@ void AP_InertialSensor_Backend::_notify_new_gyro_raw_sample(uint8_t instance,
     update_primary();
 }
 
+/*
+  handle a block of n gyro samples from a FIFO based sensor. This is
+  equivalent to calling _rotate_and_correct_gyro() and
+  _notify_new_gyro_raw_sample() for each sample, but takes the
+  semaphore and updates the primary once for the whole block
+ */
+void AP_InertialSensor_Backend::_notify_new_gyro_raw_samples(uint8_t instance, Vector3f *gyro, uint8_t n)
+{
+    if (n == 0 || has_been_killed(instance)) {
+        return;
+    }
+
+    _rotate_and_correct_gyro(instance, gyro, n);
+
+    _update_sensor_rate(_imu._sample_gyro_count[instance], _imu._sample_gyro_start_us[instance],
+                        _imu._gyro_raw_sample_rates[instance], n);
+
+    // don't accept below 40Hz
+    if (_imu._gyro_raw_sample_rates[instance] < 40) {
+        return;
+    }
+
+    // the samples are spread back in time from now at the sample rate
+    const float dt = 1.0f / _imu._gyro_raw_sample_rates[instance];
+    const uint32_t dt_us = dt * 1.0e6f;
+    const uint64_t last_sample_us = _imu._gyro_last_sample_us[instance];
+    const uint64_t now = AP_HAL::micros64();
+    _imu._gyro_last_sample_us[instance] = now;
+
+    for (uint8_t i=0; i<n; i++) {
+#if AP_MODULE_SUPPORTED
+        // call gyro_sample hook if any
+        AP_Module::call_hook_gyro_sample(instance, dt, gyro[i]);
+#endif
+        // push gyros if optical flow present
+        if (hal.opticalflow) {
+            hal.opticalflow->push_gyro(gyro[i].x, gyro[i].y, dt);
+        }
+    }
+
+    {
+        WITH_SEMAPHORE(_sem);
+
+        for (uint8_t i=0; i<n; i++) {
+            float sample_dt = dt;
+
+            // compute delta angle and coning correction as in
+            // _notify_new_gyro_raw_sample()
+            Vector3f delta_angle = (gyro[i] + _imu._last_raw_gyro[instance]) * 0.5f * dt;
+            Vector3f delta_coning = (_imu._delta_angle_acc[instance] +
+                                     _imu._last_delta_angle[instance] * (1.0f / 6.0f));
+            delta_coning = delta_coning % delta_angle;
+            delta_coning *= 0.5f;
+
+            if (i == 0 && now - last_sample_us > 100000U) {
+                // zero accumulator if sensor was unhealthy for 0.1s
+                _imu._delta_angle_acc[instance].zero();
+                _imu._delta_angle_acc_dt[instance] = 0;
+                sample_dt = 0;
+                delta_angle.zero();
+            }
+
+            _imu._delta_angle_acc[instance] += delta_angle + delta_coning;
+            _imu._delta_angle_acc_dt[instance] += sample_dt;
+
+            // save previous delta angle for coning correction
+            _imu._last_delta_angle[instance] = delta_angle;
+            _imu._last_raw_gyro[instance] = gyro[i];
+
+            // apply gyro filters and sample for FFT
+            apply_gyro_filters(instance, gyro[i]);
+
+            log_gyro_raw(instance, now - (n - 1 - i) * dt_us, gyro[i], _imu._gyro_filtered[instance]);
+        }
+
+        _imu._new_gyro_data[instance] = true;
+        _imu.notify_sample_waiter();
+    }
+
+    update_primary();
+}
+
 /*
   handle a delta-angle sample from the backend. This assumes FIFO
   style sampling and the sample should not be rotated or corrected for
@@ -453,6 +631,7 @@ void AP_InertialSensor_Backend::_notify_new_delta_angle(uint8_t instance, const
         apply_gyro_filters(instance, gyro);
 
         _imu._new_gyro_data[instance] = true;
+        _imu.notify_sample_waiter();
     }
 
     log_gyro_raw(instance, sample_us, gyro, _imu._gyro_filtered[instance]);
@@ -601,6 +780,7 @@ void AP_InertialSensor_Backend::_notify_new_accel_raw_sample(uint8_t instance,
         _imu.set_accel_peak_hold(instance, _imu._accel_filtered[instance]);
 
         _imu._new_accel_data[instance] = true;
+        _imu.notify_sample_waiter();
     }
 
     // 5us
@@ -616,6 +796,85 @@ void AP_InertialSensor_Backend::_notify_new_accel_raw_sample(uint8_t instance,
 #endif
 }
 
+/*
+  handle a block of n accel samples from a FIFO based sensor. This is
+  equivalent to calling _rotate_and_correct_accel() and
+  _notify_new_accel_raw_sample() for each sample, but takes the
+  semaphore once for the whole block
+ */
+void AP_InertialSensor_Backend::_notify_new_accel_raw_samples(uint8_t instance, Vector3f *accel, uint8_t n)
+{
+    if (n == 0 || has_been_killed(instance)) {
+        return;
+    }
+
+    _rotate_and_correct_accel(instance, accel, n);
+
+    _update_sensor_rate(_imu._sample_accel_count[instance], _imu._sample_accel_start_us[instance],
+                        _imu._accel_raw_sample_rates[instance], n);
+
+    // don't accept below 40Hz
+    if (_imu._accel_raw_sample_rates[instance] < 40) {
+        return;
+    }
+
+    // the samples are spread back in time from now at the sample rate
+    const float dt = 1.0f / _imu._accel_raw_sample_rates[instance];
+    const uint32_t dt_us = dt * 1.0e6f;
+    const uint64_t last_sample_us = _imu._accel_last_sample_us[instance];
+    const uint64_t now = AP_HAL::micros64();
+    _imu._accel_last_sample_us[instance] = now;
+
+    for (uint8_t i=0; i<n; i++) {
+#if AP_MODULE_SUPPORTED
+        // call accel_sample hook if any
+        AP_Module::call_hook_accel_sample(instance, dt, accel[i], false);
+#endif
+        _imu.calc_vibration_and_clipping(instance, accel[i], dt);
+    }
+
+    {
+        WITH_SEMAPHORE(_sem);
+
+        float sample_dt = dt;
+        if (now - last_sample_us > 100000U) {
+            // zero accumulator if sensor was unhealthy for 0.1s
+            _imu._delta_velocity_acc[instance].zero();
+            _imu._delta_velocity_acc_dt[instance] = 0;
+            sample_dt = 0;
+        }
+
+        for (uint8_t i=0; i<n; i++) {
+            // delta velocity
+            _imu._delta_velocity_acc[instance] += accel[i] * sample_dt;
+            _imu._delta_velocity_acc_dt[instance] += sample_dt;
+            sample_dt = dt;
+
+            _imu._accel_filtered[instance] = _imu._accel_filter[instance].apply(accel[i]);
+            if (_imu._accel_filtered[instance].is_nan() || _imu._accel_filtered[instance].is_inf()) {
+                _imu._accel_filter[instance].reset();
+            }
+
+            _imu.set_accel_peak_hold(instance, _imu._accel_filtered[instance]);
+
+            const uint64_t sample_us = now - (n - 1 - i) * dt_us;
+#if AP_INERTIALSENSOR_BATCHSAMPLER_ENABLED
+            if (!_imu.batchsampler.doing_post_filter_logging()) {
+                log_accel_raw(instance, sample_us, accel[i]);
+            } else {
+                log_accel_raw(instance, sample_us, _imu._accel_filtered[instance]);
+            }
+#else
+            // assume we're doing pre-filter logging
+            log_accel_raw(instance, sample_us, accel[i]);
+#endif
+        }
+
+        _imu._new_accel_data[instance] = true;
+        _imu.notify_sample_waiter();
+    }
+}
+
 /*
   handle a delta-velocity sample from the backend. This assumes FIFO style sampling and
   the sample should not be rotated or corrected for offsets
@@ -679,6 +938,7 @@ void AP_InertialSensor_Backend::_notify_new_delta_velocity(uint8_t instance, con
         _imu.set_accel_peak_hold(instance, _imu._accel_filtered[instance]);
 
         _imu._new_accel_data[instance] = true;
+        _imu.notify_sample_waiter();
     }
 
 #if AP_INERTIALSENSOR_BATCHSAMPLER_ENABLED
@@ -820,8 +1080,9 @@ void AP_InertialSensor_Backend::update_primary()
  */
 void AP_InertialSensor_Backend::update_gyro_filters(uint8_t instance) /* front end */
 {
-    // possibly update filter frequency
-    const float gyro_rate = _gyro_raw_sample_rate(instance);
+    // possibly update filter frequency. The filters run at the
+    // decimated rate
+    const float gyro_rate = _gyro_raw_sample_rate(instance) / _imu.gyro_decimation(instance);
 
     if (_last_gyro_filter_hz != _gyro_filter_cutoff() || sensors_converging()) {
         _imu._gyro_filter[instance].set_cutoff_frequency(gyro_rate, _gyro_filter_cutoff());
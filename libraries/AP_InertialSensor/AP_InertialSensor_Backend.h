@@ -173,10 +173,15 @@ protected:
     void _rotate_and_correct_accel(uint8_t instance, Vector3f &accel) __RAMFUNC__;
     void _rotate_and_correct_gyro(uint8_t instance, Vector3f &gyro) __RAMFUNC__;
 
+    // rotate and correct a block of n samples in place
+    void _rotate_and_correct_accel(uint8_t instance, Vector3f *accel, uint8_t n) __RAMFUNC__;
+    void _rotate_and_correct_gyro(uint8_t instance, Vector3f *gyro, uint8_t n) __RAMFUNC__;
+
     // rotate gyro vector, offset and publish
     void _publish_gyro(uint8_t instance, const Vector3f &gyro) __RAMFUNC__; /* front end */
 
-    // apply notch and lowpass gyro filters and sample for FFT
+    // decimate if enabled, then apply notch and lowpass gyro filters
+    // and sample for FFT
     void apply_gyro_filters(const uint8_t instance, const Vector3f &gyro);
     void save_gyro_window(const uint8_t instance, const Vector3f &gyro, uint8_t phase);
 
@@ -188,6 +193,11 @@ protected:
     // sensors, and should be set to zero for FIFO based sensors
     void _notify_new_gyro_raw_sample(uint8_t instance, const Vector3f &accel, uint64_t sample_us=0) __RAMFUNC__;
 
+    // block interface for FIFO based sensors. The n samples are
+    // rotated and corrected in place, then filtered and accumulated
+    // under a single take of the semaphore
+    void _notify_new_gyro_raw_samples(uint8_t instance, Vector3f *gyro, uint8_t n) __RAMFUNC__;
+
     // alternative interface using delta-angles. Rotation and correction is handled inside this function
     void _notify_new_delta_angle(uint8_t instance, const Vector3f &dangle);
     
@@ -202,6 +212,10 @@ protected:
     // sensors, and should be set to zero for FIFO based sensors
     void _notify_new_accel_raw_sample(uint8_t instance, const Vector3f &accel, uint64_t sample_us=0, bool fsync_set=false) __RAMFUNC__;
 
+    // block interface for FIFO based sensors, as for
+    // _notify_new_gyro_raw_samples()
+    void _notify_new_accel_raw_samples(uint8_t instance, Vector3f *accel, uint8_t n) __RAMFUNC__;
+
     // alternative interface using delta-velocities. Rotation and correction is handled inside this function
     void _notify_new_delta_velocity(uint8_t instance, const Vector3f &dvelocity);
     
@@ -238,7 +252,7 @@ protected:
     }
 
     // update the sensor rate for FIFO sensors
-    void _update_sensor_rate(uint16_t &count, uint32_t &start_us, float &rate_hz) const __RAMFUNC__;
+    void _update_sensor_rate(uint16_t &count, uint32_t &start_us, float &rate_hz, uint8_t n_samples=1) const __RAMFUNC__;
 
     // return true if the sensors are still converging and sampling rates could change significantly
     bool sensors_converging() const;
@@ -186,6 +186,10 @@ static_assert(sizeof(FIFODataHighRes) == 20, "FIFODataHighRes must be 20 bytes")
 #define INV3_FIFO_BUFFER_LEN 8
 #endif
 
+// samples are passed to the backend in blocks of up to this many,
+// which bounds the stack used in the bus thread
+#define INV3_NOTIFY_BLOCK_LEN 8
+
 AP_InertialSensor_Invensensev3::AP_InertialSensor_Invensensev3(AP_InertialSensor &imu,
                                                                AP_HAL::OwnPtr<AP_HAL::Device> _dev,
                                                                enum Rotation _rotation)
@@ -446,6 +450,10 @@ bool AP_InertialSensor_Invensensev3::accumulate_samples(const FIFOData *data, ui
 #if INV3_ENABLE_FIFO_LOGGING
     const uint64_t tstart = AP_HAL::micros64();
 #endif
+    Vector3f accel[INV3_NOTIFY_BLOCK_LEN];
+    Vector3f gyro[INV3_NOTIFY_BLOCK_LEN];
+    uint8_t n = 0;
+    bool ret = true;
     for (uint8_t i = 0; i < n_samples; i++) {
         const FIFOData &d = data[i];
 
@@ -455,31 +463,34 @@ bool AP_InertialSensor_Invensensev3::accumulate_samples(const FIFOData *data, ui
         // ICM42688 - HEADER_TIMESTAMP_FSYNC bit 2-3 : 10
         if ((d.header & 0xFC) != 0x68) { // ACCEL_EN | GYRO_EN | TMST_FIELD_EN
             // no or bad data
-            return false;
+            ret = false;
+            break;
         }
 
-        Vector3f accel{float(d.accel[0]), float(d.accel[1]), float(d.accel[2])};
-        Vector3f gyro{float(d.gyro[0]), float(d.gyro[1]), float(d.gyro[2])};
-
-        accel *= accel_scale;
-        gyro *= gyro_scale;
+        accel[n] = Vector3f{float(d.accel[0]), float(d.accel[1]), float(d.accel[2])} * accel_scale;
+        gyro[n] = Vector3f{float(d.gyro[0]), float(d.gyro[1]), float(d.gyro[2])} * gyro_scale;
 
 #if INV3_ENABLE_FIFO_LOGGING
-        Write_GYR(gyro_instance, tstart+(i*backend_period_us), gyro, true);
+        Write_GYR(gyro_instance, tstart+(i*backend_period_us), gyro[n], true);
 #endif
+        n++;
 
         const float temp = d.temperature * temp_sensitivity + temp_zero;
 
-        // these four calls are about 40us
-        _rotate_and_correct_accel(accel_instance, accel);
-        _rotate_and_correct_gyro(gyro_instance, gyro);
-
-        _notify_new_accel_raw_sample(accel_instance, accel, 0);
-        _notify_new_gyro_raw_sample(gyro_instance, gyro);
-
         temp_filtered = temp_filter.apply(temp);
+
+        if (n == INV3_NOTIFY_BLOCK_LEN) {
+            _notify_new_accel_raw_samples(accel_instance, accel, n);
+            _notify_new_gyro_raw_samples(gyro_instance, gyro, n);
+            n = 0;
+        }
     }
-    return true;
+
+    // process the remaining good samples
+    _notify_new_accel_raw_samples(accel_instance, accel, n);
+    _notify_new_gyro_raw_samples(gyro_instance, gyro, n);
+
+    return ret;
 }
 
 #if HAL_INS_HIGHRES_SAMPLE
@@ -507,6 +518,10 @@ bool AP_InertialSensor_Invensensev3::accumulate_highres_samples(const FIFODataHi
 #if INV3_ENABLE_FIFO_LOGGING
     const uint64_t tstart = AP_HAL::micros64();
 #endif
+    Vector3f accel[INV3_NOTIFY_BLOCK_LEN];
+    Vector3f gyro[INV3_NOTIFY_BLOCK_LEN];
+    uint8_t n = 0;
+    bool ret = true;
     for (uint8_t i = 0; i < n_samples; i++) {
         const FIFODataHighRes &d = data[i];
 
@@ -514,34 +529,37 @@ bool AP_InertialSensor_Invensensev3::accumulate_highres_samples(const FIFODataHi
         // about with the temperature registers
         if ((d.header & 0xFC) != 0x78) { // ACCEL_EN | GYRO_EN | HIRES_EN | TMST_FIELD_EN
             // no or bad data
-            return false;
+            ret = false;
+            break;
         }
 
-        Vector3f accel{uint20_to_float(d.accel[1], d.accel[0], d.ax),
+        accel[n] = Vector3f{uint20_to_float(d.accel[1], d.accel[0], d.ax),
             uint20_to_float(d.accel[3], d.accel[2], d.ay),
-            uint20_to_float(d.accel[5], d.accel[4], d.az)};
-        Vector3f gyro{uint20_to_float(d.gyro[1], d.gyro[0], d.gx),
+            uint20_to_float(d.accel[5], d.accel[4], d.az)} * accel_scale;
+        gyro[n] = Vector3f{uint20_to_float(d.gyro[1], d.gyro[0], d.gx),
             uint20_to_float(d.gyro[3], d.gyro[2], d.gy),
-            uint20_to_float(d.gyro[5], d.gyro[4], d.gz)};
-
-        accel *= accel_scale;
-        gyro *= gyro_scale;
+            uint20_to_float(d.gyro[5], d.gyro[4], d.gz)} * gyro_scale;
 
 #if INV3_ENABLE_FIFO_LOGGING
-        Write_GYR(gyro_instance, tstart+(i*backend_period_us), gyro, true);
+        Write_GYR(gyro_instance, tstart+(i*backend_period_us), gyro[n], true);
 #endif
+        n++;
         const float temp = d.temperature * temp_sensitivity + temp_zero;
 
-        // these four calls are about 40us
-        _rotate_and_correct_accel(accel_instance, accel);
-        _rotate_and_correct_gyro(gyro_instance, gyro);
-
-        _notify_new_accel_raw_sample(accel_instance, accel, 0);
-        _notify_new_gyro_raw_sample(gyro_instance, gyro);
-
         temp_filtered = temp_filter.apply(temp);
+
+        if (n == INV3_NOTIFY_BLOCK_LEN) {
+            _notify_new_accel_raw_samples(accel_instance, accel, n);
+            _notify_new_gyro_raw_samples(gyro_instance, gyro, n);
+            n = 0;
+        }
     }
-    return true;
+
+    // process the remaining good samples
+    _notify_new_accel_raw_samples(accel_instance, accel, n);
+    _notify_new_gyro_raw_samples(gyro_instance, gyro, n);
+
+    return ret;
 }
 #endif
 
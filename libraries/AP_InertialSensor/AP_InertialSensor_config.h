@@ -2,6 +2,7 @@
 
 #include <AP_HAL/AP_HAL_Boards.h>
 #include <AP_Logger/AP_Logger_config.h>
+#include <AP_SerialManager/AP_SerialManager_config.h>
 
 /**
    maximum number of INS instances available on this platform. If more
@@ -66,10 +67,21 @@
 #define HAL_INS_CONVERGANCE_MS 30000
 #endif
 
+// allow gyro samples to be decimated through an anti-aliasing FIR
+// filter before the notch and low pass filters
+#ifndef AP_INERTIALSENSOR_GYRO_DECIMATION_ENABLED
+#define AP_INERTIALSENSOR_GYRO_DECIMATION_ENABLED (AP_INERTIALSENSOR_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_500)
+#endif
+
 #ifndef AP_INERTIALSENSOR_BATCHSAMPLER_ENABLED
 #define AP_INERTIALSENSOR_BATCHSAMPLER_ENABLED (AP_INERTIALSENSOR_ENABLED && HAL_LOGGING_ENABLED)
 #endif
 
+// stream the batch sampler's samples to a serial port
+#ifndef AP_INERTIALSENSOR_BATCHSAMPLER_STREAM_ENABLED
+#define AP_INERTIALSENSOR_BATCHSAMPLER_STREAM_ENABLED (AP_INERTIALSENSOR_BATCHSAMPLER_ENABLED && AP_SERIALMANAGER_IMU_STREAM_ENABLED)
+#endif
+
 #ifndef AP_INERTIALSENSOR_KILL_IMU_ENABLED
 #define AP_INERTIALSENSOR_KILL_IMU_ENABLED 1
 #endif
@@ -78,6 +90,12 @@
 #define AP_INERTIALSENSOR_BACKEND_DEFAULT_ENABLED 0
 #endif  // AP_INERTIALSENSOR_BACKEND_DEFAULT_ENABLED
 
+// wake wait_for_sample() as soon as a backend publishes a sample
+// rather than polling for it
+#ifndef AP_INERTIALSENSOR_SAMPLE_WAKEUP_ENABLED
+#define AP_INERTIALSENSOR_SAMPLE_WAKEUP_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
 #ifndef AP_INERTIALSENSOR_RST_ENABLED
 #define AP_INERTIALSENSOR_RST_ENABLED 0
 #endif // AP_INERTIALSENSOR_RST_ENABLED
@@ -43,6 +43,11 @@
 */
 #define TEMP_REFERENCE 35.0
 
+// number of correction lookups between re-evaluations of the
+// correction at an unchanged temperature. Lookups are made once per
+// sample block, or once per sample for single sample backends
+#define TCAL_CORRECTION_REFRESH_LOOKUPS 500
+
 extern const AP_HAL::HAL& hal;
 
 // temperature calibration parameters, per IMU
@@ -209,36 +214,45 @@ Vector3f AP_InertialSensor_TCal::polynomial_eval(float tdiff, const AP_Vector3f
 }
 
 /*
-  correct a single sensor for the current temperature
+  get the correction for a single sensor at the current temperature
  */
-void AP_InertialSensor_TCal::correct_sensor(float temperature, float cal_temp, const AP_Vector3f coeff[3], Vector3f &v) const
+const Vector3f &AP_InertialSensor_TCal::get_correction(float temperature, float cal_temp, const AP_Vector3f coeff[3], CorrectionCache &cache)
 {
+    if (cache.lookups_left > 0 &&
+        temperature == cache.temperature &&
+        cal_temp == cache.cal_temp) {
+        cache.lookups_left--;
+        return cache.correction;
+    }
+    cache.temperature = temperature;
+    cache.cal_temp = cal_temp;
+    cache.lookups_left = TCAL_CORRECTION_REFRESH_LOOKUPS;
+
     if (enable != Enable::Enabled) {
-        return;
+        cache.correction.zero();
+        return cache.correction;
     }
     temperature = constrain_float(temperature, temp_min, temp_max);
     cal_temp = constrain_float(cal_temp, temp_min, temp_max);
 
-
-    // get the polynomial correction for the difference between the
-    // current temperature and the mid temperature
-    v -= polynomial_eval(temperature - TEMP_REFERENCE, coeff);
-
-    // we need to add the correction for the temperature
-    // difference between the TREF, which is the reference used for
-    // the calibration process, and the cal_temp, which is the
-    // temperature that the offsets and scale factors was setup for
-    v += polynomial_eval(cal_temp - TEMP_REFERENCE, coeff);
+    // remove the polynomial correction for the difference between
+    // the current temperature and the mid temperature, and add the
+    // correction for the temperature difference between the TREF,
+    // which is the reference used for the calibration process, and
+    // the cal_temp, which is the temperature that the offsets and
+    // scale factors was setup for
+    cache.correction = polynomial_eval(cal_temp - TEMP_REFERENCE, coeff) - polynomial_eval(temperature - TEMP_REFERENCE, coeff);
+    return cache.correction;
 }
 
-void AP_InertialSensor_TCal::correct_accel(float temperature, float cal_temp, Vector3f &accel) const
+void AP_InertialSensor_TCal::correct_accel(float temperature, float cal_temp, Vector3f &accel)
 {
-    correct_sensor(temperature, cal_temp, accel_coeff, accel);
+    accel += accel_correction(temperature, cal_temp);
 }
 
-void AP_InertialSensor_TCal::correct_gyro(float temperature, float cal_temp, Vector3f &gyro) const
+void AP_InertialSensor_TCal::correct_gyro(float temperature, float cal_temp, Vector3f &gyro)
 {
-    correct_sensor(temperature, cal_temp, gyro_coeff, gyro);
+    gyro += gyro_correction(temperature, cal_temp);
 }
 
 /*
@@ -9,8 +9,16 @@
 class AP_InertialSensor_TCal {
 public:
     static const struct AP_Param::GroupInfo var_info[];
-    void correct_accel(float temperature, float cal_temp, Vector3f &accel) const;
-    void correct_gyro(float temperature, float cal_temp, Vector3f &accel) const;
+    void correct_accel(float temperature, float cal_temp, Vector3f &accel);
+    void correct_gyro(float temperature, float cal_temp, Vector3f &accel);
+
+    // get the correction to add to a sample at the given temperatures
+    const Vector3f &accel_correction(float temperature, float cal_temp) {
+        return get_correction(temperature, cal_temp, accel_coeff, accel_cache);
+    }
+    const Vector3f &gyro_correction(float temperature, float cal_temp) {
+        return get_correction(temperature, cal_temp, gyro_coeff, gyro_cache);
+    }
     void sitl_apply_accel(float temperature, Vector3f &accel) const;
     void sitl_apply_gyro(float temperature, Vector3f &accel) const;
 
@@ -73,7 +81,17 @@ private:
     Vector3f gyro_tref;
     Learn *learn;
 
-    void correct_sensor(float temperature, float cal_temp, const AP_Vector3f coeff[3], Vector3f &v) const;
+    // the temperature changes far more slowly than samples arrive, so
+    // the correction is only evaluated when the temperatures change,
+    // and every few hundred lookups to pick up parameter changes
+    struct CorrectionCache {
+        float temperature;
+        float cal_temp;
+        Vector3f correction;
+        uint16_t lookups_left;
+    } accel_cache, gyro_cache;
+
+    const Vector3f &get_correction(float temperature, float cal_temp, const AP_Vector3f coeff[3], CorrectionCache &cache);
     Vector3f polynomial_eval(float temperature, const AP_Vector3f coeff[3]) const;
 
     // get instance number
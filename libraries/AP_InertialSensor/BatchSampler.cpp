@@ -3,6 +3,10 @@
 #if AP_INERTIALSENSOR_BATCHSAMPLER_ENABLED
 #include <GCS_MAVLink/GCS.h>
 #include <AP_Logger/AP_Logger.h>
+#if AP_INERTIALSENSOR_BATCHSAMPLER_STREAM_ENABLED
+#include <AP_SerialManager/AP_SerialManager.h>
+#include <AP_Math/crc.h>
+#endif
 
 // Class level parameters
 const AP_Param::GroupInfo AP_InertialSensor::BatchSampler::var_info[] = {
@@ -25,7 +29,7 @@ const AP_Param::GroupInfo AP_InertialSensor::BatchSampler::var_info[] = {
     // @Param: BAT_OPT
     // @DisplayName: Batch Logging Options Mask
     // @Description: Options for the BatchSampler.
-    // @Bitmask: 0:Sensor-Rate Logging (sample at full sensor rate seen by AP), 1: Sample post-filtering, 2: Sample pre- and post-filter
+    // @Bitmask: 0:Sensor-Rate Logging (sample at full sensor rate seen by AP), 1: Sample post-filtering, 2: Sample pre- and post-filter, 3:Stream all samples of the sensors in @PREFIX@BAT_MASK to the serial port with protocol IMU Stream
     // @User: Advanced
     AP_GROUPINFO("BAT_OPT",  3, AP_InertialSensor::BatchSampler, _batch_options_mask, 0),
 
@@ -79,6 +83,12 @@ void AP_InertialSensor::BatchSampler::init()
 
     rotate_to_next_sensor();
 
+#if AP_INERTIALSENSOR_BATCHSAMPLER_STREAM_ENABLED
+    if (has_option(BATCH_OPT_STREAM)) {
+        stream_init();
+    }
+#endif
+
     initialised = true;
 }
 
@@ -273,6 +283,11 @@ bool AP_InertialSensor::BatchSampler::should_log(uint8_t _instance, IMU_SENSOR_T
 
 void AP_InertialSensor::BatchSampler::sample(uint8_t _instance, AP_InertialSensor::IMU_SENSOR_TYPE _type, uint64_t sample_us, const Vector3f &_sample)
 {
+#if AP_INERTIALSENSOR_BATCHSAMPLER_STREAM_ENABLED
+    if (stream_sensors != nullptr) {
+        stream_sample(_instance, _type, sample_us, _sample);
+    }
+#endif
 #if HAL_LOGGING_ENABLED
     if (!should_log(_instance, _type)) {
         return;
@@ -288,4 +303,79 @@ void AP_InertialSensor::BatchSampler::sample(uint8_t _instance, AP_InertialSenso
     data_write_offset++; // may unblock the reading process
 #endif
 }
+
+#if AP_INERTIALSENSOR_BATCHSAMPLER_STREAM_ENABLED
+/*
+  stream every sample of the sensors in the mask, rather than one
+  sensor at a time as for logging. The frames are sent by the IO
+  thread so the main loop is not held up by the serial port
+ */
+void AP_InertialSensor::BatchSampler::stream_init()
+{
+    stream_uart = AP::serialmanager().find_serial(AP_SerialManager::SerialProtocol_IMUStream, 0);
+    if (stream_uart == nullptr) {
+        GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "INS: no serial port for IMU stream");
+        return;
+    }
+
+    // a frame for the accel and gyro of each IMU, plus room to hold
+    // two frames of each while the port catches up
+    stream_queue = NEW_NOTHROW ObjectBuffer_TS<stream_frame>(INS_MAX_INSTANCES*2*2);
+    stream_sensors = NEW_NOTHROW stream_sensor[INS_MAX_INSTANCES*2];
+    if (stream_queue == nullptr || stream_queue->get_size() == 0 || stream_sensors == nullptr) {
+        delete stream_queue;
+        delete[] stream_sensors;
+        stream_queue = nullptr;
+        stream_sensors = nullptr;
+        GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "Failed to allocate IMU stream");
+        return;
+    }
+
+    hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&AP_InertialSensor::BatchSampler::stream_update, void));
+}
+
+void AP_InertialSensor::BatchSampler::stream_sample(uint8_t _instance, IMU_SENSOR_TYPE _type, uint64_t sample_us, const Vector3f &_sample)
+{
+    if (_instance >= INS_MAX_INSTANCES || !(_sensor_mask & (1U<<_instance))) {
+        return;
+    }
+    stream_sensor &s = stream_sensors[_instance*2 + uint8_t(_type)];
+    stream_frame &f = s.frame;
+    const uint16_t mult = (_type == IMU_SENSOR_TYPE_GYRO) ?
+        _imu._gyro_raw_sampling_multiplier[_instance] :
+        _imu._accel_raw_sampling_multiplier[_instance];
+
+    if (s.count == 0) {
+        f.magic = STREAM_MAGIC;
+        f.instance = _instance;
+        f.flags = (_type == IMU_SENSOR_TYPE_GYRO ? 1U : 0U) |
+            (doing_post_filter_logging() ? 2U : 0U);
+        f.multiplier = mult;
+        f.first_sample_us = sample_us;
+    }
+    f.data[s.count][0] = mult*_sample.x;
+    f.data[s.count][1] = mult*_sample.y;
+    f.data[s.count][2] = mult*_sample.z;
+    f.last_sample_us = sample_us;
+    if (++s.count < STREAM_FRAME_SAMPLES) {
+        return;
+    }
+
+    s.count = 0;
+    f.seqnum = s.seqnum++;
+    f.crc = crc_xmodem((const uint8_t *)&f, sizeof(f)-sizeof(f.crc));
+    // if the port can't keep up the frame is lost, which the
+    // receiver sees as a gap in the sequence numbers
+    stream_queue->push(f);
+}
+
+void AP_InertialSensor::BatchSampler::stream_update()
+{
+    stream_frame f;
+    while (stream_uart->txspace() >= sizeof(f) && stream_queue->pop(f)) {
+        stream_uart->write((const uint8_t *)&f, sizeof(f));
+    }
+}
+#endif // AP_INERTIALSENSOR_BATCHSAMPLER_STREAM_ENABLED
+
 #endif //#if AP_INERTIALSENSOR_BATCHSAMPLER_ENABLED
@@ -107,17 +107,25 @@ bool FastRateBuffer::get_next_gyro_sample(Vector3f& gyro)
     }
 
     if (_rate_loop_gyro_window.available() == 0) {
-        _notifier.wait_blocking();
+        // ask for a signal, then check again in case a sample was
+        // pushed before the IMU thread could see the request
+        _waiting = true;
+        if (_rate_loop_gyro_window.available() == 0) {
+            _notifier.wait_blocking();
+        }
+        _waiting = false;
     }
 
-    WITH_SEMAPHORE(_mutex);
-
     return _rate_loop_gyro_window.pop(gyro);
 }
 
+/*
+  discard any queued samples. This moves the read pointer so must only
+  be called from the rate thread
+ */
 void FastRateBuffer::reset()
 {
-    _rate_loop_gyro_window.clear();
+    _rate_loop_gyro_window.advance(_rate_loop_gyro_window.available());
 }
 
 bool AP_InertialSensor::push_next_gyro_sample(const Vector3f& gyro)
@@ -129,16 +137,16 @@ bool AP_InertialSensor::push_next_gyro_sample(const Vector3f& gyro)
     if (++fast_rate_buffer->rate_decimation_count < fast_rate_buffer->rate_decimation) {
         return false;
     }
-    /*
-        tell the rate thread we have a new sample
-    */
-    WITH_SEMAPHORE(fast_rate_buffer->_mutex);
-
     if (!fast_rate_buffer->_rate_loop_gyro_window.push(gyro)) {
         debug("dropped rate loop sample");
     }
     fast_rate_buffer->rate_decimation_count = 0;
-    fast_rate_buffer->_notifier.signal();
+    /*
+        tell the rate thread we have a new sample if it is waiting for one
+    */
+    if (fast_rate_buffer->_waiting) {
+        fast_rate_buffer->_notifier.signal();
+    }
     return true;
 }
 
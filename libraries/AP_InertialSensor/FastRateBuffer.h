@@ -24,6 +24,7 @@
 #include <AP_HAL/utility/RingBuffer.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_HAL/Semaphores.h>
+#include <atomic>
 
 class FastRateBuffer
 {
@@ -39,13 +40,18 @@ public:
 
 private:
     /*
-      binary semaphore for rate loop to use to start a rate loop when
-      we hav finished filtering the primary IMU
+      the IMU backend thread is the only writer and the rate thread
+      the only reader, so the ring buffer needs no lock
      */
     ObjectBuffer<Vector3f> _rate_loop_gyro_window{AP_INERTIAL_SENSOR_RATE_LOOP_BUFFER_SIZE};
     uint8_t rate_decimation; // 0 means off
     uint8_t rate_decimation_count;
+    /*
+      binary semaphore for rate loop to use to start a rate loop when
+      we have finished filtering the primary IMU. It is only signalled
+      when the rate thread is waiting on it
+     */
     HAL_BinarySemaphore _notifier;
-    HAL_Semaphore _mutex;
+    std::atomic<bool> _waiting{false};
 };
 #endif
@@ -235,8 +235,23 @@ void AP_L1_Control::update_waypoint(const Location &prev_WP, const Location &nex
 
     Vector2f _groundspeed_vector = _ahrs.groundspeed_vector();
 
+    // Calculate the NE position of WP B relative to WP A, and of the aircraft relative to
+    // WP A and WP B, using the geometry shared by the vehicle when it is for this update
+    Vector2f AB;
+    Vector2f A_air;
+    Vector2f air_B;
+    if (_waypoint_geometry != nullptr && _waypoint_geometry->matches(prev_WP, next_WP, _current_loc)) {
+        AB = _waypoint_geometry->prev_to_next;
+        A_air = _waypoint_geometry->prev_to_current;
+        air_B = _waypoint_geometry->current_to_next;
+    } else {
+        AB = prev_WP.get_distance_NE(next_WP);
+        A_air = prev_WP.get_distance_NE(_current_loc);
+        air_B = _current_loc.get_distance_NE(next_WP);
+    }
+
     // update _target_bearing_cd
-    _target_bearing_cd = _current_loc.get_bearing_to(next_WP);
+    _target_bearing_cd = wrap_360_cd(int32_t(degrees(air_B.angle()) * 100));
 
     // Calculate groundspeed
     float groundSpeed = _groundspeed_vector.length();
@@ -256,23 +271,18 @@ void AP_L1_Control::update_waypoint(const Location &prev_WP, const Location &nex
     // 0.3183099 = 1/1/pipi
     _L1_dist = MAX(0.3183099f * _L1_damping * _L1_period * groundSpeed, dist_min);
 
-    // Calculate the NE position of WP B relative to WP A
-    Vector2f AB = prev_WP.get_distance_NE(next_WP);
     float AB_length = AB.length();
 
     // Check for AB zero length and track directly to the destination
     // if too small
     if (AB.length() < 1.0e-6f) {
-        AB = _current_loc.get_distance_NE(next_WP);
+        AB = air_B;
         if (AB.length() < 1.0e-6f) {
             AB = Vector2f(cosf(get_yaw()), sinf(get_yaw()));
         }
     }
     AB.normalize();
 
-    // Calculate the NE position of the aircraft relative to WP A
-    const Vector2f A_air = prev_WP.get_distance_NE(_current_loc);
-
     // calculate distance to target track, for reporting
     _crosstrack_error = A_air % AB;
 
@@ -292,7 +302,7 @@ void AP_L1_Control::update_waypoint(const Location &prev_WP, const Location &nex
     } else if (alongTrackDist > AB_length + groundSpeed*3) {
         // we have passed point B by 3 seconds. Head towards B
         // Calc Nu to fly To WP B
-        const Vector2f B_air = next_WP.get_distance_NE(_current_loc);
+        const Vector2f B_air = -air_B;
         Vector2f B_air_unit = (B_air).normalized(); // Unit vector from WP B to aircraft
         xtrackVel = _groundspeed_vector % (-B_air_unit); // Velocity across line
         ltrackVel = _groundspeed_vector * (-B_air_unit); // Velocity along line
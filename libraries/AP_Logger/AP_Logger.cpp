@@ -202,6 +202,37 @@ const AP_Param::GroupInfo AP_Logger::var_info[] = {
     // @RebootRequired: True
     AP_GROUPINFO("_MAX_FILES", 12, AP_Logger, _params.max_log_files, MAX_LOG_FILES),
 
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+    // @Param: _FILE_CMPRS
+    // @DisplayName: File log compression
+    // @Description: When enabled each message written to a file log is delta-encoded against the previous message of the same type. This reduces the amount of data written to the card for high rate messages. Compressed logs must be expanded with Tools/Replay/decompress_log.py before they can be read by tools which do not understand the compressed stream format.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("_FILE_CMPRS", 13, AP_Logger, _params.file_compress, 0),
+#endif
+
+#if AP_LOGGER_REPLAY_RING_ENABLED
+    // @Param: _REPLAY_RING
+    // @DisplayName: Replay history size
+    // @Description: When LOG_REPLAY is 0 and this is non-zero the EKF replay data is held in a ring of this size in memory instead of being logged. When an EKF3 lane switch or a vehicle EKF failsafe happens while logging, the contents of the ring are written to the log followed by full replay data for the rest of the log, so the lead-up to the event can be replayed without the logging load of LOG_REPLAY=1. Each 32kB holds roughly a quarter of a second of history at a 400Hz loop rate.
+    // @Units: kB
+    // @Range: 0 1024
+    // @Increment: 8
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("_REPLAY_RING", 14, AP_Logger, _params.replay_ring_kb, 0),
+#endif
+
+    // @Param: _RATE_TRIG
+    // @DisplayName: Full rate logging time after events
+    // @Description: When non-zero the LOG_FILE_RATEMAX, LOG_MAV_RATEMAX, LOG_BLK_RATEMAX and LOG_DARM_RATEMAX limits are lifted for this many seconds after an event such as an EKF3 lane switch, an EKF failsafe, high vibration or a crash, so the rest of the flight can be logged at a low rate while the events are captured at full rate.
+    // @Units: s
+    // @Range: 0 600
+    // @Increment: 1
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_TRIG", 15, AP_Logger, _params.rate_trigger_s, 0),
+
     AP_GROUPEND
 };
 
@@ -755,9 +786,9 @@ bool AP_Logger::WriteBlock_first_succeed(const void *pBuffer, uint16_t size)
 
 // write a replay block. This differs from other as it returns false if a backend doesn't
 // have space for the msg
-bool AP_Logger::WriteReplayBlock(uint8_t msg_id, const void *pBuffer, uint16_t size) {
+bool AP_Logger::WriteReplayBlock(uint8_t msg_id, const void *pBuffer, uint16_t size, bool force) {
     bool ret = true;
-    if (log_replay()) {
+    if (log_replay() || force) {
         uint8_t buf[3+size];
         buf[0] = HEAD_BYTE1;
         buf[1] = HEAD_BYTE2;
@@ -1043,7 +1074,7 @@ void AP_Logger::WriteV(const char *name, const char *labels, const char *units,
     for (uint8_t i=0; i<_next_backend; i++) {
         va_list arg_copy;
         va_copy(arg_copy, arg_list);
-        backends[i]->Write(f->msg_type, arg_copy, is_critical, is_streaming);
+        backends[i]->Write(f->msg_type, f->fmt, f->msg_len, arg_copy, is_critical, is_streaming);
         va_end(arg_copy);
     }
 }
@@ -1121,6 +1152,18 @@ AP_Logger::log_write_fmt *AP_Logger::msg_fmt_for_name(const char *name, const ch
 {
     WITH_SEMAPHORE(log_write_fmts_sem);
     struct log_write_fmt *f;
+    const uint8_t cache_idx = log_write_fmt_cache_index(name);
+    if (!direct_comp) {
+        f = log_write_fmt_cache[cache_idx];
+        if (f != nullptr && f->name == name) { // ptr comparison
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+            if (!assert_same_fmt_for_name(f, name, labels, units, mults, fmt)) {
+                return nullptr;
+            }
+#endif
+            return f;
+        }
+    }
     for (f = log_write_fmts; f; f=f->next) {
         if (!direct_comp) {
             if (f->name == name) { // ptr comparison
@@ -1130,6 +1173,7 @@ AP_Logger::log_write_fmt *AP_Logger::msg_fmt_for_name(const char *name, const ch
                     return nullptr;
                 }
 #endif
+                log_write_fmt_cache[cache_idx] = f;
                 return f;
             }
         } else {
@@ -1242,6 +1286,10 @@ AP_Logger::log_write_fmt *AP_Logger::msg_fmt_for_name(const char *name, const ch
     }
 #endif
 
+    if (!direct_comp) {
+        log_write_fmt_cache[cache_idx] = f;
+    }
+
     return f;
 }
 
@@ -1513,6 +1561,21 @@ void AP_Logger::Write_Error(LogErrorSubsystem sub_system,
   return true if we are in a logging persistance state, where we keep
   logging after a disarm or an arming failure
  */
+void AP_Logger::trigger_full_rate(void)
+{
+    if (_params.rate_trigger_s <= 0) {
+        return;
+    }
+    _full_rate_start_ms = AP_HAL::millis();
+    _full_rate_duration_ms = _params.rate_trigger_s * 1000U;
+}
+
+bool AP_Logger::full_rate_active(void) const
+{
+    return _full_rate_duration_ms != 0 &&
+        AP_HAL::millis() - _full_rate_start_ms < _full_rate_duration_ms;
+}
+
 bool AP_Logger::in_log_persistance(void) const
 {
     uint32_t now = AP_HAL::millis();
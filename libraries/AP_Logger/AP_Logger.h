@@ -216,6 +216,12 @@ public:
         _log_pause = value;
     }
 
+    // lift the streaming rate limits for LOG_RATE_TRIG seconds so
+    // the aftermath of an event is captured at full rate
+    void trigger_full_rate(void);
+    // true while a trigger_full_rate() window is active
+    bool full_rate_active(void) const;
+
     // erase handling
     void EraseAll();
 
@@ -228,8 +234,9 @@ public:
     /* Write an *important* block of data at current offset */
     void WriteCriticalBlock(const void *pBuffer, uint16_t size);
 
-    /* Write a block of replay data at current offset */
-    bool WriteReplayBlock(uint8_t msg_id, const void *pBuffer, uint16_t size);
+    /* Write a block of replay data at current offset. If force is
+       true the block is written even when LOG_REPLAY is off */
+    bool WriteReplayBlock(uint8_t msg_id, const void *pBuffer, uint16_t size, bool force=false);
 
     // high level interface
     uint16_t find_last_log() const;
@@ -323,6 +330,9 @@ public:
     bool log_while_disarmed(void) const;
     bool in_log_persistance(void) const;
     uint8_t log_replay(void) const { return _params.log_replay; }
+#if AP_LOGGER_REPLAY_RING_ENABLED
+    uint16_t replay_ring_kb(void) const { return uint16_t(MAX(_params.replay_ring_kb.get(), 0)); }
+#endif
 
     vehicle_startup_message_Writer _vehicle_messages;
 
@@ -349,6 +359,13 @@ public:
         AP_Float blk_ratemax;
         AP_Float disarm_ratemax;
         AP_Int16 max_log_files;
+        AP_Int16 rate_trigger_s; // in seconds
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+        AP_Int8 file_compress;
+#endif
+#if AP_LOGGER_REPLAY_RING_ENABLED
+        AP_Int16 replay_ring_kb; // in kilobytes
+#endif
     } _params;
 
     const struct LogStructure *structure(uint16_t num) const;
@@ -401,6 +418,14 @@ public:
         const char *mults;
     } *log_write_fmts;
 
+    // cache of log_write_fmts indexed by a hash of the name pointer,
+    // so repeated Write() calls avoid walking the list
+    #define LOGGER_WRITE_FMT_CACHE_SIZE 16
+    struct log_write_fmt *log_write_fmt_cache[LOGGER_WRITE_FMT_CACHE_SIZE];
+    static uint8_t log_write_fmt_cache_index(const char *name) {
+        return (uintptr_t(name) >> 2) % LOGGER_WRITE_FMT_CACHE_SIZE;
+    }
+
     // return (possibly allocating) a log_write_fmt for a name
     struct log_write_fmt *msg_fmt_for_name(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, const bool direct_comp = false, const bool copy_strings = false);
 
@@ -584,9 +609,28 @@ private:
     GCS_MAVLINK *_log_sending_link;
     HAL_Semaphore _log_send_sem;
 
+#if AP_LOGGER_DOWNLOAD_READ_AHEAD_ENABLED
+    // block of the log being downloaded, read in one go and sliced
+    // into LOG_DATA packets
+    struct {
+        uint8_t *buf;
+        uint32_t ofs;  // log offset of buf[0]
+        uint16_t len;  // number of valid bytes in buf
+    } _log_read_ahead;
+    int16_t get_log_data_read_ahead(uint32_t offset, uint16_t len, uint8_t *data);
+    void free_log_read_ahead();
+#endif
+
     // last time arming failed, for backends
     uint32_t _last_arming_failure_ms;
 
+    // last time RC latency statistics were logged
+    uint32_t _last_rc_latency_log_ms;
+
+    // start and length of the trigger_full_rate() window
+    uint32_t _full_rate_start_ms;
+    uint32_t _full_rate_duration_ms;
+
     // count of number of times we've started logging
     // can be used by other subsystems to detect if they should log data
     uint8_t _log_start_count;
@@ -194,21 +194,11 @@ bool AP_Logger_Backend::Write_Emit_FMT(uint8_t msg_type)
     return true;
 }
 
-bool AP_Logger_Backend::Write(const uint8_t msg_type, va_list arg_list, bool is_critical, bool is_streaming)
+bool AP_Logger_Backend::Write(const uint8_t msg_type, const char *fmt, const uint8_t msg_len, va_list arg_list, bool is_critical, bool is_streaming)
 {
     // stack-allocate a buffer so we can WriteBlock(); this could be
     // 255 bytes!  If we were willing to lose the WriteBlock
     // abstraction we could do WriteBytes() here instead?
-    const char *fmt  = nullptr;
-    uint8_t msg_len;
-    AP_Logger::log_write_fmt *f;
-    for (f = _front.log_write_fmts; f; f=f->next) {
-        if (f->msg_type == msg_type) {
-            fmt = f->fmt;
-            msg_len = f->msg_len;
-            break;
-        }
-    }
     if (fmt == nullptr) {
         INTERNAL_ERROR(AP_InternalError::error_t::logger_logwrite_missingfmt);
         return false;
@@ -222,7 +212,8 @@ bool AP_Logger_Backend::Write(const uint8_t msg_type, va_list arg_list, bool is_
     buffer[offset++] = HEAD_BYTE1;
     buffer[offset++] = HEAD_BYTE2;
     buffer[offset++] = msg_type;
-    for (uint8_t i=0; i<strlen(fmt); i++) {
+    const size_t fmt_len = strlen(fmt);
+    for (uint8_t i=0; i<fmt_len; i++) {
         uint8_t charlen = 0;
         switch(fmt[i]) {
         case 'b': {
@@ -766,6 +757,10 @@ bool AP_Logger_RateLimiter::should_log(uint8_t msgid, bool writev_streaming)
         // no rate limiting if not paused and rate is zero(user changed the parameter)
         return true;
     }
+    if (!front._log_pause && front.full_rate_active()) {
+        // capturing an event at full rate
+        return true;
+    }
     if (last_send_ms[msgid] == 0 && !writev_streaming) {
         // might be non streaming. check the not_streaming bitmask
         // cache
@@ -165,8 +165,9 @@ public:
     void Safe_Write_Emit_FMT(uint8_t msg_type);
 
     // write a log message out to the log of msg_type type, with
-    // values contained in arg_list:
-    bool Write(uint8_t msg_type, va_list arg_list, bool is_critical=false, bool is_streaming=false);
+    // values contained in arg_list. fmt and msg_len are those of the
+    // msg_type's log_write_fmt:
+    bool Write(uint8_t msg_type, const char *fmt, uint8_t msg_len, va_list arg_list, bool is_critical=false, bool is_streaming=false);
 
     // these methods are used when reporting system status over mavlink
     virtual bool logging_enabled() const;
@@ -84,6 +84,8 @@ uint32_t AP_Logger_Block::bufferspace_available()
 void AP_Logger_Block::StartWrite(uint32_t PageAdr)
 {
     df_PageAdr    = PageAdr;
+    // the block ahead may be written to before we get to it
+    df_PreErasedPage = 0;
 }
 
 void AP_Logger_Block::FinishWrite(void)
@@ -99,20 +101,54 @@ void AP_Logger_Block::FinishWrite(void)
 
     // when starting a new sector, erase it
     if ((df_PageAdr-1) % df_PagePerBlock == 0) {
-        // if we have wrapped over an existing log, force the oldest to be recalculated
-        if (_cached_oldest_log > 0) {
-            uint16_t log_num = StartRead(df_PageAdr);
-            if (log_num != 0xFFFF && log_num >= _cached_oldest_log) {
-                _cached_oldest_log = 0;
-            }
-        }
         // are we about to erase a sector with our own headers in it?
         if (df_Write_FilePage > df_NumPages - df_PagePerBlock) {
             chip_full = true;
             return;
         }
-        SectorErase(get_block(df_PageAdr));
+        if (df_PageAdr == df_PreErasedPage) {
+            // already erased while the IO thread was idle
+            df_PreErasedPage = 0;
+            return;
+        }
+        erase_block(df_PageAdr);
+    }
+}
+
+// erase the block starting at PageAdr
+void AP_Logger_Block::erase_block(uint32_t PageAdr)
+{
+    // if we have wrapped over an existing log, force the oldest to be recalculated
+    if (_cached_oldest_log > 0) {
+        uint16_t log_num = StartRead(PageAdr);
+        if (log_num != 0xFFFF && log_num >= _cached_oldest_log) {
+            _cached_oldest_log = 0;
+        }
+    }
+    SectorErase(get_block(PageAdr));
+}
+
+/*
+  erase the block after the one being written while there is not a
+  full page to write. The chip then erases while the write buffer
+  fills instead of straight after the page write that crosses into
+  the block, which could otherwise stall logging for the whole erase
+ */
+void AP_Logger_Block::pre_erase_next_block(void)
+{
+    if (!log_write_started || df_PreErasedPage != 0) {
+        return;
     }
+    // as for FinishWrite(), don't erase our own headers
+    if (df_Write_FilePage > df_NumPages - 2U * df_PagePerBlock) {
+        return;
+    }
+    uint32_t next_page = (get_block(df_PageAdr) + 1) * df_PagePerBlock + 1;
+    if (next_page > df_NumPages) {
+        next_page = 1;
+    }
+    erase_block(next_page);
+    df_PreErasedPage = next_page;
 }
 
 bool AP_Logger_Block::WritesOK() const
@@ -902,6 +938,10 @@ void AP_Logger_Block::io_timer(void)
         WITH_SEMAPHORE(sem);
 
         write_log_page();
+    } else {
+        WITH_SEMAPHORE(sem);
+
+        pre_erase_next_block();
     }
 }
 
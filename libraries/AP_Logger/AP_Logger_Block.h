@@ -107,6 +107,9 @@ private:
     uint32_t df_Write_FilePage;
     // page to wipe from in the case of corruption
     uint32_t df_EraseFrom;
+    // first page of the block ahead of the write pointer that has
+    // already been erased, or 0 if none
+    uint32_t df_PreErasedPage;
 
     // offset from adding FMT messages to log data
     bool adding_fmt_headers;
@@ -149,6 +152,8 @@ private:
     bool is_wrapped(void);
     void StartWrite(uint32_t PageAdr);
     void FinishWrite(void);
+    void erase_block(uint32_t PageAdr);
+    void pre_erase_next_block(void);
 
     // Read methods
     bool ReadBlock(void *pBuffer, uint16_t size);
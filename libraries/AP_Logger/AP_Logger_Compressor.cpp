@@ -0,0 +1,218 @@
+#include "AP_Logger_Compressor.h"
+
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+
+#include <string.h>
+#include <AP_Math/AP_Math.h>
+#include "LogStructure.h"
+
+// offsets of the type and length fields of a FMT message
+#define FMT_TYPE_OFS   LOG_PACKET_HEADER_LEN
+#define FMT_LENGTH_OFS (LOG_PACKET_HEADER_LEN+1)
+
+// header of a compressed message: HEAD_BYTE1, HEAD_BYTE2,
+// LOG_COMPRESSED_MSG and the type of the original message
+#define COMPRESSED_HEADER_LEN (LOG_PACKET_HEADER_LEN+1)
+
+bool AP_Logger_Compressor::init(void)
+{
+    slots = NEW_NOTHROW Slot[AP_LOGGER_COMPRESSOR_SLOTS];
+    if (slots == nullptr) {
+        return false;
+    }
+    reset();
+    return true;
+}
+
+void AP_Logger_Compressor::reset(void)
+{
+    memset(lengths, 0, sizeof(lengths));
+    lengths[LOG_FORMAT_MSG] = sizeof(log_Format);
+    for (uint8_t i=0; i<AP_LOGGER_COMPRESSOR_SLOTS; i++) {
+        slots[i].type = 0xFFFF;
+    }
+    header_sent = false;
+    _lost_sync = false;
+}
+
+/*
+  encode a single message, returning the number of bytes written to
+  out, which is at most len
+ */
+uint16_t AP_Logger_Compressor::encode_message(const uint8_t *msg, uint8_t len, uint8_t *out)
+{
+    const uint8_t type = msg[2];
+    Slot &s = slot_for(type);
+
+    if (type != LOG_FORMAT_MSG && s.type == type) {
+        const uint8_t *prev = s.msg;
+        uint16_t n = COMPRESSED_HEADER_LEN;
+        uint16_t i = LOG_PACKET_HEADER_LEN;
+        while (i < len) {
+            // run of bytes unchanged from the previous message
+            uint16_t z = 0;
+            while (i+z < len && z < 128 && msg[i+z] == prev[i+z]) {
+                z++;
+            }
+            if (z >= 2 || (z > 0 && i+z == len)) {
+                if (n + 1 >= len) {
+                    break;
+                }
+                out[n++] = 0x80 | (z-1);
+                i += z;
+                continue;
+            }
+            // literal run, ending at the next unchanged pair
+            const uint16_t start = i;
+            uint16_t count = 0;
+            while (i < len && count < 128) {
+                if (i+1 < len && msg[i] == prev[i] && msg[i+1] == prev[i+1]) {
+                    break;
+                }
+                i++;
+                count++;
+            }
+            if (n + 1 + count >= len) {
+                break;
+            }
+            out[n++] = count-1;
+            for (uint16_t j=0; j<count; j++) {
+                out[n++] = msg[start+j] ^ prev[start+j];
+            }
+        }
+        if (i == len && n < len) {
+            out[0] = HEAD_BYTE1;
+            out[1] = HEAD_BYTE2;
+            out[2] = LOG_COMPRESSED_MSG;
+            out[3] = type;
+            memcpy(s.msg, msg, len);
+            return n;
+        }
+    }
+
+    // send uncompressed
+    memcpy(out, msg, len);
+    if (type != LOG_FORMAT_MSG) {
+        s.type = type;
+        memcpy(s.msg, msg, len);
+    }
+    return len;
+}
+
+uint32_t AP_Logger_Compressor::encode(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_size, uint32_t &out_len)
+{
+    out_len = 0;
+    if (!header_sent) {
+        if (out_size < COMPRESSED_HEADER_LEN+1) {
+            return 0;
+        }
+        out[0] = HEAD_BYTE1;
+        out[1] = HEAD_BYTE2;
+        out[2] = LOG_COMPRESSED_MSG;
+        out[3] = STREAM_HEADER;
+        out[4] = STREAM_VERSION;
+        out_len = COMPRESSED_HEADER_LEN+1;
+        header_sent = true;
+    }
+
+    uint32_t ofs = 0;
+    while (ofs < in_len) {
+        if (_lost_sync) {
+            const uint32_t n = MIN(in_len - ofs, out_size - out_len);
+            memcpy(&out[out_len], &in[ofs], n);
+            out_len += n;
+            ofs += n;
+            break;
+        }
+        if (in_len - ofs < LOG_PACKET_HEADER_LEN) {
+            break;
+        }
+        const uint8_t *msg = &in[ofs];
+        if (msg[0] != HEAD_BYTE1 || msg[1] != HEAD_BYTE2 || lengths[msg[2]] == 0) {
+            _lost_sync = true;
+            continue;
+        }
+        const uint8_t len = lengths[msg[2]];
+        if (in_len - ofs < len || out_size - out_len < MAX_ENCODED_LENGTH) {
+            break;
+        }
+        if (msg[2] == LOG_FORMAT_MSG && msg[FMT_LENGTH_OFS] >= LOG_PACKET_HEADER_LEN) {
+            lengths[msg[FMT_TYPE_OFS]] = msg[FMT_LENGTH_OFS];
+        }
+        out_len += encode_message(msg, len, &out[out_len]);
+        ofs += len;
+    }
+    return ofs;
+}
+
+AP_Logger_Decompressor::~AP_Logger_Decompressor()
+{
+    delete[] last;
+}
+
+bool AP_Logger_Decompressor::start(uint8_t version)
+{
+    if (version != AP_Logger_Compressor::STREAM_VERSION) {
+        return false;
+    }
+    if (last == nullptr) {
+        last = NEW_NOTHROW uint8_t[256][256];
+        if (last == nullptr) {
+            return false;
+        }
+    }
+    memset(last_len, 0, sizeof(last_len));
+    return true;
+}
+
+void AP_Logger_Decompressor::store(const uint8_t *msg, uint8_t len)
+{
+    if (last == nullptr || msg[2] == LOG_FORMAT_MSG) {
+        return;
+    }
+    memcpy(last[msg[2]], msg, len);
+    last_len[msg[2]] = len;
+}
+
+bool AP_Logger_Decompressor::apply_delta(uint8_t *msg, uint8_t len)
+{
+    const uint8_t type = msg[2];
+    if (last == nullptr || last_len[type] != len) {
+        return false;
+    }
+    const uint8_t *prev = last[type];
+    for (uint16_t i=LOG_PACKET_HEADER_LEN; i<len; i++) {
+        msg[i] ^= prev[i];
+    }
+    memcpy(last[type], msg, len);
+    return true;
+}
+
+int32_t AP_Logger_Decompressor::expand(const uint8_t *in, uint32_t in_len, uint8_t *msg, uint8_t len)
+{
+    uint32_t ofs = 0;
+    uint16_t i = LOG_PACKET_HEADER_LEN;
+    while (i < len) {
+        if (ofs >= in_len) {
+            return -1;
+        }
+        const uint8_t token = in[ofs++];
+        const uint8_t count = AP_Logger_Compressor::token_count(token);
+        if (i + count > len) {
+            return -1;
+        }
+        if (AP_Logger_Compressor::token_is_zero_run(token)) {
+            memset(&msg[i], 0, count);
+        } else {
+            if (ofs + count > in_len) {
+                return -1;
+            }
+            memcpy(&msg[i], &in[ofs], count);
+            ofs += count;
+        }
+        i += count;
+    }
+    return ofs;
+}
+
+#endif // AP_LOGGER_FILE_COMPRESSION_ENABLED
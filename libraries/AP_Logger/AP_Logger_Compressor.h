@@ -0,0 +1,101 @@
+/*
+  delta compression of a stream of log messages
+
+  Each message is XORed with the previous message of the same type
+  and the result, which is mostly zeros for slowly changing data, is
+  run-length encoded. Messages are written uncompressed when there is
+  no previous message to delta against or when compressing would not
+  save space. The stream format is described in README.md.
+ */
+#pragma once
+
+#include "AP_Logger_config.h"
+
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+
+#include <stdint.h>
+
+#ifndef AP_LOGGER_COMPRESSOR_SLOTS
+#define AP_LOGGER_COMPRESSOR_SLOTS 32
+#endif
+
+class AP_Logger_Compressor
+{
+public:
+    // version byte written in the stream header
+    static const uint8_t STREAM_VERSION = 1;
+    // type byte of the stream header message
+    static const uint8_t STREAM_HEADER = 255;
+    // largest possible encoding of a single message
+    static const uint16_t MAX_ENCODED_LENGTH = 255;
+
+    // token helpers shared with the decoder
+    static bool token_is_zero_run(uint8_t token) { return (token & 0x80) != 0; }
+    static uint8_t token_count(uint8_t token) { return (token & 0x7F) + 1; }
+
+    bool init(void);
+    // start a new stream; the next encode() writes the stream header
+    void reset(void);
+
+    /*
+      encode whole messages from in, writing to out. Returns the
+      number of input bytes consumed, which is always a whole number of
+      messages. out_len is set to the number of bytes written.
+     */
+    uint32_t encode(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_size, uint32_t &out_len);
+
+    // true if the input did not look like a log stream; remaining
+    // input is passed through unmodified
+    bool lost_sync(void) const { return _lost_sync; }
+
+private:
+    // message lengths learnt from the FMT messages
+    uint8_t lengths[256];
+
+    struct Slot {
+        uint16_t type; // 0xFFFF if unused
+        uint8_t msg[255];
+    } *slots = nullptr;
+
+    bool header_sent;
+    bool _lost_sync;
+
+    Slot &slot_for(uint8_t type) { return slots[type % AP_LOGGER_COMPRESSOR_SLOTS]; }
+    uint16_t encode_message(const uint8_t *msg, uint8_t len, uint8_t *out);
+};
+
+/*
+  decoder, keeping the last message of every type
+ */
+class AP_Logger_Decompressor
+{
+public:
+    ~AP_Logger_Decompressor();
+
+    // true once the stream header has been seen
+    bool active(void) const { return last != nullptr; }
+    // handle the version byte of the stream header
+    bool start(uint8_t version);
+
+    // remember an uncompressed message as the base for later deltas
+    void store(const uint8_t *msg, uint8_t len);
+
+    /*
+      msg contains the header and the expanded XOR delta; replace the
+      delta with the original message contents. Returns false if
+      there is no previous message of this type.
+     */
+    bool apply_delta(uint8_t *msg, uint8_t len);
+
+    /*
+      expand the tokens for a delta message of length len from in,
+      returning the number of bytes of in used or -1 on error
+     */
+    static int32_t expand(const uint8_t *in, uint32_t in_len, uint8_t *msg, uint8_t len);
+
+private:
+    uint8_t (*last)[256] = nullptr;
+    uint8_t last_len[256];
+};
+
+#endif // AP_LOGGER_FILE_COMPRESSION_ENABLED
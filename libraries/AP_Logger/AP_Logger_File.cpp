@@ -44,6 +44,11 @@ extern const AP_HAL::HAL& hal;
 // time between tries to open log
 #define LOGGER_FILE_REOPEN_MS 5000
 
+// contiguous space to look for when a log is opened
+#ifndef HAL_LOGGER_FILE_PREALLOCATE_MB
+#define HAL_LOGGER_FILE_PREALLOCATE_MB 16
+#endif
+
 /*
   constructor
  */
@@ -94,6 +99,27 @@ void AP_Logger_File::Init()
 
     DEV_PRINTF("AP_Logger_File: buffer size=%u\n", (unsigned)bufsize);
 
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+    if (_front._params.file_compress) {
+        _compressor = NEW_NOTHROW AP_Logger_Compressor();
+        _cmp_buf = NEW_NOTHROW uint8_t[_writebuf_chunk];
+        if (_compressor == nullptr || _cmp_buf == nullptr || !_compressor->init()) {
+            DEV_PRINTF("AP_Logger_File: no memory for compression\n");
+            delete _compressor;
+            delete[] _cmp_buf;
+            _compressor = nullptr;
+            _cmp_buf = nullptr;
+        }
+    }
+#endif
+
+#if HAL_LOGGER_FILE_MAIN_RING_SIZE > 0
+    if (!_mainbuf.set_size(HAL_LOGGER_FILE_MAIN_RING_SIZE)) {
+        // not fatal, main thread writes will take the semaphore
+        DEV_PRINTF("AP_Logger_File: no main thread ring\n");
+    }
+#endif
+
     _initialised = true;
 
     const char* custom_dir = hal.util->get_custom_log_directory();
@@ -442,6 +468,15 @@ bool AP_Logger_File::StartNewLogOK() const
 /* Write a block of data at current offset */
 bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical)
 {
+#if HAL_LOGGER_FILE_MAIN_RING_SIZE > 0
+    if (!is_critical &&
+        !_writing_startup_messages &&
+        hal.scheduler->in_main_thread() &&
+        write_main_ring(pBuffer, size)) {
+        return true;
+    }
+#endif
+
     WITH_SEMAPHORE(semaphore);
 
 #if APM_BUILD_TYPE(APM_BUILD_Replay)
@@ -451,6 +486,15 @@ bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
     return true;
 #endif
 
+#if HAL_LOGGER_FILE_MAIN_RING_SIZE > 0
+    // anything the main thread has already written must go to the
+    // file before this message:
+    if (!drain_main_ring()) {
+        _dropped++;
+        return false;
+    }
+#endif
+
 
     uint32_t space = _writebuf.space();
 
@@ -487,6 +531,72 @@ bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
     return true;
 }
 
+#if HAL_LOGGER_FILE_MAIN_RING_SIZE > 0
+/*
+  write a message into the main thread ring without taking the
+  semaphore. Returns false if the caller should fall back to the
+  locked path, which applies the normal drop rules.
+ */
+bool AP_Logger_File::write_main_ring(const void *pBuffer, uint16_t size)
+{
+    if (_mainbuf.space() < size) {
+        return false;
+    }
+    // unlocked estimate that the message will fit outside the
+    // critical reserve once drained; drain_main_ring() does the
+    // exact check:
+    const uint32_t pending = _mainbuf.available() + size;
+    if (_writebuf.space() < pending + critical_message_reserved_space(_writebuf.get_size())) {
+        return false;
+    }
+    ByteBuffer::IoVec vec[2];
+    const uint8_t n = _mainbuf.reserve(vec, size);
+    const uint8_t *src = (const uint8_t *)pBuffer;
+    for (uint8_t i=0; i<n; i++) {
+        memcpy(vec[i].data, src, vec[i].len);
+        src += vec[i].len;
+    }
+    return _mainbuf.commit(size);
+}
+
+/*
+  move everything in the main thread ring into _writebuf. Must be
+  called with semaphore held. The ring is moved all-or-nothing so
+  that messages are never split.
+ */
+bool AP_Logger_File::drain_main_ring(void)
+{
+    uint32_t nbytes = _mainbuf.available();
+    if (nbytes == 0) {
+        return true;
+    }
+    if (_writebuf.space() < nbytes) {
+        return false;
+    }
+    const uint32_t total = nbytes;
+    while (nbytes > 0) {
+        uint32_t len;
+        const uint8_t *p = _mainbuf.readptr(len);
+        len = MIN(len, nbytes);
+        _writebuf.write(p, len);
+        _mainbuf.advance(len);
+        nbytes -= len;
+    }
+    df_stats_gather(total, _writebuf.space());
+    return true;
+}
+
+/*
+  drop any pending main thread messages. Must be called with semaphore
+  held; only the read side of the ring is touched so this is safe
+  against a concurrent main thread writer.
+ */
+void AP_Logger_File::discard_main_ring(void)
+{
+    _mainbuf.advance(_mainbuf.available());
+}
+#endif // HAL_LOGGER_FILE_MAIN_RING_SIZE > 0
+
 /*
   find the highest log number
  */
@@ -830,6 +940,13 @@ void AP_Logger_File::start_new_log(void)
     EXPECT_DELAY_MS(3000);
     _write_fd = AP::FS().open(_write_filename, O_WRONLY|O_CREAT|O_TRUNC);
     _cached_oldest_log = 0;
+    if (_write_fd != -1) {
+        // log writes get the storage ahead of terrain, FTP and scripting
+        AP::FS().set_high_priority(_write_fd);
+        // and a contiguous area to grow into, where the filesystem
+        // supports it. It doesn't matter if there isn't one
+        AP::FS().preallocate(_write_fd, HAL_LOGGER_FILE_PREALLOCATE_MB * MB_to_B);
+    }
 
     if (_write_fd == -1) {
         write_fd_semaphore.give();
@@ -846,6 +963,19 @@ void AP_Logger_File::start_new_log(void)
     _open_error_ms = 0;
     _write_offset = 0;
     _writebuf.clear();
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+    _compressing = _compressor != nullptr;
+    if (_compressing) {
+        _compressor->reset();
+    }
+    _cmp_len = _cmp_ofs = 0;
+#endif
+#if HAL_LOGGER_FILE_MAIN_RING_SIZE > 0
+    {
+        WITH_SEMAPHORE(semaphore);
+        discard_main_ring();
+    }
+#endif
     write_fd_semaphore.give();
 
     // now update lastlog.txt with the new log number
@@ -883,7 +1013,12 @@ void AP_Logger_File::flush(void)
 #if APM_BUILD_TYPE(APM_BUILD_Replay) || APM_BUILD_TYPE(APM_BUILD_UNKNOWN)
 {
     uint32_t tnow = AP_HAL::millis();
-    while (_write_fd != -1 && _initialised && !recent_open_error() && _writebuf.available()) {
+    while (_write_fd != -1 && _initialised && !recent_open_error() &&
+           (_writebuf.available()
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+            || pending_compressed()
+#endif
+               )) {
         // convince the IO timer that it really is OK to write out
         // less than _writebuf_chunk bytes:
         if (tnow > 2001) { // avoid resetting _last_write_time to 0
@@ -934,7 +1069,17 @@ void AP_Logger_File::io_timer(void)
         write_lastlog_file(log_num);
     }
 
+#if HAL_LOGGER_FILE_MAIN_RING_SIZE > 0
+    {
+        WITH_SEMAPHORE(semaphore);
+        drain_main_ring();
+    }
+#endif
+
     uint32_t nbytes = _writebuf.available();
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+    nbytes += pending_compressed();
+#endif
     if (nbytes == 0) {
         return;
     }
@@ -965,8 +1110,33 @@ void AP_Logger_File::io_timer(void)
         nbytes = _writebuf_chunk;
     }
 
+    last_io_operation = "write";
+    if (!write_fd_semaphore.take(1)) {
+        return;
+    }
+    if (_write_fd == -1) {
+        write_fd_semaphore.give();
+        return;
+    }
+
     uint32_t size;
-    const uint8_t *head = _writebuf.readptr(size);
+    const uint8_t *head;
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+    if (_compressing) {
+        if (pending_compressed() == 0) {
+            fill_compressed();
+        }
+        head = &_cmp_buf[_cmp_ofs];
+        size = pending_compressed();
+        if (size == 0) {
+            write_fd_semaphore.give();
+            return;
+        }
+    } else
+#endif
+    {
+        head = _writebuf.readptr(size);
+    }
     nbytes = MIN(nbytes, size);
 
 #if !AP_FILESYSTEM_LITTLEFS_ENABLED
@@ -978,15 +1148,6 @@ void AP_Logger_File::io_timer(void)
         }
     }
 #endif
-    last_io_operation = "write";
-    if (!write_fd_semaphore.take(1)) {
-        return;
-    }
-    if (_write_fd == -1) {
-        write_fd_semaphore.give();
-        return;
-    }
-
     uint32_t bytes_until_fsync = AP::FS().bytes_until_fsync(_write_fd);
     if (bytes_until_fsync > 0 && nbytes > bytes_until_fsync) {
         nbytes = bytes_until_fsync; // write exactly enough to sync
@@ -1015,7 +1176,14 @@ void AP_Logger_File::io_timer(void)
         _last_write_failed = false;
         _last_write_ms = tnow;
         _write_offset += nwritten;
-        _writebuf.advance(nwritten);
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+        if (_compressing) {
+            _cmp_ofs += nwritten;
+        } else
+#endif
+        {
+            _writebuf.advance(nwritten);
+        }
 
         // we know nwritten > 0 so we won't sync if bytes_until_fsync == 0
         if ((uint32_t)nwritten == bytes_until_fsync) {
@@ -1040,6 +1208,28 @@ void AP_Logger_File::io_timer(void)
     write_fd_semaphore.give();
 }
 
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+/*
+  compress the next block of _writebuf into _cmp_buf. Called from the
+  IO thread with write_fd_semaphore held when _cmp_buf is empty
+ */
+void AP_Logger_File::fill_compressed(void)
+{
+    _cmp_ofs = 0;
+    _cmp_len = 0;
+    uint32_t size;
+    const uint8_t *head = _writebuf.readptr(size);
+    uint32_t consumed = _compressor->encode(head, size, _cmp_buf, _writebuf_chunk, _cmp_len);
+    if (consumed == 0 && _cmp_len == 0 && _writebuf.available() > size) {
+        // the next message wraps around the end of the ring buffer
+        uint8_t msg[AP_Logger_Compressor::MAX_ENCODED_LENGTH];
+        const uint32_t n = _writebuf.peekbytes(msg, sizeof(msg));
+        consumed = _compressor->encode(msg, n, _cmp_buf, _writebuf_chunk, _cmp_len);
+    }
+    _writebuf.advance(consumed);
+}
+#endif // AP_LOGGER_FILE_COMPRESSION_ENABLED
+
 bool AP_Logger_File::io_thread_alive() const
 {
     if (!hal.scheduler->is_system_initialized()) {
@@ -9,7 +9,9 @@
 #include <AP_Filesystem/AP_Filesystem.h>
 
 #include <AP_HAL/utility/RingBuffer.h>
+#include <AP_Vehicle/AP_Vehicle_Type.h>
 #include "AP_Logger_Backend.h"
+#include "AP_Logger_Compressor.h"
 
 #if HAL_LOGGING_FILESYSTEM_ENABLED
 
@@ -21,6 +23,19 @@
 #endif
 #endif
 
+/*
+  size of the lock-free ring used for non-critical messages written
+  from the main thread. Zero disables the ring and all writes go
+  through the semaphore-protected _writebuf.
+ */
+#ifndef HAL_LOGGER_FILE_MAIN_RING_SIZE
+#if APM_BUILD_TYPE(APM_BUILD_Replay) || HAL_MEM_CLASS < HAL_MEM_CLASS_500
+#define HAL_LOGGER_FILE_MAIN_RING_SIZE 0
+#else
+#define HAL_LOGGER_FILE_MAIN_RING_SIZE 8192
+#endif
+#endif
+
 class AP_Logger_File : public AP_Logger_Backend
 {
 public:
@@ -112,6 +127,30 @@ private:
     // write buffer
     ByteBuffer _writebuf{0};
     const uint16_t _writebuf_chunk = HAL_LOGGER_WRITE_CHUNK_SIZE;
+
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+    // compressed data waiting to be written to the file. Only used
+    // when _compressing is set for the current log
+    AP_Logger_Compressor *_compressor;
+    uint8_t *_cmp_buf;
+    uint32_t _cmp_len;
+    uint32_t _cmp_ofs;
+    bool _compressing;
+    uint32_t pending_compressed(void) const { return _cmp_len - _cmp_ofs; }
+    void fill_compressed(void);
+#endif
+
+#if HAL_LOGGER_FILE_MAIN_RING_SIZE > 0
+    // single-producer ring for the main thread. The main thread is
+    // the only writer; it is drained into _writebuf with semaphore
+    // held, so every message written to _writebuf by any thread is
+    // ordered after the main-thread messages which preceded it. That
+    // keeps FMT messages ahead of the data which uses them.
+    ByteBuffer _mainbuf{0};
+    bool write_main_ring(const void *pBuffer, uint16_t size);
+    bool drain_main_ring(void);
+    void discard_main_ring(void);
+#endif
     uint32_t _last_write_time;
 
     /* construct a file name given a log number. Caller must free. */
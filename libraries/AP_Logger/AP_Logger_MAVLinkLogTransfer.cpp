@@ -77,6 +77,12 @@ void AP_Logger::handle_log_request_list(GCS_MAVLINK &link, const mavlink_message
     mavlink_log_request_list_t packet;
     mavlink_msg_log_request_list_decode(&msg, &packet);
 
+#if AP_LOGGER_DOWNLOAD_READ_AHEAD_ENABLED
+    // a new listing means any previous download is finished, even if
+    // the GCS never sent LOG_REQUEST_END
+    free_log_read_ahead();
+#endif
+
     _log_num_logs = get_num_logs();
 
     if (_log_num_logs == 0) {
@@ -134,6 +140,12 @@ void AP_Logger::handle_log_request_data(GCS_MAVLINK &link, const mavlink_message
 
         uint32_t time_utc, size;
         get_log_info(packet.id, size, time_utc);
+#if AP_LOGGER_DOWNLOAD_READ_AHEAD_ENABLED
+        if (packet.id != _log_num_data || size != _log_data_size) {
+            // buffered data is for a different log
+            _log_read_ahead.len = 0;
+        }
+#endif
         _log_num_data = packet.id;
         _log_data_size = size;
 
@@ -177,6 +189,9 @@ void AP_Logger::handle_log_request_end(GCS_MAVLINK &link, const mavlink_message_
     // mavlink_log_request_end_t packet;
     // mavlink_msg_log_request_end_decode(&msg, &packet);
     end_log_transfer();
+#if AP_LOGGER_DOWNLOAD_READ_AHEAD_ENABLED
+    free_log_read_ahead();
+#endif
 }
 
 void AP_Logger::end_log_transfer()
@@ -193,6 +208,15 @@ void AP_Logger::handle_log_send()
 {
     WITH_SEMAPHORE(_log_send_sem);
 
+#if AP_LOGGER_DOWNLOAD_READ_AHEAD_ENABLED
+    if (_log_read_ahead.buf != nullptr &&
+        AP_HAL::millis() - _last_mavlink_log_transfer_message_handled_ms > 10000) {
+        // the GCS has stopped downloading or lost the link without
+        // sending LOG_REQUEST_END
+        free_log_read_ahead();
+    }
+#endif
+
     if (_log_sending_link == nullptr) {
         return;
     }
@@ -281,6 +305,61 @@ void AP_Logger::handle_log_send_listing()
     }
 }
 
+#if AP_LOGGER_DOWNLOAD_READ_AHEAD_ENABLED
+/**
+   release the read-ahead buffer once a download is over
+ */
+void AP_Logger::free_log_read_ahead()
+{
+    delete[] _log_read_ahead.buf;
+    _log_read_ahead.buf = nullptr;
+    _log_read_ahead.len = 0;
+}
+
+/**
+   copy data of the log being downloaded from the read-ahead buffer,
+   refilling it with a single block-aligned backend read whenever
+   offset is outside the buffer. Falls back to a direct read if the
+   buffer can't be allocated.
+ */
+int16_t AP_Logger::get_log_data_read_ahead(uint32_t offset, uint16_t len, uint8_t *data)
+{
+    if (_log_read_ahead.buf == nullptr) {
+        _log_read_ahead.buf = NEW_NOTHROW uint8_t[AP_LOGGER_DOWNLOAD_READ_AHEAD_SIZE];
+        _log_read_ahead.len = 0;
+        if (_log_read_ahead.buf == nullptr) {
+            return get_log_data(_log_num_data, _log_data_page, offset, len, data);
+        }
+    }
+    uint16_t copied = 0;
+    while (copied < len) {
+        const uint32_t ofs = offset + copied;
+        if (ofs < _log_read_ahead.ofs || ofs >= _log_read_ahead.ofs + _log_read_ahead.len) {
+            const uint32_t block_ofs = ofs - (ofs % AP_LOGGER_DOWNLOAD_READ_AHEAD_SIZE);
+            if (block_ofs >= _log_data_size) {
+                break;
+            }
+            const uint16_t block_len = MIN(_log_data_size - block_ofs, uint32_t(AP_LOGGER_DOWNLOAD_READ_AHEAD_SIZE));
+            const int16_t ret = get_log_data(_log_num_data, _log_data_page, block_ofs, block_len, _log_read_ahead.buf);
+            if (ret < 0) {
+                _log_read_ahead.len = 0;
+                return copied > 0 ? copied : ret;
+            }
+            _log_read_ahead.ofs = block_ofs;
+            _log_read_ahead.len = ret;
+            if (ofs >= block_ofs + ret) {
+                // short read, end of log
+                break;
+            }
+        }
+        const uint16_t n = MIN(uint32_t(len - copied), _log_read_ahead.ofs + _log_read_ahead.len - ofs);
+        memcpy(&data[copied], &_log_read_ahead.buf[ofs - _log_read_ahead.ofs], n);
+        copied += n;
+    }
+    return copied;
+}
+#endif
+
 /**
    trigger sending of log data if there are some pending
  */
@@ -305,7 +384,11 @@ bool AP_Logger::handle_log_send_data()
         len = MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
     }
 
+#if AP_LOGGER_DOWNLOAD_READ_AHEAD_ENABLED
+    nbytes = get_log_data_read_ahead(_log_data_offset, len, packet.data);
+#else
     nbytes = get_log_data(_log_num_data, _log_data_page, _log_data_offset, len, packet.data);
+#endif
 
     if (nbytes < 0) {
         // report as EOF on error
@@ -47,6 +47,26 @@
 
 #endif
 
+#ifndef AP_LOGGER_FILE_COMPRESSION_ENABLED
+#define AP_LOGGER_FILE_COMPRESSION_ENABLED HAL_LOGGING_FILESYSTEM_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#endif
+
+// hold recent replay frames in memory when LOG_REPLAY is off and
+// write them out when the EKF has a problem
+#ifndef AP_LOGGER_REPLAY_RING_ENABLED
+#define AP_LOGGER_REPLAY_RING_ENABLED HAL_LOGGING_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#endif
+
+// buffer log download reads so each LOG_DATA packet does not need
+// its own backend read
+#ifndef AP_LOGGER_DOWNLOAD_READ_AHEAD_ENABLED
+#define AP_LOGGER_DOWNLOAD_READ_AHEAD_ENABLED HAL_MEM_CLASS >= HAL_MEM_CLASS_300
+#endif
+
+#ifndef AP_LOGGER_DOWNLOAD_READ_AHEAD_SIZE
+#define AP_LOGGER_DOWNLOAD_READ_AHEAD_SIZE 4096
+#endif
+
 #ifndef HAL_LOGGER_FILE_CONTENTS_ENABLED
 #define HAL_LOGGER_FILE_CONTENTS_ENABLED HAL_LOGGING_FILESYSTEM_ENABLED && !AP_FILESYSTEM_LITTLEFS_ENABLED
 #endif
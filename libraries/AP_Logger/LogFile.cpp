@@ -250,6 +250,21 @@ void AP_Logger::Write_RCOUT(void)
     }
 #endif
 
+    // RC to output latency statistics, once a second
+    const uint32_t now_ms = AP_HAL::millis();
+    SRV_Channels::RCLatency latency;
+    if (now_ms - _last_rc_latency_log_ms >= 1000 && AP::srv().get_rc_latency(latency)) {
+        _last_rc_latency_log_ms = now_ms;
+        const struct log_RCLT pkt_lt{
+            LOG_PACKET_HEADER_INIT(LOG_RCLT_MSG),
+            time_us       : AP_HAL::micros64(),
+            min_us        : latency.min_us,
+            mean_us       : latency.sum_us / latency.count,
+            max_us        : latency.max_us,
+            count         : latency.count,
+        };
+        WriteBlock(&pkt_lt, sizeof(pkt_lt));
+    }
 }
 
 #if AP_RSSI_ENABLED
@@ -306,6 +306,15 @@ struct PACKED log_RCOUT2 {
     uint16_t chan18;
 };
 
+struct PACKED log_RCLT {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t min_us;
+    uint32_t mean_us;
+    uint32_t max_us;
+    uint16_t count;
+};
+
 struct PACKED log_MAV {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -318,6 +327,17 @@ struct PACKED log_MAV {
     uint16_t times_full;
 };
 
+struct PACKED log_MAV_Perf {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t chan;
+    uint32_t rx_count;
+    uint32_t parse_us;
+    uint32_t handle_us;
+    uint32_t send_count;
+    uint32_t send_us;
+};
+
 struct PACKED log_RSSI {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -546,6 +566,15 @@ struct PACKED log_Performance {
     uint64_t rtc;
 };
 
+struct PACKED log_PerformanceHistogram {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t p999;
+    uint32_t max_time;
+};
+
 struct PACKED log_SRTL {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -592,6 +621,16 @@ struct PACKED log_STAK {
     uint16_t stack_total;
     uint16_t stack_free;
     char name[16];
+    uint16_t load;
+};
+
+// shared DMA contention
+struct PACKED log_DMA {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t transactions;
+    uint32_t uncontended_locks;
+    uint32_t contended_locks;
 };
 
 struct PACKED log_File {
@@ -609,6 +648,7 @@ struct PACKED log_Scripting {
     uint32_t run_time;
     int32_t total_mem;
     int32_t run_mem;
+    uint32_t gc_time;
 };
 
 struct PACKED log_MotBatt {
@@ -779,6 +819,16 @@ struct PACKED log_VER {
 // @Field: ss: stream slowdown is the number of ms being added to each message to fit within bandwidth
 // @Field: tf: times buffer was full when a message was going to be sent
 
+// @LoggerMessage: MAVP
+// @Description: GCS MAVLink link processing time since the previous MAVP message
+// @Field: TimeUS: Time since system startup
+// @Field: chan: mavlink channel number
+// @Field: rxc: number of received messages handled
+// @Field: prs: time spent parsing received bytes
+// @Field: hdl: time spent handling received messages
+// @Field: txc: number of messages sent
+// @Field: snd: time spent packing and sending messages
+
 // @LoggerMessage: MAVC
 // @Description: MAVLink command we have just executed
 // @Field: TimeUS: Time since system startup
@@ -880,6 +930,14 @@ struct PACKED log_VER {
 // @Field: Ex: number of microseconds being added to each loop to address scheduler overruns
 // @Field: R: RTC time, time since Unix epoch
 
+// @LoggerMessage: PMH
+// @Description: main loop time percentiles over the same period as PM
+// @Field: TimeUS: Time since system startup
+// @Field: P50: Median loop time
+// @Field: P99: 99th percentile loop time
+// @Field: P999: 99.9th percentile loop time
+// @Field: Max: Maximum loop time
+
 // @LoggerMessage: POWR
 // @Description: System power information
 // @Field: TimeUS: Time since system startup
@@ -965,6 +1023,14 @@ struct PACKED log_VER {
 // @Field: C13: channel 13 output
 // @Field: C14: channel 14 output
 
+// @LoggerMessage: RCLT
+// @Description: RC input to servo output latency, from an RC frame being decoded to the first output push after it
+// @Field: TimeUS: Time since system startup
+// @Field: Min: minimum latency since the last message
+// @Field: Mean: mean latency since the last message
+// @Field: Max: maximum latency since the last message
+// @Field: N: number of RC frames output since the last message
+
 // @LoggerMessage: RCO2
 // @Description: Servo channel output values 15 to 18
 // @Field: TimeUS: Time since system startup
@@ -1091,6 +1157,14 @@ struct PACKED log_VER {
 // @Field: Total: total stack
 // @Field: Free: free stack
 // @Field: Name: thread name
+// @Field: Load: thread CPU load since the ISR entry of the previous round, zero if thread statistics are not enabled
+
+// @LoggerMessage: DMA
+// @Description: Shared DMA contention, logged after each round of STAK messages
+// @Field: TimeUS: Time since system startup
+// @Field: Tx: total DMA transactions since boot
+// @Field: ULck: uncontended locks since the previous DMA message
+// @Field: CLck: contended locks since the previous DMA message
 
 // @LoggerMessage: FILE
 // @Description: File data
@@ -1106,6 +1180,7 @@ struct PACKED log_VER {
 // @Field: Runtime: run time
 // @Field: Total_mem: total memory usage of all scripts
 // @Field: Run_mem: run memory usage
+// @Field: GC: garbage collection time after the run
 
 // @LoggerMessage: VER
 // @Description: Ardupilot version
@@ -1162,6 +1237,8 @@ LOG_STRUCTURE_FROM_GPS \
       "RCO2",  "QHHHH",     "TimeUS,C15,C16,C17,C18", "sYYYY", "F----", true  }, \
     { LOG_RCOUT3_MSG, sizeof(log_RCOUT), \
       "RCO3",  "QHHHHHHHHHHHHHH",     "TimeUS,C19,C20,C21,C22,C23,C24,C25,C26,C27,C28,C29,C30,C31,C32", "sYYYYYYYYYYYYYY", "F--------------", true  }, \
+    { LOG_RCLT_MSG, sizeof(log_RCLT), \
+      "RCLT",  "QIIIH",     "TimeUS,Min,Mean,Max,N", "ssss-", "FFFF-", true  }, \
     { LOG_RSSI_MSG, sizeof(log_RSSI), \
       "RSSI",  "Qff",     "TimeUS,RXRSSI,RXLQ", "s-%", "F--", true  }, \
 LOG_STRUCTURE_FROM_BARO \
@@ -1192,6 +1269,8 @@ LOG_STRUCTURE_FROM_MOUNT \
     LOG_STRUCTURE_FROM_PROXIMITY                                    \
     { LOG_PERFORMANCE_MSG, sizeof(log_Performance),                     \
       "PM",  "QHHHIIHHIIIIIIQ", "TimeUS,LR,NLon,NL,MaxT,Mem,Load,ErrL,InE,ErC,SPIC,I2CC,I2CI,Ex,R", "sz---b%------ss", "F----0A------FF" }, \
+    { LOG_PERF_HISTOGRAM_MSG, sizeof(log_PerformanceHistogram),         \
+      "PMH", "QIIII", "TimeUS,P50,P99,P999,Max", "sssss", "FFFFF" }, \
     { LOG_SRTL_MSG, sizeof(log_SRTL), \
       "SRTL", "QBHHBfff", "TimeUS,Active,NumPts,MaxPts,Action,N,E,D", "s----mmm", "F----000" }, \
 LOG_STRUCTURE_FROM_AVOIDANCE \
@@ -1232,6 +1311,8 @@ LOG_STRUCTURE_FROM_FENCE \
       "RALY", "QBBLLhB", "TimeUS,Tot,Seq,Lat,Lng,Alt,Flags", "s--DUm-", "F--GGB-" },  \
     { LOG_MAV_MSG, sizeof(log_MAV),   \
       "MAV", "QBHHHBHH",   "TimeUS,chan,txp,rxp,rxdp,flags,ss,tf", "s#----s-", "F-000-C-" },   \
+    { LOG_MAV_PERF_MSG, sizeof(log_MAV_Perf),   \
+      "MAVP", "QBIIIII",   "TimeUS,chan,rxc,prs,hdl,txc,snd", "s#-ss-s", "F--FF-F" },   \
 LOG_STRUCTURE_FROM_VISUALODOM \
     { LOG_OPTFLOW_MSG, sizeof(log_Optflow), \
       "OF",   "QBffff",   "TimeUS,Qual,flowX,flowY,bodyX,bodyY", "s-EEEE", "F-0000" , true }, \
@@ -1249,12 +1330,14 @@ LOG_STRUCTURE_FROM_VISUALODOM \
       "WINC", "QBBBBBfffHfb", "TimeUS,Heal,ThEnd,Mov,Clut,Mode,DLen,Len,DRate,Tens,Vcc,Temp", "s-----mmn?vO", "F-----000000" }, \
     LOG_STRUCTURE_FROM_AC_ATTITUDECONTROL,                              \
     { LOG_STAK_MSG, sizeof(log_STAK), \
-      "STAK", "QBBHHN", "TimeUS,Id,Pri,Total,Free,Name", "s#----", "F-----", true }, \
+      "STAK", "QBBHHNH", "TimeUS,Id,Pri,Total,Free,Name,Load", "s#----%", "F-----A", true }, \
+    { LOG_DMA_MSG, sizeof(log_DMA), \
+      "DMA", "QIII", "TimeUS,Tx,ULck,CLck", "s---", "F---", true }, \
     { LOG_FILE_MSG, sizeof(log_File), \
       "FILE",   "NIBZ",       "FileName,Offset,Length,Data", "----", "----" }, \
 LOG_STRUCTURE_FROM_AIS \
     { LOG_SCRIPTING_MSG, sizeof(log_Scripting), \
-      "SCR",   "QNIii", "TimeUS,Name,Runtime,Total_mem,Run_mem", "s#sbb", "F-F--", true }, \
+      "SCR",   "QNIiiI", "TimeUS,Name,Runtime,Total_mem,Run_mem,GC", "s#sbbs", "F-F--F", true }, \
     { LOG_VER_MSG, sizeof(log_VER), \
       "VER",   "QBHBBBBIZHBBII", "TimeUS,BT,BST,Maj,Min,Pat,FWT,GH,FWS,APJ,BU,FV,IMI,ICI", "s-------------", "F-------------", false }, \
     { LOG_MOTBATT_MSG, sizeof(log_MotBatt), \
@@ -1329,6 +1412,7 @@ enum LogMessages : uint8_t {
     LOG_EVENT_MSG,
     LOG_WHEELENCODER_MSG,
     LOG_MAV_MSG,
+    LOG_MAV_PERF_MSG,
     LOG_ERROR_MSG,
     LOG_ADSB_MSG,
     LOG_ARM_DISARM_MSG,
@@ -1337,6 +1421,7 @@ enum LogMessages : uint8_t {
     LOG_IDS_FROM_PRECLAND,
     LOG_IDS_FROM_AIS,
     LOG_STAK_MSG,
+    LOG_DMA_MSG,
     LOG_FILE_MSG,
     LOG_SCRIPTING_MSG,
     LOG_VIDEO_STABILISATION_MSG,
@@ -1344,12 +1429,16 @@ enum LogMessages : uint8_t {
     LOG_VER_MSG,
     LOG_RCOUT2_MSG,
     LOG_RCOUT3_MSG,
+    LOG_RCLT_MSG,
+    LOG_PERF_HISTOGRAM_MSG,
     LOG_IDS_FROM_FENCE,
     LOG_IDS_FROM_HAL,
 
     _LOG_LAST_MSG_
 };
 
-// we reserve ID #255 for future expansion
+// ID #255 is reserved for delta-compressed messages, see
+// AP_Logger_Compressor.h
 static_assert(_LOG_LAST_MSG_ < 255, "Too many message formats");
+#define LOG_COMPRESSED_MSG 255
 static_assert(LOG_MODE_MSG < 128, "Duplicate message format IDs");
@@ -0,0 +1,141 @@
+#include <AP_gtest.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Logger/AP_Logger_Compressor.h>
+#include <AP_Logger/LogStructure.h>
+
+#if AP_LOGGER_FILE_COMPRESSION_ENABLED
+
+#include <string.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#define TEST_MSG_TYPE 200
+
+struct PACKED log_Test {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    float value;
+    uint16_t count;
+};
+
+// append a FMT message for log_Test followed by num log_Test messages
+static uint32_t make_stream(uint8_t *buf, uint16_t num)
+{
+    struct log_Format fmt {};
+    fmt.head1 = HEAD_BYTE1;
+    fmt.head2 = HEAD_BYTE2;
+    fmt.msgid = LOG_FORMAT_MSG;
+    fmt.type = TEST_MSG_TYPE;
+    fmt.length = sizeof(log_Test);
+    memcpy(fmt.name, "TEST", 4);
+    strncpy(fmt.format, "QfH", sizeof(fmt.format));
+    strncpy(fmt.labels, "TimeUS,Value,Count", sizeof(fmt.labels));
+    memcpy(buf, &fmt, sizeof(fmt));
+    uint32_t ofs = sizeof(fmt);
+
+    for (uint16_t i=0; i<num; i++) {
+        struct log_Test pkt {
+            LOG_PACKET_HEADER_INIT(TEST_MSG_TYPE),
+            time_us : 1000000U + i*2500U,
+            value   : 1.5f + (i/10)*0.01f,
+            count   : uint16_t(i/50),
+        };
+        memcpy(&buf[ofs], &pkt, sizeof(pkt));
+        ofs += sizeof(pkt);
+    }
+    return ofs;
+}
+
+// expand a compressed stream back into a plain log stream
+static uint32_t decode_stream(const uint8_t *in, uint32_t in_len, uint8_t *out)
+{
+    AP_Logger_Decompressor decompressor;
+    uint8_t lengths[256] {};
+    lengths[LOG_FORMAT_MSG] = sizeof(log_Format);
+    uint32_t ofs = 0;
+    uint32_t out_len = 0;
+    while (ofs < in_len) {
+        EXPECT_EQ(in[ofs], HEAD_BYTE1);
+        EXPECT_EQ(in[ofs+1], HEAD_BYTE2);
+        const uint8_t type = in[ofs+2];
+        if (type != LOG_COMPRESSED_MSG) {
+            const uint8_t len = lengths[type];
+            EXPECT_NE(len, 0);
+            if (type == LOG_FORMAT_MSG) {
+                lengths[in[ofs+3]] = in[ofs+4];
+            }
+            decompressor.store(&in[ofs], len);
+            memcpy(&out[out_len], &in[ofs], len);
+            out_len += len;
+            ofs += len;
+            continue;
+        }
+        if (in[ofs+3] == AP_Logger_Compressor::STREAM_HEADER) {
+            EXPECT_TRUE(decompressor.start(in[ofs+4]));
+            ofs += 5;
+            continue;
+        }
+        const uint8_t msg_type = in[ofs+3];
+        const uint8_t len = lengths[msg_type];
+        uint8_t *msg = &out[out_len];
+        msg[0] = HEAD_BYTE1;
+        msg[1] = HEAD_BYTE2;
+        msg[2] = msg_type;
+        const int32_t used = AP_Logger_Decompressor::expand(&in[ofs+4], in_len-(ofs+4), msg, len);
+        EXPECT_GT(used, 0);
+        EXPECT_TRUE(decompressor.apply_delta(msg, len));
+        out_len += len;
+        ofs += 4 + used;
+    }
+    return out_len;
+}
+
+TEST(AP_Logger_Compressor, round_trip)
+{
+    static uint8_t raw[sizeof(log_Format) + 1000*sizeof(log_Test)];
+    static uint8_t encoded[sizeof(raw) + 16];
+    static uint8_t decoded[sizeof(raw)];
+
+    const uint32_t raw_len = make_stream(raw, 1000);
+
+    AP_Logger_Compressor compressor;
+    ASSERT_TRUE(compressor.init());
+
+    // feed the stream in uneven pieces as the IO thread would
+    uint32_t in_ofs = 0;
+    uint32_t enc_len = 0;
+    while (in_ofs < raw_len) {
+        const uint32_t piece = MIN(raw_len - in_ofs, 777U);
+        uint32_t out_len;
+        const uint32_t consumed = compressor.encode(&raw[in_ofs], piece, &encoded[enc_len], MIN(uint32_t(sizeof(encoded))-enc_len, 1024U), out_len);
+        ASSERT_TRUE(consumed > 0 || out_len > 0);
+        in_ofs += consumed;
+        enc_len += out_len;
+    }
+    EXPECT_FALSE(compressor.lost_sync());
+    EXPECT_LT(enc_len, raw_len*2/3);
+
+    EXPECT_EQ(decode_stream(encoded, enc_len, decoded), raw_len);
+    EXPECT_EQ(memcmp(raw, decoded, raw_len), 0);
+}
+
+TEST(AP_Logger_Compressor, unknown_type_passes_through)
+{
+    uint8_t raw[] { HEAD_BYTE1, HEAD_BYTE2, 77, 1, 2, 3 };
+    uint8_t out[300];
+
+    AP_Logger_Compressor compressor;
+    ASSERT_TRUE(compressor.init());
+    uint32_t out_len;
+    EXPECT_EQ(compressor.encode(raw, sizeof(raw), out, sizeof(out), out_len), sizeof(raw));
+    EXPECT_TRUE(compressor.lost_sync());
+    // stream header followed by the raw bytes
+    EXPECT_EQ(out_len, 5 + sizeof(raw));
+    EXPECT_EQ(memcmp(&out[5], raw, sizeof(raw)), 0);
+}
+
+#endif // AP_LOGGER_FILE_COMPRESSION_ENABLED
+
+AP_GTEST_MAIN()
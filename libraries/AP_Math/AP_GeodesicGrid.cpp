@@ -183,6 +183,91 @@ const Matrix3f AP_GeodesicGrid::_mid_inverses[10]{
      { 0.618034f,  0.000000f, -1.000000f}},
 };
 
+/* This was generated with
+ * libraries/AP_Math/tools/geodesic_grid/geodesic_grid.py */
+const Vector3f AP_GeodesicGrid::_section_centers[80]{
+    {-0.934172f,  0.000000f, -0.356822f},
+    {-0.939124f,  0.294748f, -0.176549f},
+    {-0.756960f,  0.000000f, -0.653462f},
+    {-0.939124f, -0.294748f, -0.176549f},
+    {-0.577350f, -0.577350f, -0.577350f},
+    {-0.580411f, -0.285662f, -0.762575f},
+    {-0.762575f, -0.580411f, -0.285662f},
+    {-0.285662f, -0.762575f, -0.580411f},
+    {-0.356822f, -0.934172f,  0.000000f},
+    {-0.653462f, -0.756960f,  0.000000f},
+    {-0.176549f, -0.939124f, -0.294748f},
+    {-0.176549f, -0.939124f,  0.294748f},
+    { 0.000000f, -0.356822f, -0.934172f},
+    {-0.294748f, -0.176549f, -0.939124f},
+    { 0.000000f, -0.653462f, -0.756960f},
+    { 0.294748f, -0.176549f, -0.939124f},
+    { 0.356822f, -0.934172f,  0.000000f},
+    { 0.176549f, -0.939124f, -0.294748f},
+    { 0.176549f, -0.939124f,  0.294748f},
+    { 0.653462f, -0.756960f,  0.000000f},
+    { 0.577350f, -0.577350f, -0.577350f},
+    { 0.285662f, -0.762575f, -0.580411f},
+    { 0.580411f, -0.285662f, -0.762575f},
+    { 0.762575f, -0.580411f, -0.285662f},
+    { 0.934172f,  0.000000f, -0.356822f},
+    { 0.939124f, -0.294748f, -0.176549f},
+    { 0.756960f,  0.000000f, -0.653462f},
+    { 0.939124f,  0.294748f, -0.176549f},
+    { 0.577350f,  0.577350f, -0.577350f},
+    { 0.580411f,  0.285662f, -0.762575f},
+    { 0.762575f,  0.580411f, -0.285662f},
+    { 0.285662f,  0.762575f, -0.580411f},
+    { 0.000000f,  0.356822f, -0.934172f},
+    { 0.294748f,  0.176549f, -0.939124f},
+    { 0.000000f,  0.653462f, -0.756960f},
+    {-0.294748f,  0.176549f, -0.939124f},
+    {-0.577350f,  0.577350f, -0.577350f},
+    {-0.285662f,  0.762575f, -0.580411f},
+    {-0.762575f,  0.580411f, -0.285662f},
+    {-0.580411f,  0.285662f, -0.762575f},
+    { 0.934172f,  0.000000f,  0.356822f},
+    { 0.939124f, -0.294748f,  0.176549f},
+    { 0.756960f,  0.000000f,  0.653462f},
+    { 0.939124f,  0.294748f,  0.176549f},
+    { 0.577350f,  0.577350f,  0.577350f},
+    { 0.580411f,  0.285662f,  0.762575f},
+    { 0.762575f,  0.580411f,  0.285662f},
+    { 0.285662f,  0.762575f,  0.580411f},
+    { 0.356822f,  0.934172f,  0.000000f},
+    { 0.653462f,  0.756960f,  0.000000f},
+    { 0.176549f,  0.939124f,  0.294748f},
+    { 0.176549f,  0.939124f, -0.294748f},
+    { 0.000000f,  0.356822f,  0.934172f},
+    { 0.294748f,  0.176549f,  0.939124f},
+    { 0.000000f,  0.653462f,  0.756960f},
+    {-0.294748f,  0.176549f,  0.939124f},
+    {-0.356822f,  0.934172f,  0.000000f},
+    {-0.176549f,  0.939124f,  0.294748f},
+    {-0.176549f,  0.939124f, -0.294748f},
+    {-0.653462f,  0.756960f,  0.000000f},
+    {-0.577350f,  0.577350f,  0.577350f},
+    {-0.285662f,  0.762575f,  0.580411f},
+    {-0.580411f,  0.285662f,  0.762575f},
+    {-0.762575f,  0.580411f,  0.285662f},
+    {-0.934172f,  0.000000f,  0.356822f},
+    {-0.939124f,  0.294748f,  0.176549f},
+    {-0.756960f,  0.000000f,  0.653462f},
+    {-0.939124f, -0.294748f,  0.176549f},
+    {-0.577350f, -0.577350f,  0.577350f},
+    {-0.580411f, -0.285662f,  0.762575f},
+    {-0.762575f, -0.580411f,  0.285662f},
+    {-0.285662f, -0.762575f,  0.580411f},
+    { 0.000000f, -0.356822f,  0.934172f},
+    {-0.294748f, -0.176549f,  0.939124f},
+    { 0.000000f, -0.653462f,  0.756960f},
+    { 0.294748f, -0.176549f,  0.939124f},
+    { 0.577350f, -0.577350f,  0.577350f},
+    { 0.285662f, -0.762575f,  0.580411f},
+    { 0.762575f, -0.580411f,  0.285662f},
+    { 0.580411f, -0.285662f,  0.762575f},
+};
+
 int AP_GeodesicGrid::section(const Vector3f &v, bool inclusive)
 {
     int i = _triangle_index(v, inclusive);
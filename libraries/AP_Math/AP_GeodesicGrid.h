@@ -125,6 +125,30 @@ public:
      */
     static int section(const Vector3f &v, bool inclusive = false);
 
+    /**
+     * Number of sections.
+     */
+    static const int NUM_SECTIONS = 20 * NUM_SUBTRIANGLES;
+
+    /**
+     * Angle in radians, rounded up, within which every vector crossing a
+     * section lies from its section_center().
+     */
+    static constexpr float SECTION_RADIUS = 0.3666f; // 21 degrees
+
+    /**
+     * Get the unit vector crossing the center of a section.
+     *
+     * @param section[in] The index of the section, in [0, NUM_SECTIONS).
+     *
+     * @return The unit vector crossing the centroid of the section's
+     * triangle.
+     */
+    static const Vector3f &section_center(int section)
+    {
+        return _section_centers[section];
+    }
+
 private:
     /*
      * The following are concepts used in the description of the private
@@ -178,6 +202,11 @@ private:
      */
     static const Matrix3f _mid_inverses[10];
 
+    /**
+     * The unit vectors crossing the centroids of the sections' triangles.
+     */
+    static const Vector3f _section_centers[NUM_SECTIONS];
+
     /**
      * The representation of the neighbor umbrellas of T_0.
      *
@@ -0,0 +1,148 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_GeodesicSampleIndex.h"
+
+#include <AP_InternalError/AP_InternalError.h>
+
+static const float cos_section_radius = cosf(AP_GeodesicGrid::SECTION_RADIUS);
+static const float sin_section_radius = sinf(AP_GeodesicGrid::SECTION_RADIUS);
+
+bool AP_GeodesicSampleIndex::init(uint16_t max_samples)
+{
+    deinit();
+    _next = NEW_NOTHROW uint16_t[max_samples];
+    _bucket = NEW_NOTHROW uint8_t[max_samples];
+    if (_next == nullptr || _bucket == nullptr) {
+        deinit();
+        return false;
+    }
+    _max_samples = max_samples;
+    clear(Vector3f());
+    return true;
+}
+
+void AP_GeodesicSampleIndex::deinit()
+{
+    delete[] _next;
+    delete[] _bucket;
+    _next = nullptr;
+    _bucket = nullptr;
+    _max_samples = 0;
+}
+
+void AP_GeodesicSampleIndex::clear(const Vector3f &center)
+{
+    _center = center;
+    for (auto &h : _head) {
+        h = END;
+    }
+    for (uint16_t i = 0; i < _max_samples; i++) {
+        _bucket[i] = NO_SECTION;
+    }
+}
+
+uint8_t AP_GeodesicSampleIndex::bucket(const Vector3f &sample) const
+{
+    const int section = AP_GeodesicGrid::section(sample - _center, true);
+    if (section < 0) {
+        return NO_SECTION;
+    }
+    return section;
+}
+
+void AP_GeodesicSampleIndex::add(uint16_t idx, const Vector3f &sample)
+{
+    if (idx >= _max_samples) {
+        INTERNAL_ERROR(AP_InternalError::error_t::flow_of_control);
+        return;
+    }
+    const uint8_t b = bucket(sample);
+    _bucket[idx] = b;
+    _next[idx] = _head[b];
+    _head[b] = idx;
+}
+
+void AP_GeodesicSampleIndex::remove(uint16_t idx)
+{
+    if (idx >= _max_samples) {
+        return;
+    }
+    for (uint16_t *p = &_head[_bucket[idx]]; *p != END; p = &_next[*p]) {
+        if (*p == idx) {
+            *p = _next[idx];
+            return;
+        }
+    }
+}
+
+bool AP_GeodesicSampleIndex::bucket_is_clear(uint8_t b, const Vector3f &sample, float min_dist, sample_fn get_sample, uint16_t skip_idx) const
+{
+    const float min_dist_sq = sq(min_dist);
+    for (uint16_t i = _head[b]; i != END; i = _next[i]) {
+        if (i != skip_idx && (sample - get_sample(i)).length_squared() < min_dist_sq) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+  A sample closer than min_dist to a sample whose direction from the
+  center is r makes an angle of at most phi = asin(min_dist/|r|) with
+  r, and every direction in a section is within SECTION_RADIUS of the
+  section's center. So only the sections whose centers are within
+  phi + SECTION_RADIUS of r need searching, which for the sample
+  counts the calibrators use is a handful of the 80
+ */
+bool AP_GeodesicSampleIndex::is_clear(const Vector3f &sample, float min_dist, sample_fn get_sample, uint16_t skip_idx) const
+{
+    if (_next == nullptr) {
+        return false;
+    }
+
+    // samples without a direction could be close to anything
+    if (!bucket_is_clear(NO_SECTION, sample, min_dist, get_sample, skip_idx)) {
+        return false;
+    }
+
+    const Vector3f r = sample - _center;
+    const float len = r.length();
+    if (min_dist >= len) {
+        // any direction could hold a close sample
+        for (uint8_t b = 0; b < NUM_SECTIONS; b++) {
+            if (!bucket_is_clear(b, sample, min_dist, get_sample, skip_idx)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // cos(phi + SECTION_RADIUS)
+    const float sin_phi = min_dist / len;
+    const float cos_phi = sqrtf(1 - sq(sin_phi));
+    const float cos_search = cos_phi * cos_section_radius - sin_phi * sin_section_radius;
+
+    const Vector3f dir = r / len;
+    for (uint8_t b = 0; b < NUM_SECTIONS; b++) {
+        if (_head[b] == END || dir * AP_GeodesicGrid::section_center(b) < cos_search) {
+            continue;
+        }
+        if (!bucket_is_clear(b, sample, min_dist, get_sample, skip_idx)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,81 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  index of samples lying roughly on a sphere, bucketed by the
+  AP_GeodesicGrid section their direction from the sphere's center
+  falls in. The calibrators use it to check that a new sample is not
+  too close to any stored sample by looking only at the samples in
+  the sections near it, rather than at every stored sample.
+
+  The samples themselves stay in the caller's buffer; the index only
+  holds their indexes in that buffer
+ */
+
+#include <AP_Common/AP_Common.h>
+#include <AP_HAL/utility/functor.h>
+#include "AP_GeodesicGrid.h"
+
+class AP_GeodesicSampleIndex {
+public:
+    FUNCTOR_TYPEDEF(sample_fn, Vector3f, uint16_t);
+
+    AP_GeodesicSampleIndex() {}
+    ~AP_GeodesicSampleIndex() { deinit(); }
+
+    CLASS_NO_COPY(AP_GeodesicSampleIndex);
+
+    // allocate room for up to max_samples samples, returning false if
+    // the memory could not be allocated
+    bool init(uint16_t max_samples);
+
+    // free the index
+    void deinit();
+
+    // forget all samples. Directions are taken from center, which
+    // should be an estimate of the center of the sphere
+    void clear(const Vector3f &center);
+
+    // add sample, stored at idx in the caller's buffer
+    void add(uint16_t idx, const Vector3f &sample);
+
+    // remove the sample at idx in the caller's buffer
+    void remove(uint16_t idx);
+
+    // return true if no sample but skip_idx is closer than min_dist
+    // to sample. get_sample returns the sample at an index in the
+    // caller's buffer
+    bool is_clear(const Vector3f &sample, float min_dist, sample_fn get_sample, uint16_t skip_idx = UINT16_MAX) const;
+
+private:
+    static const uint8_t NUM_SECTIONS = AP_GeodesicGrid::NUM_SECTIONS;
+    // bucket for samples too close to the center to have a direction
+    static const uint8_t NO_SECTION = NUM_SECTIONS;
+    static const uint16_t END = UINT16_MAX;
+
+    // bucket for sample
+    uint8_t bucket(const Vector3f &sample) const;
+
+    // return false if any sample in bucket but skip_idx is closer
+    // than min_dist to sample
+    bool bucket_is_clear(uint8_t b, const Vector3f &sample, float min_dist, sample_fn get_sample, uint16_t skip_idx) const;
+
+    Vector3f _center;
+    uint16_t _head[NUM_SECTIONS+1];     // first sample in each bucket
+    uint16_t *_next = nullptr;          // next sample in the same bucket, per sample
+    uint8_t *_bucket = nullptr;         // bucket of each sample
+    uint16_t _max_samples = 0;
+};
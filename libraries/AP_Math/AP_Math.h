@@ -117,6 +117,10 @@ void mat_mul(const T *A, const T *B, T *C, uint16_t n);
 template <typename T>
 bool mat_inverse(const T *x, T *y, uint16_t dim) WARN_IF_UNUSED;
 
+// inverse of a symmetric positive definite matrix, e.g. J^T*J
+template <typename T>
+bool mat_inverse_spd(const T *x, T *y, uint16_t dim) WARN_IF_UNUSED;
+
 // matrix identity
 template <typename T>
 void mat_identity(T *x, uint16_t dim);
@@ -646,10 +646,15 @@ void SCurve::get_jerk_accel_vel_pos_at_time(float time_now, float &Jt_out, float
     uint8_t pnt = num_segs;
     float Jm, tj, T0, A0, V0, P0;
 
-    // find active segment at time_now
-    for (uint8_t i = 0; i < num_segs; i++) {
-        if (time_now < segment[num_segs - 1 - i].end_time) {
-            pnt = num_segs - 1 - i;
+    // find active segment at time_now, this is the first segment ending after time_now
+    // segment end times never decrease so a binary search can be used
+    uint8_t low = 0;
+    while (low < pnt) {
+        const uint8_t mid = (low + pnt) / 2;
+        if (time_now < segment[mid].end_time) {
+            pnt = mid;
+        } else {
+            low = mid + 1;
         }
     }
     if (pnt == 0) {
@@ -713,10 +718,12 @@ void SCurve::calc_javp_for_segment_incr_jerk(float time_now, float tj, float Jm,
     }
     const float Alpha = Jm * 0.5f;
     const float Beta = M_PI / tj;
-    Jt = Alpha * (1.0f - cosf(Beta * time_now));
-    At = A0 + Alpha * time_now - (Alpha / Beta) * sinf(Beta * time_now);
-    Vt = V0 + A0 * time_now + (Alpha * 0.5f) * (time_now * time_now) + (Alpha / (Beta * Beta)) * cosf(Beta * time_now) - Alpha / (Beta * Beta);
-    Pt = P0 + V0 * time_now + 0.5f * A0 * (time_now * time_now) + (-Alpha / (Beta * Beta)) * time_now + Alpha * (time_now * time_now * time_now) / 6.0f + (Alpha / (Beta * Beta * Beta)) * sinf(Beta * time_now);
+    const float cos_Bt = cosf(Beta * time_now);
+    const float sin_Bt = sinf(Beta * time_now);
+    Jt = Alpha * (1.0f - cos_Bt);
+    At = A0 + Alpha * time_now - (Alpha / Beta) * sin_Bt;
+    Vt = V0 + A0 * time_now + (Alpha * 0.5f) * (time_now * time_now) + (Alpha / (Beta * Beta)) * cos_Bt - Alpha / (Beta * Beta);
+    Pt = P0 + V0 * time_now + 0.5f * A0 * (time_now * time_now) + (-Alpha / (Beta * Beta)) * time_now + Alpha * (time_now * time_now * time_now) / 6.0f + (Alpha / (Beta * Beta * Beta)) * sin_Bt;
 }
 
 // Calculate the jerk, acceleration, velocity and position at time time_now when running the decreasing jerk magnitude time segment based on a raised cosine profile
@@ -734,10 +741,12 @@ void SCurve::calc_javp_for_segment_decr_jerk(float time_now, float tj, float Jm,
     const float AT = Alpha * tj;
     const float VT = Alpha * ((tj * tj) * 0.5f - 2.0f / (Beta * Beta));
     const float PT = Alpha * ((-1.0f / (Beta * Beta)) * tj + (1.0f / 6.0f) * (tj * tj * tj));
-    Jt = Alpha * (1.0f - cosf(Beta * (time_now + tj)));
-    At = (A0 - AT) + Alpha * (time_now + tj) - (Alpha / Beta) * sinf(Beta * (time_now + tj));
-    Vt = (V0 - VT) + (A0 - AT) * time_now + 0.5f * Alpha * (time_now + tj) * (time_now + tj) + (Alpha / (Beta * Beta)) * cosf(Beta * (time_now + tj)) - Alpha / (Beta * Beta);
-    Pt = (P0 - PT) + (V0 - VT) * time_now + 0.5f * (A0 - AT) * (time_now * time_now) + (-Alpha / (Beta * Beta)) * (time_now + tj) + (Alpha / 6.0f) * (time_now + tj) * (time_now + tj) * (time_now + tj) + (Alpha / (Beta * Beta * Beta)) * sinf(Beta * (time_now + tj));
+    const float cos_Bt = cosf(Beta * (time_now + tj));
+    const float sin_Bt = sinf(Beta * (time_now + tj));
+    Jt = Alpha * (1.0f - cos_Bt);
+    At = (A0 - AT) + Alpha * (time_now + tj) - (Alpha / Beta) * sin_Bt;
+    Vt = (V0 - VT) + (A0 - AT) * time_now + 0.5f * Alpha * (time_now + tj) * (time_now + tj) + (Alpha / (Beta * Beta)) * cos_Bt - Alpha / (Beta * Beta);
+    Pt = (P0 - PT) + (V0 - VT) * time_now + 0.5f * (A0 - AT) * (time_now * time_now) + (-Alpha / (Beta * Beta)) * (time_now + tj) + (Alpha / 6.0f) * (time_now + tj) * (time_now + tj) * (time_now + tj) + (Alpha / (Beta * Beta * Beta)) * sin_Bt;
 }
 
 // generate the segments for a path of length L
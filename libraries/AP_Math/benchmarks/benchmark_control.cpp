@@ -0,0 +1,175 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/control.h>
+#include <AP_Math/SCurve.h>
+#include <AP_Common/Location.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  rotation benchmarks are run for both float and double so the cost of
+  building with HAL_WITH_EKF_DOUBLE can be compared
+ */
+template <class T>
+static void BM_QuaternionRotate(benchmark::State& state)
+{
+    QuaternionT<T> q;
+    q.from_euler(T(0.1), T(-0.2), T(1.3));
+    const Vector3<T> rate{T(0.01), T(-0.02), T(0.005)};
+    while (state.KeepRunning()) {
+        q.rotate(rate);
+        gbenchmark_escape(&q);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_QuaternionRotate, float);
+BENCHMARK_TEMPLATE(BM_QuaternionRotate, double);
+
+template <class T>
+static void BM_QuaternionEarthToBody(benchmark::State& state)
+{
+    QuaternionT<T> q;
+    q.from_euler(T(0.1), T(-0.2), T(1.3));
+    Vector3<T> v{T(1), T(2), T(3)};
+    while (state.KeepRunning()) {
+        q.earth_to_body(v);
+        gbenchmark_escape(&v);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_QuaternionEarthToBody, float);
+BENCHMARK_TEMPLATE(BM_QuaternionEarthToBody, double);
+
+template <class T>
+static void BM_Matrix3FromEuler(benchmark::State& state)
+{
+    Matrix3<T> m;
+    T yaw = 0;
+    while (state.KeepRunning()) {
+        m.from_euler(T(0.1), T(-0.2), yaw);
+        yaw += T(0.001);
+        gbenchmark_escape(&m);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Matrix3FromEuler, float);
+BENCHMARK_TEMPLATE(BM_Matrix3FromEuler, double);
+
+// Location uses ftype, so this measures whichever precision the
+// library was built with
+static void BM_LocationOffset(benchmark::State& state)
+{
+    const Location origin{-353632610, 1491652300, 58400, Location::AltFrame::ABSOLUTE};
+    uint32_t n = 0;
+    while (state.KeepRunning()) {
+        Location loc = origin;
+        loc.offset(ftype(n % 100), ftype(50));
+        n++;
+        gbenchmark_escape(&loc);
+    }
+}
+
+BENCHMARK(BM_LocationOffset);
+
+static void BM_SqrtController(benchmark::State& state)
+{
+    float error = -5;
+    while (state.KeepRunning()) {
+        float out = sqrt_controller(error, 1.5, 2.5, 0.0025);
+        error += 0.001;
+        if (error > 5) {
+            error = -5;
+        }
+        gbenchmark_escape(&out);
+    }
+}
+
+BENCHMARK(BM_SqrtController);
+
+static void BM_SqrtControllerVector2f(benchmark::State& state)
+{
+    Vector2f error{-5, 3};
+    while (state.KeepRunning()) {
+        Vector2f out = sqrt_controller(error, 1.5, 2.5, 0.0025);
+        error.x += 0.001;
+        if (error.x > 5) {
+            error.x = -5;
+        }
+        gbenchmark_escape(&out);
+    }
+}
+
+BENCHMARK(BM_SqrtControllerVector2f);
+
+// the position controller's per-loop kinematic update, Vector2p is double when built with HAL_WITH_POSTYPE_DOUBLE
+static void BM_UpdatePosVelAccelXY(benchmark::State& state)
+{
+    Vector2p pos{-35363261.0, 149165230.0};
+    Vector2f vel{500, -250};
+    const Vector2f accel{25, 10};
+    const Vector2f limit{0, 1};
+    const Vector2f pos_error{10, 5};
+    const Vector2f vel_error{-20, 15};
+    while (state.KeepRunning()) {
+        update_pos_vel_accel_xy(pos, vel, accel, 0.0025, limit, pos_error, vel_error);
+        gbenchmark_escape(&pos);
+        gbenchmark_escape(&vel);
+    }
+}
+
+BENCHMARK(BM_UpdatePosVelAccelXY);
+
+// the position controller's per-loop shaping towards a moving target
+static void BM_ShapePosVelAccelXY(benchmark::State& state)
+{
+    const Vector2p pos{-35363261.0, 149165230.0};
+    Vector2p pos_input = pos + Vector2p{1000.0, -500.0};
+    const Vector2f vel_input{200, 100};
+    const Vector2f accel_input{5, -5};
+    const Vector2f vel{100, 50};
+    Vector2f accel;
+    while (state.KeepRunning()) {
+        shape_pos_vel_accel_xy(pos_input, vel_input, accel_input, pos, vel, accel, 1000, 250, 500, 0.0025, true);
+        pos_input.x += 0.5;
+        gbenchmark_escape(&accel);
+    }
+}
+
+BENCHMARK(BM_ShapePosVelAccelXY);
+
+static void BM_SCurveCalculateTrack(benchmark::State& state)
+{
+    const Vector3f origin{0, 0, 0};
+    const Vector3f destination{10000, 5000, -2000};
+    SCurve scurve;
+    while (state.KeepRunning()) {
+        scurve.calculate_track(origin, destination, 1000, 250, 150, 250, 100, 1000, 500);
+        gbenchmark_escape(&scurve);
+    }
+}
+
+BENCHMARK(BM_SCurveCalculateTrack);
+
+// one navigation-rate step along a leg with a corner into the next leg
+static void BM_SCurveAdvanceTarget(benchmark::State& state)
+{
+    SCurve prev_leg, leg, next_leg;
+    leg.calculate_track(Vector3f{0, 0, 0}, Vector3f{10000, 0, 0}, 1000, 250, 150, 250, 100, 1000, 500);
+    next_leg.calculate_track(Vector3f{10000, 0, 0}, Vector3f{10000, 10000, 0}, 1000, 250, 150, 250, 100, 1000, 500);
+    Vector3f target_pos, target_vel, target_accel;
+    while (state.KeepRunning()) {
+        if (leg.finished()) {
+            leg.init();
+            leg.calculate_track(Vector3f{0, 0, 0}, Vector3f{10000, 0, 0}, 1000, 250, 150, 250, 100, 1000, 500);
+            target_pos.zero();
+        }
+        bool passed = leg.advance_target_along_track(prev_leg, next_leg, 200, 250, true, 0.0025, target_pos, target_vel, target_accel);
+        gbenchmark_escape(&passed);
+        gbenchmark_escape(&target_pos);
+    }
+}
+
+BENCHMARK(BM_SCurveAdvanceTarget);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  throughput of the common CRCs over a 2k buffer
+ */
+
+static uint8_t buf[2048];
+
+static void fill_buf()
+{
+    uint32_t seed = 1;
+    for (auto &b : buf) {
+        seed = seed * 1103515245U + 12345U;
+        b = seed >> 24;
+    }
+}
+
+static void BM_CRC32(benchmark::State& state)
+{
+    fill_buf();
+    uint32_t crc = 0;
+    while (state.KeepRunning()) {
+        crc = crc_crc32(crc, buf, sizeof(buf));
+        gbenchmark_escape(&crc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * sizeof(buf));
+}
+
+BENCHMARK(BM_CRC32);
+
+static void BM_CRC32Small(benchmark::State& state)
+{
+    fill_buf();
+    uint32_t crc = 0;
+    while (state.KeepRunning()) {
+        crc = crc32_small(crc, buf, sizeof(buf));
+        gbenchmark_escape(&crc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * sizeof(buf));
+}
+
+BENCHMARK(BM_CRC32Small);
+
+static void BM_CRC16CCITT(benchmark::State& state)
+{
+    fill_buf();
+    uint16_t crc = 0;
+    while (state.KeepRunning()) {
+        crc = crc16_ccitt(buf, sizeof(buf), crc);
+        gbenchmark_escape(&crc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * sizeof(buf));
+}
+
+BENCHMARK(BM_CRC16CCITT);
+
+static void BM_CRC8DVB(benchmark::State& state)
+{
+    fill_buf();
+    uint8_t crc = 0;
+    while (state.KeepRunning()) {
+        crc = crc8_dvb_update(crc, buf, sizeof(buf));
+        gbenchmark_escape(&crc);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * sizeof(buf));
+}
+
+BENCHMARK(BM_CRC8DVB);
+
+BENCHMARK_MAIN();
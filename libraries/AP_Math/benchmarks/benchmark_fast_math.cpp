@@ -0,0 +1,110 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/fast_math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  each fast_math.h function against its libm equivalent. The inputs
+  change every iteration so the results can't be hoisted out of the
+  loop
+ */
+
+static void BM_LibmSinCos(benchmark::State& state)
+{
+    float x = -10;
+    while (state.KeepRunning()) {
+        float s = sinf(x) + cosf(x);
+        x += 0.001f;
+        gbenchmark_escape(&s);
+    }
+}
+
+BENCHMARK(BM_LibmSinCos);
+
+static void BM_FastSinCos(benchmark::State& state)
+{
+    float x = -10;
+    while (state.KeepRunning()) {
+        float s = fast_sinf(x) + fast_cosf(x);
+        x += 0.001f;
+        gbenchmark_escape(&s);
+    }
+}
+
+BENCHMARK(BM_FastSinCos);
+
+static void BM_LibmAtan2(benchmark::State& state)
+{
+    float y = -10;
+    while (state.KeepRunning()) {
+        float a = atan2f(y, 3.0f);
+        y += 0.001f;
+        gbenchmark_escape(&a);
+    }
+}
+
+BENCHMARK(BM_LibmAtan2);
+
+static void BM_FastAtan2(benchmark::State& state)
+{
+    float y = -10;
+    while (state.KeepRunning()) {
+        float a = fast_atan2f(y, 3.0f);
+        y += 0.001f;
+        gbenchmark_escape(&a);
+    }
+}
+
+BENCHMARK(BM_FastAtan2);
+
+static void BM_LibmInvSqrt(benchmark::State& state)
+{
+    float x = 0.01f;
+    while (state.KeepRunning()) {
+        float r = 1.0f / sqrtf(x);
+        x += 0.001f;
+        gbenchmark_escape(&r);
+    }
+}
+
+BENCHMARK(BM_LibmInvSqrt);
+
+static void BM_FastInvSqrt(benchmark::State& state)
+{
+    float x = 0.01f;
+    while (state.KeepRunning()) {
+        float r = fast_inv_sqrtf(x);
+        x += 0.001f;
+        gbenchmark_escape(&r);
+    }
+}
+
+BENCHMARK(BM_FastInvSqrt);
+
+static void BM_LibmExp(benchmark::State& state)
+{
+    float x = -10;
+    while (state.KeepRunning()) {
+        float e = expf(x);
+        x += 0.0001f;
+        gbenchmark_escape(&e);
+    }
+}
+
+BENCHMARK(BM_LibmExp);
+
+static void BM_FastExp(benchmark::State& state)
+{
+    float x = -10;
+    while (state.KeepRunning()) {
+        float e = fast_expf(x);
+        x += 0.0001f;
+        gbenchmark_escape(&e);
+    }
+}
+
+BENCHMARK(BM_FastExp);
+
+BENCHMARK_MAIN();
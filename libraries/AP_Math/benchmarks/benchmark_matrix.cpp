@@ -21,4 +21,65 @@ static void BM_MatrixMultiplication(benchmark::State& state)
 
 BENCHMARK(BM_MatrixMultiplication);
 
+// J^T*J + lambda*I as used by the 9 parameter compass calibration fit
+static void fill_normal_matrix(float m[81])
+{
+    for (uint8_t i = 0; i < 9; i++) {
+        for (uint8_t j = 0; j < 9; j++) {
+            m[i*9+j] = (i == j ? 10.0f : 0.0f) + 1.0f / (1 + i + j);
+        }
+    }
+}
+
+static void BM_MatrixInverse9(benchmark::State& state)
+{
+    float m[81];
+    fill_normal_matrix(m);
+
+    while (state.KeepRunning()) {
+        float inv[81];
+        bool ret = mat_inverse(m, inv, 9);
+        gbenchmark_escape(&ret);
+        gbenchmark_escape(inv);
+    }
+}
+
+BENCHMARK(BM_MatrixInverse9);
+
+static void BM_MatrixInverseSPD9(benchmark::State& state)
+{
+    float m[81];
+    fill_normal_matrix(m);
+
+    while (state.KeepRunning()) {
+        float inv[81];
+        bool ret = mat_inverse_spd(m, inv, 9);
+        gbenchmark_escape(&ret);
+        gbenchmark_escape(inv);
+    }
+}
+
+BENCHMARK(BM_MatrixInverseSPD9);
+
+static void BM_MatrixInverse10(benchmark::State& state)
+{
+    // one size above the fixed size versions, for comparison with
+    // the heap allocating LU decomposition
+    float m[100];
+    for (uint8_t i = 0; i < 10; i++) {
+        for (uint8_t j = 0; j < 10; j++) {
+            m[i*10+j] = (i == j ? 10.0f : 0.0f) + 1.0f / (1 + i + j);
+        }
+    }
+
+    while (state.KeepRunning()) {
+        float inv[100];
+        bool ret = mat_inverse(m, inv, 10);
+        gbenchmark_escape(&ret);
+        gbenchmark_escape(inv);
+    }
+}
+
+BENCHMARK(BM_MatrixInverse10);
+
 BENCHMARK_MAIN();
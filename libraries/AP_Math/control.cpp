@@ -25,7 +25,7 @@
 #include <AP_InternalError/AP_InternalError.h>
 
 // control default definitions
-#define CORNER_ACCELERATION_RATIO   1.0/safe_sqrt(2.0)   // acceleration reduction to enable zero overshoot corners
+#define CORNER_ACCELERATION_RATIO   M_SQRT1_2   // acceleration reduction to enable zero overshoot corners (1/sqrt(2))
 
 // update_vel_accel - single axis projection of velocity, vel, forwards in time based on a time step of dt and acceleration of accel.
 // the velocity is not moved in the direction of limit if limit is not set to zero.
@@ -0,0 +1,140 @@
+#pragma once
+
+/*
+  reduced precision approximations of libm functions for code where a
+  small error doesn't matter, such as display and telemetry. They
+  avoid the argument checks and branches of the newlib routines.
+  Where the FPU has a square root instruction, as on Cortex-M4F and
+  M7, 1.0f/sqrtf() is already fast and fast_inv_sqrtf() is only of
+  use on boards without one.
+
+  These are opt-in: don't use them in estimators or controllers. The
+  error bounds given are the maximum seen over the documented input
+  range in the unit tests.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "definitions.h"
+
+// sine of r in [-pi/2, pi/2], Taylor series to r^11 with truncation
+// error below 6e-8 at the ends
+static inline float fast_sinf_reduced(float r)
+{
+    const float r2 = r * r;
+    return r * (1.0f +
+           r2 * (-0.16666667f +
+           r2 * (0.0083333333f +
+           r2 * (-1.9841270e-4f +
+           r2 * (2.7557319e-6f +
+           r2 * -2.5052108e-8f)))));
+}
+
+// reduce x to r in [-pi/2, pi/2] with x = r + k*pi, returning k. pi
+// is split in two so k*3.140625 is exact (Cody-Waite reduction)
+static inline int32_t fast_reduce_pi(float x, float &r)
+{
+    const float kf = x * float(1.0/M_PI);
+    const int32_t k = int32_t(kf >= 0 ? kf + 0.5f : kf - 0.5f);
+    r = (x - float(k) * 3.140625f) - float(k) * 9.6765358979e-4f;
+    return k;
+}
+
+/*
+  sine, absolute error below 1e-6 for |x| <= 1000 radians. Larger
+  angles lose accuracy in the range reduction
+ */
+static inline float fast_sinf(float x)
+{
+    // sin(r + k*pi) = (-1)^k sin(r)
+    float r;
+    const int32_t k = fast_reduce_pi(x, r);
+    const float s = fast_sinf_reduced(r);
+    return (k & 1) ? -s : s;
+}
+
+/*
+  cosine, absolute error below 1e-6 for |x| <= 1000 radians
+ */
+static inline float fast_cosf(float x)
+{
+    // cos(r + k*pi) = (-1)^k cos(r) = (-1)^k sin(pi/2 - |r|)
+    float r;
+    const int32_t k = fast_reduce_pi(x, r);
+    const float c = fast_sinf_reduced(float(M_PI_2) - (r < 0 ? -r : r));
+    return (k & 1) ? -c : c;
+}
+
+/*
+  atan2 in radians in the range [-pi, pi], absolute error below 2e-5
+  radians. Returns zero for (0, 0)
+ */
+static inline float fast_atan2f(float y, float x)
+{
+    const float ax = x < 0 ? -x : x;
+    const float ay = y < 0 ? -y : y;
+    const float max_xy = ax > ay ? ax : ay;
+    if (max_xy <= 0) {
+        return 0;
+    }
+    // atan of z in [0, 1], polynomial from Abramowitz and Stegun 4.4.49
+    const float z = (ax > ay ? ay : ax) / max_xy;
+    const float z2 = z * z;
+    float a = z * (0.9998660f +
+              z2 * (-0.3302995f +
+              z2 * (0.1801410f +
+              z2 * (-0.0851330f +
+              z2 * 0.0208351f))));
+    // unfold the octant
+    if (ay > ax) {
+        a = float(M_PI_2) - a;
+    }
+    if (x < 0) {
+        a = float(M_PI) - a;
+    }
+    return y < 0 ? -a : a;
+}
+
+/*
+  1/sqrt(x) for positive normal x, relative error below 5e-6. Uses the
+  integer estimate of the exponent followed by two Newton iterations
+ */
+static inline float fast_inv_sqrtf(float x)
+{
+    uint32_t i;
+    memcpy(&i, &x, sizeof(i));
+    i = 0x5f375a86U - (i >> 1);
+    float y;
+    memcpy(&y, &i, sizeof(y));
+    const float half_x = 0.5f * x;
+    y = y * (1.5f - half_x * y * y);
+    y = y * (1.5f - half_x * y * y);
+    return y;
+}
+
+/*
+  e^x, relative error below 1e-6. x is limited to [-87, 88] so the
+  result is always a normal float
+ */
+static inline float fast_expf(float x)
+{
+    x = x < -87.0f ? -87.0f : (x > 88.0f ? 88.0f : x);
+    // e^x = 2^n * e^r with n an integer and |r| <= ln(2)/2. ln(2) is
+    // split in two so n*0.693145751953125 is exact (Cody-Waite reduction)
+    const float t = x * 1.4426950408889634f;  // log2(e)
+    const int32_t n = int32_t(t >= 0 ? t + 0.5f : t - 0.5f);
+    const float r = (x - float(n) * 0.693145751953125f) - float(n) * 1.4286067653e-6f;
+    // Taylor series of e^r
+    const float p = 1.0f + r * (1.0f +
+                           r * (0.5f +
+                           r * (0.16666667f +
+                           r * (0.041666668f +
+                           r * (0.0083333338f +
+                           r * 0.0013888889f)))));
+    // scale by 2^n through the exponent bits. n is in [-126, 127]
+    const uint32_t bits = uint32_t(n + 127) << 23;
+    float scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
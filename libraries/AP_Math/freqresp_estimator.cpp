@@ -0,0 +1,104 @@
+/*
+ * This file is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <AP_Math/AP_Math.h>
+#include "freqresp_estimator.h"
+
+// number of cycles at the current frequency in the demodulation filter
+// time constant. Longer gives less noise but more lag as the chirp sweeps
+#define FREQRESP_DEMOD_CYCLES       2.0f
+
+// ratio of the spectra filter time constant to the demodulation filter
+#define FREQRESP_SPECTRA_RATIO      2.0f
+
+void FreqRespEstimator::init(float frequency_start_hz, float frequency_stop_hz, uint8_t points_per_decade)
+{
+    freq_ratio = powf(10.0f, 1.0f / MAX(points_per_decade, 1U));
+    // the chirp dwells at the start frequency while fading in, so the
+    // first result is one step above it
+    next_freq_hz = frequency_start_hz * freq_ratio;
+    stop_freq_hz = frequency_stop_hz;
+    theta = 0.0f;
+    demod_freq_hz = frequency_start_hz;
+    spectra_freq_hz = frequency_start_hz;
+    input_dft.zero();
+    output_dft.zero();
+    cross.zero();
+    input_power = 0.0f;
+    output_power = 0.0f;
+    have_result = false;
+    result = {};
+}
+
+bool FreqRespEstimator::update(float dt, float freq_rads, float input, float output)
+{
+    if (!is_positive(dt) || !is_positive(freq_rads)) {
+        return false;
+    }
+
+    theta = wrap_2PI(theta + freq_rads * dt);
+
+    // demodulate at the current frequency
+    const float tau = FREQRESP_DEMOD_CYCLES * M_2PI / freq_rads;
+    const float alpha = dt / (tau + dt);
+    const float c = 2.0f * cosf(theta);
+    const float s = -2.0f * sinf(theta);
+    demod_freq_hz += alpha * (freq_rads / M_2PI - demod_freq_hz);
+    input_dft.x += alpha * (input * c - input_dft.x);
+    input_dft.y += alpha * (input * s - input_dft.y);
+    output_dft.x += alpha * (output * c - output_dft.x);
+    output_dft.y += alpha * (output * s - output_dft.y);
+
+    // cross and power spectra, averaged over a longer time so the
+    // coherence shows how consistent the response is
+    const float alpha_spectra = dt / (FREQRESP_SPECTRA_RATIO * tau + dt);
+    const Vector2f cross_sample {
+        input_dft.x * output_dft.x + input_dft.y * output_dft.y,
+        input_dft.x * output_dft.y - input_dft.y * output_dft.x
+    };
+    cross += (cross_sample - cross) * alpha_spectra;
+    input_power += alpha_spectra * (input_dft.length_squared() - input_power);
+    output_power += alpha_spectra * (output_dft.length_squared() - output_power);
+    spectra_freq_hz += alpha_spectra * (demod_freq_hz - spectra_freq_hz);
+
+    const float freq_hz = spectra_freq_hz;
+    if (freq_hz < next_freq_hz || next_freq_hz > stop_freq_hz * 1.001f) {
+        return false;
+    }
+    while (next_freq_hz <= freq_hz) {
+        next_freq_hz *= freq_ratio;
+    }
+    if (!is_positive(input_power) || !is_positive(output_power)) {
+        return false;
+    }
+
+    const float cross_mag = cross.length();
+    float phase_deg = degrees(atan2f(cross.y, cross.x));
+    if (have_result) {
+        // unwrap so the phase is continuous with frequency
+        while (phase_deg < result.phase_deg - 180.0f) {
+            phase_deg += 360.0f;
+        }
+        while (phase_deg > result.phase_deg + 180.0f) {
+            phase_deg -= 360.0f;
+        }
+    }
+    result.freq_hz = freq_hz;
+    result.gain_db = 20.0f * log10f(MAX(cross_mag / input_power, FLT_EPSILON));
+    result.phase_deg = phase_deg;
+    result.coherence = sq(cross_mag) / (input_power * output_power);
+    have_result = true;
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+/*
+  recursive frequency response estimator for a chirp input. The input
+  and output are demodulated at the instantaneous chirp frequency and
+  low pass filtered, giving the gain, phase and coherence of the
+  response as the chirp sweeps. Results are produced at log spaced
+  frequencies between the start and stop of the chirp.
+ */
+
+#include "vector2.h"
+
+class FreqRespEstimator {
+
+public:
+
+    // result at one frequency
+    struct Result {
+        float freq_hz;
+        float gain_db;      // gain of output over input in dB
+        float phase_deg;    // phase of output relative to input, negative for a lag
+        float coherence;    // 0 to 1, low values show the output is not linearly related to the input
+    };
+
+    // initialise for a chirp from frequency_start_hz to
+    // frequency_stop_hz with points_per_decade results per decade
+    void init(float frequency_start_hz, float frequency_stop_hz, uint8_t points_per_decade);
+
+    // update with the input and output samples at the current chirp
+    // frequency, returns true when a new result is available. Should
+    // only be called while the chirp is running
+    bool update(float dt, float freq_rads, float input, float output);
+
+    // most recent result
+    const Result &get_result() const { return result; }
+
+private:
+    // frequency of the next result and ratio between results
+    float next_freq_hz;
+    float freq_ratio;
+    float stop_freq_hz;
+
+    // demodulation phase in radians
+    float theta;
+
+    // chirp frequency passed through the same filters as the spectra,
+    // so each result is reported at the frequency it represents
+    float demod_freq_hz;
+    float spectra_freq_hz;
+
+    // demodulated input and output, x real and y imaginary
+    Vector2f input_dft;
+    Vector2f output_dft;
+
+    // filtered cross and power spectra
+    Vector2f cross;
+    float input_power;
+    float output_power;
+
+    bool have_result;
+    Result result;
+};
@@ -420,6 +420,157 @@ static bool inverse4x4(const T m[],T invOut[])
     return true;
 }
 
+template<typename T>
+static inline T mat_abs(const T x)
+{
+    return x < 0 ? -x : x;
+}
+
+static inline float mat_sqrt(const float x)
+{
+    return sqrtf(x);
+}
+
+static inline double mat_sqrt(const double x)
+{
+    return sqrt(x);
+}
+
+/*
+ *    matrix inverse for a compile time sized square matrix, by
+ *    Gauss-Jordan elimination with partial pivoting. The fixed loop
+ *    bounds let the compiler unroll the inner loops, which is much
+ *    cheaper than mat_inverseN() for the small matrices used by the
+ *    calibrators. The only temporary is one NxN copy of A, as the
+ *    inverse is built up in inv, so the stack use stays small for the
+ *    calibrator threads
+ *
+ *    @param     A,           input NxN matrix
+ *    @param     inv,         Output inverted NxN matrix, may be the same as A. Undefined on failure
+ *    @returns                false = matrix is Singular, true = matrix inversion successful
+ */
+template<typename T, uint8_t N>
+static bool mat_inverse_fixed(const T *A, T *inv)
+{
+    T a[N][N];
+    memcpy(a, A, sizeof(a));
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            inv[i*N + j] = i == j ? 1 : 0;
+        }
+    }
+
+    for (uint8_t col = 0; col < N; col++) {
+        // pick the largest remaining element in this column as pivot
+        uint8_t pivot = col;
+        for (uint8_t r = col+1; r < N; r++) {
+            if (mat_abs(a[r][col]) > mat_abs(a[pivot][col])) {
+                pivot = r;
+            }
+        }
+        if (!(mat_abs(a[pivot][col]) > 0)) {
+            return false;
+        }
+        if (pivot != col) {
+            for (uint8_t j = 0; j < N; j++) {
+                swap(a[pivot][j], a[col][j]);
+                swap(inv[pivot*N + j], inv[col*N + j]);
+            }
+        }
+
+        const T scale = 1 / a[col][col];
+        for (uint8_t j = 0; j < N; j++) {
+            a[col][j] *= scale;
+            inv[col*N + j] *= scale;
+        }
+
+        for (uint8_t r = 0; r < N; r++) {
+            if (r == col) {
+                continue;
+            }
+            const T f = a[r][col];
+            for (uint8_t j = 0; j < N; j++) {
+                a[r][j] -= f * a[col][j];
+                inv[r*N + j] -= f * inv[col*N + j];
+            }
+        }
+    }
+
+    //check sanity of results
+    for (uint8_t i = 0; i < N*N; i++) {
+        if (isnan(inv[i]) || isinf(inv[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ *    matrix inverse for a compile time sized symmetric positive
+ *    definite matrix, such as the J^T*J of a least squares fit. The
+ *    matrix is factored as L*L^T by Cholesky decomposition and the
+ *    inverse formed as inv(L)^T*inv(L), roughly half the work of
+ *    mat_inverse_fixed(). L is inverted in place, so the only
+ *    temporary is one NxN matrix
+ *
+ *    @param     A,           input NxN matrix
+ *    @param     inv,         Output inverted NxN matrix, may be the same as A. Undefined on failure
+ *    @returns                false = matrix is not positive definite, true = matrix inversion successful
+ */
+template<typename T, uint8_t N>
+static bool mat_inverse_spd_fixed(const T *A, T *inv)
+{
+    T L[N][N] {};
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j <= i; j++) {
+            T sum = A[i*N + j];
+            for (uint8_t k = 0; k < j; k++) {
+                sum -= L[i][k] * L[j][k];
+            }
+            if (i == j) {
+                if (!(sum > 0)) {
+                    return false;
+                }
+                L[i][i] = mat_sqrt(sum);
+            } else {
+                L[i][j] = sum / L[j][j];
+            }
+        }
+    }
+
+    // invert the lower triangular factor in place by forward
+    // substitution. Row i of the inverse only needs the rows above it,
+    // which are already inverted, and the elements of row i of L to
+    // the right of the one being replaced
+    for (uint8_t i = 0; i < N; i++) {
+        const T diag_inv = 1 / L[i][i];
+        for (uint8_t j = 0; j < i; j++) {
+            T sum = 0;
+            for (uint8_t k = j; k < i; k++) {
+                sum -= L[i][k] * L[k][j];
+            }
+            L[i][j] = sum * diag_inv;
+        }
+        L[i][i] = diag_inv;
+    }
+
+    // A is not needed any more, so the product can go straight to inv
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = i; j < N; j++) {
+            T sum = 0;
+            for (uint8_t k = j; k < N; k++) {
+                sum += L[k][i] * L[k][j];
+            }
+            if (isnan(sum) || isinf(sum)) {
+                return false;
+            }
+            inv[i*N + j] = sum;
+            inv[j*N + i] = sum;
+        }
+    }
+    return true;
+}
+
 /*
  *    generic matrix inverse code
  *
@@ -432,12 +583,42 @@ template<typename T>
 bool mat_inverse(const T x[], T y[], uint16_t dim)
 {
     switch(dim){
+    case 2: return mat_inverse_fixed<T,2>(x,y);
     case 3: return inverse3x3(x,y);
     case 4: return inverse4x4(x,y);
+    case 5: return mat_inverse_fixed<T,5>(x,y);
+    case 6: return mat_inverse_fixed<T,6>(x,y);
+    case 7: return mat_inverse_fixed<T,7>(x,y);
+    case 8: return mat_inverse_fixed<T,8>(x,y);
+    case 9: return mat_inverse_fixed<T,9>(x,y);
     default: return mat_inverseN(x,y,dim);
     }
 }
 
+/*
+ *    symmetric positive definite matrix inverse code
+ *
+ *    @param     x,     input nxn matrix
+ *    @param     y,     Output inverted nxn matrix
+ *    @param     n,     dimension of square matrix
+ *    @returns          false = matrix is not positive definite, true = matrix inversion successful
+ */
+template<typename T>
+bool mat_inverse_spd(const T x[], T y[], uint16_t dim)
+{
+    switch(dim){
+    case 2: return mat_inverse_spd_fixed<T,2>(x,y);
+    case 3: return mat_inverse_spd_fixed<T,3>(x,y);
+    case 4: return mat_inverse_spd_fixed<T,4>(x,y);
+    case 5: return mat_inverse_spd_fixed<T,5>(x,y);
+    case 6: return mat_inverse_spd_fixed<T,6>(x,y);
+    case 7: return mat_inverse_spd_fixed<T,7>(x,y);
+    case 8: return mat_inverse_spd_fixed<T,8>(x,y);
+    case 9: return mat_inverse_spd_fixed<T,9>(x,y);
+    default: return mat_inverse(x,y,dim);
+    }
+}
+
 template <typename T>
 void mat_mul(const T *A, const T *B, T *C, uint16_t n)
 {
@@ -461,9 +642,11 @@ void mat_identity(T *A, uint16_t n)
 }
 
 template bool mat_inverse<float>(const float x[], float y[], uint16_t dim);
+template bool mat_inverse_spd<float>(const float x[], float y[], uint16_t dim);
 template void mat_mul<float>(const float *A, const float *B, float *C, uint16_t n);
 template void mat_identity<float>(float x[], uint16_t dim);
 
 template bool mat_inverse<double>(const double x[], double y[], uint16_t dim);
+template bool mat_inverse_spd<double>(const double x[], double y[], uint16_t dim);
 template void mat_mul<double>(const double *A, const double *B, double *C, uint16_t n);
 template void mat_identity<double>(double x[], uint16_t dim);
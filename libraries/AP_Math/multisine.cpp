@@ -0,0 +1,104 @@
+/*
+ * This file is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+* This object generates a multi-sine signal, the sum of sine waves at
+* harmonics of a base frequency. Unlike a chirp every frequency is
+* excited for the whole record, so the frequency response at all of
+* them can be found from one manoeuvre. Schroeder phases are used to
+* keep the peak of the sum low, and the output is scaled so the peak
+* matches the requested magnitude. The magnitude can be faded in at
+* the beginning and faded out at the end as for a chirp.
+*/
+#include <AP_Math/AP_Math.h>
+#include "multisine.h"
+
+// constructor
+MultiSine::MultiSine() {}
+
+// initializes the multi-sine object
+void MultiSine::init(float time_record, float frequency_min_hz, float frequency_max_hz, float time_fade_in, float time_fade_out)
+{
+    record = time_record;
+    fade_in = time_fade_in;
+    fade_out = time_fade_out;
+    base_freq_hz = MAX(frequency_min_hz, 0.01f);
+
+    // choose the harmonics, all of them if they fit, otherwise
+    // logarithmically spaced so each decade gets a similar share
+    const uint16_t harmonic_max = MAX(uint16_t(frequency_max_hz / base_freq_hz + 0.001f), 1U);
+    if (harmonic_max <= MULTISINE_MAX_COMPONENTS) {
+        num_freqs = harmonic_max;
+        for (uint8_t i = 0; i < num_freqs; i++) {
+            harmonic[i] = i + 1;
+        }
+    } else {
+        num_freqs = MULTISINE_MAX_COMPONENTS;
+        const float log_max = logf(harmonic_max);
+        uint16_t prev = 0;
+        for (uint8_t i = 0; i < num_freqs; i++) {
+            const uint16_t h = lroundf(expf(log_max * i / (num_freqs - 1)));
+            harmonic[i] = MAX(h, uint16_t(prev + 1));
+            prev = harmonic[i];
+        }
+    }
+
+    // Schroeder phases
+    for (uint8_t i = 0; i < num_freqs; i++) {
+        phase[i] = -M_PI * i * (i + 1) / num_freqs;
+    }
+
+    // find the peak of the sum over one period
+    const uint16_t samples = MIN(32U * harmonic[num_freqs - 1], 2048U);
+    float peak = 0.0f;
+    for (uint16_t i = 0; i < samples; i++) {
+        peak = MAX(peak, fabsf(sum(get_period() * i / samples)));
+    }
+    scale = is_positive(peak) ? 1.0f / peak : 0.0f;
+
+    // Mark as incomplete
+    complete = false;
+}
+
+// sum of the components at time t
+float MultiSine::sum(float time) const
+{
+    float ret = 0.0f;
+    for (uint8_t i = 0; i < num_freqs; i++) {
+        ret += sinf(M_2PI * base_freq_hz * harmonic[i] * time + phase[i]);
+    }
+    return ret;
+}
+
+// determine multi-sine signal output at the specified time and amplitude
+float MultiSine::update(float time, float waveform_magnitude)
+{
+    float window;
+    if (time <= 0.0f) {
+        window = 0.0f;
+    } else if (time <= fade_in) {
+        window = 0.5 - 0.5 * cosf(M_PI * time / fade_in);
+    } else if (time <= record - fade_out) {
+        window = 1.0;
+    } else if (time <= record) {
+        window = 0.5 - 0.5 * cosf(M_PI * (time - (record - fade_out)) / fade_out + M_PI);
+    } else {
+        window = 0.0;
+    }
+
+    complete = time > record;
+
+    return window * waveform_magnitude * scale * sum(time);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdint.h>
+#include "definitions.h"
+
+#ifndef MULTISINE_MAX_COMPONENTS
+#define MULTISINE_MAX_COMPONENTS 12
+#endif
+
+class MultiSine {
+
+public:
+
+    // constructor
+    MultiSine();
+
+    // initializes the multi-sine object. The components are harmonics
+    // of frequency_min_hz up to frequency_max_hz, spaced
+    // logarithmically if there are more than MULTISINE_MAX_COMPONENTS
+    void init(float time_record, float frequency_min_hz, float frequency_max_hz, float time_fade_in, float time_fade_out);
+
+    // determine multi-sine signal output at the specified time and
+    // peak amplitude
+    float update(float time, float waveform_magnitude);
+
+    // number of frequency components
+    uint8_t num_components() const { return num_freqs; }
+
+    // accessor for the frequency of a component in rad/s
+    float get_frequency_rads(uint8_t idx) const { return M_2PI * base_freq_hz * harmonic[idx]; }
+
+    // accessor for the highest frequency component in rad/s
+    float get_max_frequency_rads() const { return get_frequency_rads(num_freqs - 1); }
+
+    // period in seconds over which the signal repeats. Any whole
+    // number of periods holds a whole number of cycles of every component
+    float get_period() const { return 1.0f / base_freq_hz; }
+
+    // Return true if multi-sine is completed
+    bool completed() const { return complete; }
+
+private:
+    // Total length in seconds
+    float record;
+
+    // Amplitude fade in time in seconds
+    float fade_in;
+
+    // Amplitude fade out time in seconds
+    float fade_out;
+
+    // fundamental frequency in Hz
+    float base_freq_hz;
+
+    // harmonic number and phase of each component
+    uint8_t num_freqs;
+    uint16_t harmonic[MULTISINE_MAX_COMPONENTS];
+    float phase[MULTISINE_MAX_COMPONENTS];
+
+    // scale to give a peak of one for unit magnitude
+    float scale;
+
+    // sum of the components at time t, before windowing and scaling
+    float sum(float time) const;
+
+    // True if multi-sine is complete, reset to false on init
+    bool complete;
+
+};
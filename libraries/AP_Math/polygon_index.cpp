@@ -0,0 +1,257 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "polygon_index.h"
+#include "AP_Math.h"
+
+#include <float.h>
+
+#pragma GCC optimize("O2")
+
+// aim for about this many edges in each band
+#define POLYGON_INDEX_EDGES_PER_BAND 4
+#define POLYGON_INDEX_MAX_BANDS 64
+
+void AP_PolygonIndex::clear()
+{
+    delete[] band_start;
+    band_start = nullptr;
+    delete[] edges;
+    edges = nullptr;
+    num_edges = 0;
+    num_bands = 0;
+}
+
+/*
+  return the band holding y, clamped to the bands of the index
+ */
+uint16_t AP_PolygonIndex::band_for(float y) const
+{
+    const float f = (y - min_pt.y) / band_height;
+    if (f <= 0) {
+        return 0;
+    }
+    if (f >= num_bands) {
+        return num_bands - 1;
+    }
+    return uint16_t(f);
+}
+
+/*
+  return the first band an edge was added to
+ */
+uint16_t AP_PolygonIndex::first_band(const Vector2f *V, uint16_t edge) const
+{
+    const uint16_t next = (edge + 1 < num_edges) ? edge + 1 : 0;
+    return band_for(MIN(V[edge].y, V[next].y) - margin);
+}
+
+bool AP_PolygonIndex::build(const Vector2f *V, uint16_t n, float _margin)
+{
+    clear();
+
+    if (Polygon_complete(V, n)) {
+        // the last point is the same as the first point; treat as if
+        // the last point wasn't passed in
+        n--;
+    }
+    if (n < 3) {
+        return false;
+    }
+
+    margin = _margin;
+    min_pt = V[0];
+    max_pt = V[0];
+    for (uint16_t i=1; i<n; i++) {
+        min_pt.x = MIN(min_pt.x, V[i].x);
+        min_pt.y = MIN(min_pt.y, V[i].y);
+        max_pt.x = MAX(max_pt.x, V[i].x);
+        max_pt.y = MAX(max_pt.y, V[i].y);
+    }
+    min_pt -= Vector2f{margin, margin};
+    max_pt += Vector2f{margin, margin};
+
+    // long edges are added to every band they cross, so use fewer
+    // bands if that makes the index much larger than the polygon
+    num_edges = n;
+    num_bands = constrain_int16(n / POLYGON_INDEX_EDGES_PER_BAND, 1, POLYGON_INDEX_MAX_BANDS);
+    uint32_t total;
+    while (true) {
+        band_height = (max_pt.y - min_pt.y) / num_bands;
+        if (!is_positive(band_height)) {
+            num_bands = 1;
+            band_height = 1;
+        }
+        total = 0;
+        for (uint16_t i=0; i<n; i++) {
+            const uint16_t next = (i + 1 < n) ? i + 1 : 0;
+            total += band_for(MAX(V[i].y, V[next].y) + margin) - first_band(V, i) + 1;
+        }
+        if (total <= 2U * POLYGON_INDEX_EDGES_PER_BAND * n || num_bands == 1) {
+            break;
+        }
+        num_bands /= 2;
+    }
+
+    if (total > UINT16_MAX) {
+        clear();
+        return false;
+    }
+    band_start = NEW_NOTHROW uint16_t[num_bands+1];
+    edges = NEW_NOTHROW uint16_t[total];
+    if (band_start == nullptr || edges == nullptr) {
+        clear();
+        return false;
+    }
+
+    // count the edges in each band, then turn the counts into offsets
+    for (uint16_t i=0; i<n; i++) {
+        const uint16_t next = (i + 1 < n) ? i + 1 : 0;
+        const uint16_t last = band_for(MAX(V[i].y, V[next].y) + margin);
+        for (uint16_t b=first_band(V, i); b<=last; b++) {
+            band_start[b+1]++;
+        }
+    }
+    for (uint16_t b=0; b<num_bands; b++) {
+        band_start[b+1] += band_start[b];
+    }
+
+    // fill in the edges, which moves each offset to the start of the
+    // next band, then move them back
+    for (uint16_t i=0; i<n; i++) {
+        const uint16_t next = (i + 1 < n) ? i + 1 : 0;
+        const uint16_t last = band_for(MAX(V[i].y, V[next].y) + margin);
+        for (uint16_t b=first_band(V, i); b<=last; b++) {
+            edges[band_start[b]++] = i;
+        }
+    }
+    for (uint16_t b=num_bands; b>0; b--) {
+        band_start[b] = band_start[b-1];
+    }
+    band_start[0] = 0;
+
+    return true;
+}
+
+template <typename T>
+bool AP_PolygonIndex::outside(const Vector2f &p, const Vector2<T> &P, const Vector2<T> *V) const
+{
+    if (p.x < min_pt.x || p.x > max_pt.x || p.y < min_pt.y || p.y > max_pt.y) {
+        return true;
+    }
+
+    // only edges spanning P.y can be crossed
+    const uint16_t b = band_for(p.y);
+    bool ret = true;
+    for (uint16_t i=band_start[b]; i<band_start[b+1]; i++) {
+        const uint16_t e = edges[i];
+        const uint16_t next = (e + 1 < num_edges) ? e + 1 : 0;
+        if (Polygon_edge_crossing(P, V[e], V[next])) {
+            ret = !ret;
+        }
+    }
+    return ret;
+}
+
+bool AP_PolygonIndex::intersects(const Vector2f *V, const Vector2f &p1, const Vector2f &p2) const
+{
+    if (MAX(p1.x, p2.x) < min_pt.x || MIN(p1.x, p2.x) > max_pt.x ||
+        MAX(p1.y, p2.y) < min_pt.y || MIN(p1.y, p2.y) > max_pt.y) {
+        return false;
+    }
+
+    const uint16_t lo = band_for(MIN(p1.y, p2.y));
+    const uint16_t hi = band_for(MAX(p1.y, p2.y));
+    for (uint16_t b=lo; b<=hi; b++) {
+        for (uint16_t i=band_start[b]; i<band_start[b+1]; i++) {
+            const uint16_t e = edges[i];
+            // edges in several bands are only tested in the first
+            // band of the segment they appear in
+            if (MAX(first_band(V, e), lo) != b) {
+                continue;
+            }
+            const uint16_t next = (e + 1 < num_edges) ? e + 1 : 0;
+            const Vector2f &v1 = V[e];
+            const Vector2f &v2 = V[next];
+            if (v1.x > p1.x && v2.x > p1.x && v1.x > p2.x && v2.x > p2.x) {
+                continue;
+            }
+            if (v1.y > p1.y && v2.y > p1.y && v1.y > p2.y && v2.y > p2.y) {
+                continue;
+            }
+            if (v1.x < p1.x && v2.x < p1.x && v1.x < p2.x && v2.x < p2.x) {
+                continue;
+            }
+            if (v1.y < p1.y && v2.y < p1.y && v1.y < p2.y && v2.y < p2.y) {
+                continue;
+            }
+            Vector2f intersection;
+            if (Vector2f::segment_intersection(v1, v2, p1, p2, intersection)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool AP_PolygonIndex::closest_distance(const Vector2f *V, const Vector2f &p, float &closest) const
+{
+    float closest_sq = FLT_MAX;
+
+    // check the edges of band b, returning false if the band does
+    // not exist or is further away than the closest edge so far
+    auto search_band = [&](int16_t b) -> bool {
+        if (b < 0 || b >= num_bands) {
+            return false;
+        }
+        const float lower = min_pt.y + b * band_height;
+        const float upper = lower + band_height;
+        const float gap = MAX(MAX(lower - p.y, p.y - upper), 0.0f);
+        if (sq(gap) >= closest_sq) {
+            return false;
+        }
+        for (uint16_t i=band_start[b]; i<band_start[b+1]; i++) {
+            const uint16_t e = edges[i];
+            const uint16_t next = (e + 1 < num_edges) ? e + 1 : 0;
+            const float dist_sq = Vector2f::closest_distance_between_line_and_point_squared(V[e], V[next], p);
+            if (dist_sq < closest_sq) {
+                closest_sq = dist_sq;
+            }
+        }
+        return true;
+    };
+
+    // search outwards from the band holding p, stopping in each
+    // direction once the bands are further away than the closest edge
+    const int16_t b0 = band_for(p.y);
+    search_band(b0);
+    bool down = true;
+    bool up = true;
+    for (int16_t r=1; down || up; r++) {
+        down = down && search_band(b0 - r);
+        up = up && search_band(b0 + r);
+    }
+
+    if (is_equal(closest_sq, FLT_MAX)) {
+        closest = 0.0f;
+        return false;
+    }
+    closest = sqrtf(closest_sq);
+    return true;
+}
+
+// Necessary to avoid linker errors
+template bool AP_PolygonIndex::outside<int32_t>(const Vector2f &p, const Vector2l &P, const Vector2l *V) const;
+template bool AP_PolygonIndex::outside<float>(const Vector2f &p, const Vector2f &P, const Vector2f *V) const;
@@ -0,0 +1,75 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <AP_Common/AP_Common.h>
+#include "vector2.h"
+
+/*
+  index of the edges of a polygon by horizontal band, so that
+  containment, closest distance and segment intersection tests only
+  look at the edges near the query rather than every edge.
+
+  The results are the same as Polygon_outside(),
+  Polygon_closest_distance_point() and Polygon_intersects() on the
+  same polygon.
+ */
+class AP_PolygonIndex {
+public:
+    AP_PolygonIndex() {}
+    ~AP_PolygonIndex() { clear(); }
+    CLASS_NO_COPY(AP_PolygonIndex);
+
+    /*
+      build the index for polygon V of n points. margin is added to
+      the extent of each edge, allowing outside() to be used with
+      points in a coordinate system that differs from V by up to
+      margin, such as the lat/lon form of a polygon held as offsets
+     */
+    bool build(const Vector2f *V, uint16_t n, float margin = 0);
+    void clear();
+
+    bool valid() const { return band_start != nullptr; }
+
+    /*
+      return true if P is outside polygon V, where p is P in the
+      coordinate system the index was built with
+     */
+    template <typename T>
+    bool outside(const Vector2f &p, const Vector2<T> &P, const Vector2<T> *V) const;
+
+    // return true if the segment from p1 to p2 crosses an edge of V
+    bool intersects(const Vector2f *V, const Vector2f &p1, const Vector2f &p2) const;
+
+    // return the closest distance from p to an edge of V
+    bool closest_distance(const Vector2f *V, const Vector2f &p, float &closest) const;
+
+private:
+    uint16_t band_for(float y) const;
+    uint16_t first_band(const Vector2f *V, uint16_t edge) const;
+
+    // edge i runs from V[i] to V[(i+1) % num_edges]
+    uint16_t num_edges;
+    uint16_t num_bands;
+    Vector2f min_pt;    // lower corner of the padded bounding box
+    Vector2f max_pt;    // upper corner of the padded bounding box
+    float band_height;
+    float margin;
+
+    // the edges in band b are edges[band_start[b]] up to
+    // edges[band_start[b+1]]
+    uint16_t *band_start = nullptr;
+    uint16_t *edges = nullptr;
+};
@@ -0,0 +1,31 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+TEST(CRC32, check_value)
+{
+    // standard CRC-32 check value, with the usual inversion done by the caller
+    const char *s = "123456789";
+    EXPECT_EQ(0xCBF43926U, ~crc_crc32(0xFFFFFFFF, (const uint8_t *)s, 9));
+}
+
+TEST(CRC32, matches_bitwise)
+{
+    // the fast crc32 must match the bitwise one for all lengths and alignments
+    uint8_t buf[300];
+    uint32_t seed = 1;
+    for (auto &b : buf) {
+        seed = seed * 1103515245U + 12345U;
+        b = seed >> 24;
+    }
+    for (uint8_t ofs = 0; ofs < 8; ofs++) {
+        for (uint16_t len = 0; len <= sizeof(buf) - ofs; len++) {
+            EXPECT_EQ(crc32_small(0x12345678, &buf[ofs], len), crc_crc32(0x12345678, &buf[ofs], len));
+        }
+    }
+}
+
+AP_GTEST_PANIC()
+AP_GTEST_MAIN()
@@ -0,0 +1,58 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/fast_math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// check the error bounds documented in fast_math.h against libm
+
+TEST(FastMath, sin_cos)
+{
+    for (int32_t i=-1000000; i<=1000000; i+=7) {
+        const float x = i * 0.001f;
+        EXPECT_NEAR(fast_sinf(x), sin(double(x)), 1.0e-6);
+        EXPECT_NEAR(fast_cosf(x), cos(double(x)), 1.0e-6);
+    }
+    EXPECT_FLOAT_EQ(fast_sinf(0), 0);
+    EXPECT_FLOAT_EQ(fast_cosf(0), 1);
+}
+
+TEST(FastMath, atan2)
+{
+    for (int16_t i=-500; i<=500; i+=3) {
+        for (int16_t j=-500; j<=500; j+=3) {
+            const float y = i * 0.0137f;
+            const float x = j * 0.0111f;
+            if (i == 0 && j == 0) {
+                continue;
+            }
+            EXPECT_NEAR(fast_atan2f(y, x), atan2(double(y), double(x)), 2.0e-5);
+        }
+    }
+    EXPECT_FLOAT_EQ(fast_atan2f(0, 0), 0);
+    EXPECT_NEAR(fast_atan2f(1, 0), M_PI_2, 2.0e-5);
+    EXPECT_NEAR(fast_atan2f(0, -1), M_PI, 2.0e-5);
+    EXPECT_NEAR(fast_atan2f(-1, -1), -0.75 * M_PI, 2.0e-5);
+}
+
+TEST(FastMath, inv_sqrt)
+{
+    for (int16_t i=-3000; i<=3000; i++) {
+        const float x = powf(10, i * 0.01f);
+        EXPECT_NEAR(fast_inv_sqrtf(x) * sqrt(double(x)), 1.0, 5.0e-6);
+    }
+}
+
+TEST(FastMath, exp)
+{
+    for (int32_t i=-86999; i<=87999; i+=3) {
+        const float x = i * 0.001f;
+        EXPECT_NEAR(fast_expf(x) / exp(double(x)), 1.0, 1.0e-6);
+    }
+    // out of range inputs are limited
+    EXPECT_FLOAT_EQ(fast_expf(-1000), fast_expf(-87));
+    EXPECT_FLOAT_EQ(fast_expf(1000), fast_expf(88));
+}
+
+AP_GTEST_MAIN()
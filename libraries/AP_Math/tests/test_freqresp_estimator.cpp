@@ -0,0 +1,39 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/chirp.h>
+#include <AP_Math/freqresp_estimator.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// a gain of two and a 30ms delay should be recovered across the sweep
+TEST(FreqRespEstimator, delay)
+{
+    const float dt = 0.0025;
+    const uint16_t delay_samples = 12;
+    float history[delay_samples+1] {};
+
+    Chirp chirp;
+    chirp.init(40, 0.5, 10, 2, 1, 4);
+    FreqRespEstimator est;
+    est.init(0.5, 10, 10);
+
+    uint16_t results = 0;
+    for (uint32_t i = 0; !chirp.completed(); i++) {
+        const float input = chirp.update(i * dt, 1);
+        for (uint16_t j = delay_samples; j > 0; j--) {
+            history[j] = history[j-1];
+        }
+        history[0] = input;
+        if (est.update(dt, chirp.get_frequency_rads(), input, 2 * history[delay_samples])) {
+            const FreqRespEstimator::Result &result = est.get_result();
+            EXPECT_NEAR(result.gain_db, 6.02, 0.5);
+            EXPECT_NEAR(result.phase_deg, -360 * result.freq_hz * delay_samples * dt, 3);
+            EXPECT_GT(result.coherence, 0.95);
+            results++;
+        }
+    }
+    EXPECT_GE(results, 12);
+}
+
+AP_GTEST_MAIN()
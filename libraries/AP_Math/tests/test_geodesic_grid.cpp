@@ -234,4 +234,33 @@ INSTANTIATE_TEST_CASE_P(HardcodedVectors,
                         GeodesicGridTest,
                         ::testing::ValuesIn(hardcoded_vectors));
 
+TEST(GeodesicGridSectionCenters, CenterInSection)
+{
+    for (int i = 0; i < AP_GeodesicGrid::NUM_SECTIONS; i++) {
+        EXPECT_EQ(i, AP_GeodesicGrid::section(AP_GeodesicGrid::section_center(i)));
+    }
+}
+
+TEST(GeodesicGridSectionCenters, SectionRadius)
+{
+    // every vector must be within SECTION_RADIUS of its section's center
+    const float cos_radius = cosf(AP_GeodesicGrid::SECTION_RADIUS);
+    uint32_t seed = 1;
+    for (uint32_t n = 0; n < 100000; n++) {
+        float c[3];
+        for (auto &x : c) {
+            seed = seed * 1103515245U + 12345U;
+            x = (seed >> 8) * (2.0f / (1U << 24)) - 1;
+        }
+        Vector3f v { c[0], c[1], c[2] };
+        if (v.length() < 0.01) {
+            continue;
+        }
+        v.normalize();
+        const int s = AP_GeodesicGrid::section(v, true);
+        ASSERT_GE(s, 0);
+        EXPECT_GE(v * AP_GeodesicGrid::section_center(s), cos_radius);
+    }
+}
+
 AP_GTEST_MAIN()
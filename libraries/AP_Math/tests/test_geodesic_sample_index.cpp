@@ -0,0 +1,108 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/AP_GeodesicSampleIndex.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+class SampleBuffer {
+public:
+    Vector3f get(uint16_t idx) { return samples[idx]; }
+
+    bool brute_force_clear(const Vector3f &v, float min_dist, uint16_t skip_idx = UINT16_MAX) const {
+        for (uint16_t i = 0; i < count; i++) {
+            if (i != skip_idx && (v - samples[i]).length() < min_dist) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Vector3f samples[300];
+    uint16_t count;
+};
+
+static float rand_float(uint32_t &seed)
+{
+    seed = seed * 1103515245U + 12345U;
+    return (seed >> 8) * (2.0f / (1U << 24)) - 1;
+}
+
+// random point near a sphere of the given center and radius
+static Vector3f rand_sample(uint32_t &seed, const Vector3f &center, float radius)
+{
+    Vector3f d;
+    do {
+        d = Vector3f(rand_float(seed), rand_float(seed), rand_float(seed));
+    } while (d.length() < 0.1);
+    d.normalize();
+    return center + d * radius + Vector3f(rand_float(seed), rand_float(seed), rand_float(seed)) * (0.02 * radius);
+}
+
+TEST(GeodesicSampleIndex, matches_brute_force)
+{
+    SampleBuffer buf;
+    AP_GeodesicSampleIndex index;
+    ASSERT_TRUE(index.init(ARRAY_SIZE(buf.samples)));
+    const auto get = FUNCTOR_BIND(&buf, &SampleBuffer::get, Vector3f, uint16_t);
+
+    uint32_t seed = 1;
+    for (uint8_t trial = 0; trial < 40; trial++) {
+        const Vector3f center { 300 * rand_float(seed), 300 * rand_float(seed), 300 * rand_float(seed) };
+        const float radius = 200 + 300 * fabsf(rand_float(seed));
+        const float min_dist = 0.106 * radius;
+        // alternate between a good estimate of the center and none
+        index.clear((trial % 2) ? center : Vector3f());
+        buf.count = 0;
+        for (uint16_t n = 0; n < 5000 && buf.count < ARRAY_SIZE(buf.samples); n++) {
+            const Vector3f v = rand_sample(seed, center, radius);
+            const bool clear = buf.brute_force_clear(v, min_dist);
+            ASSERT_EQ(clear, index.is_clear(v, min_dist, get));
+            if (clear) {
+                index.add(buf.count, v);
+                buf.samples[buf.count++] = v;
+            }
+        }
+    }
+}
+
+TEST(GeodesicSampleIndex, remove)
+{
+    SampleBuffer buf;
+    AP_GeodesicSampleIndex index;
+    ASSERT_TRUE(index.init(ARRAY_SIZE(buf.samples)));
+    const auto get = FUNCTOR_BIND(&buf, &SampleBuffer::get, Vector3f, uint16_t);
+
+    // fill the buffer without a minimum separation, then thin it out
+    // the way CompassCalibrator::thin_samples() does
+    uint32_t seed = 2;
+    const float min_dist = 30;
+    index.clear(Vector3f());
+    for (buf.count = 0; buf.count < ARRAY_SIZE(buf.samples); buf.count++) {
+        buf.samples[buf.count] = rand_sample(seed, Vector3f(), 300);
+        index.add(buf.count, buf.samples[buf.count]);
+    }
+    for (uint16_t i = 0; i < buf.count; i++) {
+        const bool clear = buf.brute_force_clear(buf.samples[i], min_dist, i);
+        ASSERT_EQ(clear, index.is_clear(buf.samples[i], min_dist, get, i));
+        if (!clear) {
+            const uint16_t last = buf.count-1;
+            index.remove(i);
+            if (last != i) {
+                index.remove(last);
+                buf.samples[i] = buf.samples[last];
+                index.add(i, buf.samples[i]);
+            }
+            buf.count--;
+        }
+    }
+    EXPECT_LT(buf.count, ARRAY_SIZE(buf.samples));
+
+    // with every sample indexed once, each one is only close to itself
+    for (uint16_t i = 0; i < buf.count; i++) {
+        EXPECT_FALSE(index.is_clear(buf.samples[i], min_dist, get));
+    }
+}
+
+AP_GTEST_PANIC()
+AP_GTEST_MAIN()
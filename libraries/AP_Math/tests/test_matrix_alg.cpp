@@ -0,0 +1,103 @@
+#include "math_test.h"
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// fill an n x n matrix with J^T*J + I for a fixed pseudo-random J,
+// which is symmetric positive definite
+static void make_spd_matrix(float *m, uint8_t n)
+{
+    float J[10][10];
+    uint32_t seed = 12345;
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) {
+            seed = seed * 1103515245U + 12345U;
+            J[i][j] = ((seed >> 16) & 0x7FFF) / 16384.0f - 1.0f;
+        }
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) {
+            float sum = i == j ? 1.0f : 0.0f;
+            for (uint8_t k = 0; k < n; k++) {
+                sum += J[k][i] * J[k][j];
+            }
+            m[i*n+j] = sum;
+        }
+    }
+}
+
+static void expect_identity(const float *A, const float *inv, uint8_t n)
+{
+    float out[10*10];
+    mat_mul(A, inv, out, n);
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) {
+            EXPECT_NEAR(i == j ? 1.0f : 0.0f, out[i*n+j], 1.0e-4);
+        }
+    }
+}
+
+TEST(MatrixAlgTest, Inverse)
+{
+    for (uint8_t n = 2; n <= 10; n++) {
+        float A[10*10];
+        float inv[10*10];
+        make_spd_matrix(A, n);
+        // swap the first two rows so a pivot is needed
+        for (uint8_t j = 0; j < n; j++) {
+            const float tmp = A[j];
+            A[j] = A[n+j];
+            A[n+j] = tmp;
+        }
+        EXPECT_TRUE(mat_inverse(A, inv, n));
+        expect_identity(A, inv, n);
+
+        // in place
+        memcpy(inv, A, sizeof(float)*n*n);
+        EXPECT_TRUE(mat_inverse(inv, inv, n));
+        expect_identity(A, inv, n);
+    }
+}
+
+TEST(MatrixAlgTest, InverseSPD)
+{
+    for (uint8_t n = 2; n <= 10; n++) {
+        float A[10*10];
+        float inv[10*10];
+        make_spd_matrix(A, n);
+        EXPECT_TRUE(mat_inverse_spd(A, inv, n));
+        expect_identity(A, inv, n);
+
+        memcpy(inv, A, sizeof(float)*n*n);
+        EXPECT_TRUE(mat_inverse_spd(inv, inv, n));
+        expect_identity(A, inv, n);
+    }
+}
+
+TEST(MatrixAlgTest, Singular)
+{
+    for (uint8_t n = 5; n <= 9; n++) {
+        float A[9*9];
+        float inv[9*9];
+        make_spd_matrix(A, n);
+        // make the last row a copy of the first
+        memcpy(&A[(n-1)*n], &A[0], sizeof(float)*n);
+        memcpy(inv, A, sizeof(float)*n*n);
+        // the rounding in elimination may leave a tiny pivot, in
+        // which case the inverse must be huge
+        if (mat_inverse(A, inv, n)) {
+            float max_elem = 0;
+            for (uint8_t i = 0; i < n*n; i++) {
+                max_elem = MAX(max_elem, fabsf(inv[i]));
+            }
+            EXPECT_GT(max_elem, 1.0e4);
+        }
+    }
+
+    // not positive definite
+    const float A[4] { 1, 2,
+                       2, 1 };
+    float inv[4];
+    EXPECT_FALSE(mat_inverse_spd(A, inv, 2));
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,50 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/multisine.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// harmonics up to the maximum frequency are used when they fit
+TEST(MultiSine, components)
+{
+    MultiSine ms;
+    ms.init(10, 1, 5, 1, 1);
+    EXPECT_EQ(ms.num_components(), 5);
+    EXPECT_FLOAT_EQ(ms.get_period(), 1);
+    for (uint8_t i = 0; i < ms.num_components(); i++) {
+        EXPECT_FLOAT_EQ(ms.get_frequency_rads(i), M_2PI * (i + 1));
+    }
+
+    // too many harmonics, log spaced and strictly increasing
+    ms.init(10, 0.5, 50, 1, 1);
+    EXPECT_EQ(ms.num_components(), MULTISINE_MAX_COMPONENTS);
+    EXPECT_FLOAT_EQ(ms.get_frequency_rads(0), M_2PI * 0.5);
+    EXPECT_FLOAT_EQ(ms.get_max_frequency_rads(), M_2PI * 50);
+    for (uint8_t i = 1; i < ms.num_components(); i++) {
+        EXPECT_GT(ms.get_frequency_rads(i), ms.get_frequency_rads(i-1));
+    }
+}
+
+// the output is periodic, within the magnitude and faded in and out
+TEST(MultiSine, output)
+{
+    MultiSine ms;
+    ms.init(6, 1, 10, 1, 1);
+    float peak = 0;
+    for (uint16_t i = 0; i < 750; i++) {
+        const float t = 1 + i * 0.004;
+        const float out = ms.update(t, 2);
+        EXPECT_NEAR(out, ms.update(t + ms.get_period(), 2), 1.0e-3);
+        peak = MAX(peak, fabsf(out));
+    }
+    EXPECT_LE(peak, 2.05);
+    EXPECT_GT(peak, 1.8);
+
+    EXPECT_FLOAT_EQ(ms.update(0, 2), 0);
+    EXPECT_FALSE(ms.completed());
+    EXPECT_FLOAT_EQ(ms.update(6.1, 2), 0);
+    EXPECT_TRUE(ms.completed());
+}
+
+AP_GTEST_MAIN()
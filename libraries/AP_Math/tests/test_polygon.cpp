@@ -2,6 +2,7 @@
 #include <AP_Common/AP_Common.h>
 
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/polygon_index.h>
 
 struct PB {
     Vector2f point;
@@ -355,6 +356,41 @@ TEST(Polygon, simple)
     TEST_POLYGON_POINTS(SIMPLE_boundary, SIMPLE_test_points);
 }
 
+/*
+  check the polygon index gives the same answers as the brute force
+  functions on a star shaped polygon
+ */
+TEST(Polygon, index)
+{
+    const uint16_t n = 60;
+    Vector2f star[n];
+    for (uint16_t i=0; i<n; i++) {
+        const float radius = (i % 2) ? 1000 : 400;
+        const float angle = i * M_2PI / n;
+        star[i] = Vector2f{radius * cosf(angle), radius * sinf(angle)};
+    }
+    AP_PolygonIndex index;
+    EXPECT_TRUE(index.build(star, n));
+    EXPECT_TRUE(index.valid());
+
+    for (float x=-1200; x<=1200; x+=37) {
+        for (float y=-1200; y<=1200; y+=41) {
+            const Vector2f p{x, y};
+            EXPECT_EQ(Polygon_outside(p, star, n), index.outside(p, p, star));
+
+            float dist1, dist2;
+            EXPECT_EQ(Polygon_closest_distance_point(star, n, p, dist1),
+                      index.closest_distance(star, p, dist2));
+            EXPECT_FLOAT_EQ(dist1, dist2);
+
+            const Vector2f p2{y * 0.5f, -x};
+            Vector2f intersection;
+            EXPECT_EQ(Polygon_intersects(star, n, p, p2, intersection),
+                      index.intersects(star, p, p2));
+        }
+    }
+}
+
 AP_GTEST_MAIN()
 
 
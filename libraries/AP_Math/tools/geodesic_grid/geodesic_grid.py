@@ -16,6 +16,7 @@
 # with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 import argparse
+import math
 import numpy as np
 import sys
 
@@ -136,6 +137,15 @@ Generate C++ code for the initialization of members _inverses and _mid_inverses
 declared in AP_GeodesicGrid.h.
 """)
 
+parser.add_argument(
+    '--section-centers-gen',
+    action='store_true',
+    help="""
+Generate C++ code for the initialization of member _section_centers declared in
+AP_GeodesicGrid.h, and print the largest angle between a section's center and
+its vertices, from which SECTION_RADIUS is set.
+""")
+
 
 args = parser.parse_args()
 
@@ -308,6 +318,22 @@ if args.inverses_gen:
         print("     {%9.6ff, %9.6ff, %9.6ff}}," % (m[2,0], m[2,1], m[2,2]))
     print("};")
 
+if args.section_centers_gen:
+    print("Header section centers code generation:")
+    print_code_gen_notice()
+    print("const Vector3f AP_GeodesicGrid::_section_centers[%d]{" % (4 * len(ico.triangles)))
+    radius = 0
+    for s in range(4 * len(ico.triangles)):
+        t = grid.section_triangle(s)
+        c = (t.a + t.b + t.c).normalized()
+        for v in t:
+            v = v.normalized()
+            cos_angle = min(1.0, c.x * v.x + c.y * v.y + c.z * v.z)
+            radius = max(radius, math.acos(cos_angle))
+        print("    {%9.6ff, %9.6ff, %9.6ff}," % (c.x, c.y, c.z))
+    print("};")
+    print()
+    print("Largest section radius: %f degrees" % math.degrees(radius))
 
 if args.icosahedron:
     print('Icosahedron:')
@@ -15,7 +15,7 @@
 import icosahedron as ico
 
 def section_triangle(s):
-    a, b, c = ico.triangles[s / 4]
+    a, b, c = ico.triangles[s // 4]
     # project the middle points to the sphere
     alpha = a.length() / (2.0 * ico.g)
     ma, mb, mc = alpha * (a + b), alpha * (b + c), alpha * (c + a)
@@ -80,7 +80,8 @@ void AP_Mission::init()
 
     // work out maximum index for our storage size
     if (_storage.size() >= AP_MISSION_EEPROM_COMMAND_SIZE+4) {
-        _commands_max = (_storage.size()-4U) / AP_MISSION_EEPROM_COMMAND_SIZE;
+        // the command count is held in MIS_TOTAL, which is signed
+        _commands_max = MIN((_storage.size()-4U) / AP_MISSION_EEPROM_COMMAND_SIZE, uint32_t(INT16_MAX));
     }
     if (_cmd_total.get() > _commands_max) {
         // wipe mission if storage not available, but don't save. This allows sdcard error to be fixed and reboot
@@ -92,6 +93,10 @@ void AP_Mission::init()
     // command list will be cleared if they do not match
     check_eeprom_version();
 
+#if AP_MISSION_CMD_CACHE_ENABLED
+    init_cmd_cache();
+#endif
+
     // initialize the jump tracking array
     init_jump_tracking();
 
@@ -325,6 +330,16 @@ void AP_Mission::update()
     // save persistent waypoint_num for watchdog restore
     hal.util->persistent_data.waypoint_num = _nav_cmd.index;
 
+#if AP_SDCARD_STORAGE_ENABLED
+    // when the mission is paged from microSD have the commands after
+    // the current one read in the background
+    if (_nav_cmd.index != _prefetch_index && _nav_cmd.index != AP_MISSION_CMD_INDEX_NONE) {
+        _prefetch_index = _nav_cmd.index;
+        _storage.prefetch(4 + _nav_cmd.index * AP_MISSION_EEPROM_COMMAND_SIZE,
+                          AP_MISSION_SDCARD_PREFETCH_COMMANDS * AP_MISSION_EEPROM_COMMAND_SIZE);
+    }
+#endif
+
     // check if we have an active nav command
     if (!_flags.nav_cmd_loaded || _nav_cmd.index == AP_MISSION_CMD_INDEX_NONE) {
         // advance in mission if no active nav command
@@ -552,7 +567,7 @@ bool AP_Mission::is_nav_cmd(const Mission_Command& cmd)
 bool AP_Mission::get_next_nav_cmd(uint16_t start_index, Mission_Command& cmd)
 {
     // search until the end of the mission command list
-    for (uint16_t cmd_index = start_index; cmd_index < (unsigned)_cmd_total; cmd_index++) {
+    for (uint16_t cmd_index = next_stop_index(start_index); cmd_index < (unsigned)_cmd_total; cmd_index = next_stop_index(cmd_index+1)) {
         // get next command
         if (!get_next_cmd(cmd_index, cmd, false)) {
             // no more commands so return failure
@@ -832,13 +847,25 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
         return false;
     }
 
+#if AP_MISSION_CMD_CACHE_ENABLED
+    Mission_Command *cached = nullptr;
+    if (_cmd_cache != nullptr) {
+        cached = &_cmd_cache[index % AP_MISSION_CMD_CACHE_SIZE];
+        if (cached->index == index) {
+            // copy all bytes so comparisons with operator== still work
+            memcpy((void *)&cmd, (const void *)cached, sizeof(cmd));
+            return true;
+        }
+    }
+#endif
+
     // ensure all bytes of cmd are zeroed
     cmd = {};
 
     // Find out proper location in memory by using the start_byte position + the index
     // we can load a command, we don't process it yet
     // read WP position
-    const uint16_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
+    const uint32_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
 
     PackedContent packed_content {};
 
@@ -890,6 +917,12 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
     // set command's index to it's position in eeprom
     cmd.index = index;
 
+#if AP_MISSION_CMD_CACHE_ENABLED
+    if (cached != nullptr) {
+        memcpy((void *)cached, (const void *)&cmd, sizeof(cmd));
+    }
+#endif
+
     // return success
     return true;
 }
@@ -961,13 +994,16 @@ bool AP_Mission::write_cmd_to_storage(uint16_t index, const Mission_Command& cmd
     }
 
     // calculate where in storage the command should be placed
-    uint16_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
+    const uint32_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
 
+    // build the whole item and write it in one go so an upload
+    // touches each storage line once per item
+    uint8_t b[AP_MISSION_EEPROM_COMMAND_SIZE];
     if (cmd.id < 256) {
         // for commands below 256 we store up to 12 bytes
-        _storage.write_byte(pos_in_storage, cmd.id);
-        _storage.write_uint16(pos_in_storage+1, cmd.p1);
-        _storage.write_block(pos_in_storage+3, packed.bytes, 12);
+        b[0] = cmd.id;
+        memcpy(&b[1], &cmd.p1, 2);
+        memcpy(&b[3], packed.bytes, 12);
     } else {
         // if the command ID is above 256 we store a tag byte followed
         // by the 16 bit command ID. The tag byte is 1 for commands
@@ -978,11 +1014,21 @@ bool AP_Mission::write_cmd_to_storage(uint16_t index, const Mission_Command& cmd
         if (cmd.id == MAV_CMD_NAV_SCRIPT_TIME) {
             tag_byte = 1;
         }
-        _storage.write_byte(pos_in_storage, tag_byte);
-        _storage.write_uint16(pos_in_storage+1, cmd.id);
-        _storage.write_uint16(pos_in_storage+3, cmd.p1);
-        _storage.write_block(pos_in_storage+5, packed.bytes, 10);
+        b[0] = tag_byte;
+        memcpy(&b[1], &cmd.id, 2);
+        memcpy(&b[3], &cmd.p1, 2);
+        memcpy(&b[5], packed.bytes, 10);
     }
+    _storage.write_block(pos_in_storage, b, sizeof(b));
+
+#if AP_MISSION_CMD_CACHE_ENABLED
+    if (_cmd_cache != nullptr && _cmd_cache[index % AP_MISSION_CMD_CACHE_SIZE].index == index) {
+        // the stored command may not decode to exactly cmd, so read
+        // it back from storage next time
+        _cmd_cache[index % AP_MISSION_CMD_CACHE_SIZE].index = 0;
+    }
+    update_stop_index(index, cmd.id);
+#endif
 
     // remember when the mission last changed
     if (index != 0) {
@@ -2300,7 +2346,7 @@ bool AP_Mission::jump_to_tag(const uint16_t tag)
 uint16_t AP_Mission::get_index_of_jump_tag(const uint16_t tag) const
 {
     const auto count = num_commands();
-    for (uint16_t i = 1; i < count; i++) {
+    for (uint16_t i = next_stop_index(1); i < count; i = next_stop_index(i+1)) {
         if (get_command_id(i) != uint16_t(MAV_CMD_JUMP_TAG)) {
             continue;
         }
@@ -2931,7 +2977,7 @@ const char *AP_Mission::Mission_Command::type() const
  */
 uint16_t AP_Mission::get_command_id(uint16_t index) const
 {
-    const uint16_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
+    const uint32_t pos_in_storage = 4 + (index * AP_MISSION_EEPROM_COMMAND_SIZE);
     uint8_t b[3] {};
     if (!_storage.read_block(b, pos_in_storage, sizeof(b))) {
         return 0U;
@@ -2945,6 +2991,96 @@ uint16_t AP_Mission::get_command_id(uint16_t index) const
     return id;
 }
 
+#if AP_MISSION_CMD_CACHE_ENABLED
+/*
+  allocate the command cache and build the stop index from the
+  commands in storage
+ */
+void AP_Mission::init_cmd_cache()
+{
+    WITH_SEMAPHORE(_rsem);
+
+    if (_cmd_cache == nullptr) {
+        _cmd_cache = NEW_NOTHROW Mission_Command[AP_MISSION_CMD_CACHE_SIZE];
+    }
+    if (_cmd_cache != nullptr) {
+        for (uint16_t i=0; i<AP_MISSION_CMD_CACHE_SIZE; i++) {
+            _cmd_cache[i].index = 0;
+        }
+    }
+
+    if (_stop_index == nullptr && _commands_max > 0) {
+        _stop_index = NEW_NOTHROW uint32_t[(_commands_max+31U)/32U];
+    }
+    if (_stop_index == nullptr) {
+        return;
+    }
+    // only the commands in the mission are indexed, which keeps boot
+    // fast for large missions on microSD. Commands past the end of
+    // the index are looked at one by one
+    memset(_stop_index, 0, ((_commands_max+31U)/32U) * sizeof(uint32_t));
+    _stop_index_count = 1;
+    const uint16_t count = MIN(uint16_t(_cmd_total), _commands_max);
+    for (uint16_t i=1; i<count; i++) {
+        update_stop_index(i, get_command_id(i));
+    }
+}
+
+/*
+  record whether the command at index is one a search for the next
+  navigation command has to stop at
+ */
+void AP_Mission::update_stop_index(uint16_t index, uint16_t id)
+{
+    if (_stop_index == nullptr || index > _stop_index_count || index >= _commands_max) {
+        return;
+    }
+    if (index == _stop_index_count) {
+        // appending to the mission
+        _stop_index_count++;
+    }
+    Mission_Command cmd {};
+    cmd.id = id;
+    const uint32_t mask = 1U << (index % 32U);
+    if (is_nav_cmd(cmd) ||
+        id == MAV_CMD_DO_JUMP ||
+        id == MAV_CMD_DO_JUMP_TAG ||
+        id == MAV_CMD_JUMP_TAG) {
+        _stop_index[index/32U] |= mask;
+    } else {
+        _stop_index[index/32U] &= ~mask;
+    }
+}
+#endif // AP_MISSION_CMD_CACHE_ENABLED
+
+/*
+  return the first index at or after index that is a navigation, jump
+  or jump tag command, or the first index that is not in the stop
+  index. Without the index every command needs to be looked at
+ */
+uint16_t AP_Mission::next_stop_index(uint16_t index) const
+{
+#if AP_MISSION_CMD_CACHE_ENABLED
+    WITH_SEMAPHORE(_rsem);
+    if (_stop_index == nullptr) {
+        return index;
+    }
+    const uint16_t total = _cmd_total;
+    const uint16_t limit = MIN(total, _stop_index_count);
+    for (uint32_t i = index; i < limit; ) {
+        const uint32_t bits = _stop_index[i/32U] >> (i % 32U);
+        if (bits != 0) {
+            return MIN(i + __builtin_ctz(bits), total);
+        }
+        // nothing left in this word, move to the start of the next
+        i = (i | 31U) + 1U;
+    }
+    return MAX(index, limit);
+#else
+    return index;
+#endif
+}
+
 /*
   see if the mission contains a particular item
  */
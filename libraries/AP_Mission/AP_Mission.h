@@ -925,6 +925,7 @@ private:
 
 #if AP_SDCARD_STORAGE_ENABLED
     bool _failed_sdcard_storage;
+    uint16_t _prefetch_index;  // nav command the last storage prefetch was for
 #endif
 
     // fast call to get command ID of a mission index
@@ -939,6 +940,25 @@ private:
     // const functions
     static HAL_Semaphore _rsem;
 
+#if AP_MISSION_CMD_CACHE_ENABLED
+    // direct mapped cache of decoded commands, an entry is valid when
+    // its index matches the slot. Home (index 0) is never cached
+    Mission_Command *_cmd_cache;
+
+    // one bit per command in storage, set for navigation, jump and
+    // jump tag commands. Searches for the next navigation command
+    // skip straight over runs of clear bits
+    uint32_t *_stop_index;
+    uint16_t _stop_index_count;  // number of commands covered by _stop_index
+
+    void init_cmd_cache();
+    void update_stop_index(uint16_t index, uint16_t id);
+#endif
+
+    // return the first index at or after index that a search for a
+    // navigation command needs to look at
+    uint16_t next_stop_index(uint16_t index) const;
+
     // mission items common to all vehicles:
     bool start_command_do_aux_function(const AP_Mission::Mission_Command& cmd);
     bool start_command_do_gripper(const AP_Mission::Mission_Command& cmd);
@@ -7,3 +7,20 @@
 #ifndef AP_MISSION_NAV_PAYLOAD_PLACE_ENABLED
 #define AP_MISSION_NAV_PAYLOAD_PLACE_ENABLED 1
 #endif
+
+// keep recently read commands decoded in memory and an index of the
+// commands that mission advancement has to stop at
+#ifndef AP_MISSION_CMD_CACHE_ENABLED
+#define AP_MISSION_CMD_CACHE_ENABLED AP_MISSION_ENABLED && (HAL_MEM_CLASS >= HAL_MEM_CLASS_500)
+#endif
+
+// number of decoded commands held in the cache
+#ifndef AP_MISSION_CMD_CACHE_SIZE
+#define AP_MISSION_CMD_CACHE_SIZE 64
+#endif
+
+// number of commands after the current one to read ahead when the
+// mission is paged from microSD
+#ifndef AP_MISSION_SDCARD_PREFETCH_COMMANDS
+#define AP_MISSION_SDCARD_PREFETCH_COMMANDS 64
+#endif
@@ -55,6 +55,7 @@ bool AP_MotorsMatrix::init(uint8_t expected_num_motors)
         }
     }
 
+    update_enabled_motors();
     set_initialised_ok(expected_num_motors == num_motors);
 
     if (!initialised_ok()) {
@@ -164,21 +165,22 @@ void AP_MotorsMatrix::output_to_motors()
             break;
         case SpoolState::SPOOLING_UP:
         case SpoolState::THROTTLE_UNLIMITED:
-        case SpoolState::SPOOLING_DOWN:
+        case SpoolState::SPOOLING_DOWN: {
             // set motor output based on thrust requests
-            for (i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-                if (motor_enabled[i]) {
-                    set_actuator_with_slew(_actuator[i], thr_lin.thrust_to_actuator(_thrust_rpyt_out[i]));
-                }
+            float actuator[AP_MOTORS_MAX_NUM_MOTORS];
+            thr_lin.thrust_to_actuator(_thrust_rpyt_out, actuator, _enabled_motors, _num_enabled_motors);
+            for (uint8_t j = 0; j < _num_enabled_motors; j++) {
+                const uint8_t m = _enabled_motors[j];
+                set_actuator_with_slew(_actuator[m], actuator[m]);
             }
             break;
+        }
     }
 
     // convert output to PWM and send to each motor
-    for (i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            rc_write(i, output_to_pwm(_actuator[i]));
-        }
+    for (uint8_t j = 0; j < _num_enabled_motors; j++) {
+        const uint8_t m = _enabled_motors[j];
+        rc_write(m, output_to_pwm(_actuator[m]));
     }
 }
 
@@ -274,26 +276,25 @@ void AP_MotorsMatrix::output_armed_stabilizing()
     // calculate amount of yaw we can fit into the throttle range
     // this is always equal to or less than the requested yaw from the pilot or rate controller
     float yaw_allowed = 1.0f; // amount of yaw we can fit in
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            // calculate the thrust outputs for roll and pitch
-            _thrust_rpyt_out[i] = roll_thrust * _roll_factor[i] + pitch_thrust * _pitch_factor[i];
-
-            // Check the maximum yaw control that can be used on this channel
-            // Exclude any lost motors if thrust boost is enabled
-            if (!is_zero(_yaw_factor[i]) && (!_thrust_boost || i != _motor_lost_index)) {
-                const float thrust_rp_best_throttle = throttle_thrust_best_rpy + _thrust_rpyt_out[i];
-                float motor_room;
-                if (is_positive(yaw_thrust * _yaw_factor[i])) {
-                    // room to upper limit
-                    motor_room = 1.0 - thrust_rp_best_throttle;
-                } else {
-                    // room to lower limit
-                    motor_room = thrust_rp_best_throttle;
-                }
-                const float motor_yaw_allowed = MAX(motor_room, 0.0)/fabsf(_yaw_factor[i]);
-                yaw_allowed = MIN(yaw_allowed, motor_yaw_allowed);
+    for (uint8_t j = 0; j < _num_enabled_motors; j++) {
+        const uint8_t i = _enabled_motors[j];
+        // calculate the thrust outputs for roll and pitch
+        _thrust_rpyt_out[i] = roll_thrust * _roll_factor[i] + pitch_thrust * _pitch_factor[i];
+
+        // Check the maximum yaw control that can be used on this channel
+        // Exclude any lost motors if thrust boost is enabled
+        if (!is_zero(_yaw_factor[i]) && (!_thrust_boost || i != _motor_lost_index)) {
+            const float thrust_rp_best_throttle = throttle_thrust_best_rpy + _thrust_rpyt_out[i];
+            float motor_room;
+            if (is_positive(yaw_thrust * _yaw_factor[i])) {
+                // room to upper limit
+                motor_room = 1.0 - thrust_rp_best_throttle;
+            } else {
+                // room to lower limit
+                motor_room = thrust_rp_best_throttle;
             }
+            const float motor_yaw_allowed = MAX(motor_room, 0.0)/fabsf(_yaw_factor[i]);
+            yaw_allowed = MIN(yaw_allowed, motor_yaw_allowed);
         }
     }
 
@@ -333,19 +334,18 @@ void AP_MotorsMatrix::output_armed_stabilizing()
     // add yaw control to thrust outputs
     float rpy_low = 1.0f;   // lowest thrust value
     float rpy_high = -1.0f; // highest thrust value
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            _thrust_rpyt_out[i] = _thrust_rpyt_out[i] + yaw_thrust * _yaw_factor[i];
+    for (uint8_t j = 0; j < _num_enabled_motors; j++) {
+        const uint8_t i = _enabled_motors[j];
+        _thrust_rpyt_out[i] = _thrust_rpyt_out[i] + yaw_thrust * _yaw_factor[i];
 
-            // record lowest roll + pitch + yaw command
-            if (_thrust_rpyt_out[i] < rpy_low) {
-                rpy_low = _thrust_rpyt_out[i];
-            }
-            // record highest roll + pitch + yaw command
-            // Exclude any lost motors if thrust boost is enabled
-            if (_thrust_rpyt_out[i] > rpy_high && (!_thrust_boost || i != _motor_lost_index)) {
-                rpy_high = _thrust_rpyt_out[i];
-            }
+        // record lowest roll + pitch + yaw command
+        if (_thrust_rpyt_out[i] < rpy_low) {
+            rpy_low = _thrust_rpyt_out[i];
+        }
+        // record highest roll + pitch + yaw command
+        // Exclude any lost motors if thrust boost is enabled
+        if (_thrust_rpyt_out[i] > rpy_high && (!_thrust_boost || i != _motor_lost_index)) {
+            rpy_high = _thrust_rpyt_out[i];
         }
     }
     // Include the lost motor scaled by _thrust_boost_ratio to smoothly transition this motor in and out of the calculation
@@ -391,10 +391,9 @@ void AP_MotorsMatrix::output_armed_stabilizing()
 
     // add scaled roll, pitch, constrained yaw and throttle for each motor
     const float throttle_thrust_best_plus_adj = throttle_thrust_best_rpy + thr_adj;
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            _thrust_rpyt_out[i] = (throttle_thrust_best_plus_adj * _throttle_factor[i]) + (rpy_scale * _thrust_rpyt_out[i]);
-        }
+    for (uint8_t j = 0; j < _num_enabled_motors; j++) {
+        const uint8_t i = _enabled_motors[j];
+        _thrust_rpyt_out[i] = (throttle_thrust_best_plus_adj * _throttle_factor[i]) + (rpy_scale * _thrust_rpyt_out[i]);
     }
 
     // determine throttle thrust for harmonic notch
@@ -417,26 +416,20 @@ void AP_MotorsMatrix::check_for_failed_motor(float throttle_thrust_best_plus_adj
 {
     // record filtered and scaled thrust output for motor loss monitoring purposes
     float alpha = _dt / (_dt + 0.5f);
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            _thrust_rpyt_out_filt[i] += alpha * (_thrust_rpyt_out[i] - _thrust_rpyt_out_filt[i]);
-        }
-    }
-
     float rpyt_high = 0.0f;
     float rpyt_sum = 0.0f;
-    uint8_t number_motors = 0.0f;
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            number_motors += 1;
-            rpyt_sum += _thrust_rpyt_out_filt[i];
-            // record highest filtered thrust command
-            if (_thrust_rpyt_out_filt[i] > rpyt_high) {
-                rpyt_high = _thrust_rpyt_out_filt[i];
-                // hold motor lost index constant while thrust boost is active
-                if (!_thrust_boost) {
-                    _motor_lost_index = i;
-                }
+    const uint8_t number_motors = _num_enabled_motors;
+    for (uint8_t j = 0; j < _num_enabled_motors; j++) {
+        const uint8_t i = _enabled_motors[j];
+        _thrust_rpyt_out_filt[i] += alpha * (_thrust_rpyt_out[i] - _thrust_rpyt_out_filt[i]);
+
+        rpyt_sum += _thrust_rpyt_out_filt[i];
+        // record highest filtered thrust command
+        if (_thrust_rpyt_out_filt[i] > rpyt_high) {
+            rpyt_high = _thrust_rpyt_out_filt[i];
+            // hold motor lost index constant while thrust boost is active
+            if (!_thrust_boost) {
+                _motor_lost_index = i;
             }
         }
     }
@@ -557,6 +550,17 @@ void AP_MotorsMatrix::remove_motor(int8_t motor_num)
     }
 }
 
+// update_enabled_motors - record the list of enabled motors used by the mixer
+void AP_MotorsMatrix::update_enabled_motors()
+{
+    _num_enabled_motors = 0;
+    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
+        if (motor_enabled[i]) {
+            _enabled_motors[_num_enabled_motors++] = i;
+        }
+    }
+}
+
 void AP_MotorsMatrix::add_motors(const struct MotorDef *motors, uint8_t num_motors)
 {
     for (uint8_t i=0; i<num_motors; i++) {
@@ -1299,6 +1303,7 @@ void AP_MotorsMatrix::setup_motors(motor_frame_class frame_class, motor_frame_ty
     if (!success) {
         _frame_class_string = "UNSUPPORTED";
     }
+    update_enabled_motors();
     set_initialised_ok(success);
 }
 
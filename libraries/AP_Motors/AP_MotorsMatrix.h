@@ -107,7 +107,7 @@ public:
 
 protected:
     // output - sends commands to the motors
-    void                output_armed_stabilizing() override;
+    void                output_armed_stabilizing() override __FASTRAMFUNC__;
 
     // check for failed motor
     void                check_for_failed_motor(float throttle_thrust_best);
@@ -145,6 +145,12 @@ protected:
     float               _thrust_rpyt_out[AP_MOTORS_MAX_NUM_MOTORS]; // combined roll, pitch, yaw and throttle outputs to motors in 0~1 range
     uint8_t             _test_order[AP_MOTORS_MAX_NUM_MOTORS];  // order of the motors in the test sequence
 
+    // compact list of enabled motors so the mixer does not need to check every output
+    // must be updated with update_enabled_motors once the motors have been added
+    void                update_enabled_motors();
+    uint8_t             _enabled_motors[AP_MOTORS_MAX_NUM_MOTORS];
+    uint8_t             _num_enabled_motors;
+
     // motor failure handling
     float               _thrust_rpyt_out_filt[AP_MOTORS_MAX_NUM_MOTORS];    // filtered thrust outputs with 1 second time constant
     uint8_t             _motor_lost_index;  // index number of the lost motor
@@ -290,6 +290,7 @@ bool AP_MotorsMatrix_6DoF_Scripting::init(uint8_t expected_num_motors) {
         }
     }
 
+    update_enabled_motors();
     set_initialised_ok(expected_num_motors == num_motors);
 
     if (!initialised_ok()) {
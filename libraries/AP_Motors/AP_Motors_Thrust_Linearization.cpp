@@ -104,6 +104,38 @@ float Thrust_Linearization::thrust_to_actuator(float thrust_in) const
     return spin_min + (spin_max - spin_min) * apply_thrust_curve_and_volt_scaling(thrust_in);
 }
 
+// converts the desired thrust of each listed motor to linearized actuator output in a range of 0~1
+// this is the same calculation as thrust_to_actuator and apply_thrust_curve_and_volt_scaling but
+// the battery scale and curve constants are calculated once rather than once per motor
+void Thrust_Linearization::thrust_to_actuator(const float thrust_in[], float actuator_out[], const uint8_t motor_index[], uint8_t num_motors) const
+{
+    float battery_scale = 1.0;
+    if (is_positive(batt_voltage_filt.get())) {
+        battery_scale = 1.0 / batt_voltage_filt.get();
+    }
+    const float spin_range = spin_max - spin_min;
+    const float thrust_curve_expo = constrain_float(curve_expo, -1.0, 1.0);
+    if (is_zero(thrust_curve_expo)) {
+        // zero expo means linear, avoid floating point exception for small values
+        const float linear_scale = spin_range * lift_max * battery_scale;
+        for (uint8_t i = 0; i < num_motors; i++) {
+            const uint8_t m = motor_index[i];
+            actuator_out[m] = spin_min + linear_scale * constrain_float(thrust_in[m], 0.0, 1.0);
+        }
+        return;
+    }
+    const float curve_offset = thrust_curve_expo - 1.0;
+    const float curve_sq = sq(1.0 - thrust_curve_expo);
+    const float curve_gain = 4.0 * thrust_curve_expo * lift_max;
+    const float curve_scale = battery_scale / (2.0 * thrust_curve_expo);
+    for (uint8_t i = 0; i < num_motors; i++) {
+        const uint8_t m = motor_index[i];
+        const float thrust = constrain_float(thrust_in[m], 0.0, 1.0);
+        const float throttle = (curve_offset + safe_sqrt(curve_sq + curve_gain * thrust)) * curve_scale;
+        actuator_out[m] = spin_min + spin_range * constrain_float(throttle, 0.0, 1.0);
+    }
+}
+
 // inverse of above, tested with AP_Motors/examples/expo_inverse_test
 // used to calculate equivelent motor throttle level to direct ouput, used in tailsitter transtions
 float Thrust_Linearization::actuator_to_thrust(float actuator) const
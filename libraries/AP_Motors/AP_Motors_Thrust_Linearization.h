@@ -23,6 +23,10 @@ public:
     // Inverse of above
     float actuator_to_thrust(float actuator) const;
 
+    // Converts the desired thrust of each listed motor to linearized actuator output in a range of 0~1
+    // equivalent to calling thrust_to_actuator for each motor but the curve constants are only calculated once
+    void thrust_to_actuator(const float thrust_in[], float actuator_out[], const uint8_t motor_index[], uint8_t num_motors) const;
+
     // Update_lift_max_from_batt_voltage - used for voltage compensation
     void update_lift_max_from_batt_voltage();
 
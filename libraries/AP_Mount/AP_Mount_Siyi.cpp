@@ -21,6 +21,7 @@ extern const AP_HAL::HAL& hal;
 #define AP_MOUNT_SIYI_YAW_P         1.50    // yaw controller P gain (converts yaw angle error to target rate)
 #define AP_MOUNT_SIYI_TIMEOUT_MS    1000    // timeout for health and rangefinder readings
 #define AP_MOUNT_SIYI_THERM_TIMEOUT_MS  3000// timeout for temp min/max readings
+#define AP_MOUNT_SIYI_ATTITUDE_SEND_MS  20  // vehicle attitude and rates are sent to the gimbal at 50Hz
 
 #define AP_MOUNT_SIYI_DEBUG 0
 #define debug(fmt, args ...) do { if (AP_MOUNT_SIYI_DEBUG) { GCS_SEND_TEXT(MAV_SEVERITY_INFO, "Siyi: " fmt, ## args); } } while (0)
@@ -91,10 +92,10 @@ void AP_Mount_Siyi::update()
     request_thermal_minmax();
 #endif
 
-    // send attitude to gimbal at 10Hz
-    if (now_ms - _last_attitude_send_ms > 100) {
-        _last_attitude_send_ms = now_ms;
-        send_attitude_position();
+    // send position to gimbal at 10Hz
+    if (now_ms - _last_position_send_ms > 100) {
+        _last_position_send_ms = now_ms;
+        send_position();
     }
 
     // run zoom control
@@ -192,6 +193,22 @@ bool AP_Mount_Siyi::get_attitude_quaternion(Quaternion& att_quat)
     return true;
 }
 
+// send the vehicle attitude and body rates to the gimbal from the fast
+// loop so its stabilisation feed-forward sees vehicle motion with the
+// least delay. The gimbal has no use for samples faster than 50Hz
+void AP_Mount_Siyi::update_fast()
+{
+    if (!_initialised) {
+        return;
+    }
+
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _last_attitude_send_ms >= AP_MOUNT_SIYI_ATTITUDE_SEND_MS) {
+        _last_attitude_send_ms = now_ms;
+        send_attitude();
+    }
+}
+
 // reading incoming packets from gimbal and confirm they are of the correct format
 // results are held in the _parsed_msg structure
 void AP_Mount_Siyi::read_incoming_packets()
@@ -205,111 +222,116 @@ void AP_Mount_Siyi::read_incoming_packets()
     // flag to allow cases below to reset parser state
     bool reset_parser = false;
 
-    // process bytes received
-    for (int16_t i = 0; i < nbytes; i++) {
-        uint8_t b;
-        if (!_uart->read(b)) {
-            continue;
-        }
-
-        _msg_buff[_msg_buff_len++] = b;
-
-        // protect against overly long messages
-        if (_msg_buff_len >= AP_MOUNT_SIYI_PACKETLEN_MAX) {
-            reset_parser = true;
+    // process bytes received, a block at a time
+    uint8_t buf[32];
+    while (nbytes > 0) {
+        const ssize_t nread = _uart->read(buf, MIN(nbytes, int16_t(sizeof(buf))));
+        if (nread <= 0) {
+            break;
         }
+        nbytes -= nread;
+        for (ssize_t i = 0; i < nread; i++) {
+            const uint8_t b = buf[i];
 
-        // process byte depending upon current state
-        switch (_parsed_msg.state) {
+            _msg_buff[_msg_buff_len++] = b;
 
-        case ParseState::WAITING_FOR_HEADER_LOW:
-            if (b == AP_MOUNT_SIYI_HEADER1) {
-                _parsed_msg.state = ParseState::WAITING_FOR_HEADER_HIGH;
-            } else {
+            // protect against overly long messages
+            if (_msg_buff_len >= AP_MOUNT_SIYI_PACKETLEN_MAX) {
                 reset_parser = true;
             }
-            break;
 
-        case ParseState::WAITING_FOR_HEADER_HIGH:
-            if (b == AP_MOUNT_SIYI_HEADER2) {
-                _parsed_msg.state = ParseState::WAITING_FOR_CTRL;
-            } else {
-                reset_parser = true;
-            }
-            break;
+            // process byte depending upon current state
+            switch (_parsed_msg.state) {
 
-        case ParseState::WAITING_FOR_CTRL:
-            _parsed_msg.state = ParseState::WAITING_FOR_DATALEN_LOW;
-            break;
+            case ParseState::WAITING_FOR_HEADER_LOW:
+                if (b == AP_MOUNT_SIYI_HEADER1) {
+                    _parsed_msg.state = ParseState::WAITING_FOR_HEADER_HIGH;
+                } else {
+                    reset_parser = true;
+                }
+                break;
 
-        case ParseState::WAITING_FOR_DATALEN_LOW:
-            _parsed_msg.data_len = b;
-            _parsed_msg.state = ParseState::WAITING_FOR_DATALEN_HIGH;
-            break;
+            case ParseState::WAITING_FOR_HEADER_HIGH:
+                if (b == AP_MOUNT_SIYI_HEADER2) {
+                    _parsed_msg.state = ParseState::WAITING_FOR_CTRL;
+                } else {
+                    reset_parser = true;
+                }
+                break;
 
-        case ParseState::WAITING_FOR_DATALEN_HIGH:
-            _parsed_msg.data_len |= ((uint16_t)b << 8);
-            // sanity check data length
-            if (_parsed_msg.data_len <= AP_MOUNT_SIYI_DATALEN_MAX) {
-                _parsed_msg.state = ParseState::WAITING_FOR_SEQ_LOW;
-            } else {
-                reset_parser = true;
-                debug("data len too large:%u (>%u)", (unsigned)_parsed_msg.data_len, (unsigned)AP_MOUNT_SIYI_DATALEN_MAX);
-            }
-            break;
+            case ParseState::WAITING_FOR_CTRL:
+                _parsed_msg.state = ParseState::WAITING_FOR_DATALEN_LOW;
+                break;
 
-        case ParseState::WAITING_FOR_SEQ_LOW:
-            _parsed_msg.state = ParseState::WAITING_FOR_SEQ_HIGH;
-            break;
+            case ParseState::WAITING_FOR_DATALEN_LOW:
+                _parsed_msg.data_len = b;
+                _parsed_msg.state = ParseState::WAITING_FOR_DATALEN_HIGH;
+                break;
 
-        case ParseState::WAITING_FOR_SEQ_HIGH:
-            _parsed_msg.state = ParseState::WAITING_FOR_CMDID;
-            break;
+            case ParseState::WAITING_FOR_DATALEN_HIGH:
+                _parsed_msg.data_len |= ((uint16_t)b << 8);
+                // sanity check data length
+                if (_parsed_msg.data_len <= AP_MOUNT_SIYI_DATALEN_MAX) {
+                    _parsed_msg.state = ParseState::WAITING_FOR_SEQ_LOW;
+                } else {
+                    reset_parser = true;
+                    debug("data len too large:%u (>%u)", (unsigned)_parsed_msg.data_len, (unsigned)AP_MOUNT_SIYI_DATALEN_MAX);
+                }
+                break;
 
-        case ParseState::WAITING_FOR_CMDID:
-            _parsed_msg.command_id = b;
-            _parsed_msg.data_bytes_received = 0;
-            if (_parsed_msg.data_len > 0) {
-                _parsed_msg.state = ParseState::WAITING_FOR_DATA;
-            } else {
-                _parsed_msg.state = ParseState::WAITING_FOR_CRC_LOW;
-            }
-            break;
+            case ParseState::WAITING_FOR_SEQ_LOW:
+                _parsed_msg.state = ParseState::WAITING_FOR_SEQ_HIGH;
+                break;
 
-        case ParseState::WAITING_FOR_DATA:
-            _parsed_msg.data_bytes_received++;
-            if (_parsed_msg.data_bytes_received >= _parsed_msg.data_len) {
-                _parsed_msg.state = ParseState::WAITING_FOR_CRC_LOW;
-            }
-            break;
+            case ParseState::WAITING_FOR_SEQ_HIGH:
+                _parsed_msg.state = ParseState::WAITING_FOR_CMDID;
+                break;
 
-        case ParseState::WAITING_FOR_CRC_LOW:
-            _parsed_msg.crc16 = b;
-            _parsed_msg.state = ParseState::WAITING_FOR_CRC_HIGH;
-            break;
+            case ParseState::WAITING_FOR_CMDID:
+                _parsed_msg.command_id = b;
+                _parsed_msg.data_bytes_received = 0;
+                if (_parsed_msg.data_len > 0) {
+                    _parsed_msg.state = ParseState::WAITING_FOR_DATA;
+                } else {
+                    _parsed_msg.state = ParseState::WAITING_FOR_CRC_LOW;
+                }
+                break;
+
+            case ParseState::WAITING_FOR_DATA:
+                _parsed_msg.data_bytes_received++;
+                if (_parsed_msg.data_bytes_received >= _parsed_msg.data_len) {
+                    _parsed_msg.state = ParseState::WAITING_FOR_CRC_LOW;
+                }
+                break;
+
+            case ParseState::WAITING_FOR_CRC_LOW:
+                _parsed_msg.crc16 = b;
+                _parsed_msg.state = ParseState::WAITING_FOR_CRC_HIGH;
+                break;
 
-        case ParseState::WAITING_FOR_CRC_HIGH:
-            _parsed_msg.crc16 |= ((uint16_t)b << 8);
+            case ParseState::WAITING_FOR_CRC_HIGH:
+                _parsed_msg.crc16 |= ((uint16_t)b << 8);
 
-            // check crc
-            const uint16_t expected_crc = crc16_ccitt(_msg_buff, _msg_buff_len-2, 0);
-            if (expected_crc == _parsed_msg.crc16) {
-                // successfully received a message, do something with it
-                process_packet();
+                // check crc
+                const uint16_t expected_crc = crc16_ccitt(_msg_buff, _msg_buff_len-2, 0);
+                if (expected_crc == _parsed_msg.crc16) {
+                    // successfully received a message, do something with it
+                    process_packet();
 #if AP_MOUNT_SIYI_DEBUG
-            } else {
-                debug("crc expected:%x got:%x", (unsigned)expected_crc, (unsigned)_parsed_msg.crc16);
+                } else {
+                    debug("crc expected:%x got:%x", (unsigned)expected_crc, (unsigned)_parsed_msg.crc16);
 #endif
+                }
+                reset_parser = true;
+                break;
             }
-            reset_parser = true;
-            break;
-        }
 
-        // handle reset of parser
-        if (reset_parser) {
-            _parsed_msg.state = ParseState::WAITING_FOR_HEADER_LOW;
-            _msg_buff_len = 0;
-            reset_parser = false;
+            // handle reset of parser
+            if (reset_parser) {
+                _parsed_msg.state = ParseState::WAITING_FOR_HEADER_LOW;
+                _msg_buff_len = 0;
+                reset_parser = false;
+            }
         }
     }
 }
@@ -1254,9 +1276,9 @@ void AP_Mount_Siyi::request_thermal_minmax()
 #endif
 
 /*
-  send ArduPilot attitude and position to gimbal
+  send ArduPilot attitude and body rates to gimbal
 */
-void AP_Mount_Siyi::send_attitude_position(void)
+void AP_Mount_Siyi::send_attitude(void)
 {
     const auto &ahrs = AP::ahrs();
     struct {
@@ -1278,8 +1300,14 @@ void AP_Mount_Siyi::send_attitude_position(void)
     attitude.yawspeed = gyro.z;
 
     send_packet(SiyiCommandId::EXTERNAL_ATTITUDE, (const uint8_t *)&attitude, sizeof(attitude));
+}
 
-    // send location and velocity
+/*
+  send ArduPilot location and velocity to gimbal
+*/
+void AP_Mount_Siyi::send_position(void)
+{
+    const auto &ahrs = AP::ahrs();
     struct {
         uint32_t time_boot_ms;
         int32_t lat, lon;
@@ -1295,7 +1323,7 @@ void AP_Mount_Siyi::send_attitude_position(void)
     }
     AP::gps().get_undulation(undulation);
 
-    position.time_boot_ms = now_ms;
+    position.time_boot_ms = AP_HAL::millis();
     position.lat = loc.lat;
     position.lon = loc.lng;
     position.alt_msl = loc.alt;
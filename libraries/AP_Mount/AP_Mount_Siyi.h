@@ -44,6 +44,9 @@ public:
     // update mount position - should be called periodically
     void update() override;
 
+    // send attitude and rates to the gimbal, called at the main loop rate
+    void update_fast() override;
+
     // return true if healthy
     bool healthy() const override;
 
@@ -358,7 +361,9 @@ private:
 
     // sending of attitude and position to gimbal
     uint32_t _last_attitude_send_ms;
-    void send_attitude_position(void);
+    uint32_t _last_position_send_ms;
+    void send_attitude(void);
+    void send_position(void);
 
     // hardware lookup table indexed by HardwareModel enum values (see above)
     struct HWInfo {
@@ -67,6 +67,16 @@ void MultiHeap::destroy(void)
     if (!available()) {
         return;
     }
+#if AP_MULTIHEAP_POOL_ENABLED
+    // give the pages back so the heaps are empty when destroyed
+    while (pool_pages != nullptr) {
+        PoolPage *next = pool_pages->next;
+        heap_free(pool_pages);
+        pool_pages = next;
+    }
+    memset(pool_free_list, 0, sizeof(pool_free_list));
+    pool_stats = {};
+#endif
     for (uint8_t i=0; i<num_heaps; i++) {
         if (heaps[i].hp != nullptr) {
             heap_destroy(heaps[i].hp);
@@ -87,13 +97,24 @@ bool MultiHeap::available(void) const
 }
 
 /*
-  allocate memory from a heap
+  allocate memory from a heap, or from the pool for small allocations
  */
 void *MultiHeap::allocate(uint32_t size)
 {
     if (!available() || size == 0) {
         return nullptr;
     }
+#if AP_MULTIHEAP_POOL_ENABLED
+    const uint8_t c = pool_class(size);
+    if (c < POOL_NUM_CLASSES) {
+        return pool_allocate(c);
+    }
+#endif
+    return allocate_from_heaps(size);
+}
+
+void *MultiHeap::allocate_from_heaps(uint32_t size)
+{
     for (uint8_t i=0; i<num_heaps; i++) {
         if (heaps[i].hp == nullptr) {
             break;
@@ -167,6 +188,32 @@ void MultiHeap::deallocate(void *ptr)
     if (!available() || ptr == nullptr) {
         return;
     }
+#if AP_MULTIHEAP_POOL_ENABLED
+    uint8_t c;
+    if (pool_lookup(ptr, c)) {
+        pool_free(ptr, c);
+        return;
+    }
+#endif
+    heap_free(ptr);
+}
+
+/*
+  free memory of a known size, which avoids the search for the pool
+  page in deallocate()
+ */
+void MultiHeap::deallocate_size(void *ptr, uint32_t size)
+{
+    if (!available() || ptr == nullptr) {
+        return;
+    }
+#if AP_MULTIHEAP_POOL_ENABLED
+    const uint8_t c = pool_class(size);
+    if (c < POOL_NUM_CLASSES) {
+        pool_free(ptr, c);
+        return;
+    }
+#endif
     heap_free(ptr);
 }
 
@@ -177,9 +224,16 @@ void MultiHeap::deallocate(void *ptr)
 void *MultiHeap::change_size(void *ptr, uint32_t old_size, uint32_t new_size)
 {
     if (new_size == 0) {
-        deallocate(ptr);
+        deallocate_size(ptr, old_size);
         return nullptr;
     }
+#if AP_MULTIHEAP_POOL_ENABLED
+    if (ptr != nullptr && pool_class(old_size) < POOL_NUM_CLASSES &&
+        pool_class(old_size) == pool_class(new_size)) {
+        // the pool object already has room for the new size
+        return ptr;
+    }
+#endif
     /*
       we don't want to require the underlying allocation system to
       support realloc() and we also want to be able to handle the case
@@ -199,8 +253,83 @@ void *MultiHeap::change_size(void *ptr, uint32_t old_size, uint32_t new_size)
         return nullptr;
     }
     memcpy(newp, ptr, MIN(old_size, new_size));
-    deallocate(ptr);
+    deallocate_size(ptr, old_size);
     return newp;
 }
 
+#if AP_MULTIHEAP_POOL_ENABLED
+/*
+  allocate an object of size class c from the pool
+ */
+void *MultiHeap::pool_allocate(uint8_t c)
+{
+    // objects after the page header keep the 8 byte alignment Lua needs
+    static_assert(sizeof(PoolPage) % 8 == 0, "PoolPage must keep objects aligned");
+
+    const uint16_t obj_size = (c+1) * POOL_CLASS_SIZE;
+    if (pool_free_list[c] == nullptr) {
+        // carve a new page into objects of this class. If the heaps
+        // can't give us a page then try for a page of one object
+        uint16_t page_size = POOL_PAGE_SIZE;
+        uint8_t *page = (uint8_t *)allocate_from_heaps(page_size);
+        if (page == nullptr) {
+            page_size = sizeof(PoolPage) + obj_size;
+            page = (uint8_t *)allocate_from_heaps(page_size);
+            if (page == nullptr) {
+                return nullptr;
+            }
+        }
+        PoolPage *hdr = (PoolPage *)page;
+        hdr->next = pool_pages;
+        hdr->size = page_size;
+        hdr->size_class = c;
+        pool_pages = hdr;
+        pool_stats.pool_bytes += page_size;
+        for (uint16_t ofs = sizeof(PoolPage); ofs + obj_size <= page_size; ofs += obj_size) {
+            PoolObject *obj = (PoolObject *)&page[ofs];
+            obj->next = pool_free_list[c];
+            pool_free_list[c] = obj;
+        }
+    }
+    PoolObject *obj = pool_free_list[c];
+    pool_free_list[c] = obj->next;
+    pool_stats.in_use_bytes += obj_size;
+    pool_stats.allocations++;
+    return obj;
+}
+
+/*
+  return an object of size class c to the pool
+ */
+void MultiHeap::pool_free(void *ptr, uint8_t c)
+{
+    PoolObject *obj = (PoolObject *)ptr;
+    obj->next = pool_free_list[c];
+    pool_free_list[c] = obj;
+    pool_stats.in_use_bytes -= (c+1) * POOL_CLASS_SIZE;
+}
+
+/*
+  find the page holding ptr. This is only needed by deallocate(), as
+  change_size() is given the size of the object
+ */
+bool MultiHeap::pool_lookup(const void *ptr, uint8_t &c) const
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+    for (const PoolPage *page = pool_pages; page != nullptr; page = page->next) {
+        const uint8_t *start = (const uint8_t *)page;
+        if (p > start && p < start + page->size) {
+            c = page->size_class;
+            return true;
+        }
+    }
+    return false;
+}
+
+void MultiHeap::get_pool_stats(PoolStats &stats) const
+{
+    stats = pool_stats;
+}
+#endif // AP_MULTIHEAP_POOL_ENABLED
+
 #endif // ENABLE_HEAP
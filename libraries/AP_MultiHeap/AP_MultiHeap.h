@@ -14,6 +14,15 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/*
+  small allocations come from a pool of fixed size objects with a
+  free list per size class, which is much quicker than the heaps and
+  stops the many small objects of a script fragmenting them
+ */
+#ifndef AP_MULTIHEAP_POOL_ENABLED
+#define AP_MULTIHEAP_POOL_ENABLED 1
+#endif
+
 class MultiHeap {
 public:
     /*
@@ -35,6 +44,15 @@ public:
     // allocation API
     void *change_size(void *ptr, uint32_t old_size, uint32_t new_size);
 
+#if AP_MULTIHEAP_POOL_ENABLED
+    struct PoolStats {
+        uint32_t pool_bytes;    // memory taken from the heaps by the pool
+        uint32_t in_use_bytes;  // memory of the pool handed out
+        uint32_t allocations;   // number of allocations from the pool
+    };
+    void get_pool_stats(PoolStats &stats) const;
+#endif
+
     /*
       get the size that we have expanded to. Used by error reporting in scripting
      */
@@ -59,6 +77,47 @@ private:
     // re-use memory when possible
     bool last_failed;
 
+#if AP_MULTIHEAP_POOL_ENABLED
+    // allocations up to POOL_CLASS_SIZE*POOL_NUM_CLASSES bytes are
+    // rounded up to a multiple of POOL_CLASS_SIZE and carved from
+    // pages allocated on the heaps. Pages are not given back to the
+    // heaps until they are destroyed
+    static constexpr uint8_t POOL_CLASS_SIZE = 16;
+    static constexpr uint8_t POOL_NUM_CLASSES = 4;
+    static constexpr uint16_t POOL_PAGE_SIZE = 512;
+
+    struct PoolObject {
+        PoolObject *next;
+    };
+    // header at the start of each page, so deallocate() can tell
+    // which pointers belong to the pool
+    struct PoolPage {
+        PoolPage *next;
+        uint16_t size;
+        uint8_t size_class;
+    };
+    PoolObject *pool_free_list[POOL_NUM_CLASSES];
+    PoolPage *pool_pages;
+    PoolStats pool_stats;
+
+    // size class of an allocation, POOL_NUM_CLASSES if not for the pool
+    static uint8_t pool_class(uint32_t size) {
+        if (size == 0 || size > POOL_CLASS_SIZE*POOL_NUM_CLASSES) {
+            return POOL_NUM_CLASSES;
+        }
+        return (size-1) / POOL_CLASS_SIZE;
+    }
+    void *pool_allocate(uint8_t c);
+    void pool_free(void *ptr, uint8_t c);
+    // true if ptr is a pool object, with its size class in c
+    bool pool_lookup(const void *ptr, uint8_t &c) const;
+#endif
+
+    // allocate without using the pool
+    void *allocate_from_heaps(uint32_t size);
+
+    // free an allocation of a known size
+    void deallocate_size(void *ptr, uint32_t size);
 
     /*
       low level allocation functions
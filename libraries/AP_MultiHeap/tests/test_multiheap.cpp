@@ -54,4 +54,61 @@ TEST(MultiHeap, Tests)
     delete[] allocs;
 }
 
+#if AP_MULTIHEAP_POOL_ENABLED
+TEST(MultiHeap, Pool)
+{
+    static MultiHeap h;
+
+    EXPECT_TRUE(h.create(20000, 1, false, 0));
+
+    MultiHeap::PoolStats stats;
+    uint8_t *p1 = (uint8_t *)h.change_size(nullptr, 0, 10);
+    uint8_t *p2 = (uint8_t *)h.change_size(nullptr, 0, 10);
+    ASSERT_TRUE(p1 != nullptr && p2 != nullptr);
+    EXPECT_NE(p1, p2);
+    h.get_pool_stats(stats);
+    EXPECT_EQ(stats.in_use_bytes, 32U);
+    EXPECT_EQ(stats.allocations, 2U);
+
+    // growing within the size class keeps the object
+    EXPECT_EQ(h.change_size(p1, 10, 16), p1);
+
+    // growing past it moves the object, keeping the contents
+    memset(p1, 0x5a, 16);
+    uint8_t *p3 = (uint8_t *)h.change_size(p1, 16, 40);
+    ASSERT_TRUE(p3 != nullptr);
+    EXPECT_NE(p3, p1);
+    for (uint8_t i=0; i<16; i++) {
+        EXPECT_EQ(p3[i], 0x5a);
+    }
+
+    // freed objects are reused
+    EXPECT_EQ(h.change_size(p2, 10, 0), nullptr);
+    EXPECT_EQ(h.change_size(nullptr, 0, 12), p2);
+
+    // large allocations come from the heaps, and moving an object
+    // between the pool and the heaps keeps the contents
+    h.get_pool_stats(stats);
+    const uint32_t in_use = stats.in_use_bytes;
+    uint8_t *big = (uint8_t *)h.change_size(p3, 40, 200);
+    ASSERT_TRUE(big != nullptr);
+    for (uint8_t i=0; i<16; i++) {
+        EXPECT_EQ(big[i], 0x5a);
+    }
+    h.get_pool_stats(stats);
+    EXPECT_EQ(stats.in_use_bytes, in_use - 48);
+    p3 = (uint8_t *)h.change_size(big, 200, 20);
+    ASSERT_TRUE(p3 != nullptr);
+    EXPECT_EQ(p3[15], 0x5a);
+
+    h.change_size(p2, 12, 0);
+    h.change_size(p3, 20, 0);
+    h.get_pool_stats(stats);
+    EXPECT_EQ(stats.in_use_bytes, 0U);
+    EXPECT_GT(stats.pool_bytes, 0U);
+
+    h.destroy();
+}
+#endif
+
 AP_GTEST_MAIN()
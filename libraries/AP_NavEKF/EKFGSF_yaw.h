@@ -88,8 +88,8 @@ private:
     ftype ahrs_accel_norm;          // length of body frame specific force vector used by AHRS calculation (m/s/s)
     ftype true_airspeed;            // true airspeed used to correct for centripetal acceleratoin in coordinated turns (m/s)
 
-    // Runs quaternion prediction for the selected AHRS using IMU (and optionally true airspeed) data
-    void predictAHRS(const uint8_t mdl_idx);
+    // Runs the rotation matrix prediction for all AHRS using IMU (and optionally true airspeed) data
+    void predictAHRS();
 
     // Applies a body frame delta angle to a body to earth frame rotation matrix using a small angle approximation
     Matrix3F updateRotMat(const Matrix3F &R, const Vector3F &g) const;
@@ -102,28 +102,39 @@ private:
 
     // The Following declarations are used by bank of EKF's that estimate yaw angle starting from a different yaw hypothesis for each filter.
 
-    struct EKF_struct {
-        ftype X[3];     // Vel North (m/s),  Vel East (m/s), yaw (rad)
-        ftype P[3][3];  // covariance matrix
-        ftype S[2][2];  // N,E velocity innovation variance (m/s)^2
-        ftype innov[2]; // Velocity N,E innovation (m/s)
+    // The bank is held as a structure of arrays with one element per
+    // model, so prediction and correction run as single passes over
+    // all models. The covariance and innovation variance matrices are
+    // symmetric so only the upper triangle is stored.
+    struct EKF_bank {
+        ftype vel_N[N_MODELS_EKFGSF];   // Vel North state (m/s)
+        ftype vel_E[N_MODELS_EKFGSF];   // Vel East state (m/s)
+        ftype yaw[N_MODELS_EKFGSF];     // yaw state (rad)
+        ftype P00[N_MODELS_EKFGSF];     // covariance matrix upper triangle
+        ftype P01[N_MODELS_EKFGSF];
+        ftype P02[N_MODELS_EKFGSF];
+        ftype P11[N_MODELS_EKFGSF];
+        ftype P12[N_MODELS_EKFGSF];
+        ftype P22[N_MODELS_EKFGSF];
+        ftype S00[N_MODELS_EKFGSF];     // N,E velocity innovation variance upper triangle (m/s)^2
+        ftype S01[N_MODELS_EKFGSF];
+        ftype S11[N_MODELS_EKFGSF];
+        ftype innov_N[N_MODELS_EKFGSF]; // Velocity North innovation (m/s)
+        ftype innov_E[N_MODELS_EKFGSF]; // Velocity East innovation (m/s)
     };
-    EKF_struct EKF[N_MODELS_EKFGSF];
+    EKF_bank EKF;
     bool vel_fuse_running;  // true when the bank of EKF's has started fusing GPS velocity data
     bool run_ekf_gsf;       // true when operating condition is suitable for to run the GSF and EKF models and fuse velocity data
 
     // Resets states and covariances for the EKF's and GSF including GSF weights, but not the AHRS complementary filters
     void resetEKFGSF();
 
-    // Runs the state and covariance prediction for the selected EKF
-    void predict(const uint8_t mdl_idx);
+    // Runs the state and covariance prediction for all EKFs
+    void predict();
 
-    // Runs the state and covariance update for the selected EKF using the GPS NE velocity measurement
-    // Returns false if the sttae and covariance correction failed
-    bool correct(const uint8_t mdl_idx, const Vector2F &vel, const ftype velObsVar);
-
-    // Forces symmetry on the covariance matrix for the selected EKF
-    void forceSymmetry(const uint8_t mdl_idx);
+    // Runs the state and covariance update for all EKFs using the GPS NE velocity measurement
+    // Returns false if the state and covariance correction failed for any model
+    bool correct(const Vector2F &vel, const ftype velObsVar);
 
     // The following declarations are used  by the Gaussian Sum Filter that combines the state estimates from the bank of
     // EKF's to form a single state estimate.
@@ -79,6 +79,30 @@ bool ekf_ring_buffer::recall(void *element, const uint32_t sample_time_ms)
     return ret;
 }
 
+/*
+  Remove and return the oldest data that is older than the time
+  specified by sample_time_ms, discarding data more than 100msec old
+  Returns false if no such data can be found
+*/
+bool ekf_ring_buffer::recall_oldest(void *element, const uint32_t sample_time_ms)
+{
+    while (count > 0) {
+        const int32_t dt = sample_time_ms - time_ms(oldest);
+        if (dt < 0) {
+            // the oldest element is younger than we want
+            return false;
+        }
+        const uint8_t idx = oldest;
+        count--;
+        oldest = (oldest+1) % size;
+        if (dt < 100) {
+            memcpy(element, get_offset(idx), elsize);
+            return true;
+        }
+    }
+    return false;
+}
+
 /*
  * Writes data and timestamp to a Ring buffer and advances indices that
  * define the location of the newest and oldest data
@@ -30,6 +30,15 @@ public:
     */
     bool recall(void *element, const uint32_t sample_time_ms);
 
+    /*
+     * Removes and returns the oldest data that is older than the time
+     * specified by sample_time_ms, so that several samples reaching the
+     * fusion time horizon together can each be used
+     * Data more than 100msec old is discarded
+     * Returns false if no such data can be found
+    */
+    bool recall_oldest(void *element, const uint32_t sample_time_ms);
+
     /*
      * Writes data and timestamp to a Ring buffer and advances indices that
      * define the location of the newest and oldest data
@@ -39,6 +48,11 @@ public:
     // zeroes all data in the ring buffer
     void reset();
 
+    // return true if init() has allocated the storage
+    bool is_allocated() const {
+        return buffer != nullptr;
+    }
+
 private:
     const uint8_t elsize;
     void *buffer;
@@ -79,6 +93,10 @@ public:
         return ekf_ring_buffer::recall(&element, sample_time);
     }
 
+    bool recall_oldest(element_type &element,uint32_t sample_time) {
+        return ekf_ring_buffer::recall_oldest(&element, sample_time);
+    }
+
     void push(const element_type &element) {
         return ekf_ring_buffer::push(&element);
     }
@@ -86,6 +104,10 @@ public:
     void reset() {
         return ekf_ring_buffer::reset();
     }
+
+    bool is_allocated() const {
+        return ekf_ring_buffer::is_allocated();
+    }
 };
 
 
@@ -8,11 +8,16 @@
 #include <AP_Logger/AP_Logger.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
+#include <AP_Common/ExpandingString.h>
 
 #include "AP_DAL/AP_DAL.h"
 
 #include <new>
 
+#if EK3_FEATURE_PARALLEL_LANES
+extern const AP_HAL::HAL& hal;
+#endif
+
 /*
   parameter defaults for different types of vehicle. The
   APM_BUILD_DIRECTORY is taken from the main vehicle directory name
@@ -739,8 +744,8 @@ const AP_Param::GroupInfo NavEKF3::var_info2[] = {
 
     // @Param: OPTIONS
     // @DisplayName: Optional EKF behaviour
-    // @Description: EKF optional behaviour. Bit 0 (JammingExpected): Setting JammingExpected will change the EKF behaviour such that if dead reckoning navigation is possible it will require the preflight alignment GPS quality checks controlled by EK3_GPS_CHECK and EK3_CHECK_SCALE to pass before resuming GPS use if GPS lock is lost for more than 2 seconds to prevent bad position estimate. Bit 1 (Manual lane switching): DANGEROUS – If enabled, this disables automatic lane switching. If the active lane becomes unhealthy, no automatic switching will occur. Users must manually set EK3_PRIMARY to change lanes. No health checks will be performed on the selected lane. Use with extreme caution.
-    // @Bitmask: 0:JammingExpected, 1: ManualLaneSwitching
+    // @Description: EKF optional behaviour. Bit 0 (JammingExpected): Setting JammingExpected will change the EKF behaviour such that if dead reckoning navigation is possible it will require the preflight alignment GPS quality checks controlled by EK3_GPS_CHECK and EK3_CHECK_SCALE to pass before resuming GPS use if GPS lock is lost for more than 2 seconds to prevent bad position estimate. Bit 1 (Manual lane switching): DANGEROUS – If enabled, this disables automatic lane switching. If the active lane becomes unhealthy, no automatic switching will occur. Users must manually set EK3_PRIMARY to change lanes. No health checks will be performed on the selected lane. Use with extreme caution. Bit 2 (ParallelLanes): On Linux boards run the update of each EKF lane on its own thread so that the EKF update time is set by the slowest lane rather than the sum of all lanes. Requires a reboot to take effect.
+    // @Bitmask: 0:JammingExpected, 1: ManualLaneSwitching, 2: ParallelLanes
     // @User: Advanced
     AP_GROUPINFO("OPTIONS",  11, NavEKF3, _options, 0),
 
@@ -866,9 +871,18 @@ bool NavEKF3::InitialiseFilter(void)
         ret &= core[i].InitialiseFilterBootstrap();
     }
 
+    // the warm start attitude is only for the first initialisation
+    if (ret) {
+        warm_start.valid = false;
+    }
+
     // set last time the cores were primary to 0
     memset(coreLastTimePrimary_us, 0, sizeof(coreLastTimePrimary_us));
 
+#if EK3_FEATURE_PARALLEL_LANES
+    start_lane_workers();
+#endif
+
     // zero the structs used capture reset events
     memset(&yaw_reset_data, 0, sizeof(yaw_reset_data));
     memset((void *)&pos_reset_data, 0, sizeof(pos_reset_data));
@@ -917,6 +931,29 @@ void NavEKF3::UpdateFilter(void)
 
     imuSampleTime_us = dal.micros64();
 
+#if EK3_FEATURE_PARALLEL_LANES
+    if (lane_workers_started) {
+        // decide on prediction for all lanes before any of them run so
+        // the decisions do not depend on thread timing and Replay
+        // sees the same inputs as a serial update
+        for (uint8_t i=0; i<num_cores; i++) {
+            LaneWorker &worker = lane_workers[i];
+            worker.allow_state_prediction = true;
+            if (core[i].getFramesSincePredict() < (_framesPerPrediction+3) &&
+                dal.ekf_low_time_remaining(AP_DAL::EKFType::EKF3, i)) {
+                worker.allow_state_prediction = false;
+            }
+        }
+        for (uint8_t i=1; i<num_cores; i++) {
+            lane_workers[i].start_sem.signal();
+        }
+        core[0].UpdateFilter(lane_workers[0].allow_state_prediction);
+        // wait for all lanes to complete before lane selection
+        for (uint8_t i=1; i<num_cores; i++) {
+            lane_workers[i].done_sem.wait_blocking();
+        }
+    } else
+#endif
     for (uint8_t i=0; i<num_cores; i++) {
         // if we have not overrun by more than 3 IMU frames, and we
         // have already used more than 1/3 of the CPU budget for this
@@ -1020,6 +1057,51 @@ void NavEKF3::UpdateFilter(void)
     sources.align_inactive_sources();
 }
 
+#if EK3_FEATURE_PARALLEL_LANES
+/*
+  start one worker thread per lane other than lane 0 if the
+  ParallelLanes option is set. If any thread can't be started we
+  carry on updating the lanes serially
+ */
+void NavEKF3::start_lane_workers(void)
+{
+    if (lane_workers_started || num_cores < 2 ||
+        !option_is_enabled(Option::ParallelLanes)) {
+        return;
+    }
+    if (lane_workers == nullptr) {
+        lane_workers = NEW_NOTHROW LaneWorker[num_cores];
+        if (lane_workers == nullptr) {
+            return;
+        }
+        for (uint8_t i=0; i<num_cores; i++) {
+            lane_workers[i].core = &core[i];
+        }
+        for (uint8_t i=1; i<num_cores; i++) {
+            if (!hal.scheduler->thread_create(FUNCTOR_BIND(&lane_workers[i], &NavEKF3::LaneWorker::thread_main, void),
+                                              "EKF3",
+                                              8192, AP_HAL::Scheduler::PRIORITY_MAIN, 0)) {
+                GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "EKF3: lane thread failed");
+                return;
+            }
+        }
+    }
+    lane_workers_started = true;
+}
+
+// worker thread main loop, runs one lane update each time it is signalled
+void NavEKF3::LaneWorker::thread_main(void)
+{
+    while (true) {
+        if (!start_sem.wait_blocking()) {
+            continue;
+        }
+        core->UpdateFilter(allow_state_prediction);
+        done_sem.signal();
+    }
+}
+#endif // EK3_FEATURE_PARALLEL_LANES
+
 /*
   check if switching lanes will reduce the normalised
   innovations. This is called when the vehicle code is about to
@@ -1074,6 +1156,13 @@ void NavEKF3::switchLane(uint8_t new_lane_index)
         primary = new_lane_index;
         lastLaneSwitch_ms = dal.millis();
         GCS_SEND_TEXT(MAV_SEVERITY_CRITICAL, "EKF3 lane switch %u", primary);
+#if AP_LOGGER_REPLAY_RING_ENABLED
+        // capture the lead-up to the switch for replay
+        dal.replay_ring_trigger();
+#endif
+#if HAL_LOGGING_ENABLED
+        AP::logger().trigger_full_rate();
+#endif
     }
 }
 
@@ -1418,6 +1507,16 @@ bool NavEKF3::getOriginLLH(Location &loc) const
 // All NED positions calculated by the filter will be relative to this location
 // The origin cannot be set if the filter is in a flight mode (eg vehicle armed)
 // Returns false if the filter has rejected the attempt to set the origin
+void NavEKF3::setWarmStartAttitude(float roll_rad, float pitch_rad, float yaw_rad)
+{
+    dal.log_WarmStartAttitude3(roll_rad, pitch_rad, yaw_rad);
+
+    warm_start.roll = roll_rad;
+    warm_start.pitch = pitch_rad;
+    warm_start.yaw = yaw_rad;
+    warm_start.valid = true;
+}
+
 bool NavEKF3::setOriginLLH(const Location &loc)
 {
     dal.log_SetOriginLLH3(loc);
@@ -2109,3 +2208,31 @@ const EKFGSF_yaw *NavEKF3::get_yawEstimator(void) const
     }
     return nullptr;
 }
+
+#if EK3_FEATURE_PERF_ACCOUNTING
+/*
+  print the CPU time of each update step of each lane, one line per
+  lane and step so it can be parsed by Tools/Replay/bench_replay.py
+ */
+void NavEKF3::perf_report(ExpandingString &str) const
+{
+    str.printf("EK3PERF lane imu step calls total_us mean_us max_us\n");
+    for (uint8_t i=0; i<num_cores; i++) {
+        for (uint8_t s=0; s<uint8_t(NavEKF3_core::PerfStep::NUM_STEPS); s++) {
+            const auto step = NavEKF3_core::PerfStep(s);
+            const NavEKF3_core::PerfCounter &p = core[i].get_perf(step);
+            if (p.count == 0) {
+                continue;
+            }
+            str.printf("EK3PERF %u %u %s %u %.0f %.2f %.2f\n",
+                       unsigned(i),
+                       unsigned(coreImuIndex[i]),
+                       NavEKF3_core::perf_step_name(step),
+                       unsigned(p.count),
+                       p.total_ns * 1.0e-3,
+                       p.total_ns * 1.0e-3 / p.count,
+                       p.max_ns * 1.0e-3);
+        }
+    }
+}
+#endif  // EK3_FEATURE_PERF_ACCOUNTING
@@ -24,6 +24,7 @@
 #include <AP_Param/AP_Param.h>
 #include <AP_NavEKF/AP_Nav_Common.h>
 #include <AP_NavEKF/AP_NavEKF_Source.h>
+#include "AP_NavEKF3_feature.h"
 
 class NavEKF3_core;
 class EKFGSF_yaw;
@@ -157,6 +158,12 @@ public:
     // Returns true if the set was successful
     bool setLatLng(const Location &loc, float posErr, uint32_t timestamp_ms);
 
+    // set the attitude saved before a watchdog reset. The cores start
+    // from it with yaw aligned rather than aligning from the sensors,
+    // so estimation resumes quickly after a reset in flight. Must be
+    // called before InitialiseFilter()
+    void setWarmStartAttitude(float roll_rad, float pitch_rad, float yaw_rad);
+
     // return estimated height above ground level
     // return false if ground height is not being estimated.
     bool getHAGL(float &HAGL) const;
@@ -343,6 +350,11 @@ public:
     // write EKF information to on-board logs
     void Log_Write();
 
+#if EK3_FEATURE_PERF_ACCOUNTING
+    // print the CPU time of each update step of each lane
+    void perf_report(class ExpandingString &str) const;
+#endif
+
     // are we using (aka fusing) a non-compass yaw?
     bool using_noncompass_for_yaw() const;
 
@@ -375,6 +387,20 @@ private:
     uint8_t primary;   // current primary core
     NavEKF3_core *core = nullptr;
 
+#if EK3_FEATURE_PARALLEL_LANES
+    // worker used to run a single lane's UpdateFilter on its own thread
+    struct LaneWorker {
+        NavEKF3_core *core;
+        bool allow_state_prediction;
+        HAL_BinarySemaphore start_sem;
+        HAL_BinarySemaphore done_sem;
+        void thread_main(void);
+    };
+    LaneWorker *lane_workers = nullptr; // one per core, lane 0 is run by the caller
+    bool lane_workers_started = false;
+    void start_lane_workers(void);
+#endif
+
     uint32_t _frameTimeUsec;        // time per IMU frame
     uint8_t  _framesPerPrediction;  // expected number of IMU frames per prediction
   
@@ -459,6 +485,7 @@ private:
     enum class Option {
         JammingExpected     = (1<<0),
         ManualLaneSwitch   = (1<<1),
+        ParallelLanes      = (1<<2),
     };
     bool option_is_enabled(Option option) const {
         return (_options & (uint32_t)option) != 0;
@@ -547,6 +574,12 @@ private:
     // origin set by one of the cores
     Location common_EKF_origin;
     bool common_origin_valid;
+
+    // attitude to initialise the cores from after a watchdog reset
+    struct {
+        bool valid;
+        ftype roll, pitch, yaw;
+    } warm_start;
     
     // update the yaw reset data to capture changes due to a lane switch
     // new_primary - index of the ekf instance that we are about to switch to as the primary
@@ -932,12 +932,12 @@ void NavEKF3_core::readRngBcnData()
     // get the number of beacons in use
     rngBcn.N = MIN(beacon->count(), ARRAY_SIZE(rngBcn.lastTime_ms));
 
-    // search through all the beacons for new data and if we find it stop searching and push the data into the observation buffer
-    bool newDataPushed = false;
+    // search through all the beacons for new data and push all new data into the observation buffer
+    // so that ranges from many beacons can be fused together when they reach the fusion time horizon
     uint8_t numRngBcnsChecked = 0;
     // start the search one index up from where we left it last time
     uint8_t index = rngBcn.lastChecked;
-    while (!newDataPushed && (numRngBcnsChecked < rngBcn.N)) {
+    while (numRngBcnsChecked < rngBcn.N) {
         // track the number of beacons checked
         numRngBcnsChecked++;
 
@@ -968,9 +968,6 @@ void NavEKF3_core::readRngBcnData()
             // identify the beacon identifier
             rngBcnDataNew.beacon_ID = index;
 
-            // indicate we have new data to push to the buffer
-            newDataPushed = true;
-
             // update the last checked index
             rngBcn.lastChecked = index;
 
@@ -1017,15 +1014,21 @@ void NavEKF3_core::readRngBcnData()
         rngBcn.goodToAlign = false;
     }
 
-    // Check the buffer for measurements that have been overtaken by the fusion time horizon and need to be fused
-    rngBcn.dataToFuse = rngBcn.storedRange.recall(rngBcn.dataDelayed, imuDataDelayed.time_ms);
+}
 
-    // Correct the range beacon earth frame origin for estimated offset relative to the EKF earth frame origin
-    if (rngBcn.dataToFuse) {
-        rngBcn.dataDelayed.beacon_posNED.x += rngBcn.posOffsetNED.x;
-        rngBcn.dataDelayed.beacon_posNED.y += rngBcn.posOffsetNED.y;
+// recall the oldest range beacon measurement that has been overtaken by the fusion time horizon
+// returns false when there are no more measurements to fuse on this time step
+bool NavEKF3_core::recallRngBcnData()
+{
+    if (!rngBcn.storedRange.recall_oldest(rngBcn.dataDelayed, imuDataDelayed.time_ms)) {
+        return false;
     }
 
+    // Correct the range beacon earth frame origin for estimated offset relative to the EKF earth frame origin
+    rngBcn.dataDelayed.beacon_posNED.x += rngBcn.posOffsetNED.x;
+    rngBcn.dataDelayed.beacon_posNED.y += rngBcn.posOffsetNED.y;
+
+    return true;
 }
 #endif  // EK3_FEATURE_BEACON_FUSION
 
@@ -1459,17 +1462,20 @@ void NavEKF3_core::updateMovementCheck(void)
     }
 }
 
+// return true if any of the drag coefficients enable drag fusion
+bool NavEKF3_core::dragCoefficientsSet() const
+{
+    return frontend->_ballisticCoef_x > 1.0f ||
+           frontend->_ballisticCoef_y > 1.0f ||
+           frontend->_momentumDragCoef > 0.001f;
+}
+
 void NavEKF3_core::SampleDragData(const imu_elements &imu)
 {
 #if EK3_FEATURE_DRAG_FUSION
     // Average and down sample to 5Hz
-    const ftype bcoef_x = frontend->_ballisticCoef_x.get();
-    const ftype bcoef_y = frontend->_ballisticCoef_y.get();
-    const ftype mcoef = frontend->_momentumDragCoef.get();
-    const bool using_bcoef_x = bcoef_x > 1.0f;
-    const bool using_bcoef_y = bcoef_y > 1.0f;
-    const bool using_mcoef = mcoef > 0.001f;
-    if (!using_bcoef_x && !using_bcoef_y && !using_mcoef) {
+    // the buffer is only allocated if drag fusion was configured when the lane was set up
+    if (!dragCoefficientsSet() || !storedDrag.is_allocated()) {
         // nothing to do
         dragFusionEnabled = false;
         return;
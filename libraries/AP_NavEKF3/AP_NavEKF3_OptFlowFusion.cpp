@@ -316,6 +316,12 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
     }
 #endif
 
+    // the innovation consistency of each axis is checked before its
+    // Kalman gains are calculated, so a rejected observation costs
+    // only its innovation and innovation variance
+    const ftype flowGateSq = sq(MAX(0.01f * (ftype)frontend->_flowInnovGate, 1.0f));
+    const bool flowRateOK = (ofDataDelayed.flowRadXY.x < frontend->_maxFlowRate) && (ofDataDelayed.flowRadXY.y < frontend->_maxFlowRate);
+
     // Fuse X and Y axis measurements sequentially assuming observation errors are uncorrelated
     for (uint8_t obsIndex=0; obsIndex<=1; obsIndex++) { // fuse X axis data first
 
@@ -449,6 +455,12 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             // flowInnovTime_ms will be updated when Y-axis innovations are calculated
             flowInnov[0] = losPred[0] - ofDataDelayed.flowRadXYcomp.x;
 
+            // Check the innovation for consistency and don't fuse if out of bounds or flow is too fast to be reliable
+            flowTestRatio[0] = sq(flowInnov[0]) / (flowGateSq * flowVarInnov[0]);
+            if (!really_fuse || !(flowTestRatio[0] < 1.0f) || !flowRateOK) {
+                continue;
+            }
+
             // calculate Kalman gains for X-axis observation
             Kfusion[0] = t78*(t12-P[0][4]*t2*t7+P[0][1]*t2*t15+P[0][6]*t2*t10+P[0][2]*t2*t19-P[0][3]*t2*t22+P[0][5]*t2*t27);
             Kfusion[1] = t78*(t31+P[1][0]*t2*t5-P[1][4]*t2*t7+P[1][6]*t2*t10+P[1][2]*t2*t19-P[1][3]*t2*t22+P[1][5]*t2*t27);
@@ -626,6 +638,12 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             flowInnov[1] = losPred[1] - ofDataDelayed.flowRadXYcomp.y;
             flowInnovTime_ms = dal.millis();
 
+            // Check the innovation for consistency and don't fuse if out of bounds or flow is too fast to be reliable
+            flowTestRatio[1] = sq(flowInnov[1]) / (flowGateSq * flowVarInnov[1]);
+            if (!really_fuse || !(flowTestRatio[1] < 1.0f) || !flowRateOK) {
+                continue;
+            }
+
             // calculate Kalman gains for the Y-axis observation
             Kfusion[0] = -t78*(t12+P[0][5]*t2*t8-P[0][6]*t2*t10+P[0][1]*t2*t16-P[0][2]*t2*t19+P[0][3]*t2*t22+P[0][4]*t2*t27);
             Kfusion[1] = -t78*(t31+P[1][0]*t2*t5+P[1][5]*t2*t8-P[1][6]*t2*t10-P[1][2]*t2*t19+P[1][3]*t2*t22+P[1][4]*t2*t27);
@@ -682,78 +700,73 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             }
         }
 
-        // calculate the innovation consistency test ratio
-        flowTestRatio[obsIndex] = sq(flowInnov[obsIndex]) / (sq(MAX(0.01f * (ftype)frontend->_flowInnovGate, 1.0f)) * flowVarInnov[obsIndex]);
-
-        // Check the innovation for consistency and don't fuse if out of bounds or flow is too fast to be reliable
-        if (really_fuse && (flowTestRatio[obsIndex]) < 1.0f && (ofDataDelayed.flowRadXY.x < frontend->_maxFlowRate) && (ofDataDelayed.flowRadXY.y < frontend->_maxFlowRate)) {
-            // record the last time observations were accepted for fusion
-            prevFlowFuseTime_ms = imuSampleTime_ms;
-            // notify first time only
-            if (!flowFusionActive) {
-                flowFusionActive = true;
-                GCS_SEND_TEXT(MAV_SEVERITY_INFO, "EKF3 IMU%u fusing optical flow",(unsigned)imu_index);
+        // the observation passed the checks above so fuse it
+        // record the last time observations were accepted for fusion
+        prevFlowFuseTime_ms = imuSampleTime_ms;
+        // notify first time only
+        if (!flowFusionActive) {
+            flowFusionActive = true;
+            GCS_SEND_TEXT(MAV_SEVERITY_INFO, "EKF3 IMU%u fusing optical flow",(unsigned)imu_index);
+        }
+        // correct the covariance P = (I - K*H)*P
+        // take advantage of the empty columns in KH to reduce the
+        // number of operations
+        for (uint8_t i = 0; i<=stateIndexLim; i++) {
+            for (uint8_t j = 0; j<=6; j++) {
+                KH[i][j] = Kfusion[i] * H_LOS[j];
+            }
+            for (uint8_t j = 7; j<=stateIndexLim; j++) {
+                KH[i][j] = 0.0f;
             }
-            // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
-            // number of operations
+        }
+        for (uint8_t j = 0; j<=stateIndexLim; j++) {
             for (uint8_t i = 0; i<=stateIndexLim; i++) {
-                for (uint8_t j = 0; j<=6; j++) {
-                    KH[i][j] = Kfusion[i] * H_LOS[j];
-                }
-                for (uint8_t j = 7; j<=stateIndexLim; j++) {
-                    KH[i][j] = 0.0f;
-                }
+                ftype res = 0;
+                res += KH[i][0] * P[0][j];
+                res += KH[i][1] * P[1][j];
+                res += KH[i][2] * P[2][j];
+                res += KH[i][3] * P[3][j];
+                res += KH[i][4] * P[4][j];
+                res += KH[i][5] * P[5][j];
+                res += KH[i][6] * P[6][j];
+                KHP[i][j] = res;
             }
-            for (uint8_t j = 0; j<=stateIndexLim; j++) {
-                for (uint8_t i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][0] * P[0][j];
-                    res += KH[i][1] * P[1][j];
-                    res += KH[i][2] * P[2][j];
-                    res += KH[i][3] * P[3][j];
-                    res += KH[i][4] * P[4][j];
-                    res += KH[i][5] * P[5][j];
-                    res += KH[i][6] * P[6][j];
-                    KHP[i][j] = res;
-                }
+        }
+
+        // Check that we are not going to drive any variances negative and skip the update if so
+        bool healthyFusion = true;
+        for (uint8_t i= 0; i<=stateIndexLim; i++) {
+            if (KHP[i][i] > P[i][i]) {
+                healthyFusion = false;
             }
+        }
 
-            // Check that we are not going to drive any variances negative and skip the update if so
-            bool healthyFusion = true;
+        if (healthyFusion) {
+            // update the covariance matrix
             for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                if (KHP[i][i] > P[i][i]) {
-                    healthyFusion = false;
+                for (uint8_t j= 0; j<=stateIndexLim; j++) {
+                    P[i][j] = P[i][j] - KHP[i][j];
                 }
             }
 
-            if (healthyFusion) {
-                // update the covariance matrix
-                for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                    for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                        P[i][j] = P[i][j] - KHP[i][j];
-                    }
-                }
-
-                // force the covariance matrix to be symmetrical and limit the variances to prevent ill-conditioning.
-                ForceSymmetry();
-                ConstrainVariances();
-
-                // correct the state vector
-                for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                    statesArray[j] = statesArray[j] - Kfusion[j] * flowInnov[obsIndex];
-                }
-                stateStruct.quat.normalize();
+            // force the covariance matrix to be symmetrical and limit the variances to prevent ill-conditioning.
+            ForceSymmetry();
+            ConstrainVariances();
 
-            } else {
-                // record bad axis
-                if (obsIndex == 0) {
-                    faultStatus.bad_xflow = true;
-                } else if (obsIndex == 1) {
-                    faultStatus.bad_yflow = true;
-                }
+            // correct the state vector
+            for (uint8_t j= 0; j<=stateIndexLim; j++) {
+                statesArray[j] = statesArray[j] - Kfusion[j] * flowInnov[obsIndex];
+            }
+            stateStruct.quat.normalize();
 
+        } else {
+            // record bad axis
+            if (obsIndex == 0) {
+                faultStatus.bad_xflow = true;
+            } else if (obsIndex == 1) {
+                faultStatus.bad_yflow = true;
             }
+
         }
     }
 
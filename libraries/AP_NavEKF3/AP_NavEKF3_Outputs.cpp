@@ -252,7 +252,8 @@ bool NavEKF3_core::getPosNE(Vector2f &posNE) const
     if (PV_AidingMode != AID_NONE) {
         // This is the normal mode of operation where we can use the EKF position states
         // correct for the IMU offset (EKF calculations are at the IMU)
-        posNE = (outputDataNew.position.xy() + posOffsetNED.xy() + public_origin.get_distance_NE_ftype(EKF_origin)).tofloat();
+        // the offset between the origins can be large, so is added in double
+        posNE = ((outputDataNew.position.xy() + posOffsetNED.xy()).todouble() + public_origin.get_distance_NE_double(EKF_origin)).tofloat();
         return true;
 
     } else {
@@ -438,8 +438,12 @@ void NavEKF3_core::CorrectExtNavForSensorOffset(ext_nav_elements &ext_nav_data)
     }
     ext_nav_data.corrected = true;
 
-    // external nav data is against the public_origin, so convert to offset from EKF_origin
-    ext_nav_data.pos.xy() += EKF_origin.get_distance_NE_ftype(public_origin);
+    // external nav data is against the public_origin, so convert to
+    // offset from EKF_origin. Both are large far from the public_origin
+    // so the sum is done in double
+    const Vector2d origin_offset = EKF_origin.get_distance_NE_double(public_origin);
+    ext_nav_data.pos.x = ftype(ext_nav_data.pos.x + origin_offset.x);
+    ext_nav_data.pos.y = ftype(ext_nav_data.pos.y + origin_offset.y);
 
 #if HAL_VISUALODOM_ENABLED
     const auto *visual_odom = dal.visualodom();
@@ -1030,6 +1034,10 @@ void NavEKF3_core::FuseVelPosNED()
                     Kfusion[i] = P[i][stateIndex]*SK;
                 }
 
+                // rows of inhibited states have zero gain, so the
+                // covariance and state updates can skip them
+                uint32_t zeroGainRows = 0;
+
                 // inhibit delta angle bias state estimation by setting Kalman gains to zero
                 if (!inhibitDelAngBiasStates) {
                     for (uint8_t i = 10; i<=12; i++) {
@@ -1048,6 +1056,7 @@ void NavEKF3_core::FuseVelPosNED()
                         }
                         if (poorObservability) {
                             Kfusion[i] = 0.0;
+                            zeroGainRows |= 1U<<i;
                         } else {
                             Kfusion[i] = P[i][stateIndex]*SK;
                         }
@@ -1055,6 +1064,7 @@ void NavEKF3_core::FuseVelPosNED()
                 } else {
                     // zero indexes 10 to 12
                     zero_range(&Kfusion[0], 10, 12);
+                    zeroGainRows |= 0x7U<<10;
                 }
 
                 // Inhibit delta velocity bias state estimation by setting Kalman gains to zero
@@ -1067,11 +1077,13 @@ void NavEKF3_core::FuseVelPosNED()
                             Kfusion[i] = P[i][stateIndex]*SK;
                         } else {
                             Kfusion[i] = 0.0f;
+                            zeroGainRows |= 1U<<i;
                         }
                     }
                 } else {
                     // zero indexes 13 to 15
                     zero_range(&Kfusion[0], 13, 15);
+                    zeroGainRows |= 0x7U<<13;
                 }
 
                 // inhibit magnetic field state estimation by setting Kalman gains to zero
@@ -1082,6 +1094,7 @@ void NavEKF3_core::FuseVelPosNED()
                 } else {
                     // zero indexes 16 to 21
                     zero_range(&Kfusion[0], 16, 21);
+                    zeroGainRows |= 0x3FU<<16;
                 }
 
                 // inhibit wind state estimation by setting Kalman gains to zero
@@ -1091,11 +1104,16 @@ void NavEKF3_core::FuseVelPosNED()
                 } else {
                     // zero indexes 22 to 23
                     zero_range(&Kfusion[0], 22, 23);
+                    zeroGainRows |= 0x3U<<22;
                 }
 
                 // update the covariance - take advantage of direct observation of a single state at index = stateIndex to reduce computations
                 // this is a numerically optimised implementation of standard equation P = (I - K*H)*P;
+                // rows with zero gain are left out as KHP is zero for them
                 for (uint8_t i= 0; i<=stateIndexLim; i++) {
+                    if (zeroGainRows & (1U<<i)) {
+                        continue;
+                    }
                     for (uint8_t j= 0; j<=stateIndexLim; j++) {
                         KHP[i][j] = Kfusion[i] * P[stateIndex][j];
                     }
@@ -1103,13 +1121,16 @@ void NavEKF3_core::FuseVelPosNED()
                 // Check that we are not going to drive any variances negative and skip the update if so
                 bool healthyFusion = true;
                 for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                    if (KHP[i][i] > P[i][i]) {
+                    if (!(zeroGainRows & (1U<<i)) && KHP[i][i] > P[i][i]) {
                         healthyFusion = false;
                     }
                 }
                 if (healthyFusion) {
                     // update the covariance matrix
                     for (uint8_t i= 0; i<=stateIndexLim; i++) {
+                        if (zeroGainRows & (1U<<i)) {
+                            continue;
+                        }
                         for (uint8_t j= 0; j<=stateIndexLim; j++) {
                             P[i][j] = P[i][j] - KHP[i][j];
                         }
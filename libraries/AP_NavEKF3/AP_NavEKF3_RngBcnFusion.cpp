@@ -64,8 +64,10 @@ void NavEKF3_core::SelectRngBcnFusion()
     // read range data from the sensor and check for new data in the buffer
     readRngBcnData();
 
-    // Determine if we need to fuse range beacon data on this time step
-    if (rngBcn.dataToFuse) {
+    // sequentially fuse every range that has been overtaken by the fusion time horizon, oldest first
+    bool fused = false;
+    for (uint8_t i = 0; i < ARRAY_SIZE(rngBcn.lastTime_ms) && recallRngBcnData(); i++) {
+        fused = true;
         if (PV_AidingMode == AID_ABSOLUTE) {
             if ((frontend->sources.getPosXYSource() == AP_NavEKF_Source::SourceXY::BEACON) && rngBcn.alignmentCompleted) {
                 if (!rngBcn.originEstInit) {
@@ -90,6 +92,7 @@ void NavEKF3_core::SelectRngBcnFusion()
             rngBcn.originEstInit = false;
         }
     }
+    rngBcn.dataToFuse = fused;
 }
 
 void NavEKF3_core::FuseRngBcn()
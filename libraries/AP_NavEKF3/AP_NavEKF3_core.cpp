@@ -7,6 +7,10 @@
 #include <AP_Logger/AP_Logger.h>
 #include <AP_DAL/AP_DAL.h>
 
+#if EK3_FEATURE_PERF_ACCOUNTING && (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#include <time.h>
+#endif
+
 // constructor
 NavEKF3_core::NavEKF3_core(NavEKF3 *_frontend, AP_DAL &_dal) :
     dal(_dal),
@@ -161,7 +165,9 @@ bool NavEKF3_core::setup_core(uint8_t _imu_index, uint8_t _core_index)
         return false;
     }
 #if EK3_FEATURE_DRAG_FUSION
-    if (!storedDrag.init(obs_buffer_length)) {
+    // drag samples are down sampled to 5Hz, and the buffer is only
+    // needed by lanes that can fuse them
+    if (dragCoefficientsSet() && !storedDrag.init(MIN((ekf_delay_ms / 200U) + 2, unsigned(obs_buffer_length)))) {
         return false;
     }
 #endif
@@ -495,11 +501,12 @@ bool NavEKF3_core::InitialiseFilterBootstrap(void)
         return storedIMU.is_filled();
     }
 
-    // accumulate enough sensor data to fill the buffers
+    // accumulate enough sensor data to fill the buffers. On a warm
+    // start the IMU buffer fill check below is enough
     if (firstInitTime_ms == 0) {
         firstInitTime_ms = imuSampleTime_ms;
         return false;
-    } else if (imuSampleTime_ms - firstInitTime_ms < 1000) {
+    } else if (imuSampleTime_ms - firstInitTime_ms < 1000 && !frontend->warm_start.valid) {
         return false;
     }
 
@@ -527,6 +534,13 @@ bool NavEKF3_core::InitialiseFilterBootstrap(void)
     // calculate initial roll and pitch orientation
     stateStruct.quat.from_euler(roll, pitch, 0.0f);
 
+    // after a watchdog reset start from the saved attitude, which is
+    // better than the accelerometers while manoeuvring, and keep its
+    // yaw rather than waiting for a yaw alignment
+    if (frontend->warm_start.valid) {
+        stateStruct.quat.from_euler(frontend->warm_start.roll, frontend->warm_start.pitch, frontend->warm_start.yaw);
+    }
+
     // initialise dynamic states
     stateStruct.velocity.zero();
     stateStruct.position.zero();
@@ -559,6 +573,10 @@ bool NavEKF3_core::InitialiseFilterBootstrap(void)
     // set to true now that states have be initialised
     statesInitialised = true;
 
+    if (frontend->warm_start.valid) {
+        yawAlignComplete = true;
+    }
+
     // reset inactive biases
     for (uint8_t i=0; i<INS_MAX_INSTANCES; i++) {
         inactiveBias[i].gyro_bias.zero();
@@ -620,6 +638,60 @@ void NavEKF3_core::CovarianceInit()
 
 }
 
+#if EK3_FEATURE_PERF_ACCOUNTING
+/*
+  time source for the perf accounting. Replay on SITL and Linux runs
+  with the HAL clock stopped at the log time, so use the host clock
+ */
+uint64_t NavEKF3_core::perf_time_ns()
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+#else
+    return AP_HAL::micros64() * 1000ULL;
+#endif
+}
+
+NavEKF3_core::PerfScope::~PerfScope()
+{
+    const uint64_t dt_ns = perf_time_ns() - start_ns;
+    counter.count++;
+    counter.total_ns += dt_ns;
+    counter.max_ns = MAX(counter.max_ns, MIN(dt_ns, UINT32_MAX));
+}
+
+const char *NavEKF3_core::perf_step_name(PerfStep step)
+{
+    switch (step) {
+    case PerfStep::UPDATE_FILTER:
+        return "UpdateFilter";
+    case PerfStep::PREDICTION:
+        return "Prediction";
+    case PerfStep::MAG_FUSION:
+        return "MagFusion";
+    case PerfStep::VEL_POS_FUSION:
+        return "VelPosFusion";
+    case PerfStep::RNG_BCN_FUSION:
+        return "RngBcnFusion";
+    case PerfStep::FLOW_FUSION:
+        return "FlowFusion";
+    case PerfStep::BODY_ODOM_FUSION:
+        return "BodyOdomFusion";
+    case PerfStep::TAS_FUSION:
+        return "TasFusion";
+    case PerfStep::BETA_DRAG_FUSION:
+        return "BetaDragFusion";
+    case PerfStep::OUTPUT_PREDICTION:
+        return "OutputPrediction";
+    case PerfStep::NUM_STEPS:
+        break;
+    }
+    return "?";
+}
+#endif  // EK3_FEATURE_PERF_ACCOUNTING
+
 /********************************************************
 *                 UPDATE FUNCTIONS                      *
 ********************************************************/
@@ -631,6 +703,10 @@ void NavEKF3_core::UpdateFilter(bool predict)
         return;
     }
 
+#if EK3_FEATURE_PERF_ACCOUNTING
+    PerfScope perf_update(perf[uint8_t(PerfStep::UPDATE_FILTER)]);
+#endif
+
     fill_scratch_variables();
 
     // update sensor selection (for affinity)
@@ -646,22 +722,37 @@ void NavEKF3_core::UpdateFilter(bool predict)
 
     // Run the EKF equations to estimate at the fusion time horizon if new IMU data is available in the buffer
     if (runUpdates) {
-        // Predict states using IMU data from the delayed time horizon
-        UpdateStrapdownEquationsNED();
+        {
+#if EK3_FEATURE_PERF_ACCOUNTING
+            PerfScope perf_step(perf[uint8_t(PerfStep::PREDICTION)]);
+#endif
+            // Predict states using IMU data from the delayed time horizon
+            UpdateStrapdownEquationsNED();
 
-        // Predict the covariance growth
-        CovariancePrediction(nullptr);
+            // Predict the covariance growth
+            CovariancePrediction(nullptr);
+        }
 
         // Run the IMU prediction step for the GSF yaw estimator algorithm
         // using IMU and optionally true airspeed data.
         // Must be run before SelectMagFusion() to provide an up to date yaw estimate
         runYawEstimatorPrediction();
 
-        // Update states using  magnetometer or external yaw sensor data
-        SelectMagFusion();
+        {
+#if EK3_FEATURE_PERF_ACCOUNTING
+            PerfScope perf_step(perf[uint8_t(PerfStep::MAG_FUSION)]);
+#endif
+            // Update states using  magnetometer or external yaw sensor data
+            SelectMagFusion();
+        }
 
-        // Update states using GPS and altimeter data
-        SelectVelPosFusion();
+        {
+#if EK3_FEATURE_PERF_ACCOUNTING
+            PerfScope perf_step(perf[uint8_t(PerfStep::VEL_POS_FUSION)]);
+#endif
+            // Update states using GPS and altimeter data
+            SelectVelPosFusion();
+        }
 
         // Run the GPS velocity correction step for the GSF yaw estimator algorithm
         // and use the yaw estimate to reset the main EKF yaw if requested
@@ -669,25 +760,50 @@ void NavEKF3_core::UpdateFilter(bool predict)
         runYawEstimatorCorrection();
 
 #if EK3_FEATURE_BEACON_FUSION
-        // Update states using range beacon data
-        SelectRngBcnFusion();
+        {
+#if EK3_FEATURE_PERF_ACCOUNTING
+            PerfScope perf_step(perf[uint8_t(PerfStep::RNG_BCN_FUSION)]);
+#endif
+            // Update states using range beacon data
+            SelectRngBcnFusion();
+        }
 #endif
 
 #if EK3_FEATURE_OPTFLOW_FUSION
-        // Update states using optical flow data
-        SelectFlowFusion();
+        {
+#if EK3_FEATURE_PERF_ACCOUNTING
+            PerfScope perf_step(perf[uint8_t(PerfStep::FLOW_FUSION)]);
+#endif
+            // Update states using optical flow data
+            SelectFlowFusion();
+        }
 #endif
 
 #if EK3_FEATURE_BODY_ODOM
-        // Update states using body frame odometry data
-        SelectBodyOdomFusion();
+        {
+#if EK3_FEATURE_PERF_ACCOUNTING
+            PerfScope perf_step(perf[uint8_t(PerfStep::BODY_ODOM_FUSION)]);
+#endif
+            // Update states using body frame odometry data
+            SelectBodyOdomFusion();
+        }
 #endif
 
-        // Update states using airspeed data
-        SelectTasFusion();
+        {
+#if EK3_FEATURE_PERF_ACCOUNTING
+            PerfScope perf_step(perf[uint8_t(PerfStep::TAS_FUSION)]);
+#endif
+            // Update states using airspeed data
+            SelectTasFusion();
+        }
 
-        // Update states using sideslip constraint assumption for fly-forward vehicles or body drag for multicopters
-        SelectBetaDragFusion();
+        {
+#if EK3_FEATURE_PERF_ACCOUNTING
+            PerfScope perf_step(perf[uint8_t(PerfStep::BETA_DRAG_FUSION)]);
+#endif
+            // Update states using sideslip constraint assumption for fly-forward vehicles or body drag for multicopters
+            SelectBetaDragFusion();
+        }
 
         // Update the filter status
         updateFilterStatus();
@@ -700,8 +816,13 @@ void NavEKF3_core::UpdateFilter(bool predict)
         }
     }
 
-    // Wind output forward from the fusion to output time horizon
-    calcOutputStates();
+    {
+#if EK3_FEATURE_PERF_ACCOUNTING
+        PerfScope perf_step(perf[uint8_t(PerfStep::OUTPUT_PREDICTION)]);
+#endif
+        // Wind output forward from the fusion to output time horizon
+        calcOutputStates();
+    }
 
     /*
       this is a check to cope with a vehicle sitting idle on the
@@ -1481,6 +1602,10 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
     nextP[8][9] = P[5][9]*dt + P[8][9] + dt*(P[5][6]*dt + P[6][8]);
     nextP[9][9] = P[6][9]*dt + P[9][9] + dt*(P[6][6]*dt + P[6][9]);
 
+    // The bias, earth field, body field and wind states have an identity state transition,
+    // so the cross covariances between them are unchanged by the prediction. Only the
+    // diagonals are written to nextP for those states; the off diagonals are left in P
+    // and are skipped when nextP is copied back below.
     if (stateIndexLim > 9) {
         nextP[0][10] = PS14;
         nextP[1][10] = PS105;
@@ -1503,7 +1628,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
         nextP[7][11] = P[4][11]*dt + P[7][11];
         nextP[8][11] = P[5][11]*dt + P[8][11];
         nextP[9][11] = P[6][11]*dt + P[9][11];
-        nextP[10][11] = P[10][11];
         nextP[11][11] = P[11][11];
         nextP[0][12] = PS20;
         nextP[1][12] = PS107;
@@ -1515,8 +1639,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
         nextP[7][12] = P[4][12]*dt + P[7][12];
         nextP[8][12] = P[5][12]*dt + P[8][12];
         nextP[9][12] = P[6][12]*dt + P[9][12];
-        nextP[10][12] = P[10][12];
-        nextP[11][12] = P[11][12];
         nextP[12][12] = P[12][12];
 
         if (stateIndexLim > 12) {
@@ -1530,9 +1652,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
             nextP[7][13] = P[4][13]*dt + P[7][13];
             nextP[8][13] = P[5][13]*dt + P[8][13];
             nextP[9][13] = P[6][13]*dt + P[9][13];
-            nextP[10][13] = P[10][13];
-            nextP[11][13] = P[11][13];
-            nextP[12][13] = P[12][13];
             nextP[13][13] = P[13][13];
             nextP[0][14] = PS57;
             nextP[1][14] = PS117;
@@ -1544,10 +1663,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
             nextP[7][14] = P[4][14]*dt + P[7][14];
             nextP[8][14] = P[5][14]*dt + P[8][14];
             nextP[9][14] = P[6][14]*dt + P[9][14];
-            nextP[10][14] = P[10][14];
-            nextP[11][14] = P[11][14];
-            nextP[12][14] = P[12][14];
-            nextP[13][14] = P[13][14];
             nextP[14][14] = P[14][14];
             nextP[0][15] = PS46;
             nextP[1][15] = PS114;
@@ -1559,11 +1674,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
             nextP[7][15] = P[4][15]*dt + P[7][15];
             nextP[8][15] = P[5][15]*dt + P[8][15];
             nextP[9][15] = P[6][15]*dt + P[9][15];
-            nextP[10][15] = P[10][15];
-            nextP[11][15] = P[11][15];
-            nextP[12][15] = P[12][15];
-            nextP[13][15] = P[13][15];
-            nextP[14][15] = P[14][15];
             nextP[15][15] = P[15][15];
 
             if (stateIndexLim > 15) {
@@ -1577,12 +1687,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
                 nextP[7][16] = P[4][16]*dt + P[7][16];
                 nextP[8][16] = P[5][16]*dt + P[8][16];
                 nextP[9][16] = P[6][16]*dt + P[9][16];
-                nextP[10][16] = P[10][16];
-                nextP[11][16] = P[11][16];
-                nextP[12][16] = P[12][16];
-                nextP[13][16] = P[13][16];
-                nextP[14][16] = P[14][16];
-                nextP[15][16] = P[15][16];
                 nextP[16][16] = P[16][16];
                 nextP[0][17] = -PS11*P[1][17] - PS12*P[2][17] - PS13*P[3][17] + PS6*P[10][17] + PS7*P[11][17] + PS9*P[12][17] + P[0][17];
                 nextP[1][17] = PS11*P[0][17] - PS12*P[3][17] + PS13*P[2][17] - PS34*P[10][17] - PS7*P[12][17] + PS9*P[11][17] + P[1][17];
@@ -1594,13 +1698,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
                 nextP[7][17] = P[4][17]*dt + P[7][17];
                 nextP[8][17] = P[5][17]*dt + P[8][17];
                 nextP[9][17] = P[6][17]*dt + P[9][17];
-                nextP[10][17] = P[10][17];
-                nextP[11][17] = P[11][17];
-                nextP[12][17] = P[12][17];
-                nextP[13][17] = P[13][17];
-                nextP[14][17] = P[14][17];
-                nextP[15][17] = P[15][17];
-                nextP[16][17] = P[16][17];
                 nextP[17][17] = P[17][17];
                 nextP[0][18] = -PS11*P[1][18] - PS12*P[2][18] - PS13*P[3][18] + PS6*P[10][18] + PS7*P[11][18] + PS9*P[12][18] + P[0][18];
                 nextP[1][18] = PS11*P[0][18] - PS12*P[3][18] + PS13*P[2][18] - PS34*P[10][18] - PS7*P[12][18] + PS9*P[11][18] + P[1][18];
@@ -1612,14 +1709,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
                 nextP[7][18] = P[4][18]*dt + P[7][18];
                 nextP[8][18] = P[5][18]*dt + P[8][18];
                 nextP[9][18] = P[6][18]*dt + P[9][18];
-                nextP[10][18] = P[10][18];
-                nextP[11][18] = P[11][18];
-                nextP[12][18] = P[12][18];
-                nextP[13][18] = P[13][18];
-                nextP[14][18] = P[14][18];
-                nextP[15][18] = P[15][18];
-                nextP[16][18] = P[16][18];
-                nextP[17][18] = P[17][18];
                 nextP[18][18] = P[18][18];
                 nextP[0][19] = -PS11*P[1][19] - PS12*P[2][19] - PS13*P[3][19] + PS6*P[10][19] + PS7*P[11][19] + PS9*P[12][19] + P[0][19];
                 nextP[1][19] = PS11*P[0][19] - PS12*P[3][19] + PS13*P[2][19] - PS34*P[10][19] - PS7*P[12][19] + PS9*P[11][19] + P[1][19];
@@ -1631,15 +1720,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
                 nextP[7][19] = P[4][19]*dt + P[7][19];
                 nextP[8][19] = P[5][19]*dt + P[8][19];
                 nextP[9][19] = P[6][19]*dt + P[9][19];
-                nextP[10][19] = P[10][19];
-                nextP[11][19] = P[11][19];
-                nextP[12][19] = P[12][19];
-                nextP[13][19] = P[13][19];
-                nextP[14][19] = P[14][19];
-                nextP[15][19] = P[15][19];
-                nextP[16][19] = P[16][19];
-                nextP[17][19] = P[17][19];
-                nextP[18][19] = P[18][19];
                 nextP[19][19] = P[19][19];
                 nextP[0][20] = -PS11*P[1][20] - PS12*P[2][20] - PS13*P[3][20] + PS6*P[10][20] + PS7*P[11][20] + PS9*P[12][20] + P[0][20];
                 nextP[1][20] = PS11*P[0][20] - PS12*P[3][20] + PS13*P[2][20] - PS34*P[10][20] - PS7*P[12][20] + PS9*P[11][20] + P[1][20];
@@ -1651,16 +1731,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
                 nextP[7][20] = P[4][20]*dt + P[7][20];
                 nextP[8][20] = P[5][20]*dt + P[8][20];
                 nextP[9][20] = P[6][20]*dt + P[9][20];
-                nextP[10][20] = P[10][20];
-                nextP[11][20] = P[11][20];
-                nextP[12][20] = P[12][20];
-                nextP[13][20] = P[13][20];
-                nextP[14][20] = P[14][20];
-                nextP[15][20] = P[15][20];
-                nextP[16][20] = P[16][20];
-                nextP[17][20] = P[17][20];
-                nextP[18][20] = P[18][20];
-                nextP[19][20] = P[19][20];
                 nextP[20][20] = P[20][20];
                 nextP[0][21] = -PS11*P[1][21] - PS12*P[2][21] - PS13*P[3][21] + PS6*P[10][21] + PS7*P[11][21] + PS9*P[12][21] + P[0][21];
                 nextP[1][21] = PS11*P[0][21] - PS12*P[3][21] + PS13*P[2][21] - PS34*P[10][21] - PS7*P[12][21] + PS9*P[11][21] + P[1][21];
@@ -1672,17 +1742,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
                 nextP[7][21] = P[4][21]*dt + P[7][21];
                 nextP[8][21] = P[5][21]*dt + P[8][21];
                 nextP[9][21] = P[6][21]*dt + P[9][21];
-                nextP[10][21] = P[10][21];
-                nextP[11][21] = P[11][21];
-                nextP[12][21] = P[12][21];
-                nextP[13][21] = P[13][21];
-                nextP[14][21] = P[14][21];
-                nextP[15][21] = P[15][21];
-                nextP[16][21] = P[16][21];
-                nextP[17][21] = P[17][21];
-                nextP[18][21] = P[18][21];
-                nextP[19][21] = P[19][21];
-                nextP[20][21] = P[20][21];
                 nextP[21][21] = P[21][21];
 
                 if (stateIndexLim > 21) {
@@ -1696,18 +1755,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
                     nextP[7][22] = P[4][22]*dt + P[7][22];
                     nextP[8][22] = P[5][22]*dt + P[8][22];
                     nextP[9][22] = P[6][22]*dt + P[9][22];
-                    nextP[10][22] = P[10][22];
-                    nextP[11][22] = P[11][22];
-                    nextP[12][22] = P[12][22];
-                    nextP[13][22] = P[13][22];
-                    nextP[14][22] = P[14][22];
-                    nextP[15][22] = P[15][22];
-                    nextP[16][22] = P[16][22];
-                    nextP[17][22] = P[17][22];
-                    nextP[18][22] = P[18][22];
-                    nextP[19][22] = P[19][22];
-                    nextP[20][22] = P[20][22];
-                    nextP[21][22] = P[21][22];
                     nextP[22][22] = P[22][22];
                     nextP[0][23] = -PS11*P[1][23] - PS12*P[2][23] - PS13*P[3][23] + PS6*P[10][23] + PS7*P[11][23] + PS9*P[12][23] + P[0][23];
                     nextP[1][23] = PS11*P[0][23] - PS12*P[3][23] + PS13*P[2][23] - PS34*P[10][23] - PS7*P[12][23] + PS9*P[11][23] + P[1][23];
@@ -1719,19 +1766,6 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
                     nextP[7][23] = P[4][23]*dt + P[7][23];
                     nextP[8][23] = P[5][23]*dt + P[8][23];
                     nextP[9][23] = P[6][23]*dt + P[9][23];
-                    nextP[10][23] = P[10][23];
-                    nextP[11][23] = P[11][23];
-                    nextP[12][23] = P[12][23];
-                    nextP[13][23] = P[13][23];
-                    nextP[14][23] = P[14][23];
-                    nextP[15][23] = P[15][23];
-                    nextP[16][23] = P[16][23];
-                    nextP[17][23] = P[17][23];
-                    nextP[18][23] = P[18][23];
-                    nextP[19][23] = P[19][23];
-                    nextP[20][23] = P[20][23];
-                    nextP[21][23] = P[21][23];
-                    nextP[22][23] = P[22][23];
                     nextP[23][23] = P[23][23];
                 }
             }
@@ -1753,6 +1787,10 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
             if (dvelBiasAxisInhibit[index]) {
                 zeroCols(nextP,stateIndex,stateIndex);
                 nextP[stateIndex][stateIndex] = dvelBiasAxisVarPrev[index];
+                // cross covariances with the other bias states are not held in nextP
+                for (uint8_t column=10; column<stateIndex; column++) {
+                    P[column][stateIndex] = 0.0f;
+                }
             }
         }
     }
@@ -1778,9 +1816,14 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
         // copy diagonals
         P[row][row] = nextP[row][row];
         // copy off diagonals
-        for (uint8_t column = 0 ; column < row; column++) {
+        const uint8_t kinematicLim = MIN(row, 10);
+        for (uint8_t column = 0 ; column < kinematicLim; column++) {
             P[row][column] = P[column][row] = nextP[column][row];
         }
+        // off diagonals between states with an identity transition are unchanged
+        for (uint8_t column = kinematicLim; column < row; column++) {
+            P[row][column] = P[column][row];
+        }
     }
 
     // constrain values to prevent ill-conditioning
@@ -2256,12 +2299,17 @@ void NavEKF3_core::verifyTiltErrorVariance()
 /*
   move the EKF origin to the current position at 1Hz. The public_origin doesn't move.
   By moving the EKF origin we keep the distortion due to spherical
-  shape of the earth to a minimum.
+  shape of the earth to a minimum, and the position states stay small
+  enough for single precision however far we fly from the public_origin.
  */
 void NavEKF3_core::moveEKFOrigin(void)
 {
-    // only move origin when we have a origin and we're using GPS
-    if (!frontend->common_origin_valid || !filterStatus.flags.using_gps) {
+    // only move origin when we have a origin and are navigating
+    // against it. This includes dead reckoning after losing GPS, where
+    // the distance flown can be large. Beacon positions are fixed
+    // relative to the EKF origin so it can't move while they are used
+    if (!frontend->common_origin_valid || PV_AidingMode != AID_ABSOLUTE ||
+        frontend->sources.getPosXYSource() == AP_NavEKF_Source::SourceXY::BEACON) {
         return;
     }
 
@@ -469,8 +469,49 @@ public:
     // failure message
     // requires_position should be true if horizontal position configuration should be checked
     bool pre_arm_check(bool requires_position, char *failure_msg, uint8_t failure_msg_len) const;
-    
+
+#if EK3_FEATURE_PERF_ACCOUNTING
+    // steps of UpdateFilter() whose CPU time is accounted
+    enum class PerfStep : uint8_t {
+        UPDATE_FILTER = 0,  // the whole of UpdateFilter()
+        PREDICTION,         // state and covariance prediction
+        MAG_FUSION,
+        VEL_POS_FUSION,
+        RNG_BCN_FUSION,
+        FLOW_FUSION,
+        BODY_ODOM_FUSION,
+        TAS_FUSION,
+        BETA_DRAG_FUSION,
+        OUTPUT_PREDICTION,
+        NUM_STEPS
+    };
+    struct PerfCounter {
+        uint32_t count;
+        uint64_t total_ns;
+        uint32_t max_ns;
+    };
+    const PerfCounter &get_perf(PerfStep step) const { return perf[uint8_t(step)]; }
+    static const char *perf_step_name(PerfStep step);
+#endif
+
 private:
+#if EK3_FEATURE_PERF_ACCOUNTING
+    PerfCounter perf[uint8_t(PerfStep::NUM_STEPS)];
+
+    // accounts the time from construction to destruction to a step
+    class PerfScope {
+    public:
+        PerfScope(PerfCounter &_counter) :
+            counter(_counter),
+            start_ns(perf_time_ns()) {}
+        ~PerfScope();
+    private:
+        PerfCounter &counter;
+        const uint64_t start_ns;
+    };
+    static uint64_t perf_time_ns();
+#endif
+
     EKFGSF_yaw *yawEstimator;
     AP_DAL &dal;
 
@@ -808,6 +849,9 @@ private:
 #if EK3_FEATURE_BEACON_FUSION
     // check for new range beacon data and update stored measurements if available
     void readRngBcnData();
+
+    // recall the oldest range beacon measurement overtaken by the fusion time horizon, returns false if none
+    bool recallRngBcnData();
 #endif
 
     // determine when to perform fusion of GPS position and  velocity measurements
@@ -1054,6 +1098,7 @@ private:
     void FuseDragForces();
     void SelectDragFusion();
     void SampleDragData(const imu_elements &imu);
+    bool dragCoefficientsSet() const;
 
     bool getGPSLLH(Location &loc) const;
 
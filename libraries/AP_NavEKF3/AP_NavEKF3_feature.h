@@ -46,3 +46,13 @@
 #ifndef EK3_FEATURE_OPTFLOW_FUSION
 #define EK3_FEATURE_OPTFLOW_FUSION HAL_NAVEKF3_AVAILABLE && AP_OPTICALFLOW_ENABLED
 #endif
+
+// per-lane CPU time of each update step, reported by Replay --perf
+#ifndef EK3_FEATURE_PERF_ACCOUNTING
+#define EK3_FEATURE_PERF_ACCOUNTING APM_BUILD_TYPE(APM_BUILD_Replay)
+#endif
+
+// run the lanes in parallel on worker threads on multi-core Linux boards
+#ifndef EK3_FEATURE_PARALLEL_LANES
+#define EK3_FEATURE_PARALLEL_LANES (CONFIG_HAL_BOARD == HAL_BOARD_LINUX) && !APM_BUILD_TYPE(APM_BUILD_Replay)
+#endif
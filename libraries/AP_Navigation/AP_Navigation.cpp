@@ -0,0 +1,38 @@
+#include "AP_Navigation.h"
+
+/*
+  recompute the NE vectors for the current location. The vector from
+  the vehicle to the next waypoint is found from the other two, saving
+  a longitude scale calculation. Its error is proportional to the
+  remaining distance and is negligible at the waypoint
+ */
+void AP_Navigation::WaypointGeometry::update(const Location &prev_WP, const Location &next_WP, const Location &current_loc)
+{
+    if (!_valid || !prev_WP.same_latlon_as(_prev_WP) || !next_WP.same_latlon_as(_next_WP)) {
+        prev_to_next = prev_WP.get_distance_NE(next_WP);
+        _prev_WP = prev_WP;
+        _next_WP = next_WP;
+    }
+    prev_to_current = prev_WP.get_distance_NE(current_loc);
+    current_to_next = prev_to_next - prev_to_current;
+    _current_loc = current_loc;
+    _valid = true;
+}
+
+bool AP_Navigation::WaypointGeometry::matches(const Location &prev_WP, const Location &next_WP, const Location &current_loc) const
+{
+    return _valid &&
+        prev_WP.same_latlon_as(_prev_WP) &&
+        next_WP.same_latlon_as(_next_WP) &&
+        current_loc.same_latlon_as(_current_loc);
+}
+
+float AP_Navigation::WaypointGeometry::path_proportion() const
+{
+    const float dsquared = prev_to_next.length_squared();
+    if (dsquared < 0.001f) {
+        // the two points are very close together
+        return 1.0f;
+    }
+    return (prev_to_next * prev_to_current) / dsquared;
+}
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <AP_Common/AP_Common.h>
+#include <AP_Common/Location.h>
 
 class AP_Navigation {
 public:
@@ -116,6 +117,40 @@ public:
 
     virtual void set_reverse(bool reverse) = 0;
 
+    // WaypointGeometry holds the NE vectors between the previous
+    // waypoint, the next waypoint and the vehicle, so a vehicle that
+    // needs them for its own navigation can share them with the
+    // controller rather than each computing them from the locations
+    class WaypointGeometry {
+    public:
+        // recompute the vectors for the current location. The leg
+        // vector is only recomputed when the waypoints change
+        void update(const Location &prev_WP, const Location &next_WP, const Location &current_loc);
+
+        // true if the vectors were computed for these locations
+        bool matches(const Location &prev_WP, const Location &next_WP, const Location &current_loc) const;
+
+        // proportion along the path from the previous to the next
+        // waypoint, as Location::line_path_proportion()
+        float path_proportion() const;
+
+        Vector2f prev_to_next;      // NE from the previous to the next waypoint in meters
+        Vector2f prev_to_current;   // NE from the previous waypoint to the vehicle in meters
+        Vector2f current_to_next;   // NE from the vehicle to the next waypoint in meters
+
+    private:
+        Location _prev_WP;
+        Location _next_WP;
+        Location _current_loc;
+        bool _valid = false;
+    };
+
+    // give the controller geometry shared by the vehicle, which it may
+    // use in update_waypoint() when it matches the locations passed
+    void set_waypoint_geometry(const WaypointGeometry *geometry) {
+        _waypoint_geometry = geometry;
+    }
+
     // add new navigation controllers to this enum. Users can then
     // select which navigation controller to use by setting the
     // NAV_CONTROLLER parameter
@@ -123,4 +158,7 @@ public:
         CONTROLLER_DEFAULT      = 0,
         CONTROLLER_L1           = 1
     };
+
+protected:
+    const WaypointGeometry *_waypoint_geometry = nullptr;
 };
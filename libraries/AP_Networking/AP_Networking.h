@@ -293,6 +293,9 @@ private:
         uint32_t rx_stats_bytes;
 
         HAL_Semaphore sem;
+        // held by the port thread across socket calls that use the
+        // buffers directly
+        HAL_Semaphore io_sem;
 
     protected:
 #if HAL_UART_STATS_ENABLED
@@ -117,7 +117,7 @@ void AP_Networking_CAN::mcast_server(void)
         }
 
         if (!cbus->register_frame_callback(
-                FUNCTOR_BIND_MEMBER(&AP_Networking_CAN::can_frame_callback, void, uint8_t, const AP_HAL::CANFrame &, AP_HAL::CANIface::CanIOFlags),
+                FUNCTOR_BIND_MEMBER(&AP_Networking_CAN::can_frame_callback, void, uint8_t, const AP_HAL::CANFrame &, AP_HAL::CANIface::CanIOFlags, uint64_t),
                 callback_id)) {
             GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "CAN_MCAST[%u]: failed to register", unsigned(bus));
             goto de_allocate;
@@ -215,7 +215,7 @@ void AP_Networking_CAN::mcast_server(void)
   handler for CAN frames from the registered callback, sending frames
   out as multicast UDP
  */
-void AP_Networking_CAN::can_frame_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags)
+void AP_Networking_CAN::can_frame_callback(uint8_t bus, const AP_HAL::CANFrame &frame, AP_HAL::CANIface::CanIOFlags flags, uint64_t timestamp_us)
 {
     if (bus >= HAL_NUM_CAN_IFACES || mcast_sockets[bus] == nullptr) {
         return;
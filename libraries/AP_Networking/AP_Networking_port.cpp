@@ -25,6 +25,12 @@ extern const AP_HAL::HAL& hal;
 #define AP_NETWORKING_PORT_MIN_RXSIZE 2048
 #endif
 
+// largest send or receive in one socket call. UDP MAVLink ports pack
+// as many whole packets as fit into each datagram
+#ifndef AP_NETWORKING_PORT_MAX_DATAGRAM
+#define AP_NETWORKING_PORT_MAX_DATAGRAM 1400
+#endif
+
 #ifndef AP_NETWORKING_PORT_STACK_SIZE
 #define AP_NETWORKING_PORT_STACK_SIZE 1024
 #endif
@@ -315,23 +321,32 @@ void AP_Networking::Port::tcp_client_loop(void)
 
 /*
   run one send/receive loop
+
+  Data is received straight into the read buffer and sent straight
+  from the write buffer, using scatter/gather socket calls to cover
+  both parts when the data wraps around the end of the ring
+  buffer. io_sem is held
+  across the socket calls so the buffers can't be reallocated under
+  us, while sem is only held to update the buffer pointers, so
+  writers are not blocked by the network stack.
  */
 bool AP_Networking::Port::send_receive(void)
 {
+    WITH_SEMAPHORE(io_sem);
 
     bool active = false;
-    uint32_t space;
-
 
     // handle incoming packets
+    ByteBuffer::IoVec vec[2];
+    uint8_t nvec;
     {
         WITH_SEMAPHORE(sem);
-        space = readbuffer->space();
+        nvec = readbuffer->reserve(vec, AP_NETWORKING_PORT_MAX_DATAGRAM);
     }
-    if (space > 0) {
-        const uint32_t n = MIN(300U, space);
-        uint8_t buf[n];
-        const auto ret = sock->recv(buf, n, 0);
+    if (nvec > 0) {
+        // a datagram must be received in one call, so receive into
+        // both parts of the space if it wraps
+        const ssize_t ret = sock->recvv(vec, nvec, 0);
         if (close_on_recv_error && ret == 0) {
             GCS_SEND_TEXT(MAV_SEVERITY_INFO, "TCP[%u]: closed connection", unsigned(state.idx));
             delete sock;
@@ -339,8 +354,10 @@ bool AP_Networking::Port::send_receive(void)
             return false;
         }
         if (ret > 0) {
-            WITH_SEMAPHORE(sem);
-            readbuffer->write(buf, ret);
+            {
+                WITH_SEMAPHORE(sem);
+                readbuffer->commit(ret);
+            }
 
             // Cant track dropped read packets because we only read in what there is space for
             // The socket buffer becomes full and data is lost there
@@ -382,25 +399,17 @@ bool AP_Networking::Port::send_receive(void)
         {
             WITH_SEMAPHORE(sem);
             available = writebuffer->available();
-            available = MIN(300U, available);
+            available = MIN(uint32_t(AP_NETWORKING_PORT_MAX_DATAGRAM), available);
 #if AP_MAVLINK_PACKETISE_ENABLED
             if (packetise) {
-                available = mavlink_packetise(*writebuffer, available);
+                available = mavlink_packetise_multiple(*writebuffer, available);
             }
 #endif
-            if (available == 0) {
-                return active;
-            }
-        }
-        uint8_t buf[available];
-        uint32_t n;
-        {
-            WITH_SEMAPHORE(sem);
-            n = writebuffer->peekbytes(buf, available);
+            nvec = available > 0 ? writebuffer->peekiovec(vec, available) : 0;
         }
 
         // nothing to send return
-        if (n <= 0) {
+        if (nvec == 0) {
             return active;
         }
 
@@ -408,11 +417,11 @@ bool AP_Networking::Port::send_receive(void)
         if (type == NetworkPortType::UDP_SERVER) {
             // UDP Server uses sendto, allowing us to change the destination address port on the fly
             if(last_udp_connect_address != 0 && last_udp_connect_port != 0) {
-                ret = sock->sendto(buf, n, last_udp_connect_address, last_udp_connect_port);
+                ret = sock->sendtov(vec, nvec, last_udp_connect_address, last_udp_connect_port);
             }
         } else {
             // TCP Server and Client and UDP Client use send
-            ret = sock->send(buf, n);
+            ret = sock->sendv(vec, nvec);
         }
 
         if (ret > 0) {
@@ -471,6 +480,7 @@ uint32_t AP_Networking::Port::_available()
 
 bool AP_Networking::Port::_discard_input()
 {
+    WITH_SEMAPHORE(io_sem);
     WITH_SEMAPHORE(sem);
     readbuffer->clear();
     return true;
@@ -485,6 +495,7 @@ bool AP_Networking::Port::init_buffers(const uint32_t size_rx, const uint32_t si
         size_rx == last_size_rx) {
         return true;
     }
+    WITH_SEMAPHORE(io_sem);
     WITH_SEMAPHORE(sem);
     if (readbuffer == nullptr) {
         readbuffer = NEW_NOTHROW ByteBuffer(size_rx);
@@ -68,10 +68,17 @@ void AP_OSD_MSP_DisplayPort::clear(void)
         const uint8_t txt_resolution = _osd.screen[_osd.get_current_screen()].get_txt_resolution();
         const uint8_t font_index = _osd.screen[_osd.get_current_screen()].get_font_index();
         _displayport->msp_displayport_set_options(font_index, txt_resolution);
+        // a new font or resolution needs the whole screen to be redrawn
+        const int16_t screen_options = (font_index << 8) | txt_resolution;
+        if (screen_options != last_screen_options) {
+            last_screen_options = screen_options;
+            last_full_redraw_ms = 0;
+        }
     }
 
-    // clear remote MSP screen
-    _displayport->msp_displayport_clear_screen();
+    // clear the local frame, only changes are sent to the remote MSP screen
+    memset(frame, ' ', sizeof(frame));
+    memset(frame_table, 0, sizeof(frame_table));
 
     // toggle flashing @1Hz
     const uint32_t now = AP_HAL::millis();
@@ -90,7 +97,77 @@ void AP_OSD_MSP_DisplayPort::write(uint8_t x, uint8_t y, const char* text)
         return;
     }
 #endif
-    _displayport->msp_displayport_write_string(x, y, false, text, 0);
+    write_frame(x, y, text, 0);
+}
+
+// store text in the frame buffer using the given font table
+void AP_OSD_MSP_DisplayPort::write_frame(uint8_t x, uint8_t y, const char* text, uint8_t font_table)
+{
+    if (y >= DISPLAYPORT_MAX_ROWS || text == nullptr) {
+        return;
+    }
+    while ((x < DISPLAYPORT_MAX_COLUMNS) && (*text != 0)) {
+        frame[y][x] = *text;
+        if (font_table) {
+            frame_table[y] |= (1ULL << x);
+        } else {
+            frame_table[y] &= ~(1ULL << x);
+        }
+        ++text;
+        ++x;
+    }
+}
+
+bool AP_OSD_MSP_DisplayPort::is_dirty(uint8_t x, uint8_t y) const
+{
+    if (y >= DISPLAYPORT_MAX_ROWS || x >= DISPLAYPORT_MAX_COLUMNS) {
+        return false;
+    }
+    return frame[y][x] != shadow_frame[y][x] ||
+        get_font_table(frame_table, x, y) != get_font_table(shadow_frame_table, x, y);
+}
+
+/*
+  send changed cells as strings, each string is a run of cells on one
+  row using the same font table. A run continues over up to 4 unchanged
+  cells, as that is cheaper than the header of a new string
+ */
+void AP_OSD_MSP_DisplayPort::transfer_frame(bool full_redraw)
+{
+    const uint8_t max_gap = 4;
+    for (uint8_t y=0; y<DISPLAYPORT_MAX_ROWS; y++) {
+        uint8_t x = 0;
+        while (x < DISPLAYPORT_MAX_COLUMNS) {
+            // find the start of a run, on a full redraw blank cells
+            // are already cleared on the remote screen
+            // a zero can't be sent as it terminates the string
+            if ((full_redraw ? frame[y][x] == ' ' : !is_dirty(x, y)) || frame[y][x] == 0) {
+                x++;
+                continue;
+            }
+            const uint8_t start = x;
+            const uint8_t font_table = get_font_table(frame_table, start, y);
+            uint8_t len = 0;
+            uint8_t gap = 0;
+            while (x < DISPLAYPORT_MAX_COLUMNS && (x - start) < DISPLAYPORT_WRITE_BUFFER_MAX_LEN-1 &&
+                   frame[y][x] != 0 && get_font_table(frame_table, x, y) == font_table) {
+                if (full_redraw ? frame[y][x] != ' ' : is_dirty(x, y)) {
+                    gap = 0;
+                    len = x - start + 1;
+                } else if (++gap > max_gap) {
+                    break;
+                }
+                x++;
+            }
+            x = start + len;
+
+            memcpy(displayport_write_buffer, &frame[y][start], len);
+            displayport_write_buffer[len] = 0;
+            _displayport->msp_displayport_write_string(start, y, false, displayport_write_buffer, font_table);
+        }
+    }
+    memcpy(shadow_frame, frame, sizeof(shadow_frame));
+    memcpy(shadow_frame_table, frame_table, sizeof(shadow_frame_table));
 }
 
 #if AP_MSP_INAV_FONTS_ENABLED
@@ -115,7 +192,7 @@ void AP_OSD_MSP_DisplayPort::write_INAV(uint8_t x, uint8_t y, const char* text)
 
         if (inav_table != last_inav_table) {
             displayport_write_buffer[buf_idx] = 0x00; // add a terminator
-            _displayport->msp_displayport_write_string(x + x_offset, y, false, displayport_write_buffer, last_inav_table);
+            write_frame(x + x_offset, y, displayport_write_buffer, last_inav_table);
             x_offset += buf_idx;
             buf_idx = 0;
             last_inav_table = inav_table;
@@ -126,7 +203,7 @@ void AP_OSD_MSP_DisplayPort::write_INAV(uint8_t x, uint8_t y, const char* text)
         if (idx == max_idx) {
             // flush when we detect end of string
             displayport_write_buffer[buf_idx] = 0x00; // add a terminator
-            _displayport->msp_displayport_write_string(x+x_offset, y, false, displayport_write_buffer, inav_table);
+            write_frame(x+x_offset, y, displayport_write_buffer, inav_table);
         }
         idx++;
     }
@@ -142,8 +219,19 @@ uint8_t AP_OSD_MSP_DisplayPort::format_string_for_osd(char* buff, uint8_t size,
 
 void AP_OSD_MSP_DisplayPort::flush(void)
 {
-    // grab the screen and force a redraw
+    // grab the screen
     _displayport->msp_displayport_grab();
+
+    // send changes, with a periodic full redraw
+    const uint32_t now_ms = AP_HAL::millis();
+    const bool full_redraw = last_full_redraw_ms == 0 || now_ms - last_full_redraw_ms >= DISPLAYPORT_FULL_REDRAW_MS;
+    if (full_redraw) {
+        last_full_redraw_ms = now_ms;
+        _displayport->msp_displayport_clear_screen();
+    }
+    transfer_frame(full_redraw);
+
+    // force a redraw
     _displayport->msp_displayport_draw_screen();
 
     // ok done processing displayport data
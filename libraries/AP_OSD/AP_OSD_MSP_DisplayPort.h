@@ -5,6 +5,14 @@
 
 #define DISPLAYPORT_WRITE_BUFFER_MAX_LEN 30
 
+// largest DisplayPort text grid, the HD 60x22 resolution
+#define DISPLAYPORT_MAX_COLUMNS 60
+#define DISPLAYPORT_MAX_ROWS 22
+
+// the whole screen is resent at this interval so that the remote
+// display recovers from lost packets or a restart
+#define DISPLAYPORT_FULL_REDRAW_MS 1000
+
 class AP_OSD_MSP_DisplayPort : public AP_OSD_Backend
 {
     using AP_OSD_Backend::AP_OSD_Backend;
@@ -58,8 +66,28 @@ protected:
 
 private:
     void setup_defaults(void);
+
+    // store text in the frame buffer using the given font table
+    void write_frame(uint8_t x, uint8_t y, const char* text, uint8_t font_table);
+
+    // cell and font table helpers for the frame buffers
+    uint8_t get_font_table(const uint64_t table_bits[], uint8_t x, uint8_t y) const { return (table_bits[y] >> x) & 1U; }
+    bool is_dirty(uint8_t x, uint8_t y) const;
+
+    // send the cells that changed since the last flush, or all of them if full_redraw is set
+    void transfer_frame(bool full_redraw);
+
     char displayport_write_buffer[DISPLAYPORT_WRITE_BUFFER_MAX_LEN]; // terminator
 
+    // frame being drawn and the frame already sent to the remote display
+    // font table is one bit per cell, used with INAV fonts
+    uint8_t frame[DISPLAYPORT_MAX_ROWS][DISPLAYPORT_MAX_COLUMNS];
+    uint8_t shadow_frame[DISPLAYPORT_MAX_ROWS][DISPLAYPORT_MAX_COLUMNS];
+    uint64_t frame_table[DISPLAYPORT_MAX_ROWS];
+    uint64_t shadow_frame_table[DISPLAYPORT_MAX_ROWS];
+    uint32_t last_full_redraw_ms;
+    int16_t last_screen_options = -1;   // font index and resolution last sent, -1 if never sent
+
     AP_MSP_Telem_Backend* _displayport;
 
     // MSP DisplayPort symbols
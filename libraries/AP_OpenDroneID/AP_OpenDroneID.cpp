@@ -232,17 +232,13 @@ void AP_OpenDroneID::update()
     send_dynamic_out();
     send_static_out();
 #if HAL_ENABLE_DRONECAN_DRIVERS
-    uint8_t can_num_drivers = AP::can().get_num_drivers();
-    for (uint8_t i = 0; i < can_num_drivers; i++) {
-        AP_DroneCAN *dronecan = AP_DroneCAN::get_dronecan(i);
-        if (dronecan == nullptr) {
-            continue;
+    // only the driver selected by DID_CANDRIVER carries the packets
+    if (_can_driver > 0) {
+        AP_DroneCAN *dronecan = AP_DroneCAN::get_dronecan(_can_driver-1);
+        if (dronecan != nullptr) {
+            // send messages
+            dronecan_send(dronecan);
         }
-        if (dronecan->get_driver_index()+1 != _can_driver) {
-            continue;
-        }
-        // send messages
-        dronecan_send(dronecan);
     }
 #endif
 }
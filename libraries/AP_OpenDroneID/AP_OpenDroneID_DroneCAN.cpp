@@ -101,28 +101,33 @@ void AP_OpenDroneID::dronecan_send(AP_DroneCAN *uavcan)
         return;
     }
 
+    // most calls have nothing pending, check that before taking the
+    // semaphore so we don't contend with the MAVLink packet updates
+    const uint8_t pending = need_send_basic_id | need_send_system | need_send_self_id |
+                            need_send_operator_id | need_send_location;
+    if ((pending & driver_mask) == 0) {
+        return;
+    }
+
+    // take the semaphore once for all pending packets
+    WITH_SEMAPHORE(_sem);
     if (need_send_basic_id & driver_mask) {
-        WITH_SEMAPHORE(_sem);
         dronecan_send_basic_id(uavcan);
         need_send_basic_id &= ~driver_mask;
     }
     if (need_send_system & driver_mask) {
-        WITH_SEMAPHORE(_sem);
         dronecan_send_system(uavcan);
         need_send_system &= ~driver_mask;
     }
     if (need_send_self_id & driver_mask) {
-        WITH_SEMAPHORE(_sem);
         dronecan_send_self_id(uavcan);
         need_send_self_id &= ~driver_mask;
     }
     if (need_send_operator_id & driver_mask) {
-        WITH_SEMAPHORE(_sem);
         dronecan_send_operator_id(uavcan);
         need_send_operator_id &= ~driver_mask;
     }
     if (need_send_location & driver_mask) {
-        WITH_SEMAPHORE(_sem);
         dronecan_send_location(uavcan);
         need_send_location &= ~driver_mask;
     }
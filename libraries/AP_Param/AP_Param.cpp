@@ -104,6 +104,17 @@ uint16_t AP_Param::_count_marker;
 uint16_t AP_Param::_count_marker_done;
 HAL_Semaphore AP_Param::_count_sem;
 
+#if AP_PARAM_SCAN_INDEX_ENABLED
+AP_Param::ScanIndex AP_Param::_scan_index;
+HAL_Semaphore AP_Param::_scan_index_sem;
+#endif
+
+#if AP_PARAM_FIND_CACHE_ENABLED
+AP_Param::find_cache_entry AP_Param::_find_cache[AP_PARAM_FIND_CACHE_SIZE];
+uint16_t AP_Param::_find_cache_marker;
+HAL_Semaphore AP_Param::_find_cache_sem;
+#endif
+
 // storage and naming information about all types that can be saved
 const AP_Param::Info *AP_Param::_var_info;
 
@@ -111,6 +122,9 @@ struct AP_Param::param_override *AP_Param::param_overrides;
 uint16_t AP_Param::param_overrides_len;
 uint16_t AP_Param::num_param_overrides;
 uint16_t AP_Param::num_read_only;
+const void *AP_Param::param_defaults_source;
+uint32_t *AP_Param::param_defaults_unknown;
+uint16_t AP_Param::num_param_defaults_unknown;
 
 // goes true if we run out of param space
 bool AP_Param::eeprom_full;
@@ -187,6 +201,10 @@ void AP_Param::erase_all(void)
 
     // add a sentinal directly after the header
     write_sentinal(sizeof(struct EEPROM_header));
+
+#if AP_PARAM_SCAN_INDEX_ENABLED
+    scan_index_reset();
+#endif
 }
 
 /* the 'group_id' of a element of a group is the 18 bit identifier
@@ -763,6 +781,29 @@ bool AP_Param::is_sentinal(const Param_header &phdr)
 bool AP_Param::scan(const AP_Param::Param_header *target, uint16_t *pofs)
 {
     struct Param_header phdr;
+#if AP_PARAM_SCAN_INDEX_ENABLED
+    {
+        WITH_SEMAPHORE(_scan_index_sem);
+        if (scan_index_build()) {
+            const uint16_t mask = _scan_index.size - 1;
+            for (uint16_t i=scan_index_slot(*target), n=0; n<_scan_index.size; i=(i+1)&mask, n++) {
+                const uint16_t ofs = _scan_index.offsets[i];
+                if (ofs == 0) {
+                    // not stored, new variables go at the sentinal
+                    *pofs = sentinal_offset;
+                    return false;
+                }
+                _storage.read_block(&phdr, ofs, sizeof(phdr));
+                if (phdr.type == target->type &&
+                    get_key(phdr) == get_key(*target) &&
+                    phdr.group_element == target->group_element) {
+                    *pofs = ofs;
+                    return true;
+                }
+            }
+        }
+    }
+#endif
     uint16_t ofs = sizeof(AP_Param::EEPROM_header);
     while (ofs < _storage.size()) {
         _storage.read_block(&phdr, ofs, sizeof(phdr));
@@ -786,6 +827,111 @@ bool AP_Param::scan(const AP_Param::Param_header *target, uint16_t *pofs)
     return false;
 }
 
+#if AP_PARAM_SCAN_INDEX_ENABLED
+uint16_t AP_Param::scan_index_slot(const Param_header &phdr)
+{
+    const uint32_t v = (uint32_t(get_key(phdr)) << 23) | (uint32_t(phdr.type) << 18) | phdr.group_element;
+    return ((v * 2654435761U) >> 16) & (_scan_index.size - 1);
+}
+
+void AP_Param::scan_index_add(const Param_header &phdr, uint16_t ofs)
+{
+    if (_scan_index.offsets == nullptr) {
+        return;
+    }
+    if (_scan_index.count >= _scan_index.size - _scan_index.size/4) {
+        // too full to probe efficiently, rebuild at a larger size
+        scan_index_reset();
+        return;
+    }
+    const uint16_t mask = _scan_index.size - 1;
+    uint16_t i = scan_index_slot(phdr);
+    while (_scan_index.offsets[i] != 0) {
+        struct Param_header h;
+        _storage.read_block(&h, _scan_index.offsets[i], sizeof(h));
+        if (h.type == phdr.type &&
+            get_key(h) == get_key(phdr) &&
+            h.group_element == phdr.group_element) {
+            // scan() returns the first copy, keep it
+            return;
+        }
+        i = (i+1) & mask;
+    }
+    _scan_index.offsets[i] = ofs;
+    _scan_index.count++;
+}
+
+/*
+  build the scan index with a single pass over storage if we don't
+  have one already. Returns false if the index can't be used
+ */
+bool AP_Param::scan_index_build(void)
+{
+    if (_scan_index.offsets != nullptr) {
+        return true;
+    }
+    if (_scan_index.failed) {
+        return false;
+    }
+    struct Param_header phdr;
+    uint16_t count = 0;
+    uint16_t ofs = sizeof(AP_Param::EEPROM_header);
+    while (true) {
+        if (ofs >= _storage.size()) {
+            // no sentinal, leave it to the linear scan
+            _scan_index.failed = true;
+            return false;
+        }
+        _storage.read_block(&phdr, ofs, sizeof(phdr));
+        if (is_sentinal(phdr)) {
+            break;
+        }
+        count++;
+        ofs += type_size((enum ap_var_type)phdr.type) + sizeof(phdr);
+    }
+    sentinal_offset = ofs;
+
+    // leave room for variables saved later
+    uint32_t size = 64;
+    while (size < 2U*count + 64U) {
+        size *= 2;
+    }
+    if (size > 0x8000) {
+        _scan_index.failed = true;
+        return false;
+    }
+    _scan_index.offsets = NEW_NOTHROW uint16_t[size];
+    if (_scan_index.offsets == nullptr) {
+        _scan_index.failed = true;
+        return false;
+    }
+    memset(_scan_index.offsets, 0, size*sizeof(uint16_t));
+    _scan_index.size = size;
+    _scan_index.count = 0;
+
+    ofs = sizeof(AP_Param::EEPROM_header);
+    while (ofs < sentinal_offset) {
+        _storage.read_block(&phdr, ofs, sizeof(phdr));
+        scan_index_add(phdr, ofs);
+        ofs += type_size((enum ap_var_type)phdr.type) + sizeof(phdr);
+    }
+    return true;
+}
+
+/*
+  discard the scan index, it will be rebuilt on the next scan()
+ */
+void AP_Param::scan_index_reset(void)
+{
+    WITH_SEMAPHORE(_scan_index_sem);
+    delete[] _scan_index.offsets;
+    _scan_index.offsets = nullptr;
+    _scan_index.size = 0;
+    _scan_index.count = 0;
+    _scan_index.failed = false;
+}
+#endif // AP_PARAM_SCAN_INDEX_ENABLED
+
 /**
  * add a _X, _Y, _Z suffix to the name of a Vector3f element
  * @param buffer
@@ -912,11 +1058,81 @@ AP_Param::find_group(const char *name, uint16_t vindex, ptrdiff_t group_offset,
 }
 
 
+#if AP_PARAM_FIND_CACHE_ENABLED
+// FNV-1a hash of a parameter name, mapped onto the find cache
+uint16_t AP_Param::find_cache_slot(const char *name)
+{
+    uint32_t hash = 2166136261U;
+    for (uint8_t i=0; i<AP_MAX_NAME_SIZE && name[i] != '\0'; i++) {
+        hash = (hash ^ uint8_t(name[i])) * 16777619U;
+    }
+    return hash % AP_PARAM_FIND_CACHE_SIZE;
+}
+#endif
+
 // Find a variable by name.
 //
 AP_Param *
 AP_Param::find(const char *name, enum ap_var_type *ptype, uint16_t *flags)
 {
+#if AP_PARAM_FIND_CACHE_ENABLED
+    if (strnlen(name, AP_MAX_NAME_SIZE+1) > AP_MAX_NAME_SIZE) {
+        bool have_flags;
+        return find_uncached(name, ptype, flags, have_flags);
+    }
+    const uint16_t slot = find_cache_slot(name);
+    uint16_t marker;
+    {
+        WITH_SEMAPHORE(_find_cache_sem);
+        marker = _count_marker;
+        if (_find_cache_marker != marker) {
+            // the parameter tree may have changed
+            memset(_find_cache, 0, sizeof(_find_cache));
+            _find_cache_marker = marker;
+        }
+        const find_cache_entry &e = _find_cache[slot];
+        if (e.ap != nullptr && strncmp(name, e.name, AP_MAX_NAME_SIZE) == 0) {
+            *ptype = (enum ap_var_type)e.type;
+            if (flags != nullptr && e.have_flags) {
+                *flags = e.flags;
+            }
+            return e.ap;
+        }
+    }
+
+    // always look up the flags so the entry can answer any caller
+    uint16_t found_flags = 0;
+    bool have_flags = false;
+    AP_Param *ap = find_uncached(name, ptype, &found_flags, have_flags);
+    if (ap == nullptr) {
+        return nullptr;
+    }
+    if (flags != nullptr && have_flags) {
+        *flags = found_flags;
+    }
+
+    WITH_SEMAPHORE(_find_cache_sem);
+    if (_find_cache_marker == marker && _count_marker == marker) {
+        find_cache_entry &e = _find_cache[slot];
+        strncpy_noterm(e.name, name, AP_MAX_NAME_SIZE);
+        e.ap = ap;
+        e.type = *ptype;
+        e.flags = found_flags;
+        e.have_flags = have_flags;
+    }
+    return ap;
+#else
+    bool have_flags;
+    return find_uncached(name, ptype, flags, have_flags);
+#endif
+}
+
+// Find a variable by name, walking the parameter tree. have_flags is
+// set if flags was filled in
+AP_Param *
+AP_Param::find_uncached(const char *name, enum ap_var_type *ptype, uint16_t *flags, bool &have_flags)
+{
+    have_flags = false;
     for (uint16_t i=0; i<_num_vars; i++) {
         const auto &info = var_info(i);
         uint8_t type = info.type;
@@ -939,6 +1155,7 @@ AP_Param::find(const char *name, enum ap_var_type *ptype, uint16_t *flags)
                     ap->find_var_info(&group_element, ginfo, group_nesting, &idx);
                     if (ginfo != nullptr) {
                         *flags = ginfo->flags;
+                        have_flags = true;
                     }
                 }
                 return ap;
@@ -1243,6 +1460,12 @@ void AP_Param::save_sync(bool force_save, bool send_to_gcs)
     write_sentinal(ofs + sizeof(phdr) + type_size((enum ap_var_type)phdr.type));
     eeprom_write_check(ap, ofs+sizeof(phdr), type_size((enum ap_var_type)phdr.type));
     eeprom_write_check(&phdr, ofs, sizeof(phdr));
+#if AP_PARAM_SCAN_INDEX_ENABLED
+    {
+        WITH_SEMAPHORE(_scan_index_sem);
+        scan_index_add(phdr, ofs);
+    }
+#endif
 
     if (send_to_gcs) {
         send_parameter(name, (enum ap_var_type)phdr.type, idx);
@@ -1659,6 +1882,13 @@ void AP_Param::load_defaults_file_from_romfs(const char *default_file, bool last
         return;
     }
 
+    if (param_defaults_source == default_file && num_param_defaults_unknown == 0) {
+        // every default has been found already, so there is no need
+        // to decompress the file
+        apply_compiled_defaults(nullptr, 0);
+        return;
+    }
+
     // filename without the prefix:
     const char *trimmed_filename = &default_file[strlen(prefix)];
 
@@ -1668,7 +1898,7 @@ void AP_Param::load_defaults_file_from_romfs(const char *default_file, bool last
         return;
     }
 
-    load_param_defaults((const char*)text, string_length, last_pass);
+    load_param_defaults(default_file, (const char*)text, string_length, last_pass);
 
     AP_ROMFS::free(text);
 
@@ -2383,6 +2613,7 @@ bool AP_Param::read_param_defaults_file(const char *filename, bool last_pass, ui
         param_overrides[idx].object_ptr = vp;
         param_overrides[idx].value = value;
         param_overrides[idx].read_only = read_only;
+        param_overrides[idx].type = var_type;
         if (read_only) {
             num_read_only++;
         }
@@ -2428,6 +2659,7 @@ bool AP_Param::load_defaults_file(const char *filename, bool last_pass)
     param_overrides_len = 0;
     num_param_overrides = 0;
     num_read_only = 0;
+    param_defaults_source = nullptr;
 
     param_overrides = NEW_NOTHROW param_override[num_defaults];
     if (param_overrides == nullptr) {
@@ -2464,31 +2696,43 @@ bool AP_Param::load_defaults_file(const char *filename, bool last_pass)
 
 #if AP_PARAM_MAX_EMBEDDED_PARAM > 0 || defined(HAL_HAVE_AP_ROMFS_EMBEDDED_H)
 /*
-  count the number of parameter defaults present in supplied string
+  copy the line at ptr into line, returning the number of bytes of
+  ptr used including the newline
  */
-bool AP_Param::count_param_defaults(const volatile char *ptr, int32_t length, uint16_t &count)
+static uint16_t copy_defaults_line(const volatile char *ptr, int32_t length, char *line, uint8_t line_size)
+{
+    uint16_t i;
+    const uint16_t n = MIN(length, int32_t(UINT16_MAX));
+    for (i=0;i<n;i++) {
+        if (ptr[i] == '\n') {
+            break;
+        }
+    }
+
+    const uint16_t linelen = MIN(i,line_size-1);
+    memcpy(line, (void *)ptr, linelen);
+    line[linelen] = 0;
+
+    return i+1;
+}
+
+/*
+  count the number of parameter defaults present in supplied string,
+  and the number naming parameters which do not exist (yet)
+ */
+bool AP_Param::count_param_defaults(const volatile char *ptr, int32_t length, uint16_t &count, uint16_t &unknown)
 {
     count = 0;
+    unknown = 0;
     
     while (length>0) {
         char line[100];
         char *pname;
         float value;
         bool read_only;
-        uint16_t i;
-        uint16_t n = length;
-        for (i=0;i<n;i++) {
-            if (ptr[i] == '\n') {
-                break;
-            }
-        }
-
-        uint16_t linelen = MIN(i,sizeof(line)-1);
-        memcpy(line, (void *)ptr, linelen);
-        line[linelen] = 0;
-
-        length -= i+1;
-        ptr += i+1;
+        const uint16_t used = copy_defaults_line(ptr, length, line, sizeof(line));
+        length -= used;
+        ptr += used;
         
         if (line[0] == '#' || line[0] == 0) {
             continue;
@@ -2500,6 +2744,7 @@ bool AP_Param::count_param_defaults(const volatile char *ptr, int32_t length, ui
 
         enum ap_var_type var_type;
         if (!find(pname, &var_type)) {
+            unknown++;
             continue;
         }
 
@@ -2509,50 +2754,79 @@ bool AP_Param::count_param_defaults(const volatile char *ptr, int32_t length, ui
 }
 
 /*
- *  load parameter defaults from supplied string
+  add a parameter default to param_overrides and apply it
  */
-void AP_Param::load_param_defaults(const volatile char *ptr, int32_t length, bool last_pass)
+void AP_Param::add_param_override(AP_Param *vp, enum ap_var_type var_type, float value, bool read_only)
 {
+    if (num_param_overrides >= param_overrides_len) {
+        INTERNAL_ERROR(AP_InternalError::error_t::flow_of_control);
+        return;
+    }
+    param_override &po = param_overrides[num_param_overrides++];
+    po.object_ptr = vp;
+    po.value = value;
+    po.read_only = read_only;
+    po.type = var_type;
+    if (read_only) {
+        num_read_only++;
+    }
+    if (!vp->configured_in_storage()) {
+        vp->set_float(value, var_type);
+    }
+}
+
+/*
+ *  load parameter defaults from supplied string. The parsed defaults
+ *  are kept in param_overrides, so when the same source is loaded
+ *  again they are applied without parsing, and only lines naming
+ *  parameters which did not exist last time are looked up again
+ */
+void AP_Param::load_param_defaults(const void *source, const volatile char *ptr, int32_t length, bool last_pass)
+{
+    if (source != nullptr && source == param_defaults_source) {
+        apply_compiled_defaults(ptr, length);
+        return;
+    }
+
     delete[] param_overrides;
     param_overrides = nullptr;
     param_overrides_len = 0;
     num_param_overrides = 0;
     num_read_only = 0;
+    delete[] param_defaults_unknown;
+    param_defaults_unknown = nullptr;
+    num_param_defaults_unknown = 0;
+    param_defaults_source = nullptr;
 
     uint16_t num_defaults = 0;
-    if (!count_param_defaults(ptr, length, num_defaults)) {
+    uint16_t num_unknown = 0;
+    if (!count_param_defaults(ptr, length, num_defaults, num_unknown)) {
         return;
     }
 
-    param_overrides = NEW_NOTHROW param_override[num_defaults];
+    // leave room for the unknown parameters appearing later
+    param_overrides = NEW_NOTHROW param_override[num_defaults+num_unknown];
     if (param_overrides == nullptr) {
         AP_HAL::panic("AP_Param: Failed to allocate overrides");
         return;
     }
 
-    param_overrides_len = num_defaults;
+    param_overrides_len = num_defaults+num_unknown;
 
-    uint16_t idx = 0;
-    
-    while (idx < num_defaults && length > 0) {
+    bool can_cache = true;
+    if (num_unknown > 0) {
+        param_defaults_unknown = NEW_NOTHROW uint32_t[num_unknown];
+        can_cache = param_defaults_unknown != nullptr;
+    }
+
+    uint32_t ofs = 0;
+    while (ofs < uint32_t(length)) {
         char line[100];
         char *pname;
         float value;
         bool read_only;
-        uint16_t i;
-        uint16_t n = length;
-        for (i=0;i<n;i++) {
-            if (ptr[i] == '\n') {
-                break;
-            }
-        }
-
-        uint16_t linelen = MIN(i,sizeof(line)-1);
-        memcpy(line, (void *)ptr, linelen);
-        line[linelen] = 0;
-
-        length -= i+1;
-        ptr += i+1;
+        const uint32_t line_ofs = ofs;
+        ofs += copy_defaults_line(&ptr[ofs], length - ofs, line, sizeof(line));
 
         if (line[0] == '#' || line[0] == 0) {
             continue;
@@ -2565,28 +2839,69 @@ void AP_Param::load_param_defaults(const volatile char *ptr, int32_t length, boo
         AP_Param *vp = find(pname, &var_type);
         if (!vp) {
             if (last_pass) {
-#if ENABLE_DEBUG && (AP_PARAM_MAX_EMBEDDED_PARAM > 0)
-                ::printf("Ignored unknown param %s from embedded region (offset=%u)\n",
-                         pname, unsigned(ptr - param_defaults_data.data));
+#if ENABLE_DEBUG
+                ::printf("Ignored unknown param %s from defaults (offset=%u)\n",
+                         pname, unsigned(line_ofs));
                 hal.console->printf(
-                         "Ignored unknown param %s from embedded region (offset=%u)\n",
-                         pname, unsigned(ptr - param_defaults_data.data));
+                         "Ignored unknown param %s from defaults (offset=%u)\n",
+                         pname, unsigned(line_ofs));
 #endif
             }
+            if (param_defaults_unknown != nullptr && num_param_defaults_unknown < num_unknown) {
+                param_defaults_unknown[num_param_defaults_unknown++] = line_ofs;
+            }
             continue;
         }
-        param_overrides[idx].object_ptr = vp;
-        param_overrides[idx].value = value;
-        param_overrides[idx].read_only = read_only;
-        if (read_only) {
-            num_read_only++;
-        }
-        idx++;
+        add_param_override(vp, var_type, value, read_only);
+    }
+
+    if (can_cache) {
+        param_defaults_source = source;
+    }
+}
+
+/*
+  re-apply the defaults parsed by the last load_param_defaults() call,
+  looking up the parameters which were unknown then. ptr and length
+  are the defaults text, which is only needed if there were unknown
+  parameters
+ */
+void AP_Param::apply_compiled_defaults(const volatile char *ptr, int32_t length)
+{
+    for (uint16_t i=0; i<num_param_overrides; i++) {
+        const param_override &po = param_overrides[i];
+        AP_Param *vp = const_cast<AP_Param *>(po.object_ptr);
         if (!vp->configured_in_storage()) {
-            vp->set_float(value, var_type);
+            vp->set_float(po.value, (enum ap_var_type)po.type);
         }
     }
-    num_param_overrides = num_defaults;
+
+    if (ptr == nullptr) {
+        return;
+    }
+    uint16_t still_unknown = 0;
+    for (uint16_t i=0; i<num_param_defaults_unknown; i++) {
+        const uint32_t ofs = param_defaults_unknown[i];
+        if (ofs >= uint32_t(length)) {
+            continue;
+        }
+        char line[100];
+        char *pname;
+        float value;
+        bool read_only;
+        copy_defaults_line(&ptr[ofs], length - ofs, line, sizeof(line));
+        if (!parse_param_line(line, &pname, value, read_only)) {
+            continue;
+        }
+        enum ap_var_type var_type;
+        AP_Param *vp = find(pname, &var_type);
+        if (vp == nullptr) {
+            param_defaults_unknown[still_unknown++] = ofs;
+            continue;
+        }
+        add_param_override(vp, var_type, value, read_only);
+    }
+    num_param_defaults_unknown = still_unknown;
 }
 #endif // AP_PARAM_MAX_EMBEDDED_PARAM > 0 || defined(HAL_HAVE_AP_ROMFS_EMBEDDED_H)
 
@@ -2599,7 +2914,7 @@ void AP_Param::load_param_defaults(const volatile char *ptr, int32_t length, boo
  */
 void AP_Param::load_embedded_param_defaults(bool last_pass)
 {
-    load_param_defaults(param_defaults_data.data, param_defaults_data.length, last_pass);
+    load_param_defaults(&param_defaults_data, param_defaults_data.data, param_defaults_data.length, last_pass);
 }
 #endif  // AP_PARAM_MAX_EMBEDDED_PARAM > 0
 
@@ -777,7 +777,7 @@ private:
       load a parameter defaults file. This happens as part of load_all()
      */
     static bool count_defaults_in_file(const char *filename, uint16_t &num_defaults);
-    static bool count_param_defaults(const volatile char *ptr, int32_t length, uint16_t &count);
+    static bool count_param_defaults(const volatile char *ptr, int32_t length, uint16_t &count, uint16_t &unknown);
     static bool read_param_defaults_file(const char *filename, bool last_pass, uint16_t &idx);
 
     // load a defaults.parm using AP_FileSystem:
@@ -785,8 +785,11 @@ private:
     // load an @ROMFS defaults.parm using ROMFS API:
     static void load_defaults_file_from_romfs(const char *filename, bool lastpass);
 
-    // load defaults from supplied string:
-    static void load_param_defaults(const volatile char *ptr, int32_t length, bool last_pass);
+    // load defaults from supplied string. source identifies the
+    // string so a reload of the same defaults can skip parsing:
+    static void load_param_defaults(const void *source, const volatile char *ptr, int32_t length, bool last_pass);
+    static void apply_compiled_defaults(const volatile char *ptr, int32_t length);
+    static void add_param_override(AP_Param *vp, enum ap_var_type var_type, float value, bool read_only);
 
     /*
       load defaults from embedded parameters
@@ -819,6 +822,41 @@ private:
     static HAL_Semaphore        _count_sem;
     static const struct Info *  _var_info;
 
+    static AP_Param *           find_uncached(const char *name, enum ap_var_type *ptype,
+                                              uint16_t *flags, bool &have_flags);
+#if AP_PARAM_FIND_CACHE_ENABLED
+    // results of recent find() calls, direct-mapped on a hash of the
+    // name and flushed whenever _count_marker changes
+    struct find_cache_entry {
+        char name[AP_MAX_NAME_SIZE];
+        AP_Param *ap;       // nullptr if the entry is unused
+        uint16_t flags;
+        bool have_flags;
+        uint8_t type;
+    };
+    static find_cache_entry     _find_cache[AP_PARAM_FIND_CACHE_SIZE];
+    static uint16_t             _find_cache_marker;
+    static HAL_Semaphore        _find_cache_sem;
+    static uint16_t             find_cache_slot(const char *name);
+#endif
+
+#if AP_PARAM_SCAN_INDEX_ENABLED
+    // open-addressed table of storage offsets of stored variables,
+    // keyed on a hash of their header. Built on the first scan()
+    struct ScanIndex {
+        uint16_t *offsets;  // 0 marks an empty slot
+        uint16_t size;      // number of slots, a power of two
+        uint16_t count;     // number of used slots
+        bool failed;        // storage couldn't be indexed
+    };
+    static ScanIndex            _scan_index;
+    static HAL_Semaphore        _scan_index_sem;
+    static uint16_t             scan_index_slot(const Param_header &phdr);
+    static bool                 scan_index_build(void);
+    static void                 scan_index_add(const Param_header &phdr, uint16_t ofs);
+    static void                 scan_index_reset(void);
+#endif
+
 #if AP_PARAM_DYNAMIC_ENABLED
     // allow for a dynamically allocated var table
     static uint16_t             _num_vars_base;
@@ -841,12 +879,22 @@ private:
         const AP_Param *object_ptr;
         float value;
         bool read_only; // param is marked @READONLY
+        uint8_t type;   // ap_var_type
     };
     static struct param_override *param_overrides;
     static uint16_t num_param_overrides;
     static uint16_t param_overrides_len;
     static uint16_t num_read_only;
 
+    /*
+      the defaults text param_overrides was parsed from by
+      load_param_defaults(), and the offsets of the lines in it naming
+      parameters which were not found
+    */
+    static const void *param_defaults_source;
+    static uint32_t *param_defaults_unknown;
+    static uint16_t num_param_defaults_unknown;
+
     // values filled into the EEPROM header
     static const uint8_t        k_EEPROM_magic0      = 0x50;
     static const uint8_t        k_EEPROM_magic1      = 0x41; ///< "AP"
@@ -8,6 +8,22 @@
 #define AP_PARAM_DEFAULTS_FILE_PARSING_ENABLED AP_FILESYSTEM_FILE_READING_ENABLED
 #endif
 
+// cache results of AP_Param::find() so repeated lookups by name (from
+// scripting and PARAM_SET) don't walk the whole parameter tree
+#ifndef AP_PARAM_FIND_CACHE_ENABLED
+#define AP_PARAM_FIND_CACHE_ENABLED HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#endif
+
+#ifndef AP_PARAM_FIND_CACHE_SIZE
+#define AP_PARAM_FIND_CACHE_SIZE 64
+#endif
+
+// keep a RAM hash index of the stored Param_header offsets so
+// scan() doesn't walk the parameter storage for every variable
+#ifndef AP_PARAM_SCAN_INDEX_ENABLED
+#define AP_PARAM_SCAN_INDEX_ENABLED HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#endif
+
 #ifndef FORCE_APJ_DEFAULT_PARAMETERS
 #define FORCE_APJ_DEFAULT_PARAMETERS 0
 #endif
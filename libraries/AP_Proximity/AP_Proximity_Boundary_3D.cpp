@@ -34,19 +34,31 @@ void AP_Proximity_Boundary_3D::init()
     for (uint8_t layer=0; layer < PROXIMITY_NUM_LAYERS; layer++) {
         const float pitch = ((float)_pitch_middle_deg[layer]);
         for (uint8_t sector=0; sector < PROXIMITY_NUM_SECTORS; sector++) {
-            const float angle_rad = ((float)_sector_middle_deg[sector]+(PROXIMITY_SECTOR_WIDTH_DEG/2.0f));
+            const float angle_rad = (sector_middle_deg(sector)+(PROXIMITY_SECTOR_WIDTH_DEG/2.0f));
             _sector_edge_vector[layer][sector].offset_bearing(angle_rad, pitch, 100.0f);
             _boundary_points[layer][sector] = _sector_edge_vector[layer][sector] * PROXIMITY_BOUNDARY_DIST_DEFAULT;
         }
+        for (uint8_t sector=0; sector < PROXIMITY_NUM_SECTORS; sector++) {
+            update_obstacle_vector(layer, sector);
+        }
     }
 }
 
+// update the cached vector to the closest point on the boundary between a sector and the next sector (clockwise)
+// this is calculated when the boundary changes so that avoidance, which checks every sector each loop, only needs a lookup
+void AP_Proximity_Boundary_3D::update_obstacle_vector(uint8_t layer, uint8_t sector)
+{
+    const Vector3f &start = _boundary_points[layer][get_next_sector(sector)];
+    const Vector3f &end = _boundary_points[layer][sector];
+    _obstacle_vector[layer][sector] = Vector3f::point_on_line_closest_to_other_point(start, end, Vector3f{});
+}
+
 // returns face corresponding to the provided yaw and (optionally) pitch
 // pitch is the vertical body-frame angle (in degrees) to the obstacle (0=directly ahead, 90 is above the vehicle)
 // yaw is the horizontal body-frame angle (in degrees) to the obstacle (0=directly ahead of the vehicle, 90 is to the right of the vehicle)
 AP_Proximity_Boundary_3D::Face AP_Proximity_Boundary_3D::get_face(float pitch, float yaw) const
 {
-    const uint8_t sector = wrap_360(yaw + (PROXIMITY_SECTOR_WIDTH_DEG * 0.5f)) / 45.0f;
+    const uint8_t sector = MIN(wrap_360(yaw + (PROXIMITY_SECTOR_WIDTH_DEG * 0.5f)) / PROXIMITY_SECTOR_WIDTH_DEG, PROXIMITY_NUM_SECTORS - 1);
     const float pitch_limited = constrain_float(pitch, -75.0f, 74.9f);
     const uint8_t layer = (pitch_limited + 75.0f)/PROXIMITY_PITCH_WIDTH_DEG;
     return Face{layer, sector};
@@ -169,6 +181,13 @@ void AP_Proximity_Boundary_3D::update_boundary(const Face &face)
     if (!_distance_valid[layer][prev_sector_ccw]) {
         _boundary_points[layer][prev_sector_ccw] = _sector_edge_vector[layer][prev_sector_ccw] * shortest_distance;
     }
+
+    // update obstacles (lines between boundary points) with an end which may have moved
+    uint8_t obstacle_sector = get_prev_sector(prev_sector_ccw);
+    for (uint8_t i = 0; i < 5; i++) {
+        update_obstacle_vector(layer, obstacle_sector);
+        obstacle_sector = get_next_sector(obstacle_sector);
+    }
 }
 
 // reset boundary.  marks all distances as invalid
@@ -247,7 +266,7 @@ bool AP_Proximity_Boundary_3D::get_distance(const Face &face, float &distance) c
 }
 
 // get the total number of obstacles 
-uint8_t AP_Proximity_Boundary_3D::get_obstacle_count() const
+uint16_t AP_Proximity_Boundary_3D::get_obstacle_count() const
 {
     return PROXIMITY_NUM_LAYERS * PROXIMITY_NUM_SECTORS;
 }
@@ -257,7 +276,7 @@ uint8_t AP_Proximity_Boundary_3D::get_obstacle_count() const
 // "update_boundary" method manipulates two sectors ccw and one sector cw from any valid face.
 // Any boundary that does not fall into these manipulated faces are useless, and will be marked as false
 // The resultant is packed into a Boundary Location object and returned by reference as "face"
-bool AP_Proximity_Boundary_3D::convert_obstacle_num_to_face(uint8_t obstacle_num, Face& face) const
+bool AP_Proximity_Boundary_3D::convert_obstacle_num_to_face(uint16_t obstacle_num, Face& face) const
 {
     // obstacle num is just "flattened layers, and sectors"
     const uint8_t layer = obstacle_num / PROXIMITY_NUM_SECTORS;
@@ -284,19 +303,14 @@ bool AP_Proximity_Boundary_3D::convert_obstacle_num_to_face(uint8_t obstacle_num
 // Then returns the closest point on this line from vehicle, in body-frame. 
 // Used by GPS based Simple Avoidance  
 // False is returned if the obstacle_num provided does not produce a valid obstacle 
-bool AP_Proximity_Boundary_3D::get_obstacle(uint8_t obstacle_num, Vector3f& vec_to_obstacle) const
+bool AP_Proximity_Boundary_3D::get_obstacle(uint16_t obstacle_num, Vector3f& vec_to_obstacle) const
 {
     Face face;
     if (!convert_obstacle_num_to_face(obstacle_num, face)) {
         // not a valid face
         return false;
     }
-    const uint8_t sector_end = face.sector;
-    const uint8_t sector_start = get_next_sector(face.sector);
-    
-    const Vector3f start = _boundary_points[face.layer][sector_start];
-    const Vector3f end = _boundary_points[face.layer][sector_end];
-    vec_to_obstacle = Vector3f::point_on_line_closest_to_other_point(start, end, Vector3f{});
+    vec_to_obstacle = _obstacle_vector[face.layer][face.sector];
     return true;
 }
 
@@ -308,7 +322,7 @@ bool AP_Proximity_Boundary_3D::get_obstacle(uint8_t obstacle_num, Vector3f& vec_
 // This helps us know if the passed line segment was in the direction of the boundary, or going in a different direction.
 // Used by GPS based Simple Avoidance  - for "brake mode"
 // False is returned if the obstacle_num provided does not produce a valid obstacle
-bool AP_Proximity_Boundary_3D::closest_point_from_segment_to_obstacle(uint8_t obstacle_num, const Vector3f& seg_start, const Vector3f& seg_end, Vector3f& closest_point) const
+bool AP_Proximity_Boundary_3D::closest_point_from_segment_to_obstacle(uint16_t obstacle_num, const Vector3f& seg_start, const Vector3f& seg_end, Vector3f& closest_point) const
 {
     Face face;
     if (!convert_obstacle_num_to_face(obstacle_num, face)) {
@@ -381,12 +395,12 @@ bool AP_Proximity_Boundary_3D::get_horizontal_object_angle_and_distance(uint8_t
 
 // get an obstacle info for AP_Periph
 // returns false if no angle or distance could be returned for some reason
-bool AP_Proximity_Boundary_3D::get_obstacle_info(uint8_t obstacle_num, float &angle_deg, float &pitch_deg, float &distance) const
+bool AP_Proximity_Boundary_3D::get_obstacle_info(uint16_t obstacle_num, float &angle_deg, float &pitch_deg, float &distance) const
 {
     // obstacle num is just "flattened layers, and sectors"
     const uint8_t layer = obstacle_num / PROXIMITY_NUM_SECTORS;
     const uint8_t sector = obstacle_num % PROXIMITY_NUM_SECTORS;
-    if (_distance_valid[layer][sector]) {
+    if ((layer < PROXIMITY_NUM_LAYERS) && _distance_valid[layer][sector]) {
         angle_deg = _angle[layer][sector];
         pitch_deg = _pitch[layer][sector];
         distance = _filtered_distance[layer][sector].get();
@@ -413,8 +427,13 @@ bool AP_Proximity_Boundary_3D::get_filtered_distance(const Face &face, float &di
 }
 
 // Get raw and filtered distances in 8 directions per layer
+// if there are more than 8 sectors each direction holds the shortest distance of the sectors within 22.5 degrees of it
 bool AP_Proximity_Boundary_3D::get_layer_distances(uint8_t layer_number, float dist_max, Proximity_Distance_Array &prx_dist_array, Proximity_Distance_Array &prx_filt_dist_array) const
 {
+    // sectors are centred on each direction so the first sector of direction 0 is counter-clockwise of forward
+    const uint8_t sectors_per_direction = PROXIMITY_NUM_SECTORS / PROXIMITY_MAX_DIRECTION;
+    const uint8_t first_sector_ofs = sectors_per_direction / 2;
+
     // cycle through all sectors filling in distances and orientations
     // see MAV_SENSOR_ORIENTATION for orientations (0 = forward, 1 = 45 degree clockwise from north, etc)
     bool valid_distances = false;
@@ -422,17 +441,27 @@ bool AP_Proximity_Boundary_3D::get_layer_distances(uint8_t layer_number, float d
     prx_filt_dist_array.offset_valid = 0;
     for (uint8_t i=0; i<PROXIMITY_MAX_DIRECTION; i++) {
         prx_dist_array.orientation[i] = i;
-        const AP_Proximity_Boundary_3D::Face face(layer_number, i);
-        if (!face.valid()) {
-            return false;
-        }
-        if (get_distance(face, prx_dist_array.distance[i]) && get_filtered_distance(face, prx_filt_dist_array.distance[i])) {
+        prx_dist_array.distance[i] = dist_max;
+        prx_filt_dist_array.distance[i] = dist_max;
+        uint8_t sector = (i * sectors_per_direction + PROXIMITY_NUM_SECTORS - first_sector_ofs) % PROXIMITY_NUM_SECTORS;
+        for (uint8_t j=0; j<sectors_per_direction; j++, sector = get_next_sector(sector)) {
+            const AP_Proximity_Boundary_3D::Face face(layer_number, sector);
+            if (!face.valid()) {
+                return false;
+            }
+            float distance, filt_distance;
+            if (!get_distance(face, distance) || !get_filtered_distance(face, filt_distance)) {
+                continue;
+            }
+            if (!prx_dist_array.valid(i) || (distance < prx_dist_array.distance[i])) {
+                prx_dist_array.distance[i] = distance;
+            }
+            if (!prx_filt_dist_array.valid(i) || (filt_distance < prx_filt_dist_array.distance[i])) {
+                prx_filt_dist_array.distance[i] = filt_distance;
+            }
             valid_distances = true;
             prx_dist_array.offset_valid |= (1U << i);
             prx_filt_dist_array.offset_valid |= (1U << i);
-        } else {
-            prx_dist_array.distance[i] = dist_max;
-            prx_filt_dist_array.distance[i] = dist_max;
         }
     }
 
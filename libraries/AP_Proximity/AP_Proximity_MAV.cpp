@@ -26,10 +26,16 @@ extern const AP_HAL::HAL& hal;
 
 #define PROXIMITY_MAV_TIMEOUT_MS    500 // distance messages must arrive within this many milliseconds
 #define PROXIMITY_TIMESTAMP_MSG_TIMEOUT_MS  50  // obstacles will be transferred from temp boundary to actual boundary if mavlink message does not arrive within this many milliseconds
+#define PROXIMITY_MAV_VOXEL_SIZE_M  0.5f    // OBSTACLE_DISTANCE_3D points within a voxel of this size are reduced to the closest point
 
 // update the state of the sensor
 void AP_Proximity_MAV::update(void)
 {
+    // push the last OBSTACLE_DISTANCE_3D frame if no more points have arrived
+    if (_cloud.count > 0 && (AP_HAL::millis() - _last_update_ms > PROXIMITY_TIMESTAMP_MSG_TIMEOUT_MS)) {
+        cloud_push_to_database();
+    }
+
     // check for timeout and set health status
     if ((_last_update_ms == 0 || (AP_HAL::millis() - _last_update_ms > PROXIMITY_MAV_TIMEOUT_MS)) &&
         (_last_upward_update_ms == 0 || (AP_HAL::millis() - _last_upward_update_ms > PROXIMITY_MAV_TIMEOUT_MS))) {
@@ -236,15 +242,13 @@ void AP_Proximity_MAV::handle_obstacle_distance_3d_msg(const mavlink_message_t &
         temp_boundary.update_3D_boundary(state.instance, frontend.boundary);
         // clear temp boundary for new data
         temp_boundary.reset();
+        // push the previous frame's points to the OA database
+        cloud_push_to_database();
     }
 
     _distance_min = packet.min_distance;
     _distance_max = packet.max_distance;
 
-    Vector3f current_pos;
-    Matrix3f body_to_ned;
-    const bool database_ready = database_prepare_for_push(current_pos, body_to_ned);
-
     const Vector3f obstacle_FRD(packet.x, packet.y, packet.z);
     const float obstacle_distance = obstacle_FRD.length();
     if (obstacle_distance < _distance_min || obstacle_distance > _distance_max || is_zero(obstacle_distance)) {
@@ -268,10 +272,64 @@ void AP_Proximity_MAV::handle_obstacle_distance_3d_msg(const mavlink_message_t &
     const AP_Proximity_Boundary_3D::Face face = frontend.boundary.get_face(pitch, yaw);
     temp_boundary.add_distance(face, pitch, yaw, obstacle.length());
 
-    if (database_ready) {
-        database_push(yaw, pitch, obstacle.length(),_last_update_ms, current_pos, body_to_ned);
+    cloud_add_point(obstacle, yaw, pitch, obstacle.length());
+}
+
+// add an OBSTACLE_DISTANCE_3D point (FRU frame, meters) to the current
+// frame's voxels, keeping only the closest point in each voxel
+void AP_Proximity_MAV::cloud_add_point(const Vector3f &obstacle, float yaw, float pitch, float distance)
+{
+    if (_cloud.count == 0) {
+        // the whole frame uses the vehicle position and attitude of its first point
+        _cloud.database_ready = database_prepare_for_push(_cloud.current_pos, _cloud.body_to_ned);
+        _cloud.timestamp_ms = _last_update_ms;
     }
-    return;
+    if (!_cloud.database_ready) {
+        // only count the point so the vehicle state is not looked up again for this frame
+        _cloud.count = 1;
+        return;
+    }
+
+    const int16_t voxel[3] {
+        int16_t(floorf(obstacle.x / PROXIMITY_MAV_VOXEL_SIZE_M)),
+        int16_t(floorf(obstacle.y / PROXIMITY_MAV_VOXEL_SIZE_M)),
+        int16_t(floorf(obstacle.z / PROXIMITY_MAV_VOXEL_SIZE_M)),
+    };
+    for (uint8_t i = 0; i < _cloud.count; i++) {
+        auto &p = _cloud.points[i];
+        if (p.voxel[0] == voxel[0] && p.voxel[1] == voxel[1] && p.voxel[2] == voxel[2]) {
+            if (distance < p.distance) {
+                p.yaw = yaw;
+                p.pitch = pitch;
+                p.distance = distance;
+            }
+            return;
+        }
+    }
+
+    if (_cloud.count >= ARRAY_SIZE(_cloud.points)) {
+        // out of voxels, push what we have and start again
+        cloud_push_to_database();
+        cloud_add_point(obstacle, yaw, pitch, distance);
+        return;
+    }
+    auto &p = _cloud.points[_cloud.count++];
+    memcpy(p.voxel, voxel, sizeof(p.voxel));
+    p.yaw = yaw;
+    p.pitch = pitch;
+    p.distance = distance;
+}
+
+// push the current frame's voxels to the OA database
+void AP_Proximity_MAV::cloud_push_to_database()
+{
+    if (_cloud.database_ready) {
+        for (uint8_t i = 0; i < _cloud.count; i++) {
+            const auto &p = _cloud.points[i];
+            database_push(p.yaw, p.pitch, p.distance, _cloud.timestamp_ms, _cloud.current_pos, _cloud.body_to_ned);
+        }
+    }
+    _cloud.count = 0;
 }
 
 #endif // AP_PROXIMITY_MAV_ENABLED
@@ -6,6 +6,8 @@
 
 #include "AP_Proximity_Backend.h"
 
+#define PROXIMITY_MAV_CLOUD_POINTS_MAX  32  // maximum number of voxels of an OBSTACLE_DISTANCE_3D frame held before pushing to the OA database
+
 class AP_Proximity_MAV : public AP_Proximity_Backend
 {
 
@@ -35,6 +37,11 @@ private:
     // handle mavlink OBSTACLE_DISTANCE_3D messages
     void handle_obstacle_distance_3d_msg(const mavlink_message_t &msg);
 
+    // add an OBSTACLE_DISTANCE_3D point (FRU frame, meters) to the current frame's voxels
+    void cloud_add_point(const Vector3f &obstacle, float yaw, float pitch, float distance);
+    // push the current frame's voxels to the OA database
+    void cloud_push_to_database();
+
    AP_Proximity_Temp_Boundary temp_boundary;
 
     // horizontal distance support
@@ -43,6 +50,23 @@ private:
     float _distance_max;        // max range of sensor in meters
     float _distance_min;        // min range of sensor in meters
 
+    // OBSTACLE_DISTANCE_3D points sharing a timestamp are downsampled
+    // to the closest point in each voxel and pushed to the OA database
+    // together once the frame is complete
+    struct {
+        struct {
+            int16_t voxel[3];       // voxel indices of the point
+            float yaw;              // yaw of the point in degrees
+            float pitch;            // pitch of the point in degrees
+            float distance;         // distance to the point in meters
+        } points[PROXIMITY_MAV_CLOUD_POINTS_MAX];
+        uint8_t count;              // number of voxels held
+        bool database_ready;        // true if the vehicle position and attitude below are valid
+        uint32_t timestamp_ms;      // system time the frame's first point was received
+        Vector3f current_pos;       // vehicle position when the frame's first point was received
+        Matrix3f body_to_ned;       // vehicle attitude when the frame's first point was received
+    } _cloud;
+
     // upward distance support
     uint32_t _last_upward_update_ms;    // system time of last update of upward distance
     float _distance_upward;             // upward distance in meters
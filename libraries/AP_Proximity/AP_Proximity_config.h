@@ -8,6 +8,12 @@
 #define HAL_PROXIMITY_ENABLED HAL_PROGRAM_SIZE_LIMIT_KB > 1024
 #endif
 
+// number of horizontal sectors in the 3D boundary, must divide 360 and be a multiple of 8
+// increase on boards with spare memory to keep more of the detail from 360 degree lidars
+#ifndef AP_PROXIMITY_NUM_SECTORS
+#define AP_PROXIMITY_NUM_SECTORS 8
+#endif
+
 #ifndef AP_PROXIMITY_BACKEND_DEFAULT_ENABLED
 #define AP_PROXIMITY_BACKEND_DEFAULT_ENABLED HAL_PROXIMITY_ENABLED
 #endif
@@ -303,6 +303,41 @@ bool AP_RCProtocol::process_byte(uint8_t byte, uint32_t baudrate)
     return false;
 }
 
+/*
+  process a block of bytes from a uart. Once a protocol is detected the
+  whole block is handed to its backend in one call, while searching
+  each byte is offered to every backend so we detect at the right byte
+ */
+bool AP_RCProtocol::process_bytes(const uint8_t *bytes, uint16_t n, uint32_t baudrate)
+{
+    if (n == 0) {
+        return false;
+    }
+    const uint32_t now = AP_HAL::millis();
+
+#if AP_RC_CHANNEL_ENABLED
+    rc_protocols_mask = rc().enabled_protocols();
+#endif
+
+    if (_detected_protocol != AP_RCProtocol::NONE &&
+        _detected_with_bytes &&
+        protocol_enabled(_detected_protocol) &&
+        !should_search(now)) {
+        backend[_detected_protocol]->process_bytes(bytes, n, baudrate);
+        if (backend[_detected_protocol]->new_input()) {
+            _new_input = true;
+            _last_input_ms = now;
+        }
+        return true;
+    }
+
+    bool ret = false;
+    for (uint16_t i = 0; i < n; i++) {
+        ret |= process_byte(bytes[i], baudrate);
+    }
+    return ret;
+}
+
 // handshake if nothing else has succeeded so far
 void AP_RCProtocol::process_handshake( uint32_t baudrate)
 {
@@ -378,13 +413,15 @@ void AP_RCProtocol::check_added_uart(void)
     const uint32_t current_baud = serial_configs[added.config_num].baud;
     process_handshake(current_baud);
 
-    uint32_t n = added.uart->available();
-    n = MIN(n, 255U);
-    for (uint8_t i=0; i<n; i++) {
-        int16_t b = added.uart->read();
-        if (b >= 0) {
-            process_byte(uint8_t(b), current_baud);
+    uint8_t buf[64];
+    uint32_t n = MIN(added.uart->available(), 255U);
+    while (n > 0) {
+        const ssize_t nread = added.uart->read(buf, MIN(n, sizeof(buf)));
+        if (nread <= 0) {
+            break;
         }
+        process_bytes(buf, nread, current_baud);
+        n -= MIN(n, uint32_t(nread));
     }
     if (searching) {
         if (now - added.last_config_change_ms > 1000) {
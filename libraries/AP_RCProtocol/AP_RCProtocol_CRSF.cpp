@@ -224,6 +224,35 @@ void AP_RCProtocol_CRSF::process_byte(uint8_t byte, uint32_t baudrate)
     _process_byte(byte);
 }
 
+// process a block of bytes provided by a uart from rc stack
+void AP_RCProtocol_CRSF::process_bytes(const uint8_t *bytes, uint16_t n, uint32_t baudrate)
+{
+    // reject RC data if we have been configured for standalone mode
+    if ((baudrate != CRSF_BAUDRATE && baudrate != CRSF_BAUDRATE_1MBIT && baudrate != CRSF_BAUDRATE_2MBIT) || _uart) {
+        return;
+    }
+    _process_bytes(bytes, n);
+}
+
+// process a block of bytes provided by a uart
+void AP_RCProtocol_CRSF::_process_bytes(const uint8_t *bytes, uint16_t n)
+{
+    while (n > 0) {
+        if (_frame_ofs == 0) {
+            // between frames anything before the next header would be
+            // discarded by check_frame(), so skip straight to it
+            const uint8_t *header = (const uint8_t *)memchr(bytes, DeviceAddress::CRSF_ADDRESS_FLIGHT_CONTROLLER, n);
+            if (header == nullptr) {
+                return;
+            }
+            n -= header - bytes;
+            bytes = header;
+        }
+        _process_byte(*bytes++);
+        n--;
+    }
+}
+
 // process a byte provided by a uart
 void AP_RCProtocol_CRSF::_process_byte(uint8_t byte)
 {
@@ -357,13 +386,15 @@ void AP_RCProtocol_CRSF::update(void)
             start_uart();
             _last_uart_start_time_ms = now;
         }
-        uint32_t n = _uart->available();
-        n = MIN(n, 255U);
-        for (uint8_t i = 0; i < n; i++) {
-            int16_t b = _uart->read();
-            if (b >= 0) {
-                _process_byte(uint8_t(b));
+        uint8_t buf[64];
+        uint32_t n = MIN(_uart->available(), 255U);
+        while (n > 0) {
+            const ssize_t nread = _uart->read(buf, MIN(n, sizeof(buf)));
+            if (nread <= 0) {
+                break;
             }
+            _process_bytes(buf, nread);
+            n -= MIN(n, uint32_t(nread));
         }
     }
 
@@ -18,6 +18,7 @@
 
 #include "AP_ROMFS.h"
 #include "tinf.h"
+#include <AP_Math/AP_Math.h>
 #include <AP_Math/crc.h>
 
 #include <AP_Common/AP_Common.h>
@@ -111,6 +112,102 @@ void AP_ROMFS::free(const uint8_t *data)
 #endif
 }
 
+/*
+  open a file for random access reads
+*/
+AP_ROMFS::Stream *AP_ROMFS::open_stream(const char *name)
+{
+    const struct embedded_file *f = find_file(name);
+    if (f == nullptr) {
+        return nullptr;
+    }
+    Stream *s = NEW_NOTHROW Stream(f);
+    if (s == nullptr) {
+        return nullptr;
+    }
+#ifndef HAL_ROMFS_UNCOMPRESSED
+    if (f->block_offsets != nullptr) {
+        s->block = (uint8_t *)malloc(BLOCK_SIZE);
+        s->tinf = (TINF_DATA *)malloc(sizeof(TINF_DATA));
+        if (s->block == nullptr || s->tinf == nullptr) {
+            delete s;
+            return nullptr;
+        }
+        return s;
+    }
+#endif
+    uint32_t size;
+    s->data = find_decompress(name, size);
+    if (s->data == nullptr) {
+        delete s;
+        return nullptr;
+    }
+    return s;
+}
+
+AP_ROMFS::Stream::~Stream()
+{
+    if (data != nullptr) {
+        AP_ROMFS::free(data);
+    }
+    ::free(block);
+    ::free(tinf);
+}
+
+/*
+  decompress one block of a block compressed file. Each block starts
+  after a full flush, so it is a self contained raw deflate stream
+*/
+bool AP_ROMFS::Stream::load_block(uint32_t idx)
+{
+    if (idx == block_idx) {
+        return true;
+    }
+    const uint32_t num_blocks = (f->decompressed_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const uint32_t start = f->block_offsets[idx];
+    const uint32_t end = idx+1 < num_blocks ? f->block_offsets[idx+1] : f->compressed_size;
+
+    uzlib_uncompress_init(tinf, NULL, 0);
+    tinf->source = f->contents + start;
+    tinf->source_limit = f->contents + end;
+    tinf->dest = block;
+    tinf->destSize = MIN(BLOCK_SIZE, f->decompressed_size - idx * BLOCK_SIZE);
+
+    if (uzlib_uncompress(tinf) != TINF_OK) {
+        block_idx = UINT32_MAX;
+        return false;
+    }
+    block_idx = idx;
+    return true;
+}
+
+int32_t AP_ROMFS::Stream::read(uint32_t ofs, void *buf, uint32_t count)
+{
+    if (ofs >= f->decompressed_size) {
+        return 0;
+    }
+    count = MIN(count, f->decompressed_size - ofs);
+    if (data != nullptr) {
+        memcpy(buf, &data[ofs], count);
+        return count;
+    }
+
+    uint8_t *b = (uint8_t *)buf;
+    uint32_t remaining = count;
+    while (remaining > 0) {
+        if (!load_block(ofs / BLOCK_SIZE)) {
+            return -1;
+        }
+        const uint32_t block_ofs = ofs % BLOCK_SIZE;
+        const uint32_t n = MIN(remaining, BLOCK_SIZE - block_ofs);
+        memcpy(b, &block[block_ofs], n);
+        b += n;
+        ofs += n;
+        remaining -= n;
+    }
+    return count;
+}
+
 /*
   directory listing interface. Start with ofs=0. Returns pathnames
   that match dirname prefix. Ends with nullptr return when no more
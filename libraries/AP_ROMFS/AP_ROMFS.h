@@ -5,8 +5,14 @@
 
 #include <stdint.h>
 
+struct TINF_DATA;
+
 class AP_ROMFS {
 public:
+    // size of the independently compressed blocks of large files,
+    // must match BLOCK_SIZE in Tools/ardupilotwaf/embed.py
+    static constexpr uint32_t BLOCK_SIZE = 8192;
+
     //  Find the named file and return its decompressed data and size. Caller
     //  must call AP_ROMFS::free() on the return value after use to free it.
     //  The data is guaranteed to be null-terminated such that it can be
@@ -33,8 +39,53 @@ private:
         uint32_t decompressed_size;
         uint32_t crc;
         const uint8_t *contents;
+        // offset of each BLOCK_SIZE block in contents, nullptr if the
+        // file is a single compressed stream
+        const uint32_t *block_offsets;
+    };
+
+public:
+    /*
+      random access reads of an embedded file. Large files are
+      decompressed one block at a time as they are read, so only
+      BLOCK_SIZE bytes of RAM are needed however big the file is.
+      Smaller files are decompressed in full when opened. Unlike
+      find_decompress() the CRC of block decompressed files is not
+      checked
+     */
+    class Stream {
+    public:
+        ~Stream();
+
+        // decompressed size of the file
+        uint32_t size() const { return f->decompressed_size; }
+
+        // read up to count bytes from offset ofs, returning the
+        // number of bytes read or -1 on a decompression error
+        int32_t read(uint32_t ofs, void *buf, uint32_t count);
+
+    private:
+        friend class AP_ROMFS;
+        Stream(const embedded_file *_f) : f(_f) {}
+
+        // decompress block idx into block
+        bool load_block(uint32_t idx);
+
+        const embedded_file *f;
+        // whole file, for files that are not block compressed
+        const uint8_t *data = nullptr;
+        // current block and its index
+        uint8_t *block = nullptr;
+        uint32_t block_idx = UINT32_MAX;
+        TINF_DATA *tinf = nullptr;
     };
 
+    // open a file for reading, returns nullptr if not found or out of
+    // memory. Free with delete
+    static Stream *open_stream(const char *name);
+
+private:
+
     // find an embedded file
     static const AP_ROMFS::embedded_file *find_file(const char *name);
 
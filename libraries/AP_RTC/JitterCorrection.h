@@ -19,6 +19,9 @@ public:
 
     int64_t get_link_offset_usec(void) const { return link_offset_usec; }
 
+    // forget the link offset, for when the offboard clock changes
+    void reset(void) { initialised = false; min_sample_counter = 0; }
+
 private:
     const uint16_t max_lag_ms;
     const uint16_t convergence_loops;
@@ -70,7 +70,7 @@ const AP_Param::GroupInfo AP_Scheduler::var_info[] = {
     // @Param: OPTIONS
     // @DisplayName: Scheduling options
     // @Description: This controls optional aspects of the scheduler.
-    // @Bitmask: 0:Enable per-task perf info
+    // @Bitmask: 0:Enable per-task perf info, 1:Deadline scheduling, 2:Run independent tasks in worker threads (Linux only)
     // @User: Advanced
     AP_GROUPINFO("OPTIONS",  2, AP_Scheduler, _options, 0),
 
@@ -137,8 +137,36 @@ void AP_Scheduler::init(const AP_Scheduler::Task *tasks, uint8_t num_tasks, uint
         perf_info.allocate_task_info(_num_tasks);
     }
 
+    if (_options & uint8_t(Options::DEADLINE_SCHEDULING)) {
+        _edf_cost_us = NEW_NOTHROW uint16_t[_num_tasks];
+        _edf_due = NEW_NOTHROW EDFDueTask[_num_tasks];
+        if (_edf_cost_us == nullptr || _edf_due == nullptr) {
+            delete[] _edf_cost_us;
+            delete[] _edf_due;
+            _edf_cost_us = nullptr;
+            _edf_due = nullptr;
+        } else {
+            // start with the promised time for each task
+            uint8_t vehicle_tasks_offset = 0;
+            uint8_t common_tasks_offset = 0;
+            for (uint8_t i=0; i<_num_tasks; i++) {
+                const Task *task = next_task(vehicle_tasks_offset, common_tasks_offset);
+                if (task == nullptr) {
+                    break;
+                }
+                _edf_cost_us[i] = task->max_time_micros;
+            }
+        }
+    }
+
     _log_performance_bit = log_performance_bit;
 
+#if AP_SCHEDULER_WORKERS_ENABLED
+    if (_options & uint8_t(Options::WORKER_THREADS)) {
+        workers_init();
+    }
+#endif
+
     // sanity check the task lists to ensure the priorities are
     // never decrease
     uint8_t old = 0;
@@ -178,73 +206,211 @@ static void fill_nanf_stack(void)
 }
 #endif
 
+/*
+  return the task at index i of the merged common/vehicle task list,
+  advancing the offsets into each list
+ */
+const AP_Scheduler::Task *AP_Scheduler::next_task(uint8_t &vehicle_tasks_offset, uint8_t &common_tasks_offset) const
+{
+    // determine which of the common task / vehicle task to run
+    bool run_vehicle_task = false;
+    if (vehicle_tasks_offset < _num_vehicle_tasks &&
+        common_tasks_offset < _num_common_tasks) {
+        // still have entries on both lists; compare the
+        // priorities.  In case of a tie the vehicle-specific
+        // entry wins.
+        const Task &vehicle_task = _vehicle_tasks[vehicle_tasks_offset];
+        const Task &common_task = _common_tasks[common_tasks_offset];
+        if (vehicle_task.priority <= common_task.priority) {
+            run_vehicle_task = true;
+        }
+    } else if (vehicle_tasks_offset < _num_vehicle_tasks) {
+        // out of common tasks to run
+        run_vehicle_task = true;
+    } else if (common_tasks_offset < _num_common_tasks) {
+        // out of vehicle tasks to run
+        run_vehicle_task = false;
+    } else {
+        // this is an error; the outside loop should have terminated
+        INTERNAL_ERROR(AP_InternalError::error_t::flow_of_control);
+        return nullptr;
+    }
+
+    if (run_vehicle_task) {
+        return &_vehicle_tasks[vehicle_tasks_offset++];
+    }
+    return &_common_tasks[common_tasks_offset++];
+}
+
+// number of loop ticks between runs of a task
+uint32_t AP_Scheduler::task_interval_ticks(const Task &task) const
+{
+    // we allow 0 to mean loop rate
+    uint32_t interval_ticks = (is_zero(task.rate_hz) ? 1 : _loop_rate_hz / task.rate_hz);
+    if (interval_ticks < 1) {
+        interval_ticks = 1;
+    }
+    return interval_ticks;
+}
+
+/*
+  check if a non-fast task is due to run, updating the slip
+  accounting. Returns false if the task is not yet due
+ */
+bool AP_Scheduler::task_due(uint8_t i, const Task &task)
+{
+    const uint16_t dt = _tick_counter - _last_run[i];
+    const uint32_t interval_ticks = task_interval_ticks(task);
+    if (dt < interval_ticks) {
+        // this task is not yet scheduled to run again
+        return false;
+    }
+
+    if (dt >= interval_ticks*2) {
+        perf_info.task_slipped(i);
+    }
+
+    if (dt >= interval_ticks*max_task_slowdown) {
+        // we are going beyond the maximum slowdown factor for a
+        // task. This will trigger increasing the time budget
+        task_not_achieved++;
+    }
+    return true;
+}
+
+/*
+  run a single task, updating its statistics and the time available
+  for the rest of the tick
+ */
+void AP_Scheduler::run_task(uint8_t i, const Task &task, uint32_t &now, uint32_t &time_available)
+{
+#if AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+    if (perf_info.has_task_info()) {
+        // time since the start of the loop in which the task
+        // first became due
+        uint32_t start_delay_us = now - uint32_t(_loop_sample_time_us);
+        if (task.priority > MAX_FAST_TASK_PRIORITIES) {
+            const uint16_t dt = _tick_counter - _last_run[i];
+            const uint32_t interval_ticks = task_interval_ticks(task);
+            if (dt > interval_ticks) {
+                start_delay_us += (dt - interval_ticks) * get_loop_period_us();
+            }
+        }
+        perf_info.update_task_jitter(i, start_delay_us);
+    }
+#endif
+
+    // run it
+    _task_time_started = now;
+    hal.util->persistent_data.scheduler_task = i;
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+    fill_nanf_stack();
+#endif
+    task.function();
+    hal.util->persistent_data.scheduler_task = -1;
+
+    // record the tick counter when we ran. This drives
+    // when we next run the event
+    _last_run[i] = _tick_counter;
+
+    // work out how long the event actually took
+    now = AP_HAL::micros();
+    uint32_t time_taken = now - _task_time_started;
+    bool overrun = false;
+    if (time_taken > _task_time_allowed) {
+        overrun = true;
+        // the event overran!
+        debug(3, "Scheduler overrun task[%u-%s] (%u/%u)\n",
+              (unsigned)i,
+              task.name,
+              (unsigned)time_taken,
+              (unsigned)_task_time_allowed);
+    }
+
+    perf_info.update_task_info(i, time_taken, overrun);
+
+    if (_edf_cost_us != nullptr) {
+        // keep a fast-attack slow-decay estimate of the cost of
+        // the task for deadline scheduling
+        uint16_t &cost = _edf_cost_us[i];
+        const uint16_t taken = MIN(time_taken, UINT16_MAX);
+        if (taken > cost) {
+            cost = taken;
+        } else {
+            cost -= (cost - taken) / 8;
+        }
+    }
+
+    if (time_taken >= time_available) {
+        /*
+          we are out of time, but we need to keep walking the task
+          table in case there is another fast loop task after this
+          task, plus we need to update the accouting so we can
+          work out if we need to allocate extra time for the loop
+          (lower the loop rate)
+          Just set time_available to zero, which means we will
+          only run fast tasks after this one
+         */
+        time_available = 0;
+    } else {
+        time_available -= time_taken;
+    }
+}
+
 /*
   run one tick
   this will run as many scheduler tasks as we can in the specified time
  */
 void AP_Scheduler::run(uint32_t time_available)
 {
-    uint32_t run_started_usec = AP_HAL::micros();
-    uint32_t now = run_started_usec;
+#if AP_SCHEDULER_WORKERS_ENABLED
+    workers_collect();
+#endif
+
+    if (_edf_cost_us != nullptr) {
+        run_deadline(time_available);
+    } else {
+        run_priority(time_available);
+    }
+
+    // update number of spare microseconds
+    _spare_micros += time_available;
+
+    _spare_ticks++;
+    if (_spare_ticks == 32) {
+        _spare_ticks /= 2;
+        _spare_micros /= 2;
+    }
+}
+
+/*
+  run tasks in priority order, skipping any whose time budget does not
+  fit in the remaining time
+ */
+void AP_Scheduler::run_priority(uint32_t &time_available)
+{
+    uint32_t now = AP_HAL::micros();
 
     uint8_t vehicle_tasks_offset = 0;
     uint8_t common_tasks_offset = 0;
 
     for (uint8_t i=0; i<_num_tasks; i++) {
-        // determine which of the common task / vehicle task to run
-        bool run_vehicle_task = false;
-        if (vehicle_tasks_offset < _num_vehicle_tasks &&
-            common_tasks_offset < _num_common_tasks) {
-            // still have entries on both lists; compare the
-            // priorities.  In case of a tie the vehicle-specific
-            // entry wins.
-            const Task &vehicle_task = _vehicle_tasks[vehicle_tasks_offset];
-            const Task &common_task = _common_tasks[common_tasks_offset];
-            if (vehicle_task.priority <= common_task.priority) {
-                run_vehicle_task = true;
-            }
-        } else if (vehicle_tasks_offset < _num_vehicle_tasks) {
-            // out of common tasks to run
-            run_vehicle_task = true;
-        } else if (common_tasks_offset < _num_common_tasks) {
-            // out of vehicle tasks to run
-            run_vehicle_task = false;
-        } else {
-            // this is an error; the outside loop should have terminated
-            INTERNAL_ERROR(AP_InternalError::error_t::flow_of_control);
+        const Task *task = next_task(vehicle_tasks_offset, common_tasks_offset);
+        if (task == nullptr) {
             break;
         }
 
-        const AP_Scheduler::Task &task = run_vehicle_task ? _vehicle_tasks[vehicle_tasks_offset] : _common_tasks[common_tasks_offset];
-        if (run_vehicle_task) {
-            vehicle_tasks_offset++;
-        } else {
-            common_tasks_offset++;
-        }
-
-        if (task.priority > MAX_FAST_TASK_PRIORITIES) {
-            const uint16_t dt = _tick_counter - _last_run[i];
-            // we allow 0 to mean loop rate
-            uint32_t interval_ticks = (is_zero(task.rate_hz) ? 1 : _loop_rate_hz / task.rate_hz);
-            if (interval_ticks < 1) {
-                interval_ticks = 1;
+        if (task->priority > MAX_FAST_TASK_PRIORITIES) {
+            if (!task_due(i, *task)) {
+                continue;
             }
-            if (dt < interval_ticks) {
-                // this task is not yet scheduled to run again
+#if AP_SCHEDULER_WORKERS_ENABLED
+            if (task->run_in_worker && worker_dispatch(i, *task)) {
                 continue;
             }
+#endif
             // this task is due to run. Do we have enough time to run it?
-            _task_time_allowed = task.max_time_micros;
-
-            if (dt >= interval_ticks*2) {
-                perf_info.task_slipped(i);
-            }
-
-            if (dt >= interval_ticks*max_task_slowdown) {
-                // we are going beyond the maximum slowdown factor for a
-                // task. This will trigger increasing the time budget
-                task_not_achieved++;
-            }
+            _task_time_allowed = task->max_time_micros;
 
             if (_task_time_allowed > time_available) {
                 // not enough time to run this task.  Continue loop -
@@ -255,61 +421,215 @@ void AP_Scheduler::run(uint32_t time_available)
             _task_time_allowed = get_loop_period_us();
         }
 
-        // run it
-        _task_time_started = now;
-        hal.util->persistent_data.scheduler_task = i;
-#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
-        fill_nanf_stack();
+        run_task(i, *task, now, time_available);
+    }
+}
+
+/*
+  run fast tasks in table order, then run the due tasks in earliest
+  deadline first order. The deadline of a task is the tick at which
+  its next run becomes due, so tasks that have slipped the most go
+  first. Tasks are chosen on their measured cost rather than their
+  max_time_micros so time left by tasks finishing early is reused
+ */
+void AP_Scheduler::run_deadline(uint32_t &time_available)
+{
+    uint32_t now = AP_HAL::micros();
+
+    uint8_t vehicle_tasks_offset = 0;
+    uint8_t common_tasks_offset = 0;
+    uint8_t num_due = 0;
+
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        const Task *task = next_task(vehicle_tasks_offset, common_tasks_offset);
+        if (task == nullptr) {
+            break;
+        }
+        if (task->priority > MAX_FAST_TASK_PRIORITIES) {
+            if (task_due(i, *task)) {
+#if AP_SCHEDULER_WORKERS_ENABLED
+                if (task->run_in_worker && worker_dispatch(i, *task)) {
+                    continue;
+                }
 #endif
-        task.function();
-        hal.util->persistent_data.scheduler_task = -1;
-
-        // record the tick counter when we ran. This drives
-        // when we next run the event
-        _last_run[i] = _tick_counter;
-
-        // work out how long the event actually took
-        now = AP_HAL::micros();
-        uint32_t time_taken = now - _task_time_started;
-        bool overrun = false;
-        if (time_taken > _task_time_allowed) {
-            overrun = true;
-            // the event overran!
-            debug(3, "Scheduler overrun task[%u-%s] (%u/%u)\n",
-                  (unsigned)i,
-                  task.name,
-                  (unsigned)time_taken,
-                  (unsigned)_task_time_allowed);
+                _edf_due[num_due].task = task;
+                _edf_due[num_due].index = i;
+                num_due++;
+            }
+            continue;
         }
+        _task_time_allowed = get_loop_period_us();
+        run_task(i, *task, now, time_available);
+    }
 
-        perf_info.update_task_info(i, time_taken, overrun);
-
-        if (time_taken >= time_available) {
-            /*
-              we are out of time, but we need to keep walking the task
-              table in case there is another fast loop task after this
-              task, plus we need to update the accouting so we can
-              work out if we need to allocate extra time for the loop
-              (lower the loop rate)
-              Just set time_available to zero, which means we will
-              only run fast tasks after this one
-             */
-            time_available = 0;
-        } else {
-            time_available -= time_taken;
+    while (num_due > 0 && time_available > 0) {
+        // find the due task with the earliest deadline that fits in
+        // the remaining time. Ties go to the task table order
+        int8_t best = -1;
+        int32_t best_deadline = 0;
+        for (uint8_t d=0; d<num_due; d++) {
+            const uint8_t i = _edf_due[d].index;
+            if (_edf_cost_us[i] > time_available) {
+                continue;
+            }
+            const int32_t deadline = int32_t(task_interval_ticks(*_edf_due[d].task)) - uint16_t(_tick_counter - _last_run[i]);
+            if (best == -1 || deadline < best_deadline) {
+                best = d;
+                best_deadline = deadline;
+            }
+        }
+        if (best == -1) {
+            // nothing else fits this tick
+            break;
         }
+        const Task &task = *_edf_due[best].task;
+        const uint8_t i = _edf_due[best].index;
+        // remove from the due list, keeping table order
+        num_due--;
+        memmove(&_edf_due[best], &_edf_due[best+1], (num_due-best)*sizeof(_edf_due[0]));
+
+        _task_time_allowed = task.max_time_micros;
+        run_task(i, task, now, time_available);
     }
+}
 
-    // update number of spare microseconds
-    _spare_micros += time_available;
+#if AP_SCHEDULER_WORKERS_ENABLED
+/*
+  start the worker threads if any task may run in them
+ */
+void AP_Scheduler::workers_init()
+{
+    bool have_worker_task = false;
+    uint8_t vehicle_tasks_offset = 0;
+    uint8_t common_tasks_offset = 0;
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        const Task *task = next_task(vehicle_tasks_offset, common_tasks_offset);
+        if (task == nullptr) {
+            break;
+        }
+        if (task->run_in_worker) {
+            have_worker_task = true;
+        }
+    }
+    if (!have_worker_task) {
+        return;
+    }
 
-    _spare_ticks++;
-    if (_spare_ticks == 32) {
-        _spare_ticks /= 2;
-        _spare_micros /= 2;
+    _workers.jobs = NEW_NOTHROW WorkerJob[_num_tasks];
+    _workers.queue = NEW_NOTHROW uint8_t[_num_tasks];
+    if (_workers.jobs == nullptr || _workers.queue == nullptr) {
+        delete[] _workers.jobs;
+        delete[] _workers.queue;
+        _workers.jobs = nullptr;
+        _workers.queue = nullptr;
+        return;
+    }
+
+    for (uint8_t w=0; w<AP_SCHEDULER_NUM_WORKERS; w++) {
+        if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Scheduler::worker_thread, void),
+                                          "sched_wk", 8192, AP_HAL::Scheduler::PRIORITY_IO, 0)) {
+            if (w == 0) {
+                // no workers, run the tasks on the main thread
+                delete[] _workers.jobs;
+                delete[] _workers.queue;
+                _workers.jobs = nullptr;
+                _workers.queue = nullptr;
+                return;
+            }
+            break;
+        }
     }
 }
 
+/*
+  worker thread main loop, running queued tasks
+ */
+void AP_Scheduler::worker_thread()
+{
+    while (true) {
+        // the timeout covers a wakeup taken by another worker
+        IGNORE_RETURN(_workers.wakeup.wait(100000));
+
+        while (true) {
+            uint8_t i;
+            const Task *task;
+            {
+                WITH_SEMAPHORE(_workers.sem);
+                if (_workers.queue_len == 0) {
+                    break;
+                }
+                i = _workers.queue[_workers.queue_head];
+                _workers.queue_head = (_workers.queue_head + 1) % _num_tasks;
+                _workers.queue_len--;
+                _workers.jobs[i].state = WorkerState::RUNNING;
+                task = _workers.jobs[i].task;
+            }
+
+            const uint32_t start_us = AP_HAL::micros();
+            task->function();
+            const uint32_t time_taken = AP_HAL::micros() - start_us;
+
+            WITH_SEMAPHORE(_workers.sem);
+            _workers.jobs[i].time_taken_us = MIN(time_taken, UINT16_MAX);
+            _workers.jobs[i].state = WorkerState::DONE;
+        }
+    }
+}
+
+/*
+  queue a due task for the worker threads. Returns false if there are
+  no workers, in which case the task runs on the main thread
+ */
+bool AP_Scheduler::worker_dispatch(uint8_t i, const Task &task)
+{
+    if (_workers.jobs == nullptr) {
+        return false;
+    }
+
+    // the task is not run again until the next interval whether or
+    // not it could be queued, so a slow worker task never adds to the
+    // main loop time budget
+    _last_run[i] = _tick_counter;
+
+    {
+        WITH_SEMAPHORE(_workers.sem);
+        WorkerJob &job = _workers.jobs[i];
+        if (job.state != WorkerState::IDLE) {
+            // the last run has not completed yet
+            perf_info.task_slipped(i);
+            return true;
+        }
+        job.task = &task;
+        job.state = WorkerState::QUEUED;
+        _workers.queue[(_workers.queue_head + _workers.queue_len) % _num_tasks] = i;
+        _workers.queue_len++;
+    }
+
+    _workers.wakeup.signal();
+    return true;
+}
+
+/*
+  record the statistics of worker task runs completed since the last
+  tick, making the tasks available to be queued again
+ */
+void AP_Scheduler::workers_collect()
+{
+    if (_workers.jobs == nullptr) {
+        return;
+    }
+    WITH_SEMAPHORE(_workers.sem);
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        WorkerJob &job = _workers.jobs[i];
+        if (job.state != WorkerState::DONE) {
+            continue;
+        }
+        perf_info.update_task_info(i, job.time_taken_us, job.time_taken_us > job.task->max_time_micros);
+        job.state = WorkerState::IDLE;
+    }
+}
+#endif  // AP_SCHEDULER_WORKERS_ENABLED
+
 /*
   return number of micros until the current task reaches its deadline
  */
@@ -472,6 +792,17 @@ void AP_Scheduler::Log_Write_Performance()
         rtc              : rtc,
     };
     AP::logger().WriteCriticalBlock(&pkt, sizeof(pkt));
+
+    const AP::PerfInfo::Histogram &loop_hist = perf_info.get_loop_histogram();
+    const struct log_PerformanceHistogram hpkt {
+        LOG_PACKET_HEADER_INIT(LOG_PERF_HISTOGRAM_MSG),
+        time_us          : pkt.time_us,
+        p50              : loop_hist.percentile(0.5),
+        p99              : loop_hist.percentile(0.99),
+        p999             : loop_hist.percentile(0.999),
+        max_time         : perf_info.get_max_time(),
+    };
+    AP::logger().WriteBlock(&hpkt, sizeof(hpkt));
 }
 #endif  // HAL_LOGGING_ENABLED
 
@@ -505,41 +836,54 @@ void AP_Scheduler::task_info(ExpandingString &str)
 
     for (uint8_t i = 0; i < _num_tasks; i++) {
         const AP::PerfInfo::TaskInfo* ti = perf_info.get_task_info(i);
-        const char *task_name;
-
-        // determine which of the common task / vehicle task to run
-        bool run_vehicle_task = false;
-        if (vehicle_tasks_offset < _num_vehicle_tasks &&
-            common_tasks_offset < _num_common_tasks) {
-            // still have entries on both lists; compare the
-            // priorities.  In case of a tie the vehicle-specific
-            // entry wins.
-            const Task &vehicle_task = _vehicle_tasks[vehicle_tasks_offset];
-            const Task &common_task = _common_tasks[common_tasks_offset];
-            if (vehicle_task.priority <= common_task.priority) {
-                run_vehicle_task = true;
-            }
-        } else if (vehicle_tasks_offset < _num_vehicle_tasks) {
-            // out of common tasks to run
-            run_vehicle_task = true;
-        } else if (common_tasks_offset < _num_common_tasks) {
-            // out of vehicle tasks to run
-            run_vehicle_task = false;
-        } else {
-            // this is an error; the outside loop should have terminated
-            INTERNAL_ERROR(AP_InternalError::error_t::flow_of_control);
+        const Task *task = next_task(vehicle_tasks_offset, common_tasks_offset);
+        if (task == nullptr) {
             return;
         }
 
-        if (run_vehicle_task) {
-            task_name = _vehicle_tasks[vehicle_tasks_offset++].name;
-        } else {
-            task_name = _common_tasks[common_tasks_offset++].name;
+        ti->print(task->name, total_time, str);
+    }
+}
+
+#if AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+// display task latency percentiles as text buffer for @SYS/latency.txt
+void AP_Scheduler::task_latency(ExpandingString &str)
+{
+    // a header to allow for machine parsers to determine format
+    str.printf("LatencyV1\n");
+
+    const AP::PerfInfo::Histogram &loop_hist = perf_info.get_loop_histogram();
+    str.printf("Loop N=%u P50=%u P99=%u P999=%u MAX=%u\n",
+               unsigned(loop_hist.count()),
+               unsigned(loop_hist.percentile(0.5)),
+               unsigned(loop_hist.percentile(0.99)),
+               unsigned(loop_hist.percentile(0.999)),
+               unsigned(perf_info.get_max_time()));
+
+    // dynamically enable statistics collection
+    if (!(_options & uint8_t(Options::RECORD_TASK_INFO))) {
+        _options.set(_options | uint8_t(Options::RECORD_TASK_INFO));
+        return;
+    }
+
+    uint8_t vehicle_tasks_offset = 0;
+    uint8_t common_tasks_offset = 0;
+
+    for (uint8_t i = 0; i < _num_tasks; i++) {
+        const AP::PerfInfo::TaskInfo* ti = perf_info.get_task_info(i);
+        if (ti == nullptr) {
+            return;
+        }
+
+        const Task *task = next_task(vehicle_tasks_offset, common_tasks_offset);
+        if (task == nullptr) {
+            return;
         }
 
-        ti->print(task_name, total_time, str);
+        ti->print_latency(task->name, str);
     }
 }
+#endif  // AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
 
 namespace AP {
 
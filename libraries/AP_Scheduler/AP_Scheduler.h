@@ -47,7 +47,23 @@
     AP_SCHEDULER_NAME_INITIALIZER(classname, func)\
     .rate_hz = _rate_hz,\
     .max_time_micros = _max_time_micros,        \
-    .priority = _priority \
+    .priority = _priority, \
+    .run_in_worker = false \
+}
+
+/*
+  as SCHED_TASK_CLASS, for a task which is independent of the main
+  loop and is safe to run concurrently with it. On boards with
+  scheduler worker threads it runs in one of those instead of on the
+  main thread
+ */
+#define SCHED_WORKER_TASK_CLASS(classname, classptr, func, _rate_hz, _max_time_micros, _priority) { \
+    .function = FUNCTOR_BIND(classptr, &classname::func, void),\
+    AP_SCHEDULER_NAME_INITIALIZER(classname, func)\
+    .rate_hz = _rate_hz,\
+    .max_time_micros = _max_time_micros,        \
+    .priority = _priority, \
+    .run_in_worker = true \
 }
 
 /*
@@ -58,7 +74,8 @@
     AP_FAST_NAME_INITIALIZER(classname, func)\
     .rate_hz = 0,\
     .max_time_micros = 0,\
-    .priority = AP_Scheduler::FAST_TASK_PRI0 \
+    .priority = AP_Scheduler::FAST_TASK_PRI0, \
+    .run_in_worker = false \
 }
 
 /*
@@ -90,10 +107,13 @@ public:
         float rate_hz;
         uint16_t max_time_micros;
         uint8_t priority; // task priority
+        bool run_in_worker; // may run in a worker thread
     };
 
     enum class Options : uint8_t {
-        RECORD_TASK_INFO = 1 << 0
+        RECORD_TASK_INFO = 1 << 0,
+        DEADLINE_SCHEDULING = 1 << 1,
+        WORKER_THREADS = 1 << 2,
     };
 
     enum FastTaskPriorities {
@@ -189,6 +209,10 @@ public:
     HAL_Semaphore &get_semaphore(void) { return _rsem; }
 
     void task_info(ExpandingString &str);
+#if AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+    // display per-task latency percentiles for @SYS/latency.txt
+    void task_latency(ExpandingString &str);
+#endif
 
     static const struct AP_Param::GroupInfo var_info[];
 
@@ -270,6 +294,56 @@ private:
     // the loop rate in case we are well over budget
     uint32_t extra_loop_us;
 
+    const Task *next_task(uint8_t &vehicle_tasks_offset, uint8_t &common_tasks_offset) const;
+    uint32_t task_interval_ticks(const Task &task) const;
+    bool task_due(uint8_t i, const Task &task);
+    void run_task(uint8_t i, const Task &task, uint32_t &now, uint32_t &time_available);
+    void run_priority(uint32_t &time_available);
+    void run_deadline(uint32_t &time_available);
+
+    // state for earliest deadline first scheduling, allocated at
+    // init if the DEADLINE_SCHEDULING option is set
+    struct EDFDueTask {
+        const Task *task;
+        uint8_t index;
+    };
+    EDFDueTask *_edf_due = nullptr;
+    uint16_t *_edf_cost_us = nullptr; // predicted cost of each task
+
+
+#if AP_SCHEDULER_WORKERS_ENABLED
+    /*
+      pool of threads running the tasks flagged run_in_worker, started
+      at init if the WORKER_THREADS option is set. Due tasks are
+      queued by the main thread and taken by whichever worker is free.
+      A task is not queued again until its last run has completed, and
+      the main thread folds completed runs into perf_info
+     */
+    enum class WorkerState : uint8_t {
+        IDLE,
+        QUEUED,
+        RUNNING,
+        DONE,
+    };
+    struct WorkerJob {
+        const Task *task;
+        uint16_t time_taken_us;
+        WorkerState state;
+    };
+    struct {
+        WorkerJob *jobs;        // one per task
+        uint8_t *queue;         // ring of task indexes
+        uint8_t queue_head;
+        uint8_t queue_len;
+        HAL_Semaphore sem;      // protects jobs and queue
+        HAL_BinarySemaphore wakeup;
+    } _workers;
+
+    void workers_init();
+    void worker_thread();
+    bool worker_dispatch(uint8_t i, const Task &task);
+    void workers_collect();
+#endif
 
     // semaphore that is held while not waiting for ins samples
     HAL_Semaphore _rsem;
@@ -9,3 +9,17 @@
 #ifndef AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED
 #define AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED 1
 #endif
+
+// per-task execution time and start jitter histograms for @SYS/latency.txt
+#ifndef AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+#define AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#endif
+
+// run tasks flagged run_in_worker in a pool of threads on multi-core boards
+#ifndef AP_SCHEDULER_WORKERS_ENABLED
+#define AP_SCHEDULER_WORKERS_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
+#ifndef AP_SCHEDULER_NUM_WORKERS
+#define AP_SCHEDULER_NUM_WORKERS 2
+#endif
@@ -31,6 +31,7 @@ void AP::PerfInfo::reset()
     long_running = 0;
     sigma_time = 0;
     sigmasquared_time = 0;
+    loop_hist = Histogram{};
     if (_task_info != nullptr) {
         memset(_task_info, 0, (_num_tasks) * sizeof(TaskInfo));
     }
@@ -78,6 +79,9 @@ void AP::PerfInfo::update_task_info(uint8_t task_index, uint16_t task_time_us, b
 
 void AP::PerfInfo::TaskInfo::update(uint16_t task_time_us, bool overrun)
 {
+#if AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+    time_hist.add(task_time_us);
+#endif
     max_time_us = MAX(max_time_us, task_time_us);
     if (min_time_us == 0) {
         min_time_us = task_time_us;
@@ -109,6 +113,87 @@ void AP::PerfInfo::TaskInfo::print(const char* task_name, uint32_t total_time, E
                 unsigned(MIN(overrun_count, 999)), unsigned(MIN(slip_count, 999)), pct);
 }
 
+#if AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+void AP::PerfInfo::TaskInfo::print_latency(const char* task_name, ExpandingString& str) const
+{
+#if AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED
+    const char* fmt = "%-32.32s N=%5u P50=%5u P99=%5u P999=%5u JP50=%5u JP99=%5u JP999=%5u\n";
+#else
+    const char* fmt = "%-16.16s N=%5u P50=%5u P99=%5u P999=%5u JP50=%5u JP99=%5u JP999=%5u\n";
+#endif
+    str.printf(fmt, task_name,
+               unsigned(MIN(time_hist.count(), 99999U)),
+               unsigned(time_hist.percentile(0.5)),
+               unsigned(time_hist.percentile(0.99)),
+               unsigned(time_hist.percentile(0.999)),
+               unsigned(jitter_hist.percentile(0.5)),
+               unsigned(jitter_hist.percentile(0.99)),
+               unsigned(jitter_hist.percentile(0.999)));
+}
+#endif
+
+/*
+  map a time to a bucket. Times below 4us get a bucket each, after
+  that each power of two gets 4 buckets
+ */
+uint8_t AP::PerfInfo::Histogram::bucket_index(uint32_t time_us)
+{
+    const uint32_t sub_buckets = 1U<<SUB_BUCKET_BITS;
+    if (time_us < sub_buckets) {
+        return time_us;
+    }
+    const uint8_t msb = 31 - __builtin_clz(time_us);
+    const uint8_t shift = msb - SUB_BUCKET_BITS;
+    const uint8_t sub = (time_us >> shift) & (sub_buckets-1);
+    return MIN((shift+1)*sub_buckets + sub, NUM_BUCKETS-1);
+}
+
+// largest time that maps to a bucket
+uint32_t AP::PerfInfo::Histogram::bucket_upper_bound(uint8_t index)
+{
+    const uint32_t sub_buckets = 1U<<SUB_BUCKET_BITS;
+    if (index < sub_buckets) {
+        return index;
+    }
+    const uint8_t shift = index / sub_buckets - 1;
+    const uint32_t sub = index % sub_buckets;
+    return ((sub_buckets + sub + 1) << shift) - 1;
+}
+
+void AP::PerfInfo::Histogram::add(uint32_t time_us)
+{
+    uint16_t &c = counts[bucket_index(time_us)];
+    if (c < UINT16_MAX) {
+        c++;
+    }
+}
+
+uint32_t AP::PerfInfo::Histogram::count() const
+{
+    uint32_t total = 0;
+    for (const auto c : counts) {
+        total += c;
+    }
+    return total;
+}
+
+uint32_t AP::PerfInfo::Histogram::percentile(float fraction) const
+{
+    const uint32_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    const uint32_t target = MAX(1U, uint32_t(total * fraction + 0.5f));
+    uint32_t sum = 0;
+    for (uint8_t i=0; i<NUM_BUCKETS; i++) {
+        sum += counts[i];
+        if (sum >= target) {
+            return bucket_upper_bound(i);
+        }
+    }
+    return bucket_upper_bound(NUM_BUCKETS-1);
+}
+
 // check_loop_time - check latest loop time vs min, max and overtime threshold
 void AP::PerfInfo::check_loop_time(uint32_t time_in_micros)
 {
@@ -131,6 +216,7 @@ void AP::PerfInfo::check_loop_time(uint32_t time_in_micros)
     }
     sigma_time += time_in_micros;
     sigmasquared_time += time_in_micros * time_in_micros;
+    loop_hist.add(time_in_micros);
 
     /* we keep a filtered loop time for use as G_Dt which is the
        predicted time for the next loop. We remove really excessive
@@ -13,6 +13,27 @@ class PerfInfo {
 public:
     PerfInfo() {}
 
+    /*
+      fixed size log-linear histogram of times in microseconds. Each
+      power of two is split into 4 linear sub-buckets, giving a
+      resolution of better than 25% up to the last bucket
+     */
+    class Histogram {
+    public:
+        void add(uint32_t time_us);
+        // return the upper bound of the bucket containing the given
+        // fraction of all samples, e.g. 0.99 for p99
+        uint32_t percentile(float fraction) const;
+        uint32_t count() const;
+
+    private:
+        static const uint8_t SUB_BUCKET_BITS = 2;
+        static const uint8_t NUM_BUCKETS = 52; // last bucket starts at 14336us
+        static uint8_t bucket_index(uint32_t time_us);
+        static uint32_t bucket_upper_bound(uint8_t index);
+        uint16_t counts[NUM_BUCKETS];
+    };
+
     // per-task timing information
     struct TaskInfo {
         uint16_t min_time_us;
@@ -21,9 +42,16 @@ public:
         uint32_t tick_count;
         uint16_t slip_count;
         uint16_t overrun_count;
+#if AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+        Histogram time_hist;    // execution time
+        Histogram jitter_hist;  // start time relative to when the task was due
+#endif
 
         void update(uint16_t task_time_us, bool overrun);
         void print(const char* task_name, uint32_t total_time, ExpandingString& str) const;
+#if AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+        void print_latency(const char* task_name, ExpandingString& str) const;
+#endif
     };
 
     /* Do not allow copies */
@@ -55,6 +83,16 @@ public:
     }
     // called after each run of a task to update its statistics based on measurements taken by the scheduler
     void update_task_info(uint8_t task_index, uint16_t task_time_us, bool overrun);
+#if AP_SCHEDULER_TASK_HISTOGRAMS_ENABLED
+    // record how late a task started relative to when it was due
+    void update_task_jitter(uint8_t task_index, uint32_t start_delay_us) {
+        if (_task_info && task_index < _num_tasks) {
+            _task_info[task_index].jitter_hist.add(start_delay_us);
+        }
+    }
+#endif
+    // histogram of main loop times since the last reset
+    const Histogram &get_loop_histogram() const { return loop_hist; }
     // record that a task slipped
     void task_slipped(uint8_t task_index) {
         if (_task_info && task_index < _num_tasks) {
@@ -74,6 +112,7 @@ private:
     uint32_t last_check_us;
     float filtered_loop_time;
     bool ignore_loop;
+    Histogram loop_hist;
     // performance monitoring
     uint8_t _num_tasks;
     TaskInfo* _task_info;
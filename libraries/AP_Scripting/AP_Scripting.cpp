@@ -22,6 +22,7 @@
 #include <AP_HAL/AP_HAL.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_Arming/AP_Arming.h>
+#include <AP_Vehicle/AP_Vehicle.h>
 
 #include "lua_scripts.h"
 #include "AP_Scripting_helpers.h"
@@ -98,6 +99,7 @@ const AP_Param::GroupInfo AP_Scripting::var_info[] = {
     // @Bitmask: 4: Disable pre-arm check
     // @Bitmask: 5: Save CRC of current scripts to loaded and running checksum parameters enabling pre-arm
     // @Bitmask: 6: Disable heap expansion on allocation failure
+    // @Bitmask: 7: Profile scripts, saving a flame graph to profile.txt in the scripts directory
     // @User: Advanced
     AP_GROUPINFO("DEBUG_OPTS", 4, AP_Scripting, _debug_options, 0),
 
@@ -199,6 +201,34 @@ const AP_Param::GroupInfo AP_Scripting::var_info[] = {
 #endif
 #endif // AP_SCRIPTING_SERIALDEVICE_ENABLED
 
+    // @Param: GC_BUDGET
+    // @DisplayName: Scripting garbage collection time budget
+    // @Description: Time the garbage collector may run for after each script. The collector is run incrementally until this time is used, a collection cycle finishes or the next script is due. Zero does a full collection after each script, which can take several milliseconds with a large heap.
+    // @Units: us
+    // @Range: 0 10000
+    // @User: Advanced
+    AP_GROUPINFO("GC_BUDGET", 19, AP_Scripting, _gc_budget_us, 1000),
+
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+    // @Param: VM2_HEAP
+    // @DisplayName: Scripting second VM heap size
+    // @Description: Amount of memory available for scripts run in the second scripting VM, zero disables it. Scripts are run in the second VM if their first line is "-- @vm 2", they have their own heap and thread, so a script with a large heap or long run time does not delay the scripts in the first VM. All other scripts are run in the first VM.
+    // @Range: 0 1048576
+    // @Increment: 1024
+    // @Units: B
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("VM2_HEAP", 20, AP_Scripting, _vm2_heap_size, 0),
+
+    // @Param: VM2_PRIO
+    // @DisplayName: Scripting second VM thread priority
+    // @Description: This sets the priority of the thread of the second scripting VM, allowing scripts that need to be run promptly to be separated from those that are not. The same warnings as SCR_THD_PRIORITY apply.
+    // @CopyValuesFrom: SCR_THD_PRIORITY
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("VM2_PRIO", 21, AP_Scripting, _vm2_priority, uint8_t(ThreadPriority::NORMAL)),
+#endif // AP_SCRIPTING_MULTI_VM_ENABLED
+
     // WARNING: additional parameters must be listed before SDEV_EN (but have an
     // index after SDEV3_PROTO) so they are not disabled by it!
     
@@ -233,7 +263,26 @@ void AP_Scripting::init(void) {
     }
 #endif
 
-    AP_HAL::Scheduler::priority_base priority = AP_HAL::Scheduler::PRIORITY_SCRIPTING;
+    if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Scripting::thread, void),
+                                      "Scripting", SCRIPTING_STACK_SIZE, hal_priority(_thd_priority), 0)) {
+        GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "Scripting: %s", "failed to start");
+        _thread_failed = true;
+    }
+
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+    if (vm_enabled(2) &&
+        !hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Scripting::vm2_thread, void),
+                                      "Scripting2", SCRIPTING_STACK_SIZE, hal_priority(_vm2_priority), 0)) {
+        // run all of the scripts in the first VM
+        GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "Scripting: %s", "VM2 failed to start");
+        _vm2_heap_size.set(0);
+    }
+#endif
+}
+
+// HAL thread priority for a SCR_THD_PRIORITY value
+AP_HAL::Scheduler::priority_base AP_Scripting::hal_priority(ThreadPriority scr_priority)
+{
     static const struct {
         ThreadPriority scr_priority;
         AP_HAL::Scheduler::priority_base hal_priority;
@@ -249,16 +298,11 @@ void AP_Scripting::init(void) {
         { ThreadPriority::BOOST, AP_HAL::Scheduler::PRIORITY_BOOST },
     };
     for (const auto &p : priority_map) {
-        if (p.scr_priority == _thd_priority) {
-            priority = p.hal_priority;
+        if (p.scr_priority == scr_priority) {
+            return p.hal_priority;
         }
     }
-
-    if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Scripting::thread, void),
-                                      "Scripting", SCRIPTING_STACK_SIZE, priority, 0)) {
-        GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "Scripting: %s", "failed to start");
-        _thread_failed = true;
-    }
+    return AP_HAL::Scheduler::PRIORITY_SCRIPTING;
 }
 
 #if AP_SCRIPTING_SERIALDEVICE_ENABLED
@@ -310,7 +354,7 @@ void AP_Scripting::thread(void) {
         _restart = false;
         _init_failed = false;
 
-        lua_scripts *lua = NEW_NOTHROW lua_scripts(_script_vm_exec_count, _script_heap_size, _debug_options);
+        lua_scripts *lua = NEW_NOTHROW lua_scripts(_script_vm_exec_count, _script_heap_size, _debug_options, _gc_budget_us, 1);
         if (lua == nullptr || !lua->heap_allocated()) {
             GCS_SEND_TEXT(MAV_SEVERITY_CRITICAL, "Scripting: %s", "Unable to allocate memory");
             _init_failed = true;
@@ -323,6 +367,12 @@ void AP_Scripting::thread(void) {
 #if AP_ARMING_ENABLED && AP_ARMING_AUX_AUTH_ENABLED
             // Clear any dangling pre-arms from previous script loads
             AP_Arming::get_singleton()->reset_all_aux_auths();
+#endif
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+            if (vm_enabled(2)) {
+                _vm2_running = true;
+                _vm2_start = true;
+            }
 #endif
             // run won't return while scripting is still active
             lua->run();
@@ -333,6 +383,15 @@ void AP_Scripting::thread(void) {
         delete lua;
         lua = nullptr;
 
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+        // stop the second VM too, it may be using the resources that
+        // are cleared below
+        _stop = true;
+        while (_vm2_running) {
+            hal.scheduler->delay(10);
+        }
+#endif
+
         // clear allocated i2c devices
         for (uint8_t i=0; i<SCRIPTING_MAX_NUM_I2C_DEVICE; i++) {
             delete _i2c_dev[i];
@@ -398,6 +457,34 @@ void AP_Scripting::thread(void) {
         }
     }
 }
+
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+/*
+  run the scripts that asked for the second VM. The VM is started
+  each time the main thread starts its own, and the main thread waits
+  for it to stop before clearing the resources used by scripts
+ */
+void AP_Scripting::vm2_thread(void) {
+    while (true) {
+        while (!_vm2_start) {
+            hal.scheduler->delay(100);
+        }
+        _vm2_start = false;
+
+        lua_scripts *lua = NEW_NOTHROW lua_scripts(_script_vm_exec_count, _vm2_heap_size, _debug_options, _gc_budget_us, 2);
+        if (lua == nullptr || !lua->heap_allocated()) {
+            GCS_SEND_TEXT(MAV_SEVERITY_CRITICAL, "Scripting: %s", "Unable to allocate VM2 memory");
+            _init_failed = true;
+        } else {
+            lua->run();
+        }
+        delete lua;
+        lua = nullptr;
+
+        _vm2_running = false;
+    }
+}
+#endif // AP_SCRIPTING_MULTI_VM_ENABLED
 #pragma GCC pop_options
 
 void AP_Scripting::handle_mission_command(const AP_Mission::Mission_Command& cmd_in)
@@ -430,6 +517,13 @@ void AP_Scripting::handle_mission_command(const AP_Mission::Mission_Command& cmd
 #endif
 }
 
+#if AP_SCRIPTING_PROFILER_ENABLED
+void AP_Scripting::profile_info(ExpandingString &str)
+{
+    lua_scripts::profile_info(str);
+}
+#endif
+
 bool AP_Scripting::arming_checks(size_t buflen, char *buffer) const
 {
     if (!enabled() || option_is_set(DebugOption::DISABLE_PRE_ARM)) {
@@ -498,6 +592,9 @@ void AP_Scripting::handle_message(const mavlink_message_t &msg, const mavlink_ch
         }
         if (mavlink_data.accept_msg_ids[i] == msg.msgid) {
             mavlink_data.rx_buffer->push(data);
+#if AP_SCRIPTING_EVENTS_ENABLED
+            signal_event(EVENT_MAVLINK);
+#endif
             return;
         }
     }
@@ -527,6 +624,33 @@ void AP_Scripting::update() {
 
 }
 
+#if AP_SCRIPTING_EVENTS_ENABLED
+void AP_Scripting::signal_event(Event event)
+{
+    lua_scripts::signal_event(event);
+}
+
+/*
+  called at 50Hz from the vehicle scheduler, so scripts waiting for a
+  mode change need not poll for it
+ */
+void AP_Scripting::update_events(void)
+{
+    if (!_enable) {
+        return;
+    }
+    const AP_Vehicle *vehicle = AP::vehicle();
+    if (vehicle == nullptr) {
+        return;
+    }
+    const uint8_t mode = vehicle->get_mode();
+    if (mode != _last_mode) {
+        _last_mode = mode;
+        signal_event(EVENT_MODE);
+    }
+}
+#endif // AP_SCRIPTING_EVENTS_ENABLED
+
 // Check if DEBUG_OPTS bit has been set to save current checksum values to params
 void AP_Scripting::save_checksum() {
 
@@ -20,6 +20,7 @@
 
 #include <GCS_MAVLink/GCS_config.h>
 #include <AP_Common/AP_Common.h>
+#include <AP_Common/ExpandingString.h>
 #include <AP_Param/AP_Param.h>
 #include <GCS_MAVLink/GCS_MAVLink.h>
 #include <AP_Mission/AP_Mission.h>
@@ -64,6 +65,11 @@ public:
     bool enabled(void) const { return _enable != 0; };
     bool should_run(void) const { return enabled() && !_stop; }
 
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+    // true if scripts can be run in VM number vm
+    bool vm_enabled(uint8_t vm) const { return vm == 1 || (vm == 2 && _vm2_heap_size > 0); }
+#endif
+
 #if HAL_GCS_ENABLED
     void handle_message(const mavlink_message_t &msg, const mavlink_channel_t chan);
 
@@ -85,6 +91,28 @@ public:
     
     void restart_all(void);
 
+    // events that can wake a script before its next run time,
+    // unscoped for the bindings
+    enum Event : uint8_t {
+        EVENT_CAN = 1U << 0,     // frame received by a scripting CAN buffer
+        EVENT_MAVLINK = 1U << 1, // message received for mavlink:receive_chan
+        EVENT_SERIAL = 1U << 2,  // data written to a scripting serial device
+        EVENT_MODE = 1U << 3,    // vehicle mode changed
+    };
+
+#if AP_SCRIPTING_EVENTS_ENABLED
+    // wake the scripts waiting for an event, may be called from any thread
+    void signal_event(Event event);
+
+    // check for events that are not signalled directly
+    void update_events(void);
+#endif
+
+#if AP_SCRIPTING_PROFILER_ENABLED
+    // summary of the script profile for @SYS/scripts.txt
+    void profile_info(ExpandingString &str);
+#endif
+
    // User parameters for inputs into scripts 
    AP_Float _user[6];
 
@@ -120,8 +148,6 @@ public:
     // PWMSource storage
     uint8_t num_pwm_source;
     AP_HAL::PWMSource *_pwm_source[SCRIPTING_MAX_NUM_PWM_SOURCE];
-    int get_current_env_ref() { return current_env_ref; }
-    void set_current_env_ref(int ref) { current_env_ref = ref; }
 
 #if AP_NETWORKING_ENABLED
     // SocketAPM storage
@@ -160,11 +186,15 @@ public:
         DISABLE_PRE_ARM = 1U << 4,
         SAVE_CHECKSUM = 1U << 5,
         DISABLE_HEAP_EXPANSION = 1U << 6,
+        PROFILE = 1U << 7,
     };
 
 private:
 
     void thread(void); // main script execution thread
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+    void vm2_thread(void); // execution thread of the second VM, started and stopped by the main thread
+#endif
 
     // Check if DEBUG_OPTS bit has been set to save current checksum values to params
     void save_checksum();
@@ -192,9 +222,19 @@ private:
     AP_Int16 _dir_disable;
     AP_Int32 _required_loaded_checksum;
     AP_Int32 _required_running_checksum;
+    AP_Int16 _gc_budget_us;
 
     AP_Enum<ThreadPriority> _thd_priority;
 
+    static AP_HAL::Scheduler::priority_base hal_priority(ThreadPriority priority);
+
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+    AP_Int32 _vm2_heap_size;
+    AP_Enum<ThreadPriority> _vm2_priority;
+    bool _vm2_start;   // set by the main thread to start the second VM
+    bool _vm2_running; // cleared by the second VM thread once it has stopped
+#endif
+
     bool option_is_set(DebugOption option) const {
         return (uint8_t(_debug_options.get()) & uint8_t(option)) != 0;
     }
@@ -208,8 +248,11 @@ private:
     bool _restart; // true if scripts should be restarted
     bool _stop; // true if scripts should be stopped
 
+#if AP_SCRIPTING_EVENTS_ENABLED
+    uint8_t _last_mode; // for EVENT_MODE
+#endif
+
     static AP_Scripting *_singleton;
-    int current_env_ref;
 };
 
 namespace AP {
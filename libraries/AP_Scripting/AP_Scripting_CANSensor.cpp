@@ -17,6 +17,7 @@
  */
 #include "AP_Scripting_CANSensor.h"
 #include <AP_Math/AP_Math.h>
+#include "AP_Scripting.h"
 
 #if AP_SCRIPTING_CAN_SENSOR_ENABLED
 
@@ -79,6 +80,9 @@ void ScriptingCANBuffer::handle_frame(AP_HAL::CANFrame &frame)
     // Add to buffer for scripting to read
     if (accept) {
         buffer.push(frame);
+#if AP_SCRIPTING_EVENTS_ENABLED
+        AP::scripting()->signal_event(AP_Scripting::EVENT_CAN);
+#endif
     }
 
     // filtering is not applied to other buffers
@@ -107,8 +107,17 @@ void AP_Scripting_SerialDevice::Port::_begin(uint32_t b, uint16_t rxS, uint16_t
 
 size_t AP_Scripting_SerialDevice::Port::_write(const uint8_t *buffer, size_t size)
 {
-    WITH_SEMAPHORE(sem);
-    return writebuffer != nullptr ? writebuffer->write(buffer, size) : 0;
+    size_t ret;
+    {
+        WITH_SEMAPHORE(sem);
+        ret = writebuffer != nullptr ? writebuffer->write(buffer, size) : 0;
+    }
+#if AP_SCRIPTING_EVENTS_ENABLED
+    if (ret > 0) {
+        AP::scripting()->signal_event(AP_Scripting::EVENT_SERIAL);
+    }
+#endif
+    return ret;
 }
 
 ssize_t AP_Scripting_SerialDevice::Port::_read(uint8_t *buffer, uint16_t count)
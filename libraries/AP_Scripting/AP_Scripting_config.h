@@ -18,3 +18,17 @@
 #ifndef AP_SCRIPTING_SERIALDEVICE_ENABLED
 #define AP_SCRIPTING_SERIALDEVICE_ENABLED AP_SERIALMANAGER_REGISTER_ENABLED && (HAL_PROGRAM_SIZE_LIMIT_KB>1024)
 #endif
+
+#ifndef AP_SCRIPTING_PROFILER_ENABLED
+#define AP_SCRIPTING_PROFILER_ENABLED AP_SCRIPTING_ENABLED
+#endif
+
+// allow scripts to be run in a second VM with its own heap and thread
+#ifndef AP_SCRIPTING_MULTI_VM_ENABLED
+#define AP_SCRIPTING_MULTI_VM_ENABLED AP_SCRIPTING_ENABLED && (HAL_MEM_CLASS >= HAL_MEM_CLASS_500)
+#endif
+
+// allow scripts to be woken early by events rather than polling
+#ifndef AP_SCRIPTING_EVENTS_ENABLED
+#define AP_SCRIPTING_EVENTS_ENABLED AP_SCRIPTING_ENABLED
+#endif
@@ -195,6 +195,309 @@ bool Parameter::set_default(float value)
     return false;
 }
 
+// lua constructor for ParameterSet, taking a table of parameter names
+int ParameterSet::new_set(lua_State *L)
+{
+    binding_argcheck(L, 1);
+    luaL_checktype(L, 1, LUA_TTABLE);
+
+    const lua_Integer count = luaL_len(L, 1);
+    luaL_argcheck(L, (count > 0) && (count <= PARAMETER_SET_MAX_PARAMS), 1, "size out of range");
+
+    void *ud = lua_newuserdata(L, sizeof(ParameterSet) + count * sizeof(Entry));
+    auto *s = new (ud) ParameterSet();
+    s->count = count;
+    s->entries = (Entry *)((uint8_t *)ud + sizeof(ParameterSet));
+
+    for (uint8_t i=0; i<s->count; i++) {
+        Entry *e = new (&s->entries[i]) Entry();
+        lua_rawgeti(L, 1, i+1);
+        const char *name = luaL_checkstring(L, -1);
+        if (!e->param.init(name)) {
+            return luaL_error(L, "No parameter: %s", name);
+        }
+        lua_pop(L, 1);
+        e->param.get(e->last_value);
+    }
+
+    luaL_getmetatable(L, "ParameterSet");
+    lua_setmetatable(L, -2);
+
+    return 1;
+}
+
+// return the value of every parameter in the set
+int ParameterSet::get(lua_State *L)
+{
+    binding_argcheck(L, 1);
+    ParameterSet *s = check_ParameterSet(L, 1);
+
+    luaL_checkstack(L, s->count, nullptr);
+    for (uint8_t i=0; i<s->count; i++) {
+        float value;
+        if (s->entries[i].param.get(value)) {
+            lua_pushnumber(L, value);
+        } else {
+            lua_pushnil(L);
+        }
+    }
+    return s->count;
+}
+
+// set the parameters in the set, in order, nil leaves a parameter unchanged
+int ParameterSet::set(lua_State *L)
+{
+    ParameterSet *s = check_ParameterSet(L, 1);
+    const int args = lua_gettop(L);
+    if (args > s->count + 1) {
+        return luaL_argerror(L, args, "too many arguments");
+    }
+
+    bool ret = true;
+    for (uint8_t i=0; i<args-1; i++) {
+        if (lua_isnil(L, i+2)) {
+            continue;
+        }
+        const float value = luaL_checknumber(L, i+2);
+        ret &= s->entries[i].param.set(value);
+    }
+    lua_pushboolean(L, ret);
+    return 1;
+}
+
+// return a bitmask of the parameters that have changed since the last call
+int ParameterSet::changed(lua_State *L)
+{
+    binding_argcheck(L, 1);
+    ParameterSet *s = check_ParameterSet(L, 1);
+
+    uint32_t mask = 0;
+    for (uint8_t i=0; i<s->count; i++) {
+        Entry &e = s->entries[i];
+        float value;
+        if (e.param.get(value) && !is_equal(value, e.last_value)) {
+            e.last_value = value;
+            mask |= 1U << i;
+        }
+    }
+    *new_uint32_t(L) = mask;
+    return 1;
+}
+
+// lua constructor for PointArray, taking the number of points
+int PointArray::new_array(lua_State *L)
+{
+    binding_argcheck(L, 1);
+    const lua_Integer count = luaL_checkinteger(L, 1);
+    luaL_argcheck(L, (count > 0) && (count <= POINT_ARRAY_MAX_POINTS), 1, "size out of range");
+
+    void *ud = lua_newuserdata(L, sizeof(PointArray) + count * sizeof(Vector3f));
+    auto *a = new (ud) PointArray();
+    a->count = count;
+    a->points = (Vector3f *)((uint8_t *)ud + sizeof(PointArray));
+    for (uint16_t i=0; i<a->count; i++) {
+        new (&a->points[i]) Vector3f();
+    }
+
+    luaL_getmetatable(L, "PointArray");
+    lua_setmetatable(L, -2);
+
+    return 1;
+}
+
+// return the number of points
+int PointArray::size(lua_State *L)
+{
+    binding_argcheck(L, 1);
+    PointArray *a = check_PointArray(L, 1);
+    lua_pushinteger(L, a->count);
+    return 1;
+}
+
+// return x, y and z of point i, the first point is 1
+int PointArray::get(lua_State *L)
+{
+    binding_argcheck(L, 2);
+    PointArray *a = check_PointArray(L, 1);
+    const lua_Integer i = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, (i >= 1) && (i <= a->count), 2, "index out of range");
+
+    const Vector3f &p = a->points[i-1];
+    lua_pushnumber(L, p.x);
+    lua_pushnumber(L, p.y);
+    lua_pushnumber(L, p.z);
+    return 3;
+}
+
+// set point i, z is optional and defaults to zero
+int PointArray::set(lua_State *L)
+{
+    const int args = lua_gettop(L);
+    if (args > 5) {
+        return luaL_argerror(L, args, "too many arguments");
+    } else if (args < 4) {
+        return luaL_argerror(L, args, "too few arguments");
+    }
+    PointArray *a = check_PointArray(L, 1);
+    const lua_Integer i = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, (i >= 1) && (i <= a->count), 2, "index out of range");
+
+    a->points[i-1] = Vector3f(luaL_checknumber(L, 3),
+                              luaL_checknumber(L, 4),
+                              luaL_optnumber(L, 5, 0));
+    return 0;
+}
+
+/*
+  set the points from a flat table of x, y, z values, returning the
+  number of points set
+ */
+int PointArray::load(lua_State *L)
+{
+    binding_argcheck(L, 2);
+    PointArray *a = check_PointArray(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+
+    const uint16_t n = MIN(luaL_len(L, 2) / 3, lua_Integer(a->count));
+    for (uint16_t i=0; i<n; i++) {
+        for (uint8_t j=0; j<3; j++) {
+            lua_rawgeti(L, 2, i*3 + j + 1);
+            a->points[i][j] = luaL_checknumber(L, -1);
+            lua_pop(L, 1);
+        }
+    }
+    lua_pushinteger(L, n);
+    return 1;
+}
+
+// rotate every point from body to earth frame by roll, pitch and yaw in radians
+int PointArray::rotate(lua_State *L)
+{
+    binding_argcheck(L, 4);
+    PointArray *a = check_PointArray(L, 1);
+    Matrix3f m;
+    m.from_euler(luaL_checknumber(L, 2), luaL_checknumber(L, 3), luaL_checknumber(L, 4));
+
+    for (uint16_t i=0; i<a->count; i++) {
+        a->points[i] = m * a->points[i];
+    }
+    return 0;
+}
+
+// add x, y and z to every point
+int PointArray::offset(lua_State *L)
+{
+    binding_argcheck(L, 4);
+    PointArray *a = check_PointArray(L, 1);
+    const Vector3f ofs(luaL_checknumber(L, 2), luaL_checknumber(L, 3), luaL_checknumber(L, 4));
+
+    for (uint16_t i=0; i<a->count; i++) {
+        a->points[i] += ofs;
+    }
+    return 0;
+}
+
+/*
+  low pass filter the points in order, smoothing a path. An alpha of
+  one leaves the points unchanged
+ */
+int PointArray::lowpass(lua_State *L)
+{
+    binding_argcheck(L, 2);
+    PointArray *a = check_PointArray(L, 1);
+    const float alpha = luaL_checknumber(L, 2);
+    luaL_argcheck(L, (alpha >= 0) && (alpha <= 1), 2, "out of range");
+
+    for (uint16_t i=1; i<a->count; i++) {
+        a->points[i] = a->points[i-1] + (a->points[i] - a->points[i-1]) * alpha;
+    }
+    return 0;
+}
+
+// return the index of and distance to the point closest to x, y, z
+int PointArray::closest(lua_State *L)
+{
+    binding_argcheck(L, 4);
+    PointArray *a = check_PointArray(L, 1);
+    const Vector3f p(luaL_checknumber(L, 2), luaL_checknumber(L, 3), luaL_checknumber(L, 4));
+
+    uint16_t best = 0;
+    float best_sq = (a->points[0] - p).length_squared();
+    for (uint16_t i=1; i<a->count; i++) {
+        const float dist_sq = (a->points[i] - p).length_squared();
+        if (dist_sq < best_sq) {
+            best = i;
+            best_sq = dist_sq;
+        }
+    }
+    lua_pushinteger(L, best+1);
+    lua_pushnumber(L, sqrtf(best_sq));
+    return 2;
+}
+
+// return the number of points within radius of x, y, z
+int PointArray::count_within(lua_State *L)
+{
+    binding_argcheck(L, 5);
+    PointArray *a = check_PointArray(L, 1);
+    const Vector3f p(luaL_checknumber(L, 2), luaL_checknumber(L, 3), luaL_checknumber(L, 4));
+    const float radius_sq = sq(luaL_checknumber(L, 5));
+
+    uint16_t n = 0;
+    for (uint16_t i=0; i<a->count; i++) {
+        if ((a->points[i] - p).length_squared() <= radius_sq) {
+            n++;
+        }
+    }
+    lua_pushinteger(L, n);
+    return 1;
+}
+
+/*
+  the x and y of the points form a polygon, closed from the last point
+  back to the first, in the same way as Polygon_outside()
+ */
+bool PointArray::outside(const Vector2f &p) const
+{
+    bool ret = true;
+    for (uint16_t i=0; i<count; i++) {
+        const uint16_t j = (i + 1 < count) ? i + 1 : 0;
+        if (Polygon_edge_crossing(p, points[i].xy(), points[j].xy())) {
+            ret = !ret;
+        }
+    }
+    return ret;
+}
+
+// return true if x, y is inside the polygon formed by the points
+int PointArray::inside(lua_State *L)
+{
+    binding_argcheck(L, 3);
+    PointArray *a = check_PointArray(L, 1);
+    luaL_argcheck(L, a->count >= 3, 1, "not a polygon");
+
+    lua_pushboolean(L, !a->outside(Vector2f(luaL_checknumber(L, 2), luaL_checknumber(L, 3))));
+    return 1;
+}
+
+// return the number of points inside the polygon formed by another PointArray
+int PointArray::count_inside(lua_State *L)
+{
+    binding_argcheck(L, 2);
+    PointArray *a = check_PointArray(L, 1);
+    PointArray *poly = check_PointArray(L, 2);
+    luaL_argcheck(L, poly->count >= 3, 2, "not a polygon");
+
+    uint16_t n = 0;
+    for (uint16_t i=0; i<a->count; i++) {
+        if (!poly->outside(a->points[i].xy())) {
+            n++;
+        }
+    }
+    lua_pushinteger(L, n);
+    return 1;
+}
+
 #if HAL_ENABLE_DRONECAN_DRIVERS
 
 #define IFACE_ALL uint8_t(((1U<<(HAL_NUM_CAN_IFACES))-1U))
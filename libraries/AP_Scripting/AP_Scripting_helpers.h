@@ -1,6 +1,7 @@
 #pragma once
 
 #include <AP_Param/AP_Param.h>
+#include <AP_Math/AP_Math.h>
 #include "lua/src/lua.hpp"
 #include <AP_DroneCAN/AP_DroneCAN.h>
 
@@ -29,6 +30,66 @@ private:
     AP_Param *vp;
 };
 
+#ifndef PARAMETER_SET_MAX_PARAMS
+#define PARAMETER_SET_MAX_PARAMS 32
+#endif
+
+/*
+  a set of parameters looked up once by name, then read and written
+  together in a single call
+ */
+class ParameterSet
+{
+public:
+    static int new_set(lua_State *L);
+    static int get(lua_State *L);
+    static int set(lua_State *L);
+    static int changed(lua_State *L);
+
+private:
+    struct Entry {
+        Parameter param;
+        float last_value; // value when changed() was last called
+    };
+
+    uint8_t count;
+    // storage follows the object in the same userdata
+    Entry *entries;
+};
+
+#ifndef POINT_ARRAY_MAX_POINTS
+#define POINT_ARRAY_MAX_POINTS 4096
+#endif
+
+/*
+  a packed array of points, so scripts can transform, filter and test
+  many points in a single call rather than one Vector3f at a time
+ */
+class PointArray
+{
+public:
+    static int new_array(lua_State *L);
+    static int size(lua_State *L);
+    static int get(lua_State *L);
+    static int set(lua_State *L);
+    static int load(lua_State *L);
+    static int rotate(lua_State *L);
+    static int offset(lua_State *L);
+    static int lowpass(lua_State *L);
+    static int closest(lua_State *L);
+    static int count_within(lua_State *L);
+    static int inside(lua_State *L);
+    static int count_inside(lua_State *L);
+
+private:
+    // return true if p is outside the polygon formed by the x and y of the points
+    bool outside(const Vector2f &p) const;
+
+    uint16_t count;
+    // storage follows the object in the same userdata
+    Vector3f *points;
+};
+
 
 #if HAL_ENABLE_DRONECAN_DRIVERS
 
@@ -799,6 +799,107 @@ local Parameter_ud_const = {}
 ---@param name string
 function Parameter(name) end
 
+-- Set of parameters, looked up once by name then read and written together.
+---@class (exact) ParameterSet_ud
+local ParameterSet_ud = {}
+
+-- Create a new parameter set from a table of up to 32 parameter names.
+-- This will error if any of the parameters are not found.
+---@param names table -- table of parameter names, eg {"ATC_RAT_RLL_P", "ATC_RAT_RLL_I"}
+---@return ParameterSet_ud
+function ParameterSet(names) end
+
+-- Get the current value of every parameter in the set, in the order they were given.
+---@return number|nil ... -- one value for each parameter
+function ParameterSet_ud:get() end
+
+-- Set the parameters in the set, in the order they were given. A nil value leaves that parameter unchanged.
+-- The values will not persist a reboot.
+---@param ... number|nil
+---@return boolean -- true if all values were set
+function ParameterSet_ud:set(...) end
+
+-- Return a bitmask of the parameters that have changed since the set was created or changed() was last called.
+-- Bit 0 is the first parameter.
+---@return uint32_t_ud
+function ParameterSet_ud:changed() end
+
+-- Packed array of points, allowing many points to be transformed, filtered and tested in a single call.
+-- Points are numbered from 1, as with Lua tables.
+---@class (exact) PointArray_ud
+local PointArray_ud = {}
+
+-- Create a new array of up to 4096 points, all zero.
+---@param size integer
+---@return PointArray_ud
+function PointArray(size) end
+
+-- Return the number of points in the array.
+---@return integer
+function PointArray_ud:size() end
+
+-- Return the x, y and z of a point.
+---@param index integer
+---@return number -- x
+---@return number -- y
+---@return number -- z
+function PointArray_ud:get(index) end
+
+-- Set a point, z defaults to zero.
+---@param index integer
+---@param x number
+---@param y number
+---@param z? number
+function PointArray_ud:set(index, x, y, z) end
+
+-- Set the points from a flat table of x, y, z values, eg {x1, y1, z1, x2, y2, z2}.
+---@param values table
+---@return integer -- number of points set
+function PointArray_ud:load(values) end
+
+-- Rotate every point from body to earth frame by the given euler angles.
+---@param roll number -- radians
+---@param pitch number -- radians
+---@param yaw number -- radians
+function PointArray_ud:rotate(roll, pitch, yaw) end
+
+-- Add an offset to every point.
+---@param x number
+---@param y number
+---@param z number
+function PointArray_ud:offset(x, y, z) end
+
+-- Low pass filter the points in order, smoothing a path. Each point moves towards the one before it, an alpha of 1 leaves the points unchanged.
+---@param alpha number -- 0 to 1
+function PointArray_ud:lowpass(alpha) end
+
+-- Return the point closest to a position.
+---@param x number
+---@param y number
+---@param z number
+---@return integer -- index of the closest point
+---@return number -- distance to the closest point
+function PointArray_ud:closest(x, y, z) end
+
+-- Return the number of points within a radius of a position.
+---@param x number
+---@param y number
+---@param z number
+---@param radius number
+---@return integer
+function PointArray_ud:count_within(x, y, z, radius) end
+
+-- Return true if a position is inside the polygon formed by the x and y of the points, the last point is joined to the first. Requires at least 3 points.
+---@param x number
+---@param y number
+---@return boolean
+function PointArray_ud:inside(x, y) end
+
+-- Return the number of points inside the polygon formed by the x and y of another array.
+---@param polygon PointArray_ud
+---@return integer
+function PointArray_ud:count_inside(polygon) end
+
 -- Set the defualt value of this parameter, if the parameter has not been configured by the user its value will be updated to the new defualt.
 ---@param value number
 ---@return boolean
@@ -1224,6 +1325,21 @@ function ScriptingCANBuffer_ud:add_filter(mask, value) end
 ---@return boolean
 function ScriptingCANBuffer_ud:write_frame(frame, timeout_us) end
 
+-- Read up to max_frames frames from the buffer in a single call, packed into a string.
+-- Each frame is a little endian uint32 id followed by a length prefixed data block, so they can be read with
+-- local id, data, pos = string.unpack("<I4s1", frames, pos)
+---@param max_frames integer
+---@return string -- packed frames
+---@return integer -- number of frames read
+function ScriptingCANBuffer_ud:read_frames(max_frames) end
+
+-- Write frames packed as returned by read_frames, eg string.pack("<I4s1", id, data) for each frame.
+-- Writing stops at the first frame that can't be sent.
+---@param frames string
+---@param timeout_us uint32_t_ud|integer|number -- timeout for each frame
+---@return integer -- number of frames written
+function ScriptingCANBuffer_ud:write_frames(frames, timeout_us) end
+
 
 -- desc
 ---@class (exact) AP_HAL__AnalogSource_ud
@@ -3409,8 +3525,9 @@ function gps:ground_speed(instance) end
 -- Returns a Vector3f that contains the velocity as observed by the GPS.
 -- You must check the status to know if the velocity is still current.
 ---@param instance integer -- instance number
+---@param reuse? Vector3f_ud -- optional Vector3f to fill in and return, rather than creating a new one
 ---@return Vector3f_ud -- 3D velocity in m/s, in NED format
-function gps:velocity(instance) end
+function gps:velocity(instance, reuse) end
 
 -- desc
 ---@param instance integer -- instance number
@@ -3429,8 +3546,9 @@ function gps:speed_accuracy(instance) end
 
 -- eturns a Location userdata for the last GPS position. You must check the status to know if the location is still current, if it is NO_GPS, or NO_FIX then it will be returning old data.
 ---@param instance integer -- instance number
+---@param reuse? Location_ud -- optional Location to fill in and return, rather than creating a new one
 ---@return Location_ud --gps location
-function gps:location(instance) end
+function gps:location(instance, reuse) end
 
 -- Returns the GPS fix status. Compare this to one of the GPS fix types.
 -- Posible status are provided as values on the gps object. eg: gps.GPS_OK_FIX_3D
@@ -3646,8 +3764,9 @@ ahrs = {}
 function ahrs:handle_external_position_estimate(location, accuracy, timestamp_ms) end
 
 -- desc
+---@param reuse? Quaternion_ud -- optional Quaternion to fill in and return, rather than creating a new one
 ---@return Quaternion_ud|nil
-function ahrs:get_quaternion() end
+function ahrs:get_quaternion(reuse) end
 
 -- desc
 ---@return integer
@@ -3707,8 +3826,9 @@ function ahrs:body_to_earth(vector) end
 function ahrs:earth_to_body(vector) end
 
 -- desc
+---@param reuse? Vector3f_ud -- optional Vector3f to fill in and return, rather than creating a new one
 ---@return Vector3f_ud
-function ahrs:get_vibration() end
+function ahrs:get_vibration(reuse) end
 
 -- Return the estimated airspeed of the vehicle if available
 ---@return number|nil -- airspeed in meters / second if available
@@ -3727,20 +3847,24 @@ function ahrs:home_is_set() end
 function ahrs:get_relative_position_D_home() end
 
 -- desc
+---@param reuse? Vector3f_ud -- optional Vector3f to fill in and return, rather than creating a new one
 ---@return Vector3f_ud|nil
-function ahrs:get_relative_position_NED_origin() end
+function ahrs:get_relative_position_NED_origin(reuse) end
 
 -- desc
+---@param reuse? Vector3f_ud -- optional Vector3f to fill in and return, rather than creating a new one
 ---@return Vector3f_ud|nil
-function ahrs:get_relative_position_NED_home() end
+function ahrs:get_relative_position_NED_home(reuse) end
 
 -- Returns nil, or a Vector3f containing the current NED vehicle velocity in meters/second in north, east, and down components.
+---@param reuse? Vector3f_ud -- optional Vector3f to fill in and return, rather than creating a new one
 ---@return Vector3f_ud|nil -- North, east, down velcoity in meters / second if available
-function ahrs:get_velocity_NED() end
+function ahrs:get_velocity_NED(reuse) end
 
 -- Get current groundspeed vector in meter / second
+---@param reuse? Vector2f_ud -- optional Vector2f to fill in and return, rather than creating a new one
 ---@return Vector2f_ud -- ground speed vector, North East, meters / second
-function ahrs:groundspeed_vector() end
+function ahrs:groundspeed_vector(reuse) end
 
 -- Returns a Vector3f containing the current wind estimate for the vehicle.
 ---@return Vector3f_ud -- wind estiamte North, East, Down meters / second
@@ -3763,25 +3887,30 @@ function ahrs:head_wind() end
 function ahrs:get_hagl() end
 
 -- desc
+---@param reuse? Vector3f_ud -- optional Vector3f to fill in and return, rather than creating a new one
 ---@return Vector3f_ud
-function ahrs:get_accel() end
+function ahrs:get_accel(reuse) end
 
 -- Returns a Vector3f containing the current smoothed and filtered gyro rates (in radians/second)
+---@param reuse? Vector3f_ud -- optional Vector3f to fill in and return, rather than creating a new one
 ---@return Vector3f_ud -- roll, pitch, yaw gyro rates in radians / second
-function ahrs:get_gyro() end
+function ahrs:get_gyro(reuse) end
 
 -- Returns a Location that contains the vehicles current home waypoint.
+---@param reuse? Location_ud -- optional Location to fill in and return, rather than creating a new one
 ---@return Location_ud -- home location
-function ahrs:get_home() end
+function ahrs:get_home(reuse) end
 
 -- Returns nil or Location userdata that contains the vehicles current position.
 -- Note: This will only return a Location if the system considers the current estimate to be reasonable.
+---@param reuse? Location_ud -- optional Location to fill in and return, rather than creating a new one
 ---@return Location_ud|nil -- current location if available
-function ahrs:get_location() end
+function ahrs:get_location(reuse) end
 
 -- same as `get_location` will be removed
+---@param reuse? Location_ud -- optional Location to fill in and return, rather than creating a new one
 ---@return Location_ud|nil
-function ahrs:get_position() end
+function ahrs:get_position(reuse) end
 
 -- Returns the current vehicle euler yaw angle in radians.
 ---@return number -- yaw angle in radians.
@@ -3894,6 +4023,19 @@ scripting = {}
 -- desc
 function scripting:restart_all() end
 
+scripting.EVENT_CAN = enum_integer
+scripting.EVENT_MAVLINK = enum_integer
+scripting.EVENT_SERIAL = enum_integer
+scripting.EVENT_MODE = enum_integer
+
+-- Set the events that run this script before the delay it returns has passed, so it does not need to poll at a high rate.
+-- The events are a bitmask of scripting.EVENT_CAN (frame received by a CAN buffer), scripting.EVENT_MAVLINK (message received for mavlink:receive_chan),
+-- scripting.EVENT_SERIAL (data written to a scripting serial device, not a real serial port) and scripting.EVENT_MODE (vehicle mode changed), zero runs the script only at its delay.
+-- The events are kept until changed.
+---@param events integer
+---@return boolean -- false if called outside of the running script
+function scripting:wake_on(events) end
+
 -- desc
 ---@param directoryname string
 ---@return table|nil -- table of filenames
@@ -27,6 +27,7 @@ char keyword_write[]               = "write";
 char keyword_literal[]             = "literal";
 char keyword_reference[]           = "reference";
 char keyword_deprecate[]           = "deprecate";
+char keyword_reuse[]               = "reuse";
 char keyword_manual[]              = "manual";
 char keyword_global[]              = "global";
 char keyword_creation[]            = "creation";
@@ -171,6 +172,7 @@ enum type_flags {
   TYPE_FLAGS_ENUM     = (1U << 2),
   TYPE_FLAGS_REFERENCE = (1U << 3),
   TYPE_FLAGS_NO_RANGE_CHECK = (1U << 4),
+  TYPE_FLAGS_REUSE    = (1U << 5), // method may fill in userdata passed by the script rather then allocate new ones
 };
 
 struct type {
@@ -774,6 +776,37 @@ void handle_userdata_field(struct userdata *data) {
   field->access_flags = parse_access_flags(&(field->type));
 }
 
+// count the userdata values a method returns, these can be reused
+int count_userdata_outputs(const struct method *method) {
+  int count = (method->return_type.type == TYPE_USERDATA) ? 1 : 0;
+  const struct argument *arg = method->arguments;
+  while (arg != NULL) {
+    if ((arg->type.flags & (TYPE_FLAGS_NULLABLE | TYPE_FLAGS_REFERENCE)) && (arg->type.type == TYPE_USERDATA)) {
+      count++;
+    }
+    arg = arg->next;
+  }
+  return count;
+}
+
+// fetch the type of the nth userdata output, in the order they are pushed (references then return value)
+const struct type * get_userdata_output(const struct method *method, int n) {
+  const struct argument *arg = method->arguments;
+  while (arg != NULL) {
+    if ((arg->type.flags & (TYPE_FLAGS_NULLABLE | TYPE_FLAGS_REFERENCE)) && (arg->type.type == TYPE_USERDATA)) {
+      if (n == 0) {
+        return &(arg->type);
+      }
+      n--;
+    }
+    arg = arg->next;
+  }
+  if ((n == 0) && (method->return_type.type == TYPE_USERDATA)) {
+    return &(method->return_type);
+  }
+  error(ERROR_INTERNAL, "Method %s has no userdata output %d", method->name, n);
+}
+
 void handle_method(struct userdata *node) {
   trace(TRACE_USERDATA, "Adding a method");
   char * parent_name = node->name;
@@ -831,6 +864,13 @@ void handle_method(struct userdata *node) {
       string_copy(&(method->dependency), dependency);
       return;
 
+    } else if (strcmp(token, keyword_reuse) == 0) {
+      if (count_userdata_outputs(method) == 0) {
+        error(ERROR_USERDATA, "Method %s of %s has no userdata to reuse", name, parent_name);
+      }
+      method->flags |= TYPE_FLAGS_REUSE;
+      return;
+
     }
     error(ERROR_USERDATA, "Method %s already exists for %s (declared on %d)", name, parent_name, method->line);
   }
@@ -1900,6 +1940,26 @@ void emit_ap_object_fields() {
   }
 }
 
+// state of the method being emitted for reusing userdata passed by the script
+static int reuse_slots;    // number of userdata outputs that may be reused, 0 if the method doesn't reuse
+static int reuse_arg_base; // stack index before the first reuse argument
+static int reuse_next;     // next output to be pushed
+
+// push a userdata value, copying into the userdata passed by the script if there is one
+void emit_userdata_push(const char *tab, const struct type *type, const char *value) {
+  if (reuse_next < reuse_slots) {
+    fprintf(source, "%sif (reuse_%d != nullptr) {\n", tab, reuse_next);
+    fprintf(source, "%s    *reuse_%d = %s;\n", tab, reuse_next, value);
+    fprintf(source, "%s    lua_pushvalue(L, %d);\n", tab, reuse_arg_base + reuse_next + 1);
+    fprintf(source, "%s} else {\n", tab);
+    fprintf(source, "%s    *new_%s(L) = %s;\n", tab, type->data.ud.sanatized_name, value);
+    fprintf(source, "%s}\n", tab);
+    reuse_next++;
+  } else {
+    fprintf(source, "%s*new_%s(L) = %s;\n", tab, type->data.ud.sanatized_name, value);
+  }
+}
+
 // emit references functions for a call, return the number of arduments added
 int emit_references(const struct argument *arg, const char * tab) {
   int arg_index = NULLABLE_ARG_COUNT_BASE + 2;
@@ -1939,9 +1999,12 @@ int emit_references(const struct argument *arg, const char * tab) {
         case TYPE_STRING:
           fprintf(source, "%slua_pushstring(L, data_%d);\n", tab, arg_index);
           break;
-        case TYPE_USERDATA:
-          fprintf(source, "%s*new_%s(L) = data_%d;\n", tab, arg->type.data.ud.sanatized_name, arg_index);
+        case TYPE_USERDATA: {
+          char value[20];
+          sprintf(value, "data_%d", arg_index);
+          emit_userdata_push(tab, &(arg->type), value);
           break;
+        }
         case TYPE_NONE:
           error(ERROR_INTERNAL, "Attempted to emit a nullable or reference argument of type none");
           break;
@@ -1988,7 +2051,15 @@ void emit_userdata_method(const struct userdata *data, const struct method *meth
     }
     arg = arg->next;
   }
-  fprintf(source, "    binding_argcheck(L, %d);\n", arg_count);
+  reuse_slots = (method->flags & TYPE_FLAGS_REUSE) ? count_userdata_outputs(method) : 0;
+  reuse_arg_base = arg_count;
+  reuse_next = 0;
+  if (reuse_slots > 0) {
+    // the script may pass a userdata to fill in for each userdata returned
+    fprintf(source, "    const int reuse_count = binding_argcheck_reuse(L, %d, %d);\n", arg_count, reuse_slots);
+  } else {
+    fprintf(source, "    binding_argcheck(L, %d);\n", arg_count);
+  }
 
   switch (data->ud_type) {
     case UD_USERDATA:
@@ -2026,6 +2097,13 @@ void emit_userdata_method(const struct userdata *data, const struct method *meth
     arg = arg->next;
   }
 
+  // check the userdata to reuse before calling the method
+  for (int i = 0; i < reuse_slots; i++) {
+    const struct type *reuse_type = get_userdata_output(method, i);
+    fprintf(source, "    %s * reuse_%d = (reuse_count > %d) ? check_%s(L, %d) : nullptr;\n",
+            reuse_type->data.ud.name, i, i, reuse_type->data.ud.sanatized_name, reuse_arg_base + i + 1);
+  }
+
   const char *ud_name = (data->flags & UD_FLAG_LITERAL)?data->name:"ud";
   const char *ud_access = (data->flags & UD_FLAG_REFERENCE)?".":"->";
 
@@ -2213,7 +2291,7 @@ void emit_userdata_method(const struct userdata *data, const struct method *meth
       fprintf(source, "    lua_pushstring(L, data);\n");
       break;
     case TYPE_USERDATA:
-      fprintf(source, "    *new_%s(L) = data;\n", method->return_type.data.ud.sanatized_name);
+      emit_userdata_push("    ", &(method->return_type), "data");
       break;
     case TYPE_AP_OBJECT:
       fprintf(source, "    if (data == NULL) {\n");
@@ -2237,6 +2315,7 @@ void emit_userdata_method(const struct userdata *data, const struct method *meth
   end_dependency(source, data->dependency);
   fprintf(source, "\n");
 
+  reuse_slots = 0;
 }
 
 const char * get_name_for_operation(enum operator_type op) {
@@ -2680,6 +2759,17 @@ void emit_argcheck_helper(void) {
   fprintf(source, "    return 0;\n");
   fprintf(source, "}\n\n");
 
+  // allow up to max_reuse extra userdata arguments, returning how many were passed
+  fprintf(source, "int binding_argcheck_reuse(lua_State *L, int expected_arg_count, int max_reuse) {\n");
+  fprintf(source, "    const int args = lua_gettop(L);\n");
+  fprintf(source, "    if (args > expected_arg_count + max_reuse) {\n");
+  fprintf(source, "        return luaL_argerror(L, args, \"too many arguments\");\n");
+  fprintf(source, "    } else if (args < expected_arg_count) {\n");
+  fprintf(source, "        return luaL_argerror(L, args, \"too few arguments\");\n");
+  fprintf(source, "    }\n");
+  fprintf(source, "    return args - expected_arg_count;\n");
+  fprintf(source, "}\n\n");
+
   fprintf(source, "int field_argerror(lua_State *L) {\n");
   fprintf(source, "    return binding_argcheck(L, -1); // force too many args error\n");
   fprintf(source, "}\n\n");
@@ -2864,6 +2954,18 @@ void emit_docs_method(const char *name, const char *method_name, struct method *
     arg = arg->next;
   }
 
+  // optional userdata to fill in rather then allocating a new one
+  int reuse_count = 0;
+  if (method->flags & TYPE_FLAGS_REUSE) {
+    reuse_count = count_userdata_outputs(method);
+    for (int i = 0; i < reuse_count; i++) {
+      char *param_name = (char *)allocate(20);
+      sprintf(param_name, "---@param reuse%i?", i+1);
+      emit_docs_param_type(*get_userdata_output(method, i), param_name, "\n");
+      free(param_name);
+    }
+  }
+
   // return type
   if ((method->flags & TYPE_FLAGS_NULLABLE) == 0) {
     emit_docs_return_type(method->return_type, FALSE);
@@ -2882,7 +2984,13 @@ void emit_docs_method(const char *name, const char *method_name, struct method *
   fprintf(docs, "function %s:%s(", name, method_name);
   for (int i = 1; i < count; ++i) {
     fprintf(docs, "param%i", i);
-    if (i < count-1) {
+    if ((i < count-1) || (reuse_count > 0)) {
+      fprintf(docs, ", ");
+    }
+  }
+  for (int i = 1; i <= reuse_count; ++i) {
+    fprintf(docs, "reuse%i", i);
+    if (i < reuse_count) {
       fprintf(docs, ", ");
     }
   }
@@ -3252,6 +3360,7 @@ int main(int argc, char **argv) {
   fprintf(header, "void load_generated_bindings(lua_State *L);\n");
   fprintf(header, "void load_generated_sandbox(lua_State *L);\n");
   fprintf(header, "int binding_argcheck(lua_State *L, int expected_arg_count);\n");
+  fprintf(header, "int binding_argcheck_reuse(lua_State *L, int expected_arg_count, int max_reuse);\n");
   fprintf(header, "int field_argerror(lua_State *L);\n");
   fprintf(header, "bool userdata_zero_arg_check(lua_State *L);\n");
   fprintf(header, "lua_Integer get_integer(lua_State *L, int arg_num, lua_Integer min_val, lua_Integer max_val);\n");
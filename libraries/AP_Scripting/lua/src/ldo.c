@@ -776,7 +776,7 @@ static void f_parser (lua_State *L, void *ud) {
   LClosure *cl;
   struct SParser *p = cast(struct SParser *, ud);
   int c = zgetc(p->z);  /* read first character */
-#if LUA_SUPPORT_LOAD_BINARY
+#if LUA_SUPPORT_LOAD_BINARY || AP_SCRIPTING_BYTECODE_ENABLED
   // support loading pre-compiled luac
   if (c == LUA_SIGNATURE[0]) {
     checkmode(L, p->mode, "binary");
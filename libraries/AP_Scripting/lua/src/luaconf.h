@@ -12,7 +12,8 @@
 #include <stddef.h>
 
 /*
-  don't support binary load() by default
+  don't support binary load() by default, precompiled script files are
+  controlled by AP_SCRIPTING_BYTECODE_ENABLED
  */
 #ifndef LUA_SUPPORT_LOAD_BINARY
 #define LUA_SUPPORT_LOAD_BINARY 0
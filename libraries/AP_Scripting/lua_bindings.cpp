@@ -12,12 +12,14 @@
 #include <AP_Filesystem/AP_Filesystem.h>
 
 #include "lua_bindings.h"
+#include "lua_scripts.h"
 
 #include "lua_boxed_numerics.h"
 #include <AP_Scripting/lua_generated_bindings.h>
 
 #include <AP_Scheduler/AP_Scheduler.h>
 #include <AP_Scripting/AP_Scripting.h>
+#include <AP_HAL/utility/sparse-endian.h>
 #include <string.h>
 
 #include "lua/src/lauxlib.h"
@@ -741,6 +743,67 @@ int lua_get_CAN_device2(lua_State *L) {
 
     return 1;
 }
+
+/*
+  read up to max frames from the buffer, returning them packed in a
+  string with a uint32 id and length prefixed data for each, to be read
+  by string.unpack("<I4s1"), and the number of frames read
+ */
+int lua_CAN_read_frames(lua_State *L)
+{
+    binding_argcheck(L, 2);
+    ScriptingCANBuffer *buffer = *check_ScriptingCANBuffer(L, 1);
+    const uint16_t max_frames = get_uint16_t(L, 2);
+
+    luaL_Buffer b;
+    luaL_buffinit(L, &b);
+    uint16_t count = 0;
+    AP_HAL::CANFrame frame;
+    while (count < max_frames && buffer->read_frame(frame)) {
+        const uint8_t len = AP_HAL::CANFrame::dlcToDataLength(frame.dlc);
+        char *p = luaL_prepbuffsize(&b, sizeof(frame.id) + 1 + len);
+        put_le32_ptr((uint8_t *)p, frame.id);
+        p[sizeof(frame.id)] = len;
+        memcpy(&p[sizeof(frame.id)+1], frame.data, len);
+        luaL_addsize(&b, sizeof(frame.id) + 1 + len);
+        count++;
+    }
+    luaL_pushresult(&b);
+    lua_pushinteger(L, count);
+    return 2;
+}
+
+/*
+  write frames packed as by read_frames, returning the number written.
+  Writing stops at the first frame that could not be sent
+ */
+int lua_CAN_write_frames(lua_State *L)
+{
+    binding_argcheck(L, 3);
+    ScriptingCANBuffer *buffer = *check_ScriptingCANBuffer(L, 1);
+    size_t size;
+    const uint8_t *data = (const uint8_t *)luaL_checklstring(L, 2, &size);
+    const uint32_t timeout_us = get_uint32(L, 3, 0, UINT32_MAX);
+
+    uint16_t count = 0;
+    size_t ofs = 0;
+    while (ofs + sizeof(uint32_t) + 1 <= size) {
+        const uint32_t id = le32toh_ptr(&data[ofs]);
+        const uint8_t len = data[ofs + sizeof(uint32_t)];
+        ofs += sizeof(uint32_t) + 1;
+        if (ofs + len > size || len > AP_HAL::CANFrame::MaxDataLen) {
+            return luaL_argerror(L, 2, "truncated frame");
+        }
+        AP_HAL::CANFrame frame(id, &data[ofs], len, len > AP_HAL::CANFrame::NonFDCANMaxDataLen);
+        ofs += len;
+        if (!buffer->write_frame(frame, timeout_us)) {
+            break;
+        }
+        count++;
+    }
+    lua_pushinteger(L, count);
+    return 1;
+}
 #endif // AP_SCRIPTING_CAN_SENSOR_ENABLED
 
 #if AP_SERIALMANAGER_ENABLED
@@ -1080,10 +1143,22 @@ int SocketAPM_string_to_ipv4_addr(lua_State *L) {
 #endif // AP_NETWORKING_ENABLED
 
 
-int lua_get_current_env_ref()
+#if AP_SCRIPTING_EVENTS_ENABLED
+// set the events that wake the running script before its next run time
+int lua_scripting_wake_on(lua_State *L)
 {
-    auto *scripting = AP::scripting();
-    return scripting->get_current_env_ref();
+    check_AP_Scripting(L);
+    binding_argcheck(L, 2);
+
+    const uint8_t events = get_uint8_t(L, 2);
+    lua_pushboolean(L, lua_scripts::set_wake_events(L, events));
+    return 1;
+}
+#endif // AP_SCRIPTING_EVENTS_ENABLED
+
+int lua_get_current_env_ref(lua_State *L)
+{
+    return lua_scripts::get_current_env_ref(L);
 }
 
 // This is used when loading modules with require, lua must only look in enabled directory's
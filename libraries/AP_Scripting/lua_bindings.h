@@ -11,6 +11,8 @@ int AP_HAL__I2CDevice_read_registers(lua_State *L);
 int AP_HAL__I2CDevice_transfer(lua_State *L);
 int lua_get_CAN_device(lua_State *L);
 int lua_get_CAN_device2(lua_State *L);
+int lua_CAN_read_frames(lua_State *L);
+int lua_CAN_write_frames(lua_State *L);
 int lua_serial_find_serial(lua_State *L);
 int lua_serial_find_simulated_device(lua_State *L);
 int lua_serial_writestring(lua_State *L);
@@ -35,3 +37,4 @@ int lua_print(lua_State *L);
 int lua_range_finder_handle_script_msg(lua_State *L);
 int lua_GCS_command_int(lua_State *L);
 int lua_DroneCAN_get_FlexDebug(lua_State *L);
+int lua_scripting_wake_on(lua_State *L);
@@ -11,7 +11,16 @@
   #endif // HAL_OS_FATFS_IO || HAL_OS_LITTLEFS_IO
 #endif // SCRIPTING_DIRECTORY
 
-int lua_get_current_env_ref();
+// allow script files to be precompiled (luac) bytecode. Bytecode is
+// not verified by the VM and script files can be uploaded over
+// MAVLink FTP, so this is off unless a build opts in. Chunks built at
+// runtime with load() are always parsed as text
+#ifndef AP_SCRIPTING_BYTECODE_ENABLED
+#define AP_SCRIPTING_BYTECODE_ENABLED 0
+#endif
+
+struct lua_State;
+int lua_get_current_env_ref(struct lua_State *L);
 const char* lua_get_modules_path();
 void lua_abort(void) __attribute__((noreturn));
 
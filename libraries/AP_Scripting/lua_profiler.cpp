@@ -0,0 +1,202 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lua_profiler.h"
+
+#if AP_SCRIPTING_PROFILER_ENABLED
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Filesystem/AP_Filesystem.h>
+#include <AP_Math/AP_Math.h>
+
+extern const AP_HAL::HAL& hal;
+
+// number of lines listed for each script by info()
+#define LUA_PROFILER_INFO_LINES 5
+
+void lua_profiler::start(session &sess, const char *name)
+{
+    const char *short_name = strrchr(name, '/');
+    short_name = (short_name != nullptr) ? short_name + 1 : name;
+
+    WITH_SEMAPHORE(sem);
+    sess.current = find_or_create(short_name);
+    sess.last_sample_us = AP_HAL::micros();
+}
+
+void lua_profiler::stop(session &sess)
+{
+    WITH_SEMAPHORE(sem);
+    if (sess.current != nullptr) {
+        // the tail of the run after the last sample only counts to
+        // the total for the script
+        sess.current->time_us += AP_HAL::micros() - sess.last_sample_us;
+    }
+    sess.current = nullptr;
+}
+
+lua_profiler::script_profile *lua_profiler::find_or_create(const char *name)
+{
+    for (script_profile *p = profiles; p != nullptr; p = p->next) {
+        if (strncmp(p->name, name, sizeof(p->name)-1) == 0) {
+            return p;
+        }
+    }
+    script_profile *p = NEW_NOTHROW script_profile();
+    if (p == nullptr) {
+        return nullptr;
+    }
+    strncpy(p->name, name, sizeof(p->name)-1);
+    p->next = profiles;
+    profiles = p;
+    return p;
+}
+
+void lua_profiler::sample(session &sess, lua_State *L)
+{
+    script_profile *current = sess.current;
+    if (current == nullptr) {
+        return;
+    }
+
+    stack s {};
+    lua_Debug ar;
+    for (int level = 0; lua_getstack(L, level, &ar); level++) {
+        if (s.depth == LUA_PROFILER_MAX_DEPTH) {
+            s.truncated = true;
+            break;
+        }
+        lua_getinfo(L, "Sl", &ar);
+        if (level == 0) {
+            s.line = ar.currentline;
+        }
+        s.frames[s.depth++] = ar.linedefined;
+    }
+    if (s.depth == 0) {
+        return;
+    }
+
+    const uint32_t now_us = AP_HAL::micros();
+    const uint32_t dt_us = now_us - sess.last_sample_us;
+    sess.last_sample_us = now_us;
+
+    WITH_SEMAPHORE(sem);
+    current->instructions += LUA_PROFILER_SAMPLE_INSTRUCTIONS;
+    current->time_us += dt_us;
+    if (!add_sample(*current, s, dt_us)) {
+        current->dropped++;
+    }
+}
+
+bool lua_profiler::add_sample(script_profile &p, const stack &s, uint32_t dt_us)
+{
+    // FNV-1a hash of the stack into an open addressed table
+    uint32_t hash = 2166136261U;
+    for (uint8_t i = 0; i < s.depth; i++) {
+        hash = (hash ^ uint16_t(s.frames[i])) * 16777619U;
+    }
+    hash = (hash ^ uint16_t(s.line)) * 16777619U;
+
+    for (uint16_t i = 0; i < LUA_PROFILER_MAX_STACKS; i++) {
+        stack &e = p.stacks[(hash + i) % LUA_PROFILER_MAX_STACKS];
+        if (e.depth == 0) {
+            e = s;
+        } else if (e.depth != s.depth || e.line != s.line || e.truncated != s.truncated ||
+                   memcmp(e.frames, s.frames, sizeof(s.frames)) != 0) {
+            continue;
+        }
+        e.instructions += LUA_PROFILER_SAMPLE_INSTRUCTIONS;
+        e.time_us += dt_us;
+        return true;
+    }
+    return false;
+}
+
+void lua_profiler::print_frame(char *buf, size_t size, int16_t linedefined)
+{
+    if (linedefined == 0) {
+        strncpy(buf, "main", size);
+    } else if (linedefined < 0) {
+        strncpy(buf, "[C]", size);
+    } else {
+        hal.util->snprintf(buf, size, "fn@%d", linedefined);
+    }
+}
+
+/*
+  write one line per stack in the collapsed format used by
+  flamegraph.pl, weighted by VM instructions:
+  script.lua;main;fn@12;fn@40:45 1200
+ */
+void lua_profiler::write_file(const char *filename)
+{
+    const int fd = AP::FS().open(filename, O_WRONLY|O_CREAT|O_TRUNC);
+    if (fd == -1) {
+        return;
+    }
+
+    WITH_SEMAPHORE(sem);
+    for (const script_profile *p = profiles; p != nullptr; p = p->next) {
+        for (const stack &s : p->stacks) {
+            if (s.depth == 0) {
+                continue;
+            }
+            char line[256];
+            size_t len = hal.util->snprintf(line, sizeof(line), "%s%s", p->name, s.truncated ? ";..." : "");
+            for (int8_t i = s.depth-1; i >= 0 && len < sizeof(line); i--) {
+                char frame[16];
+                print_frame(frame, sizeof(frame), s.frames[i]);
+                len += hal.util->snprintf(&line[len], sizeof(line)-len, ";%s", frame);
+            }
+            if (len < sizeof(line)) {
+                len += hal.util->snprintf(&line[len], sizeof(line)-len, ":%d %u\n", s.line, unsigned(s.instructions));
+            }
+            AP::FS().write(fd, line, MIN(len, sizeof(line)-1));
+        }
+    }
+    AP::FS().close(fd);
+}
+
+void lua_profiler::info(ExpandingString &str)
+{
+    WITH_SEMAPHORE(sem);
+    for (const script_profile *p = profiles; p != nullptr; p = p->next) {
+        str.printf("%-31s instr=%u time=%ums dropped=%u\n",
+                   p->name, unsigned(p->instructions), unsigned(p->time_us / 1000U), unsigned(p->dropped));
+
+        // list the most used lines, one pass for each
+        uint32_t limit = UINT32_MAX;
+        for (uint8_t n = 0; n < LUA_PROFILER_INFO_LINES; n++) {
+            const stack *best = nullptr;
+            for (const stack &s : p->stacks) {
+                if (s.depth != 0 && s.instructions < limit &&
+                    (best == nullptr || s.instructions > best->instructions)) {
+                    best = &s;
+                }
+            }
+            if (best == nullptr) {
+                break;
+            }
+            limit = best->instructions;
+            char frame[16];
+            print_frame(frame, sizeof(frame), best->frames[0]);
+            str.printf("  %s:%d %u%% %uus\n", frame, best->line,
+                       unsigned(best->instructions * 100ULL / MAX(p->instructions, 1U)),
+                       unsigned(best->time_us));
+        }
+    }
+}
+
+#endif  // AP_SCRIPTING_PROFILER_ENABLED
@@ -0,0 +1,97 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "AP_Scripting_config.h"
+
+#if AP_SCRIPTING_PROFILER_ENABLED
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Common/ExpandingString.h>
+#include <AP_HAL/Semaphores.h>
+
+#include "lua/src/lua.hpp"
+
+// number of VM instructions between samples
+#ifndef LUA_PROFILER_SAMPLE_INSTRUCTIONS
+#define LUA_PROFILER_SAMPLE_INSTRUCTIONS 100
+#endif
+
+// number of distinct stacks recorded for each script
+#ifndef LUA_PROFILER_MAX_STACKS
+#define LUA_PROFILER_MAX_STACKS 64
+#endif
+
+// number of frames recorded for each stack, innermost first
+#ifndef LUA_PROFILER_MAX_DEPTH
+#define LUA_PROFILER_MAX_DEPTH 6
+#endif
+
+/*
+  sampling profiler for scripts, driven from the VM instruction count
+  hook. Each sample attributes the instructions and wall time since the
+  previous sample to the stack of the running script
+ */
+class lua_profiler {
+    struct script_profile;
+public:
+    // the script being sampled by one VM
+    struct session {
+        script_profile *current;
+        uint32_t last_sample_us;
+    };
+
+    // attribute samples to the named script until stop() is called
+    void start(session &sess, const char *name);
+    void stop(session &sess);
+
+    // record a sample from the count hook
+    void sample(session &sess, lua_State *L);
+
+    // write the samples as collapsed stacks for flamegraph.pl
+    void write_file(const char *filename);
+
+    // summary of the cost of each script and its most used lines
+    void info(ExpandingString &str);
+
+private:
+    struct stack {
+        int16_t frames[LUA_PROFILER_MAX_DEPTH]; // line each function was defined on, 0 for the main chunk, -1 for C functions
+        int16_t line;       // current line of the innermost function
+        uint8_t depth;
+        bool truncated;     // stack was deeper than LUA_PROFILER_MAX_DEPTH
+        uint32_t instructions;
+        uint32_t time_us;
+    };
+
+    struct script_profile {
+        script_profile *next;
+        char name[32];
+        uint32_t instructions;
+        uint32_t time_us;
+        uint32_t dropped;   // samples without space for their stack
+        stack stacks[LUA_PROFILER_MAX_STACKS];
+    };
+
+    script_profile *find_or_create(const char *name);
+    bool add_sample(script_profile &p, const stack &s, uint32_t dt_us);
+
+    static void print_frame(char *buf, size_t size, int16_t linedefined);
+
+    script_profile *profiles;
+    HAL_Semaphore sem;
+};
+
+#endif  // AP_SCRIPTING_PROFILER_ENABLED
@@ -29,8 +29,6 @@
 extern const AP_HAL::HAL& hal;
 #define ENABLE_DEBUG_MODULE 0
 
-bool lua_scripts::overtime;
-jmp_buf lua_scripts::panic_jmp;
 char *lua_scripts::error_msg_buf;
 HAL_Semaphore lua_scripts::error_msg_buf_sem;
 uint8_t lua_scripts::print_error_count;
@@ -40,6 +38,19 @@ uint32_t lua_scripts::loaded_checksum;
 uint32_t lua_scripts::running_checksum;
 HAL_Semaphore lua_scripts::crc_sem;
 
+#if AP_SCRIPTING_EVENTS_ENABLED
+HAL_Semaphore lua_scripts::event_sem;
+lua_scripts *lua_scripts::event_vms;
+#endif
+
+#if AP_SCRIPTING_PROFILER_ENABLED
+lua_profiler lua_scripts::profiler;
+
+// collapsed stacks for flamegraph.pl
+#define SCRIPTING_PROFILE_FILE SCRIPTING_DIRECTORY "/profile.txt"
+#define SCRIPTING_PROFILE_WRITE_MS 10000
+#endif
+
 // return string error message for error object at top of stack
 static const char *get_error_object_message(lua_State *L) {
     const char *m = lua_tostring(L, -1);
@@ -49,20 +60,52 @@ static const char *get_error_object_message(lua_State *L) {
     return m;
 }
 
-lua_scripts::lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size, AP_Int8 &debug_options)
-    : _vm_steps(vm_steps),
+lua_scripts::lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size, AP_Int8 &debug_options, const AP_Int16 &gc_budget_us, uint8_t vm)
+    : _vm(vm),
+      _vm_steps(vm_steps),
+      _gc_budget_us(gc_budget_us),
       _debug_options(debug_options)
 {
     const bool allow_heap_expansion = !option_is_set(AP_Scripting::DebugOption::DISABLE_HEAP_EXPANSION);
     _heap.create(heap_size, 10, allow_heap_expansion, 20*1024);
+
+#if AP_SCRIPTING_EVENTS_ENABLED
+    WITH_SEMAPHORE(event_sem);
+    next_event_vm = event_vms;
+    event_vms = this;
+#endif
 }
 
 lua_scripts::~lua_scripts() {
+#if AP_SCRIPTING_EVENTS_ENABLED
+    {
+        WITH_SEMAPHORE(event_sem);
+        for (lua_scripts **link = &event_vms; *link != nullptr; link = &(*link)->next_event_vm) {
+            if (*link == this) {
+                *link = next_event_vm;
+                break;
+            }
+        }
+    }
+#endif
     _heap.destroy();
 }
 
 void lua_scripts::hook(lua_State *L, lua_Debug *ar) {
-    lua_scripts::overtime = true;
+    lua_scripts *vm = instance(L);
+#if AP_SCRIPTING_PROFILER_ENABLED
+    if (vm->profile_steps_remaining > 0) {
+        // sampling for the profiler, only over time once the whole
+        // instruction budget has been used
+        profiler.sample(vm->profile_session, L);
+        vm->profile_steps_remaining -= LUA_PROFILER_SAMPLE_INSTRUCTIONS;
+        if (vm->profile_steps_remaining > 0) {
+            return;
+        }
+    }
+#endif
+
+    vm->overtime = true;
 
     // we need to aggressively bail out as we are over time
     // so we will aggressively trap errors until we clear out
@@ -88,7 +131,7 @@ void lua_scripts::set_and_print_new_error_message(MAV_SEVERITY severity, const c
     // reset buffer and print count
     print_error_count = 0;
     if (error_msg_buf) {
-        _heap.deallocate(error_msg_buf);
+        free(error_msg_buf);
         error_msg_buf = nullptr;
     }
 
@@ -110,8 +153,9 @@ void lua_scripts::set_and_print_new_error_message(MAV_SEVERITY severity, const c
         return;
     }
 
-    // allocate buffer on scripting heap
-    error_msg_buf = (char *)_heap.allocate(len+1);
+    // allocate buffer on the system heap, as messages can come from
+    // any VM and the heap of each is only used by its own thread
+    error_msg_buf = (char *)malloc(len+1);
     if (!error_msg_buf) {
         // allocation failed
         va_end(arg_list);
@@ -132,18 +176,62 @@ void lua_scripts::set_and_print_new_error_message(MAV_SEVERITY severity, const c
 
 int lua_scripts::atpanic(lua_State *L) {
     set_and_print_new_error_message(MAV_SEVERITY_CRITICAL, "Panic: %s", get_error_object_message(L));
-    longjmp(panic_jmp, 1);
+    longjmp(instance(L)->panic_jmp, 1);
     return 0;
 }
 
+/*
+  garbage collect after each script. With a zero SCR_GC_BUDGET this
+  is a full collection, else the incremental collector is stepped
+  until the budget is used, a cycle completes or the next script is
+  due, so a large heap does not stall the scripts that follow
+ */
+void lua_scripts::collect_garbage(lua_State *L)
+{
+    if (_gc_budget_us <= 0) {
+        lua_gc(L, LUA_GCCOLLECT, 0);
+        return;
+    }
+
+    const uint32_t start_us = AP_HAL::micros();
+    uint32_t budget_us = _gc_budget_us;
+    if (scripts != nullptr) {
+        const uint64_t now_ms = AP_HAL::millis64();
+        if (scripts->next_run_ms <= now_ms) {
+            // only the minimum single step if a script is already due
+            budget_us = 0;
+        } else {
+            budget_us = MIN(budget_us, (scripts->next_run_ms - now_ms) * 1000U);
+        }
+    }
+
+    // always take at least one step so the collector keeps up with
+    // scripts that run back to back
+    do {
+        if (lua_gc(L, LUA_GCSTEP, 0) != 0) {
+            // finished a cycle
+            break;
+        }
+    } while (AP_HAL::micros() - start_us < budget_us);
+}
+
 // helper for print and log of runtime stats
-void lua_scripts::update_stats(const char *name, uint32_t run_time, int total_mem, int run_mem)
+void lua_scripts::update_stats(const char *name, uint32_t run_time, int total_mem, int run_mem, uint32_t gc_time)
 {
     if (option_is_set(AP_Scripting::DebugOption::RUNTIME_MSG)) {
-        GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "Lua: Time: %u Mem: %d + %d",
+        GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "Lua: Time: %u GC: %u Mem: %d + %d",
                                             (unsigned int)run_time,
+                                            (unsigned int)gc_time,
                                             (int)total_mem,
                                             (int)run_mem);
+#if AP_MULTIHEAP_POOL_ENABLED
+        // small objects in use out of the memory held by the pool
+        MultiHeap::PoolStats pool;
+        _heap.get_pool_stats(pool);
+        GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "Lua: Pool: %u/%u",
+                                            (unsigned int)pool.in_use_bytes,
+                                            (unsigned int)pool.pool_bytes);
+#endif
     }
 #if HAL_LOGGING_ENABLED
     if (option_is_set(AP_Scripting::DebugOption::LOG_RUNTIME)) {
@@ -153,7 +241,8 @@ void lua_scripts::update_stats(const char *name, uint32_t run_time, int total_me
             name         : {},
             run_time     : run_time,
             total_mem    : total_mem,
-            run_mem      : run_mem
+            run_mem      : run_mem,
+            gc_time      : gc_time
         };
         const char * name_short = strrchr(name, '/');
         if ((strlen(name) > sizeof(pkt.name)) && (name_short != nullptr)) {
@@ -207,12 +296,15 @@ lua_scripts::script_info *lua_scripts::load_script(lua_State *L, char *filename)
     const uint32_t loadEnd = AP_HAL::micros();
     const int endMem = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
 
-    update_stats(filename, loadEnd-loadStart, endMem, loadMem);
+    update_stats(filename, loadEnd-loadStart, endMem, loadMem, 0);
 
     new_script->name = filename;
     new_script->env_ref = luaL_ref(L, LUA_REGISTRYINDEX); // store reference to script's environment
     new_script->run_ref = luaL_ref(L, LUA_REGISTRYINDEX); // store reference to function to run
     new_script->next_run_ms = AP_HAL::millis64() - 1; // force the script to be stale
+#if AP_SCRIPTING_EVENTS_ENABLED
+    new_script->wake_events = 0;
+#endif
 
     // Get checksum of file
     uint32_t crc = 0;
@@ -261,6 +353,28 @@ void lua_scripts::create_sandbox(lua_State *L) {
     load_generated_sandbox(L);
 }
 
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+/*
+  return the VM a script asks to be run in with a first line of
+  "-- @vm N", zero if it does not have the header
+ */
+uint8_t lua_scripts::script_vm(const char *filename)
+{
+    const int fd = AP::FS().open(filename, O_RDONLY);
+    if (fd == -1) {
+        return 0;
+    }
+    char line[16] {};
+    const int32_t n = AP::FS().read(fd, line, sizeof(line)-1);
+    AP::FS().close(fd);
+    const char *header = "-- @vm ";
+    if (n <= 0 || strncmp(line, header, strlen(header)) != 0) {
+        return 0;
+    }
+    return MIN(strtoul(&line[strlen(header)], nullptr, 10), UINT8_MAX);
+}
+#endif // AP_SCRIPTING_MULTI_VM_ENABLED
+
 void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname) {
     if (dirname == nullptr) {
         return;
@@ -275,7 +389,7 @@ void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname) {
         return;
     }
 
-    // load anything that ends in .lua
+    // load anything that ends in .lua, or .luac for precompiled scripts
     for (struct dirent *de=AP::FS().readdir(d); de; de=AP::FS().readdir(d)) {
         uint8_t length = strlen(de->d_name);
         if (length < 5) {
@@ -283,19 +397,59 @@ void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname) {
             continue;
         }
 
-        if ((de->d_name[0] == '.') || strncmp(&de->d_name[length-4], ".lua", 4)) {
-            // starts with . (hidden file) or doesn't end in .lua
+        if (de->d_name[0] == '.') {
+            // starts with . (hidden file)
+            continue;
+        }
+        const bool is_source = strncmp(&de->d_name[length-4], ".lua", 4) == 0;
+#if AP_SCRIPTING_BYTECODE_ENABLED
+        const bool is_bytecode = strncmp(&de->d_name[length-5], ".luac", 5) == 0;
+#else
+        const bool is_bytecode = false;
+#endif
+        if (!is_source && !is_bytecode) {
             continue;
         }
 
         // FIXME: because chunk name fetching is not working we are allocating and storing an extra string we shouldn't need to
-        size_t size = strlen(dirname) + strlen(de->d_name) + 2;
+        // one spare byte so the name of the precompiled copy fits below
+        size_t size = strlen(dirname) + strlen(de->d_name) + 3;
         char * filename = (char *) _heap.allocate(size);
         if (filename == nullptr) {
             continue;
         }
         snprintf(filename, size, "%s/%s", dirname, de->d_name);
 
+#if AP_SCRIPTING_BYTECODE_ENABLED
+        if (is_source) {
+            // prefer a precompiled copy of the script, which is
+            // loaded when it is found in the directory
+            struct stat st;
+            const size_t len = strlen(filename);
+            filename[len] = 'c';
+            filename[len+1] = 0;
+            const bool have_bytecode = AP::FS().stat(filename, &st) == 0;
+            filename[len] = 0;
+            if (have_bytecode) {
+                _heap.deallocate(filename);
+                continue;
+            }
+        }
+#endif
+
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+        // scripts without a header, precompiled scripts and those
+        // asking for a VM that is not enabled run in the first VM
+        uint8_t vm = is_source ? script_vm(filename) : 1;
+        if (!AP_Scripting::get_singleton()->vm_enabled(vm)) {
+            vm = 1;
+        }
+        if (vm != _vm) {
+            _heap.deallocate(filename);
+            continue;
+        }
+#endif
+
         // we have something that looks like a lua file, attempt to load it
         script_info * script = load_script(L, filename);
         if (script == nullptr) {
@@ -317,6 +471,14 @@ void lua_scripts::reset_loop_overtime(lua_State *L) {
     overtime = false;
     // reset the hook to clear the counter
     const int32_t vm_steps = MAX(_vm_steps, 1000);
+#if AP_SCRIPTING_PROFILER_ENABLED
+    if (option_is_set(AP_Scripting::DebugOption::PROFILE)) {
+        profile_steps_remaining = vm_steps;
+        lua_sethook(L, hook, LUA_MASKCOUNT, LUA_PROFILER_SAMPLE_INSTRUCTIONS);
+        return;
+    }
+    profile_steps_remaining = 0;
+#endif
     lua_sethook(L, hook, LUA_MASKCOUNT, vm_steps);
 }
 
@@ -342,9 +504,32 @@ void lua_scripts::run_next_script(lua_State *L) {
     // pop the function to the top of the stack
     lua_rawgeti(L, LUA_REGISTRYINDEX, script->run_ref);
     // set current environment for other users
-    AP::scripting()->set_current_env_ref(script->env_ref);
+    current_env_ref = script->env_ref;
+
+#if AP_SCRIPTING_PROFILER_ENABLED
+    const bool profiling = profile_steps_remaining > 0;
+    if (profiling) {
+        profiler.start(profile_session, script->name);
+    }
+#endif
+
+#if AP_SCRIPTING_EVENTS_ENABLED
+    running_script = script;
+#endif
+
+    const int pcall_result = lua_pcall(L, 0, LUA_MULTRET, 0);
+
+#if AP_SCRIPTING_EVENTS_ENABLED
+    running_script = nullptr;
+#endif
 
-    if(lua_pcall(L, 0, LUA_MULTRET, 0)) {
+#if AP_SCRIPTING_PROFILER_ENABLED
+    if (profiling) {
+        profiler.stop(profile_session);
+    }
+#endif
+
+    if (pcall_result) {
         if (overtime) {
             // script has consumed an excessive amount of CPU time
             set_and_print_new_error_message(MAV_SEVERITY_CRITICAL, "%s exceeded time limit", script->name);
@@ -432,6 +617,84 @@ void lua_scripts::remove_script(lua_State *L, script_info *script) {
     _heap.deallocate(script);
 }
 
+#if AP_SCRIPTING_EVENTS_ENABLED
+bool lua_scripts::set_wake_events(lua_State *L, uint8_t events)
+{
+    lua_scripts *vm = instance(L);
+    if (vm->running_script == nullptr) {
+        return false;
+    }
+    vm->running_script->wake_events = events;
+    return true;
+}
+
+void lua_scripts::signal_event(uint8_t events)
+{
+    WITH_SEMAPHORE(event_sem);
+    for (lua_scripts *vm = event_vms; vm != nullptr; vm = vm->next_event_vm) {
+        if ((vm->wanted_events & events) != 0) {
+            vm->pending_events |= events;
+            vm->wake_sem.signal();
+        }
+    }
+}
+
+/*
+  sleep until the first script is due, or an event that a script is
+  waiting for happens, in which case those scripts are moved to the
+  front of the list to be run now
+ */
+void lua_scripts::wait_for_event(uint32_t timeout_ms)
+{
+    uint8_t wanted = 0;
+    for (script_info *script = scripts; script != nullptr; script = script->next) {
+        wanted |= script->wake_events;
+    }
+    {
+        WITH_SEMAPHORE(event_sem);
+        wanted_events = wanted;
+    }
+    if (wanted == 0) {
+        hal.scheduler->delay(timeout_ms);
+        return;
+    }
+
+    // wait is limited to what fits in microseconds, the caller waits
+    // again if the script is still not due
+    if (!wake_sem.wait(MIN(timeout_ms, 3600000U) * 1000U)) {
+        return;
+    }
+
+    uint8_t events;
+    {
+        WITH_SEMAPHORE(event_sem);
+        events = pending_events;
+        pending_events = 0;
+    }
+
+    // take the woken scripts out of the list, then put them back to run now
+    script_info *woken = nullptr;
+    script_info **link = &scripts;
+    while (*link != nullptr) {
+        script_info *script = *link;
+        if ((script->wake_events & events) != 0) {
+            *link = script->next;
+            script->next = woken;
+            woken = script;
+        } else {
+            link = &script->next;
+        }
+    }
+    const uint64_t now_ms = AP_HAL::millis64();
+    while (woken != nullptr) {
+        script_info *script = woken;
+        woken = script->next;
+        script->next_run_ms = now_ms;
+        reschedule_script(script);
+    }
+}
+#endif // AP_SCRIPTING_EVENTS_ENABLED
+
 void lua_scripts::reschedule_script(script_info *script) {
     if (script == nullptr) {
 #if defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
@@ -467,11 +730,8 @@ void lua_scripts::reschedule_script(script_info *script) {
     previous->next = script;
 }
 
-MultiHeap lua_scripts::_heap;
-
 void *lua_scripts::alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
-    (void)ud; /* not used */
-    return _heap.change_size(ptr, osize, nsize);
+    return ((lua_scripts *)ud)->_heap.change_size(ptr, osize, nsize);
 }
 
 void lua_scripts::run(void) {
@@ -496,14 +756,19 @@ void lua_scripts::run(void) {
         }
         scripts = nullptr;
         overtime = false;
+#if AP_SCRIPTING_EVENTS_ENABLED
+        running_script = nullptr;
+#endif
     }
 
-    lua_state = lua_newstate(alloc, NULL);
+    lua_state = lua_newstate(alloc, this);
     lua_State *L = lua_state;
     if (L == nullptr) {
         GCS_SEND_TEXT(MAV_SEVERITY_CRITICAL, "Lua: Couldn't allocate a lua state");
         return;
     }
+    // copied to coroutines, so the hook and panic handler can find the VM
+    *(lua_scripts **)lua_getextraspace(L) = this;
 
 #ifndef HAL_CONSOLE_DISABLED
     const int inital_mem = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
@@ -573,7 +838,13 @@ void lua_scripts::run(void) {
             // compute delay time
             uint64_t now_ms = AP_HAL::millis64();
             if (now_ms < scripts->next_run_ms) {
+#if AP_SCRIPTING_EVENTS_ENABLED
+                // go round again, the first script may have changed
+                wait_for_event(scripts->next_run_ms - now_ms);
+                continue;
+#else
                 hal.scheduler->delay(scripts->next_run_ms - now_ms);
+#endif
             }
 
             if (option_is_set(AP_Scripting::DebugOption::RUNTIME_MSG)) {
@@ -605,11 +876,9 @@ void lua_scripts::run(void) {
             hal.scheduler->restore_interrupts(istate);
 #endif
 
-            update_stats(script_name, runEnd - loadEnd, endMem, endMem - startMem);
+            collect_garbage(L);
 
-
-            // garbage collect after each script, this shouldn't matter, but seems to resolve a memory leak
-            lua_gc(L, LUA_GCCOLLECT, 0);
+            update_stats(script_name, runEnd - loadEnd, endMem, endMem - startMem, AP_HAL::micros() - runEnd);
 
         } else {
             if (option_is_set(AP_Scripting::DebugOption::NO_SCRIPTS_TO_RUN)) {
@@ -626,12 +895,21 @@ void lua_scripts::run(void) {
         const uint32_t new_expansion_size = _heap.get_expansion_size();
         if (new_expansion_size > expansion_size) {
             expansion_size = new_expansion_size;
-            set_and_print_new_error_message(MAV_SEVERITY_WARNING, "Required SCR_HEAP_SIZE over %u", unsigned(expansion_size));
+            set_and_print_new_error_message(MAV_SEVERITY_WARNING, "Required %s over %u", (_vm == 1) ? "SCR_HEAP_SIZE" : "SCR_VM2_HEAP", unsigned(expansion_size));
+        }
+
+#if AP_SCRIPTING_PROFILER_ENABLED
+        // periodically save the profile so it survives a power off
+        if (_vm == 1 && option_is_set(AP_Scripting::DebugOption::PROFILE) &&
+            (AP_HAL::millis() - last_profile_write_ms > SCRIPTING_PROFILE_WRITE_MS)) {
+            last_profile_write_ms = AP_HAL::millis();
+            profiler.write_file(SCRIPTING_PROFILE_FILE);
         }
+#endif
 
         // re-print the latest error message every 10 seconds 10 times
         const uint8_t error_prints = 10;
-        if ((print_error_count < error_prints) && (AP_HAL::millis() - last_print_ms > 10000)) {
+        if ((_vm == 1) && (print_error_count < error_prints) && (AP_HAL::millis() - last_print_ms > 10000)) {
             // note that we do not clear the buffer after we have finished printing, this allows it to be used for a pre-arm check
             print_error(MAV_SEVERITY_DEBUG);
             print_error_count++;
@@ -648,12 +926,14 @@ void lua_scripts::run(void) {
         lua_state = nullptr;
     }
 
-    error_msg_buf_sem.take_blocking();
-    if (error_msg_buf != nullptr) {
-        _heap.deallocate(error_msg_buf);
-        error_msg_buf = nullptr;
+    if (_vm == 1) {
+        error_msg_buf_sem.take_blocking();
+        if (error_msg_buf != nullptr) {
+            free(error_msg_buf);
+            error_msg_buf = nullptr;
+        }
+        error_msg_buf_sem.give();
     }
-    error_msg_buf_sem.give();
 }
 
 // Return the file checksums of running and loaded scripts
@@ -669,4 +949,12 @@ uint32_t lua_scripts::get_running_checksum()
     return running_checksum;
 }
 
+#if AP_SCRIPTING_PROFILER_ENABLED
+// summary of the profile for @SYS/scripts.txt
+void lua_scripts::profile_info(ExpandingString &str)
+{
+    profiler.info(str);
+}
+#endif
+
 #endif  // AP_SCRIPTING_ENABLED
@@ -28,13 +28,15 @@
 #include <AP_HAL/Semaphores.h>
 #include <AP_MultiHeap/AP_MultiHeap.h>
 #include "lua_common_defs.h"
+#include "lua_profiler.h"
 
 #include "lua/src/lua.hpp"
 
 class lua_scripts
 {
 public:
-    lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size, AP_Int8 &debug_options);
+    // vm is the number of the VM, scripts are run in the VM named in their header
+    lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size, AP_Int8 &debug_options, const AP_Int16 &gc_budget_us, uint8_t vm);
 
     ~lua_scripts();
 
@@ -46,10 +48,19 @@ public:
     // run scripts, does not return unless an error occured
     void run(void);
 
-    static bool overtime; // script exceeded it's execution slot, and we are bailing out
-
 private:
 
+    bool overtime; // script exceeded it's execution slot, and we are bailing out
+
+    // the VM running the Lua state, stored in the extra space of the state
+    static lua_scripts *instance(lua_State *L) { return *(lua_scripts **)lua_getextraspace(L); }
+
+#if AP_SCRIPTING_MULTI_VM_ENABLED
+    // number of the VM to run a script in, from the header of the script
+    static uint8_t script_vm(const char *filename);
+#endif
+    const uint8_t _vm;
+
     void create_sandbox(lua_State *L);
 
     typedef struct script_info {
@@ -57,6 +68,9 @@ private:
        int run_ref;          // reference to the function to run
        uint64_t next_run_ms; // time (in milliseconds) the script should next be run at
        uint32_t crc;         // crc32 checksum
+#if AP_SCRIPTING_EVENTS_ENABLED
+       uint8_t wake_events;  // AP_Scripting::Event mask that run the script before next_run_ms
+#endif
        char *name;           // filename for the script // FIXME: This information should be available from Lua
        script_info *next;
     } script_info;
@@ -76,17 +90,33 @@ private:
 
     script_info *scripts; // linked list of scripts to be run, sorted by next run time (soonest first)
 
+#if AP_SCRIPTING_EVENTS_ENABLED
+    script_info *running_script; // script being run, for wake_on
+
+    // sleep for up to timeout_ms, returning early if an event wakes a script
+    void wait_for_event(uint32_t timeout_ms);
+
+    // events from signal_event(), protected by event_sem
+    static HAL_Semaphore event_sem;
+    static lua_scripts *event_vms; // list of running VMs
+    lua_scripts *next_event_vm;
+    uint8_t wanted_events;  // events a script in this VM is waiting for
+    uint8_t pending_events; // events since this VM last woke
+    HAL_BinarySemaphore wake_sem;
+#endif
+
     // hook will be run when CPU time for a script is exceeded
     // it must be static to be passed to the C API
     static void hook(lua_State *L, lua_Debug *ar);
 
     // lua panic handler, will jump back to the start of run
     static int atpanic(lua_State *L);
-    static jmp_buf panic_jmp;
+    jmp_buf panic_jmp;
 
     lua_State *lua_state;
 
     const AP_Int32 & _vm_steps;
+    const AP_Int16 & _gc_budget_us;
     AP_Int8 & _debug_options;
 
     bool option_is_set(AP_Scripting::DebugOption option) const {
@@ -95,10 +125,16 @@ private:
 
     static void *alloc(void *ud, void *ptr, size_t osize, size_t nsize);
 
-    static MultiHeap _heap;
+    MultiHeap _heap;
+
+    // environment of the running script, for require
+    int current_env_ref;
 
     // helper for print and log of runtime stats
-    void update_stats(const char *name, uint32_t run_time, int total_mem, int run_mem);
+    void update_stats(const char *name, uint32_t run_time, int total_mem, int run_mem, uint32_t gc_time);
+
+    // run the garbage collector within SCR_GC_BUDGET
+    void collect_garbage(lua_State *L);
 
     // must be static for use in atpanic
     static void print_error(MAV_SEVERITY severity);
@@ -112,6 +148,14 @@ private:
     static uint32_t running_checksum;
     static HAL_Semaphore crc_sem;
 
+#if AP_SCRIPTING_PROFILER_ENABLED
+    // shared by all VMs so they are written to one file
+    static lua_profiler profiler;
+    lua_profiler::session profile_session;
+    int32_t profile_steps_remaining; // instructions left in the run of a script being profiled
+    uint32_t last_profile_write_ms;
+#endif
+
 public:
     // must be static for use in atpanic, public to allow bindings to issue none fatal warnings
     static void set_and_print_new_error_message(MAV_SEVERITY severity, const char *fmt, ...) FMT_PRINTF(2,3);
@@ -126,6 +170,21 @@ public:
     static uint32_t get_loaded_checksum();
     static uint32_t get_running_checksum();
 
+    // environment of the script running in the state, for require
+    static int get_current_env_ref(lua_State *L) { return instance(L)->current_env_ref; }
+
+#if AP_SCRIPTING_EVENTS_ENABLED
+    // set the events that wake the running script early, false if no script is running
+    static bool set_wake_events(lua_State *L, uint8_t events);
+
+    // wake the scripts waiting for any of the events, may be called from any thread
+    static void signal_event(uint8_t events);
+#endif
+
+#if AP_SCRIPTING_PROFILER_ENABLED
+    static void profile_info(ExpandingString &str);
+#endif
+
 };
 
 #endif  // AP_SCRIPTING_ENABLED
@@ -63,6 +63,85 @@ function test_uint64()
   return pass
 end
 
+function test_reuse()
+  local pass = true
+
+  -- methods returning userdata fill in the one passed rather than allocating
+  local home = Location()
+  pass = pass and rawequal(ahrs:get_home(home), home)
+  pass = pass and ahrs:get_home():lat() == home:lat()
+
+  local gyro = Vector3f()
+  pass = pass and rawequal(ahrs:get_gyro(gyro), gyro)
+
+  local loc = Location()
+  local pos = ahrs:get_location(loc)
+  pass = pass and ((pos == nil) or rawequal(pos, loc))
+
+  if not pass then
+    gcs:send_text(0, "Failed reuse test")
+  end
+
+  return pass
+end
+
+function test_parameter_set()
+  local pass = true
+
+  local params = ParameterSet({'SCR_ENABLE', 'SCR_HEAP_SIZE'})
+  local enable, heap_size = params:get()
+  pass = pass and enable == param:get('SCR_ENABLE')
+  pass = pass and heap_size == param:get('SCR_HEAP_SIZE')
+  pass = pass and params:changed() == uint32_t(0)
+
+  if not pass then
+    gcs:send_text(0, "Failed parameter set test")
+  end
+
+  return pass
+end
+
+function test_point_array()
+  local pass = true
+
+  -- a 10m square
+  local square = PointArray(4)
+  pass = pass and square:load({0, 0, 0, 10, 0, 0, 10, 10, 0, 0, 10, 0}) == 4
+  pass = pass and square:inside(5, 5)
+  pass = pass and not square:inside(15, 5)
+
+  local points = PointArray(3)
+  points:set(1, 1, 1)
+  points:set(2, 20, 1)
+  points:set(3, 9, 9, -5)
+  pass = pass and points:count_inside(square) == 2
+  pass = pass and points:count_within(0, 0, 0, 2) == 1
+
+  points:offset(-1, -1, 0)
+  local x, y, z = points:get(1)
+  pass = pass and x == 0 and y == 0 and z == 0
+
+  local index, distance = points:closest(19, 0, 0)
+  pass = pass and index == 2 and distance == 0
+
+  if not pass then
+    gcs:send_text(0, "Failed point array test")
+  end
+
+  return pass
+end
+
+function test_wake_on()
+  local pass = scripting:wake_on(scripting.EVENT_MODE | scripting.EVENT_MAVLINK)
+  pass = scripting:wake_on(0) and pass
+
+  if not pass then
+    gcs:send_text(0, "Failed wake on test")
+  end
+
+  return pass
+end
+
 function update()
   local all_tests_passed = true
   local require_test_local = require('test/nested')
@@ -82,6 +161,10 @@ function update()
   -- each test should run then and it's result with the previous ones
   all_tests_passed = test_offset(500, 200) and all_tests_passed
   all_tests_passed = test_uint64() and all_tests_passed
+  all_tests_passed = test_reuse() and all_tests_passed
+  all_tests_passed = test_parameter_set() and all_tests_passed
+  all_tests_passed = test_point_array() and all_tests_passed
+  all_tests_passed = test_wake_on() and all_tests_passed
 
   if all_tests_passed then
     gcs:send_text(3, "Internal tests passed")
@@ -64,6 +64,10 @@
 #define AP_SERIALMANAGER_IMUOUT_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL) && AP_INERTIALSENSOR_ENABLED
 #endif
 
+#ifndef AP_SERIALMANAGER_IMU_STREAM_ENABLED
+#define AP_SERIALMANAGER_IMU_STREAM_ENABLED (HAL_PROGRAM_SIZE_LIMIT_KB > 1024) && AP_INERTIALSENSOR_ENABLED
+#endif
+
 // serial ports registered by AP_Networking will use IDs starting at 21 for the first port
 #define AP_SERIALMANAGER_NET_PORT_1         21 // NET_P1_*
 
@@ -135,6 +139,11 @@
 #define AP_SERIALMANAGER_IMUOUT_BUFSIZE_RX     128
 #define AP_SERIALMANAGER_IMUOUT_BUFSIZE_TX     2048
 
+// IMU batch sampler stream
+#define AP_SERIALMANAGER_IMU_STREAM_BAUD        921600
+#define AP_SERIALMANAGER_IMU_STREAM_BUFSIZE_RX  64
+#define AP_SERIALMANAGER_IMU_STREAM_BUFSIZE_TX  4096
+
 // PPP protocol
 #define AP_SERIALMANAGER_PPP_BAUD           921600
 #define AP_SERIALMANAGER_PPP_BUFSIZE_RX     4096
@@ -31,7 +31,7 @@ const AP_Param::GroupInfo AP_SmartRTL::var_info[] = {
     // @Param: POINTS
     // @DisplayName: SmartRTL maximum number of points on path
     // @Description: SmartRTL maximum number of points on path. Set to 0 to disable SmartRTL.  100 points consumes about 3k of memory.
-    // @Range: 0 500
+    // @Range: 0 1000
     // @User: Advanced
     // @RebootRequired: True
     AP_GROUPINFO("POINTS", 1, AP_SmartRTL, _points_max, SMARTRTL_POINTS_DEFAULT),
@@ -67,6 +67,10 @@ const AP_Param::GroupInfo AP_SmartRTL::var_info[] = {
 *    2. Simplification uses the Ramer-Douglas-Peucker algorithm. See Wikipedia
 *    for a more complete description.
 *
+*    Both algorithms only check points added since they last completed.  Pruning
+*    keeps a grid of the path's segments so that each new segment is only compared
+*    with the segments near it instead of with the whole path.
+*
 *    The simplification and pruning algorithms run in the background and do not
 *    alter the path in memory.  Two definitions, SMARTRTL_SIMPLIFY_TIME_US and
 *    SMARTRTL_PRUNING_LOOP_TIME_US are used to limit how long each algorithm will
@@ -115,15 +119,29 @@ void AP_SmartRTL::init()
     _simplify.stack_max = _points_max * SMARTRTL_SIMPLIFY_STACK_LEN_MULT;
     _simplify.stack = (simplify_start_finish_t*)calloc(_simplify.stack_max, sizeof(simplify_start_finish_t));
 
+    // grid for pruning with roughly one bucket for every two points
+    _prune.grid_buckets = SMARTRTL_PRUNING_GRID_BUCKETS_MIN;
+    while ((_prune.grid_buckets < SMARTRTL_PRUNING_GRID_BUCKETS_MAX) && (_prune.grid_buckets * 2 < _points_max)) {
+        _prune.grid_buckets *= 2;
+    }
+    _prune.grid_head = (uint16_t*)calloc(_prune.grid_buckets, sizeof(uint16_t));
+    _prune.grid_next = (uint16_t*)calloc(_points_max, sizeof(uint16_t));
+
     // check if memory allocation failed
-    if (_path == nullptr || _prune.loops == nullptr || _simplify.stack == nullptr) {
+    if (_path == nullptr || _prune.loops == nullptr || _simplify.stack == nullptr || _prune.grid_head == nullptr || _prune.grid_next == nullptr) {
         log_action(Action::DEACTIVATED_INIT_FAILED);
         GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "SmartRTL deactivated: init failed");
         free(_path);
         free(_prune.loops);
         free(_simplify.stack);
+        free(_prune.grid_head);
+        free(_prune.grid_next);
+        _path = nullptr;
+        _prune.grid_head = nullptr;
+        _prune.grid_next = nullptr;
         return;
     }
+    prune_grid_reset();
 
     _path_points_max = _points_max;
 
@@ -431,6 +449,10 @@ void AP_SmartRTL::routine_cleanup(uint16_t path_points_count, uint16_t path_poin
     if (_prune.path_points_completed > path_points_completed_limit) {
         _prune.path_points_completed = path_points_completed_limit;
     }
+    if (_prune.grid_count >= path_points_completed_limit) {
+        // segments ending at popped points are no longer valid
+        prune_grid_reset();
+    }
 
     // calculate the number of points we could simplify
     const uint16_t points_to_simplify = (path_points_count > _simplify.path_points_completed) ? (path_points_count - _simplify.path_points_completed) : 0 ;
@@ -562,6 +584,7 @@ void AP_SmartRTL::detect_simplifications()
 *   This method runs for the allotted time, and detects loops in a path. Any detected loops are added to _prune.loops,
 *   this function does not alter the path in memory. It works by comparing the line segment between any two sequential points
 *   to the line segment between any other two sequential points. If they get close enough, anything between them could be pruned.
+*   Only segments in grid cells near the segment being checked are compared.
 *
 *   reset_pruning should have been called at least once before this function is called to setup the indexes (_prune.i, etc)
 */
@@ -573,38 +596,50 @@ void AP_SmartRTL::detect_loops()
         return;
     }
 
+    // segments must be re-added to the grid if the accuracy parameter has changed
+    if (!is_equal(_prune.grid_cell_size, (float)SMARTRTL_PRUNING_GRID_CELL_SIZE)) {
+        prune_grid_reset();
+    }
+    if (!is_positive(_prune.grid_cell_size)) {
+        // no loops can be found with zero accuracy
+        _prune.complete = true;
+        return;
+    }
+
     // capture start time
     const uint32_t start_time_us = AP_HAL::micros();
 
     // run for defined amount of time
     while (AP_HAL::micros() - start_time_us < SMARTRTL_PRUNING_LOOP_TIME_US) {
 
-        // advance inner loop
-        _prune.j++;
-        if (_prune.j > _prune.i - 2) {
-            // set inner loop back to first point
-            _prune.j = 1;
-            // reduce outer loop
-            _prune.i--;
-            // complete when outer loop has run out of new points to check
-            if (_prune.i < 4 || _prune.i < _prune.path_points_completed) {
-                _prune.complete = true;
-                _prune.path_points_completed = _prune.path_points_count;
-                return;
-            }
+        // add segments to the grid until it holds all segments to be checked
+        if (_prune.grid_count < _prune.path_points_count - 1) {
+            prune_grid_add(++_prune.grid_count);
+            continue;
         }
 
-        // find the closest distance between two line segments and the mid-point
-        dist_point dp = segment_segment_dist(_path[_prune.i], _path[_prune.i-1], _path[_prune.j-1], _path[_prune.j]);
-        if (dp.distance < SMARTRTL_PRUNING_DELTA) {
+        // complete when we have run out of new segments to check
+        if (_prune.i < 3 || _prune.i < _prune.path_points_completed) {
+            _prune.complete = true;
+            _prune.path_points_completed = _prune.path_points_count;
+            return;
+        }
+
+        // find the earliest segment that comes close to this one and the mid-point
+        uint16_t loop_start;
+        Vector3f midpoint;
+        if (prune_grid_find_loop(_prune.i, loop_start, midpoint)) {
             // if there is a loop here, add to loop array
-            if (!add_loop(_prune.j, _prune.i-1, dp.midpoint)) {
+            if (!add_loop(loop_start, _prune.i-1, midpoint)) {
                 // if the buffer is full, stop trying to prune
                 _prune.complete = true;
+                _prune.path_points_completed = _prune.path_points_count;
+                return;
             }
-            // set inner loop forward to trigger outer loop move to next segment
-            _prune.j = _prune.i;
         }
+
+        // move to previous segment
+        _prune.i--;
     }
 }
 
@@ -649,8 +684,12 @@ void AP_SmartRTL::restart_pruning(uint16_t path_points_count)
 {
     _prune.complete = false;
     _prune.i = (path_points_count > 0) ? path_points_count - 1 : 0;
-    _prune.j = 0;
     _prune.path_points_count = path_points_count;
+
+    // the grid must not hold segments beyond the end of the path
+    if (_prune.grid_count > _prune.i) {
+        prune_grid_reset();
+    }
 }
 
 // reset pruning algorithm so that it will re-check all points in the path
@@ -659,6 +698,7 @@ void AP_SmartRTL::reset_pruning()
     restart_pruning(0);
     _prune.loops_count = 0; // clear the loops that we've recorded
     _prune.path_points_completed = 0;
+    prune_grid_reset();
 }
 
 // remove all simplify-able points from the path
@@ -755,6 +795,9 @@ bool AP_SmartRTL::remove_points_by_loops(uint16_t num_points_to_remove)
     }
 
     _path_sem.give();
+
+    // segments after the removed loops have moved so must be re-added to the grid
+    prune_grid_reset();
     return true;
 }
 
@@ -900,6 +943,104 @@ bool AP_SmartRTL::loops_overlap(const prune_loop_t &loop1, const prune_loop_t &l
     return false;
 }
 
+// remove all segments from the pruning grid
+void AP_SmartRTL::prune_grid_reset()
+{
+    if (_prune.grid_head == nullptr) {
+        return;
+    }
+    for (uint16_t i = 0; i < _prune.grid_buckets; i++) {
+        _prune.grid_head[i] = SMARTRTL_PRUNING_GRID_NONE;
+    }
+    _prune.grid_long_head = SMARTRTL_PRUNING_GRID_NONE;
+    _prune.grid_count = 0;
+    _prune.grid_cell_size = SMARTRTL_PRUNING_GRID_CELL_SIZE;
+}
+
+// get the horizontal pruning grid cell holding a position
+void AP_SmartRTL::prune_grid_cell(const Vector3f& pos, int32_t &cell_x, int32_t &cell_y) const
+{
+    cell_x = (int32_t)floorf(pos.x / _prune.grid_cell_size);
+    cell_y = (int32_t)floorf(pos.y / _prune.grid_cell_size);
+}
+
+// get the bucket a pruning grid cell is held in
+uint16_t AP_SmartRTL::prune_grid_bucket(int32_t cell_x, int32_t cell_y) const
+{
+    const uint32_t hash = ((uint32_t)cell_x * 73856093U) ^ ((uint32_t)cell_y * 19349663U);
+    return hash & (_prune.grid_buckets - 1);
+}
+
+// add the segment ending at point "segment" to the pruning grid
+void AP_SmartRTL::prune_grid_add(uint16_t segment)
+{
+    const Vector3f& p1 = _path[segment-1];
+    const Vector3f& p2 = _path[segment];
+    const Vector3f midpoint = (p1 + p2) * 0.5f;
+
+    // a segment can only be found from its midpoint's cell if all of it is within one cell width of that midpoint
+    uint16_t *head = &_prune.grid_long_head;
+    if (midpoint.xy().distance_to(p1.xy()) + SMARTRTL_PRUNING_DELTA <= _prune.grid_cell_size) {
+        int32_t cell_x, cell_y;
+        prune_grid_cell(midpoint, cell_x, cell_y);
+        head = &_prune.grid_head[prune_grid_bucket(cell_x, cell_y)];
+    }
+    _prune.grid_next[segment] = *head;
+    *head = segment;
+}
+
+// find the earliest segment, which does not touch "segment", that comes within SMARTRTL_PRUNING_DELTA of it
+// returns true on success and fills in the segment found and the point midway between the two segments
+bool AP_SmartRTL::prune_grid_find_loop(uint16_t segment, uint16_t &loop_start, Vector3f &midpoint) const
+{
+    uint16_t closest = SMARTRTL_PRUNING_GRID_NONE;
+
+    // long segments are always checked
+    prune_grid_check_list(_prune.grid_long_head, segment, closest, midpoint);
+
+    // the midpoint of any other segment close to this one is within one cell width of this segment's bounding box
+    const Vector3f& p1 = _path[segment-1];
+    const Vector3f& p2 = _path[segment];
+    int32_t min_x, min_y, max_x, max_y;
+    prune_grid_cell(Vector3f{MIN(p1.x, p2.x) - _prune.grid_cell_size, MIN(p1.y, p2.y) - _prune.grid_cell_size, 0.0f}, min_x, min_y);
+    prune_grid_cell(Vector3f{MAX(p1.x, p2.x) + _prune.grid_cell_size, MAX(p1.y, p2.y) + _prune.grid_cell_size, 0.0f}, max_x, max_y);
+    if ((int64_t)(max_x - min_x + 1) * (max_y - min_y + 1) > _prune.grid_buckets) {
+        // searching the cells would visit every bucket so check every bucket once
+        for (uint16_t i = 0; i < _prune.grid_buckets; i++) {
+            prune_grid_check_list(_prune.grid_head[i], segment, closest, midpoint);
+        }
+    } else {
+        for (int32_t x = min_x; x <= max_x; x++) {
+            for (int32_t y = min_y; y <= max_y; y++) {
+                prune_grid_check_list(_prune.grid_head[prune_grid_bucket(x, y)], segment, closest, midpoint);
+            }
+        }
+    }
+
+    if (closest == SMARTRTL_PRUNING_GRID_NONE) {
+        return false;
+    }
+    loop_start = closest;
+    return true;
+}
+
+// check the segments in the list starting at "index" against "segment", updating closest and midpoint
+void AP_SmartRTL::prune_grid_check_list(uint16_t index, uint16_t segment, uint16_t &closest, Vector3f &midpoint) const
+{
+    for (; index != SMARTRTL_PRUNING_GRID_NONE; index = _prune.grid_next[index]) {
+        // never compare consecutive segments and only look for segments earlier than the closest found so far
+        // because the earliest segment gives the longest loop
+        if ((index + 2 > segment) || (index >= closest)) {
+            continue;
+        }
+        const dist_point dp = segment_segment_dist(_path[segment], _path[segment-1], _path[index-1], _path[index]);
+        if (dp.distance < SMARTRTL_PRUNING_DELTA) {
+            closest = index;
+            midpoint = dp.midpoint;
+        }
+    }
+}
+
 // returns true if pilot's yaw input should be used to adjust vehicle's heading
 bool AP_SmartRTL::use_pilot_yaw(void) const
 {
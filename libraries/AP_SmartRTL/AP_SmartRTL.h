@@ -8,7 +8,7 @@
 // definitions and macros
 #define SMARTRTL_ACCURACY_DEFAULT        2.0f   // default _ACCURACY parameter value.  Points will be no closer than this distance (in meters) together.
 #define SMARTRTL_POINTS_DEFAULT          300    // default _POINTS parameter value.  High numbers improve path pruning but use more memory and CPU for cleanup. Memory used will be 20bytes * this number.
-#define SMARTRTL_POINTS_MAX              500    // the absolute maximum number of points this library can support.
+#define SMARTRTL_POINTS_MAX              1000   // the absolute maximum number of points this library can support.
 #define SMARTRTL_TIMEOUT                 15000  // the time in milliseconds with no points saved to the path (for whatever reason), before SmartRTL is disabled for the flight
 #define SMARTRTL_CLEANUP_POINT_TRIGGER   50     // simplification will trigger when this many points are added to the path
 #define SMARTRTL_CLEANUP_START_MARGIN    10     // routine cleanup algorithms begin when the path array has only this many empty slots remaining
@@ -21,6 +21,10 @@
 #define SMARTRTL_PRUNING_DELTA (_accuracy * 0.99)   // How many meters apart must two points be, such that we can assume that there is no obstacle between them.  must be smaller than _ACCURACY parameter
 #define SMARTRTL_PRUNING_LOOP_BUFFER_LEN_MULT 0.25f // pruning loop buffer size as compared to maximum number of points
 #define SMARTRTL_PRUNING_LOOP_TIME_US    200    // maximum time (in microseconds) that the loop finding algorithm will run before returning
+#define SMARTRTL_PRUNING_GRID_CELL_SIZE  (_accuracy * 5.0f)   // width (in meters) of the grid cells used to find path segments that may be close to each other
+#define SMARTRTL_PRUNING_GRID_BUCKETS_MIN 16    // minimum number of buckets in the pruning grid
+#define SMARTRTL_PRUNING_GRID_BUCKETS_MAX 512   // maximum number of buckets in the pruning grid
+#define SMARTRTL_PRUNING_GRID_NONE       UINT16_MAX // marks the end of a list of segments in the pruning grid
 
 class AP_SmartRTL {
 
@@ -231,13 +235,33 @@ private:
         bool complete;
         uint16_t path_points_count;  // copy of _path_points_count taken when the prune algorithm started
         uint16_t path_points_completed; // number of points in that path that have already been checked for loops and should be ignored
-        uint16_t i;     // loop search's outer loop index
-        uint16_t j;     // loop search's inner loop index
+        uint16_t i;     // loop search's index of the next segment to check
         prune_loop_t* loops;// the result of the pruning algorithm
         uint16_t loops_max; // maximum number of elements in the _prunable_loops array
         uint16_t loops_count;   // number of elements in the _prunable_loops array
+        uint16_t* grid_head;    // first segment in each bucket of the grid, SMARTRTL_PRUNING_GRID_NONE if empty
+        uint16_t* grid_next;    // next segment in the same bucket (or long segment list) for each segment
+        uint16_t grid_buckets;  // number of elements in the grid_head array, always a power of two
+        uint16_t grid_long_head;// first segment too long to be held in the bucket of its midpoint
+        uint16_t grid_count;    // segments ending at points 1 to grid_count have been added to the grid
+        float grid_cell_size;   // cell width (in meters) used when segments were added to the grid
     } _prune;
 
     // returns true if the two loops overlap (used within add_loop to determine which loops to keep or throw away)
     bool loops_overlap(const prune_loop_t& loop1, const prune_loop_t& loop2) const;
+
+    // spatial index of path segments used by detect_loops so that each new segment is only compared with segments near it
+    // segments are identified by the index of their end point and are held in the bucket of the grid cell containing their midpoint
+    // segments too long to be found this way are held in a separate list which is always checked
+    void prune_grid_reset();
+    void prune_grid_cell(const Vector3f& pos, int32_t &cell_x, int32_t &cell_y) const;
+    uint16_t prune_grid_bucket(int32_t cell_x, int32_t cell_y) const;
+    void prune_grid_add(uint16_t segment);
+
+    // find the earliest segment, which does not touch "segment", that comes within SMARTRTL_PRUNING_DELTA of it
+    // returns true on success and fills in the segment found and the point midway between the two segments
+    bool prune_grid_find_loop(uint16_t segment, uint16_t &loop_start, Vector3f &midpoint) const;
+
+    // check the segments in the list starting at "index" against "segment", updating closest and midpoint
+    void prune_grid_check_list(uint16_t index, uint16_t segment, uint16_t &closest, Vector3f &midpoint) const;
 };
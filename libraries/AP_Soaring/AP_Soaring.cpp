@@ -168,6 +168,13 @@ const AP_Param::GroupInfo SoaringController::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("THML_FLAP", 22, SoaringController, soar_thermal_flap, 0),
 
+    // @Param: THML_HYPS
+    // @DisplayName: Number of thermal hypotheses
+    // @Description: Number of thermal position estimates run in parallel when thermalling. The first is placed ahead of the aircraft and the others ahead and to either side. The estimate that best explains the measured climb rates is used for centring.
+    // @Range: 1 3
+    // @User: Advanced
+    AP_GROUPINFO("THML_HYPS", 23, SoaringController, thermal_hypotheses, 1),
+
     AP_GROUPEND
 };
 
@@ -261,19 +268,15 @@ void SoaringController::init_thermalling()
     float cov_q1 = powf(thermal_q1, 2); // Process noise for strength
     float cov_q2 = powf(thermal_q2, 2); // Process noise for position and radius
 
-    const float init_q[4] = {cov_q1,
-                             cov_q2,
-                             cov_q2,
-                             cov_q2};
-
-    const MatrixN<float,4> q{init_q};
+    const float q[4] = {cov_q1,
+                        cov_q2,
+                        cov_q2,
+                        cov_q2};
 
-    const float init_p[4] = {INITIAL_STRENGTH_COVARIANCE,
-                             INITIAL_RADIUS_COVARIANCE,
-                             INITIAL_POSITION_COVARIANCE,
-                             INITIAL_POSITION_COVARIANCE};
-
-    const MatrixN<float,4> p{init_p};
+    const float p[4] = {INITIAL_STRENGTH_COVARIANCE,
+                        INITIAL_RADIUS_COVARIANCE,
+                        INITIAL_POSITION_COVARIANCE,
+                        INITIAL_POSITION_COVARIANCE};
 
     Vector3f position;
 
@@ -282,16 +285,24 @@ void SoaringController::init_thermalling()
         return;
     }
 
-    // New state vector filter will be reset. Thermal location is placed in front of a/c
-    const float init_xr[4] = {_vario.get_trigger_value(),
-                              INITIAL_THERMAL_RADIUS,
-                              position.x + thermal_distance_ahead * cosf(_ahrs.get_yaw()),
-                              position.y + thermal_distance_ahead * sinf(_ahrs.get_yaw())};
-
-    const VectorN<float,4> xr{init_xr};
-
-    // Also reset covariance matrix p so filter is not affected by previous data
-    _ekf.reset(xr, p, q, r);
+    // New state vector filter will be reset. Thermal location is placed in front of a/c,
+    // with the other hypotheses ahead and to either side
+    _ekf_count = constrain_int16(thermal_hypotheses, 1, SOARING_MAX_THERMAL_HYPOTHESES);
+    _ekf_active = 0;
+    for (uint8_t i = 0; i < _ekf_count; i++) {
+        float bearing = _ahrs.get_yaw();
+        if (i > 0) {
+            bearing += radians(i % 2 == 1 ? THERMAL_HYPOTHESIS_OFFSET_DEG : -THERMAL_HYPOTHESIS_OFFSET_DEG);
+        }
+        const float xr[4] = {_vario.get_trigger_value(),
+                             INITIAL_THERMAL_RADIUS,
+                             position.x + thermal_distance_ahead * cosf(bearing),
+                             position.y + thermal_distance_ahead * sinf(bearing)};
+
+        // Also reset covariance matrix p so filter is not affected by previous data
+        _ekf[i].reset(xr, p, q, r);
+        _ekf_log_likelihood[i] = 0;
+    }
 
     _prev_update_time = AP_HAL::micros64();
     _thermal_start_time_us = AP_HAL::micros64();
@@ -299,8 +310,8 @@ void SoaringController::init_thermalling()
 
     _vario.reset_climb_filter(0.0);
 
-    _position_x_filter.reset(_ekf.X[2]);
-    _position_y_filter.reset(_ekf.X[3]);
+    _position_x_filter.reset(active_ekf().X[2]);
+    _position_y_filter.reset(active_ekf().X[3]);
 
     _exit_commanded = false;
 }
@@ -325,13 +336,20 @@ void SoaringController::update_thermalling()
         return;
     }
 
-    Vector3f wind_drift = _ahrs.wind_estimate()*deltaT*_vario.get_filtered_climb()/_ekf.X[0];
+    // update the filters
+    Vector3f hyp_drift[SOARING_MAX_THERMAL_HYPOTHESES];
+    for (uint8_t i = 0; i < _ekf_count; i++) {
+        hyp_drift[i] = _ahrs.wind_estimate()*deltaT*_vario.get_filtered_climb()/_ekf[i].X[0];
+        _ekf[i].update(_vario.reading, current_position.x, current_position.y, hyp_drift[i].x, hyp_drift[i].y);
+        _ekf_log_likelihood[i] += _ekf[i].get_log_likelihood();
+    }
 
-    // update the filter
-    _ekf.update(_vario.reading, current_position.x, current_position.y, wind_drift.x, wind_drift.y);
+    select_hypothesis();
 
-    
-    _thermalability = (_ekf.X[0]*expf(-powf(get_thermalling_radius()/_ekf.X[1], 2))) - _vario.get_exp_thermalling_sink();
+    const ExtendedKalmanFilter &ekf = active_ekf();
+    const Vector3f &wind_drift = hyp_drift[_ekf_active];
+
+    _thermalability = (ekf.X[0]*expf(-powf(get_thermalling_radius()/ekf.X[1], 2))) - _vario.get_exp_thermalling_sink();
 
     _prev_update_time = AP_HAL::micros64();
 
@@ -339,8 +357,8 @@ void SoaringController::update_thermalling()
     _position_x_filter.set_cutoff_frequency(1/(3*_vario.tau));
     _position_y_filter.set_cutoff_frequency(1/(3*_vario.tau));
 
-    _position_x_filter.apply(_ekf.X[2], deltaT);
-    _position_y_filter.apply(_ekf.X[3], deltaT);
+    _position_x_filter.apply(ekf.X[2], deltaT);
+    _position_y_filter.apply(ekf.X[3], deltaT);
 
 #if HAL_LOGGING_ENABLED
     // write log - save the data.
@@ -363,10 +381,10 @@ void SoaringController::update_thermalling()
     AP::logger().WriteStreaming("SOAR", "TimeUS,nettorate,x0,x1,x2,x3,north,east,alt,dx_w,dy_w,th", "Qfffffffffff",
                                            AP_HAL::micros64(),
                                            (double)_vario.reading,
-                                           (double)_ekf.X[0],
-                                           (double)_ekf.X[1],
-                                           (double)_ekf.X[2],
-                                           (double)_ekf.X[3],
+                                           (double)ekf.X[0],
+                                           (double)ekf.X[1],
+                                           (double)ekf.X[2],
+                                           (double)ekf.X[3],
                                            current_position.x,
                                            current_position.y,
                                            (double)_vario.alt,
@@ -376,10 +394,10 @@ void SoaringController::update_thermalling()
 #if HAL_SOARING_NVF_EKF_ENABLED
     auto const now_ms = AP_HAL::millis();
     if (now_ms - _prev_nvf_pub_time_ms > NVF_PUBLISHER_DELAY_MS) {
-        gcs().send_named_float("SOAREKFX0", (float)_ekf.X[0]);
-        gcs().send_named_float("SOAREKFX1", (float)_ekf.X[1]);
-        gcs().send_named_float("SOAREKFX2", (float)_ekf.X[2]);
-        gcs().send_named_float("SOAREKFX3", (float)_ekf.X[3]);
+        gcs().send_named_float("SOAREKFX0", (float)ekf.X[0]);
+        gcs().send_named_float("SOAREKFX1", (float)ekf.X[1]);
+        gcs().send_named_float("SOAREKFX2", (float)ekf.X[2]);
+        gcs().send_named_float("SOAREKFX3", (float)ekf.X[3]);
         _prev_nvf_pub_time_ms = now_ms;
     }
 
@@ -387,6 +405,29 @@ void SoaringController::update_thermalling()
 #endif
 }
 
+/*
+  use the thermal hypothesis that has best explained the climb rate
+  measurements since thermalling started
+ */
+void SoaringController::select_hypothesis()
+{
+    uint8_t best = _ekf_active;
+    for (uint8_t i = 0; i < _ekf_count; i++) {
+        if (_ekf_log_likelihood[i] > _ekf_log_likelihood[best]) {
+            best = i;
+        }
+    }
+    if (best == _ekf_active ||
+        _ekf_log_likelihood[best] - _ekf_log_likelihood[_ekf_active] < THERMAL_HYPOTHESIS_SWITCH_MARGIN) {
+        return;
+    }
+    _ekf_active = best;
+
+    // the smoothed position would otherwise take several circles to follow
+    _position_x_filter.reset(active_ekf().X[2]);
+    _position_y_filter.reset(active_ekf().X[3]);
+}
+
 void SoaringController::update_cruising()
 {
     // Calculate the optimal airspeed for the current conditions of wind along current direction,
@@ -501,7 +542,7 @@ bool SoaringController::check_drift(Vector2f prev_wp, Vector2f next_wp)
     }
 
     // Check against the estimated thermal.
-    Vector2f position(_ekf.X[2], _ekf.X[3]);
+    Vector2f position(active_ekf().X[2], active_ekf().X[3]);
 
     Vector2f start_pos(_thermal_start_pos.x, _thermal_start_pos.y);
 
@@ -22,11 +22,22 @@ static constexpr float INITIAL_THERMAL_RADIUS = 80.0;
 static constexpr float INITIAL_STRENGTH_COVARIANCE = 0.0049;
 static constexpr float INITIAL_RADIUS_COVARIANCE = 400.0;
 static constexpr float INITIAL_POSITION_COVARIANCE = 400.0;
+// bearing offset of the other thermal hypotheses from the aircraft heading
+static constexpr float THERMAL_HYPOTHESIS_OFFSET_DEG = 60.0;
+// log likelihood margin needed to switch thermal hypothesis
+static constexpr float THERMAL_HYPOTHESIS_SWITCH_MARGIN = 2.0;
 
 
 class SoaringController {
     Variometer::PolarParams _polarParams;
-    ExtendedKalmanFilter _ekf{};
+    // one filter per thermal position hypothesis
+    ExtendedKalmanFilter _ekf[SOARING_MAX_THERMAL_HYPOTHESES];
+    float _ekf_log_likelihood[SOARING_MAX_THERMAL_HYPOTHESES];
+    uint8_t _ekf_count;
+    uint8_t _ekf_active;
+
+    const ExtendedKalmanFilter &active_ekf() const { return _ekf[_ekf_active]; }
+    void select_hypothesis();
     class AP_TECS &_tecs;
     Variometer _vario;
     SpeedToFly _speedToFly;
@@ -79,6 +90,7 @@ protected:
     AP_Float soar_thermal_airspeed;
     AP_Float soar_cruise_airspeed;
     AP_Float soar_thermal_flap;
+    AP_Int8 thermal_hypotheses;
 
 public:
     SoaringController(class AP_TECS &tecs, const AP_FixedWing &parms);
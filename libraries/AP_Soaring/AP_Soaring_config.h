@@ -4,6 +4,11 @@
 #define HAL_SOARING_ENABLED 1
 #endif
 
+// maximum number of thermal position hypotheses tracked in parallel
+#ifndef SOARING_MAX_THERMAL_HYPOTHESES
+#define SOARING_MAX_THERMAL_HYPOTHESES 3
+#endif
+
 // Whether to publish named-value-float of the kalman filter thermal estimator.
 // This is used with the mavproxy_soar plugin.
 #ifndef HAL_SOARING_NVF_EKF_ENABLED
@@ -1,82 +1,111 @@
 #include "ExtendedKalmanFilter.h"
-#include "AP_Math/matrixN.h"
+#include <AP_Math/AP_Math.h>
 
 
-float ExtendedKalmanFilter::measurementpredandjacobian(VectorN<float,N> &A, float Px, float Py)
+float ExtendedKalmanFilter::measurementpredandjacobian(float A[N], float Px, float Py) const
 {
     // This function computes the Jacobian using equations from
     // analytical derivation of Gaussian updraft distribution
+    const float dx = X[2] - Px;
+    const float dy = X[3] - Py;
+    const float inv_r2 = 1.0f / sq(X[1]);
+    const float dist2 = sq(dx) + sq(dy);
     // This expression gets used lots
-    float expon = expf(- (powf(X[2]-Px, 2) + powf(X[3]-Py, 2)) / powf(X[1], 2));
+    const float expon = expf(-dist2 * inv_r2);
     // Expected measurement
-    float w = X[0] * expon;
+    const float w = X[0] * expon;
 
     // Elements of the Jacobian
     A[0] = expon;
-    A[1] = 2 * X[0] * ((powf(X[2]-Px,2) + powf(X[3]-Py,2)) / powf(X[1],3)) * expon;
-    A[2] = -2 * (X[0] * (X[2]-Px) / powf(X[1],2)) * expon;
-    A[3] = -2 * (X[0] * (X[3]-Py) / powf(X[1],2)) * expon;
+    A[1] = 2 * w * dist2 * inv_r2 / X[1];
+    A[2] = -2 * w * dx * inv_r2;
+    A[3] = -2 * w * dy * inv_r2;
     return w;
 }
 
 
-void ExtendedKalmanFilter::reset(const VectorN<float,N> &x, const MatrixN<float,N> &p, const MatrixN<float,N> q, float r)
+void ExtendedKalmanFilter::reset(const float x[N], const float p[N], const float q[N], float r)
 {
-    P = p;
-    X = x;
-    Q = q;
+    for (uint8_t i = 0; i < N; i++) {
+        X[i] = x[i];
+        Q[i] = q[i];
+        for (uint8_t j = i; j < N; j++) {
+            P[i][j] = 0;
+        }
+        P[i][i] = p[i];
+    }
     R = r;
+    _log_likelihood = 0;
 }
 
 
 void ExtendedKalmanFilter::update(float z, float Px, float Py, float driftX, float driftY)
 {
-    MatrixN<float,N> tempM;
-    VectorN<float,N> H;
-    VectorN<float,N> P12;
-    VectorN<float,N> K;
-    
-    // LINE 28
     // Estimate new state from old.
     X[2] += driftX;
     X[3] += driftY;
 
-    // LINE 33
     // Update the covariance matrix
     // P = A*ekf.P*A'+ekf.Q;
-    // We know A is identity so
-    // P = ekf.P+ekf.Q;
-    P += Q;
+    // We know A is identity and Q is diagonal so
+    for (uint8_t i = 0; i < N; i++) {
+        P[i][i] += Q[i];
+    }
 
     // What measurement do we expect to receive in the estimated
     // state
-    // LINE 37
     // [z1,H] = ekf.jacobian_h(x1);
-    float z1 = measurementpredandjacobian(H, Px, Py);
+    float H[N];
+    const float z1 = measurementpredandjacobian(H, Px, Py);
+
+    // P12 = P * H'; cross covariance, from the upper triangle
+    float P12[N];
+    for (uint8_t i = 0; i < N; i++) {
+        float sum = 0;
+        for (uint8_t j = 0; j < N; j++) {
+            sum += (i <= j ? P[i][j] : P[j][i]) * H[j];
+        }
+        P12[i] = sum;
+    }
+
+    // innovation variance S = H*P12 + ekf.R
+    float S = R;
+    for (uint8_t i = 0; i < N; i++) {
+        S += H[i] * P12[i];
+    }
+    if (!is_positive(S)) {
+        // only possible with a corrupt covariance, skip the measurement
+        return;
+    }
+    const float inv_S = 1.0f / S;
 
-    // LINE 40
-    // P12 = P * H';
-    P12.mult(P, H); //cross covariance 
-    
-    // LINE 41
     // Calculate the KALMAN GAIN
-    // K = P12 * inv(H*P12 + ekf.R);                     %Kalman filter gain
-    K = P12 * 1.0 / (H * P12 + R);
+    // K = P12 * inv(S);
+    float K[N];
+    for (uint8_t i = 0; i < N; i++) {
+        K[i] = P12[i] * inv_S;
+    }
 
     // Correct the state estimate using the measurement residual.
-    // LINE 44
     // X = x1 + K * (z - z1);
-    X += K * (z - z1);
+    const float innovation = z - z1;
+    for (uint8_t i = 0; i < N; i++) {
+        X[i] += K[i] * innovation;
+    }
 
     // Make sure X[1] stays positive.
-    X[1] = X[1]>40.0 ? X[1]: 40.0;
-
-    // Correct the covariance too.
-    // LINE 46
-    // NB should be altered to reflect Stengel
-    // P = P_predict - K * P12';
-    tempM.mult(K, P12);
-    P -= tempM;
-    
-    P.force_symmetry();
+    X[1] = MAX(X[1], 40.0f);
+
+    // Correct the covariance in Joseph form
+    // P = (I - K*H)*P*(I - K*H)' + K*R*K'
+    // which with P12 = P*H' expands to
+    // P = P - K*P12' - P12*K' + S*K*K'
+    // and keeps P symmetric and positive definite under rounding
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = i; j < N; j++) {
+            P[i][j] += S * K[i] * K[j] - K[i] * P12[j] - P12[i] * K[j];
+        }
+    }
+
+    _log_likelihood = -0.5f * (sq(innovation) * inv_S + logf(S));
 }
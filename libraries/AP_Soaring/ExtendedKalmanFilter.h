@@ -3,11 +3,15 @@ Extended Kalman Filter class by Sam Tabor, 2013.
 * http://diydrones.com/forum/topics/autonomous-soaring
 * Set up for identifying thermals of Gaussian form, but could be adapted to other
 * purposes by adapting the equations for the jacobians.
+*
+* The state is [strength, radius, north, east]. The process model is
+* identity plus wind drift and the process noise is diagonal, so the
+* filter is written out for this fixed size with no matrix temporaries.
 */
 
 #pragma once
 
-#include <AP_Math/matrixN.h>
+#include <stdint.h>
 
 class ExtendedKalmanFilter {
 public:
@@ -15,13 +19,23 @@ public:
 
     static constexpr const uint8_t N = 4;
 
-    VectorN<float,N> X;
-    MatrixN<float,N> P;
-    MatrixN<float,N> Q;
-    float R;
-    void reset(const VectorN<float,N> &x, const MatrixN<float,N> &p, const MatrixN<float,N> q, float r);
+    float X[N];
+
+    // reset the state, with diagonal initial covariance p and
+    // process noise q, and measurement noise r
+    void reset(const float x[N], const float p[N], const float q[N], float r);
     void update(float z, float Px, float Py, float driftX, float driftY);
 
+    // log likelihood of the last measurement, less a constant
+    float get_log_likelihood() const { return _log_likelihood; }
+
 private:
-    float measurementpredandjacobian(VectorN<float,N> &A, float Px, float Py);
+    // covariance, only the upper triangle is used
+    float P[N][N];
+    float Q[N];
+    float R;
+
+    float _log_likelihood;
+
+    float measurementpredandjacobian(float A[N], float Px, float Py) const;
 };
@@ -61,6 +61,7 @@ void AP_Stats::copy_variables_from_parameters()
 
 void AP_Stats::init()
 {
+    WITH_SEMAPHORE(sem);
     params.bootcount.set_and_save(params.bootcount+1);
 
     // initialise our variables from parameters:
@@ -70,6 +71,7 @@ void AP_Stats::init()
 
 void AP_Stats::flush()
 {
+    WITH_SEMAPHORE(sem);
     params.flttime.set_and_save_ifchanged(flttime);
     params.runtime.set_and_save_ifchanged(runtime);
     last_flush_ms = AP_HAL::millis();
@@ -77,8 +79,8 @@ void AP_Stats::flush()
 
 void AP_Stats::update_flighttime()
 {
+    WITH_SEMAPHORE(sem);
     if (_flying_ms) {
-        WITH_SEMAPHORE(sem);
         const uint32_t now = AP_HAL::millis();
         const uint32_t delta = (now - _flying_ms)/1000;
         flttime += delta;
@@ -88,6 +90,7 @@ void AP_Stats::update_flighttime()
 
 void AP_Stats::update_runtime()
 {
+    WITH_SEMAPHORE(sem);
     const uint32_t now = AP_HAL::millis();
     const uint32_t delta = (now - _last_runtime_ms)/1000;
     runtime += delta;
@@ -131,6 +134,9 @@ void AP_Stats::update()
 
 void AP_Stats::set_flying(const bool is_flying)
 {
+    // called from the main thread while update() may be running on a
+    // scheduler worker
+    WITH_SEMAPHORE(sem);
     if (is_flying) {
         if (!_flying_ms) {
             _flying_ms = AP_HAL::millis();
@@ -150,6 +156,7 @@ void AP_Stats::set_flying(const bool is_flying)
  */
 uint32_t AP_Stats::get_flight_time_s(void)
 {
+    WITH_SEMAPHORE(sem);
     update_flighttime();
     return flttime - flttime_boot;
 }
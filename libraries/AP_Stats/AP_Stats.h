@@ -33,6 +33,7 @@ public:
 
     // accessor for is_flying
     bool get_is_flying(void) const {
+        WITH_SEMAPHORE(sem);
         return _flying_ms != 0;
     }
 
@@ -67,7 +68,9 @@ private:
 
     void update_flighttime();
     void update_runtime();
-    HAL_Semaphore sem;
+    // taken by every accessor as update() may run on a scheduler
+    // worker thread
+    mutable HAL_Semaphore sem;
 };
 
 namespace AP {
@@ -137,6 +137,32 @@ bool AP_Terrain::height_amsl(const Location &loc, float &height, bool corrected)
     // find the grid
     const struct grid_block &grid = find_grid_cache(info).grid;
 
+    if (!interpolate_height(grid, info, height)) {
+        return false;
+    }
+
+    if (loc.lat == ahrs.get_home().lat &&
+        loc.lng == ahrs.get_home().lng) {
+        // remember home altitude as a special case
+        home_height = height;
+        home_loc = loc;
+        have_home_height = true;
+    }
+
+    if (corrected && have_reference_offset) {
+        height += reference_offset;
+    }
+    
+    return true;
+}
+
+
+/*
+  interpolate the height at info within grid, returning false if the
+  surrounding heights have not been loaded
+ */
+bool AP_Terrain::interpolate_height(const struct grid_block &grid, const struct grid_info &info, float &height)
+{
     /*
       note that we rely on the one square overlap to ensure these
       calculations don't go past the end of the arrays
@@ -164,26 +190,111 @@ bool AP_Terrain::height_amsl(const Location &loc, float &height, bool corrected)
     // grid_spacing is kept small enough
     const float avg1 = (1.0f-info.frac_x) * h00  + info.frac_x * h10;
     const float avg2 = (1.0f-info.frac_x) * h01  + info.frac_x * h11;
-    const float avg  = (1.0f-info.frac_y) * avg1 + info.frac_y * avg2;
+    height = (1.0f-info.frac_y) * avg1 + info.frac_y * avg2;
 
-    height = avg;
+    return true;
+}
 
-    if (loc.lat == ahrs.get_home().lat &&
-        loc.lng == ahrs.get_home().lng) {
-        // remember home altitude as a special case
-        home_height = height;
-        home_loc = loc;
-        have_home_height = true;
+/*
+  find terrain heights at intervals of spacing meters along a path,
+  starting at path[0]. Returns the number of heights filled in, which
+  stops at max_heights, the end of the path, or the first point
+  without terrain data.
+
+  Calling height_amsl() for each point costs a full grid lookup and
+  two longitude scale calculations per point. Here the points of
+  each segment are stepped in meters from the SW corner of the degree
+  square of the segment start, and the grid is only looked up again
+  when a point moves into a different grid block
+ */
+uint16_t AP_Terrain::height_amsl_path(const Location *path, uint8_t npoints, float spacing,
+                                      float *heights, uint16_t max_heights, bool corrected)
+{
+    if (!allocate() || npoints == 0 || max_heights == 0 ||
+        !is_positive(spacing) || grid_spacing <= 0) {
+        return 0;
     }
-
-    if (corrected && have_reference_offset) {
-        height += reference_offset;
+    if (npoints == 1) {
+        return height_amsl(path[0], heights[0], corrected) ? 1 : 0;
+    }
+
+    const float gspacing = grid_spacing;
+    // distance into the current segment of the next point
+    float dist = 0;
+    uint16_t count = 0;
+    for (uint8_t i=0; i<npoints-1; i++) {
+        const Location &start = path[i];
+        const Location &end = path[i+1];
+
+        struct grid_info info;
+        calculate_grid_info(start, info);
+        Location ref;
+        ref.lat = info.lat_degrees*10*1000*1000L;
+        ref.lng = info.lon_degrees*10*1000*1000L;
+
+        const Vector2f start_ofs = ref.get_distance_NE(start);
+        const Vector2f seg = ref.get_distance_NE(end) - start_ofs;
+        const float seg_length = seg.length();
+        const Vector2f dir = is_positive(seg_length) ? seg / seg_length : Vector2f();
+
+        const struct grid_block *grid = nullptr;
+        for (; dist <= seg_length; dist += spacing) {
+            if (count == max_heights) {
+                return count;
+            }
+            const Vector2f ofs = start_ofs + dir * dist;
+            const float t = is_positive(seg_length) ? dist / seg_length : 0;
+            const int32_t lat = start.lat + int32_t((end.lat - start.lat) * t);
+            const int32_t lng = start.lng + int32_t(Location::diff_longitude(end.lng, start.lng) * t);
+            const int8_t lat_degrees = (lat<0?(lat-9999999L):lat) / (10*1000*1000L);
+            const int16_t lon_degrees = (lng<0?(lng-9999999L):lng) / (10*1000*1000L);
+            float height;
+            if (ofs.x < 0 || ofs.y < 0 ||
+                lat_degrees != info.lat_degrees ||
+                lon_degrees != info.lon_degrees) {
+                // left the degree square, use the full calculation
+                Location loc = start;
+                loc.offset(dir.x * dist, dir.y * dist);
+                if (!height_amsl(loc, height, false)) {
+                    return count;
+                }
+                // the lookup may have replaced the grid we were using
+                grid = nullptr;
+            } else {
+                const uint32_t idx_x = ofs.x / gspacing;
+                const uint32_t idx_y = ofs.y / gspacing;
+                const uint16_t grid_idx_x = idx_x / TERRAIN_GRID_BLOCK_SPACING_X;
+                const uint16_t grid_idx_y = idx_y / TERRAIN_GRID_BLOCK_SPACING_Y;
+                if (grid == nullptr ||
+                    grid_idx_x != info.grid_idx_x ||
+                    grid_idx_y != info.grid_idx_y) {
+                    info.grid_idx_x = grid_idx_x;
+                    info.grid_idx_y = grid_idx_y;
+                    Location corner = ref;
+                    corner.offset(grid_idx_x * TERRAIN_GRID_BLOCK_SPACING_X * gspacing,
+                                  grid_idx_y * TERRAIN_GRID_BLOCK_SPACING_Y * gspacing);
+                    info.grid_lat = corner.lat;
+                    info.grid_lon = corner.lng;
+                    grid = &find_grid_cache(info).grid;
+                }
+                info.idx_x = idx_x % TERRAIN_GRID_BLOCK_SPACING_X;
+                info.idx_y = idx_y % TERRAIN_GRID_BLOCK_SPACING_Y;
+                info.frac_x = (ofs.x - idx_x * gspacing) / gspacing;
+                info.frac_y = (ofs.y - idx_y * gspacing) / gspacing;
+                if (!interpolate_height(*grid, info, height)) {
+                    return count;
+                }
+            }
+            if (corrected && have_reference_offset) {
+                height += reference_offset;
+            }
+            heights[count++] = height;
+        }
+        dist -= seg_length;
     }
-    
-    return true;
+    return count;
 }
 
-
 /* 
    find difference between home terrain height and the terrain
    height at the current location in meters. A positive result
@@ -332,21 +443,31 @@ float AP_Terrain::lookahead(float bearing, float distance, float climb_ratio)
         return 0;
     }
 
-    float climb = 0;
     float lookahead_estimate = 0;
 
-    // check for terrain at grid spacing intervals
-    while (distance > 0) {
-        loc.offset_bearing(bearing, grid_spacing);
-        climb += climb_ratio * grid_spacing;
-        distance -= grid_spacing;
-        float height;
-        if (height_amsl(loc, height)) {
-            float rise = (height - base_height) - climb;
+    // check for terrain at grid spacing intervals, a batch at a time
+    const float spacing = grid_spacing;
+    const uint16_t num_points = ceilf(distance / spacing);
+    uint16_t n = 0;
+    while (n < num_points) {
+        float heights[32];
+        Location path[2] { loc, loc };
+        path[0].offset_bearing(bearing, (n+1) * spacing);
+        // end half a step beyond the last point so rounding can't drop it
+        path[1].offset_bearing(bearing, (num_points + 0.5f) * spacing);
+        const uint16_t count = height_amsl_path(path, 2, spacing, heights, MIN(uint16_t(num_points - n), uint16_t(ARRAY_SIZE(heights))));
+        for (uint16_t i=0; i<count; i++) {
+            const float climb = climb_ratio * spacing * (n+i+1);
+            const float rise = (heights[i] - base_height) - climb;
             if (rise > lookahead_estimate) {
                 lookahead_estimate = rise;
             }
         }
+        n += count;
+        if (count < ARRAY_SIZE(heights) && n < num_points) {
+            // skip the point we have no data for
+            n++;
+        }
     }
 
     return lookahead_estimate;
@@ -394,6 +515,12 @@ void AP_Terrain::update(void)
         have_surrounding_tiles = false;
     }
 
+#if AP_TERRAIN_PREFETCH_ENABLED
+    if (pos_valid) {
+        prefetch_path(loc);
+    }
+#endif
+
     // update capabilities and status
     if (allocate()) {
         if (!pos_valid) {
@@ -504,6 +631,11 @@ bool AP_Terrain::allocate(void)
         return false;
     }
     cache_size = config_cache_size;
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    // the warm cache is optional, carry on without it if we are short
+    // of memory
+    warm_cache = (struct warm_block *)calloc(AP_TERRAIN_WARM_CACHE_SIZE, sizeof(warm_cache[0]));
+#endif
     return true;
 }
 
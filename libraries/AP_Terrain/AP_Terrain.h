@@ -23,6 +23,14 @@
 #include <AP_Param/AP_Param.h>
 #include <GCS_MAVLink/GCS_MAVLink.h>
 #include <AP_Logger/AP_Logger_config.h>
+#if AP_TERRAIN_MMAP_ENABLED || AP_TERRAIN_TILE_UPLOAD_ENABLED
+#include <AP_HAL/Semaphores.h>
+#endif
+
+#if AP_TERRAIN_TILE_UPLOAD_ENABLED
+class ExpandingString;
+struct TINF_DATA;
+#endif
 
 #define TERRAIN_DEBUG 0
 
@@ -125,6 +133,18 @@ public:
      */
     bool height_amsl(const Location &loc, float &height, bool corrected = true);
 
+    /*
+      find the terrain heights in meters above sea level at intervals
+      of spacing meters along a path of npoints locations, starting at
+      path[0]. This is much cheaper than calling height_amsl() for
+      each point.
+
+      returns the number of heights filled in, stopping at max_heights,
+      the end of the path or the first point without terrain data
+     */
+    uint16_t height_amsl_path(const Location *path, uint8_t npoints, float spacing,
+                              float *heights, uint16_t max_heights, bool corrected = true);
+
     /* 
        find difference between home terrain height and the terrain
        height at the current location in meters. A positive result
@@ -203,6 +223,11 @@ public:
      */
     void set_reference_location(void);
 
+#if AP_TERRAIN_TILE_UPLOAD_ENABLED
+    // report terrain status and uploaded tiles for @SYS/terrain.txt
+    void tile_upload_info(ExpandingString &str);
+#endif
+
 private:
     // allocate the terrain subsystem data
     bool allocate(void);
@@ -301,6 +326,9 @@ private:
     // given a location, fill a grid_info structure
     void calculate_grid_info(const Location &loc, struct grid_info &info) const;
 
+    // bilinear interpolation of the height at info within grid
+    bool interpolate_height(const struct grid_block &grid, const struct grid_info &info, float &height);
+
     /*
       find a grid structure given a grid_info
     */
@@ -349,10 +377,50 @@ private:
     uint32_t east_blocks(struct grid_block &block) const;
     void write_block(void);
     void read_block(void);
+    bool check_block(struct grid_block &block, int32_t lat, int32_t lon);
+
+#if AP_TERRAIN_TILE_UPLOAD_ENABLED
+    /*
+      uploaded tile install, run by the IO thread
+     */
+    enum class TileResult : uint8_t {
+        INSTALLING,
+        INSTALLED,
+        BAD_FORMAT,
+        BAD_BLOCK,
+        IO_ERROR,
+        POSTPONED,
+    };
+    struct tile_upload;
+    void tile_upload_update(void);
+    bool tile_upload_find(char *name);
+    void tile_upload_start(const char *name);
+    void tile_upload_step(void);
+    bool tile_upload_check_block(struct grid_block &block);
+    void tile_upload_install(void);
+    void tile_upload_finish(TileResult result);
+    void tile_upload_set_result(TileResult result);
+    static int tile_read_source(struct TINF_DATA *d);
+    // called from schedule_disk_io() once a tile has been installed
+    void tile_upload_reload(void);
+#endif
+
+#if AP_TERRAIN_MMAP_ENABLED
+    // map the open degree file if it is not already mapped with at
+    // least min_length bytes
+    void map_file(uint32_t min_length);
+    // fill in a block from a mapped degree file
+    bool mapped_read(struct grid_block &grid);
+#endif
 
     // check for missing data in squares surrounding loc:
     bool update_surrounding_tiles(const Location &loc);
 
+#if AP_TERRAIN_PREFETCH_ENABLED
+    // request grids ahead of the vehicle on its current path
+    void prefetch_path(const Location &loc);
+#endif
+
     /*
       check for missing mission terrain data
      */
@@ -385,6 +453,31 @@ private:
     uint8_t cache_size = 0;
     struct grid_cache *cache = nullptr;
 
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    /*
+      a grid_block evicted from the cache, with the heights delta
+      encoded. Only blocks that have been written to disk are kept, and
+      the index fields are filled in by find_grid_cache()
+     */
+    static const uint16_t warm_data_size = 1024;
+    struct warm_block {
+        uint64_t bitmap;
+        int32_t lat;
+        int32_t lon;
+        uint16_t spacing;
+        // length of data, zero when the slot is unused
+        uint16_t length;
+        uint32_t last_access_ms;
+        uint8_t data[warm_data_size];
+    };
+    struct warm_block *warm_cache = nullptr;
+
+    // keep a compressed copy of a block being evicted from the cache
+    void warm_store(const struct grid_block &grid);
+    // fill in the heights of grid from the warm cache if we have it
+    bool warm_load(struct grid_block &grid);
+#endif
+
     // a grid_cache block waiting for disk IO
     enum DiskIoState {
         DiskIoIdle      = 0,
@@ -406,6 +499,48 @@ private:
     // open file handle on degree file
     int fd;
 
+#if AP_TERRAIN_TILE_UPLOAD_ENABLED
+    // the install in progress, allocated only while installing
+    struct tile_upload *upload;
+    uint32_t last_tile_scan_ms;
+
+    // upload seen on the last scan, installed once its size is stable
+    char tile_scan_name[16];
+    uint32_t tile_scan_size;
+
+    // set by the IO thread when a degree file has been replaced, so
+    // the main thread re-reads blocks of that degree
+    volatile bool tile_installed;
+    int8_t tile_installed_lat;
+    int16_t tile_installed_lon;
+
+    // recent installs for @SYS/terrain.txt
+    struct tile_result {
+        char name[8];
+        TileResult result;
+        uint32_t blocks;
+        uint32_t full_blocks;
+    } tile_results[AP_TERRAIN_TILE_UPLOAD_RESULTS];
+    uint8_t tile_results_next;
+    HAL_Semaphore tile_results_sem;
+#endif
+
+#if AP_TERRAIN_MMAP_ENABLED
+    // degree files mapped into memory. These are setup by the IO
+    // thread and read by the main thread
+    struct mapped_file {
+        const uint8_t *base;
+        uint32_t length;
+        // descriptor the mapping was made from, which may since have
+        // been closed
+        int fd;
+        int16_t lon_degrees;
+        int8_t lat_degrees;
+        uint32_t last_use_ms;
+    } mapped_files[AP_TERRAIN_MMAP_MAX_FILES] {};
+    HAL_Semaphore mmap_sem;
+#endif
+
     // has the timer been setup?
     bool timer_setup;
 
@@ -6,3 +6,53 @@
 #ifndef AP_TERRAIN_AVAILABLE
 #define AP_TERRAIN_AVAILABLE AP_FILESYSTEM_FILE_READING_ENABLED
 #endif
+
+// map degree files into memory on systems with virtual memory so that
+// blocks missing from the cache can be read without waiting for IO
+#ifndef AP_TERRAIN_MMAP_ENABLED
+#define AP_TERRAIN_MMAP_ENABLED AP_TERRAIN_AVAILABLE && (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
+// number of degree files that can be mapped at once
+#ifndef AP_TERRAIN_MMAP_MAX_FILES
+#define AP_TERRAIN_MMAP_MAX_FILES 4
+#endif
+
+// keep a compressed copy of grid blocks evicted from the in-memory
+// cache so that returning to them does not need a disk read. Not
+// needed when the degree files are mapped
+#ifndef AP_TERRAIN_WARM_CACHE_ENABLED
+#define AP_TERRAIN_WARM_CACHE_ENABLED AP_TERRAIN_AVAILABLE && HAL_MEM_CLASS >= HAL_MEM_CLASS_500 && !AP_TERRAIN_MMAP_ENABLED
+#endif
+
+// number of compressed grid blocks, each about 1050 bytes
+#ifndef AP_TERRAIN_WARM_CACHE_SIZE
+#define AP_TERRAIN_WARM_CACHE_SIZE 16
+#endif
+
+// install gzip compressed degree files uploaded into the terrain
+// directory, for example with MAVLink FTP
+#ifndef AP_TERRAIN_TILE_UPLOAD_ENABLED
+#define AP_TERRAIN_TILE_UPLOAD_ENABLED AP_TERRAIN_AVAILABLE && AP_FILESYSTEM_FILE_WRITING_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#endif
+
+// number of tile installs reported in @SYS/terrain.txt
+#ifndef AP_TERRAIN_TILE_UPLOAD_RESULTS
+#define AP_TERRAIN_TILE_UPLOAD_RESULTS 8
+#endif
+
+// load the grid blocks ahead of the vehicle before they are needed
+#ifndef AP_TERRAIN_PREFETCH_ENABLED
+#define AP_TERRAIN_PREFETCH_ENABLED AP_TERRAIN_AVAILABLE
+#endif
+
+// how far ahead to prefetch, in seconds of flight at the current
+// ground speed
+#ifndef AP_TERRAIN_PREFETCH_TIME_S
+#define AP_TERRAIN_PREFETCH_TIME_S 30
+#endif
+
+// maximum number of grid blocks ahead to prefetch along each path
+#ifndef AP_TERRAIN_PREFETCH_MAX_BLOCKS
+#define AP_TERRAIN_PREFETCH_MAX_BLOCKS 3
+#endif
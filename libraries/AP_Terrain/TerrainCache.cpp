@@ -0,0 +1,164 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  compressed cache of grid blocks evicted from the main cache
+
+  Heights are stored as the difference from the previous height in the
+  row, with the first height of each row relative to the first height
+  of the row before. Differences that fit in a byte are stored as a
+  single signed byte, others as an escape byte followed by the full
+  16 bit height. Neighbouring terrain heights rarely differ by more
+  than 127m, so a block takes a little over half the memory of a
+  grid_cache entry.
+ */
+
+#include "AP_Terrain.h"
+
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+
+#include <AP_HAL/AP_HAL.h>
+
+#define WARM_ESCAPE 0x80
+
+/*
+  keep a compressed copy of a block being evicted from the cache
+ */
+void AP_Terrain::warm_store(const struct grid_block &grid)
+{
+    if (warm_cache == nullptr) {
+        return;
+    }
+
+    // replace an existing copy, else use a free slot or the least
+    // recently stored one
+    int16_t idx = -1;
+    for (uint16_t i=0; i<AP_TERRAIN_WARM_CACHE_SIZE; i++) {
+        const struct warm_block &w = warm_cache[i];
+        if (w.length != 0 &&
+            TERRAIN_LATLON_EQUAL(w.lat, grid.lat) &&
+            TERRAIN_LATLON_EQUAL(w.lon, grid.lon) &&
+            w.spacing == grid.spacing) {
+            idx = i;
+            break;
+        }
+    }
+    if (idx == -1) {
+        idx = 0;
+        for (uint16_t i=0; i<AP_TERRAIN_WARM_CACHE_SIZE; i++) {
+            if (warm_cache[i].length == 0) {
+                idx = i;
+                break;
+            }
+            if (warm_cache[i].last_access_ms < warm_cache[idx].last_access_ms) {
+                idx = i;
+            }
+        }
+    }
+    struct warm_block &w = warm_cache[idx];
+
+    uint16_t len = 0;
+    int16_t row_start = 0;
+    for (uint8_t x=0; x<TERRAIN_GRID_BLOCK_SIZE_X; x++) {
+        int16_t prev = row_start;
+        for (uint8_t y=0; y<TERRAIN_GRID_BLOCK_SIZE_Y; y++) {
+            const int16_t h = grid.height[x][y];
+            const int32_t delta = int32_t(h) - prev;
+            if (delta > -128 && delta < 128) {
+                if (len + 1 > warm_data_size) {
+                    w.length = 0;
+                    return;
+                }
+                w.data[len++] = uint8_t(int8_t(delta));
+            } else {
+                if (len + 3 > warm_data_size) {
+                    // too rough to compress, it will be read from disk
+                    w.length = 0;
+                    return;
+                }
+                w.data[len++] = WARM_ESCAPE;
+                w.data[len++] = uint16_t(h) & 0xFF;
+                w.data[len++] = uint16_t(h) >> 8;
+            }
+            prev = h;
+            if (y == 0) {
+                row_start = h;
+            }
+        }
+    }
+
+    w.bitmap = grid.bitmap;
+    w.lat = grid.lat;
+    w.lon = grid.lon;
+    w.spacing = grid.spacing;
+    w.last_access_ms = AP_HAL::millis();
+    w.length = len;
+}
+
+/*
+  fill in the heights of grid from the warm cache. The slot is freed
+  as the block will be stored again when it is next evicted
+ */
+bool AP_Terrain::warm_load(struct grid_block &grid)
+{
+    if (warm_cache == nullptr) {
+        return false;
+    }
+
+    for (uint16_t i=0; i<AP_TERRAIN_WARM_CACHE_SIZE; i++) {
+        struct warm_block &w = warm_cache[i];
+        if (w.length == 0 ||
+            !TERRAIN_LATLON_EQUAL(w.lat, grid.lat) ||
+            !TERRAIN_LATLON_EQUAL(w.lon, grid.lon) ||
+            w.spacing != grid.spacing) {
+            continue;
+        }
+
+        uint16_t ofs = 0;
+        int16_t row_start = 0;
+        for (uint8_t x=0; x<TERRAIN_GRID_BLOCK_SIZE_X; x++) {
+            int16_t prev = row_start;
+            for (uint8_t y=0; y<TERRAIN_GRID_BLOCK_SIZE_Y; y++) {
+                if (ofs >= w.length) {
+                    w.length = 0;
+                    return false;
+                }
+                int16_t h;
+                if (w.data[ofs] == WARM_ESCAPE) {
+                    if (ofs + 3 > w.length) {
+                        w.length = 0;
+                        return false;
+                    }
+                    h = int16_t(w.data[ofs+1] | (uint16_t(w.data[ofs+2]) << 8));
+                    ofs += 3;
+                } else {
+                    h = prev + int8_t(w.data[ofs]);
+                    ofs++;
+                }
+                grid.height[x][y] = h;
+                prev = h;
+                if (y == 0) {
+                    row_start = h;
+                }
+            }
+        }
+
+        grid.bitmap = w.bitmap;
+        w.length = 0;
+        return true;
+    }
+    return false;
+}
+
+#endif // AP_TERRAIN_WARM_CACHE_ENABLED
@@ -72,6 +72,11 @@ void AP_Terrain::schedule_disk_io(void)
 
     switch (disk_io_state) {
     case DiskIoIdle:
+#if AP_TERRAIN_TILE_UPLOAD_ENABLED
+        if (tile_installed) {
+            tile_upload_reload();
+        }
+#endif
         // look for a block that needs reading or writing
         check_disk_read();
         if (disk_io_state == DiskIoIdle) {
@@ -212,6 +217,10 @@ void AP_Terrain::open_file(void)
 
     file_lat_degrees = block.lat_degrees;
     file_lon_degrees = block.lon_degrees;
+
+#if AP_TERRAIN_MMAP_ENABLED
+    map_file(0);
+#endif
 }
 
 /*
@@ -273,6 +282,11 @@ void AP_Terrain::write_block(void)
         io_failure = true;
     } else {
         AP::FS().fsync(fd);
+#if AP_TERRAIN_MMAP_ENABLED
+        // remap if the write extended the file
+        const uint32_t blocknum = east_blocks(disk_block.block) * disk_block.block.grid_idx_x + disk_block.block.grid_idx_y;
+        map_file((blocknum+1) * sizeof(union grid_io_block));
+#endif
 #if TERRAIN_DEBUG
         printf("wrote block at %ld %ld ret=%d mask=%07llx\n",
                (long)disk_block.block.lat,
@@ -284,6 +298,20 @@ void AP_Terrain::write_block(void)
     disk_io_state = DiskIoDoneWrite;
 }
 
+/*
+  check that a block read from disk is a valid block for lat/lon at
+  the current grid spacing
+ */
+bool AP_Terrain::check_block(struct grid_block &block, int32_t lat, int32_t lon)
+{
+    return TERRAIN_LATLON_EQUAL(block.lat,lat) &&
+        TERRAIN_LATLON_EQUAL(block.lon,lon) &&
+        block.bitmap != 0 &&
+        block.spacing == grid_spacing &&
+        block.version == TERRAIN_GRID_FORMAT_VERSION &&
+        block.crc == get_block_crc(block);
+}
+
 /*
   read in disk_block
  */
@@ -298,12 +326,7 @@ void AP_Terrain::read_block(void)
 
     ssize_t ret = AP::FS().read(fd, &disk_block, sizeof(disk_block));
     if (ret != sizeof(disk_block) || 
-        !TERRAIN_LATLON_EQUAL(disk_block.block.lat,lat) ||
-        !TERRAIN_LATLON_EQUAL(disk_block.block.lon,lon) ||
-        disk_block.block.bitmap == 0 ||
-        disk_block.block.spacing != grid_spacing ||
-        disk_block.block.version != TERRAIN_GRID_FORMAT_VERSION ||
-        disk_block.block.crc != get_block_crc(disk_block.block)) {
+        !check_block(disk_block.block, lat, lon)) {
 #if TERRAIN_DEBUG
         printf("read empty block at %ld %ld ret=%d (%ld %ld %u 0x%08lx) 0x%04x:0x%04x\n",
                (long)lat,
@@ -334,6 +357,97 @@ void AP_Terrain::read_block(void)
     disk_io_state = DiskIoDoneRead;
 }
 
+#if AP_TERRAIN_MMAP_ENABLED
+/*
+  map the open degree file into memory. Files only grow when we write
+  a block past the end, so an existing mapping of at least min_length
+  bytes is kept
+ */
+void AP_Terrain::map_file(uint32_t min_length)
+{
+    WITH_SEMAPHORE(mmap_sem);
+
+    // use the existing mapping of this file, else a free slot or the
+    // least recently used one
+    struct mapped_file *m = nullptr;
+    for (auto &f : mapped_files) {
+        if (f.base != nullptr &&
+            f.lat_degrees == file_lat_degrees &&
+            f.lon_degrees == file_lon_degrees) {
+            if (f.length >= min_length) {
+                return;
+            }
+            m = &f;
+            break;
+        }
+    }
+    if (m == nullptr) {
+        m = &mapped_files[0];
+        for (auto &f : mapped_files) {
+            if (f.base == nullptr) {
+                m = &f;
+                break;
+            }
+            if (f.last_use_ms < m->last_use_ms) {
+                m = &f;
+            }
+        }
+    }
+    if (m->base != nullptr) {
+        AP::FS().munmap(m->fd, m->base, m->length);
+        m->base = nullptr;
+    }
+
+    const int32_t length = AP::FS().lseek(fd, 0, SEEK_END);
+    if (length <= 0) {
+        // an empty new file, map it once we have written to it
+        return;
+    }
+    m->base = (const uint8_t *)AP::FS().mmap(fd, length);
+    if (m->base == nullptr) {
+        return;
+    }
+    m->length = length;
+    m->fd = fd;
+    m->lat_degrees = file_lat_degrees;
+    m->lon_degrees = file_lon_degrees;
+    m->last_use_ms = AP_HAL::millis();
+}
+
+/*
+  fill in a block from a mapped degree file. This runs in the main
+  thread when a block is missing from the cache. Returns false if the
+  file isn't mapped or doesn't reach the block, leaving the read to
+  the IO thread. As in read_block(), a bad block on disk is treated as
+  missing and grid is left empty
+ */
+bool AP_Terrain::mapped_read(struct grid_block &grid)
+{
+    const uint32_t blocknum = east_blocks(grid) * grid.grid_idx_x + grid.grid_idx_y;
+    const uint32_t file_offset = blocknum * sizeof(union grid_io_block);
+
+    WITH_SEMAPHORE(mmap_sem);
+    for (auto &m : mapped_files) {
+        if (m.base == nullptr ||
+            m.lat_degrees != grid.lat_degrees ||
+            m.lon_degrees != grid.lon_degrees) {
+            continue;
+        }
+        if (file_offset + sizeof(struct grid_block) > m.length) {
+            return false;
+        }
+        m.last_use_ms = AP_HAL::millis();
+        struct grid_block block;
+        memcpy(&block, &m.base[file_offset], sizeof(block));
+        if (check_block(block, grid.lat, grid.lon)) {
+            grid = block;
+        }
+        return true;
+    }
+    return false;
+}
+#endif // AP_TERRAIN_MMAP_ENABLED
+
 /*
   timer called to do disk IO
  */
@@ -351,6 +465,10 @@ void AP_Terrain::io_timer(void)
 
     update_reference_offset();
 
+#if AP_TERRAIN_TILE_UPLOAD_ENABLED
+    tile_upload_update();
+#endif
+
     switch (disk_io_state) {
     case DiskIoIdle:
     case DiskIoDoneRead:
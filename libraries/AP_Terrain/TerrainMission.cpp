@@ -26,6 +26,7 @@
 #include <AP_Mission/AP_Mission.h>
 #include <AP_Rally/AP_Rally.h>
 #include <AP_GPS/AP_GPS.h>
+#include <AP_AHRS/AP_AHRS.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -114,6 +115,72 @@ void AP_Terrain::update_mission_data(void)
 #endif  // AP_MISSION_ENABLED
 }
 
+#if AP_TERRAIN_PREFETCH_ENABLED
+/*
+  look up the grids ahead of the vehicle so they are read from disk,
+  or requested from the GCS, while we still have time to get them. We
+  look along the ground velocity vector and, when the next waypoint is
+  within reach, along the leg after it
+ */
+void AP_Terrain::prefetch_path(const Location &loc)
+{
+    const Vector2f vel = AP::ahrs().groundspeed_vector();
+    const float speed = vel.length();
+
+    // update_surrounding_tiles() already covers the block we are in
+    // and its neighbours, so only look further out than one block
+    const float block_size = MIN(TERRAIN_GRID_BLOCK_SPACING_X, TERRAIN_GRID_BLOCK_SPACING_Y) * float(grid_spacing);
+    const float lookahead = MIN(speed * AP_TERRAIN_PREFETCH_TIME_S,
+                                block_size * AP_TERRAIN_PREFETCH_MAX_BLOCKS);
+    if (!is_positive(block_size) || lookahead < block_size) {
+        return;
+    }
+
+    float height;
+    const Vector2f dir = vel / speed;
+    for (float dist = block_size; dist <= lookahead; dist += block_size) {
+        Location loc2 = loc;
+        loc2.offset(dir.x * dist, dir.y * dist);
+        height_amsl(loc2, height);
+    }
+
+#if AP_MISSION_ENABLED
+    AP_Mission *mission = AP::mission();
+    if (mission == nullptr || mission->state() != AP_Mission::MISSION_RUNNING) {
+        return;
+    }
+    const AP_Mission::Mission_Command &cmd = mission->get_current_nav_cmd();
+    const Location &wp = cmd.content.location;
+    if (wp.lat == 0 && wp.lng == 0) {
+        return;
+    }
+    const float wp_dist = loc.get_distance(wp);
+    if (wp_dist > lookahead) {
+        // the velocity vector covers the rest of this leg
+        return;
+    }
+    height_amsl(wp, height);
+
+    AP_Mission::Mission_Command next_cmd;
+    if (!mission->get_next_nav_cmd(cmd.index+1, next_cmd)) {
+        return;
+    }
+    const Location &next_wp = next_cmd.content.location;
+    if (next_wp.lat == 0 && next_wp.lng == 0) {
+        return;
+    }
+    const float bearing = degrees(wp.get_bearing(next_wp));
+    const float leg_length = wp.get_distance(next_wp);
+    const float remaining = MIN(MAX(lookahead - wp_dist, block_size), leg_length);
+    for (float dist = block_size; dist <= remaining; dist += block_size) {
+        Location loc2 = wp;
+        loc2.offset_bearing(bearing, dist);
+        height_amsl(loc2, height);
+    }
+#endif // AP_MISSION_ENABLED
+}
+#endif // AP_TERRAIN_PREFETCH_ENABLED
+
 #if HAL_RALLY_ENABLED
 /*
   check that we have fetched all rally terrain data
@@ -0,0 +1,495 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  install whole degree files uploaded to the terrain directory
+
+  A GCS can upload a gzip compressed degree file, for example
+  N35E149.DAT.gz made with "gzip -9 N35E149.DAT", into the terrain
+  directory using MAVLink FTP. Once the upload has stopped growing it
+  is decompressed a block at a time by the IO thread, every block is
+  checked, and if all are good the degree file is replaced. This is
+  much faster than filling the same area with TERRAIN_DATA messages.
+ */
+
+#include "AP_Terrain.h"
+
+#if AP_TERRAIN_TILE_UPLOAD_ENABLED
+
+#include <AP_Filesystem/AP_Filesystem.h>
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Common/ExpandingString.h>
+#include <AP_ROMFS/tinf.h>
+#include <GCS_MAVLink/GCS.h>
+#include <stdio.h>
+#include <ctype.h>
+
+extern const AP_HAL::HAL& hal;
+
+// time an upload must stop growing before we install it
+#define TILE_SCAN_INTERVAL_MS 5000
+
+// largest deflate window, as used by gzip -9
+#define TILE_DICT_SIZE 32768
+
+struct AP_Terrain::tile_upload {
+    // must be first, tile_read_source() casts back to tile_upload
+    TINF_DATA d;
+    int fd_in;
+    int fd_out;
+    // name of the upload, eg. N35E149.DAT.gz
+    char gz_name[16];
+    // degree file name, eg. N35E149
+    char name[8];
+    int8_t lat_degrees;
+    int16_t lon_degrees;
+    uint32_t blocks;
+    uint32_t full_blocks;
+    union grid_io_block block;
+    uint8_t in_buf[512];
+    uint8_t dict[TILE_DICT_SIZE];
+};
+
+/*
+  return a newly allocated path to a file in the terrain directory
+ */
+static char *tile_path(const char *name, const char *suffix)
+{
+    const char *terrain_dir = hal.util->get_custom_terrain_directory();
+    if (terrain_dir == nullptr) {
+        terrain_dir = HAL_BOARD_TERRAIN_DIRECTORY;
+    }
+    char *path = nullptr;
+    if (asprintf(&path, "%s/%s%s", terrain_dir, name, suffix) <= 0) {
+        return nullptr;
+    }
+    return path;
+}
+
+/*
+  skip the gzip header, see RFC1952
+ */
+static bool skip_gzip_header(TINF_DATA *d)
+{
+    if (uzlib_get_byte(d) != 0x1f ||
+        uzlib_get_byte(d) != 0x8b ||
+        uzlib_get_byte(d) != 8) {
+        return false;
+    }
+    const uint8_t flags = uzlib_get_byte(d);
+    // modification time, extra flags and OS
+    for (uint8_t i=0; i<6; i++) {
+        uzlib_get_byte(d);
+    }
+    if (flags & 0x04) {
+        // extra field
+        uint16_t len = uzlib_get_byte(d);
+        len |= uint16_t(uzlib_get_byte(d)) << 8;
+        while (len-- && !d->eof) {
+            uzlib_get_byte(d);
+        }
+    }
+    if (flags & 0x08) {
+        // original file name
+        while (uzlib_get_byte(d) != 0 && !d->eof) {}
+    }
+    if (flags & 0x10) {
+        // comment
+        while (uzlib_get_byte(d) != 0 && !d->eof) {}
+    }
+    if (flags & 0x02) {
+        // header crc
+        uzlib_get_byte(d);
+        uzlib_get_byte(d);
+    }
+    return !d->eof;
+}
+
+/*
+  refill the input buffer of the decompressor
+ */
+int AP_Terrain::tile_read_source(TINF_DATA *d)
+{
+    struct tile_upload *u = (struct tile_upload *)d;
+    const int32_t n = AP::FS().read(u->fd_in, u->in_buf, sizeof(u->in_buf));
+    if (n <= 0) {
+        return -1;
+    }
+    d->source = &u->in_buf[1];
+    d->source_limit = &u->in_buf[n];
+    return u->in_buf[0];
+}
+
+/*
+  look for an upload in the terrain directory, which must be named
+  like N35E149.DAT.gz and not have changed size since the last scan
+ */
+bool AP_Terrain::tile_upload_find(char *name)
+{
+    char *dir_path = tile_path("", "");
+    if (dir_path == nullptr) {
+        return false;
+    }
+    // remove trailing slash
+    dir_path[strlen(dir_path)-1] = 0;
+    auto *d = AP::FS().opendir(dir_path);
+    free(dir_path);
+    if (d == nullptr) {
+        return false;
+    }
+    bool found = false;
+    struct dirent *de;
+    while (!found && (de = AP::FS().readdir(d)) != nullptr) {
+        const char *n = de->d_name;
+        if (strlen(n) != 14 ||
+            strcasecmp(&n[7], ".DAT.gz") != 0 ||
+            strchr("NnSs", n[0]) == nullptr ||
+            strchr("EeWw", n[3]) == nullptr ||
+            !isdigit(n[1]) || !isdigit(n[2]) ||
+            !isdigit(n[4]) || !isdigit(n[5]) || !isdigit(n[6])) {
+            continue;
+        }
+        char *path = tile_path(n, "");
+        struct stat st;
+        if (path != nullptr && AP::FS().stat(path, &st) == 0) {
+            if (strncmp(n, tile_scan_name, sizeof(tile_scan_name)) == 0 &&
+                uint32_t(st.st_size) == tile_scan_size) {
+                // it has stopped growing
+                strncpy(name, n, sizeof(tile_scan_name)-1);
+                name[sizeof(tile_scan_name)-1] = 0;
+                found = true;
+            } else if (tile_scan_name[0] == 0 || strncmp(n, tile_scan_name, sizeof(tile_scan_name)) == 0) {
+                // check again next scan
+                strncpy(tile_scan_name, n, sizeof(tile_scan_name)-1);
+                tile_scan_size = st.st_size;
+            }
+        }
+        free(path);
+    }
+    AP::FS().closedir(d);
+    if (found) {
+        tile_scan_name[0] = 0;
+    }
+    return found;
+}
+
+/*
+  record the result of the install in progress
+ */
+void AP_Terrain::tile_upload_set_result(TileResult result)
+{
+    WITH_SEMAPHORE(tile_results_sem);
+    // re-use the entry of an earlier attempt on the same file
+    uint8_t idx = tile_results_next;
+    for (uint8_t i=0; i<ARRAY_SIZE(tile_results); i++) {
+        if (strncmp(tile_results[i].name, upload->name, sizeof(upload->name)) == 0) {
+            idx = i;
+            break;
+        }
+    }
+    if (idx == tile_results_next) {
+        tile_results_next = (tile_results_next + 1) % ARRAY_SIZE(tile_results);
+    }
+    struct tile_result &r = tile_results[idx];
+    memcpy(r.name, upload->name, sizeof(r.name));
+    r.result = result;
+    r.blocks = upload->blocks;
+    r.full_blocks = upload->full_blocks;
+}
+
+/*
+  start installing an upload
+ */
+void AP_Terrain::tile_upload_start(const char *gz_name)
+{
+    upload = NEW_NOTHROW tile_upload;
+    if (upload == nullptr) {
+        return;
+    }
+    upload->fd_in = -1;
+    upload->fd_out = -1;
+    strncpy(upload->gz_name, gz_name, sizeof(upload->gz_name)-1);
+
+    const char ns = toupper(gz_name[0]);
+    const char ew = toupper(gz_name[3]);
+    const int16_t lat = (gz_name[1]-'0')*10 + (gz_name[2]-'0');
+    const int16_t lon = (gz_name[4]-'0')*100 + (gz_name[5]-'0')*10 + (gz_name[6]-'0');
+    upload->lat_degrees = ns == 'S' ? -lat : lat;
+    upload->lon_degrees = ew == 'W' ? -lon : lon;
+    hal.util->snprintf(upload->name, sizeof(upload->name), "%c%02u%c%03u",
+                       ns, unsigned(lat), ew, unsigned(lon));
+    tile_upload_set_result(TileResult::INSTALLING);
+
+    if (lat > 90 || lon > 180) {
+        tile_upload_finish(TileResult::BAD_FORMAT);
+        return;
+    }
+
+    char *gz_path = tile_path(upload->gz_name, "");
+    char *tmp_path = tile_path(upload->name, ".TMP");
+    if (gz_path != nullptr && tmp_path != nullptr) {
+        upload->fd_in = AP::FS().open(gz_path, O_RDONLY);
+        upload->fd_out = AP::FS().open(tmp_path, O_WRONLY|O_CREAT|O_TRUNC);
+    }
+    free(gz_path);
+    free(tmp_path);
+    if (upload->fd_in == -1 || upload->fd_out == -1) {
+        tile_upload_finish(TileResult::IO_ERROR);
+        return;
+    }
+
+    uzlib_uncompress_init(&upload->d, upload->dict, sizeof(upload->dict));
+    upload->d.readSource = tile_read_source;
+    if (!skip_gzip_header(&upload->d)) {
+        tile_upload_finish(TileResult::BAD_FORMAT);
+    }
+}
+
+/*
+  check a decompressed block. Blocks that were never filled are
+  allowed, and blocks for another grid spacing can't be checked for
+  position as the layout of the file depends on the spacing
+ */
+bool AP_Terrain::tile_upload_check_block(struct grid_block &block)
+{
+    if (block.bitmap == 0) {
+        return true;
+    }
+    if (block.version != TERRAIN_GRID_FORMAT_VERSION ||
+        block.crc != get_block_crc(block) ||
+        (block.bitmap & ~bitmap_mask) != 0 ||
+        block.lat_degrees != upload->lat_degrees ||
+        block.lon_degrees != upload->lon_degrees) {
+        return false;
+    }
+    if (block.spacing == grid_spacing &&
+        east_blocks(block) * block.grid_idx_x + block.grid_idx_y != upload->blocks) {
+        return false;
+    }
+    if (block.bitmap == bitmap_mask) {
+        upload->full_blocks++;
+    }
+    return true;
+}
+
+/*
+  decompress, check and write out one block
+ */
+void AP_Terrain::tile_upload_step(void)
+{
+    TINF_DATA &d = upload->d;
+    d.dest = upload->block.buffer;
+    d.destSize = sizeof(upload->block);
+    const int res = uzlib_uncompress(&d);
+    if (res < 0) {
+        tile_upload_finish(TileResult::BAD_FORMAT);
+        return;
+    }
+
+    const uint32_t len = d.dest - upload->block.buffer;
+    if (len == sizeof(upload->block)) {
+        if (!tile_upload_check_block(upload->block.block)) {
+            tile_upload_finish(TileResult::BAD_BLOCK);
+            return;
+        }
+        if (AP::FS().write(upload->fd_out, upload->block.buffer, len) != int32_t(len)) {
+            tile_upload_finish(TileResult::IO_ERROR);
+            return;
+        }
+        upload->blocks++;
+    } else if (len != 0) {
+        // files are a whole number of blocks
+        tile_upload_finish(TileResult::BAD_FORMAT);
+        return;
+    }
+
+    if (res == TINF_DONE) {
+        if (upload->blocks == 0) {
+            tile_upload_finish(TileResult::BAD_FORMAT);
+            return;
+        }
+        tile_upload_install();
+    }
+}
+
+/*
+  replace the degree file with the decompressed upload
+ */
+void AP_Terrain::tile_upload_install(void)
+{
+    if (AP::FS().fsync(upload->fd_out) != 0) {
+        tile_upload_finish(TileResult::IO_ERROR);
+        return;
+    }
+    AP::FS().close(upload->fd_out);
+    upload->fd_out = -1;
+
+    // stop using the old file
+    if (fd != -1 &&
+        file_lat_degrees == upload->lat_degrees &&
+        file_lon_degrees == upload->lon_degrees) {
+        AP::FS().close(fd);
+        fd = -1;
+    }
+#if AP_TERRAIN_MMAP_ENABLED
+    {
+        WITH_SEMAPHORE(mmap_sem);
+        for (auto &m : mapped_files) {
+            if (m.base != nullptr &&
+                m.lat_degrees == upload->lat_degrees &&
+                m.lon_degrees == upload->lon_degrees) {
+                AP::FS().munmap(m.fd, m.base, m.length);
+                m.base = nullptr;
+            }
+        }
+    }
+#endif
+
+    char *dat_path = tile_path(upload->name, ".DAT");
+    char *tmp_path = tile_path(upload->name, ".TMP");
+    bool ok = false;
+    if (dat_path != nullptr && tmp_path != nullptr) {
+        // not all filesystems can rename over an existing file
+        AP::FS().unlink(dat_path);
+        ok = AP::FS().rename(tmp_path, dat_path) == 0;
+    }
+    free(dat_path);
+    free(tmp_path);
+    if (!ok) {
+        tile_upload_finish(TileResult::IO_ERROR);
+        return;
+    }
+
+    tile_installed_lat = upload->lat_degrees;
+    tile_installed_lon = upload->lon_degrees;
+    tile_installed = true;
+    tile_upload_finish(TileResult::INSTALLED);
+}
+
+/*
+  finish with the install in progress. The upload is removed unless
+  we have only postponed installing it
+ */
+void AP_Terrain::tile_upload_finish(TileResult result)
+{
+    if (upload->fd_in != -1) {
+        AP::FS().close(upload->fd_in);
+    }
+    if (upload->fd_out != -1) {
+        AP::FS().close(upload->fd_out);
+        char *tmp_path = tile_path(upload->name, ".TMP");
+        if (tmp_path != nullptr) {
+            AP::FS().unlink(tmp_path);
+            free(tmp_path);
+        }
+    }
+    if (result != TileResult::POSTPONED) {
+        char *gz_path = tile_path(upload->gz_name, "");
+        if (gz_path != nullptr) {
+            AP::FS().unlink(gz_path);
+            free(gz_path);
+        }
+    }
+    tile_upload_set_result(result);
+    if (result == TileResult::INSTALLED) {
+        GCS_SEND_TEXT(MAV_SEVERITY_INFO, "Terrain: installed %s", upload->name);
+    } else if (result != TileResult::POSTPONED) {
+        GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "Terrain: bad upload %s", upload->name);
+    }
+    delete upload;
+    upload = nullptr;
+}
+
+/*
+  called by the IO thread to make progress on uploads. Degree files
+  are only replaced while disarmed
+ */
+void AP_Terrain::tile_upload_update(void)
+{
+    if (upload != nullptr) {
+        if (hal.util->get_soft_armed()) {
+            tile_upload_finish(TileResult::POSTPONED);
+            return;
+        }
+        tile_upload_step();
+        return;
+    }
+
+    // wait for the main thread to see the last install
+    if (tile_installed || hal.util->get_soft_armed()) {
+        return;
+    }
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - last_tile_scan_ms < TILE_SCAN_INTERVAL_MS) {
+        return;
+    }
+    last_tile_scan_ms = now_ms;
+    char gz_name[sizeof(tile_scan_name)];
+    if (tile_upload_find(gz_name)) {
+        tile_upload_start(gz_name);
+    }
+}
+
+/*
+  called from the main thread when a degree file has been replaced,
+  to re-read any cached blocks from the new file
+ */
+void AP_Terrain::tile_upload_reload(void)
+{
+    for (uint16_t i=0; i<cache_size; i++) {
+        struct grid_block &grid = cache[i].grid;
+        if (cache[i].state != GRID_CACHE_INVALID &&
+            grid.lat_degrees == tile_installed_lat &&
+            grid.lon_degrees == tile_installed_lon) {
+            cache[i].state = GRID_CACHE_DISKWAIT;
+        }
+    }
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    if (warm_cache != nullptr) {
+        for (uint16_t i=0; i<AP_TERRAIN_WARM_CACHE_SIZE; i++) {
+            warm_cache[i].length = 0;
+        }
+    }
+#endif
+    tile_installed = false;
+}
+
+/*
+  report terrain status and uploaded tiles
+ */
+void AP_Terrain::tile_upload_info(ExpandingString &str)
+{
+    uint16_t pending, loaded;
+    get_statistics(pending, loaded);
+    str.printf("Enabled: %u Spacing: %u Status: %u Pending: %u Loaded: %u\n",
+               unsigned(enable.get()), unsigned(get_grid_spacing()),
+               unsigned(status()), unsigned(pending), unsigned(loaded));
+
+    static const char *result_names[] = {
+        "installing", "installed", "bad-format", "bad-block", "io-error", "postponed",
+    };
+    WITH_SEMAPHORE(tile_results_sem);
+    for (uint8_t i=0; i<ARRAY_SIZE(tile_results); i++) {
+        const struct tile_result &r = tile_results[i];
+        if (r.name[0] == 0) {
+            continue;
+        }
+        str.printf("%s %-10s Blocks: %u Full: %u (%u%%)\n",
+                   r.name, result_names[uint8_t(r.result)],
+                   unsigned(r.blocks), unsigned(r.full_blocks),
+                   r.blocks > 0 ? unsigned(r.full_blocks * 100U / r.blocks) : 0U);
+    }
+}
+
+#endif // AP_TERRAIN_TILE_UPLOAD_ENABLED
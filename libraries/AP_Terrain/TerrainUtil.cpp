@@ -124,6 +124,11 @@ AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info
     // Not found. Use the oldest grid and make it this grid,
     // initially unpopulated
     struct grid_cache &grid = cache[oldest_i];
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    if (grid.state == GRID_CACHE_VALID && grid.grid.bitmap != 0) {
+        warm_store(grid.grid);
+    }
+#endif
     memset(&grid, 0, sizeof(grid));
 
     grid.grid.lat = info.grid_lat;
@@ -136,6 +141,19 @@ AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info
     grid.grid.version = TERRAIN_GRID_FORMAT_VERSION;
     grid.last_access_ms = AP_HAL::millis();
 
+#if AP_TERRAIN_WARM_CACHE_ENABLED
+    if (warm_load(grid.grid)) {
+        grid.state = GRID_CACHE_VALID;
+        return grid;
+    }
+#endif
+#if AP_TERRAIN_MMAP_ENABLED
+    if (mapped_read(grid.grid)) {
+        grid.state = GRID_CACHE_VALID;
+        return grid;
+    }
+#endif
+
     // mark as waiting for disk read
     grid.state = GRID_CACHE_DISKWAIT;
 
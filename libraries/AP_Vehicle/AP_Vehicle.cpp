@@ -600,6 +600,11 @@ SCHED_TASK_CLASS arguments:
  - expected time (in MicroSeconds) that the method should take to run
  - priority (0 through 255, lower number meaning higher priority)
 
+SCHED_WORKER_TASK_CLASS takes the same arguments as SCHED_TASK_CLASS,
+for methods which only touch state protected by their own semaphore
+and so may run in a scheduler worker thread when SCHED_OPTIONS enables
+them.
+
  */
 const AP_Scheduler::Task AP_Vehicle::scheduler_tasks[] = {
 #if HAL_GYROFFT_ENABLED
@@ -675,11 +680,14 @@ const AP_Scheduler::Task AP_Vehicle::scheduler_tasks[] = {
     SCHED_TASK_CLASS(AP_Filters,   &vehicle.filters,        update,                   1, 100, 252),
 #endif
 #if AP_STATS_ENABLED
-    SCHED_TASK_CLASS(AP_Stats,             &vehicle.stats,            update,           1, 100, 252),
+    SCHED_WORKER_TASK_CLASS(AP_Stats,      &vehicle.stats,            update,           1, 100, 252),
 #endif
 #if AP_ARMING_ENABLED
     SCHED_TASK(update_arming,          1,     50, 253),
 #endif
+#if AP_SCRIPTING_ENABLED && AP_SCRIPTING_EVENTS_ENABLED
+    SCHED_TASK_CLASS(AP_Scripting, &vehicle.scripting,      update_events,            50,  50, 254),
+#endif
 };
 
 void AP_Vehicle::get_common_scheduler_tasks(const AP_Scheduler::Task*& tasks, uint8_t& num_tasks)
@@ -821,6 +829,70 @@ void AP_Vehicle::update_throttle_notch(AP_InertialSensor::HarmonicNotch &notch)
 #endif
 }
 
+#if HAL_GYROFFT_ENABLED
+/*
+  update a notch per motor for frames without ESC telemetry. Each
+  motor's frequency is predicted from its thrust as for throttle based
+  tracking, then scaled by a per-motor ratio that is slowly pulled
+  towards the FFT noise peak closest to the motor's current estimate.
+  Motors at similar thrust share a peak, motors whose estimate is far
+  from every peak keep their last ratio
+ */
+void AP_Vehicle::update_fft_motor_notch(AP_InertialSensor::HarmonicNotch &notch)
+{
+#if APM_BUILD_TYPE(APM_BUILD_ArduPlane) || APM_BUILD_COPTER_OR_HELI
+    // a peak is associated with a motor if within this fraction of its estimate
+    const float association_ratio = 0.2;
+    // low pass filter coefficient for the per-motor ratio
+    const float scale_alpha = 0.05;
+
+    const AP_Motors* motors = AP::motors();
+    if (motors == nullptr) {
+        notch.update_freq_hz(0);
+        return;
+    }
+    const float ref_freq = notch.params.center_freq_hz();
+    const float ref = notch.params.reference();
+
+    float peaks[AP_HAL::DSP::MAX_TRACKED_PEAKS];
+    const uint8_t num_peaks = gyro_fft.get_weighted_noise_center_frequencies_hz(AP_HAL::DSP::MAX_TRACKED_PEAKS, peaks);
+
+    float notches[INS_MAX_NOTCHES];
+    uint8_t motor_num = 0;
+    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS && motor_num < INS_MAX_NOTCHES; i++) {
+        float motor_throttle = 0;
+        if (!motors->get_thrust(i, motor_throttle)) {
+            continue;
+        }
+        float &scale = notch.motor_freq_scale[motor_num];
+        if (!is_positive(scale)) {
+            scale = 1.0;
+        }
+        const float predicted_hz = ref_freq * sqrtf(MAX(0, motor_throttle) / ref);
+        const float estimate_hz = predicted_hz * scale;
+
+        // find the closest peak to this motor's estimate
+        float best_err_hz = association_ratio * estimate_hz;
+        float best_hz = 0;
+        for (uint8_t p = 0; p < num_peaks; p++) {
+            const float err_hz = fabsf(peaks[p] - estimate_hz);
+            if (err_hz < best_err_hz) {
+                best_err_hz = err_hz;
+                best_hz = peaks[p];
+            }
+        }
+        if (is_positive(best_hz) && is_positive(predicted_hz)) {
+            scale += scale_alpha * (best_hz / predicted_hz - scale);
+            scale = constrain_float(scale, 0.5, 2.0);
+        }
+        notches[motor_num++] = predicted_hz * scale;
+    }
+    notch.set_inactive(false);
+    notch.update_frequencies_hz(motor_num, notches);
+#endif
+}
+#endif  // HAL_GYROFFT_ENABLED
+
 // update the harmonic notch filter center frequency dynamically
 void AP_Vehicle::update_dynamic_notch(AP_InertialSensor::HarmonicNotch &notch)
 {
@@ -876,7 +948,10 @@ void AP_Vehicle::update_dynamic_notch(AP_InertialSensor::HarmonicNotch &notch)
 #if HAL_GYROFFT_ENABLED
         case HarmonicNotchDynamicMode::UpdateGyroFFT: // FFT based tracking
             // set the harmonic notch filter frequency scaled on measured frequency
-            if (notch.params.hasOption(HarmonicNotchFilterParams::Options::DynamicHarmonic)) {
+            if (notch.params.hasOption(HarmonicNotchFilterParams::Options::DynamicHarmonic) &&
+                notch.params.hasOption(HarmonicNotchFilterParams::Options::PerMotorFFT)) {
+                update_fft_motor_notch(notch);
+            } else if (notch.params.hasOption(HarmonicNotchFilterParams::Options::DynamicHarmonic)) {
                 float notches[INS_MAX_NOTCHES];
                 const uint8_t peaks = gyro_fft.get_weighted_noise_center_frequencies_hz(notch.num_dynamic_notches, notches);
 
@@ -1087,6 +1162,16 @@ void AP_Vehicle::one_Hz_update(void)
 #endif
 #endif
 
+#if HAL_LOGGING_ENABLED && HAL_BUS_STATS_ENABLED
+    // Log bus usage of SPI and I2C devices
+    hal.util->bus_log();
+#endif
+
+#if HAL_LOGGING_ENABLED && AP_HAL_CYCLE_PROBES_ENABLED
+    // Log the cycle counter probes over the last second
+    AP_HAL::CycleProbe::log();
+#endif
+
 }
 
 void AP_Vehicle::check_motor_noise()
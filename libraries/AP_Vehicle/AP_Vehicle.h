@@ -548,6 +548,10 @@ private:
 #if AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED
     // update the harmonic notch for throttle based notch
     void update_throttle_notch(AP_InertialSensor::HarmonicNotch &notch);
+#if HAL_GYROFFT_ENABLED
+    // update the harmonic notch for per-motor FFT based notch
+    void update_fft_motor_notch(AP_InertialSensor::HarmonicNotch &notch);
+#endif
 #endif // AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED
 
     // decimation for 1Hz update
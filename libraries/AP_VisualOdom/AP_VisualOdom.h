@@ -29,6 +29,10 @@
 class AP_VisualOdom_Backend;
 
 #define AP_VISUALODOM_TIMEOUT_MS 300
+// EKF3 ignores external nav samples less than this far apart (extNavIntervalMin_ms)
+#define AP_VISUALODOM_EKF_INTERVAL_MIN_MS 20
+// a sample arriving in a burst may be moved later by up to this much to be accepted
+#define AP_VISUALODOM_TIME_SHIFT_MAX_MS 10
 
 class AP_VisualOdom
 {
@@ -90,4 +90,24 @@ uint32_t AP_VisualOdom_Backend::get_reset_timestamp_ms(uint8_t reset_counter)
     return _reset_timestamp_ms;
 }
 
+// space sample timestamps so the EKF does not silently drop samples
+// arriving in a burst. Companions on lossy links (e.g. WiFi) often
+// deliver several samples at once and the jitter corrected timestamps
+// of consecutive samples can then be closer together than the EKF
+// accepts.  Samples slightly too close are moved later to the earliest
+// accepted time, samples that would need to move too far are dropped
+bool AP_VisualOdom_Backend::space_sample_time(uint32_t &time_ms, uint32_t &last_time_ms) const
+{
+    // unsigned difference to match the EKF's check, older samples are not adjusted
+    const uint32_t dt_ms = time_ms - last_time_ms;
+    if (last_time_ms != 0 && dt_ms < AP_VISUALODOM_EKF_INTERVAL_MIN_MS) {
+        if (AP_VISUALODOM_EKF_INTERVAL_MIN_MS - dt_ms > AP_VISUALODOM_TIME_SHIFT_MAX_MS) {
+            return false;
+        }
+        time_ms = last_time_ms + AP_VISUALODOM_EKF_INTERVAL_MIN_MS;
+    }
+    last_time_ms = time_ms;
+    return true;
+}
+
 #endif
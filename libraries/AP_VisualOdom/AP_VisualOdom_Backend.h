@@ -61,6 +61,12 @@ protected:
     // updates the reset timestamp to the current system time if the reset_counter has changed
     uint32_t get_reset_timestamp_ms(uint8_t reset_counter);
 
+    // space sample timestamps so the EKF does not silently drop samples
+    // arriving in a burst. time_ms may be moved later to fit the EKF's
+    // minimum interval after last_time_ms, returns false if the sample
+    // would need to move too far and should be dropped instead
+    bool space_sample_time(uint32_t &time_ms, uint32_t &last_time_ms) const;
+
     AP_VisualOdom::VisualOdom_Type get_type(void) const {
         return _frontend.get_type();
     }
@@ -81,6 +87,10 @@ protected:
 
     // quality
     int8_t _quality;                // last recorded quality
+
+    // timestamps of last samples sent to the EKF
+    uint32_t _last_pos_time_ms;     // last position and attitude sample
+    uint32_t _last_vel_time_ms;     // last velocity sample
 };
 
 #endif  // HAL_VISUALODOM_ENABLED
@@ -37,7 +37,7 @@ void AP_VisualOdom_MAV::handle_pose_estimate(uint64_t remote_time_us, uint32_t t
     _quality = quality;
 
     // send attitude and position to EKF if quality OK
-    bool consume = (_quality >= _frontend.get_quality_min());
+    bool consume = (_quality >= _frontend.get_quality_min()) && space_sample_time(time_ms, _last_pos_time_ms);
     if (consume) {
         AP::ahrs().writeExtNavData(pos, attitude, posErr, angErr, time_ms, _frontend.get_delay_ms(), get_reset_timestamp_ms(reset_counter));
     }
@@ -65,7 +65,7 @@ void AP_VisualOdom_MAV::handle_vision_speed_estimate(uint64_t remote_time_us, ui
     _quality = quality;
 
     // send velocity to EKF if quality OK
-    bool consume = (_quality >= _frontend.get_quality_min());
+    bool consume = (_quality >= _frontend.get_quality_min()) && space_sample_time(time_ms, _last_vel_time_ms);
     if (consume) {
         AP::ahrs().writeExtNavVelData(vel, _frontend.get_vel_noise(), time_ms, _frontend.get_delay_ms());
     }
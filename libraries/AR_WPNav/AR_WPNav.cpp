@@ -119,6 +119,7 @@ void AR_WPNav::init(float speed_max)
     _scurve_prev_leg.init();
     _scurve_this_leg.init();
     _scurve_next_leg.init();
+    _next_leg_pending = false;
     _track_scalar_dt = 1.0f;
 
     // init some flags
@@ -162,6 +163,10 @@ void AR_WPNav::update(float dt)
     // handle change in max speed
     update_speed_max();
 
+    // plan the next leg one update after its leg was set so that a
+    // waypoint change costs at most one scurve calculation per loop
+    calculate_next_leg();
+
     // advance target along path unless vehicle is pivoting
     if (!_pivot.active()) {
         switch (_nav_control_type) {
@@ -211,6 +216,7 @@ bool AR_WPNav::set_desired_location(const Location& destination, Location next_d
         _scurve_prev_leg.init();
         _scurve_this_leg.init();
         _scurve_next_leg.init();
+        _next_leg_pending = false;
     }
 
     // shift this leg to previous leg
@@ -243,7 +249,7 @@ bool AR_WPNav::set_desired_location(const Location& destination, Location next_d
     destination_NE *= 0.01f;
 
     // calculate track to destination
-    if (_fast_waypoint && !_scurve_next_leg.finished()) {
+    if (_fast_waypoint && !_next_leg_pending && !_scurve_next_leg.finished()) {
         // skip recalculating this leg by simply shifting next leg
         _scurve_this_leg = _scurve_next_leg;
     } else {
@@ -260,6 +266,7 @@ bool AR_WPNav::set_desired_location(const Location& destination, Location next_d
 
     // handle next destination
     _scurve_next_leg.init();
+    _next_leg_pending = false;
     _fast_waypoint = false;
     _pivot_at_next_wp = false;
     if (next_destination.initialised()) {
@@ -273,16 +280,9 @@ bool AR_WPNav::set_desired_location(const Location& destination, Location next_d
                 INTERNAL_ERROR(AP_InternalError::error_t::flow_of_control);
                 return false;
             }
-            next_destination_NE *= 0.01f;
-            _scurve_next_leg.calculate_track(Vector3f{destination_NE.x, destination_NE.y, 0.0f},
-                                             Vector3f{next_destination_NE.x, next_destination_NE.y, 0.0f},
-                                             _pos_control.get_speed_max(),
-                                             _pos_control.get_speed_max(),  // speed up (not used)
-                                             _pos_control.get_speed_max(),  // speed down (not used)
-                                             _pos_control.get_accel_max(),  // forward back acceleration
-                                             _pos_control.get_accel_max(),  // vertical accel (not used)
-                                             AR_WPNAV_SNAP_MAX,             // snap
-                                             _pos_control.get_jerk_max());
+            // the next leg is calculated on the next call to update
+            _next_leg_destination_NE = next_destination_NE * 0.01f;
+            _next_leg_pending = true;
 
             // next destination provided so fast waypoint
             _fast_waypoint = true;
@@ -297,6 +297,34 @@ bool AR_WPNav::set_desired_location(const Location& destination, Location next_d
     return true;
 }
 
+// calculate the next leg's scurve if set_desired_location has requested one
+void AR_WPNav::calculate_next_leg()
+{
+    if (!_next_leg_pending) {
+        return;
+    }
+    _next_leg_pending = false;
+
+    // convert destination to offset from EKF origin
+    Vector2f destination_NE;
+    if (!_destination.get_vector_xy_from_origin_NE_cm(destination_NE)) {
+        // stop at the destination instead
+        _fast_waypoint = false;
+        return;
+    }
+    destination_NE *= 0.01f;
+
+    _scurve_next_leg.calculate_track(Vector3f{destination_NE.x, destination_NE.y, 0.0f},
+                                     Vector3f{_next_leg_destination_NE.x, _next_leg_destination_NE.y, 0.0f},
+                                     _pos_control.get_speed_max(),
+                                     _pos_control.get_speed_max(),  // speed up (not used)
+                                     _pos_control.get_speed_max(),  // speed down (not used)
+                                     _pos_control.get_accel_max(),  // forward back acceleration
+                                     _pos_control.get_accel_max(),  // vertical accel (not used)
+                                     AR_WPNAV_SNAP_MAX,             // snap
+                                     _pos_control.get_jerk_max());
+}
+
 // set desired location to a reasonable stopping point, return true on success
 bool AR_WPNav::set_desired_location_to_stopping_location()
 {
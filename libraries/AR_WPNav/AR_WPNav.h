@@ -141,6 +141,9 @@ protected:
     // updates position controller limits and recalculate scurve path if required
     void update_speed_max();
 
+    // calculate the next leg's scurve if set_desired_location has requested one
+    void calculate_next_leg();
+
     // parameters
     AP_Float _speed_max;            // target speed between waypoints in m/s
     AP_Float _radius;               // distance in meters from a waypoint when we consider the waypoint has been reached
@@ -156,6 +159,8 @@ protected:
     SCurve _scurve_prev_leg;        // previous scurve trajectory used to blend with current scurve trajectory
     SCurve _scurve_this_leg;        // current scurve trajectory
     SCurve _scurve_next_leg;        // next scurve trajectory used to blend with current scurve trajectory
+    bool _next_leg_pending;         // true if _scurve_next_leg has been requested but not yet calculated
+    Vector2f _next_leg_destination_NE; // end of the pending next leg as offset from EKF origin in meters
     bool _fast_waypoint;            // true if vehicle will stop at the next waypoint
     bool _pivot_at_next_wp;         // true if vehicle should pivot at next waypoint
     bool _overspeed_enabled;        // if true scurve's position target will speedup to catch vehicles travelling faster than WP_SPEED
@@ -0,0 +1,112 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "FIRDecimator.h"
+
+// cutoff as a fraction of the output Nyquist frequency, leaving room
+// for the transition band of a short filter
+#define FIR_DECIMATOR_CUTOFF 0.8f
+
+template <class T>
+FIRDecimator<T>::~FIRDecimator()
+{
+    delete[] _coeff;
+    delete[] _buffer;
+}
+
+template <class T>
+bool FIRDecimator<T>::init(uint8_t factor)
+{
+    delete[] _coeff;
+    delete[] _buffer;
+    _coeff = nullptr;
+    _buffer = nullptr;
+    _factor = 0;
+
+    if (factor < 2 || factor > UINT8_MAX / FIR_DECIMATOR_TAPS_PER_PHASE) {
+        return false;
+    }
+    const uint8_t num_taps = factor * FIR_DECIMATOR_TAPS_PER_PHASE;
+    _coeff = NEW_NOTHROW_FAST float[num_taps];
+    _buffer = NEW_NOTHROW_FAST T[num_taps];
+    if (_coeff == nullptr || _buffer == nullptr) {
+        delete[] _coeff;
+        delete[] _buffer;
+        _coeff = nullptr;
+        _buffer = nullptr;
+        return false;
+    }
+
+    // Blackman windowed sinc, normalised to unity gain at DC
+    const float fc = FIR_DECIMATOR_CUTOFF * 0.5f / factor;
+    const float centre = (num_taps - 1) * 0.5f;
+    float sum = 0;
+    for (uint8_t i=0; i<num_taps; i++) {
+        const float x = i - centre;
+        const float sinc = is_zero(x) ? 2 * fc : sinf(M_2PI * fc * x) / (M_PI * x);
+        const float w = 0.42f - 0.5f * cosf(M_2PI * i / (num_taps - 1)) + 0.08f * cosf(2 * M_2PI * i / (num_taps - 1));
+        _coeff[i] = sinc * w;
+        sum += _coeff[i];
+    }
+    for (uint8_t i=0; i<num_taps; i++) {
+        _coeff[i] /= sum;
+    }
+
+    _num_taps = num_taps;
+    _factor = factor;
+    reset();
+    return true;
+}
+
+template <class T>
+void FIRDecimator<T>::reset()
+{
+    for (uint8_t i=0; i<_num_taps; i++) {
+        _buffer[i] = T();
+    }
+    _head = 0;
+    _count = 0;
+}
+
+template <class T>
+bool FIRDecimator<T>::apply(const T &sample, T &out)
+{
+    if (_factor == 0) {
+        out = sample;
+        return true;
+    }
+
+    _buffer[_head] = sample;
+    _head = (_head + 1 < _num_taps) ? _head + 1 : 0;
+    if (++_count < _factor) {
+        return false;
+    }
+    _count = 0;
+
+    // the filter is symmetric so the coefficients can be applied from
+    // the oldest sample, which avoids wrapping inside the loops
+    T result = T();
+    uint8_t c = 0;
+    for (uint8_t i=_head; i<_num_taps; i++) {
+        result += _buffer[i] * _coeff[c++];
+    }
+    for (uint8_t i=0; i<_head; i++) {
+        result += _buffer[i] * _coeff[c++];
+    }
+    out = result;
+    return true;
+}
+
+template class FIRDecimator<float>;
+template class FIRDecimator<Vector3f>;
@@ -0,0 +1,62 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <AP_Math/AP_Math.h>
+#include <inttypes.h>
+
+/// @file   FIRDecimator.h
+/// @brief  A windowed sinc FIR low pass filter that decimates its input
+///
+/// Only every factor'th output is calculated, so the cost per input
+/// sample is taps/factor multiplies, the same as a polyphase
+/// decimator. The anti-aliasing cutoff is placed below the Nyquist
+/// frequency of the output rate.
+
+// taps for each output phase, the filter has factor times this many taps
+#define FIR_DECIMATOR_TAPS_PER_PHASE 8
+
+template <class T>
+class FIRDecimator {
+public:
+    FIRDecimator() : _factor(0), _num_taps(0), _head(0), _count(0) {}
+    ~FIRDecimator();
+
+    CLASS_NO_COPY(FIRDecimator);
+
+    // set up to decimate by factor, returning false if the filter
+    // could not be allocated
+    bool init(uint8_t factor);
+
+    // add a sample, returning true and filling in out when a
+    // decimated sample is available
+    bool apply(const T &sample, T &out);
+
+    // clear the sample history
+    void reset();
+
+    uint8_t get_factor() const { return _factor; }
+
+private:
+    uint8_t _factor;    // zero when not initialised
+    uint8_t _num_taps;
+    uint8_t _head;      // index of the oldest sample
+    uint8_t _count;     // samples since the last output
+    float *_coeff = nullptr;
+    T *_buffer = nullptr;
+};
+
+typedef FIRDecimator<float> FIRDecimatorFloat;
+typedef FIRDecimator<Vector3f> FIRDecimatorVector3f;
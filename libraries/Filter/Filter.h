@@ -8,6 +8,7 @@
 #include "FilterWithBuffer.h"
 #include "LowPassFilter.h"
 #include "ModeFilter.h"
+#include "MedianFilter.h"
 #include "Butter.h"
 
 /*
@@ -132,8 +132,8 @@ const AP_Param::GroupInfo HarmonicNotchFilterParams::var_info[] = {
 
     // @Param: OPTS
     // @DisplayName: Harmonic Notch Filter options
-    // @Description: Harmonic Notch Filter options. Triple and double-notches can provide deeper attenuation across a wider bandwidth with reduced latency than single notches and are suitable for larger aircraft. Multi-Source attaches a harmonic notch to each detected noise frequency instead of simply being multiples of the base frequency, in the case of FFT it will attach notches to each of three detected noise peaks, in the case of ESC it will attach notches to each of four motor RPM values. Loop rate update changes the notch center frequency at the scheduler loop rate rather than at the default of 200Hz. If both double and triple notches are specified only double notches will take effect.
-    // @Bitmask: 0:Double notch,1:Multi-Source,2:Update at loop rate,3:EnableOnAllIMUs,4:Triple notch, 5:Use min freq on RPM source failure
+    // @Description: Harmonic Notch Filter options. Triple and double-notches can provide deeper attenuation across a wider bandwidth with reduced latency than single notches and are suitable for larger aircraft. Multi-Source attaches a harmonic notch to each detected noise frequency instead of simply being multiples of the base frequency, in the case of FFT it will attach notches to each of three detected noise peaks, in the case of ESC it will attach notches to each of four motor RPM values. Per-motor FFT, used with FFT tracking and Multi-Source, attaches a notch to each motor at a frequency estimated from that motor's thrust and corrected against the nearest FFT noise peak, for frames without ESC telemetry. Loop rate update changes the notch center frequency at the scheduler loop rate rather than at the default of 200Hz. If both double and triple notches are specified only double notches will take effect.
+    // @Bitmask: 0:Double notch,1:Multi-Source,2:Update at loop rate,3:EnableOnAllIMUs,4:Triple notch, 5:Use min freq on RPM source failure, 6:Per-motor FFT
     // @User: Advanced
     // @RebootRequired: True
     AP_GROUPINFO("OPTS", 8, HarmonicNotchFilterParams, _options, 0),
@@ -218,7 +218,7 @@ void HarmonicNotchFilter<T>::allocate_filters(uint8_t num_notches, uint32_t harm
     _harmonics = harmonics;
 
     if (_num_filters > 0) {
-        _filters = NEW_NOTHROW NotchFilter<T>[_num_filters];
+        _filters = NEW_NOTHROW_FAST NotchFilter<T>[_num_filters];
         if (_filters == nullptr) {
             GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "Failed to allocate %u bytes for notch filter", (unsigned int)(_num_filters * sizeof(NotchFilter<T>)));
             _num_filters = 0;
@@ -244,7 +244,7 @@ void HarmonicNotchFilter<T>::expand_filter_count(uint16_t total_notches)
       note that we rely on the semaphore in
       AP_InertialSensor_Backend.cpp to make this thread safe
      */
-    auto filters = NEW_NOTHROW NotchFilter<T>[total_notches];
+    auto filters = NEW_NOTHROW_FAST NotchFilter<T>[total_notches];
     if (filters == nullptr) {
         _alloc_has_failed = true;
         return;
@@ -406,16 +406,34 @@ T HarmonicNotchFilter<T>::apply(const T &sample)
     }
 #endif
 
+    /*
+      the biquad is evaluated here rather than by calling
+      NotchFilter::apply() so that the whole cascade is compiled as
+      one loop in this translation unit. This is the hot path for
+      per-motor notches, where there may be dozens of filters per
+      IMU sample. Uninitialised or reset filters take the out of line
+      path. The arithmetic must match NotchFilter::apply()
+     */
     T output = sample;
     for (uint16_t i = 0; i < _num_enabled_filters; i++) {
+        NotchFilter<T> &n = _filters[i];
 #if NOTCH_DEBUG_LOGGING
-        if (!_filters[i].initialised) {
+        if (!n.initialised) {
             ::dprintf(dfd, "------- ");
         } else {
-            ::dprintf(dfd, "%.4f ", _filters[i]._center_freq_hz);
+            ::dprintf(dfd, "%.4f ", n._center_freq_hz);
         }
 #endif
-        output = _filters[i].apply(output);
+        if (!n.initialised || n.need_reset) {
+            output = n.apply(output);
+            continue;
+        }
+        const T filtered = output*n.b0 + n.ntchsig1*n.b1 + n.ntchsig2*n.b2 - n.signal1*n.a1 - n.signal2*n.a2;
+        n.ntchsig2 = n.ntchsig1;
+        n.ntchsig1 = output;
+        n.signal2 = n.signal1;
+        n.signal1 = filtered;
+        output = filtered;
     }
 #if NOTCH_DEBUG_LOGGING
     if (_num_enabled_filters > 0) {
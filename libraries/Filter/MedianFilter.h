@@ -0,0 +1,139 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+/// @file	MedianFilter.h
+/// @brief	A running median of the last FILTER_SIZE samples
+///
+/// Unlike ModeFilter, which keeps a sorted buffer and drops the
+/// highest or lowest sample in turn, this drops the oldest sample, so
+/// the output is the true median of the window. A sorted copy of the
+/// window is kept alongside the samples in arrival order; the oldest
+/// and newest samples are found by binary search and the entries
+/// after them moved with memmove, which keeps larger windows cheap for
+/// noisy sensors.
+#pragma once
+
+#include <inttypes.h>
+#include <string.h>
+#include "FilterClass.h"
+#include "FilterWithBuffer.h"
+
+template <class T, uint8_t FILTER_SIZE>
+class MedianFilter : public FilterWithBuffer<T,FILTER_SIZE>
+{
+public:
+    MedianFilter() :
+        FilterWithBuffer<T,FILTER_SIZE>(),
+        _num_samples(0),
+        _output(0)
+    {}
+
+    // apply - Add a new raw value to the filter, retrieve the filtered result
+    virtual T apply(T sample) override;
+
+    // reset - clear the filter
+    virtual void reset() override;
+
+    // get - get latest filtered value from filter (equal to the value returned by latest call to apply method)
+    T get() const {
+        return _output;
+    }
+
+private:
+    // first index in sorted[] whose value is not less than value
+    uint8_t lower_bound(T value) const;
+    // first index in sorted[] whose value is greater than value
+    uint8_t upper_bound(T value) const;
+
+    T               sorted[FILTER_SIZE];    // the window in ascending order
+    uint8_t         _num_samples;           // number of samples in the window
+    T               _output;
+};
+
+// Typedef for convenience
+typedef MedianFilter<int16_t,5> MedianFilterInt16_Size5;
+typedef MedianFilter<uint16_t,5> MedianFilterUInt16_Size5;
+typedef MedianFilter<float,5> MedianFilterFloat_Size5;
+typedef MedianFilter<float,9> MedianFilterFloat_Size9;
+typedef MedianFilter<float,15> MedianFilterFloat_Size15;
+
+// Public Methods //////////////////////////////////////////////////////////////
+
+template <class T, uint8_t FILTER_SIZE>
+T MedianFilter<T,FILTER_SIZE>::apply(T sample)
+{
+    if (_num_samples >= FILTER_SIZE) {
+        // remove the oldest sample, which the parent is about to overwrite
+        const T oldest = FilterWithBuffer<T,FILTER_SIZE>::samples[FilterWithBuffer<T,FILTER_SIZE>::sample_index];
+        const uint8_t i = lower_bound(oldest);
+        _num_samples--;
+        memmove(&sorted[i], &sorted[i+1], (_num_samples - i) * sizeof(T));
+    }
+
+    // call parent's apply function to get the sample into the array
+    FilterWithBuffer<T,FILTER_SIZE>::apply(sample);
+
+    // insert the new sample after any equal ones
+    const uint8_t i = upper_bound(sample);
+    memmove(&sorted[i+1], &sorted[i], (_num_samples - i) * sizeof(T));
+    sorted[i] = sample;
+    _num_samples++;
+
+    return _output = sorted[_num_samples / 2];
+}
+
+// reset - clear all samples
+template <class T, uint8_t FILTER_SIZE>
+void MedianFilter<T,FILTER_SIZE>::reset()
+{
+    FilterWithBuffer<T,FILTER_SIZE>::reset();
+    _num_samples = 0;
+    _output = 0;
+}
+
+// Private Methods //////////////////////////////////////////////////////////////
+
+template <class T, uint8_t FILTER_SIZE>
+uint8_t MedianFilter<T,FILTER_SIZE>::lower_bound(T value) const
+{
+    uint8_t lo = 0;
+    uint8_t hi = _num_samples;
+    while (lo < hi) {
+        const uint8_t mid = (lo + hi) / 2;
+        if (sorted[mid] < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template <class T, uint8_t FILTER_SIZE>
+uint8_t MedianFilter<T,FILTER_SIZE>::upper_bound(T value) const
+{
+    uint8_t lo = 0;
+    uint8_t hi = _num_samples;
+    while (lo < hi) {
+        const uint8_t mid = (lo + hi) / 2;
+        if (value < sorted[mid]) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
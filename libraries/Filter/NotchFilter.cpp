@@ -25,6 +25,53 @@ const static float NOTCH_MAX_SLEW       = 0.05f;
 const static float NOTCH_MAX_SLEW_LOWER = 1.0f - NOTCH_MAX_SLEW;
 const static float NOTCH_MAX_SLEW_UPPER = 1.0f / NOTCH_MAX_SLEW_LOWER;
 
+// changes in center frequency smaller than this fraction, or in
+// attenuation smaller than this absolute value, don't recalculate the
+// coefficients. Dynamic notches are retuned at loop rate and most
+// updates move the center by far less than this
+const static float NOTCH_MIN_FREQ_CHANGE = 0.001f;
+const static float NOTCH_MIN_A_CHANGE    = 0.001f;
+
+// sin(i * pi / 128) for i = 0 to 64
+static const float notch_sin_table[65] = {
+    0.000000000f, 0.024541229f, 0.049067674f, 0.073564564f, 0.098017140f,
+    0.122410675f, 0.146730474f, 0.170961889f, 0.195090322f, 0.219101240f,
+    0.242980180f, 0.266712757f, 0.290284677f, 0.313681740f, 0.336889853f,
+    0.359895037f, 0.382683432f, 0.405241314f, 0.427555093f, 0.449611330f,
+    0.471396737f, 0.492898192f, 0.514102744f, 0.534997620f, 0.555570233f,
+    0.575808191f, 0.595699304f, 0.615231591f, 0.634393284f, 0.653172843f,
+    0.671558955f, 0.689540545f, 0.707106781f, 0.724247083f, 0.740951125f,
+    0.757208847f, 0.773010453f, 0.788346428f, 0.803207531f, 0.817584813f,
+    0.831469612f, 0.844853565f, 0.857728610f, 0.870086991f, 0.881921264f,
+    0.893224301f, 0.903989293f, 0.914209756f, 0.923879533f, 0.932992799f,
+    0.941544065f, 0.949528181f, 0.956940336f, 0.963776066f, 0.970031253f,
+    0.975702130f, 0.980785280f, 0.985277642f, 0.989176510f, 0.992479535f,
+    0.995184727f, 0.997290457f, 0.998795456f, 0.999698819f, 1.000000000f,
+};
+
+/*
+  sine and cosine of omega, for omega from 0 to pi. The nearest table
+  entry is rotated by the remaining angle of at most pi/256 using short
+  series for its sine and cosine, which gives float precision without
+  calling sinf() and cosf(). With per-motor notches there may be dozens
+  of notches retuned every loop and the trig calls dominated the cost
+ */
+static void notch_sin_cos(float omega, float &sin_omega, float &cos_omega)
+{
+    const float pos = constrain_float(omega * float(128 / M_PI), 0, 128);
+    const uint8_t idx = uint8_t(pos + 0.5f);
+    const float d = (pos - idx) * float(M_PI / 128);
+
+    const float sin_i = idx <= 64 ? notch_sin_table[idx] : notch_sin_table[128 - idx];
+    const float cos_i = idx <= 64 ? notch_sin_table[64 - idx] : -notch_sin_table[idx - 64];
+    const float d2 = sq(d);
+    const float sin_d = d * (1.0f - d2 * (1.0f / 6.0f));
+    const float cos_d = 1.0f - d2 * 0.5f;
+
+    sin_omega = sin_i * cos_d + cos_i * sin_d;
+    cos_omega = cos_i * cos_d - sin_i * sin_d;
+}
+
 /*
    calculate the attenuation and quality factors of the filter
  */
@@ -57,11 +104,11 @@ void NotchFilter<T>::init(float sample_freq_hz, float center_freq_hz, float band
 template <class T>
 void NotchFilter<T>::init_with_A_and_Q(float sample_freq_hz, float center_freq_hz, float A, float Q)
 {
-    // don't update if no updates required
+    // don't update if the change is too small to matter
     if (initialised &&
-        is_equal(center_freq_hz, _center_freq_hz) &&
+        fabsf(center_freq_hz - _center_freq_hz) <= _center_freq_hz * NOTCH_MIN_FREQ_CHANGE &&
         is_equal(sample_freq_hz, _sample_freq_hz) &&
-        is_equal(A, _A)) {
+        fabsf(A - _A) <= NOTCH_MIN_A_CHANGE) {
         return;
     }
 
@@ -75,9 +122,11 @@ void NotchFilter<T>::init_with_A_and_Q(float sample_freq_hz, float center_freq_h
 
     if (is_positive(new_center_freq) && (new_center_freq < 0.5 * sample_freq_hz) && (Q > 0.0)) {
         float omega = 2.0 * M_PI * new_center_freq / sample_freq_hz;
-        float alpha = sinf(omega) / (2 * Q);
+        float sin_omega, cos_omega;
+        notch_sin_cos(omega, sin_omega, cos_omega);
+        float alpha = sin_omega / (2 * Q);
         b0 =  1.0 + alpha*sq(A);
-        b1 = -2.0 * cosf(omega);
+        b1 = -2.0 * cos_omega;
         b2 =  1.0 - alpha*sq(A);
         a1 = b1;
         a2 =  1.0 - alpha;
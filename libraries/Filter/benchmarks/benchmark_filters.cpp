@@ -0,0 +1,133 @@
+#include <AP_gbenchmark.h>
+
+#include <Filter/Filter.h>
+#include <Filter/LowPassFilter2p.h>
+#include <Filter/NotchFilter.h>
+#include <Filter/HarmonicNotchFilter.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const float sample_rate_hz = 2000;
+
+// a gyro-like input which changes every sample
+template <class T>
+static T sample_input(uint32_t i);
+
+template <>
+float sample_input<float>(uint32_t i)
+{
+    return sinf(i * 0.1f);
+}
+
+template <>
+Vector3f sample_input<Vector3f>(uint32_t i)
+{
+    return Vector3f(sinf(i * 0.1f), cosf(i * 0.13f), sinf(i * 0.17f));
+}
+
+template <class T>
+static void BM_LowPassFilter2p(benchmark::State& state)
+{
+    LowPassFilter2p<T> filter{sample_rate_hz, 80};
+    T input[64];
+    for (uint8_t i=0; i<ARRAY_SIZE(input); i++) {
+        input[i] = sample_input<T>(i);
+    }
+    uint32_t n = 0;
+    while (state.KeepRunning()) {
+        T out = filter.apply(input[n++ % ARRAY_SIZE(input)]);
+        gbenchmark_escape(&out);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_LowPassFilter2p, float);
+BENCHMARK_TEMPLATE(BM_LowPassFilter2p, Vector3f);
+
+template <class T>
+static void BM_NotchFilter(benchmark::State& state)
+{
+    NotchFilter<T> filter;
+    filter.init(sample_rate_hz, 120, 60, 40);
+    T input[64];
+    for (uint8_t i=0; i<ARRAY_SIZE(input); i++) {
+        input[i] = sample_input<T>(i);
+    }
+    uint32_t n = 0;
+    while (state.KeepRunning()) {
+        T out = filter.apply(input[n++ % ARRAY_SIZE(input)]);
+        gbenchmark_escape(&out);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_NotchFilter, float);
+BENCHMARK_TEMPLATE(BM_NotchFilter, Vector3f);
+
+/*
+  harmonic notch on a gyro vector, with range(0) sources (e.g. one per
+  motor for ESC telemetry) each with range(1) harmonics and a double
+  notch
+ */
+static void BM_HarmonicNotchFilter_apply(benchmark::State& state)
+{
+    const uint8_t num_sources = state.range(0);
+    const uint8_t num_harmonics = state.range(1);
+
+    HarmonicNotchFilterParams params {};
+    params.set_options(uint16_t(HarmonicNotchFilterParams::Options::DoubleNotch));
+    params.set_attenuation(40);
+    params.set_bandwidth_hz(40);
+    params.set_center_freq_hz(80);
+    params.set_freq_min_ratio(1.0);
+
+    HarmonicNotchFilter<Vector3f> filter {};
+    filter.allocate_filters(num_sources, (1U<<num_harmonics)-1, params.num_composite_notches());
+    filter.init(sample_rate_hz, params);
+    float freqs[16];
+    for (uint8_t i=0; i<num_sources; i++) {
+        freqs[i] = 80 + i;
+    }
+    filter.update(num_sources, freqs);
+
+    Vector3f input[64];
+    for (uint8_t i=0; i<ARRAY_SIZE(input); i++) {
+        input[i] = sample_input<Vector3f>(i);
+    }
+    uint32_t n = 0;
+    while (state.KeepRunning()) {
+        Vector3f out = filter.apply(input[n++ % ARRAY_SIZE(input)]);
+        gbenchmark_escape(&out);
+    }
+}
+
+BENCHMARK(BM_HarmonicNotchFilter_apply)->Args({1, 1})->Args({1, 3})->Args({4, 3})->Args({8, 3});
+
+// cost of retuning all the notches, as done at loop rate with
+// dynamic notches
+static void BM_HarmonicNotchFilter_update(benchmark::State& state)
+{
+    HarmonicNotchFilterParams params {};
+    params.set_options(uint16_t(HarmonicNotchFilterParams::Options::DoubleNotch));
+    params.set_attenuation(40);
+    params.set_bandwidth_hz(40);
+    params.set_center_freq_hz(80);
+    params.set_freq_min_ratio(1.0);
+
+    HarmonicNotchFilter<Vector3f> filter {};
+    filter.allocate_filters(8, 0x7, params.num_composite_notches());
+    filter.init(sample_rate_hz, params);
+
+    float freqs[8];
+    uint32_t n = 0;
+    while (state.KeepRunning()) {
+        for (uint8_t i=0; i<ARRAY_SIZE(freqs); i++) {
+            freqs[i] = 80 + ((n + i) % 20);
+        }
+        n++;
+        filter.update(ARRAY_SIZE(freqs), freqs);
+        gbenchmark_clobber();
+    }
+}
+
+BENCHMARK(BM_HarmonicNotchFilter_update);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,64 @@
+#include <AP_gtest.h>
+
+#include <Filter/FIRDecimator.h>
+
+/*
+  a constant input should come out unchanged once the filter is full,
+  at one output for every factor inputs
+ */
+TEST(FIRDecimatorTest, DCGain)
+{
+    FIRDecimatorFloat filter;
+    EXPECT_TRUE(filter.init(4));
+    EXPECT_EQ(4, filter.get_factor());
+
+    uint16_t outputs = 0;
+    float out = 0;
+    for (uint16_t i=0; i<400; i++) {
+        if (filter.apply(3.0f, out)) {
+            outputs++;
+        }
+    }
+    EXPECT_EQ(100, outputs);
+    EXPECT_NEAR(3.0f, out, 1.0e-4f);
+}
+
+/*
+  a tone above the Nyquist frequency of the output rate should be
+  strongly attenuated, a tone well below it should pass
+ */
+TEST(FIRDecimatorTest, Aliasing)
+{
+    const uint8_t factor = 4;
+    const float rate = 8000;
+    const float output_nyquist = 0.5f * rate / factor;
+
+    for (float freq : { 0.8f * rate / factor, 0.1f * output_nyquist }) {
+        FIRDecimatorVector3f filter;
+        EXPECT_TRUE(filter.init(factor));
+        float peak = 0;
+        for (uint16_t i=0; i<2000; i++) {
+            const float v = sinf(M_2PI * freq * i / rate);
+            Vector3f out;
+            if (filter.apply(Vector3f{v, v, v}, out) && i > 200) {
+                peak = MAX(peak, fabsf(out.x));
+            }
+        }
+        if (freq > output_nyquist) {
+            EXPECT_LT(peak, 0.01f);
+        } else {
+            EXPECT_GT(peak, 0.9f);
+        }
+    }
+}
+
+TEST(FIRDecimatorTest, Uninitialised)
+{
+    FIRDecimatorFloat filter;
+    float out = 0;
+    EXPECT_TRUE(filter.apply(2.0f, out));
+    EXPECT_FLOAT_EQ(2.0f, out);
+    EXPECT_FALSE(filter.init(1));
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,53 @@
+#include <AP_gtest.h>
+
+#include <algorithm>
+
+#include <Filter/Filter.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// median of the last n samples by sorting a copy
+template <class T>
+static T brute_force_median(const T *history, uint16_t count, uint8_t n)
+{
+    const uint8_t len = count < n ? count : n;
+    T window[255];
+    for (uint8_t i=0; i<len; i++) {
+        window[i] = history[count - len + i];
+    }
+    std::sort(&window[0], &window[len]);
+    return window[len / 2];
+}
+
+TEST(MedianFilterTest, Int16_Size5)
+{
+    MedianFilterInt16_Size5 filt;
+    EXPECT_EQ(3, filt.apply(3));
+    EXPECT_EQ(3, filt.apply(1));
+    EXPECT_EQ(2, filt.apply(2));
+    EXPECT_EQ(3, filt.apply(10));
+    EXPECT_EQ(3, filt.apply(10));
+    // 3 drops out of the window
+    EXPECT_EQ(10, filt.apply(10));
+    // a single glitch is rejected
+    EXPECT_EQ(10, filt.apply(-100));
+    EXPECT_EQ(10, filt.get());
+
+    filt.reset();
+    EXPECT_EQ(7, filt.apply(7));
+}
+
+TEST(MedianFilterTest, Float_Size15)
+{
+    MedianFilterFloat_Size15 filt;
+    float history[500];
+    uint32_t seed = 1;
+    for (uint16_t i=0; i<ARRAY_SIZE(history); i++) {
+        seed = seed * 1103515245U + 12345U;
+        // include repeated values to exercise the equal-value handling
+        history[i] = float((seed >> 16) % 50);
+        EXPECT_FLOAT_EQ(brute_force_median(history, i+1, 15), filt.apply(history[i]));
+    }
+}
+
+AP_GTEST_MAIN()
@@ -20,6 +20,7 @@
 #include <AP_GPS/AP_GPS.h>
 #include <RC_Channel/RC_Channel.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
+#include <AP_Common/ExpandingString.h>
 
 #include "MissionItemProtocol_Waypoints.h"
 #include "MissionItemProtocol_Rally.h"
@@ -54,7 +55,7 @@ const AP_Param::GroupInfo GCS::var_info[] {
     // @Param: _OPTIONS
     // @DisplayName: MAVLink Options
     // @Description: Alters various behaviour of the MAVLink interface
-    // @Bitmask: 0:Accept MAVLink only from SYSID_GCS
+    // @Bitmask: 0:Accept MAVLink only from SYSID_GCS, 1:Pipeline mission item requests
     // @User: Advanced
     AP_GROUPINFO("_OPTIONS",    3,      GCS, mav_options, 0),
 
@@ -204,6 +205,106 @@ void GCS::send_to_active_channels(uint32_t msgid, const char *pkt)
     }
 }
 
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+bool GCS::get_cached_payload(uint32_t msgid, void *payload, uint8_t len) const
+{
+    if (num_gcs() < 2) {
+        // nobody to share with
+        return false;
+    }
+    for (const auto &entry : cached_payload) {
+        if (entry.generation == payload_cache_generation &&
+            entry.msgid == msgid &&
+            entry.len == len) {
+            memcpy(payload, entry.payload, len);
+            return true;
+        }
+    }
+    return false;
+}
+
+void GCS::cache_payload(uint32_t msgid, const void *payload, uint8_t len)
+{
+    if (num_gcs() < 2 || len > sizeof(cached_payload[0].payload)) {
+        return;
+    }
+    // reuse this message's entry or one which is stale
+    cached_payload_t *slot = nullptr;
+    for (auto &entry : cached_payload) {
+        if (entry.msgid == msgid) {
+            slot = &entry;
+            break;
+        }
+        if (slot == nullptr && entry.generation != payload_cache_generation) {
+            slot = &entry;
+        }
+    }
+    if (slot == nullptr) {
+        return;
+    }
+    slot->msgid = msgid;
+    slot->generation = payload_cache_generation;
+    slot->len = len;
+    memcpy(slot->payload, payload, len);
+}
+#endif  // AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+
+#if AP_MAVLINK_STATS_ENABLED
+void GCS::record_message_time(uint32_t msgid, uint32_t dt_us)
+{
+    for (uint8_t i=0; i<ARRAY_SIZE(msg_stats); i++) {
+        msg_stats_t &entry = msg_stats[(msgid + i) % ARRAY_SIZE(msg_stats)];
+        if (entry.count == 0) {
+            entry.msgid = msgid;
+        } else if (entry.msgid != msgid) {
+            continue;
+        }
+        entry.count++;
+        entry.total_us += dt_us;
+        entry.max_us = MAX(entry.max_us, dt_us);
+        return;
+    }
+    msg_stats_overflow++;
+}
+
+/*
+  report MAVLink processing time, for @SYS/mavlink_stats.txt
+ */
+void GCS::mavlink_stats(ExpandingString &str) const
+{
+    // a header to allow for machine parsers to determine format
+    str.printf("MAVLINKV1\n");
+    for (uint8_t i=0; i<num_gcs(); i++) {
+        const GCS_MAVLINK *c = chan(i);
+        if (c == nullptr) {
+            continue;
+        }
+        const GCS_MAVLINK::PerfStats &p = c->get_perf_stats();
+        str.printf("CHAN%u rx=%u parse=%uus handle=%uus tx=%u send=%uus\n",
+                   unsigned(i),
+                   unsigned(p.rx_count),
+                   unsigned(p.parse_us),
+                   unsigned(p.handle_us),
+                   unsigned(p.send_count),
+                   unsigned(p.send_us));
+    }
+    for (const auto &entry : msg_stats) {
+        if (entry.count == 0) {
+            continue;
+        }
+        str.printf("MSG%-5u count=%u total=%uus avg=%uus max=%uus\n",
+                   unsigned(entry.msgid),
+                   unsigned(entry.count),
+                   unsigned(entry.total_us),
+                   unsigned(entry.total_us / entry.count),
+                   unsigned(entry.max_us));
+    }
+    if (msg_stats_overflow > 0) {
+        str.printf("untracked=%u\n", unsigned(msg_stats_overflow));
+    }
+}
+#endif  // AP_MAVLINK_STATS_ENABLED
+
 void GCS::send_named_float(const char *name, float value) const
 {
 
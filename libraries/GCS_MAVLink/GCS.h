@@ -430,6 +430,18 @@ public:
     // return true if channel is private
     bool is_private(void) const { return is_private(chan); }
 
+#if AP_MAVLINK_STATS_ENABLED
+    // cumulative time spent processing this link's traffic
+    struct PerfStats {
+        uint32_t parse_us;   // update_receive, less time in packetReceived
+        uint32_t handle_us;  // time in packetReceived
+        uint32_t rx_count;
+        uint32_t send_us;    // time in try_send_message
+        uint32_t send_count;
+    };
+    const PerfStats &get_perf_stats() const { return perf_stats; }
+#endif
+
 #if HAL_HIGH_LATENCY2_ENABLED
     // true if this is a high latency link
     bool is_high_latency_link;
@@ -511,6 +523,19 @@ protected:
     // saveable rate of each stream
     AP_Int16        streamRates[NUM_STREAMS];
 
+#if AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED
+    // adapt stream_slowdown_ms to the link's capacity
+    AP_Int8         adaptive_streams;
+    struct {
+        uint32_t last_update_ms;
+        uint32_t radio_status_ms; // RADIO_STATUS last seen on this link
+        uint16_t last_out_of_space_count;
+        uint16_t last_rxerrors;
+    } adaptive;
+    void update_adaptive_slowdown(uint32_t now_ms);
+    void adaptive_slowdown_from_radio_status(const mavlink_radio_t &packet, uint32_t now_ms);
+#endif
+
     void handle_heartbeat(const mavlink_message_t &msg) const;
 
     virtual bool persist_streamrates() const { return false; }
@@ -848,6 +873,9 @@ private:
         Bitmask<MSG_LAST> ap_message_ids;
         uint16_t interval_ms;
         uint16_t last_sent_ms; // from AP_HAL::millis16()
+        // interval used to order the bucket in bucket_heap; the
+        // result of get_reschedule_interval_ms when last scheduled
+        uint16_t scheduled_interval_ms;
     };
     deferred_message_bucket_t deferred_message_bucket[10];
     static const uint8_t no_bucket_to_send = -1;
@@ -855,6 +883,17 @@ private:
     uint8_t sending_bucket_id = no_bucket_to_send;
     Bitmask<MSG_LAST> bucket_message_ids_to_send;
 
+    // min-heap of the in-use buckets ordered on the time until each
+    // is next due.  Passing time does not change the order, so only
+    // the bucket just sent needs to be moved; allocating or freeing a
+    // bucket marks the heap for rebuilding.
+    uint8_t bucket_heap[ARRAY_SIZE(deferred_message_bucket)];
+    uint8_t bucket_heap_len;
+    bool bucket_heap_rebuild_needed;
+    uint16_t ms_before_bucket_due(uint8_t bucket, uint16_t now16_ms) const;
+    void bucket_heap_sift_down(uint8_t pos, uint16_t now16_ms);
+    void bucket_heap_rebuild(uint16_t now16_ms);
+
     ap_message next_deferred_bucket_message_to_send(uint16_t now16_ms);
     void find_next_bucket_to_send(uint16_t now16_ms);
     void remove_message_from_bucket(int8_t bucket, ap_message id);
@@ -903,6 +942,10 @@ private:
     // When sending parameters and waypoints this may be longer than
     // the interval specified in "deferred"
     uint16_t get_reschedule_interval_ms(const deferred_message_bucket_t &deferred) const;
+#if AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED
+    // true if a bucket holds messages which should be slowed less
+    bool bucket_is_critical(const deferred_message_bucket_t &deferred) const;
+#endif
 
     bool do_try_send_message(const ap_message id);
 
@@ -1018,6 +1061,8 @@ private:
     static void ftp_error(struct pending_ftp &response, FTP_ERROR error); // FTP helper method for packing a NAK
     static int gen_dir_entry(char *dest, size_t space, const char * path, const struct dirent * entry); // FTP helper for emitting a dir response
     static void ftp_list_dir(struct pending_ftp &request, struct pending_ftp &response);
+    static void ftp_read_file(const pending_ftp &request, pending_ftp &reply);
+    void ftp_read_gap(const pending_ftp &request);
 
     bool ftp_init(void);
     void handle_file_transfer_protocol(const mavlink_message_t &msg);
@@ -1107,6 +1152,12 @@ private:
 
     uint32_t last_mavlink_stats_logged;
 
+#if AP_MAVLINK_STATS_ENABLED
+    PerfStats perf_stats;
+    // perf_stats as of the last MAVP log message
+    PerfStats perf_stats_logged;
+#endif
+
     uint8_t last_battery_status_idx;
 
     // if we've ever sent a DISTANCE_SENSOR message out of an
@@ -1240,6 +1291,7 @@ public:
 
     enum class Option {
       GCS_SYSID_ENFORCE = (1U << 0),
+      MISSION_UPLOAD_PIPELINE = (1U << 1),
     };
     bool option_is_enabled(Option option) const {
         return (mav_options & (uint16_t)option) != 0;
@@ -1319,6 +1371,21 @@ public:
     uint8_t get_available_modes_sequence() const { return available_modes_sequence; }
     void available_modes_changed() { available_modes_sequence += 1; }
 
+#if AP_MAVLINK_STATS_ENABLED
+    // record the time taken to handle a received message
+    void record_message_time(uint32_t msgid, uint32_t dt_us);
+    // fill in @SYS/mavlink_stats.txt
+    void mavlink_stats(class ExpandingString &str) const;
+#endif
+
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+    // a payload packed by one link may be reused by the other links
+    // during the same update_send.  Sequence number, checksum and
+    // signing are still applied per-link when the payload is sent.
+    bool get_cached_payload(uint32_t msgid, void *payload, uint8_t len) const;
+    void cache_payload(uint32_t msgid, const void *payload, uint8_t len);
+#endif
+
 protected:
 
     virtual GCS_MAVLINK *new_gcs_mavlink_backend(AP_HAL::UARTDriver &uart) = 0;
@@ -1409,6 +1476,31 @@ private:
     // Sequence number should be incremented when available modes changes
     // Sent in AVAILABLE_MODES_MONITOR msg
     uint8_t available_modes_sequence;
+
+#if AP_MAVLINK_STATS_ENABLED
+    // receive statistics for the first AP_MAVLINK_STATS_NUM_MSGS
+    // message IDs seen, in an open-addressed table keyed on msgid
+    struct msg_stats_t {
+        uint32_t msgid;
+        uint32_t count;    // zero if the slot is unused
+        uint32_t total_us;
+        uint32_t max_us;
+    } msg_stats[AP_MAVLINK_STATS_NUM_MSGS];
+    // messages received after the table filled
+    uint32_t msg_stats_overflow;
+#endif
+
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+    // incremented on each update_send; cache entries from an earlier
+    // generation are stale
+    uint32_t payload_cache_generation;
+    struct cached_payload_t {
+        uint32_t msgid;
+        uint32_t generation;
+        uint8_t len;
+        uint8_t payload[48];
+    } cached_payload[4];
+#endif
 };
 
 GCS &gcs();
@@ -877,6 +877,10 @@ void GCS_MAVLINK::handle_radio_status(const mavlink_message_t &msg)
 
     last_radio_status.txbuf = packet.txbuf;
 
+#if AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED
+    adaptive_slowdown_from_radio_status(packet, now);
+#endif
+
     // use the state of the transmit buffer in the radio to
     // control the stream rate, giving us adaptive software
     // flow control
@@ -1203,11 +1207,84 @@ bool GCS_MAVLINK::should_send_message_in_delay_callback(const ap_message id) con
     return false;
 }
 
+#if AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED
+bool GCS_MAVLINK::bucket_is_critical(const deferred_message_bucket_t &deferred) const
+{
+    return deferred.ap_message_ids.get(MSG_ATTITUDE) ||
+        deferred.ap_message_ids.get(MSG_LOCATION) ||
+        deferred.ap_message_ids.get(MSG_SYS_STATUS);
+}
+
+/*
+  for links which do not report RADIO_STATUS, slow the streams down
+  while messages are failing to fit in the transmit buffer and speed
+  them back up once they fit again
+ */
+void GCS_MAVLINK::update_adaptive_slowdown(uint32_t now_ms)
+{
+    if (adaptive_streams == 0) {
+        return;
+    }
+    if (now_ms - adaptive.last_update_ms < 250) {
+        return;
+    }
+    adaptive.last_update_ms = now_ms;
+
+    const uint16_t drops = out_of_space_to_send_count - adaptive.last_out_of_space_count;
+    adaptive.last_out_of_space_count = out_of_space_to_send_count;
+
+    if (adaptive.radio_status_ms != 0 && now_ms - adaptive.radio_status_ms < 5000) {
+        // the radio's txbuf is a better measure; handle_radio_status
+        // does the adjustment
+        return;
+    }
+
+    if (drops > 0) {
+        // back off quickly, more for many failures
+        stream_slowdown_ms = MIN(stream_slowdown_ms + MIN(drops * 10U, 100U), 2000U);
+    } else if (stream_slowdown_ms > 0) {
+        // recover smoothly
+        const uint16_t step = MAX(stream_slowdown_ms / 8U, 10U);
+        stream_slowdown_ms = stream_slowdown_ms > step ? stream_slowdown_ms - step : 0;
+    }
+#if GCS_DEBUG_SEND_MESSAGE_TIMINGS
+    if (stream_slowdown_ms > max_slowdown_ms) {
+        max_slowdown_ms = stream_slowdown_ms;
+    }
+#endif
+}
+
+/*
+  receive errors mean the radio link is losing packets, so sending
+  less leaves more airtime for retries
+ */
+void GCS_MAVLINK::adaptive_slowdown_from_radio_status(const mavlink_radio_t &packet, uint32_t now_ms)
+{
+    const bool had_status = adaptive.radio_status_ms != 0;
+    adaptive.radio_status_ms = now_ms;
+    const uint16_t new_errors = packet.rxerrors - adaptive.last_rxerrors;
+    adaptive.last_rxerrors = packet.rxerrors;
+    if (adaptive_streams == 0 || !had_status) {
+        return;
+    }
+    if (new_errors > 0 && stream_slowdown_ms < 2000) {
+        stream_slowdown_ms += MIN(new_errors * 5U, 40U);
+    }
+}
+#endif  // AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED
+
 uint16_t GCS_MAVLINK::get_reschedule_interval_ms(const deferred_message_bucket_t &deferred) const
 {
     uint32_t interval_ms = deferred.interval_ms;
 
-    interval_ms += stream_slowdown_ms;
+#if AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED
+    if (adaptive_streams != 0 && bucket_is_critical(deferred)) {
+        interval_ms += stream_slowdown_ms / 4;
+    } else
+#endif
+    {
+        interval_ms += stream_slowdown_ms;
+    }
 
     // slow most messages down if we're transfering parameters or
     // waypoints:
@@ -1233,6 +1310,65 @@ uint16_t GCS_MAVLINK::get_reschedule_interval_ms(const deferred_message_bucket_t
     return interval_ms;
 }
 
+// return the number of ms until a bucket should be sent, zero if
+// it is overdue.  This is a non-decreasing function of the bucket's
+// due time, so the heap order is kept as time passes
+uint16_t GCS_MAVLINK::ms_before_bucket_due(uint8_t bucket, uint16_t now16_ms) const
+{
+    const deferred_message_bucket_t &b = deferred_message_bucket[bucket];
+    const uint16_t ms_since_last_sent = now16_ms - b.last_sent_ms;
+    if (ms_since_last_sent > b.scheduled_interval_ms) {
+        // should already have sent this bucket!
+        return 0;
+    }
+    return b.scheduled_interval_ms - ms_since_last_sent;
+}
+
+void GCS_MAVLINK::bucket_heap_sift_down(uint8_t pos, uint16_t now16_ms)
+{
+    while (true) {
+        const uint8_t left = 2*pos + 1;
+        if (left >= bucket_heap_len) {
+            return;
+        }
+        uint8_t smallest = left;
+        uint16_t smallest_ms = ms_before_bucket_due(bucket_heap[left], now16_ms);
+        const uint8_t right = left + 1;
+        if (right < bucket_heap_len) {
+            const uint16_t right_ms = ms_before_bucket_due(bucket_heap[right], now16_ms);
+            if (right_ms < smallest_ms) {
+                smallest = right;
+                smallest_ms = right_ms;
+            }
+        }
+        if (ms_before_bucket_due(bucket_heap[pos], now16_ms) <= smallest_ms) {
+            return;
+        }
+        const uint8_t tmp = bucket_heap[pos];
+        bucket_heap[pos] = bucket_heap[smallest];
+        bucket_heap[smallest] = tmp;
+        pos = smallest;
+    }
+}
+
+void GCS_MAVLINK::bucket_heap_rebuild(uint16_t now16_ms)
+{
+    bucket_heap_len = 0;
+    for (uint8_t i=0; i<ARRAY_SIZE(deferred_message_bucket); i++) {
+        deferred_message_bucket_t &bucket = deferred_message_bucket[i];
+        if (bucket.ap_message_ids.count() == 0) {
+            // no entries
+            continue;
+        }
+        bucket.scheduled_interval_ms = get_reschedule_interval_ms(bucket);
+        bucket_heap[bucket_heap_len++] = i;
+    }
+    for (int8_t i=bucket_heap_len/2-1; i>=0; i--) {
+        bucket_heap_sift_down(i, now16_ms);
+    }
+    bucket_heap_rebuild_needed = false;
+}
+
 // typical runtime on fmuv3: 5 microseconds for 3 buckets
 void GCS_MAVLINK::find_next_bucket_to_send(uint16_t now16_ms)
 {
@@ -1242,27 +1378,14 @@ void GCS_MAVLINK::find_next_bucket_to_send(uint16_t now16_ms)
 #endif
 
     // all done sending this bucket... find another bucket...
-    sending_bucket_id = no_bucket_to_send;
-    uint16_t ms_before_send_next_bucket_to_send = UINT16_MAX;
-    for (uint8_t i=0; i<ARRAY_SIZE(deferred_message_bucket); i++) {
-        if (deferred_message_bucket[i].ap_message_ids.count() == 0) {
-            // no entries
-            continue;
-        }
-        const uint16_t interval = get_reschedule_interval_ms(deferred_message_bucket[i]);
-        const uint16_t ms_since_last_sent = now16_ms - deferred_message_bucket[i].last_sent_ms;
-        uint16_t ms_before_send_this_bucket;
-        if (ms_since_last_sent > interval) {
-            // should already have sent this bucket!
-            ms_before_send_this_bucket = 0;
-        } else {
-            ms_before_send_this_bucket = interval - ms_since_last_sent;
-        }
-        if (ms_before_send_this_bucket < ms_before_send_next_bucket_to_send) {
-            sending_bucket_id = i;
-            ms_before_send_next_bucket_to_send = ms_before_send_this_bucket;
-        }
-    }
+    if (bucket_heap_rebuild_needed) {
+        bucket_heap_rebuild(now16_ms);
+    } else if (bucket_heap_len > 0) {
+        // the bucket we were sending is at the top of the heap and
+        // may just have been rescheduled
+        bucket_heap_sift_down(0, now16_ms);
+    }
+    sending_bucket_id = (bucket_heap_len > 0) ? bucket_heap[0] : no_bucket_to_send;
     if (sending_bucket_id != no_bucket_to_send) {
         bucket_message_ids_to_send = deferred_message_bucket[sending_bucket_id].ap_message_ids;
     } else {
@@ -1320,7 +1443,15 @@ bool GCS_MAVLINK::do_try_send_message(const ap_message id)
     void *data = hal.scheduler->disable_interrupts_save();
     uint32_t start_send_message_us = AP_HAL::micros();
 #endif
+#if AP_MAVLINK_STATS_ENABLED
+    const uint32_t send_start_us = AP_HAL::micros();
+    const bool sent = try_send_message(id);
+    perf_stats.send_us += AP_HAL::micros() - send_start_us;
+    perf_stats.send_count++;
+    if (!sent) {
+#else
     if (!try_send_message(id)) {
+#endif
         // didn't fit in buffer...
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
         try_send_message_stats.no_space_for_message++;
@@ -1540,6 +1671,10 @@ void GCS_MAVLINK::update_send()
     // check for any in-progress tasks; check_tasks does its own rate-limiting
     GCS_MAVLINK_InProgress::check_tasks();
 
+#if AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED
+    update_adaptive_slowdown(AP_HAL::millis());
+#endif
+
     const uint32_t start = AP_HAL::millis();
     const uint16_t start16 = start & 0xFFFF;
     while (AP_HAL::millis() - start < 5) { // spend a max of 5ms sending messages.  This should never trigger - out_of_time() should become true
@@ -1618,6 +1753,7 @@ void GCS_MAVLINK::update_send()
                 if (uint16_t(start16 - deferred_message_bucket[sending_bucket_id].last_sent_ms) > interval_ms) {
                     deferred_message_bucket[sending_bucket_id].last_sent_ms = start16;
                 }
+                deferred_message_bucket[sending_bucket_id].scheduled_interval_ms = interval_ms;
                 find_next_bucket_to_send(start16);
             }
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
@@ -1655,6 +1791,7 @@ void GCS_MAVLINK::remove_message_from_bucket(int8_t bucket, ap_message id)
         // bucket empty.  Free it:
         deferred_message_bucket[bucket].interval_ms = 0;
         deferred_message_bucket[bucket].last_sent_ms = 0;
+        bucket_heap_rebuild_needed = true;
     }
 
     if (bucket == sending_bucket_id) {
@@ -1767,6 +1904,7 @@ bool GCS_MAVLINK::set_ap_message_interval(enum ap_message id, uint16_t interval_
         // allocate a bucket for this interval
         deferred_message_bucket[empty_bucket_id].interval_ms = interval_ms;
         deferred_message_bucket[empty_bucket_id].last_sent_ms = AP_HAL::millis16();
+        bucket_heap_rebuild_needed = true;
         closest_bucket = empty_bucket_id;
     }
 
@@ -1882,6 +2020,10 @@ GCS_MAVLINK::update_receive(uint32_t max_time_us)
 
     status.packet_rx_drop_count = 0;
 
+#if AP_MAVLINK_STATS_ENABLED
+    uint32_t handle_us = 0;
+#endif
+
     const uint16_t nbytes = _port->available();
     for (uint16_t i=0; i<nbytes; i++)
     {
@@ -1915,7 +2057,16 @@ GCS_MAVLINK::update_receive(uint32_t max_time_us)
         const uint8_t framing = mavlink_frame_char_buffer(channel_buffer(), channel_status(), c, &msg, &status);
         if (framing == MAVLINK_FRAMING_OK) {
             hal.util->persistent_data.last_mavlink_msgid = msg.msgid;
+#if AP_MAVLINK_STATS_ENABLED
+            const uint32_t handle_start_us = AP_HAL::micros();
             packetReceived(status, msg);
+            const uint32_t dt_us = AP_HAL::micros() - handle_start_us;
+            handle_us += dt_us;
+            perf_stats.rx_count++;
+            gcs().record_message_time(msg.msgid, dt_us);
+#else
+            packetReceived(status, msg);
+#endif
             parsed_packet = true;
             gcs_alternative_active[chan] = false;
             alternative.last_mavlink_ms = now_ms;
@@ -1940,6 +2091,11 @@ GCS_MAVLINK::update_receive(uint32_t max_time_us)
         }
     }
 
+#if AP_MAVLINK_STATS_ENABLED
+    perf_stats.handle_us += handle_us;
+    perf_stats.parse_us += (AP_HAL::micros() - tstart_us) - handle_us;
+#endif
+
     const uint32_t tnow = AP_HAL::millis();
 
     // send a timesync message every 10 seconds; this is for data
@@ -2076,6 +2232,23 @@ void GCS_MAVLINK::log_mavlink_stats()
     };
 
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
+
+#if AP_MAVLINK_STATS_ENABLED
+    // time spent on this link since the last MAVP message
+    const struct log_MAV_Perf perf{
+        LOG_PACKET_HEADER_INIT(LOG_MAV_PERF_MSG),
+        time_us    : pkt.time_us,
+        chan       : (uint8_t)chan,
+        rx_count   : perf_stats.rx_count - perf_stats_logged.rx_count,
+        parse_us   : perf_stats.parse_us - perf_stats_logged.parse_us,
+        handle_us  : perf_stats.handle_us - perf_stats_logged.handle_us,
+        send_count : perf_stats.send_count - perf_stats_logged.send_count,
+        send_us    : perf_stats.send_us - perf_stats_logged.send_us,
+    };
+    perf_stats_logged = perf_stats;
+
+    AP::logger().WriteBlock(&perf, sizeof(perf));
+#endif
 }
 #endif
 
@@ -2710,6 +2883,11 @@ void GCS::update_send()
         prot->update();
     }
 
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+    // anything packed before now is out of date:
+    payload_cache_generation++;
+#endif
+
     // round-robin the GCS_MAVLINK backend that gets to go first so
     // one backend doesn't monopolise all of the time allowed for sending
     // messages
@@ -5936,42 +6114,59 @@ void GCS_MAVLINK::send_extended_sys_state() const
 void GCS_MAVLINK::send_attitude() const
 {
 #if AP_AHRS_ENABLED
+    mavlink_attitude_t pkt;
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+    if (gcs().get_cached_payload(MAVLINK_MSG_ID_ATTITUDE, &pkt, sizeof(pkt))) {
+        mavlink_msg_attitude_send_struct(chan, &pkt);
+        return;
+    }
+#endif
     const AP_AHRS &ahrs = AP::ahrs();
     const Vector3f omega = ahrs.get_gyro();
-    mavlink_msg_attitude_send(
-        chan,
-        AP_HAL::millis(),
-        ahrs.get_roll(),
-        ahrs.get_pitch(),
-        ahrs.get_yaw(),
-        omega.x,
-        omega.y,
-        omega.z);
+    pkt.time_boot_ms = AP_HAL::millis();
+    pkt.roll = ahrs.get_roll();
+    pkt.pitch = ahrs.get_pitch();
+    pkt.yaw = ahrs.get_yaw();
+    pkt.rollspeed = omega.x;
+    pkt.pitchspeed = omega.y;
+    pkt.yawspeed = omega.z;
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+    gcs().cache_payload(MAVLINK_MSG_ID_ATTITUDE, &pkt, sizeof(pkt));
+#endif
+    mavlink_msg_attitude_send_struct(chan, &pkt);
 #endif
 }
 
 void GCS_MAVLINK::send_attitude_quaternion() const
 {
 #if AP_AHRS_ENABLED
+    mavlink_attitude_quaternion_t pkt;
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+    if (gcs().get_cached_payload(MAVLINK_MSG_ID_ATTITUDE_QUATERNION, &pkt, sizeof(pkt))) {
+        mavlink_msg_attitude_quaternion_send_struct(chan, &pkt);
+        return;
+    }
+#endif
     const AP_AHRS &ahrs = AP::ahrs();
     Quaternion quat;
     if (!ahrs.get_quaternion(quat)) {
         return;
     }
     const Vector3f omega = ahrs.get_gyro();
-    const float repr_offseq_q[] {0,0,0,0};  // unused, but probably should correspond to the AHRS view?
-    mavlink_msg_attitude_quaternion_send(
-        chan,
-        AP_HAL::millis(),
-        quat.q1,
-        quat.q2,
-        quat.q3,
-        quat.q4,
-        omega.x, // rollspeed
-        omega.y, // pitchspeed
-        omega.z, // yawspeed
-        repr_offseq_q
-        );
+    pkt.time_boot_ms = AP_HAL::millis();
+    pkt.q1 = quat.q1;
+    pkt.q2 = quat.q2;
+    pkt.q3 = quat.q3;
+    pkt.q4 = quat.q4;
+    pkt.rollspeed = omega.x;
+    pkt.pitchspeed = omega.y;
+    pkt.yawspeed = omega.z;
+    // unused, but probably should correspond to the AHRS view?
+    memset(pkt.repr_offset_q, 0, sizeof(pkt.repr_offset_q));
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+    gcs().cache_payload(MAVLINK_MSG_ID_ATTITUDE_QUATERNION, &pkt, sizeof(pkt));
+#endif
+    mavlink_msg_attitude_quaternion_send_struct(chan, &pkt);
 #endif
 }
 
@@ -5992,6 +6187,14 @@ int32_t GCS_MAVLINK::global_position_int_relative_alt() const {
 void GCS_MAVLINK::send_global_position_int()
 {
 #if AP_AHRS_ENABLED
+    mavlink_global_position_int_t pkt;
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+    if (gcs().get_cached_payload(MAVLINK_MSG_ID_GLOBAL_POSITION_INT, &pkt, sizeof(pkt))) {
+        mavlink_msg_global_position_int_send_struct(chan, &pkt);
+        return;
+    }
+#endif
+
     AP_AHRS &ahrs = AP::ahrs();
 
     UNUSED_RESULT(ahrs.get_location(global_position_current_loc)); // return value ignored; we send stale data
@@ -6001,17 +6204,20 @@ void GCS_MAVLINK::send_global_position_int()
         vel.zero();
     }
 
-    mavlink_msg_global_position_int_send(
-        chan,
-        AP_HAL::millis(),
-        global_position_current_loc.lat, // in 1E7 degrees
-        global_position_current_loc.lng, // in 1E7 degrees
-        global_position_int_alt(),       // millimeters above ground/sea level
-        global_position_int_relative_alt(), // millimeters above home
-        vel.x * 100,                     // X speed cm/s (+ve North)
-        vel.y * 100,                     // Y speed cm/s (+ve East)
-        vel.z * 100,                     // Z speed cm/s (+ve Down)
-        ahrs.yaw_sensor);                // compass heading in 1/100 degree
+    pkt.time_boot_ms = AP_HAL::millis();
+    pkt.lat = global_position_current_loc.lat;        // in 1E7 degrees
+    pkt.lon = global_position_current_loc.lng;        // in 1E7 degrees
+    pkt.alt = global_position_int_alt();              // millimeters above ground/sea level
+    pkt.relative_alt = global_position_int_relative_alt(); // millimeters above home
+    pkt.vx = vel.x * 100;                             // X speed cm/s (+ve North)
+    pkt.vy = vel.y * 100;                             // Y speed cm/s (+ve East)
+    pkt.vz = vel.z * 100;                             // Z speed cm/s (+ve Down)
+    pkt.hdg = ahrs.yaw_sensor;                        // compass heading in 1/100 degree
+
+#if AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+    gcs().cache_payload(MAVLINK_MSG_ID_GLOBAL_POSITION_INT, &pkt, sizeof(pkt));
+#endif
+    mavlink_msg_global_position_int_send_struct(chan, &pkt);
 #endif  // AP_AHRS_ENABLED
 }
 
@@ -167,6 +167,57 @@ void GCS_MAVLINK::ftp_push_replies(pending_ftp &reply)
     }
 }
 
+// read request.size bytes at request.offset of the open file into reply
+void GCS_MAVLINK::ftp_read_file(const pending_ftp &request, pending_ftp &reply)
+{
+    // must actually be working on a file
+    if (ftp.fd == -1) {
+        ftp_error(reply, FTP_ERROR::FileNotFound);
+        return;
+    }
+
+    // must have the file in read mode
+    if ((ftp.mode != FTP_FILE_MODE::Read)) {
+        ftp_error(reply, FTP_ERROR::Fail);
+        return;
+    }
+
+    // seek to requested offset
+    if (AP::FS().lseek(ftp.fd, request.offset, SEEK_SET) == -1) {
+        ftp_error(reply, FTP_ERROR::FailErrno);
+        return;
+    }
+
+    // fill the buffer
+    const ssize_t read_bytes = AP::FS().read(ftp.fd, reply.data, MIN(sizeof(reply.data),request.size));
+    if (read_bytes == -1) {
+        ftp_error(reply, FTP_ERROR::FailErrno);
+        return;
+    }
+    if (read_bytes == 0) {
+        ftp_error(reply, FTP_ERROR::EndOfFile);
+        return;
+    }
+
+    reply.opcode = FTP_OP::Ack;
+    reply.offset = request.offset;
+    reply.size = (uint8_t)read_bytes;
+}
+
+// answer a ReadFile request which arrived during a burst read
+void GCS_MAVLINK::ftp_read_gap(const pending_ftp &request)
+{
+    pending_ftp reply {};
+    reply.req_opcode = request.opcode;
+    reply.session = request.session;
+    reply.seq_number = request.seq_number + 1;
+    reply.chan = request.chan;
+    reply.sysid = request.sysid;
+    reply.compid = request.compid;
+    ftp_read_file(request, reply);
+    ftp_push_replies(reply);
+}
+
 void GCS_MAVLINK::ftp_worker(void) {
     pending_ftp request;
     pending_ftp reply = {};
@@ -297,41 +348,8 @@ void GCS_MAVLINK::ftp_worker(void) {
                         break;
                     }
                 case FTP_OP::ReadFile:
-                    {
-                        // must actually be working on a file
-                        if (ftp.fd == -1) {
-                            ftp_error(reply, FTP_ERROR::FileNotFound);
-                            break;
-                        }
-
-                        // must have the file in read mode
-                        if ((ftp.mode != FTP_FILE_MODE::Read)) {
-                            ftp_error(reply, FTP_ERROR::Fail);
-                            break;
-                        }
-
-                        // seek to requested offset
-                        if (AP::FS().lseek(ftp.fd, request.offset, SEEK_SET) == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
-
-                        // fill the buffer
-                        const ssize_t read_bytes = AP::FS().read(ftp.fd, reply.data, MIN(sizeof(reply.data),request.size));
-                        if (read_bytes == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
-                        if (read_bytes == 0) {
-                            ftp_error(reply, FTP_ERROR::EndOfFile);
-                            break;
-                        }
-
-                        reply.opcode = FTP_OP::Ack;
-                        reply.offset = request.offset;
-                        reply.size = (uint8_t)read_bytes;
-                        break;
-                    }
+                    ftp_read_file(request, reply);
+                    break;
                 case FTP_OP::Ack:
                 case FTP_OP::Nack:
                     // eat these, we just didn't expect them
@@ -538,6 +556,37 @@ void GCS_MAVLINK::ftp_worker(void) {
                             // prep the reply to be used again
                             reply.seq_number++;
 
+                            /*
+                              a re-request for a chunk lost earlier in
+                              this burst is answered straight away
+                              rather than queueing behind the rest of
+                              the burst, so on high latency links the
+                              gaps are filled while the burst is still
+                              streaming. Any other request supersedes
+                              the burst.
+                             */
+                            pending_ftp next_request;
+                            bool superseded = false;
+                            bool gap_filled = false;
+                            while (ftp.requests->peek(next_request)) {
+                                if (next_request.opcode != FTP_OP::ReadFile ||
+                                    next_request.session != ftp.current_session) {
+                                    superseded = true;
+                                    break;
+                                }
+                                UNUSED_RESULT(ftp.requests->pop());
+                                ftp_read_gap(next_request);
+                                gap_filled = true;
+                            }
+                            if (superseded) {
+                                break;
+                            }
+                            if (gap_filled &&
+                                AP::FS().lseek(ftp.fd, request.offset + i * max_read + read_bytes, SEEK_SET) == -1) {
+                                ftp_error(reply, FTP_ERROR::FailErrno);
+                                break;
+                            }
+
                             hal.scheduler->delay(burst_delay_ms);
                         }
 
@@ -37,6 +37,7 @@ extern const AP_HAL::HAL& hal;
 // mavlink/pymavlink project for when MAVLINK_SEPARATE_HELPERS is defined
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmissing-declarations"
+#include "GCS_SHA256.h"
 #include "include/mavlink/v2.0/mavlink_helpers.h"
 #pragma GCC diagnostic pop
 #endif
@@ -202,6 +202,16 @@ const AP_Param::GroupInfo GCS_MAVLINK::var_info[] = {
     // @RebootRequired: True
     // @User: Advanced
     AP_GROUPINFO("_ADSB",   10, GCS_MAVLINK, streamRates[GCS_MAVLINK::STREAM_ADSB], DRATE(GCS_MAVLINK::STREAM_ADSB)),
+
+#if AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED
+    // @Param: _ADAPT
+    // @DisplayName: Adaptive stream rates
+    // @Description: When enabled the streams on this link are slowed while messages are being dropped because the link is full, and sped up again once it clears. Receive errors reported in RADIO_STATUS also slow the streams. Attitude, position and system status are slowed less than other messages.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("_ADAPT",  11, GCS_MAVLINK, adaptive_streams, 0),
+#endif
+
     AP_GROUPEND
 };
 #undef DRATE
@@ -0,0 +1,163 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+  SHA-256 for MAVLink2 signing using the ARMv8 SHA-2 instructions.
+
+  The generated mavlink_sha256.h lets an implementation provide its
+  own sha256 with the same API by defining HAVE_MAVLINK_SHA256. This
+  must be included before mavlink_helpers.h, and only from the one
+  translation unit which includes the helpers.
+
+  The 32 byte secret key is only half a SHA-256 block, so there is no
+  compression work that can be done once per link; each packet costs
+  one block for the key, header and short payloads, plus one block for
+  every further 64 bytes.
+ */
+#pragma once
+
+#include "GCS_config.h"
+
+#if AP_MAVLINK_SIGNING_ARM_SHA256_ENABLED
+
+#include <arm_neon.h>
+#include <stdint.h>
+#include <string.h>
+
+#define HAVE_MAVLINK_SHA256
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t len;           // bytes hashed so far
+    uint8_t buf[64];        // partial block
+} mavlink_sha256_ctx;
+
+static const uint32_t mavlink_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+// run the compression function over nblocks 64 byte blocks
+static inline void mavlink_sha256_blocks(uint32_t state[8], const uint8_t *data, uint32_t nblocks)
+{
+    uint32x4_t abcd = vld1q_u32(&state[0]);
+    uint32x4_t efgh = vld1q_u32(&state[4]);
+
+    while (nblocks--) {
+        const uint32x4_t abcd_save = abcd;
+        const uint32x4_t efgh_save = efgh;
+
+        // message words are big-endian
+        uint32x4_t msg[4];
+        for (uint8_t i = 0; i < 4; i++) {
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[16*i])));
+        }
+
+        // four rounds per step, extending the message schedule by
+        // four words each step until it is complete
+        for (uint8_t i = 0; i < 16; i++) {
+            const uint32x4_t wk = vaddq_u32(msg[i&3], vld1q_u32(&mavlink_sha256_k[4*i]));
+            const uint32x4_t abcd_prev = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, wk);
+            efgh = vsha256h2q_u32(efgh, abcd_prev, wk);
+            if (i < 12) {
+                msg[i&3] = vsha256su1q_u32(vsha256su0q_u32(msg[i&3], msg[(i+1)&3]), msg[(i+2)&3], msg[(i+3)&3]);
+            }
+        }
+
+        abcd = vaddq_u32(abcd, abcd_save);
+        efgh = vaddq_u32(efgh, efgh_save);
+        data += 64;
+    }
+
+    vst1q_u32(&state[0], abcd);
+    vst1q_u32(&state[4], efgh);
+}
+
+static inline void mavlink_sha256_init(mavlink_sha256_ctx *m)
+{
+    m->state[0] = 0x6a09e667;
+    m->state[1] = 0xbb67ae85;
+    m->state[2] = 0x3c6ef372;
+    m->state[3] = 0xa54ff53a;
+    m->state[4] = 0x510e527f;
+    m->state[5] = 0x9b05688c;
+    m->state[6] = 0x1f83d9ab;
+    m->state[7] = 0x5be0cd19;
+    m->len = 0;
+}
+
+static inline void mavlink_sha256_update(mavlink_sha256_ctx *m, const void *v, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)v;
+    uint32_t used = m->len & 63;
+    m->len += len;
+
+    if (used != 0) {
+        // fill the partial block first
+        const uint32_t n = (len < 64 - used) ? len : 64 - used;
+        memcpy(&m->buf[used], p, n);
+        used += n;
+        p += n;
+        len -= n;
+        if (used < 64) {
+            return;
+        }
+        mavlink_sha256_blocks(m->state, m->buf, 1);
+    }
+
+    // whole blocks straight from the caller's buffer
+    const uint32_t nblocks = len / 64;
+    mavlink_sha256_blocks(m->state, p, nblocks);
+    p += nblocks * 64;
+    len -= nblocks * 64;
+
+    memcpy(m->buf, p, len);
+}
+
+// finish the hash and return the first 48 bits, as used for the
+// MAVLink2 signature
+static inline void mavlink_sha256_final_48(mavlink_sha256_ctx *m, uint8_t result[6])
+{
+    const uint64_t bits = m->len * 8;
+    uint32_t used = m->len & 63;
+
+    m->buf[used++] = 0x80;
+    if (used > 56) {
+        memset(&m->buf[used], 0, 64 - used);
+        mavlink_sha256_blocks(m->state, m->buf, 1);
+        used = 0;
+    }
+    memset(&m->buf[used], 0, 56 - used);
+    for (uint8_t i = 0; i < 8; i++) {
+        m->buf[56+i] = bits >> (56 - 8*i);
+    }
+    mavlink_sha256_blocks(m->state, m->buf, 1);
+
+    result[0] = m->state[0] >> 24;
+    result[1] = m->state[0] >> 16;
+    result[2] = m->state[0] >> 8;
+    result[3] = m->state[0];
+    result[4] = m->state[1] >> 24;
+    result[5] = m->state[1] >> 16;
+}
+
+#endif  // AP_MAVLINK_SIGNING_ARM_SHA256_ENABLED
@@ -34,6 +34,12 @@
 #define AP_MAVLINK_AUTOPILOT_VERSION_REQUEST_ENABLED 1
 #endif
 
+// number of mission items which may be requested ahead of the one
+// being waited for when MAV_OPTIONS has mission upload pipelining set
+#ifndef AP_MAVLINK_MISSION_UPLOAD_WINDOW
+#define AP_MAVLINK_MISSION_UPLOAD_WINDOW 8
+#endif
+
 #ifndef AP_MAVLINK_MSG_RC_CHANNELS_RAW_ENABLED
 #define AP_MAVLINK_MSG_RC_CHANNELS_RAW_ENABLED 1
 #endif
@@ -128,6 +134,27 @@
 #define AP_MAVLINK_MSG_FLIGHT_INFORMATION_ENABLED HAL_GCS_ENABLED && AP_ARMING_ENABLED
 #endif  // AP_MAVLINK_MSG_FLIGHT_INFORMATION_ENABLED
 
+// adjust per-link stream slowdown from send failures and radio errors
+#ifndef AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED
+#define AP_MAVLINK_ADAPTIVE_STREAMS_ENABLED HAL_GCS_ENABLED && (HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
+
+// per-message handling time and per-link parse/send time, shown in
+// @SYS/mavlink_stats.txt and logged in MAVP
+#ifndef AP_MAVLINK_STATS_ENABLED
+#define AP_MAVLINK_STATS_ENABLED HAL_GCS_ENABLED && HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#endif
+
+#ifndef AP_MAVLINK_STATS_NUM_MSGS
+#define AP_MAVLINK_STATS_NUM_MSGS 32
+#endif
+
+// share the packed payload of commonly-streamed messages between
+// links within a single GCS::update_send
+#ifndef AP_MAVLINK_PAYLOAD_CACHE_ENABLED
+#define AP_MAVLINK_PAYLOAD_CACHE_ENABLED HAL_GCS_ENABLED
+#endif
+
 // deprecated 2025-02, replaced by MAV_CMD_DO_SET_GLOBAL_ORIGIN
 // ArduPilot 4.8 starts to warn if anyone uses this
 // ArduPilot 4.9 continues to warn if anyone uses this
@@ -136,3 +163,13 @@
 #ifndef AP_MAVLINK_SET_GPS_GLOBAL_ORIGIN_MESSAGE_ENABLED
 #define AP_MAVLINK_SET_GPS_GLOBAL_ORIGIN_MESSAGE_ENABLED (HAL_GCS_ENABLED && AP_AHRS_ENABLED)
 #endif  // AP_MAVLINK_SET_GPS_GLOBAL_ORIGIN_MESSAGE_ENABLED
+
+// sign MAVLink2 packets using the ARMv8 SHA-2 instructions when the
+// compiler targets them, in place of the generic mavlink sha256
+#ifndef AP_MAVLINK_SIGNING_ARM_SHA256_ENABLED
+#ifdef __ARM_FEATURE_SHA2
+#define AP_MAVLINK_SIGNING_ARM_SHA256_ENABLED HAL_GCS_ENABLED
+#else
+#define AP_MAVLINK_SIGNING_ARM_SHA256_ENABLED 0
+#endif
+#endif
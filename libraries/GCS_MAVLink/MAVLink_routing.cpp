@@ -32,6 +32,10 @@ extern const AP_HAL::HAL& hal;
 
 #define ROUTING_DEBUG 0
 
+static_assert(MAVLINK_ROUTE_HASH_SIZE > MAVLINK_MAX_ROUTES, "route hash must be larger than route table");
+static_assert((MAVLINK_ROUTE_HASH_SIZE & (MAVLINK_ROUTE_HASH_SIZE-1)) == 0, "route hash size must be a power of two");
+static_assert(MAVLINK_COMM_NUM_BUFFERS <= 16, "channel masks are 16 bit");
+
 // constructor
 MAVLink_routing::MAVLink_routing(void) : num_routes(0) {}
 
@@ -171,45 +175,56 @@ bool MAVLink_routing::check_and_forward(GCS_MAVLINK &in_link, const mavlink_mess
         return true;
     }
 
+    // work out the channels to forward on.  Private channels only
+    // get messages targeted exactly at a sysid/compid seen on them:
+    uint16_t public_mask;
+    uint16_t private_mask = 0;
+    if (broadcast_system) {
+        public_mask = route_channel_mask;
+    } else {
+        if (target_component != -1) {
+            private_mask = channels_for_route(target_system, target_component);
+        }
+        if (broadcast_component || !match_system) {
+            public_mask = channels_for_sysid(target_system);
+        } else {
+            public_mask = private_mask;
+        }
+    }
+
     // forward on any channels matching the targets
     bool forwarded = false;
-    bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS];
-    memset(sent_to_chan, 0, sizeof(sent_to_chan));
-    for (uint8_t i=0; i<num_routes; i++) {
-
-        // Skip if channel is private and the target system or component IDs do not match
-        GCS_MAVLINK *out_link = gcs().chan(routes[i].channel);
+    const uint16_t mask = public_mask | private_mask;
+    for (uint8_t i=0; i<MAVLINK_COMM_NUM_BUFFERS; i++) {
+        if ((mask & (1U<<i)) == 0) {
+            continue;
+        }
+        const mavlink_channel_t channel = (mavlink_channel_t)(MAVLINK_COMM_0 + i);
+        GCS_MAVLINK *out_link = gcs().chan(channel);
         if (out_link == nullptr) {
             // this is bad
             continue;
         }
-        if (out_link->is_private() &&
-            (target_system != routes[i].sysid ||
-             target_component != routes[i].compid)) {
+        // Skip if channel is private and the target system or component IDs do not match
+        const uint16_t allowed = out_link->is_private() ? private_mask : public_mask;
+        if ((allowed & (1U<<i)) == 0) {
             continue;
         }
-
-        if (broadcast_system || (target_system == routes[i].sysid &&
-                                 (broadcast_component || 
-                                  target_component == routes[i].compid ||
-                                  !match_system))) {
-
-            if (&in_link != out_link && !sent_to_chan[routes[i].channel]) {
-                if (out_link->check_payload_size(msg.len)) {
+        if (&in_link == out_link) {
+            continue;
+        }
+        if (out_link->check_payload_size(msg.len)) {
 #if ROUTING_DEBUG
-                    ::printf("fwd msg %u from chan %u on chan %u sysid=%d compid=%d\n",
-                             msg.msgid,
-                             (unsigned)in_link.get_chan(),
-                             (unsigned)routes[i].channel,
-                             (int)target_system,
-                             (int)target_component);
+            ::printf("fwd msg %u from chan %u on chan %u sysid=%d compid=%d\n",
+                     msg.msgid,
+                     (unsigned)in_link.get_chan(),
+                     (unsigned)channel,
+                     (int)target_system,
+                     (int)target_component);
 #endif
-                    _mavlink_resend_uart(routes[i].channel, &msg);
-                }
-                sent_to_chan[routes[i].channel] = true;
-                forwarded = true;
-            }
+            _mavlink_resend_uart(channel, &msg);
         }
+        forwarded = true;
     }
 
     if ((!forwarded && match_system) ||
@@ -236,29 +251,24 @@ void MAVLink_routing::send_to_components(uint32_t msgid, const char *pkt, uint8_
 
 void MAVLink_routing::send_to_components(const char *pkt, const mavlink_msg_entry_t *entry, const uint8_t pkt_len)
 {
-    bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS] {};
+    // channels on which our system ID has been seen
+    const uint16_t mask = channels_for_sysid(mavlink_system.sysid);
 
-    // check learned routes
-    for (uint8_t i=0; i<num_routes; i++) {
-        if (routes[i].sysid != mavlink_system.sysid) {
-            // our system ID hasn't been seen on this link
-            continue;
-        }
-        if (sent_to_chan[routes[i].channel]) {
-            // we've already send it on this link
+    for (uint8_t i=0; i<MAVLINK_COMM_NUM_BUFFERS; i++) {
+        if ((mask & (1U<<i)) == 0) {
             continue;
         }
-        if (comm_get_txspace(routes[i].channel) <
-            ((uint16_t)entry->max_msg_len) + GCS_MAVLINK::packet_overhead_chan(routes[i].channel)) {
+        const mavlink_channel_t channel = (mavlink_channel_t)(MAVLINK_COMM_0 + i);
+        if (comm_get_txspace(channel) <
+            ((uint16_t)entry->max_msg_len) + GCS_MAVLINK::packet_overhead_chan(channel)) {
             // it doesn't fit on this channel
             continue;
         }
 #if ROUTING_DEBUG
-        ::printf("send msg %u on chan %u sysid=%u compid=%u\n",
+        ::printf("send msg %u on chan %u sysid=%u\n",
                  entry->msgid,
-                 (unsigned)routes[i].channel,
-                 (unsigned)routes[i].sysid,
-                 (unsigned)routes[i].compid);
+                 (unsigned)channel,
+                 (unsigned)mavlink_system.sysid);
 #endif
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
         if (entry->max_msg_len > pkt_len) {
@@ -266,13 +276,12 @@ void MAVLink_routing::send_to_components(const char *pkt, const mavlink_msg_entr
                           entry->max_msg_len, pkt_len);
         }
 #endif
-        _mav_finalize_message_chan_send(routes[i].channel,
+        _mav_finalize_message_chan_send(channel,
                                         entry->msgid,
                                         pkt,
                                         entry->min_msg_len,
                                         MIN(entry->max_msg_len, pkt_len),
                                         entry->crc_extra);
-        sent_to_chan[routes[i].channel] = true;
     }
 }
 
@@ -312,12 +321,89 @@ bool MAVLink_routing::find_by_mavtype_and_compid(uint8_t mavtype, uint8_t compid
     return false;
 }
 
+/*
+  return the route for a sysid/compid, or nullptr if none has been
+  learnt
+*/
+MAVLink_routing::route *MAVLink_routing::find_route(uint8_t sysid, uint8_t compid)
+{
+    uint8_t h = route_hash(sysid, compid);
+    for (uint8_t n=0; n<MAVLINK_ROUTE_HASH_SIZE; n++) {
+        const uint8_t idx = route_index[h];
+        if (idx == 0) {
+            return nullptr;
+        }
+        route &r = routes[idx-1];
+        if (r.sysid == sysid && r.compid == compid) {
+            return &r;
+        }
+        h = (h + 1) & (MAVLINK_ROUTE_HASH_SIZE-1);
+    }
+    return nullptr;
+}
+
+// return the mask of channels a sysid/compid has been seen on
+uint16_t MAVLink_routing::channels_for_route(uint8_t sysid, uint8_t compid)
+{
+    const route *r = find_route(sysid, compid);
+    return r == nullptr ? 0 : r->channel_mask;
+}
+
+// return the mask of channels any component of sysid has been seen on
+uint16_t MAVLink_routing::channels_for_sysid(uint8_t sysid) const
+{
+    uint8_t h = route_hash(sysid, 0);
+    for (uint8_t n=0; n<MAVLINK_ROUTE_HASH_SIZE; n++) {
+        const sysid_entry &e = sysid_index[h];
+        if (e.channel_mask == 0) {
+            return 0;
+        }
+        if (e.sysid == sysid) {
+            return e.channel_mask;
+        }
+        h = (h + 1) & (MAVLINK_ROUTE_HASH_SIZE-1);
+    }
+    return 0;
+}
+
+// add routes[i] to route_index
+void MAVLink_routing::index_route(uint8_t i)
+{
+    uint8_t h = route_hash(routes[i].sysid, routes[i].compid);
+    while (route_index[h] != 0) {
+        h = (h + 1) & (MAVLINK_ROUTE_HASH_SIZE-1);
+    }
+    route_index[h] = i + 1;
+}
+
+// record that sysid has been seen on the channel(s) in channel_bit
+void MAVLink_routing::index_channel(uint8_t sysid, uint16_t channel_bit)
+{
+    route_channel_mask |= channel_bit;
+    uint8_t h = route_hash(sysid, 0);
+    while (sysid_index[h].channel_mask != 0 && sysid_index[h].sysid != sysid) {
+        h = (h + 1) & (MAVLINK_ROUTE_HASH_SIZE-1);
+    }
+    sysid_index[h].sysid = sysid;
+    sysid_index[h].channel_mask |= channel_bit;
+}
+
+void MAVLink_routing::rebuild_index(void)
+{
+    memset(route_index, 0, sizeof(route_index));
+    memset(sysid_index, 0, sizeof(sysid_index));
+    route_channel_mask = 0;
+    for (uint8_t i=0; i<num_routes; i++) {
+        index_route(i);
+        index_channel(routes[i].sysid, routes[i].channel_mask);
+    }
+}
+
 /*
   see if the message is for a new route and learn it
 */
 void MAVLink_routing::learn_route(GCS_MAVLINK &in_link, const mavlink_message_t &msg)
 {
-    uint8_t i;
     if (msg.sysid == 0) {
         // don't learn routes to the broadcast system
         return;
@@ -335,31 +421,68 @@ void MAVLink_routing::learn_route(GCS_MAVLINK &in_link, const mavlink_message_t
         return;
     }
     const mavlink_channel_t in_channel = in_link.get_chan();
-    for (i=0; i<num_routes; i++) {
-        if (routes[i].sysid == msg.sysid &&
-            routes[i].compid == msg.compid &&
-            routes[i].channel == in_channel) {
-            if (routes[i].mavtype == 0 && msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
-                routes[i].mavtype = mavlink_msg_heartbeat_get_type(&msg);
-            }
-            break;
+    const uint16_t channel_bit = 1U<<(in_channel-MAVLINK_COMM_0);
+    const uint32_t now_ms = AP_HAL::millis();
+
+    route *r = find_route(msg.sysid, msg.compid);
+    if (r != nullptr) {
+        r->last_seen_ms = now_ms;
+        if ((r->channel_mask & channel_bit) == 0) {
+            r->channel_mask |= channel_bit;
+            index_channel(msg.sysid, channel_bit);
+#if ROUTING_DEBUG
+            ::printf("learned route %u %u via %u\n",
+                     (unsigned)msg.sysid,
+                     (unsigned)msg.compid,
+                     (unsigned)in_channel);
+#endif
+        }
+        if (r->mavtype == 0 && msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
+            r->mavtype = mavlink_msg_heartbeat_get_type(&msg);
         }
+        return;
     }
-    if (i == num_routes && i<MAVLINK_MAX_ROUTES) {
-        routes[i].sysid = msg.sysid;
-        routes[i].compid = msg.compid;
-        routes[i].channel = in_channel;
-        if (msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
-            routes[i].mavtype = mavlink_msg_heartbeat_get_type(&msg);
+
+    if (num_routes == MAVLINK_MAX_ROUTES) {
+        // table is full; replace the route we have not heard from
+        // for longest, if it has gone quiet
+        uint8_t oldest = 0;
+        for (uint8_t i=1; i<num_routes; i++) {
+            if (now_ms - routes[i].last_seen_ms > now_ms - routes[oldest].last_seen_ms) {
+                oldest = i;
+            }
+        }
+        if (now_ms - routes[oldest].last_seen_ms < MAVLINK_ROUTE_EVICT_MS) {
+            return;
         }
-        num_routes++;
 #if ROUTING_DEBUG
-        ::printf("learned route %u %u via %u\n",
-                 (unsigned)msg.sysid,
-                 (unsigned)msg.compid,
-                 (unsigned)in_channel);
+        ::printf("evicted route %u %u\n",
+                 (unsigned)routes[oldest].sysid,
+                 (unsigned)routes[oldest].compid);
 #endif
+        num_routes--;
+        routes[oldest] = routes[num_routes];
+        rebuild_index();
     }
+
+    const uint8_t i = num_routes++;
+    routes[i].sysid = msg.sysid;
+    routes[i].compid = msg.compid;
+    routes[i].channel = in_channel;
+    routes[i].mavtype = 0;
+    if (msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
+        routes[i].mavtype = mavlink_msg_heartbeat_get_type(&msg);
+    }
+    routes[i].channel_mask = channel_bit;
+    routes[i].last_seen_ms = now_ms;
+    index_route(i);
+    index_channel(msg.sysid, channel_bit);
+#if ROUTING_DEBUG
+    ::printf("learned route %u %u via %u\n",
+             (unsigned)msg.sysid,
+             (unsigned)msg.compid,
+             (unsigned)in_channel);
+#endif
 }
 
 
@@ -382,11 +505,7 @@ void MAVLink_routing::handle_heartbeat(GCS_MAVLINK &link, const mavlink_message_
     mask &= ~no_route_mask;
     
     // mask out channels that are known sources for this sysid/compid
-    for (uint8_t i=0; i<num_routes; i++) {
-        if (routes[i].sysid == msg.sysid && routes[i].compid == msg.compid) {
-            mask &= ~(1U<<((unsigned)(routes[i].channel-MAVLINK_COMM_0)));
-        }
-    }
+    mask &= ~channels_for_route(msg.sysid, msg.compid);
 
     if (mask == 0) {
         // nothing to send to
@@ -7,7 +7,21 @@
 
 // 20 routes should be enough for now. This may need to increase as
 // we make more extensive use of MAVLink forwarding
+#ifndef MAVLINK_MAX_ROUTES
 #define MAVLINK_MAX_ROUTES 20
+#endif
+
+// size of the route lookup tables; must be a power of two larger
+// than MAVLINK_MAX_ROUTES
+#ifndef MAVLINK_ROUTE_HASH_SIZE
+#define MAVLINK_ROUTE_HASH_SIZE 32
+#endif
+
+// when the routing table is full a route not heard from for this
+// long is replaced by a new one
+#ifndef MAVLINK_ROUTE_EVICT_MS
+#define MAVLINK_ROUTE_EVICT_MS 30000
+#endif
 
 /*
   object to handle MAVLink packet routing
@@ -50,15 +64,40 @@ public:
     bool find_by_mavtype_and_compid(uint8_t mavtype, uint8_t compid, uint8_t &sysid, mavlink_channel_t &channel) const;
 
 private:
-    // a simple linear routing table. We don't expect to have a lot of
-    // routes, so a scalable structure isn't worthwhile yet.
+    // one route per sysid/compid, with the mask of channels it has
+    // been seen on
     uint8_t num_routes;
     struct route {
         uint8_t sysid;
         uint8_t compid;
-        mavlink_channel_t channel;
+        mavlink_channel_t channel; // first channel it was seen on
         uint8_t mavtype;
+        uint16_t channel_mask;
+        uint32_t last_seen_ms;
     } routes[MAVLINK_MAX_ROUTES];
+
+    // open-addressing indexes so the per-packet lookups do not scan
+    // routes[].  route_index holds index+1 into routes[] keyed on
+    // sysid/compid; sysid_index holds the union of the channel masks
+    // of all routes for a sysid.  Both are rebuilt when a route is
+    // evicted.
+    uint8_t route_index[MAVLINK_ROUTE_HASH_SIZE];
+    struct sysid_entry {
+        uint8_t sysid;
+        uint16_t channel_mask; // zero if unused
+    } sysid_index[MAVLINK_ROUTE_HASH_SIZE];
+    // channels with any route
+    uint16_t route_channel_mask;
+
+    static uint8_t route_hash(uint8_t sysid, uint8_t compid) {
+        return (sysid * 37U + compid) & (MAVLINK_ROUTE_HASH_SIZE-1);
+    }
+    route *find_route(uint8_t sysid, uint8_t compid);
+    uint16_t channels_for_route(uint8_t sysid, uint8_t compid);
+    uint16_t channels_for_sysid(uint8_t sysid) const;
+    void index_route(uint8_t i);
+    void index_channel(uint8_t sysid, uint16_t channel_bit);
+    void rebuild_index(void);
     
     // a channel mask to block routing as required
     uint8_t no_route_mask;
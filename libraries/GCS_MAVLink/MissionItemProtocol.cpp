@@ -15,8 +15,16 @@ void MissionItemProtocol::init_send_requests(GCS_MAVLINK &_link,
     timelast_receive_ms = AP_HAL::millis();    // set time we last received commands to now
     receiving = true;              // record that we expect to receive commands
     request_i = _request_first;                 // reset the next expected command number to zero
+    request_next = _request_first;
     request_last = _request_last;         // record how many commands we expect to receive
 
+    // when pipelining, keep several requests in flight so the GCS
+    // does not wait a round trip for each item
+    request_window = 1;
+    if (gcs().option_is_enabled(GCS::Option::MISSION_UPLOAD_PIPELINE)) {
+        request_window = AP_MAVLINK_MISSION_UPLOAD_WINDOW;
+    }
+
     dest_sysid = msg.sysid;       // record system id of GCS who wants to upload the mission
     dest_compid = msg.compid;     // record component id of GCS who wants to upload the mission
 
@@ -270,6 +278,12 @@ void MissionItemProtocol::handle_mission_item(const mavlink_message_t &msg, cons
 
     // check if this is the requested waypoint
     if (cmd.seq != request_i) {
+        if (request_window > 1 && cmd.seq < request_next) {
+            // an item we already have, or one arriving after an item
+            // that was lost. The lost item is requested again on
+            // timeout and everything after it is requested again
+            return;
+        }
         send_mission_ack(msg, MAV_MISSION_INVALID_SEQUENCE);
         return;
     }
@@ -307,6 +321,9 @@ void MissionItemProtocol::handle_mission_item(const mavlink_message_t &msg, cons
     // update waypoint receiving state machine
     timelast_receive_ms = AP_HAL::millis();
     request_i++;
+    if (request_next < request_i) {
+        request_next = request_i;
+    }
 
     if (request_i > request_last) {
         transfer_is_complete(*link, msg);
@@ -351,8 +368,8 @@ void MissionItemProtocol::send_mission_ack(const GCS_MAVLINK &_link,
 }
 
 /**
- * @brief Send the next pending waypoint, called from deferred message
- * handling code
+ * @brief Send the pending waypoint requests, called from deferred
+ * message handling code
  */
 void MissionItemProtocol::queued_request_send()
 {
@@ -366,14 +383,21 @@ void MissionItemProtocol::queued_request_send()
         INTERNAL_ERROR(AP_InternalError::error_t::gcs_bad_missionprotocol_link);
         return;
     }
-    CHECK_PAYLOAD_SIZE2_VOID(link->get_chan(), MISSION_REQUEST);
-    mavlink_msg_mission_request_send(
-        link->get_chan(),
-        dest_sysid,
-        dest_compid,
-        request_i,
-        mission_type());
-    timelast_request_ms = AP_HAL::millis();
+    // request the items in the window which have not been requested
+    // yet. If there are none, update() re-requests request_i when the
+    // requests time out
+    while (request_next <= request_last &&
+           request_next < request_i + request_window) {
+        CHECK_PAYLOAD_SIZE2_VOID(link->get_chan(), MISSION_REQUEST);
+        mavlink_msg_mission_request_send(
+            link->get_chan(),
+            dest_sysid,
+            dest_compid,
+            request_next,
+            mission_type());
+        timelast_request_ms = AP_HAL::millis();
+        request_next++;
+    }
 }
 
 void MissionItemProtocol::update()
@@ -407,6 +431,9 @@ void MissionItemProtocol::update()
     const uint32_t wp_recv_timeout_ms = 1000U + link->get_stream_slowdown_ms();
     if (tnow - timelast_request_ms > wp_recv_timeout_ms) {
         timelast_request_ms = tnow;
+        // go back to the item we are waiting for and request the
+        // window again
+        request_next = request_i;
         link->send_message(next_item_ap_message_id());
     }
 }
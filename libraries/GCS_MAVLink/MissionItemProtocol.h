@@ -86,6 +86,8 @@ private:
     virtual void truncate(const mavlink_mission_count_t &packet) = 0;
 
     uint16_t        request_i; // request index
+    uint16_t        request_next; // next index to send a request for
+    uint8_t         request_window; // number of requests which may be outstanding
 
     // waypoints
     uint8_t         dest_sysid;  // where to send requests
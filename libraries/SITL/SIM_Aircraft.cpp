@@ -46,6 +46,9 @@ extern const HAL_SITL& hal_sitl;
 
 Aircraft *Aircraft::instances[MAX_SIM_INSTANCES];
 
+// distance the vehicle may move before the earth field is looked up again
+#define SIM_MAG_FIELD_CACHE_DIST_M  100.0f
+
 /*
   parent class for all simulator types
  */
@@ -111,14 +114,23 @@ float Aircraft::ground_height_difference() const
 {
 #if AP_TERRAIN_AVAILABLE
     AP_Terrain *terrain = AP::terrain();
-    float h1, h2;
     if (sitl &&
         terrain != nullptr &&
-        sitl->terrain_enable &&
-        terrain->height_amsl(home, h1, false) &&
-        terrain->height_amsl(location, h2, false)) {
-        h2 += local_ground_level;
-        return h2 - h1;
+        sitl->terrain_enable) {
+        // this is called several times each step, so only go back to
+        // the terrain grid when home changes or the vehicle has moved
+        if (!terrain_cache.home_valid || !terrain_cache.home.same_loc_as(home)) {
+            terrain_cache.home = home;
+            terrain_cache.home_valid = terrain->height_amsl(home, terrain_cache.home_amsl, false);
+        }
+        if (!terrain_cache.loc_valid ||
+            terrain_cache.loc.get_distance(location) > SIM_TERRAIN_CACHE_DIST_M) {
+            terrain_cache.loc = location;
+            terrain_cache.loc_valid = terrain->height_amsl(location, terrain_cache.loc_amsl, false);
+        }
+        if (terrain_cache.home_valid && terrain_cache.loc_valid) {
+            return terrain_cache.loc_amsl + local_ground_level - terrain_cache.home_amsl;
+        }
     }
 #endif
     return local_ground_level;
@@ -210,17 +222,25 @@ void Aircraft::update_position(void)
 */
 void Aircraft::update_mag_field_bf()
 {
-    // get the magnetic field intensity and orientation
-    float intensity;
-    float declination;
-    float inclination;
-    AP_Declination::get_mag_field_ef(location.lat * 1e-7f, location.lng * 1e-7f, intensity, declination, inclination);
-
-    // create a field vector and rotate to the required orientation
-    Vector3f mag_ef(1e3f * intensity, 0.0f, 0.0f);
-    Matrix3f R;
-    R.from_euler(0.0f, -ToRad(inclination), ToRad(declination));
-    mag_ef = R * mag_ef;
+    // the field table is interpolated over a coarse grid, so only
+    // look it up again once we have moved a significant distance
+    if (!mag_field_cache.valid ||
+        mag_field_cache.loc.get_distance(location) > SIM_MAG_FIELD_CACHE_DIST_M) {
+        // get the magnetic field intensity and orientation
+        float intensity;
+        float declination;
+        float inclination;
+        AP_Declination::get_mag_field_ef(location.lat * 1e-7f, location.lng * 1e-7f, intensity, declination, inclination);
+
+        // create a field vector and rotate to the required orientation
+        Vector3f field(1e3f * intensity, 0.0f, 0.0f);
+        Matrix3f R;
+        R.from_euler(0.0f, -ToRad(inclination), ToRad(declination));
+        mag_field_cache.mag_ef = R * field;
+        mag_field_cache.loc = location;
+        mag_field_cache.valid = true;
+    }
+    Vector3f mag_ef = mag_field_cache.mag_ef;
 
     // calculate frame height above ground
     const float frame_height_agl = fmaxf((-position.z) + home.alt * 0.01f - ground_level, 0.0f);
@@ -245,6 +265,49 @@ void Aircraft::update_mag_field_bf()
     mag_bf += sitl->mag_mot.get() * battery_current;
 }
 
+/*
+  lengthen the physics step while the vehicle is steady. The decision
+  only depends on the simulated state so runs stay repeatable
+ */
+void Aircraft::update_time_warp(const struct sitl_input &input)
+{
+    const uint8_t warp_max = constrain_int16(sitl->idle_warp, 1, 8);
+
+    // backends that advance time themselves are not warped
+    if (warp_max <= 1 || !use_time_sync) {
+        time_warp.multiple = 1;
+        return;
+    }
+
+    // outputs must be settled, rather than just small
+    bool steady = true;
+    for (uint8_t i=0; i<ARRAY_SIZE(input.servos); i++) {
+        if (abs(int16_t(input.servos[i] - time_warp.servos[i])) > 2) {
+            steady = false;
+            break;
+        }
+    }
+    memcpy(time_warp.servos, input.servos, sizeof(time_warp.servos));
+
+    if (steady) {
+        Vector3f accel_ef = dcm * accel_body;
+        accel_ef.z += GRAVITY_MSS;
+        steady = accel_ef.length() < 0.2f && gyro.length() < radians(2.0f);
+    }
+
+    if (!steady) {
+        time_warp.multiple = 1;
+        time_warp.steady_start_us = time_now_us;
+    } else if (time_now_us - time_warp.steady_start_us > 1000000U &&
+               time_warp.multiple < warp_max) {
+        // double the step each second we stay steady
+        time_warp.multiple = MIN(time_warp.multiple * 2, warp_max);
+        time_warp.steady_start_us = time_now_us;
+    }
+
+    frame_time_us = uint64_t(1.0e6f/rate_hz) * time_warp.multiple;
+}
+
 /* advance time by deltat in seconds */
 void Aircraft::time_advance()
 {
@@ -297,7 +360,10 @@ void Aircraft::sync_frame_time(void)
         // don't let a large negative debt build up
         sleep_debt_us = -1.0e5;
     }
-    if (sleep_debt_us > min_sleep_time) {
+    if (max_speed) {
+        // never sleep, the achieved rate is still calculated below
+        sleep_debt_us = 0;
+    } else if (sleep_debt_us > min_sleep_time) {
         // sleep if we have built up a debt of min_sleep_tim
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
         usleep(sleep_debt_us);
@@ -692,6 +758,7 @@ void Aircraft::update_model(const struct sitl_input &input)
 {
     local_ground_level = 0.0f;
     if (sitl != nullptr) {
+        update_time_warp(input);
         update(input);
     } else {
         time_advance();
@@ -717,7 +784,10 @@ void Aircraft::update_dynamics(const Vector3f &rot_accel)
     eas2tas = AP_Baro::get_EAS2TAS_for_alt_amsl(location.alt*0.01);
     air_density = AP_Baro::get_air_density_for_alt_amsl(location.alt*0.01);
 
+    const bool trapezoidal = sitl != nullptr && sitl->integrator == SIM::Integrator::TRAPEZOIDAL;
+
     // update rotational rates in body frame
+    const Vector3f gyro_prev = gyro;
     gyro += rot_accel * delta_time;
 
     gyro.x = constrain_float(gyro.x, -radians(2000.0f), radians(2000.0f));
@@ -731,7 +801,11 @@ void Aircraft::update_dynamics(const Vector3f &rot_accel)
     accel_body.z = constrain_float(accel_body.z, -accel_limit, accel_limit);
 
     // update attitude
-    dcm.rotate(gyro * delta_time);
+    if (trapezoidal) {
+        dcm.rotate((gyro_prev + gyro) * (0.5f * delta_time));
+    } else {
+        dcm.rotate(gyro * delta_time);
+    }
     dcm.normalize();
 
     Vector3f accel_earth = dcm * accel_body;
@@ -748,11 +822,16 @@ void Aircraft::update_dynamics(const Vector3f &rot_accel)
     accel_body = dcm.transposed() * (accel_earth + Vector3f(0.0f, 0.0f, -GRAVITY_MSS));
 
     // new velocity vector
+    const Vector3f velocity_prev = velocity_ef;
     velocity_ef += accel_earth * delta_time;
 
     const bool was_on_ground = on_ground();
     // new position vector
-    position += (velocity_ef * delta_time).todouble();
+    if (trapezoidal) {
+        position += ((velocity_prev + velocity_ef) * (0.5f * delta_time)).todouble();
+    } else {
+        position += (velocity_ef * delta_time).todouble();
+    }
 
     // velocity relative to air mass, in earth frame
     velocity_air_ef = velocity_ef - wind_ef;
@@ -46,6 +46,9 @@
 
 #define MAX_SIM_INSTANCES 16
 
+// distance the vehicle may move before the terrain height is looked up again
+#define SIM_TERRAIN_CACHE_DIST_M 0.2f
+
 namespace SITL {
 
 /*
@@ -64,6 +67,11 @@ public:
     void set_speedup(float speedup);
     float get_speedup() const { return target_speedup; }
 
+    /*
+      run as fast as possible without synchronising with wall clock time
+     */
+    void set_max_speed(bool enable) { max_speed = enable; }
+
     /*
       set instance number
      */
@@ -269,6 +277,14 @@ protected:
     const char *autotest_dir;
     const char *frame;
     bool use_time_sync = true;
+    bool max_speed;
+
+    // multiple of the physics step applied by update_time_warp()
+    struct {
+        uint8_t multiple = 1;
+        uint64_t steady_start_us;
+        uint16_t servos[ARRAY_SIZE(sitl_input::servos)] {};
+    } time_warp;
     float last_speedup = -1.0f;
     const char *config_ = "";
     float eas2tas = 1.0;
@@ -293,6 +309,22 @@ protected:
 
     float ground_height_difference() const;
 
+    // earth frame field and terrain heights are only looked up again
+    // once the vehicle has moved far enough for them to change
+    struct {
+        Location loc;
+        Vector3f mag_ef;            // mGauss, earth frame
+        bool valid = false;
+    } mag_field_cache;
+    mutable struct {
+        Location home;
+        Location loc;
+        float home_amsl;            // terrain height at home
+        float loc_amsl;             // terrain height at loc
+        bool home_valid = false;
+        bool loc_valid = false;
+    } terrain_cache;
+
     virtual bool on_ground() const;
 
     // returns height above ground level in metres
@@ -304,6 +336,9 @@ protected:
     /* update body frame magnetic field */
     void update_mag_field_bf(void);
 
+    /* lengthen the physics step while the vehicle is steady */
+    void update_time_warp(const struct sitl_input &input);
+
     /* advance time by deltat in seconds */
     void time_advance();
 
@@ -206,7 +206,7 @@ private:
     uint16_t controller_port = 18083;
 
     // a list of sockets used to reduce inter-packet latency
-    ObjectBuffer_TS<SocketAPM_native*> socks{2};
+    ObjectBuffer_SPSC<SocketAPM_native*> socks{2};
     SocketAPM_native *sock;
 
     char replybuf[10000];
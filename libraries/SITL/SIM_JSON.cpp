@@ -23,6 +23,10 @@
 #include <stdio.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Logger/AP_Logger.h>
@@ -30,6 +34,7 @@
 #include <SRV_Channel/SRV_Channel.h>
 
 #define UDP_TIMEOUT_MS 100
+#define SHM_SPIN_COUNT 2000     // polls of the shared memory before sleeping between polls
 
 extern const AP_HAL::HAL& hal;
 
@@ -65,7 +70,14 @@ JSON::JSON(const char *frame_str) :
 
     const char *colon = strchr(frame_str, ':');
     if (colon) {
-        target_ip = colon+1;
+        if (strncmp(colon+1, "shm", 3) == 0 && (colon[4] == 0 || colon[4] == ':')) {
+            use_shm = true;
+            if (colon[4] == ':') {
+                shm_path = colon+5;
+            }
+        } else {
+            target_ip = colon+1;
+        }
     }
 
     for (uint8_t i=0; i<ARRAY_SIZE(sim_defaults); i++) {
@@ -85,6 +97,11 @@ JSON::JSON(const char *frame_str) :
 */
 void JSON::set_interface_ports(const char* address, const int port_in, const int port_out)
 {
+    if (use_shm) {
+        // the shared memory is opened on the first update, once the instance is known
+        return;
+    }
+
     sock.set_blocking(false);
     sock.reuseaddress();
 
@@ -134,6 +151,107 @@ void JSON::output_servos(const struct sitl_input &input)
 }
 
 
+/*
+    Create the shared memory file and map it
+*/
+void JSON::shm_init()
+{
+    static_assert(sizeof(shm_layout) == 216, "JSON shared memory layout must not change");
+
+    if (shm_path == nullptr) {
+#ifdef __linux__
+        snprintf(shm_path_default, sizeof(shm_path_default), "/dev/shm/ardupilot_json_%u", (unsigned)instance);
+#else
+        snprintf(shm_path_default, sizeof(shm_path_default), "/tmp/ardupilot_json_%u", (unsigned)instance);
+#endif
+        shm_path = shm_path_default;
+    }
+
+    const int fd = open(shm_path, O_RDWR|O_CREAT, 0666);
+    if (fd == -1) {
+        AP_HAL::panic("JSON: unable to open %s: %s", shm_path, strerror(errno));
+    }
+    if (ftruncate(fd, sizeof(shm_layout)) != 0) {
+        AP_HAL::panic("JSON: unable to size %s: %s", shm_path, strerror(errno));
+    }
+    void *ptr = mmap(nullptr, sizeof(shm_layout), PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        AP_HAL::panic("JSON: unable to map %s: %s", shm_path, strerror(errno));
+    }
+
+    shm = (shm_layout *)ptr;
+    memset(shm, 0, sizeof(shm_layout));
+    __atomic_store_n(&shm->magic, shm_magic, __ATOMIC_RELEASE);
+
+    printf("JSON shared memory interface at %s\n", shm_path);
+}
+
+/*
+    Write servos to shared memory and signal the physics backend
+*/
+void JSON::output_servos_shm(const struct sitl_input &input)
+{
+    const uint8_t num_servos = SRV_Channels::have_32_channels() ? 32 : 16;
+    shm->frame_rate = rate_hz;
+    shm->num_servos = num_servos;
+    for (uint8_t i=0; i<num_servos; i++) {
+        shm->pwm[i] = input.servos[i];
+    }
+    __atomic_store_n(&shm->servo_seq, ++shm_seq, __ATOMIC_RELEASE);
+}
+
+/*
+    Wait for the physics backend to reply to the last servo output
+    This is a blocking function
+*/
+void JSON::recv_fdm_shm(const struct sitl_input &input)
+{
+    uint32_t polls = 0;
+    uint64_t wait_start_us = 0;
+    while (__atomic_load_n(&shm->state_seq, __ATOMIC_ACQUIRE) != shm_seq) {
+        if (polls < SHM_SPIN_COUNT) {
+            polls++;
+            sched_yield();
+            continue;
+        }
+        const uint64_t now_us = get_wall_time_us();
+        if (wait_start_us == 0) {
+            wait_start_us = now_us;
+        } else if (now_us - wait_start_us > 1000000) {
+            wait_start_us = now_us;
+            printf("No JSON shared memory state received\n");
+        }
+        usleep(100);
+    }
+
+    const shm_state &s = shm->state;
+    state.timestamp_s = s.timestamp_s;
+    state.imu.gyro = Vector3f(s.gyro[0], s.gyro[1], s.gyro[2]);
+    state.imu.accel_body = Vector3f(s.accel_body[0], s.accel_body[1], s.accel_body[2]);
+    state.position = Vector3d(s.position[0], s.position[1], s.position[2]);
+    state.attitude = Vector3f(s.attitude[0], s.attitude[1], s.attitude[2]);
+    state.quaternion = Quaternion(s.quaternion[0], s.quaternion[1], s.quaternion[2], s.quaternion[3]);
+    state.velocity = Vector3f(s.velocity[0], s.velocity[1], s.velocity[2]);
+    memcpy(state.rng, s.rng, sizeof(state.rng));
+    state.wind_vane_apparent.direction = s.wind_vane_direction;
+    state.wind_vane_apparent.speed = s.wind_vane_speed;
+    state.airspeed = s.airspeed;
+    // the no_time_sync field is set by its presence
+    state.no_time_sync = (s.fields & TIME_SYNC) != 0;
+
+    // the mandatory fields are always present in the layout
+    const uint32_t received_bitmask = s.fields | TIMESTAMP | GYRO | ACCEL_BODY | POSITION | VELOCITY;
+
+    // Must get either attitude or quaternion fields
+    if ((received_bitmask & (EULER_ATT | QUAT_ATT)) == 0) {
+        printf("Did not receive attitude or quaternion\n");
+        return;
+    }
+
+    update_from_state(received_bitmask);
+}
+
 /*
     very simple JSON parser for sensor data
     called with pointer to one row of sensor data, nul terminated
@@ -281,6 +399,17 @@ void JSON::recv_fdm(const struct sitl_input &input)
         return;
     }
 
+    memmove(sensor_buffer, p2, sensor_buffer_len - (p2 - sensor_buffer));
+    sensor_buffer_len = sensor_buffer_len - (p2 - sensor_buffer);
+
+    update_from_state(received_bitmask);
+}
+
+/*
+    Update the vehicle from the received state
+*/
+void JSON::update_from_state(uint32_t received_bitmask)
+{
     if (received_bitmask != last_received_bitmask) {
         // some change in the message we have received, print what we got
         printf("\nJSON received:\n");
@@ -299,9 +428,6 @@ void JSON::recv_fdm(const struct sitl_input &input)
     }
     last_received_bitmask = received_bitmask;
 
-    memmove(sensor_buffer, p2, sensor_buffer_len - (p2 - sensor_buffer));
-    sensor_buffer_len = sensor_buffer_len - (p2 - sensor_buffer);
-
     accel_body = state.imu.accel_body;
     gyro = state.imu.gyro;
     velocity_ef = state.velocity;
@@ -449,11 +575,19 @@ void JSON::recv_fdm(const struct sitl_input &input)
 */
 void JSON::update(const struct sitl_input &input)
 {
-    // send to JSON model
-    output_servos(input);
+    if (use_shm) {
+        if (shm == nullptr) {
+            shm_init();
+        }
+        output_servos_shm(input);
+        recv_fdm_shm(input);
+    } else {
+        // send to JSON model
+        output_servos(input);
 
-    // receive from JSON model
-    recv_fdm(input);
+        // receive from JSON model
+        recv_fdm(input);
+    }
 
     // update magnetic field
     // as the model does not provide mag feild we calculate it from position and attitude
@@ -66,12 +66,56 @@ private:
 
     SocketAPM_native sock;
 
+    /*
+      shared memory transport, selected with a model of JSON:shm or
+      JSON:shm:/path/to/file. The layout is fixed and naturally
+      aligned so it can be mapped directly by the physics backend,
+      see examples/JSON/readme.md for the protocol
+     */
+    static const uint32_t shm_magic = 0x4A534D31; // "JSM1"
+    struct shm_state {
+        double timestamp_s;
+        float gyro[3];
+        float accel_body[3];
+        double position[3];
+        float attitude[3];
+        float quaternion[4];
+        float velocity[3];
+        float rng[6];
+        float wind_vane_direction;
+        float wind_vane_speed;
+        float airspeed;
+        uint32_t fields;        // DataKey bitmask of the optional fields that are valid
+    };
+    struct shm_layout {
+        uint32_t magic;         // shm_magic, written by ArduPilot once the layout is ready
+        uint32_t servo_seq;     // incremented by ArduPilot after pwm has been written
+        uint32_t state_seq;     // set to servo_seq by the physics backend after state has been written
+        uint16_t frame_rate;
+        uint16_t num_servos;
+        uint16_t pwm[32];
+        shm_state state;
+    };
+
+    bool use_shm;
+    const char *shm_path;
+    char shm_path_default[40];
+    shm_layout *shm;
+    uint32_t shm_seq;
+
     uint32_t frame_counter;
     double last_timestamp_s;
 
     void output_servos(const struct sitl_input &input);
     void recv_fdm(const struct sitl_input &input);
 
+    void shm_init();
+    void output_servos_shm(const struct sitl_input &input);
+    void recv_fdm_shm(const struct sitl_input &input);
+
+    // update the vehicle from state and the mask of keytable entries received
+    void update_from_state(uint32_t received_bitmask);
+
     uint32_t parse_sensors(const char *json);
 
     // buffer for parsing pose data in JSON format
@@ -77,8 +77,8 @@ void Motor::calculate_forces(const struct sitl_input &input,
     // work out roll and pitch of motor relative to it pointing straight up
     float roll = 0, pitch = 0;
 
-    uint64_t now = AP_HAL::micros64();
-    
+    const uint64_t now = now_us;
+
     // possibly roll and/or pitch the motor
     if (roll_servo >= 0) {
         uint16_t servoval = update_servo(input.servos[roll_servo+motor_offset], now, last_roll_value);
@@ -109,14 +109,15 @@ void Motor::calculate_forces(const struct sitl_input &input,
     if (use_drag) {
         // calculate momentum drag per motor
         const float momentum_drag_factor = momentum_drag_coefficient * sqrtf(air_density * true_prop_area);
+        const Vector3f thrust_sqrt { sqrtf(fabsf(thrust.x)), sqrtf(fabsf(thrust.y)), sqrtf(fabsf(thrust.z)) };
         Vector3f momentum_drag;
-        momentum_drag.x = momentum_drag_factor * motor_vel.x * (sqrtf(fabsf(thrust.y)) + sqrtf(fabsf(thrust.z)));
-        momentum_drag.y = momentum_drag_factor * motor_vel.y * (sqrtf(fabsf(thrust.x)) + sqrtf(fabsf(thrust.z)));
+        momentum_drag.x = momentum_drag_factor * motor_vel.x * (thrust_sqrt.y + thrust_sqrt.z);
+        momentum_drag.y = momentum_drag_factor * motor_vel.y * (thrust_sqrt.x + thrust_sqrt.z);
         // The application of momentum drag to the Z axis is a 'hack' to compensate for incorrect modelling
         // of the variation of thust with inflow velocity. If not applied, the vehicle will
         // climb at an unrealistic rate during operation in STABILIZE. TODO replace prop and motor model in
         // with one based on DC motor, momentum disc and blade element theory.
-        momentum_drag.z = momentum_drag_factor * motor_vel.z * (sqrtf(fabsf(thrust.x)) + sqrtf(fabsf(thrust.y)) + sqrtf(fabsf(thrust.z)));
+        momentum_drag.z = momentum_drag_factor * motor_vel.z * (thrust_sqrt.x + thrust_sqrt.y + thrust_sqrt.z);
 
         thrust -= momentum_drag;
     }
@@ -0,0 +1,262 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  Horizontal ray casting against a static scene of posts and walls
+*/
+
+#include "SIM_RayCaster.h"
+
+#if AP_SIM_RAYCASTER_ENABLED
+
+using namespace SITL;
+
+#define RAYCASTER_LEAF_SIZE 4
+#define RAYCASTER_STACK_SIZE 64
+
+void RayCaster::clear()
+{
+    _num_primitives = 0;
+    _num_nodes = 0;
+}
+
+bool RayCaster::add_circle(const Vector2f &centre, float radius)
+{
+    if (_num_primitives >= ARRAY_SIZE(_primitives)) {
+        return false;
+    }
+    Primitive &p = _primitives[_num_primitives++];
+    p.type = Primitive::Type::CIRCLE;
+    p.a = centre;
+    p.radius = radius;
+    _num_nodes = 0;
+    return true;
+}
+
+bool RayCaster::add_segment(const Vector2f &start, const Vector2f &end)
+{
+    if (_num_primitives >= ARRAY_SIZE(_primitives)) {
+        return false;
+    }
+    Primitive &p = _primitives[_num_primitives++];
+    p.type = Primitive::Type::SEGMENT;
+    p.a = start;
+    p.b = end;
+    p.radius = 0;
+    _num_nodes = 0;
+    return true;
+}
+
+void RayCaster::primitive_bounds(const Primitive &p, Vector2f &min, Vector2f &max) const
+{
+    switch (p.type) {
+    case Primitive::Type::CIRCLE:
+        min = p.a - Vector2f(p.radius, p.radius);
+        max = p.a + Vector2f(p.radius, p.radius);
+        return;
+    case Primitive::Type::SEGMENT:
+        min = Vector2f(MIN(p.a.x, p.b.x), MIN(p.a.y, p.b.y));
+        max = Vector2f(MAX(p.a.x, p.b.x), MAX(p.a.y, p.b.y));
+        return;
+    }
+}
+
+void RayCaster::build()
+{
+    _num_nodes = 0;
+    if (_num_primitives > 0) {
+        build_node(0, _num_primitives);
+    }
+}
+
+/*
+  build the subtree over count primitives starting at first, splitting
+  at the middle of the longest axis of the primitive centres. Returns
+  the index of the node
+ */
+uint16_t RayCaster::build_node(uint16_t first, uint16_t count)
+{
+    const uint16_t index = _num_nodes++;
+    Node &node = _nodes[index];
+
+    Vector2f centre_min, centre_max;
+    for (uint16_t i=0; i<count; i++) {
+        Vector2f pmin, pmax;
+        primitive_bounds(_primitives[first+i], pmin, pmax);
+        const Vector2f centre = (pmin + pmax) * 0.5f;
+        if (i == 0) {
+            node.min = pmin;
+            node.max = pmax;
+            centre_min = centre_max = centre;
+            continue;
+        }
+        node.min.x = MIN(node.min.x, pmin.x);
+        node.min.y = MIN(node.min.y, pmin.y);
+        node.max.x = MAX(node.max.x, pmax.x);
+        node.max.y = MAX(node.max.y, pmax.y);
+        centre_min.x = MIN(centre_min.x, centre.x);
+        centre_min.y = MIN(centre_min.y, centre.y);
+        centre_max.x = MAX(centre_max.x, centre.x);
+        centre_max.y = MAX(centre_max.y, centre.y);
+    }
+
+    node.first = first;
+    if (count <= RAYCASTER_LEAF_SIZE) {
+        node.count = count;
+        return index;
+    }
+    node.count = 0;
+
+    // partition the primitives either side of the split
+    const bool split_x = (centre_max.x - centre_min.x) >= (centre_max.y - centre_min.y);
+    const float split = split_x ? 0.5f * (centre_min.x + centre_max.x) : 0.5f * (centre_min.y + centre_max.y);
+    uint16_t left_count = 0;
+    for (uint16_t i=0; i<count; i++) {
+        Vector2f pmin, pmax;
+        primitive_bounds(_primitives[first+i], pmin, pmax);
+        const float c = split_x ? 0.5f * (pmin.x + pmax.x) : 0.5f * (pmin.y + pmax.y);
+        if (c < split) {
+            const Primitive tmp = _primitives[first+i];
+            _primitives[first+i] = _primitives[first+left_count];
+            _primitives[first+left_count] = tmp;
+            left_count++;
+        }
+    }
+    if (left_count == 0 || left_count == count) {
+        // all the centres coincide, split by count instead
+        left_count = count / 2;
+    }
+
+    build_node(first, left_count);
+    node.right = build_node(first + left_count, count - left_count);
+    return index;
+}
+
+float RayCaster::intersect(const Primitive &p, const Vector2f &origin, const Vector2f &dir)
+{
+    switch (p.type) {
+    case Primitive::Type::CIRCLE: {
+        const Vector2f m = origin - p.a;
+        const float b = m * dir;
+        const float c = m * m - sq(p.radius);
+        if (c > 0 && b > 0) {
+            // outside and pointing away
+            return -1;
+        }
+        const float discriminant = sq(b) - c;
+        if (discriminant < 0) {
+            return -1;
+        }
+        return MAX(-b - sqrtf(discriminant), 0.0f);
+    }
+    case Primitive::Type::SEGMENT: {
+        const Vector2f e = p.b - p.a;
+        const float denominator = dir % e;
+        if (is_zero(denominator)) {
+            // parallel
+            return -1;
+        }
+        const Vector2f w = p.a - origin;
+        const float t = (w % e) / denominator;
+        const float u = (w % dir) / denominator;
+        if (t < 0 || u < 0 || u > 1) {
+            return -1;
+        }
+        return t;
+    }
+    }
+    return -1;
+}
+
+float RayCaster::intersect(const Node &n, const Vector2f &origin, const Vector2f &inv_dir, float max_range)
+{
+    // slab test
+    const float tx1 = (n.min.x - origin.x) * inv_dir.x;
+    const float tx2 = (n.max.x - origin.x) * inv_dir.x;
+    const float ty1 = (n.min.y - origin.y) * inv_dir.y;
+    const float ty2 = (n.max.y - origin.y) * inv_dir.y;
+    const float t_enter = MAX(MIN(tx1, tx2), MIN(ty1, ty2));
+    const float t_exit = MIN(MAX(tx1, tx2), MAX(ty1, ty2));
+    if (t_exit < 0 || t_enter > t_exit || t_enter > max_range) {
+        return -1;
+    }
+    return MAX(t_enter, 0.0f);
+}
+
+float RayCaster::cast(const Vector2f &origin, float bearing_rad, float max_range) const
+{
+    if (_num_nodes == 0) {
+        return max_range;
+    }
+
+    const Vector2f dir(cosf(bearing_rad), sinf(bearing_rad));
+    // a large value rather than infinity avoids 0 * inf in the slab test
+    const Vector2f inv_dir(is_zero(dir.x) ? 1.0e30f : 1.0f / dir.x,
+                           is_zero(dir.y) ? 1.0e30f : 1.0f / dir.y);
+
+    float nearest = max_range;
+    uint16_t stack[RAYCASTER_STACK_SIZE];
+    uint8_t stack_len = 0;
+    stack[stack_len++] = 0;
+    while (stack_len > 0) {
+        const Node &node = _nodes[stack[--stack_len]];
+        const float t_node = intersect(node, origin, inv_dir, nearest);
+        if (t_node < 0) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint16_t i=node.first; i<node.first+node.count; i++) {
+                const float t = intersect(_primitives[i], origin, dir);
+                if (t >= 0 && t < nearest) {
+                    nearest = t;
+                }
+            }
+            continue;
+        }
+        if (stack_len + 2 > RAYCASTER_STACK_SIZE) {
+            // can't happen for a tree built from the primitive limit
+            continue;
+        }
+        // push the nearer child last so it is visited first and the
+        // far one is more likely to be pruned
+        uint16_t near_child = uint16_t(&node - _nodes) + 1;
+        uint16_t far_child = node.right;
+        float t_near = intersect(_nodes[near_child], origin, inv_dir, nearest);
+        float t_far = intersect(_nodes[far_child], origin, inv_dir, nearest);
+        if (t_far >= 0 && (t_near < 0 || t_far < t_near)) {
+            const uint16_t tmp_child = near_child;
+            near_child = far_child;
+            far_child = tmp_child;
+            const float tmp_t = t_near;
+            t_near = t_far;
+            t_far = tmp_t;
+        }
+        if (t_far >= 0) {
+            stack[stack_len++] = far_child;
+        }
+        if (t_near >= 0) {
+            stack[stack_len++] = near_child;
+        }
+    }
+    return nearest;
+}
+
+void RayCaster::cast(const Vector2f &origin, const float bearing_rad[], float distance[], uint16_t num_rays, float max_range) const
+{
+    for (uint16_t i=0; i<num_rays; i++) {
+        distance[i] = cast(origin, bearing_rad[i], max_range);
+    }
+}
+
+#endif  // AP_SIM_RAYCASTER_ENABLED
@@ -0,0 +1,103 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  Horizontal ray casting against a static scene of vertical posts and
+  walls, used by simulated rangefinders and proximity sensors.
+
+  The scene is held in a bounding volume hierarchy so each ray only
+  tests the primitives whose boxes it passes through, nearest first.
+  Positions are in metres north and east of any fixed origin.
+*/
+
+#pragma once
+
+#include "SIM_config.h"
+
+#if AP_SIM_RAYCASTER_ENABLED
+
+#include <AP_Math/AP_Math.h>
+
+#ifndef AP_SIM_RAYCASTER_MAX_PRIMITIVES
+#define AP_SIM_RAYCASTER_MAX_PRIMITIVES 1024
+#endif
+
+namespace SITL {
+
+class RayCaster {
+public:
+
+    // remove all primitives
+    void clear();
+
+    // add a vertical post of radius in metres. Returns false if the scene is full
+    bool add_circle(const Vector2f &centre, float radius);
+
+    // add a wall between two points. Returns false if the scene is full
+    bool add_segment(const Vector2f &start, const Vector2f &end);
+
+    // build the hierarchy, must be called after adding primitives and before casting
+    void build();
+
+    // return distance in metres along a ray from origin on bearing
+    // (radians clockwise from north) to the nearest primitive, or
+    // max_range if nothing is hit within max_range
+    float cast(const Vector2f &origin, float bearing_rad, float max_range) const;
+
+    // cast num_rays rays from the same origin, filling distance[]
+    void cast(const Vector2f &origin, const float bearing_rad[], float distance[], uint16_t num_rays, float max_range) const;
+
+    uint16_t num_primitives() const { return _num_primitives; }
+
+private:
+
+    struct Primitive {
+        enum class Type : uint8_t {
+            CIRCLE,
+            SEGMENT,
+        } type;
+        Vector2f a;             // circle centre or segment start
+        Vector2f b;             // segment end
+        float radius;
+    };
+
+    // a node is a leaf when count is non-zero, otherwise its children
+    // are at index+1 and right
+    struct Node {
+        Vector2f min;
+        Vector2f max;
+        uint16_t first;
+        uint16_t count;
+        uint16_t right;
+    };
+
+    // return the distance along the ray to the primitive, or a negative number if it is not hit
+    static float intersect(const Primitive &p, const Vector2f &origin, const Vector2f &dir);
+
+    // return the entry distance along the ray into the box, or a negative number if it is missed
+    static float intersect(const Node &n, const Vector2f &origin, const Vector2f &inv_dir, float max_range);
+
+    void primitive_bounds(const Primitive &p, Vector2f &min, Vector2f &max) const;
+    uint16_t build_node(uint16_t first, uint16_t count);
+
+    Primitive _primitives[AP_SIM_RAYCASTER_MAX_PRIMITIVES];
+    uint16_t _num_primitives;
+
+    Node _nodes[2*AP_SIM_RAYCASTER_MAX_PRIMITIVES];
+    uint16_t _num_nodes;
+};
+
+}
+
+#endif  // AP_SIM_RAYCASTER_ENABLED
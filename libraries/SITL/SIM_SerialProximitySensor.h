@@ -49,6 +49,11 @@ public:
         return AP::sitl()->measure_distance_at_angle_bf(location, angle);
     }
 
+    // return distances to nearest objects at count angles
+    void measure_distances_at_angles_bf(const Location &location, const float angle[], float distance[], uint16_t count) const {
+        AP::sitl()->measure_distances_at_angles_bf(location, angle, distance, count);
+    }
+
 private:
 
     uint32_t last_sent_ms;
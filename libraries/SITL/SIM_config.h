@@ -85,6 +85,10 @@
 #define AP_SIM_ADSB_SAGETECH_MXS_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL)
 #endif
 
+#ifndef AP_SIM_RAYCASTER_ENABLED
+#define AP_SIM_RAYCASTER_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL)
+#endif
+
 #ifndef AP_SIM_SERIALDEVICE_CORRUPTION_ENABLED
 #define AP_SIM_SERIALDEVICE_CORRUPTION_ENABLED 0
 #endif
@@ -647,6 +647,20 @@ const AP_Param::GroupInfo SIM::var_info3[] = {
     // @Path: ./SIM_Vicon.cpp
     AP_SUBGROUPINFO(vicon, "VICON_", 56, SIM, ViconParms),
 
+    // @Param: INTEG
+    // @DisplayName: Simulated dynamics integrator
+    // @Description: Integration method used for the attitude and position of the built in vehicle models. Trapezoidal integration uses the average of the rotation rate and velocity over each step which is exact for linearly changing rates, giving more accurate dynamics at a given SIM_RATE_HZ
+    // @Values: 0:Semi-implicit Euler,1:Trapezoidal
+    // @User: Advanced
+    AP_GROUPINFO("INTEG",         57, SIM,  integrator, 0),
+
+    // @Param: IDLE_WARP
+    // @DisplayName: Simulated idle time warp
+    // @Description: Largest multiple of the physics step used by the built in vehicle models while the vehicle is steady, with unchanging outputs and negligible acceleration and rotation, such as sitting disarmed or holding position in still air. The step doubles each second the vehicle stays steady and drops back to the normal step as soon as it is not. This allows long missions to be simulated with fewer steps. The firmware sees the longer steps, so this should not be used when testing timing. 0 or 1 disables
+    // @Range: 0 8
+    // @User: Advanced
+    AP_GROUPINFO("IDLE_WARP",     58, SIM,  idle_warp, 0),
+
 #ifdef SFML_JOYSTICK
     AP_SUBGROUPEXTENSION("",      63, SIM,  var_sfml_joystick),
 #endif // SFML_JOYSTICK
@@ -1479,113 +1493,97 @@ float SIM::get_rangefinder(uint8_t instance) {
     return nanf("");
 };
 
-float SIM::measure_distance_at_angle_bf(const Location &location, float angle) const
+#if AP_SIM_RAYCASTER_ENABLED
+/*
+  scene of posts used by the simulated proximity sensors, built on first use
+ */
+const RayCaster *SIM::proximity_scene() const
 {
-    // should we populate state.rangefinder_m[...] from this?
-    Vector2f vehicle_pos_cm;
-    if (!location.get_vector_xy_from_origin_NE_cm(vehicle_pos_cm)) {
-        // should probably use SITL variables...
-        return 0.0f;
+    static RayCaster *scene;
+    if (scene != nullptr) {
+        return scene;
     }
-
-#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
-    static uint64_t count = 0;
-
-    if (count == 0) {
-        unlink("/tmp/rayfile.scr");
-        unlink("/tmp/intersectionsfile.scr");
+    scene = NEW_NOTHROW RayCaster();
+    if (scene == nullptr) {
+        return nullptr;
     }
 
-    count++;
+    ::fprintf(stderr, "Writing /tmp/post-locations.scr\n");
+    FILE *postfile = fopen("/tmp/post-locations.scr", "w");
 
-    // the 1000 here is so the files don't grow unbounded
-    const bool write_debug_files = count < 1000;
-
-    FILE *rayfile = nullptr;
-    if (write_debug_files) {
-        rayfile = fopen("/tmp/rayfile.scr", "a");
-    }
-#endif
-
-    // cast a ray from location out 200m...
-    Location location2 = location;
-    location2.offset_bearing(wrap_180(angle + state.yawDeg), 200);
-    Vector2f ray_endpos_cm;
-    if (!location2.get_vector_xy_from_origin_NE_cm(ray_endpos_cm)) {
-        // should probably use SITL variables...
-        return 0.0f;
-    }
-#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
-    if (rayfile != nullptr) {
-        ::fprintf(rayfile, "map icon %f %f barrell\n", location2.lat*1e-7, location2.lng*1e-7);
-        fclose(rayfile);
-    }
-
-    // setup a grid of posts
-    FILE *postfile = nullptr;
-    FILE *intersectionsfile = nullptr;
-    if (write_debug_files) {
-        static bool postfile_written;
-        if (!postfile_written) {
-            ::fprintf(stderr, "Writing /tmp/post-locations.scr\n");
-            postfile_written = true;
-            postfile = fopen("/tmp/post-locations.scr", "w");
-        }
-        intersectionsfile = fopen("/tmp/intersections.scr", "a");
-    }
-#endif
-
-    const float radius_cm = 100.0f;
-    float min_dist_cm = 1000000.0;
-    const uint8_t num_post_offset = 10;
+    // setup a grid of posts, positions relative to post_origin
+    const float radius = 1.0f;
+    const int8_t num_post_offset = 10;
     for (int8_t x=-num_post_offset; x<num_post_offset; x++) {
         for (int8_t y=-num_post_offset; y<num_post_offset; y++) {
-            Location post_location = post_origin;
-            post_location.offset(x*10+3, y*10+2);
-#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+            const Vector2f offset(x*10+3, y*10+2);
             if (postfile != nullptr) {
-                ::fprintf(postfile, "map circle %f %f %f blue\n", post_location.lat*1e-7, post_location.lng*1e-7, radius_cm*0.01);
-            }
-#endif
-            Vector2f post_position_cm;
-            if (!post_location.get_vector_xy_from_origin_NE_cm(post_position_cm)) {
-                // should probably use SITL variables...
-                min_dist_cm = 0;
-                goto OUT;
-            }
-            Vector2f intersection_point_cm;
-            if (Vector2f::circle_segment_intersection(ray_endpos_cm, vehicle_pos_cm, post_position_cm, radius_cm, intersection_point_cm)) {
-                float dist_cm = (intersection_point_cm-vehicle_pos_cm).length();
-#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
-                if (intersectionsfile != nullptr) {
-                    Location intersection_point = location;
-                    intersection_point.offset(intersection_point_cm.x*0.01,
-                                              intersection_point_cm.y*0.01);
-                    ::fprintf(intersectionsfile,
-                              "map icon %f %f barrell\n",
-                              intersection_point.lat*1e-7,
-                              intersection_point.lng*1e-7);
-                }
-#endif
-                if (dist_cm < min_dist_cm) {
-                    min_dist_cm = dist_cm;
-                }
+                Location post_location = post_origin;
+                post_location.offset(offset.x, offset.y);
+                ::fprintf(postfile, "map circle %f %f %f blue\n", post_location.lat*1e-7, post_location.lng*1e-7, radius);
             }
+            scene->add_circle(offset, radius);
         }
     }
-
-OUT:
-#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
     if (postfile != nullptr) {
         fclose(postfile);
     }
-    if (intersectionsfile != nullptr) {
-        fclose(intersectionsfile);
+
+    scene->build();
+    return scene;
+}
+#endif  // AP_SIM_RAYCASTER_ENABLED
+
+// return distance to nearest object at angle (degrees, body frame)
+float SIM::measure_distance_at_angle_bf(const Location &location, float angle) const
+{
+    float distance;
+    measure_distances_at_angles_bf(location, &angle, &distance, 1);
+    return distance;
+}
+
+// fill distance[] with the distance to the nearest object for each of
+// count body frame angles in degrees.  Objects beyond 200m are not seen
+// and are reported as a very large distance
+void SIM::measure_distances_at_angles_bf(const Location &location, const float angle[], float distance[], uint16_t count) const
+{
+    const float max_range = 200.0f;
+    const float no_object = 10000.0f;
+
+#if AP_SIM_RAYCASTER_ENABLED
+    const RayCaster *scene = proximity_scene();
+    if (scene == nullptr) {
+        for (uint16_t i=0; i<count; i++) {
+            distance[i] = 0.0f;
+        }
+        return;
+    }
+    const Vector2f vehicle_pos = post_origin.get_distance_NE(location);
+    for (uint16_t i=0; i<count; i++) {
+        const float bearing = radians(wrap_360(angle[i] + state.yawDeg));
+        const float d = scene->cast(vehicle_pos, bearing, max_range);
+        distance[i] = d < max_range ? d : no_object;
+    }
+#else
+    // brute force test against each post
+    const Vector2f vehicle_pos = post_origin.get_distance_NE(location);
+    for (uint16_t i=0; i<count; i++) {
+        const float bearing = radians(wrap_360(angle[i] + state.yawDeg));
+        const Vector2f ray_end = vehicle_pos + Vector2f(cosf(bearing), sinf(bearing)) * max_range;
+        distance[i] = no_object;
+        const float radius = 1.0f;
+        const int8_t num_post_offset = 10;
+        for (int8_t x=-num_post_offset; x<num_post_offset; x++) {
+            for (int8_t y=-num_post_offset; y<num_post_offset; y++) {
+                const Vector2f post_position(x*10+3, y*10+2);
+                Vector2f intersection_point;
+                if (Vector2f::circle_segment_intersection(ray_end, vehicle_pos, post_position, radius, intersection_point)) {
+                    distance[i] = MIN(distance[i], (intersection_point-vehicle_pos).length());
+                }
+            }
+        }
     }
 #endif
-
-    // ::fprintf(stderr, "Distance @%f = %fm\n", angle, min_dist_cm*0.01f);
-    return min_dist_cm * 0.01f;
 }
 
 } // namespace SITL
@@ -33,6 +33,7 @@
 #include "SIM_DroneCANDevice.h"
 #include "SIM_ADSB_Sagetech_MXS.h"
 #include "SIM_Volz.h"
+#include "SIM_RayCaster.h"
 
 namespace SITL {
 
@@ -562,6 +563,7 @@ public:
     float get_rangefinder(uint8_t instance);
 
     float measure_distance_at_angle_bf(const Location &location, float angle) const;
+    void measure_distances_at_angles_bf(const Location &location, const float angle[], float distance[], uint16_t count) const;
 
     // get the apparent wind speed and direction as set by external physics backend
     float get_apparent_wind_dir() const{return state.wind_vane_apparent.direction;}
@@ -614,6 +616,16 @@ public:
     AP_Int16 osd_columns;
 #endif
 
+    // integration method used by Aircraft::update_dynamics
+    enum class Integrator : uint8_t {
+        SEMI_IMPLICIT_EULER = 0,
+        TRAPEZOIDAL = 1,
+    };
+    AP_Enum<Integrator> integrator;
+
+    // largest multiple of the physics step used while the vehicle is steady
+    AP_Int8 idle_warp;
+
     // Allow inhibiting of SITL only sim state messages over MAVLink
     // This gives more realistic data rates for testing links
     void set_stop_MAVLink_sim_state() { stop_MAVLink_sim_state = true; }
@@ -624,6 +636,12 @@ public:
      */
     bool set_pose(uint8_t instance, const Location &loc, const Quaternion &quat,
                   const Vector3f &velocity_ef, const Vector3f &gyro_rads);
+
+private:
+#if AP_SIM_RAYCASTER_ENABLED
+    // scene seen by simulated proximity sensors
+    const RayCaster *proximity_scene() const;
+#endif
 };
 
 } // namespace SITL
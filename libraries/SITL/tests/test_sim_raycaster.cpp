@@ -0,0 +1,93 @@
+#include <AP_gtest.h>
+
+#include <SITL/SIM_RayCaster.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+using namespace SITL;
+
+TEST(RayCaster, empty_scene)
+{
+    RayCaster scene;
+    scene.clear();
+    scene.build();
+    EXPECT_FLOAT_EQ(scene.cast(Vector2f(), 0, 100), 100);
+}
+
+TEST(RayCaster, single_post)
+{
+    RayCaster scene;
+    scene.clear();
+    scene.add_circle(Vector2f(10, 0), 1);
+    scene.build();
+
+    // straight at it, away from it and past it
+    EXPECT_NEAR(scene.cast(Vector2f(), 0, 100), 9, 0.001);
+    EXPECT_FLOAT_EQ(scene.cast(Vector2f(), M_PI, 100), 100);
+    EXPECT_FLOAT_EQ(scene.cast(Vector2f(), M_PI_2, 100), 100);
+
+    // out of range
+    EXPECT_FLOAT_EQ(scene.cast(Vector2f(), 0, 5), 5);
+
+    // from inside the post
+    EXPECT_FLOAT_EQ(scene.cast(Vector2f(10, 0), 0, 100), 0);
+}
+
+TEST(RayCaster, wall)
+{
+    RayCaster scene;
+    scene.clear();
+    scene.add_segment(Vector2f(-50, 20), Vector2f(50, 20));
+    scene.build();
+
+    // east is positive y
+    EXPECT_NEAR(scene.cast(Vector2f(), M_PI_2, 100), 20, 0.001);
+    EXPECT_NEAR(scene.cast(Vector2f(), radians(45), 100), 20 * M_SQRT2, 0.001);
+    EXPECT_FLOAT_EQ(scene.cast(Vector2f(), 0, 100), 100);
+    EXPECT_FLOAT_EQ(scene.cast(Vector2f(), -M_PI_2, 100), 100);
+}
+
+// the hierarchy must give the same nearest hit as testing every primitive
+TEST(RayCaster, grid_matches_brute_force)
+{
+    RayCaster scene;
+    scene.clear();
+    const float radius = 1.0f;
+    for (int8_t x=-10; x<10; x++) {
+        for (int8_t y=-10; y<10; y++) {
+            EXPECT_TRUE(scene.add_circle(Vector2f(x*10+3, y*10+2), radius));
+        }
+    }
+    EXPECT_TRUE(scene.add_segment(Vector2f(-120, -120), Vector2f(-120, 120)));
+    scene.build();
+
+    const float max_range = 200;
+    const Vector2f origin(-12.5, 7.25);
+    float bearings[360];
+    float distances[360];
+    for (uint16_t i=0; i<ARRAY_SIZE(bearings); i++) {
+        bearings[i] = radians(i);
+    }
+    scene.cast(origin, bearings, distances, ARRAY_SIZE(bearings), max_range);
+
+    for (uint16_t i=0; i<ARRAY_SIZE(bearings); i++) {
+        const Vector2f ray_end = origin + Vector2f(cosf(bearings[i]), sinf(bearings[i])) * max_range;
+        float expected = max_range;
+        for (int8_t x=-10; x<10; x++) {
+            for (int8_t y=-10; y<10; y++) {
+                Vector2f intersection;
+                if (Vector2f::circle_segment_intersection(ray_end, origin, Vector2f(x*10+3, y*10+2), radius, intersection)) {
+                    expected = MIN(expected, (intersection - origin).length());
+                }
+            }
+        }
+        Vector2f intersection;
+        if (Vector2f::segment_intersection(origin, ray_end, Vector2f(-120, -120), Vector2f(-120, 120), intersection)) {
+            expected = MIN(expected, (intersection - origin).length());
+        }
+        // circle_segment_intersection loses a little precision over long segments
+        EXPECT_NEAR(distances[i], expected, 0.05);
+    }
+}
+
+AP_GTEST_MAIN()
@@ -181,6 +181,38 @@ SRV_Channel::SRV_Channel(void)
     have_pwm_mask = ~uint32_t(0);
 }
 
+void SRV_Channel::update_scale(void)
+{
+    if (scale_valid() || high_out == 0) {
+        return;
+    }
+    scale.servo_min = servo_min;
+    scale.servo_max = servo_max;
+    scale.servo_trim = servo_trim;
+    scale.high_out = high_out;
+    scale.range = float(servo_max - servo_min) / high_out;
+    scale.above_trim = float(servo_max - servo_trim) / high_out;
+    scale.below_trim = float(servo_trim - servo_min) / high_out;
+}
+
+/*
+  return uint16_t((value * span) / high_out) for value >= 0 using a
+  scale factor of span / high_out. Where the product is too close to a
+  whole number for the truncation to be sure to match, the division is
+  done instead, so the result is the same either way
+ */
+static uint16_t scale_pwm(float value, float scale, int16_t span, uint16_t high_out)
+{
+    if (span > 0) {
+        const float v = value * scale;
+        const float frac = v - float(uint32_t(v));
+        if (frac > 0.001f && frac < 0.999f) {
+            return uint16_t(v);
+        }
+    }
+    return uint16_t((value * (float)span) / (float)high_out);
+}
+
 // convert a 0..range_max to a pwm
 uint16_t SRV_Channel::pwm_from_range(float scaled_value) const
 {
@@ -191,6 +223,9 @@ uint16_t SRV_Channel::pwm_from_range(float scaled_value) const
     if (reversed) {
         scaled_value = high_out - scaled_value;
     }
+    if (scale_valid()) {
+        return servo_min + scale_pwm(scaled_value, scale.range, servo_max - servo_min, high_out);
+    }
     return servo_min + uint16_t( (scaled_value * (float)(servo_max - servo_min)) / (float)high_out );
 }
 
@@ -204,6 +239,12 @@ uint16_t SRV_Channel::pwm_from_angle(float scaled_value) const
         scaled_value = -scaled_value;
     }
     scaled_value = constrain_float(scaled_value, -high_out, high_out);
+    if (scale_valid()) {
+        if (scaled_value > 0) {
+            return servo_trim + scale_pwm(scaled_value, scale.above_trim, servo_max - servo_trim, high_out);
+        }
+        return servo_trim - scale_pwm(-scaled_value, scale.below_trim, servo_trim - servo_min, high_out);
+    }
     if (scaled_value > 0) {
         return servo_trim + uint16_t( (scaled_value * (float)(servo_max - servo_trim)) / (float)high_out);
     } else {
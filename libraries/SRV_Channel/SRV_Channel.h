@@ -330,6 +330,29 @@ private:
     // high point of angle or range output
     uint16_t high_out;
 
+    // output scale factors, so the per-loop conversion of every
+    // channel is a multiply rather than a divide. These are valid
+    // while the parameters and high_out they were calculated from
+    // are unchanged
+    struct {
+        int16_t servo_min;
+        int16_t servo_max;
+        int16_t servo_trim;
+        uint16_t high_out;
+        float range;        // (servo_max - servo_min) / high_out
+        float above_trim;   // (servo_max - servo_trim) / high_out
+        float below_trim;   // (servo_trim - servo_min) / high_out
+    } scale;
+
+    // recalculate the output scale factors if they are out of date
+    void update_scale(void);
+
+    // true if the output scale factors are up to date
+    bool scale_valid(void) const {
+        return scale.high_out == high_out && scale.servo_min == servo_min &&
+               scale.servo_max == servo_max && scale.servo_trim == servo_trim;
+    }
+
     // convert a 0..range_max to a pwm
     uint16_t pwm_from_range(float scaled_value) const;
 
@@ -567,6 +590,16 @@ public:
     void cork();
     void push();
 
+    // latency from a new RC input frame to the first output push after it
+    struct RCLatency {
+        uint32_t min_us;
+        uint32_t max_us;
+        uint32_t sum_us;
+        uint16_t count;
+    };
+    // get and reset the RC latency statistics, returns false if no new RC input has been output
+    bool get_rc_latency(RCLatency &stats);
+
     // disable PWM output to a set of channels given by a mask. This is used by the AP_BLHeli code
     static void set_disabled_channel_mask(uint32_t mask) { disabled_mask = mask; }
     static uint32_t get_disabled_channel_mask() { return disabled_mask; }
@@ -710,6 +743,12 @@ private:
 
     // semaphore for multi-thread use of override_counter array
     HAL_Semaphore override_counter_sem;
+
+    // update the RC latency statistics on output push
+    void update_rc_latency();
+    uint32_t last_rc_input_us;  // time of the last RC input frame included in the statistics
+    RCLatency rc_latency;
+    HAL_Semaphore rc_latency_sem;
 };
 
 namespace AP {
@@ -421,6 +421,7 @@ void SRV_Channels::calc_pwm(void)
             override_counter[i]--;
         }
         if (channels[i].valid_function()) {
+            channels[i].update_scale();
             channels[i].calc_pwm(functions[channels[i].function.get()].output_scaled);
         }
     }
@@ -487,6 +488,8 @@ void SRV_Channels::push()
 {
     hal.rcout->push();
 
+    update_rc_latency();
+
 #if AP_VOLZ_ENABLED
     // give volz library a chance to update
     volz.update();
@@ -548,6 +551,44 @@ void SRV_Channels::push()
 #endif // HAL_NUM_CAN_IFACES
 }
 
+/*
+  record the time from a new RC input frame being decoded to the first
+  output push after it
+ */
+void SRV_Channels::update_rc_latency()
+{
+    const uint32_t input_us = hal.rcin->last_input_us();
+    if (input_us == 0 || input_us == last_rc_input_us) {
+        return;
+    }
+    last_rc_input_us = input_us;
+    const uint32_t latency_us = AP_HAL::micros() - input_us;
+
+    WITH_SEMAPHORE(rc_latency_sem);
+    if (rc_latency.count == 0) {
+        rc_latency.min_us = rc_latency.max_us = latency_us;
+    } else {
+        rc_latency.min_us = MIN(rc_latency.min_us, latency_us);
+        rc_latency.max_us = MAX(rc_latency.max_us, latency_us);
+    }
+    if (rc_latency.count < UINT16_MAX) {
+        rc_latency.sum_us += latency_us;
+        rc_latency.count++;
+    }
+}
+
+// get and reset the RC latency statistics, returns false if no new RC input has been output
+bool SRV_Channels::get_rc_latency(RCLatency &stats)
+{
+    WITH_SEMAPHORE(rc_latency_sem);
+    if (rc_latency.count == 0) {
+        return false;
+    }
+    stats = rc_latency;
+    rc_latency = {};
+    return true;
+}
+
 void SRV_Channels::zero_rc_outputs()
 {
     /* Send an invalid signal to the motors to prevent spinning due to
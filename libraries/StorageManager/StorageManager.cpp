@@ -136,7 +136,7 @@ StorageAccess::StorageAccess(StorageManager::StorageType _type) :
   base read function. The src offset is within the bytes allocated
   for the storage type of this StorageAccess object
 */
-bool StorageAccess::read_block(void *data, uint16_t addr, size_t n) const
+bool StorageAccess::read_block(void *data, uint32_t addr, size_t n) const
 {
     uint8_t *b = (uint8_t *)data;
 
@@ -147,7 +147,24 @@ bool StorageAccess::read_block(void *data, uint16_t addr, size_t n) const
             return false;
         }
         const size_t n2 = MIN(n, file->bufsize - addr);
-        memcpy(b, &file->buffer[addr], n2);
+        if (file->page == nullptr) {
+            memcpy(b, &file->buffer[addr], n2);
+            return n == n2;
+        }
+        WITH_SEMAPHORE(file->sem);
+        size_t remaining = n2;
+        while (remaining > 0) {
+            size_t count = remaining;
+            const uint8_t *p = file_data(addr, count, false);
+            if (p == nullptr) {
+                memset(b, 0, remaining);
+                return false;
+            }
+            memcpy(b, p, count);
+            b += count;
+            addr += count;
+            remaining -= count;
+        }
         return n == n2;
     }
 #endif
@@ -190,7 +207,7 @@ bool StorageAccess::read_block(void *data, uint16_t addr, size_t n) const
   base write function. The addr offset is within the bytes allocated
   for the storage type of this StorageAccess object
 */
-bool StorageAccess::write_block(uint16_t addr, const void *data, size_t n) const
+bool StorageAccess::write_block(uint32_t addr, const void *data, size_t n) const
 {
     const uint8_t *b = (const uint8_t *)data;
 
@@ -202,9 +219,24 @@ bool StorageAccess::write_block(uint16_t addr, const void *data, size_t n) const
         // using microSD data
         WITH_SEMAPHORE(file->sem);
         const size_t n2 = MIN(n, file->bufsize - addr);
-        memcpy(&file->buffer[addr], b, n2);
-        for (uint8_t i=addr/1024U; i<(addr+n2+1023U)/1024U; i++) {
-            file->dirty_mask |= (1ULL<<i);
+        if (file->page == nullptr) {
+            memcpy(&file->buffer[addr], b, n2);
+            for (uint8_t i=addr/1024U; i<(addr+n2+1023U)/1024U; i++) {
+                file->dirty_mask |= (1ULL<<i);
+            }
+            return n == n2;
+        }
+        size_t remaining = n2;
+        while (remaining > 0) {
+            size_t count = remaining;
+            uint8_t *p = file_data(addr, count, true);
+            if (p == nullptr) {
+                return false;
+            }
+            memcpy(p, b, count);
+            b += count;
+            addr += count;
+            remaining -= count;
         }
         return n == n2;
     }
@@ -246,7 +278,7 @@ bool StorageAccess::write_block(uint16_t addr, const void *data, size_t n) const
 /*
   read a byte
  */
-uint8_t StorageAccess::read_byte(uint16_t loc) const
+uint8_t StorageAccess::read_byte(uint32_t loc) const
 {
     uint8_t v;
     read_block(&v, loc, sizeof(v));
@@ -256,7 +288,7 @@ uint8_t StorageAccess::read_byte(uint16_t loc) const
 /*
   read 16 bit value
  */
-uint16_t StorageAccess::read_uint16(uint16_t loc) const
+uint16_t StorageAccess::read_uint16(uint32_t loc) const
 {
     uint16_t v;
     read_block(&v, loc, sizeof(v));
@@ -266,7 +298,7 @@ uint16_t StorageAccess::read_uint16(uint16_t loc) const
 /*
   read 32 bit value
  */
-uint32_t StorageAccess::read_uint32(uint16_t loc) const
+uint32_t StorageAccess::read_uint32(uint32_t loc) const
 {
     uint32_t v;
     read_block(&v, loc, sizeof(v));
@@ -276,7 +308,7 @@ uint32_t StorageAccess::read_uint32(uint16_t loc) const
 /*
   read a float
  */
-float StorageAccess::read_float(uint16_t loc) const
+float StorageAccess::read_float(uint32_t loc) const
 {
     float v;
     read_block(&v, loc, sizeof(v));
@@ -286,7 +318,7 @@ float StorageAccess::read_float(uint16_t loc) const
 /*
   write a byte
  */
-void StorageAccess::write_byte(uint16_t loc, uint8_t value) const
+void StorageAccess::write_byte(uint32_t loc, uint8_t value) const
 {
     write_block(loc, &value, sizeof(value));
 }
@@ -294,7 +326,7 @@ void StorageAccess::write_byte(uint16_t loc, uint8_t value) const
 /*
   write a uint16
  */
-void StorageAccess::write_uint16(uint16_t loc, uint16_t value) const
+void StorageAccess::write_uint16(uint32_t loc, uint16_t value) const
 {
     write_block(loc, &value, sizeof(value));
 }
@@ -302,7 +334,7 @@ void StorageAccess::write_uint16(uint16_t loc, uint16_t value) const
 /*
   write a uint32
  */
-void StorageAccess::write_uint32(uint16_t loc, uint32_t value) const
+void StorageAccess::write_uint32(uint32_t loc, uint32_t value) const
 {
     write_block(loc, &value, sizeof(value));
 }
@@ -310,7 +342,7 @@ void StorageAccess::write_uint32(uint16_t loc, uint32_t value) const
 /*
   write a float
  */
-void StorageAccess::write_float(uint16_t loc, float value) const
+void StorageAccess::write_float(uint32_t loc, float value) const
 {
     write_block(loc, &value, sizeof(value));
 }
@@ -322,8 +354,8 @@ bool StorageAccess::copy_area(const StorageAccess &source) const
 {
     // we deliberately allow for copies from smaller areas. This
     // allows for a partial backup region for parameters
-    uint16_t total = MIN(source.size(), size());
-    uint16_t ofs = 0;
+    uint32_t total = MIN(source.size(), size());
+    uint32_t ofs = 0;
     while (total > 0) {
         uint8_t block[32];
         uint16_t n = MIN(sizeof(block), total);
@@ -347,7 +379,11 @@ bool StorageAccess::attach_file(const char *filename, uint16_t size_kbyte)
         // only one attach per boot
         return false;
     }
-    const uint32_t size = MIN(0xFFFFU, size_kbyte * 1024U);
+    uint32_t size = size_kbyte * 1024U;
+    if (type != StorageManager::StorageMission) {
+        // only mission storage can be over 64k
+        size = MIN(0xFFFFU, size);
+    }
     auto *newfile = NEW_NOTHROW FileStorage;
     if (newfile == nullptr) {
         AP_BoardConfig::allocation_error("StorageFile");
@@ -358,6 +394,13 @@ bool StorageAccess::attach_file(const char *filename, uint16_t size_kbyte)
     if (newfile->fd == -1) {
         goto fail;
     }
+    if (size > 0xFFFFU) {
+        // too large to hold in memory, page from the file
+        if (!attach_paged(newfile, size)) {
+            goto fail;
+        }
+        goto attached;
+    }
     newfile->buffer = NEW_NOTHROW uint8_t[size];
     if (newfile->buffer == nullptr) {
         AP_BoardConfig::allocation_error("StorageFile");
@@ -381,6 +424,7 @@ bool StorageAccess::attach_file(const char *filename, uint16_t size_kbyte)
         }
     }
 
+attached:
     hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&StorageAccess::flush_file, void));
 
     file = newfile;
@@ -395,16 +439,175 @@ fail:
     if (newfile->buffer != nullptr) {
         delete[] newfile->buffer;
     }
+    delete[] newfile->page;
     delete newfile;
     return false;
 }
 
+/*
+  setup a file which is accessed through a cache of pages, extending
+  it to size
+ */
+bool StorageAccess::attach_paged(FileStorage *newfile, uint32_t size)
+{
+    const uint8_t num_pages = AP_SDCARD_STORAGE_CACHE_PAGES;
+    static_assert(AP_SDCARD_STORAGE_CACHE_PAGES <= 64, "dirty mask covers 64 pages");
+    newfile->buffer = NEW_NOTHROW uint8_t[num_pages*1024U];
+    newfile->page = NEW_NOTHROW FileStorage::Page[num_pages];
+    if (newfile->buffer == nullptr || newfile->page == nullptr) {
+        AP_BoardConfig::allocation_error("StorageFile");
+    }
+    for (uint8_t i=0; i<num_pages; i++) {
+        newfile->page[i].num = 0xFFFF;
+    }
+    newfile->num_pages = num_pages;
+    newfile->bufsize = size;
+
+    const int32_t flen = AP::FS().lseek(newfile->fd, 0, SEEK_END);
+    if (flen < 0) {
+        return false;
+    }
+    if (uint32_t(flen) >= size) {
+        return true;
+    }
+
+    // extend the file 1k at a time using the first slot. A new file
+    // starts with a copy of the existing storage
+    uint8_t *b = newfile->buffer;
+    for (uint32_t ofs=flen; ofs<size; ) {
+        const uint32_t n = MIN(1024U - (ofs % 1024U), size - ofs);
+        memset(b, 0, n);
+        if (flen == 0 && ofs < total_size) {
+            read_block(b, ofs, MIN(n, total_size - ofs));
+        }
+        if (AP::FS().write(newfile->fd, b, n) != int32_t(n)) {
+            return false;
+        }
+        ofs += n;
+    }
+    return AP::FS().fsync(newfile->fd) == 0;
+}
+
+/*
+  find the slot holding page num of a paged file, or -1
+ */
+int16_t StorageAccess::find_page(uint16_t num) const
+{
+    for (uint8_t i=0; i<file->num_pages; i++) {
+        if (file->page[i].num == num) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+  write the page held in a slot to the file, clearing its dirty bit
+ */
+bool StorageAccess::write_slot(uint8_t slot) const
+{
+    const uint32_t num = file->page != nullptr ? file->page[slot].num : slot;
+    const uint32_t ofs = num * 1024U;
+    const uint32_t len = MIN(1024U, file->bufsize-ofs);
+    if (AP::FS().lseek(file->fd, ofs, SEEK_SET) != int32_t(ofs) ||
+        AP::FS().write(file->fd, &file->buffer[slot*1024U], len) != int32_t(len)) {
+        return false;
+    }
+    file->dirty_mask &= ~(1ULL<<slot);
+    return true;
+}
+
+/*
+  load page num of a paged file, returning its slot or -1 on IO
+  failure. Empty slots are used first, then the least recently used
+  clean one
+ */
+int16_t StorageAccess::load_page(uint16_t num) const
+{
+    const int16_t found = find_page(num);
+    if (found != -1) {
+        file->page[found].last_use = ++file->use_count;
+        return found;
+    }
+
+    auto rank = [this](uint8_t i) -> uint8_t {
+        if (file->page[i].num == 0xFFFF) {
+            return 0;
+        }
+        return (file->dirty_mask & (1ULL<<i)) ? 2 : 1;
+    };
+    uint8_t slot = 0;
+    for (uint8_t i=1; i<file->num_pages; i++) {
+        if (rank(i) < rank(slot) ||
+            (rank(i) == rank(slot) && file->page[i].last_use < file->page[slot].last_use)) {
+            slot = i;
+        }
+    }
+    if ((file->dirty_mask & (1ULL<<slot)) && !write_slot(slot)) {
+        return -1;
+    }
+
+    const uint32_t ofs = num * 1024U;
+    const uint32_t len = MIN(1024U, file->bufsize-ofs);
+    if (AP::FS().lseek(file->fd, ofs, SEEK_SET) != int32_t(ofs) ||
+        AP::FS().read(file->fd, &file->buffer[slot*1024U], len) != int32_t(len)) {
+        file->page[slot].num = 0xFFFF;
+        return -1;
+    }
+    file->page[slot].num = num;
+    file->page[slot].last_use = ++file->use_count;
+    return slot;
+}
+
+/*
+  return a pointer to the data at addr in a paged file, reducing n to
+  the number of bytes available there. Must be called with the file
+  semaphore held
+ */
+uint8_t *StorageAccess::file_data(uint32_t addr, size_t &n, bool dirty) const
+{
+    const int16_t slot = load_page(addr / 1024U);
+    if (slot == -1) {
+        return nullptr;
+    }
+    const uint32_t page_ofs = addr % 1024U;
+    n = MIN(n, 1024U - page_ofs);
+    if (dirty) {
+        file->dirty_mask |= (1ULL<<slot);
+    }
+    return &file->buffer[slot*1024U + page_ofs];
+}
+
+/*
+  load one page of any requested prefetch range
+ */
+void StorageAccess::prefetch_pages(void)
+{
+    WITH_SEMAPHORE(file->sem);
+    while (file->prefetch_len > 0) {
+        const uint16_t num = file->prefetch_ofs / 1024U;
+        const uint32_t n = MIN(file->prefetch_len, 1024U - (file->prefetch_ofs % 1024U));
+        file->prefetch_ofs += n;
+        file->prefetch_len -= n;
+        if (find_page(num) == -1) {
+            load_page(num);
+            return;
+        }
+    }
+}
+
 /*
   flush file changes to microSD
  */
 void StorageAccess::flush_file(void)
 {
-    if (file == nullptr || file->dirty_mask == 0) {
+    if (file == nullptr) {
+        return;
+    }
+    if (file->page != nullptr && file->prefetch_len > 0) {
+        prefetch_pages();
+    }
+    if (file->dirty_mask == 0) {
         return;
     }
     const uint32_t now_ms = AP_HAL::millis();
@@ -422,13 +625,8 @@ void StorageAccess::flush_file(void)
     // write out 1k at a time
     bool io_fail = false;
     const int b = __builtin_ffsll(file->dirty_mask);
-    const uint32_t ofs = (b-1)*1024;
-    const uint32_t len = MIN(1024U, file->bufsize-ofs);
-    if (AP::FS().lseek(file->fd, ofs, SEEK_SET) != int32_t(ofs) ||
-        AP::FS().write(file->fd, &file->buffer[ofs], len) != int32_t(len)) {
+    if (!write_slot(b-1)) {
         io_fail = true;
-    } else {
-        file->dirty_mask &= ~(1ULL<<(b-1));
     }
     if (file->dirty_mask == 0) {
         file->last_clean_ms = now_ms;
@@ -448,3 +646,18 @@ void StorageAccess::flush_file(void)
 }
 #endif // AP_SDCARD_STORAGE_ENABLED
 
+/*
+  request that a range of storage is loaded in the background
+ */
+void StorageAccess::prefetch(uint32_t addr, uint32_t n) const
+{
+#if AP_SDCARD_STORAGE_ENABLED
+    if (file == nullptr || file->page == nullptr) {
+        return;
+    }
+    WITH_SEMAPHORE(file->sem);
+    file->prefetch_ofs = addr;
+    file->prefetch_len = MIN(n, file->bufsize - MIN(addr, file->bufsize));
+#endif
+}
+
@@ -93,25 +93,26 @@ public:
     // constructor
     StorageAccess(StorageManager::StorageType _type);
 
-    // return total size of this accessor
-    uint16_t size(void) const { return total_size; }
+    // return total size of this accessor. This is only over 64k for
+    // mission storage attached from microSD
+    uint32_t size(void) const { return total_size; }
 
     // base access via block functions
-    bool read_block(void *dst, uint16_t src, size_t n) const;
-    bool write_block(uint16_t dst, const void* src, size_t n) const;    
+    bool read_block(void *dst, uint32_t src, size_t n) const;
+    bool write_block(uint32_t dst, const void* src, size_t n) const;    
 
     // helper functions
-    uint8_t  read_byte(uint16_t loc) const;
-    uint8_t  read_uint8(uint16_t loc) const { return read_byte(loc); }
-    uint16_t read_uint16(uint16_t loc) const;
-    uint32_t read_uint32(uint16_t loc) const;
-    float read_float(uint16_t loc) const;
-
-    void write_byte(uint16_t loc, uint8_t value) const;
-    void write_uint8(uint16_t loc, uint8_t value) const { return write_byte(loc, value); }
-    void write_uint16(uint16_t loc, uint16_t value) const;
-    void write_uint32(uint16_t loc, uint32_t value) const;
-    void write_float(uint16_t loc, float value) const;
+    uint8_t  read_byte(uint32_t loc) const;
+    uint8_t  read_uint8(uint32_t loc) const { return read_byte(loc); }
+    uint16_t read_uint16(uint32_t loc) const;
+    uint32_t read_uint32(uint32_t loc) const;
+    float read_float(uint32_t loc) const;
+
+    void write_byte(uint32_t loc, uint8_t value) const;
+    void write_uint8(uint32_t loc, uint8_t value) const { return write_byte(loc, value); }
+    void write_uint16(uint32_t loc, uint16_t value) const;
+    void write_uint32(uint32_t loc, uint32_t value) const;
+    void write_float(uint32_t loc, float value) const;
 
     // copy from one storage area to another
     bool copy_area(const StorageAccess &source) const;
@@ -119,9 +120,13 @@ public:
     // attach a storage file from microSD
     bool attach_file(const char *fname, uint16_t size_kbyte);
 
+    // hint that the given range will be read soon. For storage paged
+    // from microSD the pages are loaded by the IO thread
+    void prefetch(uint32_t addr, uint32_t n) const;
+
 private:
     const StorageManager::StorageType type;
-    uint16_t total_size;
+    uint32_t total_size;
 
 #if AP_SDCARD_STORAGE_ENABLED
     /*
@@ -137,8 +142,28 @@ private:
         uint32_t last_io_fail_ms;
         // each bit of the dirty mask covers 1k of data
         uint64_t dirty_mask;
+        /*
+          files too large to hold in memory are paged. buffer then
+          holds num_pages pages, page[i] giving the page of the file
+          held in slot i, and bit i of dirty_mask is set if slot i
+          needs writing
+         */
+        struct Page {
+            uint32_t last_use;
+            uint16_t num;
+        } *page;
+        uint8_t num_pages;
+        uint32_t use_count;
+        uint32_t prefetch_ofs;
+        uint32_t prefetch_len;
     } *file;
 
     void flush_file(void);
+    bool attach_paged(FileStorage *newfile, uint32_t size);
+    void prefetch_pages(void);
+    int16_t find_page(uint16_t num) const;
+    int16_t load_page(uint16_t num) const;
+    bool write_slot(uint8_t slot) const;
+    uint8_t *file_data(uint32_t addr, size_t &n, bool dirty) const;
 #endif
 };